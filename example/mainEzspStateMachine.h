@@ -16,6 +16,7 @@
 
 #include <ezsp/ezsp.h>
 #include <ezsp/byte-manip.h>
+#include <ezsp/zbmessage/green-power-payload-decoders.h>
 
 namespace NSMAIN {
 
@@ -92,7 +93,8 @@ public:
 		displayNetworkKey(displayNetworkKey),
 		channelRequestAnswerTimer(this->timerBuilder.create()),
 		currentState(MainState::INIT_PENDING),
-		startFirmwareUpgrade(switchToFirmwareUpgradeMode) {
+		startFirmwareUpgrade(switchToFirmwareUpgradeMode),
+		payloadDecoders() {
 		/* If the EZSP adapter's application is corrupted, we will never boot the application
 		In such cases, if we don't specifically handle that scenarion we would catch an ASH timeout but the default libezsp behaviour is to run the application, which would hang.
 		Therefore, if we have been instructed to perform a firmware upgrade, and only in that case, we will ask libezsp to select the bootloader's firmware upgrade option directly as soon as we hit the ASH timeout
@@ -321,199 +323,87 @@ public:
 	}
 
 	/**
-	 * @brief Extract one cluster report from the beginning payload buffer
+	 * @brief Handler to be invoked when a new green power frame is received
 	 *
-	 * @note The buffer may contain trailing data, that won't be parsed. @p usedBytes can be used to find out what remains after the cluster report
+	 * It will take the appropriate actions
 	 *
-	 * @param[in] payload The payload (byte buffer) out of which we will parse the leading bytes
-	 * @param[out] usedBytes The number of bytes successfully dissected at the beginning of the buffer
+	 * @warning Currently, this method only displays on/off and scene commands, and a few attribute reports
 	 *
-	 * @return true If a cluster report could be parsed, in such case @p usedBytes will contain the number of bytes decoded to generate the cluster report
+	 * @param[in] i_gpf The frame received
 	 */
-	static bool extractClusterReport( const NSSPI::ByteBuffer& payload, uint8_t& usedBytes ) {
-		size_t payloadSize = payload.size();
-
-		if (payloadSize < 5) {
-			clogE << "Attribute reporting frame is too short: " << payloadSize << " bytes\n";
-			usedBytes = 0;
-			return false;
+	void onReceivedGPFrame(const NSEZSP::CGpFrameView &i_gpf) {
+		if (i_gpf.getCommandId() == NSEZSP::NSGPF::GPF_MANUFACTURER_ATTRIBUTE_REPORTING) {
+			return;	// Channel request, handled by the library
 		}
-
-		/* Cluster IDs are defined in the ZCL specification (Zigbee Alliance document 07-5123-06) */
-		uint16_t clusterId = NSEZSP::dble_u8_to_u16(payload.at(1), payload.at(0));
-		/* Attribute IDs are also defined in the ZCL specs */
-		uint16_t attributeId = NSEZSP::dble_u8_to_u16(payload.at(3), payload.at(2));
-		uint8_t type = payload.at(4);
-
-		switch (clusterId) {
-		case 0x0000: /* Basic */
-			if ((attributeId == 0x4000 /* SWBuildID */) && (type == NSEZSP::ZCL_CHAR_STRING_ATTRIBUTE_TYPE)) {
-				if (payloadSize < 6) {
-					clogE << "Firmware version string is too short: " << payloadSize << " bytes\n";
-				}
-				else {
-					uint8_t strLength = payload.at(5);
-					if (payloadSize < 6+strLength) {
-						clogE << "String frame is too short: " << payloadSize << " bytes\n";
-						usedBytes = 0;
-						return false;
-					}
-					std::string fwVersion(payload.begin()+6, payload.begin()+6+strLength);
-					std::cout << "Firmware version is \"" << fwVersion << "\"\n";
-					usedBytes = 6 + strLength;
-					return true;
-				}
-			}
-			else {
-				clogE << "Wrong type: 0x" << std::hex << std::setw(4) << std::setfill('0') << static_cast<unsigned int>(type) << "\n";
-			}
-			break;
-		case 0x000F: /* Binary input */
-			if ((attributeId == 0x0055 /* PresentValue */) && (type == NSEZSP::ZCL_BOOLEAN_ATTRIBUTE_TYPE)) {
-				if (payloadSize < 6) {
-					clogE << "Binary input frame is too short: " << payloadSize << " bytes\n";
-				}
-				else {
-					uint8_t value = payload.at(5);
-					std::cout << "Door is " << (value?"closed":"open") << "\n";
-					usedBytes = 6;
-					return true;
-				}
-			}
-			else {
-				clogE << "Wrong type: 0x" << std::hex << std::setw(4) << std::setfill('0') << static_cast<unsigned int>(type) << "\n";
-			}
-			break;
-		case 0x0402: /* Temperature Measurement */
-			if ((attributeId == 0x0000 /* MeasuredValue */) && (type == NSEZSP::ZCL_INT16S_ATTRIBUTE_TYPE)) {
-				if (payloadSize < 7) {
-					clogE << "Temperature frame is too short: " << payloadSize << " bytes\n";
-					usedBytes = 0;
-					return false;
-				}
-				else {
-					int16_t value = static_cast<int16_t>(NSEZSP::dble_u8_to_u16(payload.at(6), payload.at(5)));
-					std::cout << "Temperature: " << value/100 << "." << std::setw(2) << std::setfill('0') << abs(value%100) << "°C\n"; /* Note: we padd with 0 and only use the absolute value for the decimals in order to properly display the extracted decimal part */
-					usedBytes = 7;
-					return true;
-				}
-			}
-			else {
-				clogE << "Wrong type: 0x" << std::hex << std::setw(4) << std::setfill('0') << static_cast<unsigned int>(type) << "\n";
-			}
-			break;
-		case 0x0405: /* Humidity */
-			if ((attributeId == 0x0000 /* MeasuredValue */) && (type == NSEZSP::ZCL_INT16U_ATTRIBUTE_TYPE)) {
-				if (payloadSize < 7) {
-					clogE << "Humidity frame is too short: " << payloadSize << " bytes\n";
-					usedBytes = 0;
-					return false;
-				}
-				else {
-					int16_t value = static_cast<int16_t>(NSEZSP::dble_u8_to_u16(payload.at(6), payload.at(5)));
-					std::cout << "Humidity: " << value/100 << "." << std::setw(2) << std::setfill('0') << value%100 << "%\n";
-					usedBytes = 7;
-					return true;
-				}
+		GPFramePrinter printer;
+		if (!this->payloadDecoders.decode(i_gpf, printer)) {
+			if (!this->payloadDecoders.hasDecoder(i_gpf.getCommandId())) {
+				clogW << "Unknown command ID: 0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(i_gpf.getCommandId()) << "\n";
 			}
 			else {
-				clogE << "Wrong type: 0x" << std::hex << std::setw(4) << std::setfill('0') << static_cast<unsigned int>(type) << "\n";
-			}
-			break;
-		case 0x0001: /* Power Configuration */
-			if ((attributeId == 0x0020 /* BatteryVoltage */) && (type == NSEZSP::ZCL_INT8U_ATTRIBUTE_TYPE)) {
-				if (payloadSize < 6) {
-					clogE << "Battery level frame is too short: " << payloadSize << " bytes\n";
-				}
-				else {
-					uint8_t value = static_cast<uint8_t>(payload.at(5));
-					std::cout << "Battery level: " << value/10 << "." << std::setw(1) << std::setfill('0') << value%10 << "V\n";
-					usedBytes = 6;
-					return true;
+				clogE << "Failed decoding payload of command 0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(i_gpf.getCommandId()) << ": ";
+				for (auto i : i_gpf.getPayloadView()) {
+					clogE << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(i) << " ";
 				}
+				clogE << "\n";
 			}
-			else {
-				clogE << "Wrong type: 0x" << std::hex << std::setw(4) << std::setfill('0') << static_cast<unsigned int>(type) << "\n";
-			}
-			break;
-		default:
-			clogE << "Unknown cluster ID: 0x" << std::hex << std::setw(4) << std::setfill('0') << clusterId << "\n";
 		}
-		clogE << "Payload parsing error\n";
-		usedBytes = 0;
-		return false;
 	}
 
+private:
 	/**
-	 * @brief Extract multiple concatenated cluster reports from the beginning payload buffer
-	 *
-	 * @param[in] payload The payload (byte buffer) we will parse
-	 *
-	 * @return true If the buffer only contains 0, 1 or more concatenated cluster report(s) that were succesfully parsed, false otherwise (also returned when there are undecoded trailing bytes)
+	 * @brief Displays the commands and attribute reports decoded from incoming green power frames
 	 */
-	static bool extractMultiClusterReport( NSSPI::ByteBuffer payload ) {
-		uint8_t usedBytes = 0;
-		bool validBuffer = true;
-
-		while (payload.size()>0 && validBuffer) {
-			validBuffer = extractClusterReport(payload, usedBytes);
-			if (validBuffer) {
-				payload.erase(payload.begin(), payload.begin()+static_cast<int>(usedBytes));
+	class GPFramePrinter : public NSEZSP::CGpPayloadVisitor {
+	public:
+		void handleOnOff(const NSEZSP::CGpFrameView &i_gpf, NSEZSP::CGpOnOffAction i_action) override {
+			switch (i_action) {
+			case NSEZSP::CGpOnOffAction::Off:
+				std::cout << "Received Off Command\n";
+				break;
+			case NSEZSP::CGpOnOffAction::On:
+				std::cout << "Received On Command\n";
+				break;
+			default:
+				std::cout << "Received Toggle Command\n";
+				break;
 			}
 		}
-		return validBuffer;
-	}
 
-	/**
-	 * @brief Handler to be invoked when a new green power frame is received
-	 *
-	 * It will take the appropriate actions
-	 *
-	 * @warning Currently, this method only handles green power attribute single or multi report frames
-	 *
-	 * @param[in] i_gpf The frame received
-	 */
-	void onReceivedGPFrame(NSEZSP::CGpFrame &i_gpf) {
-		switch(i_gpf.getCommandId()) {
-		case 0xa0: {	// Attribute reporting
-			uint8_t usedBytes;
-			if (!extractClusterReport(i_gpf.getPayload(), usedBytes)) {
-				clogE << "Failed decoding attribute reporting payload: ";
-				for (auto i : i_gpf.getPayload()) {
-					clogE << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(i) << " ";
-				}
-			}
+		void handleScene(const NSEZSP::CGpFrameView &i_gpf, const NSEZSP::CGpSceneEvent &i_event) override {
+			std::cout << "Received " << (i_event.store?"Store":"Recall") << " Scene " << static_cast<unsigned int>(i_event.scene) << " Command\n";
 		}
-		break;
 
-		case 0xa2: {	// Multi-Cluster Reporting
-			if (!extractMultiClusterReport(i_gpf.getPayload())) {
-				clogE << "Failed to fully decode multi-cluster reporting payload: ";
-				for (auto i : i_gpf.getPayload()) {
-					clogE << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(i) << " ";
-				}
+		void handleAttributeReport(const NSEZSP::CGpFrameView &i_gpf, const NSEZSP::CGpAttributeReport &i_report) override {
+			if (i_report.manufacturerSpecific) {
+				return;
+			}
+			/* Cluster IDs and attribute IDs are defined in the ZCL specification (Zigbee Alliance document 07-5123-06) */
+			if (i_report.clusterId == 0x0000 /* Basic */ && i_report.attributeId == 0x4000 /* SWBuildID */ && i_report.type == NSEZSP::ZCL_CHAR_STRING_ATTRIBUTE_TYPE) {
+				std::string fwVersion(i_report.value.begin(), i_report.value.end());
+				std::cout << "Firmware version is \"" << fwVersion << "\"\n";
+			}
+			else if (i_report.clusterId == 0x000F /* Binary input */ && i_report.attributeId == 0x0055 /* PresentValue */ && i_report.type == NSEZSP::ZCL_BOOLEAN_ATTRIBUTE_TYPE) {
+				std::cout << "Door is " << (i_report.rawValue?"closed":"open") << "\n";
+			}
+			else if (i_report.clusterId == 0x0402 /* Temperature Measurement */ && i_report.attributeId == 0x0000 /* MeasuredValue */ && i_report.type == NSEZSP::ZCL_INT16S_ATTRIBUTE_TYPE) {
+				int16_t value = static_cast<int16_t>(i_report.rawValue);
+				std::cout << "Temperature: " << value/100 << "." << std::setw(2) << std::setfill('0') << abs(value%100) << "°C\n"; /* Note: we padd with 0 and only use the absolute value for the decimals in order to properly display the extracted decimal part */
+			}
+			else if (i_report.clusterId == 0x0405 /* Humidity */ && i_report.attributeId == 0x0000 /* MeasuredValue */ && i_report.type == NSEZSP::ZCL_INT16U_ATTRIBUTE_TYPE) {
+				uint16_t value = static_cast<uint16_t>(i_report.rawValue);
+				std::cout << "Humidity: " << value/100 << "." << std::setw(2) << std::setfill('0') << value%100 << "%\n";
+			}
+			else if (i_report.clusterId == 0x0001 /* Power Configuration */ && i_report.attributeId == 0x0020 /* BatteryVoltage */ && i_report.type == NSEZSP::ZCL_INT8U_ATTRIBUTE_TYPE) {
+				uint8_t value = static_cast<uint8_t>(i_report.rawValue);
+				std::cout << "Battery level: " << value/10 << "." << std::setw(1) << std::setfill('0') << value%10 << "V\n";
+			}
+			else {
+				clogW << "Unhandled report of attribute 0x" << std::hex << std::setw(4) << std::setfill('0') << i_report.attributeId
+				      << " of cluster 0x" << std::setw(4) << i_report.clusterId << "\n";
 			}
 		}
-		break;
-
-		case 0x20: { // Off Command (see Table 54 "Payloadless GPDF commands sent by GPD" in Green Power Specifications v1.1.1 (14-0563-18))
-			std::cout << "Received Off Command\n";
-		}
-		break;
-
-		case 0x21: { // On Command (see Table 54 "Payloadless GPDF commands sent by GPD" in Green Power Specifications v1.1.1 (14-0563-18))
-			std::cout << "Received On Command\n";
-		}
-		break;
-		
-		case 0xa1: break; // Channel request
-		default:
-			clogW << "Unknown command ID: 0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(i_gpf.getCommandId()) << "\n";
-			break;
-		}
-	}
-
-private:
+	};
 	unsigned int initFailures;  /*!< How many failed init cycles we have done so far */
 	NSSPI::TimerBuilder &timerBuilder;    /*!< A builder to create timer instances */
 	NSEZSP::CEzsp& libEzsp;  /*!< The CEzsp instance to use to communicate with the EZSP adapter */
@@ -527,6 +417,7 @@ private:
 	std::unique_ptr<NSSPI::ITimer> channelRequestAnswerTimer;   /*!< A timer to temporarily allow channel request */
 	MainState currentState; /*!< Our current state (for the internal state machine) */
 	bool startFirmwareUpgrade; /*!< Do we immediately put the EZSP adapter into firmware upgrade mode at startup */
+	NSEZSP::CGpPayloadDecoders payloadDecoders;	/*!< Decoders of the payloads of incoming green power frames */
 };
 
 } // namespace NSMAIN
@@ -289,7 +289,7 @@ int main(int argc, char **argv) {
 	};
 	lib_main.registerLibraryStateCallback(clibobs);
 
-	auto gprecvobs = [&fsm](NSEZSP::CGpFrame &i_gpf) {
+	auto gprecvobs = [&fsm](const NSEZSP::CGpFrameView &i_gpf) {
 		fsm.onReceivedGPFrame(i_gpf);
 	};
 	lib_main.registerGPFrameRecvCallback(gprecvobs);
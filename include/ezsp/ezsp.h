@@ -7,10 +7,12 @@
 #ifndef __EZSP_H__
 #define __EZSP_H__
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <vector>
 #include <map>
+#include <string>
 
 #include <ezsp/export.h>
 #include <ezsp/config.h>
@@ -19,6 +21,7 @@
 #include <ezsp/gpd.h>
 #include <ezsp/zbmessage/green-power-device.h>
 #include <ezsp/zbmessage/green-power-frame.h>
+#include <ezsp/green-power-attribute-store.h>
 #include <ezsp/ezsp-adapter-version.h>
 #include <spi/TimerBuilder.h>
 #include <spi/IUartDriver.h>
@@ -114,11 +117,38 @@ public:
 
 typedef CLibEzspPublic::State CLibEzspState;    /* Shortcut for access to public state enum */
 
+/**
+ * @brief Sizes of the queues and tables allocated by the library
+ *
+ * In static allocation builds (USE_STATIC_ALLOCATION), these are hard limits: the corresponding storage is allocated once, when CEzsp is constructed, and never grows.
+ * In other builds, they are only initial reservations.
+ */
+class LIBEXPORT CEzspCapacities {
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param maxQueuedCommands The maximum number of EZSP commands waiting to be sent to the adapter (stack initialization queues about 50 commands at once, and each Green Power commissioning or downlink adds a few more while the adapter is busy). In static allocation builds, commands beyond this limit are dropped and logged as errors (see CEzspDongle::sendCommand())
+	 * @param maxGpDevices The maximum number of Green Power devices whose liveness is tracked (see CEzsp::registerGPDeviceOfflineCallback()), and whose keys are stored on the host when MICs are checked on the host (see USE_BUILTIN_MIC_PROCESSING)
+	 * @param maxGpAttributes The maximum number of Green Power device attributes whose last reported value is kept (see CEzsp::getGPAttributeStore())
+	 */
+	explicit CEzspCapacities(std::size_t maxQueuedCommands = 256, std::size_t maxGpDevices = 1024, std::size_t maxGpAttributes = CGpAttributeStore::DEFAULT_CAPACITY) :
+		maxQueuedCommands(maxQueuedCommands),
+		maxGpDevices(maxGpDevices),
+		maxGpAttributes(maxGpAttributes) {
+	}
+
+	std::size_t maxQueuedCommands;	/*!< The maximum number of EZSP commands waiting to be sent to the adapter */
+	std::size_t maxGpDevices;	/*!< The maximum number of Green Power devices in the host key database and in the liveness tracker */
+	std::size_t maxGpAttributes;	/*!< The maximum number of attributes in the Green Power attribute store */
+};
+
 class CLibEzspMain;
 
 typedef std::function<void (CLibEzspState i_state)> FLibStateCallback;  /*!< Callback type for method registerLibraryStateCallback() */
 typedef std::function<void (uint32_t &i_gpd_id, bool i_gpd_known, CGpdKeyStatus i_gpd_key_status)> FGpSourceIdCallback;    /*!< Callback type for method registerGPSourceIdCallback() */
-typedef std::function<void (CGpFrame &i_gpf)> FGpFrameRecvCallback; /*!< Callback type for method registerGPFrameRecvCallback() */
+typedef std::function<void (const CGpFrameView &i_gpf)> FGpFrameRecvCallback; /*!< Callback type for method registerGPFrameRecvCallback() */
+typedef std::function<void (const CGpLivenessReport &i_report)> FGpDeviceOfflineCallback; /*!< Callback type for method registerGPDeviceOfflineCallback() */
 typedef std::function<void (std::map<uint8_t, int8_t>)> FEnergyScanCallback;    /*!< Callback type for method startEnergyScan() */
 typedef std::function<void (std::map<uint8_t, std::vector<NSEZSP::ZigbeeNetworkScanResult> >)> FActiveScanCallback; /*!< Callback type for method startActiveScan() */
 typedef std::function<void (EEmberStatus status, const NSEZSP::EmberKeyData& key)> FNetworkKeyCallback;    /*!< Callback type for method getNetworkKey() */
@@ -131,8 +161,9 @@ public:
 	 * @param uartHandle A handle on a IUartDriver instance to send/receive EZSP message over a serial line
 	 * @param timerbuilder A timer builder object used to generate timers
 	 * @param requestZbNetworkResetToChannel Set this to non 0 if we should destroy any pre-existing Zigbee network in the EZSP adapter and recreate a new Zigbee network on the specified 802.15.4 channel number, set this to -1 if we should just leave any previously joined network
+	 * @param capacities The sizes of the internal queues and tables (hard limits in static allocation builds)
 	 */
-	CEzsp(NSSPI::IUartDriverHandle uartHandle, const NSSPI::TimerBuilder& timerbuilder, unsigned int requestZbNetworkResetToChannel=0);
+	CEzsp(NSSPI::IUartDriverHandle uartHandle, const NSSPI::TimerBuilder& timerbuilder, unsigned int requestZbNetworkResetToChannel=0, const CEzspCapacities& capacities=CEzspCapacities());
 
 	/**
 	 * @brief Copy constructor
@@ -185,7 +216,7 @@ public:
 	/**
 	 * @brief Register callback to receive all incoming greenpower sourceId
 	 *
-	 * @param newObsGPFrameRecvCallback A callback function of type void func(CGpFrame &i_gpf), that will be invoked each time a new valid green power frame is received from a known source ID (or nullptr to disable callbacks)
+	 * @param newObsGPFrameRecvCallback A callback function of type void func(const CGpFrameView &i_gpf), that will be invoked each time a new valid green power frame is received from a known source ID (or nullptr to disable callbacks)
 	 */
 	void registerGPFrameRecvCallback(FGpFrameRecvCallback newObsGPFrameRecvCallback);
 
@@ -196,6 +227,39 @@ public:
 	 */
 	void registerGPSourceIdCallback(FGpSourceIdCallback newObsGPSourceIdCallback);
 
+	/**
+	 * @brief Get the last value reported by GP devices for each of their attributes
+	 *
+	 * The store is updated on reception of attribute reporting GPD commands, and can be read from any thread without blocking the reception
+	 * of frames, rather than maintaining values in the callback registered with registerGPFrameRecvCallback().
+	 *
+	 * @return The attribute store (its capacity is set by CEzspCapacities::maxGpAttributes)
+	 */
+	const CGpAttributeStore& getGPAttributeStore() const;
+
+	/**
+	 * @brief Register callback to be notified of GP devices that stop reporting
+	 *
+	 * Each authenticated frame from a GP device re-arms a deadline of a few times its reporting period, learned from the intervals between
+	 * its frames (see setGPLivenessParameters()). The callback is invoked when a device misses its deadline (CGpLivenessReport::offline
+	 * is true), and again when the device is heard after that (CGpLivenessReport::offline is false).
+	 * At most CEzspCapacities::maxGpDevices devices are tracked.
+	 *
+	 * @param newObsGPDeviceOfflineCallback A callback function of type void func(const CGpLivenessReport &i_report) (or nullptr to disable callbacks)
+	 */
+	void registerGPDeviceOfflineCallback(FGpDeviceOfflineCallback newObsGPDeviceOfflineCallback);
+
+	/**
+	 * @brief Configure when GP devices are considered offline, forgetting the reporting periods learned so far
+	 *
+	 * @param nbMissedReports The number of reporting periods without any frame before a device is considered offline
+	 * @param minTimeout The shortest silence before a device is considered offline, whatever its reporting period
+	 * @param initialTimeout The silence before a device heard only once (whose reporting period is unknown) is considered offline
+	 */
+	void setGPLivenessParameters(unsigned int nbMissedReports = 3,
+	                             std::chrono::milliseconds minTimeout = std::chrono::milliseconds(60000),
+	                             std::chrono::milliseconds initialTimeout = std::chrono::milliseconds(3600000));
+
 	/**
 	 * @brief Remove GP all devices from sink
 	 *
@@ -227,10 +291,80 @@ public:
 	 */
 	bool addGPDevices(const std::vector<CGpDevice> &gpDevicesList);
 
+	/**
+	 * @brief Make the GP devices registered in the sink match a desired list (identified by their source ID value+key)
+	 *
+	 * Only the differences are applied: devices missing from the list are removed, new devices or devices whose key or options changed
+	 * are (re-)registered, and the others are left untouched. This is meant to be used at startup, instead of clearAllGPDevices()
+	 * followed by addGPDevices(), as the adapter's tables are not read again nor rewritten entirely.
+	 *
+	 * @param gpDevicesList The desired list of CGpDevice objects containing source ID + key pairs
+	 * @param[out] summary The number of devices left unchanged, added, updated and removed
+	 *
+	 * @return true if the action is going to be run in the background, false if the sink is busy
+	 */
+	bool syncGPDevices(const std::vector<CGpDevice> &gpDevicesList, CGpSyncSummary &summary);
+
+	/**
+	 * @brief Load the GP devices from a persistent store on the host, rather than pushing them all with addGPDevices() at each start
+	 *
+	 * The store is a snapshot file (mapped in memory as is, so that loading it is immediate whatever the number of devices) and a delta log
+	 * (@p path suffixed with ".log"). Once the store is open, GP devices added or removed with addGPDevices(), removeGPDevices()
+	 * and clearAllGPDevices() are persisted there. If the store does not exist, it is created with the devices currently known.
+	 *
+	 * @note Only available when MICs are checked on the host (see USE_BUILTIN_MIC_PROCESSING)
+	 *
+	 * @param path The path of the store snapshot file
+	 *
+	 * @return true if the store is open, false if it is invalid or could not be accessed
+	 */
+	bool openGPDeviceStore(const std::string& path);
+
+	/**
+	 * @brief Select what to do with incoming frames from GP devices that are not known by the sink (eg: neighbours' devices)
+	 *
+	 * By default, such frames are processed (and notified to the callback registered with registerGPSourceIdCallback()).
+	 * In environments with lots of foreign GP devices, dropping them before they are decoded saves most of their processing.
+	 * Unsecured commissioning and channel request frames are never dropped.
+	 *
+	 * @param policy The policy
+	 * @param sampleInterval With CGpUnknownSourcePolicy::Sample, one out of this number of frames from unknown devices is processed
+	 */
+	void setUnknownGPSourcePolicy(CGpUnknownSourcePolicy policy, unsigned int sampleInterval = 100);
+
+	/**
+	 * @brief Let the adapter validate the most active GP devices, while the host validates all others (hybrid mode)
+	 *
+	 * The adapter's GP sink table only holds a few dozen devices. In hybrid mode, the devices sending the most frames are moved into it in
+	 * the background (and moved back to the host when other devices become more active), so that the adapter authenticates their frames.
+	 *
+	 * @note Only available when MICs are checked on the host (see USE_BUILTIN_MIC_PROCESSING)
+	 *
+	 * @param nbEntries The number of entries of the adapter's GP sink table to use, 0 to disable hybrid mode
+	 *
+	 * @return true if hybrid mode has been configured
+	 */
+	bool setNcpGPSinkTableSize(unsigned int nbEntries);
+
+	/**
+	 * @brief Validate the MICs of incoming GP frames on a pool of worker threads shared by all CEzsp instances of the process
+	 *
+	 * By default, each instance validates MICs on the thread receiving data from its adapter. With a shared pool, a burst of frames
+	 * on one adapter is spread over several cores. Frames are still processed in their reception order.
+	 *
+	 * @note Only available when MICs are checked on the host (see USE_BUILTIN_MIC_PROCESSING), with C++11 threads (see USE_CPPTHREADS)
+	 *
+	 * @param nbWorkers The number of worker threads, 0 to validate MICs on the receiving threads again
+	 *
+	 * @return true if the pool has been configured
+	 */
+	static bool setGPMicValidationWorkers(unsigned int nbWorkers);
+
 	/**
 	 * @brief Open a Green Power commissionning session
 	 *
-	 * After invoking this method, we will accept new Green Power Devices to become bound to us
+	 * After invoking this method, we will accept new Green Power Devices to become bound to us, until closeCommissioningSession() is invoked
+	 * Devices commissioned at the same time are queued and paired in turn
 	 *
 	 * @return true if the action is going to be run in the background, false if the sink is busy
 	 */
@@ -1,6 +1,10 @@
 #ifndef __GPD_H__
 #define __GPD_H__
 
+#include <cstddef>
+#include <cstdint>
+#include <chrono>
+
 namespace NSEZSP {
 /**
  * @brief enumetion for possible status of a gpd key from an incomming gpd
@@ -11,6 +15,35 @@ enum class CGpdKeyStatus {
 	Undefined   /*<! it's not possible to know the status of key for this gpd. */
 };
 
+/**
+ * @brief What to do with incoming frames from gpds that are not known by the sink (eg: neighbours' devices)
+ */
+enum class CGpUnknownSourcePolicy {
+	Process,    /*<! process them as any other frame (observers are notified of their source ID) */
+	Drop,       /*<! drop them as soon as they are received, before decoding them */
+	Sample      /*<! drop them, except one out of a configurable number of them, that is processed */
+};
+
+/**
+ * @brief Changes applied by a synchronization of the registered gpds with a desired list (see CEzsp::syncGPDevices())
+ */
+struct CGpSyncSummary {
+	std::size_t nbUnchanged;    /*<! gpds already registered with the same key and options, left untouched */
+	std::size_t nbAdded;        /*<! gpds that were not registered yet */
+	std::size_t nbUpdated;      /*<! gpds registered with another key or options, written again */
+	std::size_t nbRemoved;      /*<! registered gpds that are not in the desired list */
+};
+
+/**
+ * @brief A gpd going silent, or being heard again (see CEzsp::registerGPDeviceOfflineCallback())
+ */
+struct CGpLivenessReport {
+	uint32_t sourceId;                          /*<! the source ID of the gpd */
+	bool offline;                               /*<! true if the gpd missed its reports, false if it is heard again after being offline */
+	std::chrono::milliseconds expectedPeriod;   /*<! the reporting period learned for the gpd (0 if it was only heard once) */
+	std::chrono::milliseconds silence;          /*<! the time since the gpd was last heard (when offline), or the duration of the outage (when heard again) */
+};
+
 } // namespace NSEZSP
 
 #endif
@@ -0,0 +1,152 @@
+/**
+ * @file green-power-attribute-store.h
+ *
+ * @brief Last known values of the attributes reported by GP devices, readable from any thread without blocking the RX path
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <chrono>
+#include <functional>
+
+#include <ezsp/export.h>
+#include <ezsp/zbmessage/green-power-payload-decoders.h>
+
+namespace NSEZSP {
+
+/**
+ * @brief The last known value of one attribute of a GP device
+ */
+struct CGpAttributeValue {
+	uint32_t sourceId;	/*!< The source ID of the GPD */
+	uint16_t clusterId;	/*!< The ZCL cluster ID */
+	uint16_t attributeId;	/*!< The ZCL attribute ID */
+	uint8_t type;	/*!< The ZCL attribute type (see zcl.h) */
+	uint64_t rawValue;	/*!< The value, as in CGpAttributeReport::rawValue */
+	uint64_t version;	/*!< The store version at which this value last changed (see CGpAttributeStore::getVersion()) */
+	std::chrono::steady_clock::time_point lastReport;	/*!< When the value was last reported, changed or not */
+};
+
+/**
+ * @brief Table of the last value reported for each (source ID, cluster, attribute), with lock-free readers
+ *
+ * Values are written from the RX path (see update()), and read from any number of threads with get() and forEachChangedSince().
+ * Each entry is protected by a sequence lock: a reader never blocks the writer, it retries in the unlikely case the entry it read was
+ * being updated at the same time. Only standard (not manufacturer-specific) attributes whose values fit in CGpAttributeReport::rawValue
+ * (up to 8 bytes) are kept.
+ *
+ * Each change of a value increments the version of the store, and records it in the entry, so that pollers can only get the values
+ * changed since their previous poll.
+ *
+ * All storage is allocated at construction: once the table holds its capacity of entries, values of new attributes are dropped.
+ */
+class LIBEXPORT CGpAttributeStore {
+public:
+	typedef std::function<void (const CGpAttributeValue& i_value)> FValueCallback;	/*!< Callback invoked for each value by forEachChangedSince() */
+
+	static constexpr std::size_t DEFAULT_CAPACITY = 4096;	/*!< Default maximum number of attributes in the store */
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param i_capacity The maximum number of attributes kept in the store
+	 */
+	explicit CGpAttributeStore(std::size_t i_capacity = DEFAULT_CAPACITY);
+
+	CGpAttributeStore(const CGpAttributeStore&) = delete;
+	CGpAttributeStore& operator=(const CGpAttributeStore&) = delete;
+
+	/**
+	 * @brief Record a reported attribute value
+	 *
+	 * @param i_source_id The source ID of the GPD that sent the report
+	 * @param i_report The reported attribute
+	 * @param i_now The time of the report
+	 *
+	 * @return true if the value is new or changed (the version of the store was incremented), false if it is unchanged or not kept
+	 *
+	 * @note Writers are serialized, but are expected to come from the RX path only
+	 */
+	bool update(uint32_t i_source_id, const CGpAttributeReport& i_report, std::chrono::steady_clock::time_point i_now);
+
+	/**
+	 * @brief Get the last known value of an attribute
+	 *
+	 * @param i_source_id The source ID of the GPD
+	 * @param i_cluster_id The ZCL cluster ID
+	 * @param i_attribute_id The ZCL attribute ID
+	 * @param[out] o_value The last known value
+	 *
+	 * @return false if the attribute was never reported
+	 */
+	bool get(uint32_t i_source_id, uint16_t i_cluster_id, uint16_t i_attribute_id, CGpAttributeValue& o_value) const;
+
+	/**
+	 * @brief Get the current version of the store, that is the number of value changes so far
+	 */
+	uint64_t getVersion() const;
+
+	/**
+	 * @brief Invoke a callback for each value changed after a given version
+	 *
+	 * @param i_version The version returned by the previous call (0 to get all values)
+	 * @param i_callback The callback to invoke for each value whose version is greater than @p i_version
+	 *
+	 * @return The version to give to the next call. Values changed while this call runs may be given again by the next call.
+	 */
+	uint64_t forEachChangedSince(uint64_t i_version, FValueCallback i_callback) const;
+
+	/**
+	 * @brief Get the number of attributes in the store
+	 */
+	std::size_t getNbEntries() const;
+
+	/**
+	 * @brief Get the number of reports dropped because the store was full
+	 */
+	std::size_t getNbDropped() const;
+
+private:
+	/**
+	 * @brief One attribute, all fields are written under its sequence lock
+	 */
+	struct Slot {
+		std::atomic<uint64_t> key{0};	/*!< The attribute of this slot (see makeKey()), 0 while the slot is free */
+		std::atomic<uint32_t> sequence{0};	/*!< Sequence lock: odd while the writer updates the fields below */
+		std::atomic<uint8_t> type{0};	/*!< The ZCL attribute type */
+		std::atomic<uint64_t> rawValue{0};	/*!< The last value */
+		std::atomic<uint64_t> version{0};	/*!< The store version of the last change */
+		std::atomic<std::chrono::steady_clock::rep> lastReport{0};	/*!< The time of the last report, since the steady clock's epoch */
+	};
+
+	/**
+	 * @brief Build the key of an attribute (never 0 for a valid source ID)
+	 */
+	static uint64_t makeKey(uint32_t i_source_id, uint16_t i_cluster_id, uint16_t i_attribute_id);
+
+	/**
+	 * @brief Find the slot of an attribute, or the free slot where it would be stored
+	 *
+	 * @return nullptr if the attribute is not in the table and there is no free slot
+	 */
+	Slot* find(uint64_t i_key) const;
+
+	/**
+	 * @brief Read the fields of a slot consistently with regards to the writer
+	 */
+	static void read(const Slot& i_slot, CGpAttributeValue& o_value);
+
+	std::size_t capacity;	/*!< The maximum number of attributes */
+	std::size_t mask;	/*!< The number of slots (a power of two, at least twice the capacity) minus 1 */
+	std::unique_ptr<Slot[]> slots;	/*!< Open addressing hash table of the attributes (linear probing, entries are never removed) */
+	std::mutex writeMutex;	/*!< Serializes writers (readers never take it) */
+	std::atomic<uint64_t> version;	/*!< The number of value changes so far */
+	std::atomic<std::size_t> nbEntries;	/*!< The number of used slots */
+	std::atomic<std::size_t> nbDropped;	/*!< The number of reports dropped because the table was full */
+};
+
+} // namespace NSEZSP
@@ -10,6 +10,7 @@
 #include <ezsp/export.h>
 #include <ezsp/ezsp-protocol/ezsp-enum.h>
 #include <spi/ByteBuffer.h>
+#include <spi/ByteView.h>
 
 namespace NSEZSP {
 
@@ -58,7 +59,7 @@ public:
 	 * @param raw_message The buffer to construct from
 	 * @param i_src_id source id of gpd frame, used to decrypt key
 	 */
-	CGpdCommissioningPayload(const NSSPI::ByteBuffer& raw_message, uint32_t i_src_id);
+	CGpdCommissioningPayload(NSSPI::ByteView raw_message, uint32_t i_src_id);
 
 	/**
 	 * @brief Getter for the enclosed encryption/authentication key
@@ -11,6 +11,9 @@
 #include <ezsp/ezsp-protocol/ezsp-enum.h>
 #include <ezsp/zbmessage/zcl.h>
 #include <spi/ByteBuffer.h>
+#include <spi/FrameBuffer.h>
+#include <spi/ByteView.h>
+#include <spi/IAes.h>
 
 namespace NSEZSP {
 
@@ -51,8 +54,32 @@ public:
 	 * @brief Construction from an incoming ezsp raw message
 	 *
 	 * @param raw_message The buffer to construct from
+	 *
+	 * @note If @p raw_message is truncated or uses an unsupported addressing mode, the resulting frame is not valid (see isValid())
+	 */
+	explicit CGpFrame(NSSPI::ByteView raw_message);
+
+	/**
+	 * @brief Fields of an incoming GP frame that are located at a fixed offset in the incoming ezsp raw message
 	 */
-	explicit CGpFrame(const NSSPI::ByteBuffer& raw_message);
+	struct Header {
+		uint32_t source_id;	/*!< The source ID of the GPD */
+		EGpSecurityLevel security;	/*!< The security level of the frame */
+		uint8_t command_id;	/*!< The GPD command ID */
+		uint8_t proxy_table_entry;	/*!< The index of the GPD in the adapter's proxy table, 0xFF if it is not in the table */
+	};
+
+	/**
+	 * @brief Read the fixed-offset fields of an incoming ezsp raw message, without decoding nor copying the whole frame
+	 *
+	 * This is meant to discard unwanted frames as early as possible, before constructing a CGpFrame.
+	 *
+	 * @param raw_message The buffer to read from (same as for CGpFrame(NSSPI::ByteView))
+	 * @param[out] o_header The fields read from @p raw_message
+	 *
+	 * @return false if @p raw_message is too short or uses an unsupported addressing mode (constructing a CGpFrame from it will then also fail)
+	 */
+	static bool peekHeader(NSSPI::ByteView raw_message, Header& o_header);
 
 	/**
 	 * @brief Dump this instance as a string
@@ -74,6 +101,15 @@ public:
 		return out;
 	}
 
+	/**
+	 * @brief Was this frame successfully decoded?
+	 *
+	 * @return true if all fields were read from a complete sourceId-addressed incoming message
+	 */
+	bool isValid() const {
+		return valid;
+	}
+
 	// getter
 	uint8_t getApplicationId() const {
 		return application_id;
@@ -112,7 +148,15 @@ public:
 		return proxy_table_entry;
 	}
 	NSSPI::ByteBuffer getPayload() const {
-		return payload;
+		return payload.toByteBuffer();
+	}
+	/**
+	 * @brief Get a view on the GPD command payload, without copying it
+	 *
+	 * @return A view that remains valid as long as this frame exists and is not modified
+	 */
+	NSSPI::ByteView getPayloadView() const {
+		return NSSPI::ByteView(payload);
 	}
 
 	/**
@@ -139,10 +183,103 @@ public:
 	 * @param[in] i_gpd_key The key to authenticate the message
 	 *
 	 * @return true if the MIC in this frame validates the full GP frame using @p i_gpd_key as an authentication key
+	 *
+	 * @note The command of a frame using security level 3 is decrypted in order to check its MIC, but this frame is not modified (see decrypt())
 	 */
 	bool validateMIC(const NSEZSP::EmberKeyData& i_gpd_key) const;
 
+	/**
+	 * @brief Validate the MIC in this frame against the provided key schedule
+	 *
+	 * This avoids re-running the AES key expansion for each frame when the key schedule of the GPD has been computed beforehand
+	 * (see NSSPI::IAes::expand_key())
+	 *
+	 * @param[in] i_gpd_expanded_key The key schedule of the key to authenticate the message
+	 *
+	 * @return true if the MIC in this frame validates the full GP frame using @p i_gpd_expanded_key as an authentication key schedule
+	 */
+	bool validateMIC(const NSSPI::IAes::ExpandedKey& i_gpd_expanded_key) const;
+
+	/**
+	 * @brief Validate the MIC of several frames at once, each one against its own key schedule
+	 *
+	 * The AES-CBC-MAC chains of up to MIC_BATCH_LANES frames are run side by side, so that implementations of
+	 * NSSPI::IAes::encrypt_blocks() able to interleave independent blocks (AES-NI) keep their AES unit busy.
+	 * Results are identical to invoking validateMIC() on each frame.
+	 *
+	 * @param[in] frames The frames to validate
+	 * @param[in] keys The key schedules to use, one per frame (a nullptr key leads to a failed validation for the corresponding frame)
+	 * @param[in] count The number of frames (and keys)
+	 * @param[out] o_results The validation results, one per frame
+	 */
+	static void validateMICBatch(const CGpFrame* const frames[], const NSSPI::IAes::ExpandedKey* const keys[], std::size_t count, bool o_results[]);
+
+	static constexpr unsigned int MIC_BATCH_LANES = 8;	/*!< Maximum number of MIC calculations run side by side by validateMICBatch() */
+
+	/**
+	 * @brief Decrypt the command of a frame using security level 3 (GPD_ENCRYPT_FRM_COUNTER_MIC_SECURITY), and validate its MIC
+	 *
+	 * On success, getCommandId(), getPayload() and getPayloadView() return the plain text command from then on (see isDecrypted())
+	 * The frame is left untouched if the MIC does not validate.
+	 *
+	 * @param[in] i_gpd_key The key to decrypt and authenticate the message
+	 *
+	 * @return true if the frame has been decrypted and its MIC is valid
+	 */
+	bool decrypt(const NSEZSP::EmberKeyData& i_gpd_key);
+
+	/**
+	 * @brief Decrypt the command of a frame using security level 3, and validate its MIC, using a pre-computed key schedule
+	 *
+	 * @param[in] i_gpd_expanded_key The key schedule of the key to decrypt and authenticate the message
+	 *
+	 * @return true if the frame has been decrypted and its MIC is valid
+	 */
+	bool decrypt(const NSSPI::IAes::ExpandedKey& i_gpd_expanded_key);
+
+	/**
+	 * @brief Has the command of this frame been decrypted (see decrypt())?
+	 *
+	 * @return true if getCommandId() and the payload getters return the plain text command of an encrypted frame
+	 */
+	bool isDecrypted() const {
+		return decrypted;
+	}
+
 private:
+	/**
+	 * @brief Prepare the AES blocks used to compute the MIC of this frame (AES-CCM*)
+	 *
+	 * @param[in] i_command_id The plain text GPD command ID
+	 * @param[in] i_payload The plain text GPD command payload
+	 * @param[out] o_B0 The first block of the AES-CBC part
+	 * @param[out] o_B The (padded) authenticated data, on which the AES-CBC part is run after B0
+	 * @param[out] o_A0 The counter block of the AES-CTR part
+	 *
+	 * @return true if the blocks could be computed, false if the security level or application ID of this frame is not supported
+	 */
+	bool prepareMICBlocks(uint8_t i_command_id, const NSSPI::FrameBuffer& i_payload, NSSPI::FrameBuffer& o_B0, NSSPI::FrameBuffer& o_B, NSSPI::FrameBuffer& o_A0) const;
+
+	/**
+	 * @brief Compute the MIC of this frame for a given plain text command, and compare it with the MIC enclosed in the frame
+	 *
+	 * @param[in] i_gpd_expanded_key The key schedule of the key to authenticate the message
+	 * @param[in] i_command_id The plain text GPD command ID
+	 * @param[in] i_payload The plain text GPD command payload
+	 *
+	 * @return true if the MIC matches
+	 */
+	bool checkMIC(const NSSPI::IAes::ExpandedKey& i_gpd_expanded_key, uint8_t i_command_id, const NSSPI::FrameBuffer& i_payload) const;
+
+	/**
+	 * @brief Decrypt the command of a security level 3 frame (AES-CTR part of AES-CCM*, using the counter blocks A1, A2...)
+	 *
+	 * @param[in] i_gpd_expanded_key The key schedule of the key to decrypt the message
+	 * @param[out] o_command_id The plain text GPD command ID
+	 * @param[out] o_payload The plain text GPD command payload
+	 */
+	void decryptCommand(const NSSPI::IAes::ExpandedKey& i_gpd_expanded_key, uint8_t& o_command_id, NSSPI::FrameBuffer& o_payload) const;
+
 	/**
 	 * @brief Computes a nonce according to the GP specs
 	 *
@@ -155,7 +292,7 @@ private:
 
 	/**
 	 * @brief Run the EAS CBC multiple times on a group of AES blocks
-	 * @param[in] i_gpd_key is the 128-bit AES key
+	 * @param[in] i_gpd_expanded_key is the key schedule of the 128-bit AES key
 	 * @param[in] X0 is the initial input of AES-CBC
 	 * @param[in] B0 is the very first block
 	 * @param[in] B The input buffer on which to run AES CBC
@@ -166,8 +303,9 @@ private:
 	 * B is split in multiple AES block size long buffers that will be sequentially used as input to the AES-CBC cipher
 	 * @note B should be a multiple of AES block size (16 bytes) or an error will occur and an empty buffer will be returned
 	 */
-	static NSSPI::ByteBuffer getLastXiAESCBC(const EmberKeyData& i_gpd_key, const NSSPI::ByteBuffer& X0, const NSSPI::ByteBuffer& B0, const NSSPI::ByteBuffer& B, unsigned int& lastIndex);
+	static NSSPI::FrameBuffer getLastXiAESCBC(const NSSPI::IAes::ExpandedKey& i_gpd_expanded_key, const NSSPI::FrameBuffer& X0, const NSSPI::FrameBuffer& B0, const NSSPI::FrameBuffer& B, unsigned int& lastIndex);
 
+	bool valid;	/*!< Was this frame successfully decoded? */
 	uint8_t application_id;
 	uint8_t link_value;
 	uint8_t sequence_number;
@@ -180,7 +318,103 @@ private:
 	uint8_t command_id;
 	uint32_t mic;
 	uint8_t proxy_table_entry;
-	NSSPI::ByteBuffer payload;
+	NSSPI::FrameBuffer payload;	/*!< GPD command payload (stored inline, no heap allocation for GP-sized payloads) */
+	bool decrypted;	/*!< Have command_id and payload been replaced by their plain text (security level 3 only)? */
+};
+
+/**
+ * @brief Read-only view on an incoming green power frame, whose fields are decoded on access
+ *
+ * A view built on an incoming ezsp raw message only references it: nothing is decoded nor copied up front, each getter reads its
+ * field at its fixed offset in the message, and getPayloadView() points to the payload bytes inside the message.
+ * A view can also be built on an existing CGpFrame (for example a frame decrypted by the host), its getters then return the fields of
+ * that frame.
+ *
+ * @warning A view is only valid as long as the message or frame it references, that is for the duration of the observer or callback it
+ *          is given to. Use retain() to get an owning CGpFrame that can be kept.
+ */
+class LIBEXPORT CGpFrameView {
+public:
+	/**
+	 * @brief Construction on an incoming ezsp raw message
+	 *
+	 * @param raw_message The buffer to reference (same as for CGpFrame(NSSPI::ByteView)), it must outlive this view
+	 *
+	 * @note If @p raw_message is truncated or uses an unsupported addressing mode, the resulting view is not valid (see isValid())
+	 */
+	explicit CGpFrameView(NSSPI::ByteView raw_message);
+
+	/**
+	 * @brief Construction on a decoded frame
+	 *
+	 * @param frame The frame to reference, it must outlive this view
+	 */
+	CGpFrameView(const CGpFrame& frame); //NOSONAR: implicit conversion is wanted
+
+	/**
+	 * @brief Is the referenced frame complete and sourceId-addressed?
+	 *
+	 * @return true if the getters below return the fields of the frame, false if they return the defaults of an invalid CGpFrame
+	 */
+	bool isValid() const;
+
+	uint8_t getApplicationId() const;
+	uint8_t getLinkValue() const;
+	uint8_t getSequenceNumber() const;
+	uint32_t getSourceId() const;
+	EGpSecurityLevel getSecurity() const;
+	EGpSecurityKeyType getKeyType() const;
+	bool isAutoCommissioning() const;
+	bool isRxAfterTx() const;
+	uint32_t getSecurityFrameCounter() const;
+	uint8_t getCommandId() const;
+	uint32_t getMic() const;
+	uint8_t getProxyTableEntry() const;
+
+	/**
+	 * @brief Get a view on the GPD command payload, without copying it
+	 *
+	 * @return A view on the payload bytes inside the referenced message (or frame)
+	 */
+	NSSPI::ByteView getPayloadView() const;
+
+	/**
+	 * @brief Has the command of the referenced frame been decrypted (see CGpFrame::decrypt())?
+	 *
+	 * @return true if getCommandId() and getPayloadView() return the plain text command of an encrypted frame
+	 */
+	bool isDecrypted() const;
+
+	/**
+	 * @brief Build an owning copy of the referenced frame, that remains valid after this view
+	 *
+	 * @return The decoded frame
+	 */
+	CGpFrame retain() const;
+
+	/**
+	 * @brief Dump the referenced frame as a string
+	 *
+	 * @return The resulting string (same as CGpFrame::String())
+	 */
+	std::string String() const;
+
+	/**
+	 * @brief Serialize to an iostream
+	 *
+	 * @param out The original output stream
+	 * @param data The object to serialize
+	 *
+	 * @return The new output stream with serialized data appended
+	 */
+	friend std::ostream& operator<< (std::ostream& out, const CGpFrameView& data) {
+		out << data.String();
+		return out;
+	}
+
+private:
+	NSSPI::ByteView raw;	/*!< The referenced incoming ezsp raw message (only used if frame is nullptr) */
+	const CGpFrame* frame;	/*!< The referenced decoded frame, or nullptr if fields are read from raw */
 };
 
 } // namespace NSEZSP
@@ -0,0 +1,229 @@
+/**
+ * @file green-power-payload-decoders.h
+ *
+ * @brief Decoding of GPD command payloads into typed events, dispatched by GPD command ID
+ */
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#include <ezsp/export.h>
+#include <ezsp/zbmessage/green-power-frame.h>
+#include <spi/ByteView.h>
+
+namespace NSEZSP {
+
+/**
+ * @brief GPD command IDs (see the GPDF commands sent by GPD in Green Power Specifications v1.1.1 (14-0563-18))
+ */
+namespace NSGPF {
+
+constexpr uint8_t GPF_SCENE_0_CMD	=	0x10;
+constexpr uint8_t GPF_SCENE_1_CMD	=	0x11;
+constexpr uint8_t GPF_SCENE_2_CMD	=	0x12;
+constexpr uint8_t GPF_SCENE_3_CMD	=	0x13;
+constexpr uint8_t GPF_SCENE_4_CMD	=	0x14;
+constexpr uint8_t GPF_SCENE_5_CMD	=	0x15;
+constexpr uint8_t GPF_SCENE_6_CMD	=	0x16;
+constexpr uint8_t GPF_SCENE_7_CMD	=	0x17;
+
+constexpr uint8_t GPF_STORE_SCENE_0_CMD	=	0x18;
+constexpr uint8_t GPF_STORE_SCENE_1_CMD	=	0x19;
+constexpr uint8_t GPF_STORE_SCENE_2_CMD	=	0x1A;
+constexpr uint8_t GPF_STORE_SCENE_3_CMD	=	0x1B;
+constexpr uint8_t GPF_STORE_SCENE_4_CMD	=	0x1C;
+constexpr uint8_t GPF_STORE_SCENE_5_CMD	=	0x1D;
+constexpr uint8_t GPF_STORE_SCENE_6_CMD	=	0x1E;
+constexpr uint8_t GPF_STORE_SCENE_7_CMD	=	0x1F;
+
+constexpr uint8_t GPF_OFF_CMD		=	0x20;
+constexpr uint8_t GPF_ON_CMD		=	0x21;
+constexpr uint8_t GPF_TOGGLE_CMD	=	0x22;
+
+constexpr uint8_t GPF_UP_W_ON_OFF_CMD	=	0x34;
+constexpr uint8_t GPF_STOP_CMD			=	0x35;
+constexpr uint8_t GPF_DOWN_W_ON_OFF_CMD	=	0x36;
+
+constexpr uint8_t GPF_ATTRIBUTE_REPORTING	= 0xA0;
+constexpr uint8_t GPF_MANUFACTURER_ATTRIBUTE_REPORTING	= 0xA1;
+constexpr uint8_t GPF_MULTI_CLUSTER_REPORTING	= 0xA2;
+constexpr uint8_t GPF_MANUFACTURER_MULTI_CLUSTER_REPORTING	= 0xA3;
+
+constexpr uint8_t GPF_COMMISSIONING_CMD		=	0xE0;
+constexpr uint8_t GPF_DECOMMISSIONING_CMD	=	0xE1;
+constexpr uint8_t GPF_CHANNEL_REQUEST_CMD	=	0xE3;
+
+// GPDF commands sent to GPD
+constexpr uint8_t GPF_CHANNEL_CONFIGURATION  = 0xF3;
+
+// MSP GPF
+constexpr uint8_t GPF_MSP_CHANNEL_REQUEST_CMD	=	0xB0;
+
+} // namespace NSGPF
+
+/**
+ * @brief Action requested by an on/off GPD command
+ */
+enum class CGpOnOffAction : uint8_t {
+	Off,
+	On,
+	Toggle
+};
+
+/**
+ * @brief A scene GPD command
+ */
+struct CGpSceneEvent {
+	bool store;	/*!< true to store the current state into the scene, false to recall the scene */
+	uint8_t scene;	/*!< The scene number (0 to 7) */
+};
+
+/**
+ * @brief One attribute record of an attribute reporting GPD command
+ */
+struct CGpAttributeReport {
+	bool manufacturerSpecific;	/*!< Is this a manufacturer-specific attribute? */
+	uint16_t manufacturerId;	/*!< The manufacturer ID (only meaningful if manufacturerSpecific is true) */
+	uint16_t clusterId;	/*!< The ZCL cluster ID */
+	uint16_t attributeId;	/*!< The ZCL attribute ID */
+	uint8_t type;	/*!< The ZCL attribute type (see zcl.h) */
+	uint64_t rawValue;	/*!< The value as a little endian unsigned integer (not sign-extended) for types of up to 8 bytes, 0 otherwise */
+	NSSPI::ByteView value;	/*!< The value bytes inside the payload (the characters of strings, without their length) */
+};
+
+/**
+ * @brief An event produced by a user-registered decoder (see CGpPayloadDecoders::registerDecoder())
+ */
+struct CGpCustomEvent {
+	uint16_t eventId;	/*!< Identifies the event, the meaning is up to the decoder */
+	int64_t value;	/*!< A value attached to the event */
+	NSSPI::ByteView data;	/*!< Bytes attached to the event (inside the payload) */
+};
+
+/**
+ * @brief Receives the events decoded from GPD command payloads
+ *
+ * The frame given to each method is the one being decoded, event views point into its payload and are only valid during the call.
+ */
+class CGpPayloadVisitor {
+public:
+	CGpPayloadVisitor() = default;
+	virtual ~CGpPayloadVisitor() = default;
+
+	/**
+	 * @brief Method that will be invoked for on, off and toggle commands
+	 *
+	 * @param i_gpf The frame being decoded
+	 * @param i_action The requested action
+	 */
+	virtual void handleOnOff( const CGpFrameView &/*i_gpf*/, CGpOnOffAction /*i_action*/ ) { /* Default implementation does nothing, add your own handler here in derived visitor classes */ }
+
+	/**
+	 * @brief Method that will be invoked for recall and store scene commands
+	 *
+	 * @param i_gpf The frame being decoded
+	 * @param i_event The scene command
+	 */
+	virtual void handleScene( const CGpFrameView &/*i_gpf*/, const CGpSceneEvent &/*i_event*/ ) { /* Default implementation does nothing, add your own handler here in derived visitor classes */ }
+
+	/**
+	 * @brief Method that will be invoked for each attribute record of an attribute reporting command
+	 *
+	 * @param i_gpf The frame being decoded
+	 * @param i_report The attribute record
+	 */
+	virtual void handleAttributeReport( const CGpFrameView &/*i_gpf*/, const CGpAttributeReport &/*i_report*/ ) { /* Default implementation does nothing, add your own handler here in derived visitor classes */ }
+
+	/**
+	 * @brief Method that user-registered decoders may invoke for events that do not fit the methods above
+	 *
+	 * @param i_gpf The frame being decoded
+	 * @param i_event The decoded event
+	 */
+	virtual void handleCustomEvent( const CGpFrameView &/*i_gpf*/, const CGpCustomEvent &/*i_event*/ ) { /* Default implementation does nothing, add your own handler here in derived visitor classes */ }
+};
+
+/**
+ * @brief Table of GPD command payload decoders, indexed by GPD command ID
+ *
+ * A new instance decodes on/off, scene and attribute reporting commands (0xA0 to 0xA3). Decoders for other (for example manufacturer
+ * specific) commands can be added with registerDecoder().
+ * Decoding never allocates: decoders read the payload view of the frame and invoke the visitor with events that live on the stack.
+ *
+ * @note registerDecoder() must not be invoked while another thread is decoding with the same instance
+ */
+class LIBEXPORT CGpPayloadDecoders {
+public:
+	/**
+	 * @brief A decoder, that invokes @p io_visitor for each event found in the payload of @p i_gpf
+	 *
+	 * @return false if the payload is malformed (events already given to the visitor are not taken back)
+	 */
+	typedef bool (*FDecoder)(const CGpFrameView& i_gpf, CGpPayloadVisitor& io_visitor);
+
+	/**
+	 * @brief Default constructor, registers the built-in decoders
+	 */
+	CGpPayloadDecoders();
+
+	/**
+	 * @brief Set the decoder for a GPD command ID, replacing any previous one
+	 *
+	 * @param i_command_id The GPD command ID
+	 * @param i_decoder The decoder, or nullptr to stop decoding this command
+	 */
+	void registerDecoder(uint8_t i_command_id, FDecoder i_decoder);
+
+	/**
+	 * @brief Is there a decoder for a GPD command ID?
+	 *
+	 * @param i_command_id The GPD command ID
+	 *
+	 * @return true if decode() handles frames carrying this command
+	 */
+	bool hasDecoder(uint8_t i_command_id) const;
+
+	/**
+	 * @brief Decode the payload of a frame, using the decoder of its command ID
+	 *
+	 * @param i_gpf The frame to decode
+	 * @param io_visitor The visitor to invoke with the decoded events
+	 *
+	 * @return false if there is no decoder for the command of @p i_gpf, or if its payload is malformed
+	 */
+	bool decode(const CGpFrameView& i_gpf, CGpPayloadVisitor& io_visitor) const;
+
+	/**
+	 * @brief Built-in decoder of the on, off and toggle commands
+	 */
+	static bool decodeOnOff(const CGpFrameView& i_gpf, CGpPayloadVisitor& io_visitor);
+
+	/**
+	 * @brief Built-in decoder of the recall and store scene commands
+	 */
+	static bool decodeScene(const CGpFrameView& i_gpf, CGpPayloadVisitor& io_visitor);
+
+	/**
+	 * @brief Built-in decoder of the (manufacturer-specific) attribute reporting and multi-cluster reporting commands
+	 */
+	static bool decodeAttributeReporting(const CGpFrameView& i_gpf, CGpPayloadVisitor& io_visitor);
+
+	/**
+	 * @brief Read one ZCL attribute value
+	 *
+	 * @param i_type The ZCL attribute type
+	 * @param i_data The bytes starting with the value
+	 * @param[out] o_report The value and rawValue fields are set to the value read
+	 * @param[out] o_size The number of bytes of @p i_data used by the value
+	 *
+	 * @return false if @p i_type is not supported (arrays, structures, sets and bags) or if @p i_data is too short
+	 */
+	static bool readAttributeValue(uint8_t i_type, NSSPI::ByteView i_data, CGpAttributeReport& o_report, std::size_t& o_size);
+
+private:
+	std::array<FDecoder, 256> decoders;	/*!< The decoder of each GPD command ID (nullptr if there is none) */
+};
+
+} // namespace NSEZSP
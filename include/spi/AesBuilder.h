@@ -9,9 +9,32 @@
 
 namespace NSSPI {
 
+/**
+ * @brief Factory for the AES implementation
+ *
+ * Among the implementations enabled at build time, the fastest one is selected once for the whole process:
+ * AES-NI (USE_AESNI) if the CPU supports it, then the T-table implementation (USE_AESTTABLE), then the built-in byte-oriented
+ * implementation (USE_AESCUSTOM) as the fallback.
+ */
 class LIBEXPORT AesBuilder {
 public:
 	static std::unique_ptr<IAes> create();
+
+	/**
+	 * @brief Get a process-wide AES instance, that can be used without any allocation
+	 *
+	 * @warning Only the const methods (working on an IAes::ExpandedKey) may be used on this instance, which makes it safe to share between threads
+	 *
+	 * @return The shared instance
+	 */
+	static const IAes& shared();
+
+	/**
+	 * @brief Get a human-readable name of the AES implementation selected at runtime
+	 *
+	 * @return The implementation name (eg: "AES-NI")
+	 */
+	static const char* getBackendName();
 };
 
 } // namespace NSSPI
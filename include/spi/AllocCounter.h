@@ -0,0 +1,147 @@
+/**
+ * @file AllocCounter.h
+ *
+ * @brief Optional heap allocation instrumentation, enabled by the USE_ALLOC_COUNTING build option
+ *
+ * When USE_ALLOC_COUNTING is defined, the global operator new/delete are replaced (see AllocCounter.cpp) by versions
+ * that count allocations and allocated bytes per thread, and attribute them to the library layer that is currently
+ * executing on that thread.
+ * Library code marks the layer it is running in using the ALLOC_COUNTING_LAYER() macro, which compiles to nothing
+ * in regular builds.
+ * Tests can also poison the allocator (see AllocCounter::Poison) to check that a code path performs no allocation at all.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include <ezsp/export.h>
+
+#ifdef USE_ALLOC_COUNTING
+
+namespace NSSPI {
+
+class LIBEXPORT AllocCounter {
+public:
+	/**
+	 * @brief The library layers to which allocations are attributed
+	 */
+	enum class Layer : uint8_t {
+		NONE = 0,	/*!< Outside of any instrumented layer */
+		ASH,	/*!< ASH decoding (AshDriver) */
+		DONGLE,	/*!< EZSP frame decoding and dispatching (CEzspDongle and its observers) */
+		GP_SINK,	/*!< Green Power frame processing (CGpSink) */
+		USER_CALLBACK,	/*!< Callbacks provided by the library user */
+		NB_LAYERS	/*!< Number of layers, not a valid layer */
+	};
+
+	/**
+	 * @brief Counters for one layer
+	 */
+	struct Stats {
+		uint64_t allocs;	/*!< Number of calls to operator new */
+		uint64_t bytes;	/*!< Total number of bytes requested from operator new */
+	};
+
+	/**
+	 * @brief RAII object attributing allocations on the current thread to a layer, for its whole lifetime
+	 */
+	class LIBEXPORT Scope {
+	public:
+		explicit Scope(Layer layer);
+		~Scope();
+		Scope(const Scope& other) = delete;
+		Scope& operator=(const Scope& other) = delete;
+	private:
+		Layer previous;	/*!< The layer that was active when this scope was entered, restored at exit */
+	};
+
+	/**
+	 * @brief RAII object poisoning the allocator on the current thread, for its whole lifetime
+	 *
+	 * While a Poison object is alive, any allocation attributed to a layer other than Layer::NONE is a violation.
+	 * Violations are counted separately (see getViolations()), and the requested size is printed on stderr.
+	 */
+	class LIBEXPORT Poison {
+	public:
+		Poison();
+		~Poison();
+		Poison(const Poison& other) = delete;
+		Poison& operator=(const Poison& other) = delete;
+	private:
+		bool previous;	/*!< The poisoning state when this object was created, restored at destruction */
+	};
+
+	/**
+	 * @brief RAII object poisoning the allocator on all threads of the process, for its whole lifetime
+	 *
+	 * Same as Poison, but also covers allocations performed by threads started by the library (timers, serial reader...).
+	 * Violations are counted on the thread that allocated (see getViolations()), and also process-wide (see getProcessViolations()).
+	 */
+	class LIBEXPORT ProcessPoison {
+	public:
+		ProcessPoison();
+		~ProcessPoison();
+		ProcessPoison(const ProcessPoison& other) = delete;
+		ProcessPoison& operator=(const ProcessPoison& other) = delete;
+	};
+
+	/**
+	 * @brief Get the counters of the calling thread for a given layer
+	 *
+	 * @param layer The layer
+	 *
+	 * @return The counters accumulated on the calling thread since the last reset()
+	 */
+	static Stats get(Layer layer);
+
+	/**
+	 * @brief Get the allocations performed by a given layer on the calling thread while the allocator was poisoned
+	 *
+	 * @param layer The layer
+	 *
+	 * @return The violations accumulated on the calling thread since the last reset()
+	 */
+	static Stats getViolations(Layer layer);
+
+	/**
+	 * @brief Get the allocations performed by a given layer on any thread while the allocator was poisoned
+	 *
+	 * @param layer The layer
+	 *
+	 * @return The violations accumulated on all threads since the last reset()
+	 */
+	static Stats getProcessViolations(Layer layer);
+
+	/**
+	 * @brief Reset all counters (including violations) of the calling thread, and the process-wide violation counters
+	 */
+	static void reset();
+
+	/**
+	 * @brief Get a printable name for a layer
+	 *
+	 * @param layer The layer
+	 *
+	 * @return The name of @p layer
+	 */
+	static const char* layerToString(Layer layer);
+
+	/**
+	 * @brief Account for one allocation on the calling thread (invoked by our operator new)
+	 *
+	 * @param size The number of bytes allocated
+	 */
+	static void onAlloc(std::size_t size);
+};
+
+} // namespace NSSPI
+
+#define ALLOC_COUNTING_LAYER(layer) NSSPI::AllocCounter::Scope allocCountingScope(NSSPI::AllocCounter::Layer::layer)
+
+#else
+
+#define ALLOC_COUNTING_LAYER(layer)
+
+#endif // USE_ALLOC_COUNTING
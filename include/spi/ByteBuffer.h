@@ -12,6 +12,7 @@
 #include <vector>
 #include <array>
 #include <cstddef> // For size_t
+#include <cstring> // For memcpy()
 
 #include <ezsp/export.h>
 #include <ezsp/byte-manip.h>
@@ -50,22 +51,15 @@ public:
 	 * @param[in] fromBuf A pointer to the memory buffer to use as input
 	 * @param size The size in bytes to read from @p fromBuf
 	 */
-	ByteBuffer(const uint8_t* fromBuf, size_t size) : _Base() {
-		while (size--) {
-			this->push_back(*fromBuf++);
-		}
-	}
+	ByteBuffer(const uint8_t* fromBuf, size_t size) : _Base(fromBuf, fromBuf + size) { }
 	/**
 	 * @brief Append another ByteBuffer's content to our current content
 	 *
 	 * @param[in] other The array containing the content to add
 	 */
 	template <std::size_t N>
-	ByteBuffer(const std::array<uint8_t, N>& other) : _Base() {
+	ByteBuffer(const std::array<uint8_t, N>& other) : _Base(other.begin(), other.end()) {
 		/* Note: because this is a member template-based method, it should be declare AND defined in the header file */
-		for (auto it=other.begin(); it<other.end(); it++) {
-			this->push_back(*it);
-		}
 	}
 
 	ByteBuffer& operator=(const ByteBuffer& other) {
@@ -90,9 +84,7 @@ public:
 	 * @param[in] other The ByteBuffer containing the content to add
 	 */
 	void append(const ByteBuffer& other) {
-		for (auto it=other.begin(); it<other.end(); it++) {
-			this->push_back(*it);
-		}
+		this->insert(this->end(), other.begin(), other.end());
 	}
 	/**
 	 * @brief Append another ByteBuffer's content to our current content
@@ -102,9 +94,7 @@ public:
 	template <std::size_t N>
 	void append(const std::array<uint8_t, N>& other) {
 		/* Note: because this is a member template-based method, it should be declare AND defined in the header file */
-		for (auto it=other.begin(); it<other.end(); it++) {
-			this->push_back(*it);
-		}
+		this->insert(this->end(), other.begin(), other.end());
 	}
 	/**
 	 * @brief Append another ByteBuffer's content to our current content
@@ -112,8 +102,11 @@ public:
 	 * @param[in] other The ByteBuffer containing the content to add
 	 */
 	void append(ByteBuffer&& other) {
-		for (auto it=other.begin(); it<other.end(); it++) {
-			this->push_back(std::move(*it));
+		if (this->empty()) {
+			_Base::operator=(std::move(other));	/* Steal the storage of other, no copy needed */
+		}
+		else {
+			this->insert(this->end(), other.begin(), other.end());
 		}
 	}
 	/**
@@ -124,8 +117,8 @@ public:
 	 * @warning The caller must make sure that we will have enough room in dst to store all bytes (it should be able to know this by consulting our size() method)
 	 */
 	void toMemory(uint8_t* dst) const {
-		for (auto it=this->begin(); it<this->end(); it++) {
-			*dst++ = *it;
+		if (!this->empty()) {
+			memcpy(dst, this->data(), this->size());
 		}
 	}
 
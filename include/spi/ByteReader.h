@@ -0,0 +1,172 @@
+/**
+ * @file ByteReader.h
+ *
+ * @brief Bounds-checked sequential reader over a ByteView
+ */
+
+#ifndef __BYTEREADER_H__
+#define __BYTEREADER_H__
+
+#include <cstdint>
+#include <cstddef> // For size_t
+#include <cstring> // For memcpy()
+#include <array>
+
+#include <spi/ByteView.h>
+
+namespace NSSPI {
+
+/**
+ * @brief A cursor reading little-endian fields out of a ByteView
+ *
+ * Reading past the end of the view never throws. Instead, an error flag is raised, the read returns 0 (or an empty view),
+ * and all subsequent reads fail as well. Parsers can thus read all their fields in sequence and check hasError() only once at the end.
+ */
+class ByteReader {
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param input The bytes to read from
+	 */
+	explicit ByteReader(ByteView input) : input(input), pos(0), error(false) { }
+
+	/**
+	 * @brief Did any read run out of bounds?
+	 *
+	 * @return true if at least one read failed
+	 */
+	bool hasError() const {
+		return this->error;
+	}
+
+	/**
+	 * @brief Get the current read offset in the input
+	 *
+	 * @return The offset of the next byte to read
+	 */
+	std::size_t position() const {
+		return this->pos;
+	}
+
+	/**
+	 * @brief Get the number of bytes left to read
+	 *
+	 * @return The number of unread bytes
+	 */
+	std::size_t remaining() const {
+		return this->input.size() - this->pos;
+	}
+
+	/**
+	 * @brief Get a view on all bytes not read yet (the cursor is not moved)
+	 *
+	 * @return The view on the unread bytes
+	 */
+	ByteView remainingView() const {
+		return this->input.subView(this->pos);
+	}
+
+	/**
+	 * @brief Skip bytes
+	 *
+	 * @param count The number of bytes to skip
+	 *
+	 * @return false if there were not enough bytes left
+	 */
+	bool skip(std::size_t count) {
+		if (!this->ensure(count)) {
+			return false;
+		}
+		this->pos += count;
+		return true;
+	}
+
+	uint8_t readU8() {
+		if (!this->ensure(1)) {
+			return 0;
+		}
+		return this->input[this->pos++];
+	}
+
+	uint16_t readU16le() {
+		if (!this->ensure(2)) {
+			return 0;
+		}
+		uint16_t result = NSEZSP::dble_u8_to_u16(this->input[this->pos+1], this->input[this->pos]);
+		this->pos += 2;
+		return result;
+	}
+
+	uint32_t readU32le() {
+		if (!this->ensure(4)) {
+			return 0;
+		}
+		uint32_t result = NSEZSP::quad_u8_to_u32(this->input[this->pos+3], this->input[this->pos+2], this->input[this->pos+1], this->input[this->pos]);
+		this->pos += 4;
+		return result;
+	}
+
+	uint64_t readU64le() {
+		uint64_t lo = this->readU32le();
+		uint64_t hi = this->readU32le();
+		return (hi << 32) | lo;
+	}
+
+	/**
+	 * @brief Read a sequence of bytes without copying them
+	 *
+	 * @param count The number of bytes to read
+	 *
+	 * @return A view on the bytes read (empty on error)
+	 */
+	ByteView readBytes(std::size_t count) {
+		if (!this->ensure(count)) {
+			return ByteView();
+		}
+		ByteView result = this->input.subView(this->pos, count);
+		this->pos += count;
+		return result;
+	}
+
+	/**
+	 * @brief Read a fixed-size sequence of bytes into an array
+	 *
+	 * @param[out] o_array The array to fill (left untouched on error)
+	 *
+	 * @return false if there were not enough bytes left
+	 */
+	template <std::size_t N>
+	bool readBytes(std::array<uint8_t, N>& o_array) {
+		if (!this->ensure(N)) {
+			return false;
+		}
+		memcpy(o_array.data(), this->input.data() + this->pos, N);
+		this->pos += N;
+		return true;
+	}
+
+private:
+	/**
+	 * @brief Check that @p count bytes can be read, raise the error flag otherwise
+	 *
+	 * @param count The number of bytes we want to read
+	 *
+	 * @return true if the read can be performed
+	 */
+	bool ensure(std::size_t count) {
+		if (this->error || count > this->input.size() - this->pos) {
+			this->error = true;
+			return false;
+		}
+		return true;
+	}
+
+	ByteView input;	/*!< The bytes we are reading */
+	std::size_t pos;	/*!< The offset of the next byte to read in input */
+	bool error;	/*!< Did a read fail? */
+};
+
+} // namespace NSSPI
+
+#endif
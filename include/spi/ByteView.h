@@ -0,0 +1,122 @@
+/**
+ * @file ByteView.h
+ *
+ * @brief Non-owning, read-only view on a contiguous sequence of bytes
+ */
+
+#ifndef __BYTEVIEW_H__
+#define __BYTEVIEW_H__
+
+#include <cstdint>
+#include <cstddef> // For size_t
+#include <array>
+#include <stdexcept>
+
+#include <spi/ByteBuffer.h>
+#include <spi/FrameBuffer.h>
+
+namespace NSSPI {
+
+/**
+ * @brief A pointer+length pair referencing bytes owned by someone else (a span)
+ *
+ * Building a ByteView never copies nor allocates. The referenced storage must outlive the view.
+ */
+class ByteView {
+public:
+	typedef uint8_t value_type;
+	typedef const uint8_t* const_iterator;
+
+	/**
+	 * @brief Default constructor, creates an empty view
+	 */
+	ByteView() : ptr(nullptr), len(0) { }
+
+	/**
+	 * @brief Construct a view on a memory area
+	 *
+	 * @param[in] data A pointer to the first byte
+	 * @param size The number of bytes in the view
+	 */
+	ByteView(const uint8_t* data, std::size_t size) : ptr(data), len(size) { }
+
+	/**
+	 * @brief Construct a view on the content of a ByteBuffer
+	 *
+	 * @param buf The buffer to reference
+	 */
+	ByteView(const ByteBuffer& buf) : ptr(buf.data()), len(buf.size()) { } //NOSONAR: implicit conversion is wanted
+
+	/**
+	 * @brief Construct a view on the content of a FrameBuffer
+	 *
+	 * @param buf The buffer to reference
+	 */
+	ByteView(const FrameBuffer& buf) : ptr(buf.data()), len(buf.size()) { } //NOSONAR: implicit conversion is wanted
+
+	/**
+	 * @brief Construct a view on the content of a std::array
+	 *
+	 * @param arr The array to reference
+	 */
+	template <std::size_t N>
+	ByteView(const std::array<uint8_t, N>& arr) : ptr(arr.data()), len(N) { } //NOSONAR: implicit conversion is wanted
+
+	const uint8_t* data() const {
+		return this->ptr;
+	}
+	std::size_t size() const {
+		return this->len;
+	}
+	bool empty() const {
+		return (this->len == 0);
+	}
+	const_iterator begin() const {
+		return this->ptr;
+	}
+	const_iterator end() const {
+		return this->ptr + this->len;
+	}
+	const uint8_t& operator[](std::size_t pos) const {
+		return this->ptr[pos];
+	}
+	const uint8_t& at(std::size_t pos) const {
+		if (pos >= this->len) {
+			throw std::out_of_range("ByteView::at");
+		}
+		return this->ptr[pos];
+	}
+
+	/**
+	 * @brief Get a view on a part of this view
+	 *
+	 * @param offset The offset of the first byte of the sub-view
+	 * @param count The maximum number of bytes in the sub-view (the sub-view is truncated to the end of this view)
+	 *
+	 * @return The sub-view (empty if @p offset is beyond the end of this view)
+	 */
+	ByteView subView(std::size_t offset, std::size_t count = static_cast<std::size_t>(-1)) const {
+		if (offset >= this->len) {
+			return ByteView();
+		}
+		std::size_t remaining = this->len - offset;
+		return ByteView(this->ptr + offset, (count < remaining)?count:remaining);
+	}
+
+	/**
+	 * @brief Copy the viewed bytes into a newly created ByteBuffer
+	 *
+	 * @return The resulting ByteBuffer
+	 */
+	ByteBuffer toByteBuffer() const {
+		return ByteBuffer(this->ptr, this->len);
+	}
+
+private:
+	const uint8_t* ptr;	/*!< The first byte in the view */
+	std::size_t len;	/*!< The number of bytes in the view */
+};
+
+} // namespace NSSPI
+
+#endif
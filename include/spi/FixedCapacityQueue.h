@@ -0,0 +1,144 @@
+/**
+ * @file FixedCapacityQueue.h
+ *
+ * @brief FIFO queue with a capacity fixed at construction, that never allocates afterwards
+ */
+
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <stdexcept>
+
+namespace NSSPI {
+
+/**
+ * @brief A FIFO queue (std::queue-like interface) stored in a ring of slots that are all allocated at construction
+ *
+ * Pushing copy-assigns the new element into a pre-existing slot, and popping does not destroy the slot, so elements that own
+ * buffers (like ByteBuffer) keep their capacity from one use of a slot to the next.
+ * When the queue is full, push() refuses the new element instead of growing.
+ *
+ * @tparam T The element type (must be default constructible and copy assignable)
+ */
+template <typename T>
+class FixedCapacityQueue {
+public:
+	/**
+	 * @brief Constructor
+	 *
+	 * @param capacity The maximum number of elements the queue will hold
+	 */
+	explicit FixedCapacityQueue(std::size_t capacity) :
+		slots(capacity),
+		head(0),
+		count(0) {
+	}
+
+	/**
+	 * @brief Append an element at the back of the queue
+	 *
+	 * @param value The element to append
+	 *
+	 * @return true if the element was queued, false if the queue is full (in that case, @p value is discarded)
+	 */
+	bool push(const T& value) {
+		if (this->full()) {
+			return false;
+		}
+		this->slots[(this->head + this->count) % this->slots.size()] = value;
+		this->count++;
+		return true;
+	}
+
+	/**
+	 * @brief Access the element at the front of the queue
+	 *
+	 * @return The oldest element in the queue
+	 *
+	 * @warning The queue must not be empty
+	 */
+	T& front() {
+		return this->slots[this->head];
+	}
+
+	/**
+	 * @brief Access the element at the front of the queue
+	 *
+	 * @return The oldest element in the queue
+	 *
+	 * @warning The queue must not be empty
+	 */
+	const T& front() const {
+		return this->slots[this->head];
+	}
+
+	/**
+	 * @brief Remove the element at the front of the queue
+	 *
+	 * @note The slot itself is kept (with its content) to be reused by a future push()
+	 */
+	void pop() {
+		if (this->count == 0) {
+			throw std::out_of_range("pop() on empty FixedCapacityQueue");
+		}
+		this->head = (this->head + 1) % this->slots.size();
+		this->count--;
+	}
+
+	/**
+	 * @brief Is the queue empty?
+	 *
+	 * @return true if there is no element in the queue
+	 */
+	bool empty() const {
+		return (this->count == 0);
+	}
+
+	/**
+	 * @brief Is the queue full?
+	 *
+	 * @return true if the next push() will be refused
+	 */
+	bool full() const {
+		return (this->count >= this->slots.size());
+	}
+
+	/**
+	 * @brief Get the number of elements in the queue
+	 *
+	 * @return The number of elements
+	 */
+	std::size_t size() const {
+		return this->count;
+	}
+
+	/**
+	 * @brief Get the maximum number of elements in the queue
+	 *
+	 * @return The capacity set at construction
+	 */
+	std::size_t capacity() const {
+		return this->slots.size();
+	}
+
+	/**
+	 * @brief swap() function to swap the content of two FixedCapacityQueue instances
+	 *
+	 * @param first The first object
+	 * @param second The second object
+	 */
+	friend void swap(FixedCapacityQueue& first, FixedCapacityQueue& second) {
+		using std::swap;	// Enable ADL
+		swap(first.slots, second.slots);
+		swap(first.head, second.head);
+		swap(first.count, second.count);
+	}
+
+private:
+	std::vector<T> slots;	/*!< The ring of slots, sized once at construction */
+	std::size_t head;	/*!< Index of the front element in slots */
+	std::size_t count;	/*!< Number of elements currently in the queue */
+};
+
+} // namespace NSSPI
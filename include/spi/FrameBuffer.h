@@ -0,0 +1,387 @@
+/**
+ * @file FrameBuffer.h
+ *
+ * @brief Byte buffer with inline (small-buffer optimized) storage, sized for ASH/EZSP frames
+ *
+ * Contrary to ByteBuffer, which derives from std::vector and thus always allocates its content on the heap,
+ * a FrameBuffer keeps up to FrameBuffer::INLINE_CAPACITY bytes inside the object itself.
+ * Only larger contents spill to the heap.
+ * All bulk operations (construction from memory, append, copy to memory) are performed using memcpy()/memmove().
+ */
+
+#ifndef __FRAMEBUFFER_H__
+#define __FRAMEBUFFER_H__
+
+#include <cstdint>
+#include <cstddef> // For size_t
+#include <cstring> // For memcpy()
+#include <array>
+#include <functional> // For std::less
+#include <stdexcept>
+
+#include <spi/ByteBuffer.h>
+
+namespace NSSPI {
+
+class FrameBuffer {
+public:
+	static constexpr std::size_t INLINE_CAPACITY = 136;	/*!< Number of bytes stored without any heap allocation (enough for any unstuffed ASH frame and EZSP payload) */
+
+	typedef uint8_t value_type;
+	typedef uint8_t* iterator;
+	typedef const uint8_t* const_iterator;
+
+	/**
+	 * @brief Default constructor
+	 */
+	FrameBuffer() : heapBuf(nullptr), len(0), cap(INLINE_CAPACITY) { }
+
+	/**
+	 * @brief Construct from a buffer in memory
+	 *
+	 * @param[in] fromBuf A pointer to the memory buffer to use as input
+	 * @param size The size in bytes to read from @p fromBuf
+	 */
+	FrameBuffer(const uint8_t* fromBuf, std::size_t size) : FrameBuffer() {
+		this->append(fromBuf, size);
+	}
+
+	/**
+	 * @brief Construct from a list of bytes
+	 *
+	 * @param list The bytes to store
+	 */
+	FrameBuffer(const std::initializer_list<uint8_t>& list) : FrameBuffer() {
+		this->append(list.begin(), list.size());
+	}
+
+	/**
+	 * @brief Construct from a ByteBuffer
+	 *
+	 * @param other The ByteBuffer to copy
+	 */
+	explicit FrameBuffer(const ByteBuffer& other) : FrameBuffer() {
+		this->append(other.data(), other.size());
+	}
+
+	/**
+	 * @brief Copy constructor
+	 *
+	 * @param other The object to copy from
+	 */
+	FrameBuffer(const FrameBuffer& other) : FrameBuffer() {
+		this->append(other.data(), other.size());
+	}
+
+	/**
+	 * @brief Move constructor
+	 *
+	 * @param other The object to move from (inline content is copied, heap content is stolen)
+	 */
+	FrameBuffer(FrameBuffer&& other) noexcept : heapBuf(other.heapBuf), len(other.len), cap(other.cap) {
+		if (!other.heapBuf) {
+			memcpy(this->inlineBuf, other.inlineBuf, other.len);
+		}
+		other.heapBuf = nullptr;
+		other.len = 0;
+		other.cap = INLINE_CAPACITY;
+	}
+
+	/**
+	 * @brief Destructor
+	 */
+	~FrameBuffer() {
+		delete[] this->heapBuf;
+	}
+
+	/**
+	 * @brief Assignment operator
+	 *
+	 * @param other The object to assign to the lhs
+	 *
+	 * @return The object that has been assigned the value of @p other
+	 */
+	FrameBuffer& operator=(const FrameBuffer& other) {
+		if (&other != this) {
+			this->clear();
+			this->append(other.data(), other.size());
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief Move assignment operator
+	 *
+	 * @param other The object to move from
+	 *
+	 * @return The object that has been assigned the value of @p other
+	 */
+	FrameBuffer& operator=(FrameBuffer&& other) noexcept {
+		if (&other != this) {
+			delete[] this->heapBuf;
+			this->heapBuf = other.heapBuf;
+			this->len = other.len;
+			this->cap = other.cap;
+			if (!other.heapBuf) {
+				memcpy(this->inlineBuf, other.inlineBuf, other.len);
+			}
+			other.heapBuf = nullptr;
+			other.len = 0;
+			other.cap = INLINE_CAPACITY;
+		}
+		return *this;
+	}
+
+	uint8_t* data() {
+		return (this->heapBuf?this->heapBuf:this->inlineBuf);
+	}
+	const uint8_t* data() const {
+		return (this->heapBuf?this->heapBuf:this->inlineBuf);
+	}
+	std::size_t size() const {
+		return this->len;
+	}
+	std::size_t capacity() const {
+		return this->cap;
+	}
+	bool empty() const {
+		return (this->len == 0);
+	}
+	/**
+	 * @brief Is the content stored inside the object itself (no heap allocation)?
+	 *
+	 * @return true if no heap storage is used
+	 */
+	bool isInline() const {
+		return (this->heapBuf == nullptr);
+	}
+
+	iterator begin() {
+		return this->data();
+	}
+	iterator end() {
+		return this->data() + this->len;
+	}
+	const_iterator begin() const {
+		return this->data();
+	}
+	const_iterator end() const {
+		return this->data() + this->len;
+	}
+
+	uint8_t& operator[](std::size_t pos) {
+		return this->data()[pos];
+	}
+	const uint8_t& operator[](std::size_t pos) const {
+		return this->data()[pos];
+	}
+	uint8_t& at(std::size_t pos) {
+		if (pos >= this->len) {
+			throw std::out_of_range("FrameBuffer::at");
+		}
+		return this->data()[pos];
+	}
+	const uint8_t& at(std::size_t pos) const {
+		if (pos >= this->len) {
+			throw std::out_of_range("FrameBuffer::at");
+		}
+		return this->data()[pos];
+	}
+	uint8_t& front() {
+		return this->data()[0];
+	}
+	const uint8_t& front() const {
+		return this->data()[0];
+	}
+	uint8_t& back() {
+		return this->data()[this->len-1];
+	}
+	const uint8_t& back() const {
+		return this->data()[this->len-1];
+	}
+
+	/**
+	 * @brief Empty the buffer (storage is kept for reuse)
+	 */
+	void clear() {
+		this->len = 0;
+	}
+
+	/**
+	 * @brief Make sure we can store at least @p newCap bytes without reallocating
+	 *
+	 * @param newCap The requested capacity
+	 */
+	void reserve(std::size_t newCap) {
+		if (newCap <= this->cap) {
+			return;
+		}
+		uint8_t* newBuf = new uint8_t[newCap];
+		memcpy(newBuf, this->data(), this->len);
+		delete[] this->heapBuf;
+		this->heapBuf = newBuf;
+		this->cap = newCap;
+	}
+
+	/**
+	 * @brief Change the size of the buffer, new bytes are zeroed
+	 *
+	 * @param newSize The new size
+	 */
+	void resize(std::size_t newSize) {
+		if (newSize > this->len) {
+			this->growFor(newSize);
+			memset(this->data() + this->len, 0, newSize - this->len);
+		}
+		this->len = newSize;
+	}
+
+	void push_back(uint8_t val) {
+		if (this->len == this->cap) {
+			this->growFor(this->len + 1);
+		}
+		this->data()[this->len++] = val;
+	}
+
+	void pop_back() {
+		if (this->len != 0) {
+			this->len--;
+		}
+	}
+
+	/**
+	 * @brief Append a memory buffer to our current content
+	 *
+	 * @param[in] src A pointer to the bytes to append, that may point inside our own content
+	 * @param size The number of bytes to append
+	 */
+	void append(const uint8_t* src, std::size_t size) {
+		if (size == 0) {
+			return;
+		}
+		const uint8_t* oldData = this->data();
+		if (!std::less<const uint8_t*>()(src, oldData) && std::less<const uint8_t*>()(src, oldData + this->len)) {
+			/* Appending (part of) ourselves: growing may free the storage src points to, so locate src again afterwards */
+			std::size_t offset = static_cast<std::size_t>(src - oldData);
+			this->growFor(this->len + size);
+			src = this->data() + offset;
+		}
+		else {
+			this->growFor(this->len + size);
+		}
+		memcpy(this->data() + this->len, src, size);
+		this->len += size;
+	}
+
+	/**
+	 * @brief Append another FrameBuffer's content to our current content
+	 *
+	 * @param[in] other The FrameBuffer containing the content to add
+	 */
+	void append(const FrameBuffer& other) {
+		this->append(other.data(), other.size());
+	}
+
+	/**
+	 * @brief Append a ByteBuffer's content to our current content
+	 *
+	 * @param[in] other The ByteBuffer containing the content to add
+	 */
+	void append(const ByteBuffer& other) {
+		this->append(other.data(), other.size());
+	}
+
+	/**
+	 * @brief Append an array's content to our current content
+	 *
+	 * @param[in] other The array containing the content to add
+	 */
+	template <std::size_t N>
+	void append(const std::array<uint8_t, N>& other) {
+		this->append(other.data(), N);
+	}
+
+	/**
+	 * @brief Remove @p count bytes at the beginning of the buffer
+	 *
+	 * @param count The number of leading bytes to remove
+	 */
+	void eraseFront(std::size_t count) {
+		if (count >= this->len) {
+			this->len = 0;
+			return;
+		}
+		memmove(this->data(), this->data() + count, this->len - count);
+		this->len -= count;
+	}
+
+	/**
+	 * @brief Write the content of this instance into a memory buffer
+	 *
+	 * @param[in] dst A pointer to the beginning of the memory buffer
+	 *
+	 * @warning The caller must make sure that we will have enough room in dst to store all bytes (it should be able to know this by consulting our size() method)
+	 */
+	void toMemory(uint8_t* dst) const {
+		memcpy(dst, this->data(), this->len);
+	}
+
+	/**
+	 * @brief Convert to a ByteBuffer (a single allocation of the exact size is performed)
+	 *
+	 * @return A ByteBuffer containing a copy of our bytes
+	 */
+	ByteBuffer toByteBuffer() const {
+		return ByteBuffer(this->data(), this->len);
+	}
+
+	bool operator==(const FrameBuffer& other) const {
+		return (this->len == other.len && memcmp(this->data(), other.data(), this->len) == 0);
+	}
+	bool operator!=(const FrameBuffer& other) const {
+		return !(*this == other);
+	}
+
+	/**
+	 * @brief Serialize to an iostream
+	 *
+	 * @param out The original output stream
+	 * @param data The object to serialize
+	 *
+	 * @return The new output stream with serialized data appended
+	 */
+	friend std::ostream& operator<<(std::ostream& out, const FrameBuffer& data) {
+		for (auto it=data.begin(); it<data.end(); it++) {
+			if (it != data.begin()) {
+				out << std::string(" ");
+			}
+			out << NSEZSP::byteToHexString(*it);
+		}
+		return out;
+	}
+
+private:
+	/**
+	 * @brief Make sure we can store @p needed bytes, growing geometrically
+	 *
+	 * @param needed The total number of bytes we need to store
+	 */
+	void growFor(std::size_t needed) {
+		if (needed > this->cap) {
+			std::size_t newCap = this->cap * 2;
+			if (newCap < needed) {
+				newCap = needed;
+			}
+			this->reserve(newCap);
+		}
+	}
+
+	uint8_t* heapBuf;	/*!< Heap storage, only used when content outgrows inlineBuf, nullptr otherwise */
+	std::size_t len;	/*!< The number of bytes currently stored */
+	std::size_t cap;	/*!< The number of bytes that can be stored without reallocating */
+	uint8_t inlineBuf[INLINE_CAPACITY];	/*!< Inline storage */
+};
+
+} // namespace NSSPI
+
+#endif
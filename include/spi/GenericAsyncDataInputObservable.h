@@ -6,10 +6,10 @@
 
 #pragma once
 
-#include <set>
 #include <cstdlib>	// For size_t
 #include <ezsp/export.h>
 #include <spi/IAsyncDataInputObserver.h>
+#include <spi/ObserverList.h>
 
 namespace NSSPI {
 
@@ -94,7 +94,11 @@ public:
 	bool registerObserver(NSSPI::IAsyncDataInputObserver* observer);
 
 	/**
-	 * @brief Register a new observer
+	 * @brief Unregister an observer
+	 *
+	 * Waits until notifications in progress on other threads are over: once this returns, @p observer will not be invoked anymore and can
+	 * be destroyed. When invoked from a notification of this observable, notifications in progress on other threads are not waited for.
+	 * Do not invoke it while holding a lock that @p observer takes in its handlers.
 	 *
 	 * @param observer The new observer to remove from the notification list
 	 * @return true if the observer was successfully removed
@@ -109,8 +113,13 @@ public:
 	 */
 	void notifyObservers(const unsigned char* inputData, const size_t inputDataLen);
 
+	/**
+	 * @brief Notify all registered observers that no more data from the current burst is to be expected (see IAsyncDataInputObserver::handleInputBurstEnd())
+	 */
+	void notifyObserversOfInputBurstEnd();
+
 private:
-	std::set<NSSPI::IAsyncDataInputObserver*> observers;	/*!< The list of registered observers */
+	NSSPI::ObserverList<NSSPI::IAsyncDataInputObserver> observers;	/*!< The list of registered observers (copy-on-write, can be notified while being modified from another thread) */
 };
 
 } // namespace NSEZSP
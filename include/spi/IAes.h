@@ -9,6 +9,8 @@
 #ifndef __IAES_H__
 #define __IAES_H__
 
+#include <cstddef>
+
 #include <ezsp/ezsp-protocol/ezsp-enum.h>
 #include <ezsp/export.h>
 
@@ -20,6 +22,16 @@ public:
 	static constexpr uint8_t  N_ROW          = 4;
 	static constexpr uint8_t  N_COL          = 4;
 	static constexpr uint8_t  AES_BLOCK_SIZE = (N_ROW * N_COL);
+	static constexpr uint8_t  AES128_ROUNDS  = 10;
+
+	/**
+	 * @brief A pre-computed AES-128 key schedule (all round keys, as bytes), that can be reused for any number of block encryptions
+	 */
+	struct ExpandedKey {
+		ExpandedKey() : round_keys() { }	/* Not an aggregate, so that a braced key (EmberKeyData) is never mistaken for an ExpandedKey */
+
+		uint8_t round_keys[(AES128_ROUNDS + 1) * AES_BLOCK_SIZE];
+	};
 
 	IAes() = default;
 
@@ -29,6 +41,44 @@ public:
 	virtual void set_key( const NSEZSP::EmberKeyData& key ) = 0;
 	virtual bool encrypt( const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) = 0;
 
+	/**
+	 * @brief Run the AES-128 key expansion once, to be able to encrypt later on with that key without repeating the expansion
+	 *
+	 * @note This method does not use nor modify the key set using set_key()
+	 *
+	 * @param[in] key The 128-bit AES key
+	 * @param[out] o_expanded The resulting key schedule
+	 */
+	virtual void expand_key( const NSEZSP::EmberKeyData& key, ExpandedKey& o_expanded ) const = 0;
+
+	/**
+	 * @brief Encrypt a single block using a key schedule computed by expand_key()
+	 *
+	 * @note This method does not use nor modify the key set using set_key(), it can thus be called concurrently on a shared instance
+	 *
+	 * @param[in] key The key schedule
+	 * @param[in] in The plain text block
+	 * @param[out] out The cipher text block (may be the same buffer as @p in)
+	 */
+	virtual void encrypt( const ExpandedKey& key, const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) const = 0;
+
+	/**
+	 * @brief Encrypt several independent blocks, each one with its own key schedule
+	 *
+	 * Implementations able to pipeline several block encryptions (eg: AES-NI) override this method to interleave the rounds of
+	 * all blocks, this default implementation just encrypts blocks one after the other.
+	 *
+	 * @param[in] keys The key schedules, one per block
+	 * @param[in] in The plain text blocks
+	 * @param[out] out The cipher text blocks (may be the same buffer as @p in)
+	 * @param[in] count The number of blocks
+	 */
+	virtual void encrypt_blocks( const ExpandedKey* const keys[], const unsigned char in[][IAes::AES_BLOCK_SIZE], unsigned char out[][IAes::AES_BLOCK_SIZE], std::size_t count ) const {
+		for (std::size_t i = 0; i < count; i++) {
+			this->encrypt(*keys[i], in[i], out[i]);
+		}
+	}
+
 	// encryption functions
 	//bool decrypt( const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE], const aes_context ctx[1] ); // \TODO rewrite with class context
 	virtual bool cbc_encrypt(const unsigned char *in, unsigned char *out, unsigned long size, unsigned char iv[AES_BLOCK_SIZE]) = 0;
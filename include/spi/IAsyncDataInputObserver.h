@@ -37,6 +37,13 @@ public:
 	 * @param dataLen The size of the data to read inside dataIn
 	 */
 	virtual void handleInputData(const unsigned char* dataIn, const size_t dataLen) = 0;
+
+	/**
+	 * @brief Handler invoked after the last of a group of input data that were received together (eg: all frames decoded from one serial read)
+	 *
+	 * Observers can use this to process data accumulated from handleInputData() in one batch
+	 */
+	virtual void handleInputBurstEnd() { /* Default implementation does nothing, add your own handler here in derived observer classes */ }
 };
 
 } // namespace NSSPI
@@ -0,0 +1,243 @@
+/**
+ * @file ObserverList.h
+ *
+ * @brief Copy-on-write list of observers, safe to notify while other threads register/unregister
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <thread>	// For std::this_thread::yield()
+#include <algorithm>	// For std::find()
+
+namespace NSSPI {
+
+/**
+ * @brief A list of observer pointers, stored as an immutable snapshot that is replaced as a whole on each change (RCU-style)
+ *
+ * Notifying observers only requires an atomic load of the current snapshot, followed by a linear scan on a contiguous vector, without taking any lock.
+ * Registering or unregistering builds a new vector (under a writer mutex) and atomically publishes it.
+ * A notification that is in progress while the list changes keeps on using the snapshot it loaded, which stays alive until that notification completes.
+ *
+ * remove() waits until all notifications performed with forEach() that may still use the removed observer are over (a grace period, as in RCU):
+ * once it returns, the observer will not be invoked anymore and can be destroyed. Notifiers count themselves in one of two reader counters,
+ * chosen by the parity of an epoch that remove() flips before waiting for the counter of the previous parity to drop to zero.
+ *
+ * @tparam T The observer type (we store non-owning T* pointers)
+ *
+ * @warning remove() does not wait when it is invoked from a notification of the same list on the same thread (for example an observer
+ *          that unregisters itself from its own callback), as that would never end. In that case only, the removed observer may still be
+ *          invoked by notifications in progress on other threads. remove() must not be invoked while holding a lock that observers take
+ *          in their callbacks, as it waits for these callbacks to return.
+ */
+template <typename T>
+class ObserverList {
+public:
+	typedef std::vector<T*> Snapshot;	/*!< The immutable content of one version of the list */
+
+	/**
+	 * @brief Default constructor
+	 */
+	ObserverList() : current(std::make_shared<const Snapshot>()), writeMutex(), graceMutex(), epoch(0), nbReaders() {
+		this->nbReaders[0] = 0;
+		this->nbReaders[1] = 0;
+	}
+
+	/**
+	 * @brief Copy constructor
+	 *
+	 * @param other The object to copy from (the current snapshot is shared, as it is immutable)
+	 */
+	ObserverList(const ObserverList& other) : ObserverList() {
+		this->current = other.snapshot();
+	}
+
+	/**
+	 * @brief Assignment operator
+	 *
+	 * @param other The object to assign to the lhs
+	 *
+	 * @return The object that has been assigned the value of @p other
+	 */
+	ObserverList& operator=(const ObserverList& other) {
+		if (&other != this) {
+			this->publish(other.snapshot());
+		}
+		return *this;
+	}
+
+	/**
+	 * @brief swap() function to swap the content of two ObserverList instances
+	 *
+	 * @param first The first object
+	 * @param second The second object
+	 */
+	friend void swap(ObserverList& first, ObserverList& second) {
+		if (&first == &second) {
+			return;
+		}
+		std::shared_ptr<const Snapshot> firstSnapshot = first.snapshot();
+		first.publish(second.snapshot());
+		second.publish(firstSnapshot);
+	}
+
+	/**
+	 * @brief Add an observer to the list
+	 *
+	 * @param observer The new observer to add
+	 * @return true if the observer was added, false if it was already in the list
+	 */
+	bool add(T* observer) {
+		std::lock_guard<std::mutex> lock(this->writeMutex);
+		std::shared_ptr<const Snapshot> old = this->snapshot();
+		if (std::find(old->begin(), old->end(), observer) != old->end()) {
+			return false;
+		}
+		std::shared_ptr<Snapshot> updated = std::make_shared<Snapshot>();
+		updated->reserve(old->size() + 1);
+		updated->assign(old->begin(), old->end());
+		updated->push_back(observer);
+		std::atomic_store(&this->current, std::shared_ptr<const Snapshot>(updated));
+		return true;
+	}
+
+	/**
+	 * @brief Remove an observer from the list
+	 *
+	 * Notifications in progress on other threads are waited for, so that @p observer can be destroyed as soon as this method returns
+	 * (see the class documentation for the only exception).
+	 *
+	 * @param observer The observer to remove
+	 * @return true if the observer was removed, false if it was not in the list
+	 */
+	bool remove(T* observer) {
+		{
+			std::lock_guard<std::mutex> lock(this->writeMutex);
+			std::shared_ptr<const Snapshot> old = this->snapshot();
+			if (std::find(old->begin(), old->end(), observer) == old->end()) {
+				return false;
+			}
+			std::shared_ptr<Snapshot> updated = std::make_shared<Snapshot>();
+			updated->reserve(old->size() - 1);
+			for (T* item : *old) {
+				if (item != observer) {
+					updated->push_back(item);
+				}
+			}
+			std::atomic_store(&this->current, std::shared_ptr<const Snapshot>(updated));
+		}
+		this->waitForReaders();	/* Outside writeMutex, so that observers can still register or unregister from their callbacks */
+		return true;
+	}
+
+	/**
+	 * @brief Get the current version of the list
+	 *
+	 * @return A snapshot that will not change, even if observers are added or removed afterwards
+	 *
+	 * @warning Observers invoked through a snapshot are not waited for by remove(), use forEach() to notify them.
+	 */
+	std::shared_ptr<const Snapshot> snapshot() const {
+		return std::atomic_load(&this->current);
+	}
+
+	/**
+	 * @brief Invoke a function on each observer of the current snapshot
+	 *
+	 * This is the way observers should be notified: remove() waits for the notifications performed here.
+	 *
+	 * @param func A callable taking a T* as argument
+	 */
+	template <typename F>
+	void forEach(F func) const {
+		ReadScope scope(*this);
+		for (T* observer : *scope.snap) {
+			func(observer);
+		}
+	}
+
+	/**
+	 * @brief Get the number of observers in the current snapshot
+	 *
+	 * @return The number of observers
+	 */
+	std::size_t size() const {
+		return this->snapshot()->size();
+	}
+
+private:
+	/**
+	 * @brief A notification in progress, counted in the reader counter of the current epoch parity for its whole duration
+	 *
+	 * Scopes of the calling thread are chained, so that remove() can tell whether it is invoked from a notification of its own list.
+	 */
+	struct ReadScope {
+		explicit ReadScope(const ObserverList& i_list) :
+			list(&i_list),
+			parity(i_list.epoch.load() & 1U),
+			outer(ReadScope::innermost()),
+			snap() {
+			this->list->nbReaders[this->parity].fetch_add(1);
+			ReadScope::innermost() = this;
+			this->snap = this->list->snapshot();	/* Loaded once counted, so that remove() either waits for us or we see its new snapshot */
+		}
+
+		~ReadScope() {
+			ReadScope::innermost() = this->outer;
+			this->list->nbReaders[this->parity].fetch_sub(1);
+		}
+
+		ReadScope(const ReadScope&) = delete;
+		ReadScope& operator=(const ReadScope&) = delete;
+
+		/**
+		 * @brief Get the innermost notification in progress on the calling thread
+		 */
+		static ReadScope*& innermost() {
+			static thread_local ReadScope* scope = nullptr;
+			return scope;
+		}
+
+		const ObserverList* list;	/*!< The list being notified */
+		unsigned int parity;	/*!< The reader counter we are counted in */
+		ReadScope* outer;	/*!< The enclosing notification on the same thread, if any */
+		std::shared_ptr<const Snapshot> snap;	/*!< The snapshot used by this notification */
+	};
+
+	/**
+	 * @brief Wait until all notifications that may have loaded a snapshot older than the current one are over
+	 */
+	void waitForReaders() {
+		for (const ReadScope* scope = ReadScope::innermost(); scope != nullptr; scope = scope->outer) {
+			if (scope->list == this) {
+				return;	/* Invoked from one of our own notifications, waiting would never end */
+			}
+		}
+		std::lock_guard<std::mutex> lock(this->graceMutex);	/* One grace period at a time, so that the epoch does not flip back while we wait */
+		unsigned int l_previous = this->epoch.fetch_add(1) & 1U;
+		while (this->nbReaders[l_previous].load() != 0) {
+			std::this_thread::yield();
+		}
+	}
+
+	/**
+	 * @brief Atomically replace the current snapshot
+	 *
+	 * @param snap The new snapshot
+	 */
+	void publish(std::shared_ptr<const Snapshot> snap) {
+		std::lock_guard<std::mutex> lock(this->writeMutex);
+		std::atomic_store(&this->current, snap);
+	}
+
+	std::shared_ptr<const Snapshot> current;	/*!< The currently published version of the list, only accessed using atomic_load()/atomic_store() */
+	std::mutex writeMutex;	/*!< Serializes writers, so that no concurrent change is lost */
+	std::mutex graceMutex;	/*!< Serializes the grace periods of remove() */
+	std::atomic<unsigned int> epoch;	/*!< Its parity selects the reader counter new notifications are counted in */
+	mutable std::atomic<unsigned int> nbReaders[2];	/*!< Number of notifications in progress, per epoch parity */
+};
+
+} // namespace NSSPI
@@ -14,6 +14,7 @@
 #include "ezsp/byte-manip.h"
 
 #include "spi/ILogger.h"
+#include "spi/AllocCounter.h"
 
 // For debug logging only
 //#include <sstream>
@@ -28,13 +29,20 @@ constexpr uint32_t T_RX_ACK_INIT      = 1600;
 constexpr uint32_t T_RX_ACK_MAX       = 3200;
 constexpr uint32_t T_ACK_ASH_RESET    = 5000;
 
+/**
+ * Number of EZSP payloads that can be decoded from one serial read without growing rxPayloads (the adapter sends at most a few frames in a row)
+ */
+constexpr std::size_t RX_PAYLOADS_RESERVE = 8;
+
 AshDriver::AshDriver(CAshCallback* ipCb, const NSSPI::TimerBuilder& i_timer_builder, NSSPI::GenericAsyncDataInputObservable* serialReadObservable) :
 	enabled(true),
 	ackTimer(i_timer_builder.create()),
 	ashCodec(ipCb),
 	serialReadObservable(serialReadObservable),
 	serialWriteFunc(nullptr),
-	serialRWMutex() {
+	serialRWMutex(),
+	rxPayloads() {
+	this->rxPayloads.reserve(RX_PAYLOADS_RESERVE);
 	/* Tell the codec that it should invoke cancelTimer() below to cancel ACk timeoutes when a proper ASH ACK is received */
 
 	this->ashCodec.setAckTimeoutCancelFunc([this]() {
@@ -92,17 +100,17 @@ void AshDriver::registerSerialReadObservable(NSSPI::GenericAsyncDataInputObserva
 }
 
 void AshDriver::handleInputData(const unsigned char* dataIn, const size_t dataLen) {
+	ALLOC_COUNTING_LAYER(ASH);
 	if (this->enabled) { /* We only process incoming traffic on serial port in enabled mode */
-		NSSPI::ByteBuffer inputData(dataIn, dataLen);
 		const std::lock_guard<std::recursive_mutex> serialRWLock(this->serialRWMutex);	/* Make sure there is no write before we handle the read data (and ack if needed) */
-		this->appendIncoming(inputData); /* Note: resulting decoded EZSP message will be notified to the caller (observer) using our observable property */
+		this->appendIncoming(dataIn, dataLen); /* Note: resulting decoded EZSP message will be notified to the caller (observer) using our observable property */
 	}
 	else {
 		//clogD << "AshDriver ignoring incoming data in disabled mode\n";
 	}
 }
 
-bool AshDriver::sendAshFrame(const NSSPI::ByteBuffer& frame) {
+bool AshDriver::sendAshFrame(const NSSPI::FrameBuffer& frame) {
 	size_t writtenBytes = 0;
 
 	if (!this->serialWriteFunc) {
@@ -147,37 +155,51 @@ bool AshDriver::sendAckFrame() {
 }
 
 bool AshDriver::sendDataFrame(const NSSPI::ByteBuffer& i_data) {
+	return this->sendDataFrame(i_data.data(), i_data.size());
+}
+
+bool AshDriver::sendDataFrame(const uint8_t* i_data, std::size_t i_len) {
+	ALLOC_COUNTING_LAYER(ASH);
 	/* FIXME: sendDataFrame() should not be allowed until the previous ack is confirmed, or the peer may have missed a frame! */
 	this->ackTimer->stop();	/* Stop any possibly running timer */
 
-	if (!this->sendAshFrame(this->ashCodec.forgeDataFrame(i_data))) {
+	/* Start ACK timer before writing, the ACK may be received before the write returns */
+	this->ackTimer->start(T_RX_ACK_INIT, this);
+	if (!this->sendAshFrame(this->ashCodec.forgeDataFrame(i_data, i_len))) {
+		this->ackTimer->stop();
 		return false;
 	}
-	/* Start ACK timer */
-	this->ackTimer->start(T_RX_ACK_INIT, this);
 
 	return true;
 }
 
-void AshDriver::appendIncoming(NSSPI::ByteBuffer& i_data) {
-	std::vector<NSSPI::ByteBuffer> ezspPayloads = this->ashCodec.appendIncoming(i_data);
+void AshDriver::appendIncoming(const uint8_t* i_data, std::size_t i_len) {
+	std::vector<NSSPI::FrameBuffer> ezspPayloads;
+	ezspPayloads.swap(this->rxPayloads);	/* Borrow our preallocated storage (if we are re-entered during notification, the nested call will simply use its own storage) */
+	ezspPayloads.clear();
+	this->ashCodec.appendIncoming(i_data, i_len, ezspPayloads);
 	if (ezspPayloads.size()>1) {
 		clogW << "Multiple EZSP payloads extraction from one ASH stream:\n";	/* This should rarely occur except on very very slow hosts, or when NCP sends two related EZSP messages in a row */
 		for (auto it = ezspPayloads.begin(); it != ezspPayloads.end(); ++it) {
 			clogW << *it << "\n";
 		}
 	}
-	for (auto ezspPayload : ezspPayloads) {
+	bool notified = false;
+	for (const auto& ezspPayload : ezspPayloads) {
 		std::size_t ezspPayloadSize = ezspPayload.size();
 		if (ezspPayloadSize>128) {	/* ASH should not carry payloads larger than 128 bytes */
 			clogE << "EZSP payload too large. Ignored\n";
 		}
-		else {
-			uint8_t ezspAsMemoryBuffer[ezspPayloadSize];
-			ezspPayload.toMemory(ezspAsMemoryBuffer);
-			this->notifyObservers(static_cast<unsigned char*>(ezspAsMemoryBuffer), ezspPayloadSize);
+		else if (ezspPayloadSize>0) {
+			this->notifyObservers(ezspPayload.data(), ezspPayloadSize);
+			notified = true;
 		}
 	}
+	if (notified) {
+		this->notifyObserversOfInputBurstEnd();	/* Let observers process in one go what they may have accumulated from the payloads above */
+	}
+	ezspPayloads.clear();
+	this->rxPayloads.swap(ezspPayloads);	/* Give back the storage for the next call */
 }
 
 bool AshDriver::isConnected() const {
@@ -13,6 +13,7 @@
 #include "spi/GenericAsyncDataInputObservable.h"
 #include "spi/TimerBuilder.h"
 #include "spi/ByteBuffer.h"
+#include "spi/FrameBuffer.h"
 #include "spi/IUartDriver.h"
 #include "ezsp/enum-generator.h"
 #include "ezsp/ashv2-codec.h"
@@ -120,7 +121,7 @@ public:
 	 *
 	 * @note If no serial writer functor is registered, this method will return false
 	 */
-	bool sendAshFrame(const NSSPI::ByteBuffer& frame);
+	bool sendAshFrame(const NSSPI::FrameBuffer& frame);
 
 	/**
 	 * @brief Send an ASH NCP reset frame
@@ -149,6 +150,16 @@ public:
 	 */
 	bool sendDataFrame(const NSSPI::ByteBuffer& i_data);
 
+	/**
+	 * @brief Send an ASH data frame from a raw EZSP payload
+	 *
+	 * @param[in] i_data A pointer to the data payload of the frame we are sending
+	 * @param[in] i_len The number of bytes in @p i_data
+	 *
+	 * @return true If the data frame was sent successfully (note that when we return true, we don't have any response or acknowledgment yet)
+	 */
+	bool sendDataFrame(const uint8_t* i_data, std::size_t i_len);
+
 	/**
 	 * @brief Get the current ASH connection state
 	 *
@@ -171,11 +182,12 @@ protected:
 	/**
 	 * @brief Append a new chunk of incoming ASH bytes and try to decode the current accumulated bytes into an EZSP message
 	 *
-	 * @param[in] i_data The new incoming ASH bytes
+	 * @param[in] i_data A pointer to the new incoming ASH bytes
+	 * @param i_len The number of bytes to read from @p i_data
 	 *
 	 * @note If an EZSP message could be extracted out of an ASH DATA frame, then our observers will be pushed a notification containing the extracted EZSP payload
 	 */
-	void appendIncoming(NSSPI::ByteBuffer& i_data);
+	void appendIncoming(const uint8_t* i_data, std::size_t i_len);
 
 	/**
 	 * @brief Internal callback invoked when timeouts occur
@@ -192,6 +204,7 @@ private:
 	NSSPI::GenericAsyncDataInputObservable* serialReadObservable;	/*!< The observable object used to be notified about new incoming bytes received on the serial port */
 	FAshDriverWriteFunc serialWriteFunc;   /*!< A function to write bytes to the serial port */
 	std::recursive_mutex serialRWMutex;	/*!< A mutex to prevent simultaneous read and writes to the serial port (recursive because we allow a reading handler to also write, for example, an ack) */
+	std::vector<NSSPI::FrameBuffer> rxPayloads;	/*!< Storage for decoded EZSP payloads, kept across calls to appendIncoming() to avoid reallocating it for each incoming chunk */
 };
 
 } // namespace NSEZSP
@@ -45,12 +45,13 @@ bool AshCodec::isInConnectedState() const {
 	return this->stateConnected;
 }
 
-NSSPI::ByteBuffer AshCodec::forgeResetNCPFrame(void) {
+NSSPI::FrameBuffer AshCodec::forgeResetNCPFrame(void) {
 	this->nextExpectedFEAckNum = 0;
 	this->lastReceivedByNEAckNum = 0;
 	this->frmNum = 0;
 	this->stateConnected = false;
-	NSSPI::ByteBuffer lo_msg;
+	NSSPI::FrameBuffer lo_msg;
+	NSSPI::FrameBuffer lo_stuffed;
 
 	if (ackTimerCancelFunc) {
 		this->ackTimerCancelFunc();	/* Cancel any existing armed ack timeout */
@@ -65,15 +66,15 @@ NSSPI::ByteBuffer AshCodec::forgeResetNCPFrame(void) {
 	lo_msg.push_back(u16_get_hi_u8(crc));
 	lo_msg.push_back(u16_get_lo_u8(crc));
 
-	lo_msg = addByteStuffing(lo_msg);
+	lo_stuffed.push_back(ASH_CANCEL_BYTE);
+	addByteStuffing(lo_msg, lo_stuffed);
 
-	lo_msg.insert( lo_msg.begin(), ASH_CANCEL_BYTE );
-
-	return lo_msg;
+	return lo_stuffed;
 }
 
-NSSPI::ByteBuffer AshCodec::forgeAckFrame(void) {
-	NSSPI::ByteBuffer lo_msg;
+NSSPI::FrameBuffer AshCodec::forgeAckFrame(void) {
+	NSSPI::FrameBuffer lo_msg;
+	NSSPI::FrameBuffer lo_stuffed;
 
 	uint8_t ashControlByte = this->lastReceivedByNEAckNum | 0x80;
 	lo_msg.push_back(ashControlByte);
@@ -83,35 +84,43 @@ NSSPI::ByteBuffer AshCodec::forgeAckFrame(void) {
 	lo_msg.push_back(u16_get_hi_u8(crc));
 	lo_msg.push_back(u16_get_lo_u8(crc));
 
-	return addByteStuffing(lo_msg);
+	addByteStuffing(lo_msg, lo_stuffed);
+	return lo_stuffed;
+}
+
+NSSPI::FrameBuffer AshCodec::forgeDataFrame(const NSSPI::ByteBuffer& i_data) {
+	return this->forgeDataFrame(i_data.data(), i_data.size());
 }
 
-NSSPI::ByteBuffer AshCodec::forgeDataFrame(NSSPI::ByteBuffer i_data) {
-	NSSPI::ByteBuffer lo_msg;
+NSSPI::FrameBuffer AshCodec::forgeDataFrame(const uint8_t* i_data, std::size_t i_len) {
+	NSSPI::FrameBuffer lo_msg;
+	NSSPI::FrameBuffer lo_stuffed;
 
 	uint8_t ashControlByte = static_cast<uint8_t>(this->frmNum << 4) | (this->lastReceivedByNEAckNum & 0x07U);
 	lo_msg.push_back(ashControlByte);
 	//clogD << "AshCodec creating DATA(frmNum=" << std::dec << static_cast<unsigned int>(u8_get_hi_nibble(ashControlByte) & 0x07U)
 	//      << ", ackNum=" << static_cast<unsigned int>(u8_get_lo_nibble(ashControlByte) & 0x07U) << ")\n";
-	//clogD << "EZSP payload: " << i_data << "\n";
+	//clogD << "EZSP payload: " << NSSPI::FrameBuffer(i_data, i_len) << "\n";
 	this->frmNum++;
 	this->frmNum &= 0x07U;
 	this->nextExpectedFEAckNum = this->frmNum;	/* ACK value always contain the next expected frame number */
 
-	lo_msg.append(dataRandomize(i_data));
+	lo_msg.append(i_data, i_len);
+	dataRandomize(lo_msg, 1);	/* 1 here will skip the 1st byte (ashControlByte) */
 
 	uint16_t crc = computeCRC(lo_msg);
 	lo_msg.push_back(u16_get_hi_u8(crc));
 	lo_msg.push_back(u16_get_lo_u8(crc));
 
-	return addByteStuffing(lo_msg);
+	addByteStuffing(lo_msg, lo_stuffed);
+	return lo_stuffed;
 }
 
-NSSPI::ByteBuffer AshCodec::processInterFlagStream() {
+NSSPI::FrameBuffer AshCodec::processInterFlagStream() {
 
-	NSSPI::ByteBuffer lo_msg;
+	NSSPI::FrameBuffer lo_msg;
 
-	lo_msg.append(removeByteStuffing(this->in_msg));
+	removeByteStuffing(this->in_msg, lo_msg);
 
 	if (lo_msg.size() < 3) { /* There should be at least a Control byte and a 16-bit CRC */
 		lo_msg.clear();
@@ -147,7 +156,8 @@ NSSPI::ByteBuffer AshCodec::processInterFlagStream() {
 		this->lastReceivedByNEAckNum = remoteFrmNum+1;
 		this->lastReceivedByNEAckNum &= 0x07U;
 
-		lo_msg = dataRandomize(lo_msg, 1);	/* 1 here will skip the 1st byte (ashControlByte) from result */
+		dataRandomize(lo_msg, 1);	/* 1 here will skip the 1st byte (ashControlByte) */
+		lo_msg.eraseFront(1);	/* Only keep the EZSP payload, drop the ashControlByte */
 
 		/*
 		// For debugging
@@ -236,17 +246,15 @@ NSSPI::ByteBuffer AshCodec::processInterFlagStream() {
 	return lo_msg;
 }
 
-std::vector<NSSPI::ByteBuffer> AshCodec::appendIncoming(NSSPI::ByteBuffer& i_data) {
+void AshCodec::appendIncoming(const uint8_t* i_data, std::size_t i_len, std::vector<NSSPI::FrameBuffer>& o_payloads) {
 	/**
 	 * Specifications for the ASH frame format can be found in Silabs's document ug101-uart-gateway-protocol-reference.pdf
 	 */
 	bool inputError = false;
-	std::vector<NSSPI::ByteBuffer> extractedPayloads;	/*!< A vector of extracted ASH payloads... there could be 0, 1 or more payloads extracted out of the current accumulated bytes+i_data */
 	uint8_t val;
 
-	while(!i_data.empty()) {
-		val = i_data.front();
-		i_data.erase(i_data.begin());
+	for (std::size_t pos = 0; pos < i_len; pos++) {
+		val = i_data[pos];
 		switch( val ) {
 		case ASH_CANCEL_BYTE:
 			// Cancel Byte: Terminates a frame in progress. A Cancel Byte causes all data received since the
@@ -261,8 +269,8 @@ std::vector<NSSPI::ByteBuffer> AshCodec::appendIncoming(NSSPI::ByteBuffer& i_dat
 			// last Flag Byte or Cancel Byte is tested to see whether it is a valid frame.
 			//LOGGER(logTRACE) << "<-- RX ASH frame: VIEW ASH_FLAG_BYTE";
 			if (!inputError && !this->in_msg.empty()) {
-				extractedPayloads.push_back(this->processInterFlagStream());
-				/* Note: if we got several ASH frames in a single incoming byte buffer, we will loop and push_back all decoded payloads inside extractedPayload */
+				o_payloads.emplace_back(this->processInterFlagStream());
+				/* Note: if we got several ASH frames in a single incoming byte buffer, we will loop and push_back all decoded payloads inside o_payloads */
 			}
 			this->in_msg.clear();
 			inputError = false;
@@ -293,18 +301,17 @@ std::vector<NSSPI::ByteBuffer> AshCodec::appendIncoming(NSSPI::ByteBuffer& i_dat
 		}
 
 	}
-
-	return extractedPayloads;
 }
 
 
-uint16_t AshCodec::computeCRC(const NSSPI::ByteBuffer& buf) {
+uint16_t AshCodec::computeCRC(const NSSPI::FrameBuffer& buf) {
 	uint16_t lo_crc = 0xFFFF; // initial value
 	uint16_t polynomial = 0x1021; // 0001 0000 0010 0001 (0, 5, 12)
 
-	for (std::size_t cnt = 0; cnt < buf.size(); cnt++) {
+	for (auto it = buf.begin(); it != buf.end(); ++it) {
+		uint8_t byte = *it;
 		for (uint8_t i = 0; i < 8; i++) {
-			bool bit = ((static_cast<uint8_t>(buf.at(cnt) >> static_cast<uint8_t>(7 - i)) & 1) == 1);
+			bool bit = ((static_cast<uint8_t>(byte >> static_cast<uint8_t>(7 - i)) & 1) == 1);
 			bool c15 = ((static_cast<uint8_t>(lo_crc >> 15) & 1) == 1);
 			lo_crc = static_cast<uint16_t>(lo_crc << 1U);
 			if (c15 != bit) {
@@ -318,19 +325,17 @@ uint16_t AshCodec::computeCRC(const NSSPI::ByteBuffer& buf) {
 	return lo_crc;
 }
 
-NSSPI::ByteBuffer AshCodec::removeByteStuffing(const NSSPI::ByteBuffer& i_data) {
-	NSSPI::ByteBuffer result;
-
+void AshCodec::removeByteStuffing(const NSSPI::FrameBuffer& i_data, NSSPI::FrameBuffer& o_result) {
 	// Remove byte stuffing
 	bool escape = false;
 	for (auto it = i_data.begin(); it != i_data.end(); ++it) {
 		if (escape) {
 			escape = false;
 			if ((*it & 0x20) == 0) {
-				result.push_back(static_cast<uint8_t>(*it | 0x20U));
+				o_result.push_back(static_cast<uint8_t>(*it | 0x20U));
 			}
 			else {
-				result.push_back(static_cast<uint8_t>(*it & 0xDFU));
+				o_result.push_back(static_cast<uint8_t>(*it & 0xDFU));
 			}
 		}
 		else { // escape==false
@@ -338,60 +343,52 @@ NSSPI::ByteBuffer AshCodec::removeByteStuffing(const NSSPI::ByteBuffer& i_data)
 				escape = true;
 			}
 			else {
-				result.push_back(*it);  // Non-stuffed byte is copied over as-is
+				o_result.push_back(*it);  // Non-stuffed byte is copied over as-is
 			}
 		}
 	}
-	return result;
 }
 
-NSSPI::ByteBuffer AshCodec::addByteStuffing(const NSSPI::ByteBuffer& i_data) {
-
-	NSSPI::ByteBuffer result;
-
+void AshCodec::addByteStuffing(const NSSPI::FrameBuffer& i_data, NSSPI::FrameBuffer& o_result) {
 	for (auto it = i_data.begin(); it != i_data.end(); ++it) {
 		switch (*it) {
 		case 0x7EU:
-			result.push_back(0x7DU);
-			result.push_back(0x5EU);
+			o_result.push_back(0x7DU);
+			o_result.push_back(0x5EU);
 			break;
 		case 0x7DU:
-			result.push_back(0x7DU);
-			result.push_back(0x5DU);
+			o_result.push_back(0x7DU);
+			o_result.push_back(0x5DU);
 			break;
 		case 0x11U:
-			result.push_back(0x7DU);
-			result.push_back(0x31U);
+			o_result.push_back(0x7DU);
+			o_result.push_back(0x31U);
 			break;
 		case 0x13U:
-			result.push_back(0x7DU);
-			result.push_back(0x33U);
+			o_result.push_back(0x7DU);
+			o_result.push_back(0x33U);
 			break;
 		case 0x18U:
-			result.push_back(0x7DU);
-			result.push_back(0x38U);
+			o_result.push_back(0x7DU);
+			o_result.push_back(0x38U);
 			break;
 		case 0x1AU:
-			result.push_back(0x7DU);
-			result.push_back(0x3AU);
+			o_result.push_back(0x7DU);
+			o_result.push_back(0x3AU);
 			break;
 		default:
-			result.push_back(*it);
+			o_result.push_back(*it);
 			break;
 		}
 	}
-	result.push_back(0x7EU);
-
-	return result;
+	o_result.push_back(0x7EU);
 }
 
-NSSPI::ByteBuffer AshCodec::dataRandomize(const NSSPI::ByteBuffer& i_data, uint8_t start) {
-	NSSPI::ByteBuffer result;
-
+void AshCodec::dataRandomize(NSSPI::FrameBuffer& io_data, std::size_t start) {
 	// Randomise the data
 	uint8_t lfsrByte = 0x42;
-	for (uint8_t cnt = start; cnt < i_data.size(); cnt++) {
-		result.push_back(i_data.at(cnt) ^ lfsrByte);
+	for (std::size_t cnt = start; cnt < io_data.size(); cnt++) {
+		io_data[cnt] ^= lfsrByte;
 
 		/* Now, compute the next LFSR byte */
 		bool lfsrByteBit0 = lfsrByte & 0x01;
@@ -400,8 +397,6 @@ NSSPI::ByteBuffer AshCodec::dataRandomize(const NSSPI::ByteBuffer& i_data, uint8
 			lfsrByte ^= static_cast<uint8_t>(0xb8U);
 		}
 	}
-
-	return result;
 }
 
 /**
@@ -11,6 +11,7 @@
 
 #include "spi/TimerBuilder.h"
 #include "spi/ByteBuffer.h"
+#include "spi/FrameBuffer.h"
 #include "ezsp/enum-generator.h"
 
 namespace NSEZSP {
@@ -87,36 +88,45 @@ public:
 	 *
 	 * @return The ASH frame as a buffer
 	 */
-	NSSPI::ByteBuffer forgeResetNCPFrame(void);
+	NSSPI::FrameBuffer forgeResetNCPFrame(void);
 
 	/**
 	 * @brief Create an ASH ack frame
 	 *
 	 * @return The ASH frame as a buffer
 	 */
-	NSSPI::ByteBuffer forgeAckFrame(void);
+	NSSPI::FrameBuffer forgeAckFrame(void);
 
 	/**
 	 * @brief Create an ASH data frame containing i_data as payload and return it
 	 *
 	 * @param[in] i_data The EZSP payload to be carried by the ASH frame
 	 *
-	 * @note This buffer needs to be passed by copy because it is modified internally inside this method.
-	 *
 	 * @return The ASH frame as a buffer
 	 */
-	NSSPI::ByteBuffer forgeDataFrame(NSSPI::ByteBuffer i_data);
+	NSSPI::FrameBuffer forgeDataFrame(const NSSPI::ByteBuffer& i_data);
 
 	/**
-	 * @brief Try to append a chunk of ASH bytes to the current accumulated incoming bytes
+	 * @brief Create an ASH data frame containing a raw EZSP payload and return it
+	 *
+	 * @param[in] i_data A pointer to the EZSP payload to be carried by the ASH frame
+	 * @param[in] i_len The number of bytes in @p i_data
 	 *
-	 * @param[in] i_data A stream of bytes to try to decode. If one or more messages could be extracted, then the successfully decoded bytes will be stripped from this buffer
+	 * @return The ASH frame as a buffer (no heap allocation as long as the stuffed frame fits in NSSPI::FrameBuffer::INLINE_CAPACITY)
+	 */
+	NSSPI::FrameBuffer forgeDataFrame(const uint8_t* i_data, std::size_t i_len);
+
+	/**
+	 * @brief Try to append a chunk of ASH bytes to the current accumulated incoming bytes
 	 *
-	 * @note This buffer needs to be passed by copy because it is modified internally inside this method.
+	 * @param[in] i_data A pointer to a stream of bytes to try to decode
+	 * @param i_len The number of bytes to read from @p i_data
+	 * @param[out] o_payloads A vector to which parsed data payload(s) contained in the ASH frame (mainly EZSP message contained in ASH data frames) will be appended
 	 *
-	 * @return A vector of parsed data payload(s) contained in the ASH frame (mainly EZSP message contained in ASH data frames)
+	 * @note There could be 0, 1 or more payloads extracted out of the current accumulated bytes+i_data.
+	 *       The caller can reuse the same (cleared) @p o_payloads vector across calls so that no allocation is needed in steady state.
 	 */
-	std::vector<NSSPI::ByteBuffer> appendIncoming(NSSPI::ByteBuffer& i_data);
+	void appendIncoming(const uint8_t* i_data, std::size_t i_len, std::vector<NSSPI::FrameBuffer>& o_payloads);
 
 	/**
 	 * @brief Compute an ASH CRC16 on a speficied buffer
@@ -125,34 +135,31 @@ public:
 	 *
 	 * @return The 16-bit computed CRC
 	 */
-	static uint16_t computeCRC(const NSSPI::ByteBuffer& buf);
+	static uint16_t computeCRC(const NSSPI::FrameBuffer& buf);
 
 	/**
 	 * @brief Remove ASH byte stuffing on an ASH raw stream
 	 *
 	 * @param i_data The raw stream from which byte stuffing will be removed
-	 *
-	 * @return An ASH payload with byte stuffing removed
+	 * @param[out] o_result A buffer to which the ASH payload with byte stuffing removed will be appended
 	 */
-	static NSSPI::ByteBuffer removeByteStuffing(const NSSPI::ByteBuffer& i_data);
+	static void removeByteStuffing(const NSSPI::FrameBuffer& i_data, NSSPI::FrameBuffer& o_result);
 
 	/**
 	 * @brief Apply ASH byte stuffing to an ASH payload
 	 *
 	 * @param i_data The payload to which byte stuffing will be added
-	 *
-	 * @return A byte stuffed raw stream for transmission over a serial link
+	 * @param[out] o_result A buffer to which the byte stuffed raw stream for transmission over a serial link will be appended
 	 */
-	static NSSPI::ByteBuffer addByteStuffing(const NSSPI::ByteBuffer& i_data);
+	static void addByteStuffing(const NSSPI::FrameBuffer& i_data, NSSPI::FrameBuffer& o_result);
 
 	/**
 	 * @brief Apply ASH randomisation (XORed LFSR) to an ASH payload
 	 *
-	 * @param i_data The payload to randomize
-	 *
-	 * @return A randomized buffer for transmission over a serial link
+	 * @param[in,out] io_data The payload to randomize (in place)
+	 * @param start The offset of the first byte to randomize in @p io_data (preceding bytes are left untouched)
 	 */
-	static NSSPI::ByteBuffer dataRandomize(const NSSPI::ByteBuffer& i_data, uint8_t start = 0);
+	static void dataRandomize(NSSPI::FrameBuffer& io_data, std::size_t start = 0);
 
 	/**
 	 * @brief Swap function
@@ -174,7 +181,7 @@ private:
 	 *
 	 * @return The decoded ASH payload if any
 	 */
-	NSSPI::ByteBuffer processInterFlagStream();
+	NSSPI::FrameBuffer processInterFlagStream();
 
 public:
 	CAshCallback *pCb;
@@ -184,7 +191,7 @@ private:
 	uint8_t frmNum; /*!< The sequence number of the next data frame we will send */
 	uint8_t lastReceivedByNEAckNum;	/*!< The ACk value that the near-end (us) will send to acknowledge the last far-end (=from remote) frame, meaning we acknowlegde reception of all frames up to sequence number lastReceivedByNEAckNum-1 */
 	bool stateConnected;	/*!< Are we currently in connected state? (meaning we have an active working ASH handshake between host and NCP) */
-	NSSPI::ByteBuffer in_msg; /*!< Currently accumulated buffer */
+	NSSPI::FrameBuffer in_msg; /*!< Currently accumulated buffer */
 };
 
 /**
@@ -29,7 +29,12 @@ public:
 	 * @param i_cmd The EZSP command
 	 * @param i_msg_receive The payload of the message
 	 */
-	virtual void handleEzspRxMessage( EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_receive ) { /* Default implementation does nothing, add your own handler here in derived observer classes */ }
+	virtual void handleEzspRxMessage( EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive ) { /* Default implementation does nothing, add your own handler here in derived observer classes */ }
+
+	/**
+	 * @brief Method that will be invoked once all EZSP messages decoded from one serial read have been passed to handleEzspRxMessage()
+	 */
+	virtual void handleEzspRxBurstEnd() { /* Default implementation does nothing, add your own handler here in derived observer classes */ }
 
 	/**
 	 * @brief Method that will be invoked when bootloader prompt is caught
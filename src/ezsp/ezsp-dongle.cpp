@@ -7,6 +7,7 @@
 #include <ezsp/byte-manip.h>
 #include "ezsp-dongle.h"
 #include "spi/ILogger.h"
+#include "spi/AllocCounter.h"
 
 DEFINE_ENUM(Mode, EZSP_DONGLE_MODE_LIST, NSEZSP::CEzspDongle);
 
@@ -17,7 +18,7 @@ using NSEZSP::CEzspDongle;
  * But we store it inside a pointer and not a reference because we want to be able to update the value of timerBuilder when invoking swap()
  * and swap cannot be executed on const references but can be executed on non-const pointers to a const reference.
  */
-CEzspDongle::CEzspDongle(const NSSPI::TimerBuilder& i_timer_builder, CEzspDongleObserver* ip_observer) :
+CEzspDongle::CEzspDongle(const NSSPI::TimerBuilder& i_timer_builder, CEzspDongleObserver* ip_observer, std::size_t i_max_queued_commands) :
 	firstStartup(true),
 	version(),
 	lastKnownMode(CEzspDongle::Mode::UNKNOWN),
@@ -28,11 +29,14 @@ CEzspDongle::CEzspDongle(const NSSPI::TimerBuilder& i_timer_builder, CEzspDongle
 	ezspSeqNum(0),
 	ash(static_cast<CAshCallback*>(this), *timerBuilder),
 	blp(*timerBuilder),
-	sendingMsgQueue(),
+	sendingMsgQueue(CEzspDongle::buildSendingMsgQueue(i_max_queued_commands)),
 	sendingMsgQueueMutex(),
+	droppedCommands(0),
 	wait_rsp(false),
 	observers(),
-	ezspWriteMutex() {
+	ezspWriteMutex(),
+	rxEzspMessage() {
+	this->rxEzspMessage.reserve(NSSPI::FrameBuffer::INLINE_CAPACITY);
 	if (ip_observer) {
 		registerObserver(ip_observer);
 	}
@@ -55,8 +59,11 @@ CEzspDongle::CEzspDongle(const CEzspDongle& other) :
 	ash(static_cast<CAshCallback*>(this), *timerBuilder),
 	blp(*timerBuilder),
 	sendingMsgQueue(other.sendingMsgQueue),
-	wait_rsp(other.wait_rsp),
-	observers(other.observers) {
+	droppedCommands(other.droppedCommands.load()),
+	wait_rsp(other.wait_rsp.load()),
+	observers(other.observers),
+	rxEzspMessage() {
+	this->rxEzspMessage.reserve(NSSPI::FrameBuffer::INLINE_CAPACITY);
 	/* By default, no parsing is done on the adapter serial port */
 	this->ash.disable();
 	this->blp.disable();
@@ -85,8 +92,14 @@ void swap(CEzspDongle& first, CEzspDongle& second) {
 	swap(first.ash, second.ash);
 	swap(first.blp, second.blp);
 	swap(first.sendingMsgQueue, second.sendingMsgQueue);
-	swap(first.wait_rsp, second.wait_rsp);
+	bool firstWaitRsp = first.wait_rsp;	/* std::atomic cannot be swapped */
+	first.wait_rsp = second.wait_rsp.load();
+	second.wait_rsp = firstWaitRsp;
+	uint32_t firstDroppedCommands = first.droppedCommands;
+	first.droppedCommands = second.droppedCommands.load();
+	second.droppedCommands = firstDroppedCommands;
 	swap(first.observers, second.observers);
+	swap(first.rxEzspMessage, second.rxEzspMessage);
 	/* Once we have swapped the members of the two instances... the two instances have actually been swapped */
 }
 
@@ -192,6 +205,7 @@ void CEzspDongle::ashCbInfo(AshCodec::EAshInfo info) {
 }
 
 void CEzspDongle::handleInputData(const unsigned char* dataIn, const size_t dataLen) {
+	ALLOC_COUNTING_LAYER(DONGLE);
 	if (this->lastKnownMode != CEzspDongle::Mode::EZSP_NCP && this->lastKnownMode != CEzspDongle::Mode::UNKNOWN) {
 		clogE << "EZSP message recevied while in bootloader prompt mode... Should not reach here\n";
 		/* In bootloader parsing mode, incoming bytes are read directly by the bootloader prompt driver from the serial port */
@@ -199,16 +213,14 @@ void CEzspDongle::handleInputData(const unsigned char* dataIn, const size_t data
 		return;
 	}
 
-	NSSPI::ByteBuffer ezspMessage(dataIn, dataLen);
 	EEzspCmd l_cmd;
-
-	//clogD << "NCP->host EZSP message " << ezspMessage << "\n";
+	size_t headerLen;	/* The size of the EZSP header preceding the payload in dataIn */
 
 	/* Note: this code will handle all successfully decoded incoming EZSP messages */
 	/* It won't be run in bootloader prompt mode, because the ASH driver is then disabled */
 
 	if (this->knownEzspProtocolVersionGE(8)) {	/* EZSPv8 and higher */
-		if (ezspMessage.size() < 5) {	/* EZSPv8 message should contain at least 5 bytes for v8 frames (see protocol format below) */
+		if (dataLen < 5) {	/* EZSPv8 message should contain at least 5 bytes for v8 frames (see protocol format below) */
 			clogE << "EZSP message is too short\n";
 			return;
 		}
@@ -218,49 +230,47 @@ void CEzspDongle::handleInputData(const unsigned char* dataIn, const size_t data
 		*/
 
 		/* Extract the EZSP command (frame ID) and store it into l_cmd */
-		if (ezspMessage.at(4) != 0) {
+		if (dataIn[4] != 0) {
 			clogE << "Unsupported EZSPv8 frame ID (>0xff): 0x" << std::hex << std::setw(2) << std::setfill('0')
-			      << static_cast<unsigned int>(ezspMessage.at(4))
-			      << static_cast<unsigned int>(ezspMessage.at(3)) << "\n";
+			      << static_cast<unsigned int>(dataIn[4])
+			      << static_cast<unsigned int>(dataIn[3]) << "\n";
 			return;
 		}
-		l_cmd = static_cast<EEzspCmd>(ezspMessage.at(3));
-		/* Remove the leading EZSP header from the payload */
-		ezspMessage.erase(ezspMessage.begin(), ezspMessage.begin()+5);
-		/* Payload (frame parameters in Silabs' terminology) will remain in buffer ezspMessage */
+		l_cmd = static_cast<EEzspCmd>(dataIn[3]);
+		/* The leading EZSP header will be skipped, payload (frame parameters in Silabs' terminology) starts after it */
+		headerLen = 5;
 	}
 	else {	/* Unknown EZSP version or version strictly lower than v8 */
-		if (ezspMessage.size() < 4) {	/* EZSP messages (v6 & v7) should contain at least 4 bytes for legacy frames (see protocol format below) */
+		if (dataLen < 4) {	/* EZSP messages (v6 & v7) should contain at least 4 bytes for legacy frames (see protocol format below) */
 			clogE << "EZSP message is too short\n";
 			return;
 		}
 
 		/* Silabs' document ug100-ezsp-reference-guide mentions, for EZSP up to v7, in section 3 Protocol Format, that the EZSP frame format is:
 		* Sequence (1 byte) | Frame Control (1 byte) | Legacy Frame ID (1 byte, almost always 0xFF) | Extended Frame Control (1 byte) | Frame ID (1 byte) | Parameters (n bytes)
-		* Thus, in case we get a legacy frame ID at offset 2, we just get rid of both "Legacy Frame ID" and "Extended Frame Control" and get a frame formatted as legacy frames
+		* Thus, in case we get a legacy frame ID at offset 2, we just skip both "Legacy Frame ID" and "Extended Frame Control" and parse the frame as a legacy frame
 		*/
-		if (ezspMessage.size() >= 3 && ezspMessage.at(2) == 0xffU) { /* 0xff as frame ID means we use an extended header, where frame ID will actually be shifted 2 bytes away... so we just delete those two bytes */
-			if (ezspMessage.size() < 4) {	/* We got Sequence+FC+Legacy indicating an extended FC... but there was nothing more! */
-				clogE << "Truncated extended header in EZSP message\n";
-				return;
-			}
-			ezspMessage.erase(ezspMessage.begin()+2, ezspMessage.begin()+4); /* Remove Legacy Frame ID + Extended Frame Control (offset+4 is kept as per begin() usage conventions)*/
+		size_t frameIdOffset = 2;
+		if (dataIn[2] == 0xffU) { /* 0xff as frame ID means we use an extended header, where frame ID will actually be shifted 2 bytes away */
+			frameIdOffset += 2; /* Skip Legacy Frame ID + Extended Frame Control */
 		}
 
 		/* EZSP message should now contain at least 3 bytes for all frames (reduced to legacy format):
 		* Sequence (1 byte) | Frame Control (1 byte) | Frame ID (1 byte) | Parameters (n bytes)
 		*/
 
-		if (ezspMessage.size() < 3) {	/* EZSP message should contain at least 1 byte for sequence, 1 byte for frame control and a message ID field (1 or 2 bytes) */
+		if (dataLen <= frameIdOffset) {	/* EZSP message should contain at least 1 byte for sequence, 1 byte for frame control and a message ID field (1 or 2 bytes) */
 			clogE << "EZSP message is too short\n";
 			return;
 		}
 		/* Extract the EZSP command (frame ID) and store it into l_cmd */
-		l_cmd = static_cast<EEzspCmd>(ezspMessage.at(2));
-		/* Remove the leading EZSP header from the payload */
-		ezspMessage.erase(ezspMessage.begin(), ezspMessage.begin()+3);
-		/* Payload (frame parameters in Silabs' terminology) will remain in buffer ezspMessage */
+		l_cmd = static_cast<EEzspCmd>(dataIn[frameIdOffset]);
+		/* The leading EZSP header will be skipped, payload (frame parameters in Silabs' terminology) starts after it */
+		headerLen = frameIdOffset + 1;
 	}
+	/* Copy the payload only once, directly out of the decoded ASH frame, into our reused buffer */
+	NSSPI::ByteBuffer& ezspMessage = this->rxEzspMessage;
+	ezspMessage.assign(dataIn + headerLen, dataIn + dataLen);
 	/* Got an correct incoming EZSP message... will be forwarded to the user */
 
 	//clogD << "Received EZSP message payload " << ezspMessage << "\n";
@@ -274,17 +284,40 @@ void CEzspDongle::handleInputData(const unsigned char* dataIn, const size_t data
 	notifyObserversOfEzspRxMessage(l_cmd, ezspMessage);
 }
 
-void CEzspDongle::sendCommand(EEzspCmd i_cmd, NSSPI::ByteBuffer i_cmd_payload ) {
+void CEzspDongle::handleInputBurstEnd() {
+	ALLOC_COUNTING_LAYER(DONGLE);
+	if (this->lastKnownMode != CEzspDongle::Mode::EZSP_NCP && this->lastKnownMode != CEzspDongle::Mode::UNKNOWN) {
+		return;
+	}
+	notifyObserversOfEzspRxBurstEnd();
+}
+
+bool CEzspDongle::sendCommand(EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_cmd_payload ) {
+	ALLOC_COUNTING_LAYER(DONGLE);
 	SMsg l_msg;
 
 	l_msg.i_cmd = i_cmd;
-	l_msg.payload = i_cmd_payload;
+	l_msg.payload.append(i_cmd_payload.data(), i_cmd_payload.size());
 
 	{
 		std::lock_guard<std::mutex> outgoingQueue(this->sendingMsgQueueMutex);
+#ifdef USE_STATIC_ALLOCATION
+		if (!this->sendingMsgQueue.push(l_msg)) {
+			uint32_t l_dropped = ++this->droppedCommands;
+			clogE << "EZSP command queue is full (" << std::dec << this->sendingMsgQueue.capacity() << " commands), dropping command "
+			      << CEzspEnum::EEzspCmdToString(i_cmd) << " (" << l_dropped << " commands dropped so far)\n";
+			return false;
+		}
+#else
 		this->sendingMsgQueue.push(l_msg);
+#endif
 	}
 	this->sendNextMsg();
+	return true;
+}
+
+uint32_t CEzspDongle::getDroppedCommandsCount() const {
+	return this->droppedCommands;
 }
 
 
@@ -294,21 +327,36 @@ void CEzspDongle::sendCommand(EEzspCmd i_cmd, NSSPI::ByteBuffer i_cmd_payload )
  *
  */
 
+CEzspDongle::SMsgQueue CEzspDongle::buildSendingMsgQueue(std::size_t capacity) {
+#ifdef USE_STATIC_ALLOCATION
+	return SMsgQueue(capacity);
+#else
+	(void)capacity;	/* std::queue grows as needed */
+	return SMsgQueue();
+#endif
+}
+
 void CEzspDongle::sendNextMsg( void ) {
 	if (this->lastKnownMode != CEzspDongle::Mode::EZSP_NCP && this->lastKnownMode != CEzspDongle::Mode::UNKNOWN) {
 		clogW << "Refusing to send EZSP messages in bootloader mode\n";
 		return; /* No EZSP message can be sent in bootloader mode */
 	}
 
-	if ( (!this->wait_rsp) && (!this->sendingMsgQueue.empty()) ) {
+	/* Claim the right to send before writing: the response may be handled by the RX thread before the write returns,
+	 * and another thread may be queueing a command at the same time */
+	if (!this->wait_rsp.exchange(true)) {
 		SMsg l_msg;
 		{
 			std::lock_guard<std::mutex> outgoingQueueLock(this->sendingMsgQueueMutex);
+			if (this->sendingMsgQueue.empty()) {
+				this->wait_rsp = false;	/* Under the queue lock: a command queued from now on will be sent by the thread queueing it */
+				return;
+			}
 			l_msg = sendingMsgQueue.front();
 		}
 
 		//clogD << "Sending to NCP EZSP command: " << CEzspEnum::EEzspCmdToString(l_msg.i_cmd) << " with payload " << l_msg.payload << "\n";
-		NSSPI::ByteBuffer ezspMessage;
+		NSSPI::FrameBuffer ezspMessage;	/* Inline storage, no allocation for any regular EZSP command */
 
 		// First, place the EZSP seq number byte
 		ezspMessage.push_back(this->ezspSeqNum++);
@@ -334,8 +382,8 @@ void CEzspDongle::sendNextMsg( void ) {
 		//clogD << "host->NCP EZSP message " << ezspMessage << "\n";
 		{
 			std::lock_guard<std::mutex> ezspWriteLock(this->ezspWriteMutex);
-			if (this->ash.sendDataFrame(ezspMessage)) {
-				this->wait_rsp = true;
+			if (!this->ash.sendDataFrame(ezspMessage.data(), ezspMessage.size())) {
+				this->wait_rsp = false;
 			}
 		}
 	}
@@ -346,11 +394,11 @@ void CEzspDongle::sendNextMsg( void ) {
  * Managing Observer of this class
  */
 bool CEzspDongle::registerObserver(CEzspDongleObserver* observer) {
-	return this->observers.emplace(observer).second;
+	return this->observers.add(observer);
 }
 
 bool CEzspDongle::unregisterObserver(CEzspDongleObserver* observer) {
-	return static_cast<bool>(this->observers.erase(observer));
+	return this->observers.remove(observer);
 }
 
 void CEzspDongle::forceFirmwareUpgradeOnInitTimeout() {
@@ -402,27 +450,33 @@ void CEzspDongle::setMode(CEzspDongle::Mode requestedMode) {
 }
 
 void CEzspDongle::notifyObserversOfDongleState( EDongleState i_state ) {
-	for(auto observer : this->observers) {
+	this->observers.forEach([&i_state](CEzspDongleObserver* observer) {
 		observer->handleDongleState(i_state);
-	}
+	});
 }
 
-void CEzspDongle::notifyObserversOfEzspRxMessage( EEzspCmd i_cmd, NSSPI::ByteBuffer i_message ) {
-	for(auto observer : this->observers) {
+void CEzspDongle::notifyObserversOfEzspRxMessage( EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_message ) {
+	this->observers.forEach([&i_cmd, &i_message](CEzspDongleObserver* observer) {
 		observer->handleEzspRxMessage(i_cmd, i_message);
-	}
+	});
+}
+
+void CEzspDongle::notifyObserversOfEzspRxBurstEnd() {
+	this->observers.forEach([](CEzspDongleObserver* observer) {
+		observer->handleEzspRxBurstEnd();
+	});
 }
 
 void CEzspDongle::notifyObserversOfBootloaderPrompt() {
-	for(auto observer : this->observers) {
+	this->observers.forEach([](CEzspDongleObserver* observer) {
 		observer->handleBootloaderPrompt();
-	}
+	});
 }
 
 void CEzspDongle::notifyObserversOfFirmwareXModemXfrReady() {
-	for(auto observer : this->observers) {
+	this->observers.forEach([](CEzspDongleObserver* observer) {
 		observer->handleFirmwareXModemXfr();
-	}
+	});
 }
 
 void CEzspDongle::handleDongleState( EDongleState i_state ) {
@@ -439,15 +493,15 @@ void CEzspDongle::handleResponse(EEzspCmd i_cmd) {
 			*/
 			clogE << "Received a message with a non-empty queue while no response was expected\n";
 		}
-		SMsg l_msgQ;
+		bool isResponse;
 		{
 			std::lock_guard<std::mutex> outgoingQueue(this->sendingMsgQueueMutex);
-			l_msgQ = sendingMsgQueue.front();
-			if (l_msgQ.i_cmd == i_cmd ) { /* Make sure that the EZSP message is a response to the last command we sent */
+			isResponse = (sendingMsgQueue.front().i_cmd == i_cmd); /* Make sure that the EZSP message is a response to the last command we sent (compare in place, no need to copy the queued message) */
+			if (isResponse) {
 				this->sendingMsgQueue.pop();	/* Remove the message that was acknowledged from out queue */
 			}
 		}
-		if (l_msgQ.i_cmd == i_cmd) { /* Make sure that the EZSP message is a response to the last command we sent */
+		if (isResponse) {
 			this->wait_rsp = false;
 			this->sendNextMsg();
 		}
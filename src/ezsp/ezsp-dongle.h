@@ -10,6 +10,7 @@
 #include <iostream>
 #include <queue>
 #include <set>
+#include <atomic>
 
 #include <ezsp/ezsp-protocol/ezsp-enum.h>
 #include <ezsp/ezsp-adapter-version.h>
@@ -18,6 +19,9 @@
 #include <spi/TimerBuilder.h>
 #include <spi/IAsyncDataInputObserver.h>
 #include <spi/ByteBuffer.h>
+#include <spi/FrameBuffer.h>
+#include <spi/ObserverList.h>
+#include <spi/FixedCapacityQueue.h>
 
 #include "ash-driver.h"
 #include "bootloader-prompt-driver.h"
@@ -27,7 +31,7 @@
 extern "C" {	/* Avoid compiler warning on member initialization for structs (in -Weffc++ mode) */
 	typedef struct {
 		NSEZSP::EEzspCmd i_cmd;	/*!< The EZSP command to send */
-		NSSPI::ByteBuffer payload;	/*!< The payload for the EZSP command (as a byte buffer) */
+		NSSPI::FrameBuffer payload;	/*!< The payload for the EZSP command (stored inline, so that queue slots never allocate) */
 	} SMsg;
 }
 namespace NSEZSP {
@@ -61,10 +65,11 @@ public:
 	 *
 	 * @param[in] i_timer_builder A timer builder used to build timer objects
 	 * @param[in] ip_observer An optional observer that will be notified when dongle state changes and when a EZSP message is received
+	 * @param[in] i_max_queued_commands The maximum number of EZSP commands waiting to be sent to the adapter (only enforced in static allocation builds)
 	 *
 	 * @note Observers can also be registered later on using method registerObserver()
 	 */
-	CEzspDongle(const NSSPI::TimerBuilder& i_timer_builder, CEzspDongleObserver* ip_observer = nullptr);
+	CEzspDongle(const NSSPI::TimerBuilder& i_timer_builder, CEzspDongleObserver* ip_observer = nullptr, std::size_t i_max_queued_commands = 256);
 
 	/**
 	 * @brief Default constructor
@@ -159,8 +164,17 @@ public:
 	 *
 	 * @param i_cmd The EZSP command to send
 	 * @param i_cmd_payload The payload
+	 *
+	 * @return true if the command was queued, false if it was dropped because the outgoing queue is full (only in static allocation builds, see CEzspCapacities::maxQueuedCommands)
+	 */
+	bool sendCommand(EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_cmd_payload = NSSPI::ByteBuffer() );
+
+	/**
+	 * @brief Get the number of EZSP commands dropped because the outgoing queue was full
+	 *
+	 * @return The number of commands dropped since this dongle was created
 	 */
-	void sendCommand(EEzspCmd i_cmd, NSSPI::ByteBuffer i_cmd_payload = NSSPI::ByteBuffer() );
+	uint32_t getDroppedCommandsCount() const;
 
 	/**
 	 * @brief Callback invoked on EZSP received bytes
@@ -170,6 +184,11 @@ public:
 	 */
 	void handleInputData(const unsigned char* dataIn, const size_t dataLen);
 
+	/**
+	 * @brief Callback invoked once all EZSP messages decoded from one serial read have been passed to handleInputData()
+	 */
+	void handleInputBurstEnd();
+
 	/**
 	 * @brief Callback invoked on ASH info
 	 *
@@ -179,6 +198,10 @@ public:
 
 	/**
 	 * Managing Observer of this class
+	 *
+	 * unregisterObserver() waits until notifications in progress on other threads are over: once it returns, the observer will not be
+	 * invoked anymore and can be destroyed. When invoked from a notification of this dongle, notifications in progress on other threads
+	 * are not waited for. Do not invoke it while holding a lock that the observer takes in its handlers.
 	 */
 	bool registerObserver(CEzspDongleObserver* observer);
 	bool unregisterObserver(CEzspDongleObserver* observer);
@@ -218,6 +241,12 @@ public:
 	CEzspDongle& operator=(const CEzspDongle other);
 
 private:
+#ifdef USE_STATIC_ALLOCATION
+	typedef NSSPI::FixedCapacityQueue<SMsg> SMsgQueue;	/*!< Outgoing EZSP messages, storage allocated at construction */
+#else
+	typedef std::queue<SMsg> SMsgQueue;	/*!< Outgoing EZSP messages */
+#endif
+
 	bool firstStartup;  /*!< Is this the first attempt to exchange with the dongle? If so, we will probe to check if the adapter is in EZSP or bootloader prompt mode */
 	NSEZSP::EzspAdapterVersion version; /*!< The version details of this EZSP adapter (firmware and hardware) */
 	CEzspDongle::Mode lastKnownMode;    /*!< What is the current adapter mode (bootloader, EZSP/ASH mode etc.) */
@@ -228,11 +257,22 @@ private:
 	uint8_t ezspSeqNum;	/*!< The EZSP sequence number (wrapping 0-255 counter) */
 	NSEZSP::AshDriver ash;   /*!< An ASH encoder/decoder instance */
 	NSEZSP::BootloaderPromptDriver blp;  /*!< A bootloader prompt decoder instance */
-	std::queue<SMsg> sendingMsgQueue;	/*!< The EZSP messages queued to be sent to the adapter */
+	SMsgQueue sendingMsgQueue;	/*!< The EZSP messages queued to be sent to the adapter */
 	std::mutex sendingMsgQueueMutex;	/*!< A mutex protecting access to attribute sendingMsgQueue */
-	bool wait_rsp;	/*!< Are we currently waiting for an EZSP response to an EZSP command we have sent? */
-	std::set<CEzspDongleObserver*> observers;	/*!< List of observers of this instance */
+	std::atomic<uint32_t> droppedCommands;	/*!< Number of commands dropped because sendingMsgQueue was full */
+	std::atomic<bool> wait_rsp;	/*!< Are we currently waiting for an EZSP response to an EZSP command we have sent (or sending one)? */
+	NSSPI::ObserverList<CEzspDongleObserver> observers;	/*!< List of observers of this instance (copy-on-write, can be notified while being modified from another thread) */
 	std::mutex ezspWriteMutex;	/*!< Mutex allowing exclusive writes to the EZSP adapter */
+	NSSPI::ByteBuffer rxEzspMessage;	/*!< Storage for the payload of the last incoming EZSP message, reused from one message to the next to avoid reallocating it */
+
+	/**
+	 * @brief Create an empty outgoing EZSP message queue
+	 *
+	 * @param capacity The maximum number of messages in the queue (only used in static allocation builds)
+	 *
+	 * @return The new queue
+	 */
+	static SMsgQueue buildSendingMsgQueue(std::size_t capacity);
 
 	/**
 	 * @brief Send the next message in our EZSP message queue (sendingMsgQueue)
@@ -252,7 +292,12 @@ private:
 	 * @param i_cmd The EZSP command received
 	 * @param i_message The payload of the EZSP command
 	 */
-	void notifyObserversOfEzspRxMessage( EEzspCmd i_cmd, NSSPI::ByteBuffer i_message );
+	void notifyObserversOfEzspRxMessage( EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_message );
+
+	/**
+	 * @brief Notify all observers of this instance that the current burst of incoming EZSP messages is over
+	 */
+	void notifyObserversOfEzspRxBurstEnd();
 
 	/**
 	 * @brief Notify all observers of this instance that the dongle is running the booloader and that a bootloader prompt has been detected
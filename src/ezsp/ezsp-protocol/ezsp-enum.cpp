@@ -10,7 +10,7 @@
 using NSEZSP::CEzspEnum;
 
 std::string CEzspEnum::EmberNodeTypeToString( EmberNodeType in ) {
-	const std::map<EmberNodeType,std::string> MyEnumStrings {
+	static const std::map<EmberNodeType,std::string> MyEnumStrings {
 		{ EMBER_UNKNOWN_DEVICE, "EMBER_UNKNOWN_DEVICE" },
 		{ EMBER_COORDINATOR, "EMBER_COORDINATOR" },
 		{ EMBER_ROUTER, "EMBER_ROUTER" },
@@ -22,7 +22,7 @@ std::string CEzspEnum::EmberNodeTypeToString( EmberNodeType in ) {
 }
 
 std::string CEzspEnum::EEmberStatusToString( EEmberStatus in ) {
-	const std::map<EEmberStatus,std::string> MyEnumStrings {
+	static const std::map<EEmberStatus,std::string> MyEnumStrings {
 		{ EMBER_SUCCESS, "EMBER_SUCCESS" },
 		{ EMBER_ERR_FATAL, "EMBER_ERR_FATAL" },
 		{ EMBER_NO_BUFFERS, "EMBER_NO_BUFFERS" },
@@ -54,7 +54,7 @@ std::string CEzspEnum::EEmberStatusToString( EEmberStatus in ) {
 }
 
 std::string CEzspEnum::EmberJoinMethodToString( EmberJoinMethod in ) {
-	const std::map<EmberJoinMethod,std::string> MyEnumStrings {
+	static const std::map<EmberJoinMethod,std::string> MyEnumStrings {
 		{ EMBER_USE_MAC_ASSOCIATION, "EMBER_USE_MAC_ASSOCIATION" },
 		{ EMBER_USE_NWK_REJOIN, "EMBER_USE_NWK_REJOIN" },
 		{ EMBER_USE_NWK_REJOIN_HAVE_NWK_KEY, "EMBER_USE_NWK_REJOIN_HAVE_NWK_KEY" },
@@ -65,7 +65,7 @@ std::string CEzspEnum::EmberJoinMethodToString( EmberJoinMethod in ) {
 }
 
 std::string CEzspEnum::EEzspCmdToString( EEzspCmd in ) {
-	const std::map<EEzspCmd,std::string> MyEnumStrings {
+	static const std::map<EEzspCmd,std::string> MyEnumStrings {
 		/* Configuration Frames */
 		{ EZSP_VERSION, "EZSP_VERSION" },
 		{ EZSP_GET_CONFIGURATION_VALUE, "EZSP_GET_CONFIGURATION_VALUE" },
@@ -291,7 +291,7 @@ std::string CEzspEnum::EEzspCmdToString( EEzspCmd in ) {
 }
 
 std::string CEzspEnum::EmberKeyTypeToString( EmberKeyType in ) {
-	const std::map<EmberKeyType,std::string> MyEnumStrings {
+	static const std::map<EmberKeyType,std::string> MyEnumStrings {
 		{ EMBER_TRUST_CENTER_LINK_KEY, "EMBER_TRUST_CENTER_LINK_KEY" },
 		{ EMBER_CURRENT_NETWORK_KEY, "EMBER_CURRENT_NETWORK_KEY" },
 		{ EMBER_NEXT_NETWORK_KEY, "EMBER_NEXT_NETWORK_KEY" },
@@ -303,7 +303,7 @@ std::string CEzspEnum::EmberKeyTypeToString( EmberKeyType in ) {
 
 
 std::string CEzspEnum::EmberIncomingMessageTypeToString( EmberIncomingMessageType in ) {
-	const std::map<EmberIncomingMessageType,std::string> MyEnumStrings {
+	static const std::map<EmberIncomingMessageType,std::string> MyEnumStrings {
 		{ EMBER_INCOMING_UNICAST, "EMBER_INCOMING_UNICAST" },
 		{ EMBER_INCOMING_UNICAST_REPLY, "EMBER_INCOMING_UNICAST_REPLY" },
 		{ EMBER_INCOMING_MULTICAST, "EMBER_INCOMING_MULTICAST" },
@@ -10,12 +10,25 @@
 
 using NSEZSP::CGetNetworkParametersResponse;
 
-CGetNetworkParametersResponse::CGetNetworkParametersResponse(const NSSPI::ByteBuffer& raw_message) :
-	status(static_cast<EEmberStatus>(raw_message.at(0))),
-	node_type(static_cast<EmberNodeType>(raw_message.at(1))),
-	parameters(raw_message,2)
+CGetNetworkParametersResponse::CGetNetworkParametersResponse(NSSPI::ByteView raw_message) :
+	status(),
+	node_type(),
+	parameters() {
+	NSSPI::ByteReader reader(raw_message);
+	this->parse(reader);
+}
+
+CGetNetworkParametersResponse::CGetNetworkParametersResponse(NSSPI::ByteReader& reader) :
+	status(),
+	node_type(),
+	parameters() {
+	this->parse(reader);
+}
 
-{
+void CGetNetworkParametersResponse::parse(NSSPI::ByteReader& reader) {
+	this->status = static_cast<EEmberStatus>(reader.readU8());
+	this->node_type = static_cast<EmberNodeType>(reader.readU8());
+	this->parameters = CEmberNetworkParameters(reader);
 }
 
 std::string CGetNetworkParametersResponse::String() const {
@@ -9,6 +9,8 @@
 #include "ezsp/ezsp-protocol/ezsp-enum.h"
 #include "ezsp/ezsp-protocol/struct/ember-network-parameters.h"
 #include "spi/ByteBuffer.h"
+#include "spi/ByteView.h"
+#include "spi/ByteReader.h"
 
 namespace NSEZSP {
 
@@ -26,7 +28,14 @@ public:
 	 *
 	 * @param raw_message The buffer to construct from
 	 */
-	explicit CGetNetworkParametersResponse(const NSSPI::ByteBuffer& raw_message);
+	explicit CGetNetworkParametersResponse(NSSPI::ByteView raw_message);
+
+	/**
+	 * @brief Construction from the current position of a reader
+	 *
+	 * @param reader The reader to consume the structure from (its error flag is raised if there are not enough bytes)
+	 */
+	explicit CGetNetworkParametersResponse(NSSPI::ByteReader& reader);
 
 	/**
 	 * @brief Copy constructor
@@ -85,6 +94,13 @@ public:
 
 
 private:
+	/**
+	 * @brief Read all fields out of a reader
+	 *
+	 * @param reader The reader to consume the structure from
+	 */
+	void parse(NSSPI::ByteReader& reader);
+
 	EEmberStatus status;
 	EmberNodeType node_type;
 	CEmberNetworkParameters parameters;
@@ -11,23 +11,46 @@
 
 #include "spi/Logger.h"
 #include "ezsp/byte-manip.h"
+#include "spi/ByteReader.h"
 
 using NSEZSP::CEmberChildDataStruct;
 
-CEmberChildDataStruct::CEmberChildDataStruct(const NSSPI::ByteBuffer& raw_message) :
+CEmberChildDataStruct::CEmberChildDataStruct(NSSPI::ByteView raw_message) :
 	eui64(),
-	type(static_cast<EmberNodeType>(raw_message.at(EMBER_EUI64_BYTE_SIZE))),
-	id(static_cast<EmberNodeId>(dble_u8_to_u16(raw_message.at(EMBER_EUI64_BYTE_SIZE+2), raw_message.at(EMBER_EUI64_BYTE_SIZE+1)))),
-	phy(raw_message.at(EMBER_EUI64_BYTE_SIZE+3)),
-	power(raw_message.at(EMBER_EUI64_BYTE_SIZE+4)),
-	timeout(raw_message.at(EMBER_EUI64_BYTE_SIZE+5)),
+	type(),
+	id(),
+	phy(),
+	power(),
+	timeout(),
 	gpdIeeeAddress(),	/* FIXME */
 	sourceId(),	/* FIXME */
 	applicationId(), /* FIXME */
 	endpoint() { /* FIXME */
-	for (unsigned int loop=0; loop<EMBER_EUI64_BYTE_SIZE; loop++) {
-		eui64.at(loop) = raw_message.at(loop);
-	}
+	NSSPI::ByteReader reader(raw_message);
+	this->parse(reader);
+}
+
+CEmberChildDataStruct::CEmberChildDataStruct(NSSPI::ByteReader& reader) :
+	eui64(),
+	type(),
+	id(),
+	phy(),
+	power(),
+	timeout(),
+	gpdIeeeAddress(),	/* FIXME */
+	sourceId(),	/* FIXME */
+	applicationId(), /* FIXME */
+	endpoint() { /* FIXME */
+	this->parse(reader);
+}
+
+void CEmberChildDataStruct::parse(NSSPI::ByteReader& reader) {
+	reader.readBytes(this->eui64);
+	this->type = static_cast<EmberNodeType>(reader.readU8());
+	this->id = static_cast<EmberNodeId>(reader.readU16le());
+	this->phy = reader.readU8();
+	this->power = reader.readU8();
+	this->timeout = reader.readU8();
 	//    if( raw_message.size() > 17 ) // todo associate to node type
 	//    {
 	//        gpdIeeeAddress.clear();
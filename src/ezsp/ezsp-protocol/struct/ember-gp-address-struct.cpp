@@ -5,6 +5,7 @@
  */
 #include <sstream>
 #include <iomanip>
+#include <stdexcept>
 
 #include "ezsp/byte-manip.h"
 #include "ember-gp-address-struct.h"
@@ -21,15 +22,30 @@ applicationId(),
 endpoint() {
 }
 
-CEmberGpAddressStruct::CEmberGpAddressStruct(const NSSPI::ByteBuffer& raw_message):
-	applicationId(raw_message.at(0)),
+CEmberGpAddressStruct::CEmberGpAddressStruct(NSSPI::ByteView raw_message):
+	applicationId(),
 	gpdIeeeAddress(),
-	endpoint(raw_message.at(EMBER_EUI64_BYTE_SIZE+1)) {
-	for (unsigned int loop=0; loop<EMBER_EUI64_BYTE_SIZE; loop++) {
-		gpdIeeeAddress.at(loop) = raw_message.at(1+loop);
+	endpoint() {
+	NSSPI::ByteReader reader(raw_message);
+	this->parse(reader);
+	if (reader.hasError()) {
+		throw std::out_of_range("CEmberGpAddressStruct: truncated buffer");
 	}
 }
 
+CEmberGpAddressStruct::CEmberGpAddressStruct(NSSPI::ByteReader& reader):
+	applicationId(),
+	gpdIeeeAddress(),
+	endpoint() {
+	this->parse(reader);
+}
+
+void CEmberGpAddressStruct::parse(NSSPI::ByteReader& reader) {
+	this->applicationId = reader.readU8();
+	reader.readBytes(this->gpdIeeeAddress);
+	this->endpoint = reader.readU8();
+}
+
 CEmberGpAddressStruct::CEmberGpAddressStruct(const uint32_t i_srcId):
 	// IEEE address will contain the source ID duplicated twice
 	gpdIeeeAddress( {
@@ -47,20 +63,22 @@ endpoint(0) {
 }
 
 NSSPI::ByteBuffer CEmberGpAddressStruct::getRaw() const {
-	NSSPI::ByteBuffer lo_raw;
+	NSSPI::FrameBuffer lo_raw;
 
+	this->appendRaw(lo_raw);
+
+	return lo_raw.toByteBuffer();
+}
+
+void CEmberGpAddressStruct::appendRaw(NSSPI::FrameBuffer& o_raw) const {
 	// application Id
-	lo_raw.push_back(applicationId);
+	o_raw.push_back(applicationId);
 
 	// Ieee | sourceId
-	for(uint8_t loop=0; loop<EMBER_EUI64_BYTE_SIZE; loop++) {
-		lo_raw.push_back(gpdIeeeAddress.at(loop));
-	}
+	o_raw.append(gpdIeeeAddress);
 
 	// endpoint
-	lo_raw.push_back(endpoint);
-
-	return lo_raw;
+	o_raw.push_back(endpoint);
 }
 
 std::string CEmberGpAddressStruct::toString() const {
@@ -8,6 +8,9 @@
 #include "ezsp/ezsp-protocol/ezsp-enum.h"
 #include "ezsp/byte-manip.h"
 #include "spi/ByteBuffer.h"
+#include "spi/FrameBuffer.h"
+#include "spi/ByteView.h"
+#include "spi/ByteReader.h"
 
 namespace NSEZSP {
 
@@ -23,7 +26,14 @@ public:
 	 *
 	 * @param raw_message The buffer to construct from
 	 */
-	explicit CEmberGpAddressStruct(const NSSPI::ByteBuffer& raw_message);
+	explicit CEmberGpAddressStruct(NSSPI::ByteView raw_message);
+
+	/**
+	 * @brief Construction from the current position of a reader
+	 *
+	 * @param reader The reader to consume the structure from (its error flag is raised if there are not enough bytes)
+	 */
+	explicit CEmberGpAddressStruct(NSSPI::ByteReader& reader);
 
 	/**
 	 * @brief Construct from sourceId
@@ -67,6 +77,13 @@ public:
 	 */
 	NSSPI::ByteBuffer getRaw() const;
 
+	/**
+	 * @brief Append the raw representation of this structure to a frame buffer
+	 *
+	 * @param[out] o_raw The buffer to append to
+	 */
+	void appendRaw(NSSPI::FrameBuffer& o_raw) const;
+
 	/**
 	 * @brief Dump this instance as a string
 	 *
@@ -88,6 +105,13 @@ public:
 	}
 
 private:
+	/**
+	 * @brief Read all fields out of a reader
+	 *
+	 * @param reader The reader to consume the structure from
+	 */
+	void parse(NSSPI::ByteReader& reader);
+
 	uint8_t applicationId; /*!< The GPD Application ID */
 	EmberEUI64 gpdIeeeAddress; /*!< The GPD's EUI64 */
 	uint8_t endpoint; /*!< The GPD endpoint */
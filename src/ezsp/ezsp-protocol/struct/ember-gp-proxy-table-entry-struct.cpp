@@ -6,6 +6,7 @@
 
 #include <sstream>
 #include <iomanip>
+#include <stdexcept>
 
 #include "ezsp/ezsp-protocol/struct/ember-gp-proxy-table-entry-struct.h"
 
@@ -14,19 +15,49 @@
 using NSEZSP::CEmberGpProxyTableEntryStruct;
 
 /** \todo Verify value !!! */
-CEmberGpProxyTableEntryStruct::CEmberGpProxyTableEntryStruct(const NSSPI::ByteBuffer& raw_message) :
-	/*security_link_key(raw_message.begin(),raw_message.begin()+EMBER_KEY_DATA_BYTE_SIZE),*/
-	status(raw_message.at(0)),
-	options(quad_u8_to_u32(raw_message.at(4),raw_message.at(3),raw_message.at(2),raw_message.at(1))),
-	gpd(NSSPI::ByteBuffer(raw_message.begin()+5,raw_message.end())),
-	assigned_alias(dble_u8_to_u16(raw_message.at(16),raw_message.at(15))),
-	security_options(raw_message.at(17)),
-	gpdSecurityFrameCounter(static_cast<EmberGpSecurityFrameCounter>(quad_u8_to_u32(raw_message.at(21),raw_message.at(20),raw_message.at(19),raw_message.at(18)))),
+CEmberGpProxyTableEntryStruct::CEmberGpProxyTableEntryStruct(NSSPI::ByteView raw_message) :
+	/*security_link_key(),*/
+	status(),
+	options(),
+	gpd(),
+	assigned_alias(),
+	security_options(),
+	gpdSecurityFrameCounter(),
 	gpd_key(),
 	sink_list(),
-	groupcast_radius(raw_message.at(60)),
-	search_counter(raw_message.at(61)) {
-	for (unsigned int loop=0; loop<EMBER_KEY_DATA_BYTE_SIZE; loop++) {
-		gpd_key.at(loop) = raw_message.at(22U+loop);
+	groupcast_radius(),
+	search_counter() {
+	NSSPI::ByteReader reader(raw_message);
+	this->parse(reader);
+	if (reader.hasError()) {
+		throw std::out_of_range("CEmberGpProxyTableEntryStruct: truncated buffer");
 	}
 }
+
+CEmberGpProxyTableEntryStruct::CEmberGpProxyTableEntryStruct(NSSPI::ByteReader& reader) :
+	/*security_link_key(),*/
+	status(),
+	options(),
+	gpd(),
+	assigned_alias(),
+	security_options(),
+	gpdSecurityFrameCounter(),
+	gpd_key(),
+	sink_list(),
+	groupcast_radius(),
+	search_counter() {
+	this->parse(reader);
+}
+
+void CEmberGpProxyTableEntryStruct::parse(NSSPI::ByteReader& reader) {
+	this->status = reader.readU8();
+	this->options = reader.readU32le();
+	this->gpd = CEmberGpAddressStruct(reader);
+	this->assigned_alias = reader.readU16le();
+	this->security_options = reader.readU8();
+	this->gpdSecurityFrameCounter = static_cast<EmberGpSecurityFrameCounter>(reader.readU32le());
+	reader.readBytes(this->gpd_key);
+	reader.skip(GP_SINK_LIST_ENTRIES * EMBER_GP_SINK_LIST_ENTRY_SIZE);	/* Sink list is not decoded */
+	this->groupcast_radius = reader.readU8();
+	this->search_counter = reader.readU8();
+}
@@ -26,7 +26,14 @@ public:
 	 *
 	 * @param raw_message The buffer to construct from
 	 */
-	explicit CEmberGpProxyTableEntryStruct(const NSSPI::ByteBuffer& raw_message);
+	explicit CEmberGpProxyTableEntryStruct(NSSPI::ByteView raw_message);
+
+	/**
+	 * @brief Construction from the current position of a reader
+	 *
+	 * @param reader The reader to consume the structure from (its error flag is raised if there are not enough bytes)
+	 */
+	explicit CEmberGpProxyTableEntryStruct(NSSPI::ByteReader& reader);
 
 	/**
 	 * @brief Copy constructor
@@ -51,8 +58,33 @@ public:
 		return gpd;
 	}
 
+	/**
+	 * @brief options getter
+	 *
+	 * @return The tunneling options
+	 */
+	uint32_t getOptions() const {
+		return options;
+	}
+
+	/**
+	 * @brief Is this entry in use?
+	 *
+	 * @return true if the entry holds a GPD, false if it is blank
+	 */
+	bool isActive() const {
+		return status==0x01;
+	}
+
 
 private:
+	/**
+	 * @brief Read all fields out of a reader
+	 *
+	 * @param reader The reader to consume the structure from
+	 */
+	void parse(NSSPI::ByteReader& reader);
+
 	// EmberKeyData security_link_key; /*!< The link key to be used to secure this pairing link. */ -- WRONG SPEC
 	EmberGpProxyTableEntryStatus status; /*!< Internal status of the proxy table entry. */
 	uint32_t options; /*!< The tunneling options (this contains both options and extendedOptions from the spec). */
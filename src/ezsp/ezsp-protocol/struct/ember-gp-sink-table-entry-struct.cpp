@@ -6,6 +6,7 @@
 
 #include <sstream>
 #include <iomanip>
+#include <stdexcept>
 
 #include "ezsp/ezsp-protocol/struct/ember-gp-sink-table-entry-struct.h"
 #include "ezsp/byte-manip.h"
@@ -31,22 +32,31 @@ CEmberGpSinkTableEntryStruct::CEmberGpSinkTableEntryStruct():
 CEmberGpSinkTableEntryStruct::~CEmberGpSinkTableEntryStruct() {
 }
 
-CEmberGpSinkTableEntryStruct::CEmberGpSinkTableEntryStruct(const NSSPI::ByteBuffer& raw_message):
-	status(raw_message.at(0)),
-	options(dble_u8_to_u16(raw_message.at(2),raw_message.at(1))),
-	gpd(NSSPI::ByteBuffer(raw_message.begin()+3,raw_message.end())),
-	device_id(raw_message.at(13)),
-	sink_list(),
-	assigned_alias(dble_u8_to_u16(raw_message.at(37),raw_message.at(36))),
-	groupcast_radius(raw_message.at(38)),
-	security_options(raw_message.at(39)),
-	gpdSecurity_frame_counter(static_cast<EmberGpSecurityFrameCounter>(quad_u8_to_u32(raw_message.at(43),raw_message.at(42),raw_message.at(41),raw_message.at(40)))),
-	gpd_key() {
-	for (unsigned int loop=0; loop<EMBER_KEY_DATA_BYTE_SIZE; loop++) {
-		gpd_key.at(loop) = raw_message.at(44U+loop);
+CEmberGpSinkTableEntryStruct::CEmberGpSinkTableEntryStruct(NSSPI::ByteView raw_message):
+	CEmberGpSinkTableEntryStruct() {
+	NSSPI::ByteReader reader(raw_message);
+	this->parse(reader);
+	if (reader.hasError()) {
+		throw std::out_of_range("CEmberGpSinkTableEntryStruct: truncated buffer");
 	}
-	sink_list[0].push_back(0xFF);
-	sink_list[1].push_back(0xFF);
+}
+
+CEmberGpSinkTableEntryStruct::CEmberGpSinkTableEntryStruct(NSSPI::ByteReader& reader):
+	CEmberGpSinkTableEntryStruct() {
+	this->parse(reader);
+}
+
+void CEmberGpSinkTableEntryStruct::parse(NSSPI::ByteReader& reader) {
+	this->status = reader.readU8();
+	this->options = CEmberGpSinkTableOption(reader.readU16le());
+	this->gpd = CEmberGpAddressStruct(reader);
+	this->device_id = reader.readU8();
+	reader.skip(GP_SINK_LIST_ENTRIES * EMBER_GP_SINK_LIST_ENTRY_SIZE);	/* Sink list is not decoded, we always use our own (disabled) sink list */
+	this->assigned_alias = reader.readU16le();
+	this->groupcast_radius = reader.readU8();
+	this->security_options = reader.readU8();
+	this->gpdSecurity_frame_counter = static_cast<EmberGpSecurityFrameCounter>(reader.readU32le());
+	reader.readBytes(this->gpd_key);
 }
 
 CEmberGpSinkTableEntryStruct::CEmberGpSinkTableEntryStruct(EmberGpSinkTableEntryStatus i_status, CEmberGpSinkTableOption i_options,
@@ -67,7 +77,7 @@ CEmberGpSinkTableEntryStruct::CEmberGpSinkTableEntryStruct(EmberGpSinkTableEntry
 }
 
 NSSPI::ByteBuffer CEmberGpSinkTableEntryStruct::getRaw() const {
-	NSSPI::ByteBuffer l_struct;
+	NSSPI::FrameBuffer l_struct;
 
 	// Internal status of the sink table entry.
 	l_struct.push_back(status); // 0x01 : active, 0xff : disable
@@ -75,13 +85,12 @@ NSSPI::ByteBuffer CEmberGpSinkTableEntryStruct::getRaw() const {
 	l_struct.push_back(u16_get_lo_u8(options.get()));
 	l_struct.push_back(u16_get_hi_u8(options.get()));
 	// The addressing info of the GPD.
-	NSSPI::ByteBuffer l_addr = gpd.getRaw();
-	l_struct.insert(l_struct.end(), l_addr.begin(), l_addr.end());
+	gpd.appendRaw(l_struct);
 	// The device id for the GPD.
 	l_struct.push_back(device_id);
 	// The list of sinks (hardcoded to 2 which is the spec minimum).
 	for( int loop=0; loop<GP_SINK_LIST_ENTRIES; loop++ ) {
-		l_struct.insert(l_struct.end(), sink_list[loop].begin(), sink_list[loop].end());
+		l_struct.append(sink_list[loop].data(), sink_list[loop].size());
 	}
 	// The assigned alias for the GPD.
 	l_struct.push_back(u16_get_lo_u8(assigned_alias));
@@ -97,9 +106,9 @@ NSSPI::ByteBuffer CEmberGpSinkTableEntryStruct::getRaw() const {
 	l_struct.push_back(u32_get_byte3(gpdSecurity_frame_counter));
 
 	// The key to use for GPD.
-	l_struct.insert(l_struct.end(), gpd_key.begin(), gpd_key.end());
+	l_struct.append(gpd_key);
 
-	return l_struct;
+	return l_struct.toByteBuffer();
 }
 
 
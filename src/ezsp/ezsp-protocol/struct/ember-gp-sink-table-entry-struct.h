@@ -30,7 +30,14 @@ public:
 	 *
 	 * @param raw_message The buffer to construct from
 	 */
-	explicit CEmberGpSinkTableEntryStruct(const NSSPI::ByteBuffer& raw_message);
+	explicit CEmberGpSinkTableEntryStruct(NSSPI::ByteView raw_message);
+
+	/**
+	 * @brief Construction from the current position of a reader
+	 *
+	 * @param reader The reader to consume the structure from (its error flag is raised if there are not enough bytes)
+	 */
+	explicit CEmberGpSinkTableEntryStruct(NSSPI::ByteReader& reader);
 
 	/**
 	 * @brief constructor with specific value, others are set to default value.
@@ -87,6 +94,9 @@ public:
 	uint8_t getGroupcastRadius() const {
 		return groupcast_radius;
 	}
+	uint8_t getSecurityOption() const {
+		return security_options;
+	}
 	uint8_t getSecurityLevel() const {
 		return security_options&0x03;
 	}
@@ -132,6 +142,13 @@ public:
 		assigned_alias=i_alias;
 	}
 
+	/**
+	 * @brief groupcast_radius setter
+	 */
+	void setGroupcastRadius(uint8_t i_groupcast_radius) {
+		groupcast_radius=i_groupcast_radius;
+	}
+
 	/**
 	 * @brief security_options setter
 	 */
@@ -174,6 +191,13 @@ public:
 	}
 
 private:
+	/**
+	 * @brief Read all fields out of a reader
+	 *
+	 * @param reader The reader to consume the structure from
+	 */
+	void parse(NSSPI::ByteReader& reader);
+
 	EmberGpSinkTableEntryStatus status; /*!< Internal status of the sink table entry */
 	CEmberGpSinkTableOption options; /*!< The tunneling options (this contains both options and extendedOptions from the spec). WRONG Specification only 16 bits like option without extended... */
 	CEmberGpAddressStruct gpd; /*!< The addressing info of the GPD */
@@ -10,31 +10,41 @@
 #include "ezsp/ezsp-protocol/struct/ember-key-struct.h"
 
 #include "ezsp/byte-manip.h"
+#include "spi/ByteReader.h"
 
 using NSEZSP::CEmberKeyStruct;
 
-CEmberKeyStruct::CEmberKeyStruct(const NSSPI::ByteBuffer& raw_message) :
-	bitmask(static_cast<EmberKeyStructBitmask>(dble_u8_to_u16(raw_message.at(1), raw_message.at(0)))),
-	type(static_cast<EmberKeyType>(raw_message.at(2))),
+CEmberKeyStruct::CEmberKeyStruct(NSSPI::ByteView raw_message) :
+	bitmask(),
+	type(),
 	key(),
-	outgoingFrameCounter(
-	    static_cast<uint32_t>(raw_message.at(19)) |
-	    static_cast<uint32_t>(raw_message.at(20))<<8 |
-	    static_cast<uint32_t>(raw_message.at(21))<<16 |
-	    static_cast<uint32_t>(raw_message.at(22))<<24),
-	incomingFrameCounter(
-	    static_cast<uint32_t>(raw_message.at(23)) |
-	    static_cast<uint32_t>(raw_message.at(24))<<8 |
-	    static_cast<uint32_t>(raw_message.at(25))<<16 |
-	    static_cast<uint32_t>(raw_message.at(26))<<24),
-	sequenceNumber(static_cast<EmberKeyType>(raw_message.at(27))),
+	outgoingFrameCounter(),
+	incomingFrameCounter(),
+	sequenceNumber(),
 	partnerEUI64() {
-	for (unsigned int loop=0; loop<EMBER_KEY_DATA_BYTE_SIZE; loop++) {
-		key.at(loop) = raw_message.at(3U+loop);
-	}
-	for(unsigned int loop=0; loop<EMBER_EUI64_BYTE_SIZE; loop++) {
-		partnerEUI64.at(loop) = raw_message.at(28U+loop);
-	}
+	NSSPI::ByteReader reader(raw_message);
+	this->parse(reader);
+}
+
+CEmberKeyStruct::CEmberKeyStruct(NSSPI::ByteReader& reader) :
+	bitmask(),
+	type(),
+	key(),
+	outgoingFrameCounter(),
+	incomingFrameCounter(),
+	sequenceNumber(),
+	partnerEUI64() {
+	this->parse(reader);
+}
+
+void CEmberKeyStruct::parse(NSSPI::ByteReader& reader) {
+	this->bitmask = static_cast<EmberKeyStructBitmask>(reader.readU16le());
+	this->type = static_cast<EmberKeyType>(reader.readU8());
+	reader.readBytes(this->key);
+	this->outgoingFrameCounter = reader.readU32le();
+	this->incomingFrameCounter = reader.readU32le();
+	this->sequenceNumber = reader.readU8();
+	reader.readBytes(this->partnerEUI64);
 }
 
 std::string CEmberKeyStruct::String() const {
@@ -8,6 +8,8 @@
 
 #include "ezsp/ezsp-protocol/ezsp-enum.h"
 #include "spi/ByteBuffer.h"
+#include "spi/ByteView.h"
+#include "spi/ByteReader.h"
 
 namespace NSEZSP {
 
@@ -25,7 +27,14 @@ public:
 	 *
 	 * @param raw_message The buffer to construct from
 	 */
-	explicit CEmberKeyStruct(const NSSPI::ByteBuffer& raw_message);
+	explicit CEmberKeyStruct(NSSPI::ByteView raw_message);
+
+	/**
+	 * @brief Construction from the current position of a reader
+	 *
+	 * @param reader The reader to consume the structure from (its error flag is raised if there are not enough bytes)
+	 */
+	explicit CEmberKeyStruct(NSSPI::ByteReader& reader);
 
 	/**
 	 * @brief Copy constructor
@@ -112,6 +121,13 @@ public:
 	}
 
 private:
+	/**
+	 * @brief Read all fields out of a reader
+	 *
+	 * @param reader The reader to consume the structure from
+	 */
+	void parse(NSSPI::ByteReader& reader);
+
 	EmberKeyStructBitmask bitmask;
 	EmberKeyType type;
 	EmberKeyData key;
@@ -9,6 +9,8 @@
 
 #include "ezsp/ezsp-protocol/struct/ember-network-parameters.h"
 #include "ezsp/byte-manip.h"
+#include "spi/ByteReader.h"
+#include "spi/FrameBuffer.h"
 
 using NSEZSP::CEmberNetworkParameters;
 
@@ -23,27 +25,45 @@ CEmberNetworkParameters::CEmberNetworkParameters() :
 	channels(0) {
 }
 
-CEmberNetworkParameters::CEmberNetworkParameters(const NSSPI::ByteBuffer& raw_message, const std::string::size_type skip) :
-	extend_pan_id(
-	    static_cast<uint64_t>(raw_message.at(0+skip)) |
-	    static_cast<uint64_t>(raw_message.at(1+skip))<<8 |
-	    static_cast<uint64_t>(raw_message.at(2+skip))<<16 |
-	    static_cast<uint64_t>(raw_message.at(3+skip))<<24 |
-	    static_cast<uint64_t>(raw_message.at(4+skip))<<32 |
-	    static_cast<uint64_t>(raw_message.at(5+skip))<<40 |
-	    static_cast<uint64_t>(raw_message.at(6+skip))<<48 |
-	    static_cast<uint64_t>(raw_message.at(7+skip))<<56),
-	pan_id(dble_u8_to_u16(raw_message.at(9+skip), raw_message.at(8+skip))),
-	radio_tx_power(raw_message.at(10+skip)),
-	radio_channel(raw_message.at(11+skip)),
-	join_method(static_cast<EmberJoinMethod>(raw_message.at(12+skip))),
-	nwk_manager_id(static_cast<EmberNodeId>(dble_u8_to_u16(raw_message.at(14+skip), raw_message.at(13+skip)))),
-	nwk_update_id(raw_message.at(15+skip)),
-	channels(quad_u8_to_u32(raw_message.at(19), raw_message.at(18), raw_message.at(17), raw_message.at(16))) {
+CEmberNetworkParameters::CEmberNetworkParameters(NSSPI::ByteView raw_message, const std::string::size_type skip) :
+	extend_pan_id(0),
+	pan_id(0),
+	radio_tx_power(0),
+	radio_channel(0),
+	join_method(EMBER_USE_MAC_ASSOCIATION),
+	nwk_manager_id(0),
+	nwk_update_id(0),
+	channels(0) {
+	NSSPI::ByteReader reader(raw_message);
+	reader.skip(skip);
+	this->parse(reader);
+}
+
+CEmberNetworkParameters::CEmberNetworkParameters(NSSPI::ByteReader& reader) :
+	extend_pan_id(0),
+	pan_id(0),
+	radio_tx_power(0),
+	radio_channel(0),
+	join_method(EMBER_USE_MAC_ASSOCIATION),
+	nwk_manager_id(0),
+	nwk_update_id(0),
+	channels(0) {
+	this->parse(reader);
+}
+
+void CEmberNetworkParameters::parse(NSSPI::ByteReader& reader) {
+	this->extend_pan_id = reader.readU64le();
+	this->pan_id = reader.readU16le();
+	this->radio_tx_power = reader.readU8();
+	this->radio_channel = reader.readU8();
+	this->join_method = static_cast<EmberJoinMethod>(reader.readU8());
+	this->nwk_manager_id = static_cast<EmberNodeId>(reader.readU16le());
+	this->nwk_update_id = reader.readU8();
+	this->channels = reader.readU32le();
 }
 
 NSSPI::ByteBuffer CEmberNetworkParameters::getRaw() const {
-	NSSPI::ByteBuffer raw_message;
+	NSSPI::FrameBuffer raw_message;
 
 	// extend_pan_id
 	raw_message.push_back(static_cast<uint8_t>(extend_pan_id&0xFF));
@@ -82,7 +102,7 @@ NSSPI::ByteBuffer CEmberNetworkParameters::getRaw() const {
 	raw_message.push_back(u32_get_byte2(channels));
 	raw_message.push_back(u32_get_byte3(channels));
 
-	return raw_message;
+	return raw_message.toByteBuffer();
 }
 
 std::string CEmberNetworkParameters::toString() const {
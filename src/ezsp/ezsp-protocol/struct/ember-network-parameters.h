@@ -9,6 +9,8 @@
 #include <string>
 #include "ezsp/ezsp-protocol/ezsp-enum.h"
 #include "spi/ByteBuffer.h"
+#include "spi/ByteView.h"
+#include "spi/ByteReader.h"
 
 namespace NSEZSP {
 
@@ -30,7 +32,14 @@ public:
 	 * @param raw_message The buffer to construct from
 	 * @param skip The number of leading bytes to skip in buffer @p raw_message
 	 */
-	CEmberNetworkParameters(const NSSPI::ByteBuffer& raw_message, const std::string::size_type skip = 0);
+	CEmberNetworkParameters(NSSPI::ByteView raw_message, const std::string::size_type skip = 0);
+
+	/**
+	 * @brief Construction from the current position of a reader
+	 *
+	 * @param reader The reader to consume the structure from (its error flag is raised if there are not enough bytes)
+	 */
+	explicit CEmberNetworkParameters(NSSPI::ByteReader& reader);
 
 	NSSPI::ByteBuffer getRaw() const;
 
@@ -155,6 +164,13 @@ public:
 	}
 
 private:
+	/**
+	 * @brief Read all fields out of a reader
+	 *
+	 * @param reader The reader to consume the structure from
+	 */
+	void parse(NSSPI::ByteReader& reader);
+
 	uint64_t extend_pan_id;
 	uint16_t pan_id;
 	uint8_t radio_tx_power;
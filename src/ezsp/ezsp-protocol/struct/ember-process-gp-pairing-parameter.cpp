@@ -43,7 +43,7 @@ CProcessGpPairingParam::CProcessGpPairingParam(CEmberGpSinkTableEntryStruct i_si
 
 
 NSSPI::ByteBuffer CProcessGpPairingParam::get() const {
-	NSSPI::ByteBuffer lo_out;
+	NSSPI::FrameBuffer lo_out;
 
 	// The options field of the GP Pairing command
 	uint32_t l_option = options.get();
@@ -52,8 +52,7 @@ NSSPI::ByteBuffer CProcessGpPairingParam::get() const {
 	lo_out.push_back(u32_get_byte2(l_option));
 	lo_out.push_back(u32_get_byte3(l_option));
 	// The addressing info of the target GPD.
-	NSSPI::ByteBuffer l_gpd_addr = addr.getRaw();
-	lo_out.insert(lo_out.end(),l_gpd_addr.begin(),l_gpd_addr.end());
+	addr.appendRaw(lo_out);
 	// The communication mode of the GP Sink.
 	lo_out.push_back(commMode);
 	// The network address of the GP Sink.
@@ -66,9 +65,9 @@ NSSPI::ByteBuffer CProcessGpPairingParam::get() const {
 	lo_out.push_back(u16_get_lo_u8(assignedAlias));
 	lo_out.push_back(u16_get_hi_u8(assignedAlias));
 	// The IEEE address of the GP Sink.
-	lo_out.insert(lo_out.end(),sinkIeeeAddress.begin(),sinkIeeeAddress.end());
+	lo_out.append(sinkIeeeAddress);
 	// The key to use for GPD.
-	lo_out.insert(lo_out.end(),gpdKey.begin(),gpdKey.end());
+	lo_out.append(gpdKey);
 	// The security frame counter of the GPD.
 	lo_out.push_back(u32_get_byte0(gpdSecurityFrameCounter));
 	lo_out.push_back(u32_get_byte1(gpdSecurityFrameCounter));
@@ -77,5 +76,5 @@ NSSPI::ByteBuffer CProcessGpPairingParam::get() const {
 	// The forwarding radius.
 	lo_out.push_back(forwardingRadius);
 
-	return lo_out;
+	return lo_out.toByteBuffer();
 }
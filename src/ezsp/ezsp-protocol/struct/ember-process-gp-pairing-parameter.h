@@ -51,6 +51,23 @@ public:
 	 */
 	NSSPI::ByteBuffer get() const;
 
+	/**
+	 * @brief Options getter
+	 *
+	 * @return The options field of the GP Pairing command
+	 */
+	const CGpPairingCommandOption& getOptions() const {
+		return options;
+	}
+
+	/**
+	 * @brief Source ID getter
+	 *
+	 * @return The source ID of the target GPD
+	 */
+	uint32_t getGpdSourceId() const {
+		return addr.getSourceId();
+	}
 
 private:
 	CGpPairingCommandOption options;        /*!< The options field of the GP Pairing command (see A.3.3.5.2 GP Pairing command for more details) */
@@ -10,19 +10,24 @@
 #include "ezsp/ezsp-protocol/struct/ember-zigbee-network.h"
 
 #include "ezsp/byte-manip.h"
+#include "spi/ByteReader.h"
 
 using NSEZSP::CEmberZigbeeNetwork;
 
-CEmberZigbeeNetwork::CEmberZigbeeNetwork(const NSSPI::ByteBuffer& raw_message) :
-	channel(static_cast<uint8_t>(raw_message.at(0))),
-	panId(dble_u8_to_u16(raw_message.at(2), raw_message.at(1))),
-	extendedPanId(0),
-	allowingJoin(raw_message.at(11)!=0),
-	stackProfile(static_cast<uint8_t>(raw_message.at(12))),
-	nwkUpdateId(static_cast<uint8_t>(raw_message.at(13))) {
-	for (unsigned int loop=0; loop<8; loop++) {
-		extendedPanId = extendedPanId << 8 | raw_message.at(3U+(7-loop) /*FIXME: why reverse?*/);
-	}
+CEmberZigbeeNetwork::CEmberZigbeeNetwork(NSSPI::ByteView raw_message) :
+	channel(),
+	panId(),
+	extendedPanId(),
+	allowingJoin(),
+	stackProfile(),
+	nwkUpdateId() {
+	NSSPI::ByteReader reader(raw_message);
+	this->channel = reader.readU8();
+	this->panId = reader.readU16le();
+	this->extendedPanId = reader.readU64le();
+	this->allowingJoin = (reader.readU8() != 0);
+	this->stackProfile = reader.readU8();
+	this->nwkUpdateId = reader.readU8();
 }
 
 CEmberZigbeeNetwork::CEmberZigbeeNetwork(const CEmberZigbeeNetwork& other) :
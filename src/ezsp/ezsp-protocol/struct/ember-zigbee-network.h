@@ -8,6 +8,7 @@
 
 //#include "ezsp/ezsp-protocol/ezsp-enum.h"
 #include "spi/ByteBuffer.h"
+#include "spi/ByteView.h"
 
 namespace NSEZSP {
 
@@ -27,7 +28,7 @@ public:
 	 *
 	 * @param raw_message The buffer to construct from
 	 */
-	explicit CEmberZigbeeNetwork(const NSSPI::ByteBuffer& raw_message);
+	explicit CEmberZigbeeNetwork(NSSPI::ByteView raw_message);
 
 	/**
 	 * @brief Copy constructor
@@ -69,16 +69,16 @@ std::string ZigbeeNetworkScanResult::toString() const {
 
 using NSEZSP::CEzsp;
 
-CEzsp::CEzsp(NSSPI::IUartDriverHandle uartHandle, const NSSPI::TimerBuilder& timerbuilder, unsigned int requestZbNetworkResetToChannel) :
+CEzsp::CEzsp(NSSPI::IUartDriverHandle uartHandle, const NSSPI::TimerBuilder& timerbuilder, unsigned int requestZbNetworkResetToChannel, const CEzspCapacities& capacities) :
 	main(nullptr) {
 #ifdef TRACE_API_CALLS
 	clogD << "->API call " << __func__ << " constructor on instance " << static_cast<void *>(this) << "\n";
 #endif
 #ifndef DYNAMIC_ALLOCATION
-	static CLibEzspMain g_MainEzsp(uartHandle, timerbuilder, requestZbNetworkResetToChannel);
+	static CLibEzspMain g_MainEzsp(uartHandle, timerbuilder, requestZbNetworkResetToChannel, capacities);
 	main = &g_MainEzsp;
 #else
-	main = new CLibEzspMain(uartHandle, timerbuilder, requestZbNetworkResetToChannel);
+	main = new CLibEzspMain(uartHandle, timerbuilder, requestZbNetworkResetToChannel, capacities);
 #endif
 }
 
@@ -134,6 +134,27 @@ void CEzsp::registerGPSourceIdCallback(FGpSourceIdCallback newObsGPSourceIdCallb
 	main->registerGPSourceIdCallback(newObsGPSourceIdCallback);
 }
 
+const NSEZSP::CGpAttributeStore& CEzsp::getGPAttributeStore() const {
+#ifdef TRACE_API_CALLS
+	clogD << "->API call " << __func__ << "()\n";
+#endif
+	return main->getGPAttributeStore();
+}
+
+void CEzsp::registerGPDeviceOfflineCallback(FGpDeviceOfflineCallback newObsGPDeviceOfflineCallback) {
+#ifdef TRACE_API_CALLS
+	clogD << "->API call " << __func__ << "()\n";
+#endif
+	main->registerGPDeviceOfflineCallback(newObsGPDeviceOfflineCallback);
+}
+
+void CEzsp::setGPLivenessParameters(unsigned int nbMissedReports, std::chrono::milliseconds minTimeout, std::chrono::milliseconds initialTimeout) {
+#ifdef TRACE_API_CALLS
+	clogD << "->API call " << __func__ << "(" << std::dec << nbMissedReports << ", " << minTimeout.count() << "ms, " << initialTimeout.count() << "ms)\n";
+#endif
+	main->setGPLivenessParameters(nbMissedReports, minTimeout, initialTimeout);
+}
+
 bool CEzsp::clearAllGPDevices() {
 #ifdef TRACE_API_CALLS
 	clogD << "->API call " << __func__ << "()\n";
@@ -169,6 +190,48 @@ bool CEzsp::addGPDevices(const std::vector<CGpDevice> &gpDevicesList) {
 	return main->addGPDevices(gpDevicesList);
 }
 
+bool CEzsp::syncGPDevices(const std::vector<CGpDevice> &gpDevicesList, CGpSyncSummary &summary) {
+#ifdef TRACE_API_CALLS
+	std::stringstream gpDevicesListAsStr;
+	for (auto it = gpDevicesList.begin(); it != gpDevicesList.end(); ++it) {
+		if (it != gpDevicesList.begin()) {
+			gpDevicesListAsStr << ",";
+		}
+		gpDevicesListAsStr << "0x" << std::hex << std::setw(8) << std::setfill('0') << it->getSourceId();
+	}
+	clogD << "->API call " << __func__ << "([" << gpDevicesListAsStr.str() << "])\n";
+#endif
+	return main->syncGPDevices(gpDevicesList, summary);
+}
+
+bool CEzsp::openGPDeviceStore(const std::string& path) {
+#ifdef TRACE_API_CALLS
+	clogD << "->API call " << __func__ << "(" << path << ")\n";
+#endif
+	return main->openGPDeviceStore(path);
+}
+
+void CEzsp::setUnknownGPSourcePolicy(CGpUnknownSourcePolicy policy, unsigned int sampleInterval) {
+#ifdef TRACE_API_CALLS
+	clogD << "->API call " << __func__ << "(" << static_cast<unsigned int>(policy) << ", " << std::dec << sampleInterval << ")\n";
+#endif
+	main->setUnknownGPSourcePolicy(policy, sampleInterval);
+}
+
+bool CEzsp::setNcpGPSinkTableSize(unsigned int nbEntries) {
+#ifdef TRACE_API_CALLS
+	clogD << "->API call " << __func__ << "(" << std::dec << nbEntries << ")\n";
+#endif
+	return main->setNcpGPSinkTableSize(nbEntries);
+}
+
+bool CEzsp::setGPMicValidationWorkers(unsigned int nbWorkers) {
+#ifdef TRACE_API_CALLS
+	clogD << "->API call " << __func__ << "(" << std::dec << nbWorkers << ")\n";
+#endif
+	return NSEZSP::CLibEzspMain::setGPMicValidationWorkers(nbWorkers);
+}
+
 bool CEzsp::openCommissioningSession() {
 #ifdef TRACE_API_CALLS
 	clogD << "->API call " << __func__ << "()\n";
@@ -0,0 +1,163 @@
+/**
+ * @file green-power-attribute-store.cpp
+ *
+ * @brief Last known values of the attributes reported by GP devices, readable from any thread without blocking the RX path
+ */
+
+#include "ezsp/green-power-attribute-store.h"
+#include "ezsp/zbmessage/zcl.h"
+
+using NSEZSP::CGpAttributeStore;
+using NSEZSP::CGpAttributeValue;
+
+constexpr std::size_t CGpAttributeStore::DEFAULT_CAPACITY;
+
+namespace {
+/**
+ * @brief Can a reported value be stored in CGpAttributeValue::rawValue?
+ */
+bool fitsRawValue(const NSEZSP::CGpAttributeReport& i_report) {
+	switch (i_report.type) {
+	case NSEZSP::ZCL_OCTET_STRING_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_CHAR_STRING_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_LONG_OCTET_STRING_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_LONG_CHAR_STRING_ATTRIBUTE_TYPE:
+		return false;
+	default:
+		return (i_report.value.size() <= sizeof(i_report.rawValue));
+	}
+}
+}
+
+CGpAttributeStore::CGpAttributeStore(std::size_t i_capacity) :
+	capacity(i_capacity),
+	mask(0),
+	slots(),
+	writeMutex(),
+	version(0),
+	nbEntries(0),
+	nbDropped(0) {
+	std::size_t l_nb_slots = 1;
+	while (l_nb_slots < 2 * this->capacity) {
+		l_nb_slots <<= 1;
+	}
+	this->mask = l_nb_slots - 1;
+	this->slots.reset(new Slot[l_nb_slots]);
+}
+
+uint64_t CGpAttributeStore::makeKey(uint32_t i_source_id, uint16_t i_cluster_id, uint16_t i_attribute_id) {
+	return (static_cast<uint64_t>(i_source_id) << 32) | (static_cast<uint64_t>(i_cluster_id) << 16) | i_attribute_id;
+}
+
+CGpAttributeStore::Slot* CGpAttributeStore::find(uint64_t i_key) const {
+	/* Fibonacci hashing spreads consecutive source IDs and attribute IDs over the table */
+	std::size_t l_index = static_cast<std::size_t>((i_key * 0x9E3779B97F4A7C15ULL) >> 32) & this->mask;
+	for (std::size_t l_probes = 0; l_probes <= this->mask; l_probes++) {
+		Slot& l_slot = this->slots[l_index];
+		uint64_t l_key = l_slot.key.load(std::memory_order_acquire);
+		if (l_key == i_key || l_key == 0) {
+			return &l_slot;
+		}
+		l_index = (l_index + 1) & this->mask;
+	}
+	return nullptr;
+}
+
+void CGpAttributeStore::read(const Slot& i_slot, CGpAttributeValue& o_value) {
+	uint32_t l_sequence_before;
+	uint32_t l_sequence_after;
+	do {
+		l_sequence_before = i_slot.sequence.load(std::memory_order_acquire);
+		o_value.type = i_slot.type.load(std::memory_order_relaxed);
+		o_value.rawValue = i_slot.rawValue.load(std::memory_order_relaxed);
+		o_value.version = i_slot.version.load(std::memory_order_relaxed);
+		o_value.lastReport = std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(i_slot.lastReport.load(std::memory_order_relaxed)));
+		std::atomic_thread_fence(std::memory_order_acquire);
+		l_sequence_after = i_slot.sequence.load(std::memory_order_relaxed);
+	} while ((l_sequence_before & 1U) != 0 || l_sequence_before != l_sequence_after);
+	uint64_t l_key = i_slot.key.load(std::memory_order_relaxed);
+	o_value.sourceId = static_cast<uint32_t>(l_key >> 32);
+	o_value.clusterId = static_cast<uint16_t>(l_key >> 16);
+	o_value.attributeId = static_cast<uint16_t>(l_key);
+}
+
+bool CGpAttributeStore::update(uint32_t i_source_id, const CGpAttributeReport& i_report, std::chrono::steady_clock::time_point i_now) {
+	if (i_source_id == 0 || i_report.manufacturerSpecific || !fitsRawValue(i_report)) {
+		return false;
+	}
+	uint64_t l_key = CGpAttributeStore::makeKey(i_source_id, i_report.clusterId, i_report.attributeId);
+
+	std::lock_guard<std::mutex> lock(this->writeMutex);
+	Slot* l_slot = this->find(l_key);
+	bool l_new = (l_slot != nullptr && l_slot->key.load(std::memory_order_relaxed) == 0);
+	if (l_slot == nullptr || (l_new && this->nbEntries.load(std::memory_order_relaxed) >= this->capacity)) {
+		this->nbDropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+	bool l_changed = (l_new
+	                  || l_slot->rawValue.load(std::memory_order_relaxed) != i_report.rawValue
+	                  || l_slot->type.load(std::memory_order_relaxed) != i_report.type);
+	uint64_t l_version = this->version.load(std::memory_order_relaxed) + (l_changed ? 1 : 0);
+
+	/* Sequence lock write: readers that see an odd or a different sequence number retry */
+	uint32_t l_sequence = l_slot->sequence.load(std::memory_order_relaxed);
+	l_slot->sequence.store(l_sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+	l_slot->type.store(i_report.type, std::memory_order_relaxed);
+	l_slot->rawValue.store(i_report.rawValue, std::memory_order_relaxed);
+	if (l_changed) {
+		l_slot->version.store(l_version, std::memory_order_relaxed);
+	}
+	l_slot->lastReport.store(i_now.time_since_epoch().count(), std::memory_order_relaxed);
+	l_slot->sequence.store(l_sequence + 2, std::memory_order_release);
+
+	if (l_new) {
+		/* Publish the slot only once its fields are set, readers ignore it until then */
+		l_slot->key.store(l_key, std::memory_order_release);
+		this->nbEntries.fetch_add(1, std::memory_order_relaxed);
+	}
+	/* Published after the slot, so that a reader who sees this version also sees all values up to it */
+	this->version.store(l_version, std::memory_order_release);
+	return l_changed;
+}
+
+bool CGpAttributeStore::get(uint32_t i_source_id, uint16_t i_cluster_id, uint16_t i_attribute_id, CGpAttributeValue& o_value) const {
+	uint64_t l_key = CGpAttributeStore::makeKey(i_source_id, i_cluster_id, i_attribute_id);
+	const Slot* l_slot = this->find(l_key);
+	if (i_source_id == 0 || l_slot == nullptr || l_slot->key.load(std::memory_order_acquire) != l_key) {
+		return false;
+	}
+	CGpAttributeStore::read(*l_slot, o_value);
+	return true;
+}
+
+uint64_t CGpAttributeStore::getVersion() const {
+	return this->version.load(std::memory_order_acquire);
+}
+
+uint64_t CGpAttributeStore::forEachChangedSince(uint64_t i_version, FValueCallback i_callback) const {
+	uint64_t l_version = this->version.load(std::memory_order_acquire);
+	if (l_version == i_version) {
+		return l_version;	/* Nothing changed, no need to scan the table */
+	}
+	CGpAttributeValue l_value;
+	for (std::size_t i = 0; i <= this->mask; i++) {
+		const Slot& l_slot = this->slots[i];
+		if (l_slot.key.load(std::memory_order_acquire) == 0 || l_slot.version.load(std::memory_order_relaxed) <= i_version) {
+			continue;
+		}
+		CGpAttributeStore::read(l_slot, l_value);
+		if (l_value.version > i_version && i_callback) {
+			i_callback(l_value);
+		}
+	}
+	return l_version;
+}
+
+std::size_t CGpAttributeStore::getNbEntries() const {
+	return this->nbEntries.load(std::memory_order_relaxed);
+}
+
+std::size_t CGpAttributeStore::getNbDropped() const {
+	return this->nbDropped.load(std::memory_order_relaxed);
+}
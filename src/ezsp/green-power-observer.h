@@ -5,12 +5,25 @@
  */
 #pragma once
 
+#include <chrono>
+
 #include <ezsp/gpd.h>
 
 #include "ezsp/zbmessage/green-power-frame.h"
 
 namespace NSEZSP {
 
+/**
+ * @brief Outcome of the pairing of a device that sent commissioning frames during a commissioning session
+ */
+struct CGpCommissioningReport {
+	uint32_t sourceId;	/*!< The source ID of the device */
+	bool paired;	/*!< Has the device been written into the adapter's sink and proxy tables? */
+	unsigned int nbDuplicates;	/*!< The number of commissioning frames received again from the device while it was waiting or being paired */
+	std::chrono::microseconds queueDelay;	/*!< The time spent waiting for the pairings of other devices */
+	std::chrono::microseconds latency;	/*!< The time from the first commissioning frame of the device to the end of its pairing */
+};
+
 class CGpObserver {
 public:
 	CGpObserver() = default;
@@ -19,9 +32,9 @@ public:
 	/**
 	 * @brief Method that will be invoked on incoming valid green power frames
 	 *
-	 * @param i_gpf The green power frame received
+	 * @param i_gpf A view on the green power frame received, only valid during this call (use CGpFrameView::retain() to keep the frame)
 	 */
-	virtual void handleRxGpFrame( CGpFrame &i_gpf ) { /* Default implementation does nothing, add your own handler here in derived observer classes */ }
+	virtual void handleRxGpFrame( const CGpFrameView &i_gpf ) { /* Default implementation does nothing, add your own handler here in derived observer classes */ }
 
 	/**
 	 * @brief Method that will be invoked on every green power frame receive on our radio channel
@@ -32,6 +45,20 @@ public:
 	 */
 	virtual void handleRxGpdId( uint32_t &i_gpd_id, bool i_gpd_known, CGpdKeyStatus i_gpd_key_status ) { /* Default implementation does nothing, add your own handler here in derived observer classes */ }
 
+	/**
+	 * @brief Method that will be invoked each time the pairing of a device that sent commissioning frames is over
+	 *
+	 * @param i_report The outcome and latency of the pairing
+	 */
+	virtual void handleGpdCommissioning( const CGpCommissioningReport &i_report ) { /* Default implementation does nothing, add your own handler here in derived observer classes */ }
+
+	/**
+	 * @brief Method that will be invoked each time a device misses its expected reports, and when it is heard again after that
+	 *
+	 * @param i_report The device and its silence
+	 */
+	virtual void handleGpdLiveness( const CGpLivenessReport &i_report ) { /* Default implementation does nothing, add your own handler here in derived observer classes */ }
+
 };
 
 } // namespace NSEZSP
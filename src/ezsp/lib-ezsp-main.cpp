@@ -11,6 +11,7 @@
 
 #include "ezsp/lib-ezsp-main.h"
 #include "spi/ILogger.h"
+#include "spi/AllocCounter.h"
 #include "ezsp/ezsp-protocol/get-network-parameters-response.h"  // For CGetNetworkParametersResponse
 #include "ezsp/ezsp-protocol/struct/ember-key-struct.h"  // For CEmberKeyStruct
 
@@ -20,7 +21,7 @@ using NSEZSP::CLibEzspMain;
 using NSEZSP::CLibEzspPublic;
 using NSEZSP::CLibEzspInternal;
 
-CLibEzspMain::CLibEzspMain(NSSPI::IUartDriverHandle uartHandle, const NSSPI::TimerBuilder& timerbuilder, unsigned int requestZbNetworkResetToChannel) :
+CLibEzspMain::CLibEzspMain(NSSPI::IUartDriverHandle uartHandle, const NSSPI::TimerBuilder& timerbuilder, unsigned int requestZbNetworkResetToChannel, const CEzspCapacities& capacities) :
 	uartHandle(uartHandle),
 	timerbuilder(timerbuilder),
 	exp_ezsp_min_version(6),    /* Expect EZSP version 6 minimum */
@@ -30,12 +31,13 @@ CLibEzspMain::CLibEzspMain(NSSPI::IUartDriverHandle uartHandle, const NSSPI::Tim
 	xncpVersionNumber(0),  /* 0 means unknown (yet) */
 	lib_state(CLibEzspInternal::State::UNINITIALIZED),
 	obsStateCallback(nullptr),
-	dongle(timerbuilder, this),
+	dongle(timerbuilder, this, capacities.maxQueuedCommands),
 	zb_messaging(dongle, timerbuilder),
 	zb_nwk(dongle, zb_messaging),
-	gp_sink(dongle, zb_messaging),
+	gp_sink(dongle, zb_messaging, timerbuilder, capacities.maxGpDevices, capacities.maxGpAttributes),
 	obsGPFrameRecvCallback(nullptr),
 	obsGPSourceIdCallback(nullptr),
+	obsGPDeviceOfflineCallback(nullptr),
 	energyScanCallback(nullptr),
 	networkKeyCallback(nullptr),
 	leavePreviousNetworkAtInit(requestZbNetworkResetToChannel != 0),
@@ -90,6 +92,18 @@ void CLibEzspMain::registerGPSourceIdCallback(FGpSourceIdCallback newObsGPSource
 	this->obsGPSourceIdCallback = newObsGPSourceIdCallback;
 }
 
+const NSEZSP::CGpAttributeStore& CLibEzspMain::getGPAttributeStore() const {
+	return this->gp_sink.getAttributeStore();
+}
+
+void CLibEzspMain::registerGPDeviceOfflineCallback(FGpDeviceOfflineCallback newObsGPDeviceOfflineCallback) {
+	this->obsGPDeviceOfflineCallback = newObsGPDeviceOfflineCallback;
+}
+
+void CLibEzspMain::setGPLivenessParameters(unsigned int nbMissedReports, std::chrono::milliseconds minTimeout, std::chrono::milliseconds initialTimeout) {
+	this->gp_sink.setLivenessParameters(nbMissedReports, minTimeout, initialTimeout);
+}
+
 void CLibEzspMain::setState(CLibEzspInternal::State i_new_state) {
 	CLibEzspInternal::State l_old_state = this->lib_state;
 	this->lib_state = i_new_state;
@@ -370,6 +384,41 @@ bool CLibEzspMain::addGPDevices(const std::vector<CGpDevice> &gpDevicesList) {
 	return true;
 }
 
+bool CLibEzspMain::syncGPDevices(const std::vector<CGpDevice> &gpDevicesList, CGpSyncSummary &summary) {
+	if (this->getState() != CLibEzspInternal::State::READY) {
+		return false;
+	}
+	this->setState(CLibEzspInternal::State::SINK_BUSY);
+	if (!this->gp_sink.syncGpds(gpDevicesList, summary)) {
+		return false; /* Probably sink is not ready */
+	}
+
+	return true;
+}
+
+bool CLibEzspMain::openGPDeviceStore(const std::string& path) {
+	return this->gp_sink.openDeviceStore(path);
+}
+
+void CLibEzspMain::setUnknownGPSourcePolicy(CGpUnknownSourcePolicy policy, unsigned int sampleInterval) {
+	this->gp_sink.setUnknownSourcePolicy(policy, sampleInterval);
+}
+
+bool CLibEzspMain::setNcpGPSinkTableSize(unsigned int nbEntries) {
+	return this->gp_sink.setNcpSinkTableSize(nbEntries);
+}
+
+bool CLibEzspMain::setGPMicValidationWorkers(unsigned int nbWorkers) {
+#if defined(USE_BUILTIN_MIC_PROCESSING) && defined(USE_CPPTHREADS)
+	NSEZSP::CGpMicValidationPool::setShared(nbWorkers);
+	return true;
+#else
+	(void)nbWorkers;
+	clogE << "A MIC validation pool is only available when MICs are processed on the host (USE_BUILTIN_MIC_PROCESSING) with C++11 threads (USE_CPPTHREADS)\n";
+	return false;
+#endif
+}
+
 bool CLibEzspMain::openCommissioningSession() {
 	if (this->getState() != CLibEzspInternal::State::READY) {
 		return false;
@@ -655,7 +704,7 @@ void CLibEzspMain::handleEzspRxMessage_STACK_STATUS_HANDLER(const NSSPI::ByteBuf
 	}
 }
 
-void CLibEzspMain::handleEzspRxMessage(EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_receive) {
+void CLibEzspMain::handleEzspRxMessage(EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive) {
 	//clogD << "CLibEzspMain::handleEzspRxMessage " << CEzspEnum::EEzspCmdToString(i_cmd);
 	//if (i_msg_receive.size()>0) {
 	//	clogD << " with payload " << i_msg_receive;
@@ -673,9 +722,13 @@ void CLibEzspMain::handleEzspRxMessage(EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_r
 	}
 	break;
 	case EZSP_GET_KEY: {
-		EEmberStatus l_status = static_cast<EEmberStatus>(i_msg_receive.at(0));
-		i_msg_receive.erase(i_msg_receive.begin());
-		CEmberKeyStruct l_rsp(i_msg_receive);
+		NSSPI::ByteReader l_reader(i_msg_receive);
+		EEmberStatus l_status = static_cast<EEmberStatus>(l_reader.readU8());
+		CEmberKeyStruct l_rsp(l_reader);
+		if (l_reader.hasError()) {
+			clogE << "Truncated EZSP_GET_KEY response: " << i_msg_receive << "\n";
+			break;
+		}
 		clogI << "EZSP_GET_KEY status : " << CEzspEnum::EEmberStatusToString(l_status) << ", " << l_rsp.String() << std::endl;
 		if (this->networkKeyCallback) {
 			this->networkKeyCallback(l_status, l_rsp.getKey());
@@ -799,17 +852,28 @@ void CLibEzspMain::handleBootloaderPrompt() {
 	clogI << "CLibEzspMain::handleBootloaderPrompt\n";
 }
 
-void CLibEzspMain::handleRxGpFrame( CGpFrame &i_gpf ) {
+void CLibEzspMain::handleRxGpFrame( const CGpFrameView &i_gpf ) {
 	// Start DEBUG
-	clogI << "CLibEzspMain::handleRxGpFrame gp frame : " << i_gpf << std::endl;
+	if (NSSPI::Logger::getInstance()->infoLogger.isOutputting()) {	/* Only format the whole frame dump when it is actually going to be output */
+		clogI << "CLibEzspMain::handleRxGpFrame gp frame : " << i_gpf << std::endl;
+	}
 
 	if( nullptr != obsGPFrameRecvCallback ) {
+		ALLOC_COUNTING_LAYER(USER_CALLBACK);
 		obsGPFrameRecvCallback(i_gpf);
 	}
 }
 
 void CLibEzspMain::handleRxGpdId( uint32_t &i_gpd_id, bool i_gpd_known, CGpdKeyStatus i_gpd_key_status ) {
 	if( nullptr != obsGPSourceIdCallback ) {
+		ALLOC_COUNTING_LAYER(USER_CALLBACK);
 		obsGPSourceIdCallback(i_gpd_id, i_gpd_known, i_gpd_key_status);
 	}
 }
+
+void CLibEzspMain::handleGpdLiveness( const CGpLivenessReport &i_report ) {
+	if( nullptr != obsGPDeviceOfflineCallback ) {
+		ALLOC_COUNTING_LAYER(USER_CALLBACK);
+		obsGPDeviceOfflineCallback(i_report);
+	}
+}
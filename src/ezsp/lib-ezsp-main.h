@@ -74,8 +74,9 @@ public:
 	 * @param uartHandle A handle on a IUartDriver instance to send/receive EZSP message over a serial line
 	 * @param timerbuilder An ITimerFactory used to generate ITimer objects
 	 * @param requestZbNetworkResetToChannel Set this to non 0 if we should destroy any pre-existing Zigbee network in the EZSP adapter and recreate a new Zigbee network on the specified 802.15.4 channel number, set this to -1 if we should just leave any previously joined network
+	 * @param capacities The sizes of the internal queues and tables (hard limits in static allocation builds)
 	 */
-	CLibEzspMain(NSSPI::IUartDriverHandle uartHandle, const NSSPI::TimerBuilder& timerbuilder, unsigned int requestZbNetworkResetToChannel);
+	CLibEzspMain(NSSPI::IUartDriverHandle uartHandle, const NSSPI::TimerBuilder& timerbuilder, unsigned int requestZbNetworkResetToChannel, const CEzspCapacities& capacities = CEzspCapacities());
 
 	CLibEzspMain() = delete; /*<! Construction without arguments is not allowed */
 	CLibEzspMain(const CLibEzspMain&) = delete; /*<! No copy construction allowed */
@@ -117,7 +118,7 @@ public:
 	/**
 	 * @brief Register callback to receive all authenticated incoming green power frames
 	 *
-	 * @param newObsGPFrameRecvCallback A callback function of type void func(CGpFrame &i_gpf), that will be invoked each time a new valid green power frame is received from a known source ID (or nullptr to disable this callback)
+	 * @param newObsGPFrameRecvCallback A callback function of type void func(const CGpFrameView &i_gpf), that will be invoked each time a new valid green power frame is received from a known source ID (or nullptr to disable this callback)
 	 */
 	void registerGPFrameRecvCallback(FGpFrameRecvCallback newObsGPFrameRecvCallback);
 
@@ -128,6 +129,29 @@ public:
 	 */
 	void registerGPSourceIdCallback(FGpSourceIdCallback newObsGPSourceIdCallback);
 
+	/**
+	 * @brief Get the last value reported by GP devices for each of their attributes
+	 *
+	 * @return The attribute store of the sink
+	 */
+	const CGpAttributeStore& getGPAttributeStore() const;
+
+	/**
+	 * @brief Register callback to be notified of GP devices that stop reporting, and that are heard again after that
+	 *
+	 * @param newObsGPDeviceOfflineCallback A callback function of type void func(const CGpLivenessReport &i_report) (or nullptr to disable callbacks)
+	 */
+	void registerGPDeviceOfflineCallback(FGpDeviceOfflineCallback newObsGPDeviceOfflineCallback);
+
+	/**
+	 * @brief Configure when GP devices are considered offline
+	 *
+	 * @param nbMissedReports The number of reporting periods without any frame before a device is considered offline
+	 * @param minTimeout The shortest silence before a device is considered offline
+	 * @param initialTimeout The silence before a device heard only once is considered offline
+	 */
+	void setGPLivenessParameters(unsigned int nbMissedReports, std::chrono::milliseconds minTimeout, std::chrono::milliseconds initialTimeout);
+
 	/**
 	 * @brief Remove GP all devices from sink
 	 *
@@ -159,10 +183,60 @@ public:
 	 */
 	bool addGPDevices(const std::vector<CGpDevice> &gpDevicesList);
 
+	/**
+	 * @brief Make the GP devices registered in the sink match a desired list (identified by their source ID value+key)
+	 *
+	 * Only the differences are applied: devices missing from the list are removed, new devices or devices whose key or options changed
+	 * are (re-)registered, and the others are left untouched. This is meant to be used at startup, instead of clearAllGPDevices()
+	 * followed by addGPDevices(), as the adapter's tables are not read again nor rewritten entirely.
+	 *
+	 * @param gpDevicesList The desired list of CGpDevice objects containing source ID + key pairs
+	 * @param[out] summary The number of devices left unchanged, added, updated and removed
+	 *
+	 * @return true if the action is going to be run in the background, false if the sink is busy
+	 */
+	bool syncGPDevices(const std::vector<CGpDevice> &gpDevicesList, CGpSyncSummary &summary);
+
+	/**
+	 * @brief Load the GP devices from a persistent store on the host, and persist subsequent GP device additions and removals there
+	 *
+	 * @param path The path of the store snapshot file
+	 *
+	 * @return true if the store is open
+	 */
+	bool openGPDeviceStore(const std::string& path);
+
+	/**
+	 * @brief Select what to do with incoming frames from unknown GP devices
+	 *
+	 * @param policy The policy
+	 * @param sampleInterval With CGpUnknownSourcePolicy::Sample, one out of this number of frames from unknown devices is processed
+	 */
+	void setUnknownGPSourcePolicy(CGpUnknownSourcePolicy policy, unsigned int sampleInterval);
+
+	/**
+	 * @brief Let the adapter's GP sink table validate the most active GP devices (hybrid mode)
+	 *
+	 * @param nbEntries The number of entries of the adapter's GP sink table to use, 0 to disable hybrid mode
+	 *
+	 * @return true if hybrid mode has been configured
+	 */
+	bool setNcpGPSinkTableSize(unsigned int nbEntries);
+
+	/**
+	 * @brief Validate the MICs of incoming GP frames on a pool of worker threads shared by all instances
+	 *
+	 * @param nbWorkers The number of worker threads, 0 to validate MICs on the receiving threads again
+	 *
+	 * @return true if the pool has been configured
+	 */
+	static bool setGPMicValidationWorkers(unsigned int nbWorkers);
+
 	/**
 	 * @brief Open a Green Power commissionning session
 	 *
-	 * After invoking this method, we will accept new Green Power Devices to become bound to us
+	 * After invoking this method, we will accept new Green Power Devices to become bound to us, until closeCommissioningSession() is invoked
+	 * Devices commissioned at the same time are queued and paired in turn
 	 *
 	 * @return true if the action is going to be run in the background, false if the sink is busy
 	 */
@@ -273,11 +347,12 @@ private:
 	 * Oberver handlers
 	 */
 	void handleDongleState( EDongleState i_state );
-	void handleEzspRxMessage( EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_receive );
+	void handleEzspRxMessage( EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive );
 	void handleBootloaderPrompt();
 	void handleFirmwareXModemXfr();
-	void handleRxGpFrame( CGpFrame &i_gpf );
+	void handleRxGpFrame( const CGpFrameView &i_gpf );
 	void handleRxGpdId( uint32_t &i_gpd_id, bool i_gpd_known, CGpdKeyStatus i_gpd_key_status );
+	void handleGpdLiveness( const CGpLivenessReport &i_report );
 
 	/**
 	 * @brief Handle an incoming VERSION EZSP message
@@ -326,6 +401,7 @@ private:
 	CGpSink gp_sink;    /*!< Internal Green Power sink utility */
 	FGpFrameRecvCallback obsGPFrameRecvCallback;   /*!< Optional user callback invoked by us each time a green power message is received */
 	FGpSourceIdCallback obsGPSourceIdCallback;	/*!< Optional user callback invoked by us each time a green power message is received */
+	FGpDeviceOfflineCallback obsGPDeviceOfflineCallback;	/*!< Optional user callback invoked by us each time a green power device goes offline or is heard again */
 	FEnergyScanCallback energyScanCallback;  /*!< A user callback invoked by us each time an energy scan is finished */
 	FActiveScanCallback activeScanCallback;  /*!< A user callback invoked by us each time an active scan is finished */
 	FNetworkKeyCallback networkKeyCallback;	/*!< A user callback invoked by us when the network key details are retrieved */
@@ -51,6 +51,14 @@ public:
 	 */
 	uint32_t get() const;
 
+	/**
+	 * @brief AddSink getter
+	 *
+	 * @return true if the pairing is being added, false if it is being removed
+	 */
+	bool isAddSink() const {
+		return add_sink;
+	}
 
 private:
 	/**
@@ -9,15 +9,16 @@
 #include <cstring>
 
 #include "ezsp/byte-manip.h"
+#include "spi/ByteReader.h"
 #include "spi/ILogger.h"
 #include "spi/AesBuilder.h"
 #include "ezsp/zbmessage/gpd-commissioning-command-payload.h"
 
 using NSEZSP::CGpdCommissioningPayload;
 
-CGpdCommissioningPayload::CGpdCommissioningPayload(const NSSPI::ByteBuffer& raw_message, uint32_t i_src_id):
-	device_id(raw_message.at(0)),
-	options(raw_message.at(1)),
+CGpdCommissioningPayload::CGpdCommissioningPayload(NSSPI::ByteView raw_message, uint32_t i_src_id):
+	device_id(0),
+	options(0),
 	extended_options(0),
 	key(),
 	key_mic(),
@@ -28,25 +29,22 @@ CGpdCommissioningPayload::CGpdCommissioningPayload(const NSSPI::ByteBuffer& raw_
 	gpd_command_list(),
 	gpd_cluster_list() {
 	// only device_id and option are mandatory, other field depend of option value
-	unsigned int l_idx = 2;
+	NSSPI::ByteReader reader(raw_message);
+	device_id = reader.readU8();
+	options = reader.readU8();
 
 	// extended option
 	if( options & (1<<COM_OPTION_EXTENDED_OPTION_FIELD_BIT) ) {
-		extended_options = raw_message.at(l_idx);
-		l_idx++;
+		extended_options = reader.readU8();
 	}
 
 	// gpd key
 	if( extended_options & (1<<COM_EXT_OPTION_GPD_KEY_PRESENT_BIT) ) {
-		for (unsigned int loop=0; loop<EMBER_KEY_DATA_BYTE_SIZE; loop++) {
-			key.at(loop) = raw_message.at(l_idx+loop);
-		}
-		l_idx += EMBER_KEY_DATA_BYTE_SIZE;
+		reader.readBytes(key);
 		// gpd key MIC and encryption
 		if( extended_options & (1<<COM_EXT_OPTION_GPD_KEY_ENCRYPTION_BIT) ) {
 			// MIC
-			key_mic = quad_u8_to_u32(raw_message.at(l_idx+3),raw_message.at(l_idx+2),raw_message.at(l_idx+1),raw_message.at(l_idx));
-			l_idx += 4;
+			key_mic = reader.readU32le();
 			// Encrypt key using default TC-LK (A.3.3.3.3 gpLinkKey:"ZigBeeAlliance09") with method A.3.7.1.2.3 Over-the-air protection of GPD key with TC-LK
 			constexpr uint8_t TC_LK[EMBER_KEY_DATA_BYTE_SIZE] = {0x5A, 0x69, 0x67, 0x42, 0x65, 0x65, 0x41, 0x6C, 0x6C, 0x69, 0x61, 0x6E, 0x63, 0x65, 0x30, 0x39};
 			uint8_t nonce[EMBER_KEY_DATA_BYTE_SIZE];
@@ -88,41 +86,39 @@ CGpdCommissioningPayload::CGpdCommissioningPayload(const NSSPI::ByteBuffer& raw_
 
 	// gpd outgoing counter
 	if( extended_options & (1<<COM_EXT_OPTION_GPD_OUT_COUNTER_PRESENT_BIT) ) {
-		out_frame_counter = quad_u8_to_u32(raw_message.at(l_idx+3),raw_message.at(l_idx+2),raw_message.at(l_idx+1),raw_message.at(l_idx));
-		l_idx += 4;
+		out_frame_counter = reader.readU32le();
 	}
 
 	// application information
 	if( options & (1<<COM_OPTION_APPLICATION_INFORMATION_BIT) ) {
-		app_information = raw_message.at(l_idx);
-		l_idx++;
+		app_information = reader.readU8();
 	}
 
 	// manufacturer id
 	if( app_information & (1<<COM_APP_INFO_MANUFACTURER_ID_PRESENT_BIT) ) {
-		manufacturer_id = dble_u8_to_u16(raw_message.at(l_idx+1),raw_message.at(l_idx));
-		l_idx += 2;
+		manufacturer_id = reader.readU16le();
 	}
 
 	// model id
 	if( app_information & (1<<COM_APP_INFO_MODEL_ID_PRESENT_BIT) ) {
-		model_id = dble_u8_to_u16(raw_message.at(l_idx+1),raw_message.at(l_idx));
-		l_idx += 2;
+		model_id = reader.readU16le();
 	}
 
 	// gpd commands
 	if( app_information & (1<<COM_APP_INFO_GPD_COMMANDS_PRESENT_BIT) ) {
-		uint8_t l_number = raw_message.at(l_idx);
-		l_idx++;
-		for( int loop=0; loop<l_number; loop++) {
-			gpd_command_list.push_back(raw_message.at(l_idx));
-			l_idx++;
-		}
+		uint8_t l_number = reader.readU8();
+		NSSPI::ByteView l_commands = reader.readBytes(l_number);
+		gpd_command_list.assign(l_commands.begin(), l_commands.end());
 	}
 
 	// gpd cluster list
 	if( app_information & (1<<COM_APP_INFO_CLUSTER_LIST_PRESENT_BIT) ) {
-		gpd_cluster_list.insert(gpd_cluster_list.begin(),raw_message.begin()+static_cast<int>(l_idx),raw_message.end());
+		NSSPI::ByteView l_clusters = reader.remainingView();
+		gpd_cluster_list.assign(l_clusters.begin(), l_clusters.end());
+	}
+
+	if (reader.hasError()) {
+		clogW << "Truncated GPD commissioning payload\n";
 	}
 }
 
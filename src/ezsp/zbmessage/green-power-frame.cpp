@@ -6,18 +6,51 @@
 
 #include <sstream>
 #include <iomanip>
+#include <algorithm>	// For std::copy(), std::min() and std::max()
+#include <cstring>	// For memcpy()
 
 #include "ezsp/byte-manip.h"
+#include "spi/ByteReader.h"
 #include "ezsp/zbmessage/green-power-frame.h"
 
-#include "ezsp/ezsp-protocol/struct/ember-gp-address-struct.h"
-
 #include "spi/ILogger.h"
 #include "spi/AesBuilder.h"
 
 using NSEZSP::CGpFrame;
+using NSEZSP::CGpFrameView;
+
+namespace {
+/* Offsets in the incoming ezsp raw message of the fields read by CGpFrame::peekHeader() and CGpFrameView, see the field order in CGpFrame::CGpFrame(NSSPI::ByteView) */
+constexpr std::size_t LINK_VALUE_OFFSET = 1;	/* After EZSP status */
+constexpr std::size_t SEQUENCE_NUMBER_OFFSET = 2;
+constexpr std::size_t APPLICATION_ID_OFFSET = 3;
+constexpr std::size_t SOURCE_ID_OFFSET = 4;
+constexpr std::size_t SECURITY_OFFSET = 13;	/* After the GPD IEEE address (whose first half is the source ID) and endpoint */
+constexpr std::size_t KEY_TYPE_OFFSET = 14;
+constexpr std::size_t AUTO_COMMISSIONING_OFFSET = 15;
+constexpr std::size_t RX_AFTER_TX_OFFSET = 16;
+constexpr std::size_t FRAME_COUNTER_OFFSET = 17;
+constexpr std::size_t COMMAND_ID_OFFSET = 21;	/* After the 4-byte frame counter */
+constexpr std::size_t MIC_OFFSET = 22;
+constexpr std::size_t PROXY_TABLE_ENTRY_OFFSET = 26;	/* After the 4-byte MIC */
+constexpr std::size_t PAYLOAD_LENGTH_OFFSET = 27;
+constexpr std::size_t PAYLOAD_OFFSET = 28;
+
+uint32_t readU32le(NSSPI::ByteView raw_message, std::size_t offset) {
+	return NSEZSP::quad_u8_to_u32(raw_message[offset + 3], raw_message[offset + 2], raw_message[offset + 1], raw_message[offset]);
+}
+
+/**
+ * @brief The frame referenced by views on invalid messages, so that their getters return the defaults of an invalid CGpFrame
+ */
+const CGpFrame& invalidFrame() {
+	static const CGpFrame frame;
+	return frame;
+}
+}
 
 CGpFrame::CGpFrame():
+	valid(false),
 	application_id(0),
 	link_value(0),
 	sequence_number(0),
@@ -30,10 +63,12 @@ CGpFrame::CGpFrame():
 	command_id(0xFF),
 	mic(0),
 	proxy_table_entry(0xFF),
-	payload() {
+	payload(),
+	decrypted(false) {
 }
 
-CGpFrame::CGpFrame(const NSSPI::ByteBuffer& raw_message):
+CGpFrame::CGpFrame(NSSPI::ByteView raw_message):
+	valid(false),
 	application_id(0),
 	link_value(0),
 	sequence_number(0),
@@ -46,32 +81,49 @@ CGpFrame::CGpFrame(const NSSPI::ByteBuffer& raw_message):
 	command_id(0xFF),
 	mic(0),
 	proxy_table_entry(0xFF),
-	payload() {
-
-	//clogD << "Lionel: constructing CGPFrame from buffer " << raw_message << "\n";
-	CEmberGpAddressStruct gp_address = CEmberGpAddressStruct(NSSPI::ByteBuffer(raw_message.begin()+3,raw_message.end()));
-
-	this->application_id = gp_address.getApplicationId();
+	payload(),
+	decrypted(false) {
+
+	NSSPI::ByteReader reader(raw_message);
+	reader.skip(1);	/* EZSP status byte */
+	link_value = reader.readU8();
+	sequence_number = reader.readU8();
+	/* The GP address struct (see CEmberGpAddressStruct) comes next: application ID (1 byte), then the source ID (4 bytes, little endian) as the first half of the GPD IEEE address */
+	this->application_id = reader.readU8();
 	/* only sourceId addressing mode is supported */
-	if (this->application_id == 0) {
-		link_value = raw_message.at(1);
-		sequence_number = raw_message.at(2);
-		source_id = gp_address.getSourceId();
-		security = static_cast<EGpSecurityLevel>(raw_message.at(13));
-		key_type = static_cast<EGpSecurityKeyType>(raw_message.at(14));
-		auto_commissioning = raw_message.at(15);
-		rx_after_tx = raw_message.at(16);
-		security_frame_counter = quad_u8_to_u32(raw_message.at(20), raw_message.at(19), raw_message.at(18), raw_message.at(17));
-		command_id = raw_message.at(21);
-		mic = quad_u8_to_u32(raw_message.at(25), raw_message.at(24), raw_message.at(23), raw_message.at(22));
-		proxy_table_entry = raw_message.at(26);
-		for( unsigned int loop=0; loop<raw_message.at(27); loop++ ) {
-			payload.push_back(raw_message.at(28+loop));
-		}
+	if (this->application_id != 0) {
+		clogW << "Unsupported application ID: " << std::dec << static_cast<unsigned int>(this->application_id) << ". Ignoring\n";
+		return;
 	}
-	else {
-		clogW << "Unsupported application ID: " << std::dec << this->application_id << ". Ignoring\n";
+	source_id = reader.readU32le();
+	reader.skip(EMBER_EUI64_BYTE_SIZE - 4 + 1);	/* Remaining half of the GPD IEEE address and endpoint are not used with sourceId addressing */
+	security = static_cast<EGpSecurityLevel>(reader.readU8());
+	key_type = static_cast<EGpSecurityKeyType>(reader.readU8());
+	auto_commissioning = (reader.readU8() != 0);
+	rx_after_tx = (reader.readU8() != 0);
+	security_frame_counter = reader.readU32le();
+	command_id = reader.readU8();
+	mic = reader.readU32le();
+	proxy_table_entry = reader.readU8();
+	uint8_t payload_length = reader.readU8();
+	NSSPI::ByteView l_payload = reader.readBytes(payload_length);
+	payload.append(l_payload.data(), l_payload.size());
+	if (reader.hasError()) {
+		clogE << "Truncated GP frame: " << NSSPI::Logger::byteSequenceToString(raw_message.data(), raw_message.size()) << "\n";
+		return;
+	}
+	this->valid = true;
+}
+
+bool CGpFrame::peekHeader(NSSPI::ByteView raw_message, Header& o_header) {
+	if (raw_message.size() <= PROXY_TABLE_ENTRY_OFFSET || raw_message[APPLICATION_ID_OFFSET] != 0) {
+		return false;
 	}
+	o_header.source_id = readU32le(raw_message, SOURCE_ID_OFFSET);
+	o_header.security = static_cast<EGpSecurityLevel>(raw_message[SECURITY_OFFSET]);
+	o_header.command_id = raw_message[COMMAND_ID_OFFSET];
+	o_header.proxy_table_entry = raw_message[PROXY_TABLE_ENTRY_OFFSET];
+	return true;
 }
 
 uint8_t CGpFrame::toNwkFCByteField() const {
@@ -128,57 +180,75 @@ NSEZSP::GPNonce CGpFrame::computeNonce(uint32_t sourceId, uint32_t frameCounter)
 	return nonce;
 }
 
-NSSPI::ByteBuffer CGpFrame::getLastXiAESCBC(const EmberKeyData& i_gpd_key, const NSSPI::ByteBuffer& X0, const NSSPI::ByteBuffer& B0, const NSSPI::ByteBuffer& B, unsigned int& lastIndex) {
-	NSSPI::ByteBuffer result;
+NSSPI::FrameBuffer CGpFrame::getLastXiAESCBC(const NSSPI::IAes::ExpandedKey& i_gpd_expanded_key, const NSSPI::FrameBuffer& X0, const NSSPI::FrameBuffer& B0, const NSSPI::FrameBuffer& B, unsigned int& lastIndex) {
 	lastIndex = 0;
 
 	if (B.size() % NSSPI::IAes::AES_BLOCK_SIZE != 0) {
 		clogE << "B should have a size equal to  a multiple of " << std::dec << static_cast<unsigned int>(NSSPI::IAes::AES_BLOCK_SIZE)
 		      << " but is " << B.size() << " bytes long\n";
-		return NSSPI::ByteBuffer();
+		return NSSPI::FrameBuffer();
 	}
 	if (B0.size() != NSSPI::IAes::AES_BLOCK_SIZE) {
 		clogE << "Wrong size for B0\n";
-		return NSSPI::ByteBuffer();
+		return NSSPI::FrameBuffer();
 	}
 	if (X0.size() != NSSPI::IAes::AES_BLOCK_SIZE) {    /* X0 is our iv and should have the size of an AES block */
 		clogE << "Wrong size for X0\n";
-		return NSSPI::ByteBuffer();
+		return NSSPI::FrameBuffer();
 	}
-	uint8_t X0buf[X0.size()];
+	uint8_t X0buf[NSSPI::IAes::AES_BLOCK_SIZE];
 	X0.toMemory(X0buf);
-	std::unique_ptr<NSSPI::IAes> aes = NSSPI::AesBuilder::create();
-
-	aes->set_key(i_gpd_key);
+	const NSSPI::IAes& aes = NSSPI::AesBuilder::shared();
+	const bool dumpDebug = NSSPI::Logger::getInstance()->debugLogger.isOutputting();
 
 	uint8_t Bi_1buf[NSSPI::IAes::AES_BLOCK_SIZE];
 	B0.toMemory(Bi_1buf);
 
 	uint8_t Xibuf[NSSPI::IAes::AES_BLOCK_SIZE];
 
-	clogD << "index runs from 1 to " << std::dec << static_cast<unsigned int>(B.size()/NSSPI::IAes::AES_BLOCK_SIZE+2) << "\n";
+	if (dumpDebug) {
+		clogD << "index runs from 1 to " << std::dec << static_cast<unsigned int>(B.size()/NSSPI::IAes::AES_BLOCK_SIZE+2) << "\n";
+	}
 	for (unsigned int index = 1; index < B.size()/NSSPI::IAes::AES_BLOCK_SIZE+2; index++) {
-		clogD << "B" << std::dec << (index-1) << ": " << NSSPI::Logger::byteSequenceToString(Bi_1buf, NSSPI::IAes::AES_BLOCK_SIZE) << "\n";
-		clogD << "Running AES-CBC cypher on B"  << (index-1) << "\n";
-		aes->cbc_encrypt(Bi_1buf, Xibuf, NSSPI::IAes::AES_BLOCK_SIZE, X0buf);  // Initially, this is X1=cipher.encrypt(X0)
-		clogD << "X" << std::dec << index << ": " << NSSPI::Logger::byteSequenceToString(Xibuf, NSSPI::IAes::AES_BLOCK_SIZE) << "\n";
+		if (dumpDebug) {
+			clogD << "B" << std::dec << (index-1) << ": " << NSSPI::Logger::byteSequenceToString(Bi_1buf, NSSPI::IAes::AES_BLOCK_SIZE) << "\n";
+			clogD << "Running AES-CBC cypher on B"  << (index-1) << "\n";
+		}
+		/* One AES-CBC step: Xi=cipher.encrypt(Xi-1 XOR Bi-1) (initially, this is X1=cipher.encrypt(X0 XOR B0)) */
+		for (unsigned int i=0; i<NSSPI::IAes::AES_BLOCK_SIZE; i++) {
+			X0buf[i] ^= Bi_1buf[i];
+		}
+		aes.encrypt(i_gpd_expanded_key, X0buf, Xibuf);
+		std::copy(Xibuf, Xibuf + NSSPI::IAes::AES_BLOCK_SIZE, X0buf);
+		if (dumpDebug) {
+			clogD << "X" << std::dec << index << ": " << NSSPI::Logger::byteSequenceToString(Xibuf, NSSPI::IAes::AES_BLOCK_SIZE) << "\n";
+		}
 		for (unsigned int i=0; i<NSSPI::IAes::AES_BLOCK_SIZE; i++) {
 			Bi_1buf[i] = B[i + (index-1) * NSSPI::IAes::AES_BLOCK_SIZE];
 		}
 		lastIndex = index;
 	}
 
-	return NSSPI::ByteBuffer(Xibuf, NSSPI::IAes::AES_BLOCK_SIZE);
+	return NSSPI::FrameBuffer(Xibuf, NSSPI::IAes::AES_BLOCK_SIZE);
 }
 
 bool CGpFrame::validateMIC(const EmberKeyData& i_gpd_key) const {
-	if (this->security != EGpSecurityLevel::GPD_FRM_COUNTER_MIC_SECURITY) {
+	NSSPI::IAes::ExpandedKey expandedKey;
+	NSSPI::AesBuilder::shared().expand_key(i_gpd_key, expandedKey);
+	return this->validateMIC(expandedKey);
+}
+
+bool CGpFrame::prepareMICBlocks(uint8_t i_command_id, const NSSPI::FrameBuffer& i_payload, NSSPI::FrameBuffer& o_B0, NSSPI::FrameBuffer& o_B, NSSPI::FrameBuffer& o_A0) const {
+	if (this->security != EGpSecurityLevel::GPD_FRM_COUNTER_MIC_SECURITY && this->security != EGpSecurityLevel::GPD_ENCRYPT_FRM_COUNTER_MIC_SECURITY) {
 		clogW << "Unsupported security level: " << std::dec << this->security << "\n";
 		return false;
 	}
-	clogD << "Command ID from payload: 0x" << std::hex << std::setw(2) << std::setfill('0') << +(this->command_id) << "\n";
+	const bool dumpDebug = NSSPI::Logger::getInstance()->debugLogger.isOutputting();	/* Don't format debug dumps when they are not output, this method is on the RX path of every secured frame */
 	NSEZSP::GPNonce nonce = this->computeNonce(this->source_id, this->security_frame_counter);
-	clogD << "Nonce: " << NSSPI::Logger::byteSequenceToString(nonce) << "\n";
+	if (dumpDebug) {
+		clogD << "Command ID from payload: 0x" << std::hex << std::setw(2) << std::setfill('0') << +(i_command_id) << "\n";
+		clogD << "Nonce: " << NSSPI::Logger::byteSequenceToString(nonce) << "\n";
+	}
 
 	/* Source ID is appended to header only if application ID is 0b000, we always append source ID below, so make sure we don't do it mistakenly */
 	if (this->application_id != 0) {
@@ -197,28 +267,34 @@ bool CGpFrame::validateMIC(const EmberKeyData& i_gpd_key) const {
 	header.at(8) = u32_get_byte2(this->security_frame_counter);
 	header.at(9) = u32_get_byte3(this->security_frame_counter);
 
-	clogD << "Header: " << NSSPI::Logger::byteSequenceToString(header) << "\n";
+	if (dumpDebug) {
+		clogD << "Header: " << NSSPI::Logger::byteSequenceToString(header) << "\n";
+	}
 
-	NSSPI::ByteBuffer a(header);
+	NSSPI::FrameBuffer a;
+	a.append(header);
 
+	/* Define the plain text data (this is message m in AES CCM's terminology) */
+	NSSPI::FrameBuffer plain_text_data;
+	NSSPI::FrameBuffer& authenticated_command = (this->security == EGpSecurityLevel::GPD_ENCRYPT_FRM_COUNTER_MIC_SECURITY ? plain_text_data : a);
+	/* When security_level is 2 or 1, the command is appended to the header and m is an empty string, when security level is 3, the command is m (see 09-5499-25, section A 1.5.4.3.1) */
 	/* First push_back the command ID byte (it is not part of the payload attribute) */
-	a.push_back(this->command_id);
-	/* Append payload to header (only when security_level is 2 or 1 (see 09-5499-25, section A 1.5.4.3.1)) */
-	a.append(this->payload);
+	authenticated_command.push_back(i_command_id);
+	authenticated_command.append(i_payload);
 
-	clogD << "a: " << a << "\n";
+	if (dumpDebug) {
+		clogD << "a: " << a << "\n";
+	}
 
 	uint16_t La = a.size();
 
-	NSSPI::ByteBuffer add_auth_data;
+	NSSPI::FrameBuffer add_auth_data;
 
 	add_auth_data.push_back(u16_get_hi_u8(La));
 	add_auth_data.push_back(u16_get_lo_u8(La));
 	add_auth_data.append(a);
 
-	std::unique_ptr<NSSPI::IAes> aes = NSSPI::AesBuilder::create();
-	aes->set_key(i_gpd_key);
-	NSSPI::ByteBuffer padded_add_auth_data(add_auth_data);    /* Prepare a copy of add_auth_data that is going to be padded to align it to an exact multiple of AES block below */
+	NSSPI::FrameBuffer padded_add_auth_data(add_auth_data);    /* Prepare a copy of add_auth_data that is going to be padded to align it to an exact multiple of AES block below */
 	{
 		unsigned int padToAesBlockSize = padded_add_auth_data.size() % NSSPI::IAes::AES_BLOCK_SIZE;
 		if (padToAesBlockSize>0) {  /* Only pad if there are remaining bytes outside of an AES block boundary */
@@ -227,14 +303,23 @@ bool CGpFrame::validateMIC(const EmberKeyData& i_gpd_key) const {
 			}
 		}
 	}
-	clogD << "padded_add_auth_data: " << padded_add_auth_data << " (" << std::dec << padded_add_auth_data.size() << " bytes)\n";
-
-	/* Define the plain text data (this is message m in AES CCM's terminology) */
-	NSSPI::ByteBuffer plain_text_data; /* AES's m is an empty string when security_level is 2 or 1 (see 09-5499-25, section A 1.5.4.3.1) */
+	if (dumpDebug) {
+		clogD << "padded_add_auth_data: " << padded_add_auth_data << " (" << std::dec << padded_add_auth_data.size() << " bytes)\n";
+	}
 
-	NSSPI::ByteBuffer& padded_plain_text_data = plain_text_data; /* We should pad plain_text_data to be the smallest multiple of NSSPI::IAes::AES_BLOCK_SIZE here, but we unly support security levels leading to an empty value, so we don't do any additional padding here */
-	clogD << "padded_plain_text_data: " << padded_plain_text_data << "\n";
-	NSSPI::ByteBuffer auth_data(std::move(padded_add_auth_data));
+	NSSPI::FrameBuffer padded_plain_text_data(plain_text_data);	/* Prepare a copy of plain_text_data that is going to be padded to align it to an exact multiple of AES block below */
+	{
+		unsigned int padToAesBlockSize = padded_plain_text_data.size() % NSSPI::IAes::AES_BLOCK_SIZE;
+		if (padToAesBlockSize>0) {  /* Only pad if there are remaining bytes outside of an AES block boundary */
+			for (size_t i = 0; i<NSSPI::IAes::AES_BLOCK_SIZE - padToAesBlockSize; i++) {
+				padded_plain_text_data.push_back(0x00);  /* Pad with byte 0x00 */
+			}
+		}
+	}
+	if (dumpDebug) {
+		clogD << "padded_plain_text_data: " << padded_plain_text_data << "\n";
+	}
+	NSSPI::FrameBuffer auth_data(std::move(padded_add_auth_data));
 	auth_data.append(padded_plain_text_data);
 
 	/* Compute the flags, harcoded to 0x49 because:
@@ -244,18 +329,23 @@ bool CGpFrame::validateMIC(const EmberKeyData& i_gpd_key) const {
 	*/
 	uint8_t flags = 0x49U;
 
-	NSSPI::ByteBuffer B0({flags});
+	NSSPI::FrameBuffer& B0 = o_B0;
+	B0.clear();
+	B0.push_back(flags);
 	B0.append(nonce);
 
-	uint16_t Lm = static_cast<uint16_t>(plain_text_data.size());  /* This will always be 0x0000 because m (and thus plain_text_data) is 0 */
+	uint16_t Lm = static_cast<uint16_t>(plain_text_data.size());  /* This is 0x0000 for security levels 1 and 2, because m (and thus plain_text_data) is empty */
 
-	/* The two lines below actually thus append twice 0x00 */
-	B0.push_back(u16_get_lo_u8(Lm));
+	/* Lm is encoded big endian, like La */
 	B0.push_back(u16_get_hi_u8(Lm));
+	B0.push_back(u16_get_lo_u8(Lm));
 
-	clogD << "auth_data: " << auth_data << "\n";
+	if (dumpDebug) {
+		clogD << "auth_data: " << auth_data << "\n";
+	}
 
-	NSSPI::ByteBuffer B(std::move(auth_data));  /* Prepare a copy of auth_data that is going to be padded to align it to an exact multiple of AES block below */
+	NSSPI::FrameBuffer& B = o_B;
+	B = std::move(auth_data);  /* Prepare a copy of auth_data that is going to be padded to align it to an exact multiple of AES block below */
 	{
 		unsigned int padToAesBlockSize = B.size() % NSSPI::IAes::AES_BLOCK_SIZE;
 		if (padToAesBlockSize>0) {  /* Only pad if there are remaining bytes outside of an AES block boundary */
@@ -265,39 +355,122 @@ bool CGpFrame::validateMIC(const EmberKeyData& i_gpd_key) const {
 		}
 	}
 
-	clogD << "B: " << B << " (" << static_cast<unsigned int>(B.size()) << " bytes)\n";
+	if (dumpDebug) {
+		clogD << "B: " << B << " (" << static_cast<unsigned int>(B.size()) << " bytes)\n";
+	}
+
+	/* A0 is the counter block of the AES-CTR part of AES-CCM used to encrypt the MIC (see decryptCommand() for the counter blocks used to encrypt m) */
+	o_A0.clear();
+	o_A0.push_back(flags & 0x03U);
+	o_A0.append(nonce);
+	o_A0.push_back(0x00);
+	o_A0.push_back(0x00);
+	return true;
+}
+
+void CGpFrame::decryptCommand(const NSSPI::IAes::ExpandedKey& i_gpd_expanded_key, uint8_t& o_command_id, NSSPI::FrameBuffer& o_payload) const {
+	const NSSPI::IAes& aes = NSSPI::AesBuilder::shared();
+	NSEZSP::GPNonce nonce = this->computeNonce(this->source_id, this->security_frame_counter);
+	/* AES-CTR part of AES-CCM: m is encrypted using the counter blocks A1, A2... (A0 being used for the MIC) */
+	uint8_t Ai[NSSPI::IAes::AES_BLOCK_SIZE];
+	Ai[0] = 0x01U;	/* Flags: L-1, with L=2 */
+	std::copy(nonce.begin(), nonce.end(), Ai + 1);
+	uint8_t keyStream[NSSPI::IAes::AES_BLOCK_SIZE];
+	std::size_t mLen = 1 + this->payload.size();	/* m is the GPD command ID followed by the GPD command payload */
+	o_payload.clear();
+	for (std::size_t offset = 0; offset < mLen; offset++) {
+		if (offset % NSSPI::IAes::AES_BLOCK_SIZE == 0) {
+			uint16_t counter = static_cast<uint16_t>(offset / NSSPI::IAes::AES_BLOCK_SIZE + 1);
+			Ai[NSSPI::IAes::AES_BLOCK_SIZE - 2] = u16_get_hi_u8(counter);
+			Ai[NSSPI::IAes::AES_BLOCK_SIZE - 1] = u16_get_lo_u8(counter);
+			aes.encrypt(i_gpd_expanded_key, Ai, keyStream);
+		}
+		uint8_t plain = keyStream[offset % NSSPI::IAes::AES_BLOCK_SIZE] ^ (offset == 0 ? this->command_id : this->payload[offset - 1]);
+		if (offset == 0) {
+			o_command_id = plain;
+		}
+		else {
+			o_payload.push_back(plain);
+		}
+	}
+}
+
+bool CGpFrame::validateMIC(const NSSPI::IAes::ExpandedKey& i_gpd_expanded_key) const {
+	if (this->security == EGpSecurityLevel::GPD_ENCRYPT_FRM_COUNTER_MIC_SECURITY && !this->decrypted) {
+		/* The MIC authenticates the plain text command, decrypt it first */
+		uint8_t plainCommandId = 0;
+		NSSPI::FrameBuffer plainPayload;
+		this->decryptCommand(i_gpd_expanded_key, plainCommandId, plainPayload);
+		return this->checkMIC(i_gpd_expanded_key, plainCommandId, plainPayload);
+	}
+	return this->checkMIC(i_gpd_expanded_key, this->command_id, this->payload);
+}
+
+bool CGpFrame::decrypt(const EmberKeyData& i_gpd_key) {
+	NSSPI::IAes::ExpandedKey expandedKey;
+	NSSPI::AesBuilder::shared().expand_key(i_gpd_key, expandedKey);
+	return this->decrypt(expandedKey);
+}
+
+bool CGpFrame::decrypt(const NSSPI::IAes::ExpandedKey& i_gpd_expanded_key) {
+	if (this->security != EGpSecurityLevel::GPD_ENCRYPT_FRM_COUNTER_MIC_SECURITY) {
+		clogW << "Cannot decrypt a GP frame with security level " << std::dec << this->security << "\n";
+		return false;
+	}
+	if (this->decrypted) {
+		return this->checkMIC(i_gpd_expanded_key, this->command_id, this->payload);
+	}
+	uint8_t plainCommandId = 0;
+	NSSPI::FrameBuffer plainPayload;
+	this->decryptCommand(i_gpd_expanded_key, plainCommandId, plainPayload);
+	if (!this->checkMIC(i_gpd_expanded_key, plainCommandId, plainPayload)) {
+		return false;	/* Keep the encrypted command untouched */
+	}
+	this->command_id = plainCommandId;
+	this->payload = std::move(plainPayload);
+	this->decrypted = true;
+	return true;
+}
+
+bool CGpFrame::checkMIC(const NSSPI::IAes::ExpandedKey& i_gpd_expanded_key, uint8_t i_command_id, const NSSPI::FrameBuffer& i_payload) const {
+	NSSPI::FrameBuffer B0;
+	NSSPI::FrameBuffer B;
+	NSSPI::FrameBuffer A0;
+	if (!this->prepareMICBlocks(i_command_id, i_payload, B0, B, A0)) {
+		return false;
+	}
+	const bool dumpDebug = NSSPI::Logger::getInstance()->debugLogger.isOutputting();
 
 	/* X0 contains 16 times 0x00 */
-	NSSPI::ByteBuffer X0 = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+	NSSPI::FrameBuffer X0 = { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
 
 	unsigned int lastIndex;
 
-	clogD << "Running AES-CBC part of AES-CCM\n";
+	if (dumpDebug) {
+		clogD << "Running AES-CBC part of AES-CCM\n";
+	}
 	uint32_t T;
 	{
-		NSSPI::ByteBuffer Xi = CGpFrame::getLastXiAESCBC(i_gpd_key, X0, B0, B, lastIndex);
-		clogD << "Got last Xi result:\n";
-		clogD << "X" << lastIndex << ": " << Xi << "\n";
+		NSSPI::FrameBuffer Xi = CGpFrame::getLastXiAESCBC(i_gpd_expanded_key, X0, B0, B, lastIndex);
+		if (dumpDebug) {
+			clogD << "Got last Xi result:\n";
+			clogD << "X" << lastIndex << ": " << Xi << "\n";
+		}
 
 		T = quad_u8_to_u32(Xi.at(3), Xi.at(2), Xi.at(1), Xi.at(0));    /* Grab the first 4 bytes of Xi, and make it a 32 bit word (little-endian) */
 	} /* Xi now goes out of scope */
 
-	clogD << "T: 0x" << std::hex << std::setw(8) << std::setfill('0') << T << "\n";
-
-	clogD << "Running AES-CTR part of AES-CCM\n";
-
-	NSSPI::ByteBuffer A0;
-	A0.push_back(flags & 0x03U);
-	A0.append(nonce);
-	A0.push_back(0x00);
-	A0.push_back(0x00);
+	if (dumpDebug) {
+		clogD << "T: 0x" << std::hex << std::setw(8) << std::setfill('0') << T << "\n";
+		clogD << "Running AES-CTR part of AES-CCM\n";
+	}
 
-	NSSPI::ByteBuffer& iv = A0;
+	NSSPI::FrameBuffer& iv = A0;
 
-	/* Calculating the MIC (without any encryption), means running AES-CTR only once, with a counter that is equal to the IV
+	/* Calculating the MIC means running AES-CTR only once, with a counter that is equal to the IV
 	 * In that case, we run AES only once, and AES-CTR is just AES-EBC using the IV, XORed with the input.
 	 * In order not to create a dependency on AES-CTR, we will just implement it below using AES-EBC.
-	 * If encryption support is required, some refactor will be needed, where the IV is firs XORed with the 128-bit incrementing counter at each pass.
+	 * The encrypted command of security level 3 frames uses the following counter blocks (see decryptCommand())
 	 */
 	if (iv.size() != NSSPI::IAes::AES_BLOCK_SIZE) {
 		clogE << "Internal error iv does not match AES block size\n";
@@ -306,17 +479,19 @@ bool CGpFrame::validateMIC(const EmberKeyData& i_gpd_key) const {
 	uint8_t ivBuf[NSSPI::IAes::AES_BLOCK_SIZE];
 	iv.toMemory(ivBuf);
 	uint8_t EBuf[NSSPI::IAes::AES_BLOCK_SIZE];
-	aes->encrypt(ivBuf, EBuf);
+	NSSPI::AesBuilder::shared().encrypt(i_gpd_expanded_key, ivBuf, EBuf);
 	//clogD << "E: " << NSSPI::Logger::byteSequenceToString(EBuf, NSSPI::IAes::AES_BLOCK_SIZE) << "\n";
 	/* The code above is commented out, because in our specific case, X0 is full of 0x00 */
 	//for (unsigned int i=0; i<NSSPI::IAes::AES_BLOCK_SIZE; i++) {
 	//    EBuf[i] ^= X0[i];    /* XOR the result of AES on counter with the plaintext */
 	//}
-	NSSPI::ByteBuffer r(EBuf, NSSPI::IAes::AES_BLOCK_SIZE);
+	NSSPI::FrameBuffer r(EBuf, NSSPI::IAes::AES_BLOCK_SIZE);
 
-	clogD << "A0: " << A0 << "\n";
-	clogD << "r(E(Key,A0)): " << r << "\n";
-	clogD << "T: 0x" << std::hex << std::setw(8) << std::setfill('0') << T << "\n";
+	if (dumpDebug) {
+		clogD << "A0: " << A0 << "\n";
+		clogD << "r(E(Key,A0)): " << r << "\n";
+		clogD << "T: 0x" << std::hex << std::setw(8) << std::setfill('0') << T << "\n";
+	}
 
 	if (r.size()<sizeof(T)) {
 		clogE << "Internal error: mismatch bewteen r and T sizes\n";
@@ -326,11 +501,91 @@ bool CGpFrame::validateMIC(const EmberKeyData& i_gpd_key) const {
 	uint32_t U = quad_u8_to_u32(r[3], r[2], r[1], r[0]);    /* Keep only the 4 first bytes of r, store them in U */
 	U ^= T; /* Xor with T */
 
-	clogD << "Re-calculated MIC: 0x" << std::hex << std::setw(8) << std::setfill('0') << U << "\n";
-	clogD << "MIC enclosed in GP frame: 0x" << std::hex << std::setw(8) << std::setfill('0') << this->mic << "\n";
+	if (dumpDebug) {
+		clogD << "Re-calculated MIC: 0x" << std::hex << std::setw(8) << std::setfill('0') << U << "\n";
+		clogD << "MIC enclosed in GP frame: 0x" << std::hex << std::setw(8) << std::setfill('0') << this->mic << "\n";
+	}
 	return (this->mic == U);
 }
 
+void CGpFrame::validateMICBatch(const CGpFrame* const frames[], const NSSPI::IAes::ExpandedKey* const keys[], std::size_t count, bool o_results[]) {
+	const NSSPI::IAes& aes = NSSPI::AesBuilder::shared();
+
+	for (std::size_t first = 0; first < count; first += MIC_BATCH_LANES) {
+		NSSPI::FrameBuffer B0[MIC_BATCH_LANES];
+		NSSPI::FrameBuffer B[MIC_BATCH_LANES];
+		NSSPI::FrameBuffer A0[MIC_BATCH_LANES];
+		unsigned int frameIndex[MIC_BATCH_LANES];	/* Index in frames[] of each active lane */
+		std::size_t nbBlocks[MIC_BATCH_LANES];	/* Number of AES-CBC blocks (B0 included) of each active lane */
+		const NSSPI::IAes::ExpandedKey* laneKeys[MIC_BATCH_LANES];
+		uint8_t X[MIC_BATCH_LANES][NSSPI::IAes::AES_BLOCK_SIZE];	/* Current AES-CBC output (Xi) of each active lane */
+		uint8_t in[MIC_BATCH_LANES][NSSPI::IAes::AES_BLOCK_SIZE];
+		unsigned int nbLanes = 0;
+		std::size_t maxBlocks = 0;
+
+		std::size_t last = std::min(count, first + MIC_BATCH_LANES);
+		for (std::size_t i = first; i < last; i++) {
+			o_results[i] = false;
+			if (keys[i] == nullptr) {
+				continue;
+			}
+			if (frames[i]->security == EGpSecurityLevel::GPD_ENCRYPT_FRM_COUNTER_MIC_SECURITY && !frames[i]->decrypted) {
+				o_results[i] = frames[i]->validateMIC(*keys[i]);	/* The command must be decrypted before its MIC can be computed, not batched */
+				continue;
+			}
+			if (!frames[i]->prepareMICBlocks(frames[i]->command_id, frames[i]->payload, B0[nbLanes], B[nbLanes], A0[nbLanes])) {
+				continue;
+			}
+			if (B0[nbLanes].size() != NSSPI::IAes::AES_BLOCK_SIZE || B[nbLanes].size() % NSSPI::IAes::AES_BLOCK_SIZE != 0 || A0[nbLanes].size() != NSSPI::IAes::AES_BLOCK_SIZE) {
+				clogE << "Internal error: MIC blocks do not match AES block size\n";
+				continue;
+			}
+			frameIndex[nbLanes] = static_cast<unsigned int>(i);
+			nbBlocks[nbLanes] = 1 + B[nbLanes].size() / NSSPI::IAes::AES_BLOCK_SIZE;
+			maxBlocks = std::max(maxBlocks, nbBlocks[nbLanes]);
+			nbLanes++;
+		}
+
+		/* AES-CBC part of AES-CCM, one block of each lane at a time (X0 is null, so the first input block is B0 itself) */
+		unsigned int laneMap[MIC_BATCH_LANES];	/* Lane owning each block passed to encrypt_blocks() */
+		for (std::size_t step = 0; step < maxBlocks; step++) {
+			unsigned int nbInputs = 0;
+			for (unsigned int lane = 0; lane < nbLanes; lane++) {
+				if (step >= nbBlocks[lane]) {
+					continue;	/* This frame is shorter, its chain is already complete */
+				}
+				if (step == 0) {
+					B0[lane].toMemory(in[nbInputs]);
+				}
+				else {
+					for (unsigned int j = 0; j < NSSPI::IAes::AES_BLOCK_SIZE; j++) {
+						in[nbInputs][j] = static_cast<uint8_t>(X[lane][j] ^ B[lane][(step - 1) * NSSPI::IAes::AES_BLOCK_SIZE + j]);
+					}
+				}
+				laneKeys[nbInputs] = keys[frameIndex[lane]];
+				laneMap[nbInputs] = lane;
+				nbInputs++;
+			}
+			aes.encrypt_blocks(laneKeys, in, in, nbInputs);
+			for (unsigned int input = 0; input < nbInputs; input++) {
+				memcpy(X[laneMap[input]], in[input], NSSPI::IAes::AES_BLOCK_SIZE);
+			}
+		}
+
+		/* AES-CTR part of AES-CCM, for all lanes at once */
+		for (unsigned int lane = 0; lane < nbLanes; lane++) {
+			A0[lane].toMemory(in[lane]);
+			laneKeys[lane] = keys[frameIndex[lane]];
+		}
+		aes.encrypt_blocks(laneKeys, in, in, nbLanes);
+		for (unsigned int lane = 0; lane < nbLanes; lane++) {
+			uint32_t T = quad_u8_to_u32(X[lane][3], X[lane][2], X[lane][1], X[lane][0]);
+			uint32_t U = quad_u8_to_u32(in[lane][3], in[lane][2], in[lane][1], in[lane][0]) ^ T;
+			o_results[frameIndex[lane]] = (frames[frameIndex[lane]]->mic == U);
+		}
+	}
+}
+
 std::string CGpFrame::String() const {
 	std::stringstream buf;
 
@@ -347,7 +602,96 @@ std::string CGpFrame::String() const {
 	buf << "[mic: "<< std::hex << std::setw(8) << std::setfill('0') << static_cast<unsigned int>(mic) << "]";
 	buf << "[proxy_table_entry: 0x"<< std::hex << std::setw(2) << std::setfill('0') << +(proxy_table_entry) << "]";
 	buf << "[payload:" << payload << "]";
+	if (this->decrypted) {
+		buf << "[decrypted]";
+	}
 	buf << " }";
 
 	return buf.str();
 }
+
+CGpFrameView::CGpFrameView(NSSPI::ByteView raw_message) :
+	raw(raw_message),
+	frame(nullptr) {
+	if (raw_message.size() > APPLICATION_ID_OFFSET && raw_message[APPLICATION_ID_OFFSET] != 0) {
+		clogW << "Unsupported application ID: " << std::dec << static_cast<unsigned int>(raw_message[APPLICATION_ID_OFFSET]) << ". Ignoring\n";
+		this->frame = &invalidFrame();
+	}
+	else if (raw_message.size() <= PAYLOAD_LENGTH_OFFSET || raw_message.size() < PAYLOAD_OFFSET + raw_message[PAYLOAD_LENGTH_OFFSET]) {
+		clogE << "Truncated GP frame: " << NSSPI::Logger::byteSequenceToString(raw_message.data(), raw_message.size()) << "\n";
+		this->frame = &invalidFrame();
+	}
+}
+
+CGpFrameView::CGpFrameView(const CGpFrame& frame) :
+	raw(),
+	frame(&frame) {
+}
+
+bool CGpFrameView::isValid() const {
+	return (this->frame == nullptr || this->frame->isValid());
+}
+
+uint8_t CGpFrameView::getApplicationId() const {
+	return (this->frame != nullptr ? this->frame->getApplicationId() : this->raw[APPLICATION_ID_OFFSET]);
+}
+
+uint8_t CGpFrameView::getLinkValue() const {
+	return (this->frame != nullptr ? this->frame->getLinkValue() : this->raw[LINK_VALUE_OFFSET]);
+}
+
+uint8_t CGpFrameView::getSequenceNumber() const {
+	return (this->frame != nullptr ? this->frame->getSequenceNumber() : this->raw[SEQUENCE_NUMBER_OFFSET]);
+}
+
+uint32_t CGpFrameView::getSourceId() const {
+	return (this->frame != nullptr ? this->frame->getSourceId() : readU32le(this->raw, SOURCE_ID_OFFSET));
+}
+
+NSEZSP::EGpSecurityLevel CGpFrameView::getSecurity() const {
+	return (this->frame != nullptr ? this->frame->getSecurity() : static_cast<EGpSecurityLevel>(this->raw[SECURITY_OFFSET]));
+}
+
+NSEZSP::EGpSecurityKeyType CGpFrameView::getKeyType() const {
+	return (this->frame != nullptr ? this->frame->getKeyType() : static_cast<EGpSecurityKeyType>(this->raw[KEY_TYPE_OFFSET]));
+}
+
+bool CGpFrameView::isAutoCommissioning() const {
+	return (this->frame != nullptr ? this->frame->isAutoCommissioning() : (this->raw[AUTO_COMMISSIONING_OFFSET] != 0));
+}
+
+bool CGpFrameView::isRxAfterTx() const {
+	return (this->frame != nullptr ? this->frame->isRxAfterTx() : (this->raw[RX_AFTER_TX_OFFSET] != 0));
+}
+
+uint32_t CGpFrameView::getSecurityFrameCounter() const {
+	return (this->frame != nullptr ? this->frame->getSecurityFrameCounter() : readU32le(this->raw, FRAME_COUNTER_OFFSET));
+}
+
+uint8_t CGpFrameView::getCommandId() const {
+	return (this->frame != nullptr ? this->frame->getCommandId() : this->raw[COMMAND_ID_OFFSET]);
+}
+
+uint32_t CGpFrameView::getMic() const {
+	return (this->frame != nullptr ? this->frame->getMic() : readU32le(this->raw, MIC_OFFSET));
+}
+
+uint8_t CGpFrameView::getProxyTableEntry() const {
+	return (this->frame != nullptr ? this->frame->getProxyTableEntry() : this->raw[PROXY_TABLE_ENTRY_OFFSET]);
+}
+
+NSSPI::ByteView CGpFrameView::getPayloadView() const {
+	return (this->frame != nullptr ? this->frame->getPayloadView() : this->raw.subView(PAYLOAD_OFFSET, this->raw[PAYLOAD_LENGTH_OFFSET]));
+}
+
+bool CGpFrameView::isDecrypted() const {
+	return (this->frame != nullptr && this->frame->isDecrypted());
+}
+
+CGpFrame CGpFrameView::retain() const {
+	return (this->frame != nullptr ? *this->frame : CGpFrame(this->raw));
+}
+
+std::string CGpFrameView::String() const {
+	return (this->frame != nullptr ? this->frame->String() : CGpFrame(this->raw).String());
+}
@@ -0,0 +1,198 @@
+/**
+ * @file green-power-payload-decoders.cpp
+ *
+ * @brief Decoding of GPD command payloads into typed events, dispatched by GPD command ID
+ */
+
+#include "ezsp/zbmessage/green-power-payload-decoders.h"
+#include "ezsp/zbmessage/zcl.h"
+#include "spi/ByteReader.h"
+
+using NSEZSP::CGpPayloadDecoders;
+using NSEZSP::CGpAttributeReport;
+using NSEZSP::NSGPF::GPF_SCENE_0_CMD;
+using NSEZSP::NSGPF::GPF_STORE_SCENE_0_CMD;
+using NSEZSP::NSGPF::GPF_STORE_SCENE_7_CMD;
+using NSEZSP::NSGPF::GPF_OFF_CMD;
+using NSEZSP::NSGPF::GPF_ON_CMD;
+using NSEZSP::NSGPF::GPF_TOGGLE_CMD;
+using NSEZSP::NSGPF::GPF_ATTRIBUTE_REPORTING;
+using NSEZSP::NSGPF::GPF_MANUFACTURER_ATTRIBUTE_REPORTING;
+using NSEZSP::NSGPF::GPF_MULTI_CLUSTER_REPORTING;
+using NSEZSP::NSGPF::GPF_MANUFACTURER_MULTI_CLUSTER_REPORTING;
+
+namespace {
+/**
+ * @brief Get the size of the values of a fixed-size ZCL attribute type
+ *
+ * @return The size in bytes, 0 for types without data, or -1 if @p i_type has a variable size or is not supported
+ */
+int fixedAttributeSize(uint8_t i_type) {
+	if (i_type >= NSEZSP::ZCL_DATA8_ATTRIBUTE_TYPE && i_type <= NSEZSP::ZCL_DATA64_ATTRIBUTE_TYPE) {
+		return i_type - NSEZSP::ZCL_DATA8_ATTRIBUTE_TYPE + 1;
+	}
+	if (i_type >= NSEZSP::ZCL_BITMAP8_ATTRIBUTE_TYPE && i_type <= NSEZSP::ZCL_BITMAP64_ATTRIBUTE_TYPE) {
+		return i_type - NSEZSP::ZCL_BITMAP8_ATTRIBUTE_TYPE + 1;
+	}
+	if (i_type >= NSEZSP::ZCL_INT8U_ATTRIBUTE_TYPE && i_type <= NSEZSP::ZCL_INT64U_ATTRIBUTE_TYPE) {
+		return i_type - NSEZSP::ZCL_INT8U_ATTRIBUTE_TYPE + 1;
+	}
+	if (i_type >= NSEZSP::ZCL_INT8S_ATTRIBUTE_TYPE && i_type <= NSEZSP::ZCL_INT64S_ATTRIBUTE_TYPE) {
+		return i_type - NSEZSP::ZCL_INT8S_ATTRIBUTE_TYPE + 1;
+	}
+	switch (i_type) {
+	case NSEZSP::ZCL_NO_DATA_ATTRIBUTE_TYPE:
+		return 0;
+	case NSEZSP::ZCL_BOOLEAN_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_ENUM8_ATTRIBUTE_TYPE:
+		return 1;
+	case NSEZSP::ZCL_ENUM16_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_FLOAT_SEMI_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_CLUSTER_ID_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_ATTRIBUTE_ID_ATTRIBUTE_TYPE:
+		return 2;
+	case NSEZSP::ZCL_FLOAT_SINGLE_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_TIME_OF_DAY_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_DATE_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_UTC_TIME_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_BACNET_OID_ATTRIBUTE_TYPE:
+		return 4;
+	case NSEZSP::ZCL_FLOAT_DOUBLE_ATTRIBUTE_TYPE:
+	case NSEZSP::ZCL_IEEE_ADDRESS_ATTRIBUTE_TYPE:
+		return 8;
+	case NSEZSP::ZCL_SECURITY_KEY_ATTRIBUTE_TYPE:
+		return 16;
+	default:
+		return -1;
+	}
+}
+}
+
+CGpPayloadDecoders::CGpPayloadDecoders() :
+	decoders() {
+	this->decoders.fill(nullptr);
+	for (uint8_t command_id = GPF_SCENE_0_CMD; command_id <= GPF_STORE_SCENE_7_CMD; command_id++) {
+		this->decoders[command_id] = &CGpPayloadDecoders::decodeScene;
+	}
+	this->decoders[GPF_OFF_CMD] = &CGpPayloadDecoders::decodeOnOff;
+	this->decoders[GPF_ON_CMD] = &CGpPayloadDecoders::decodeOnOff;
+	this->decoders[GPF_TOGGLE_CMD] = &CGpPayloadDecoders::decodeOnOff;
+	this->decoders[GPF_ATTRIBUTE_REPORTING] = &CGpPayloadDecoders::decodeAttributeReporting;
+	this->decoders[GPF_MANUFACTURER_ATTRIBUTE_REPORTING] = &CGpPayloadDecoders::decodeAttributeReporting;
+	this->decoders[GPF_MULTI_CLUSTER_REPORTING] = &CGpPayloadDecoders::decodeAttributeReporting;
+	this->decoders[GPF_MANUFACTURER_MULTI_CLUSTER_REPORTING] = &CGpPayloadDecoders::decodeAttributeReporting;
+}
+
+void CGpPayloadDecoders::registerDecoder(uint8_t i_command_id, FDecoder i_decoder) {
+	this->decoders[i_command_id] = i_decoder;
+}
+
+bool CGpPayloadDecoders::hasDecoder(uint8_t i_command_id) const {
+	return (this->decoders[i_command_id] != nullptr);
+}
+
+bool CGpPayloadDecoders::decode(const CGpFrameView& i_gpf, CGpPayloadVisitor& io_visitor) const {
+	FDecoder l_decoder = this->decoders[i_gpf.getCommandId()];
+	if (l_decoder == nullptr) {
+		return false;
+	}
+	return l_decoder(i_gpf, io_visitor);
+}
+
+bool CGpPayloadDecoders::decodeOnOff(const CGpFrameView& i_gpf, CGpPayloadVisitor& io_visitor) {
+	switch (i_gpf.getCommandId()) {
+	case GPF_OFF_CMD:
+		io_visitor.handleOnOff(i_gpf, CGpOnOffAction::Off);
+		return true;
+	case GPF_ON_CMD:
+		io_visitor.handleOnOff(i_gpf, CGpOnOffAction::On);
+		return true;
+	case GPF_TOGGLE_CMD:
+		io_visitor.handleOnOff(i_gpf, CGpOnOffAction::Toggle);
+		return true;
+	default:
+		return false;
+	}
+}
+
+bool CGpPayloadDecoders::decodeScene(const CGpFrameView& i_gpf, CGpPayloadVisitor& io_visitor) {
+	uint8_t l_command_id = i_gpf.getCommandId();
+	if (l_command_id < GPF_SCENE_0_CMD || l_command_id > GPF_STORE_SCENE_7_CMD) {
+		return false;
+	}
+	CGpSceneEvent l_event = { (l_command_id >= GPF_STORE_SCENE_0_CMD), static_cast<uint8_t>((l_command_id - GPF_SCENE_0_CMD) & 0x07U) };
+	io_visitor.handleScene(i_gpf, l_event);
+	return true;
+}
+
+bool CGpPayloadDecoders::decodeAttributeReporting(const CGpFrameView& i_gpf, CGpPayloadVisitor& io_visitor) {
+	uint8_t l_command_id = i_gpf.getCommandId();
+	if (l_command_id < GPF_ATTRIBUTE_REPORTING || l_command_id > GPF_MANUFACTURER_MULTI_CLUSTER_REPORTING) {
+		return false;
+	}
+	/* 0xA0: cluster ID, then attribute records. 0xA2: records each starting with their own cluster ID. 0xA1 and 0xA3: same, after a manufacturer ID */
+	bool l_manufacturer_specific = (l_command_id == GPF_MANUFACTURER_ATTRIBUTE_REPORTING || l_command_id == GPF_MANUFACTURER_MULTI_CLUSTER_REPORTING);
+	bool l_multi_cluster = (l_command_id == GPF_MULTI_CLUSTER_REPORTING || l_command_id == GPF_MANUFACTURER_MULTI_CLUSTER_REPORTING);
+
+	NSSPI::ByteReader reader(i_gpf.getPayloadView());
+	CGpAttributeReport l_report;
+	l_report.manufacturerSpecific = l_manufacturer_specific;
+	l_report.manufacturerId = (l_manufacturer_specific ? reader.readU16le() : 0);
+	l_report.clusterId = (l_multi_cluster ? 0 : reader.readU16le());
+	if (reader.hasError()) {
+		return false;
+	}
+	while (reader.remaining() > 0) {
+		if (l_multi_cluster) {
+			l_report.clusterId = reader.readU16le();
+		}
+		l_report.attributeId = reader.readU16le();
+		l_report.type = reader.readU8();
+		std::size_t l_size = 0;
+		if (reader.hasError() || !CGpPayloadDecoders::readAttributeValue(l_report.type, reader.remainingView(), l_report, l_size)) {
+			return false;
+		}
+		reader.skip(l_size);
+		io_visitor.handleAttributeReport(i_gpf, l_report);
+	}
+	return true;
+}
+
+bool CGpPayloadDecoders::readAttributeValue(uint8_t i_type, NSSPI::ByteView i_data, CGpAttributeReport& o_report, std::size_t& o_size) {
+	o_report.rawValue = 0;
+	int l_fixed_size = fixedAttributeSize(i_type);
+	if (l_fixed_size >= 0) {
+		o_size = static_cast<std::size_t>(l_fixed_size);
+		if (i_data.size() < o_size) {
+			return false;
+		}
+		o_report.value = i_data.subView(0, o_size);
+		if (o_size <= sizeof(o_report.rawValue)) {
+			for (std::size_t i = o_size; i > 0; i--) {
+				o_report.rawValue = (o_report.rawValue << 8) | i_data[i - 1];
+			}
+		}
+		return true;
+	}
+	std::size_t l_length_size;
+	if (i_type == ZCL_OCTET_STRING_ATTRIBUTE_TYPE || i_type == ZCL_CHAR_STRING_ATTRIBUTE_TYPE) {
+		l_length_size = 1;
+	}
+	else if (i_type == ZCL_LONG_OCTET_STRING_ATTRIBUTE_TYPE || i_type == ZCL_LONG_CHAR_STRING_ATTRIBUTE_TYPE) {
+		l_length_size = 2;
+	}
+	else {
+		return false;	/* Arrays, structures, sets and bags are not supported */
+	}
+	NSSPI::ByteReader reader(i_data);
+	std::size_t l_length = (l_length_size == 1 ? reader.readU8() : reader.readU16le());
+	if (l_length == (l_length_size == 1 ? 0xFFU : 0xFFFFU)) {
+		l_length = 0;	/* Invalid (unset) string, no characters follow */
+	}
+	if (reader.hasError() || reader.remaining() < l_length) {
+		return false;
+	}
+	o_report.value = i_data.subView(l_length_size, l_length);
+	o_size = l_length_size + l_length;
+	return true;
+}
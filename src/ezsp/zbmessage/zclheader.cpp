@@ -7,6 +7,7 @@
 #include "ezsp/zbmessage/zclheader.h"
 
 #include "ezsp/byte-manip.h"
+#include "spi/ByteReader.h"
 
 using NSEZSP::CZCLHeader;
 
@@ -26,17 +27,19 @@ CZCLHeader::CZCLHeader() :
  *
  * Total of bytes expected: 5 (if manufacturer code is present) or 3 otherwise
  */
-CZCLHeader::CZCLHeader(const NSSPI::ByteBuffer& i_data, uint8_t& o_idx) :
-	frm_ctrl(i_data.at(0)),
-	manufacturer_code(frm_ctrl.IsManufacturerCodePresent()?dble_u8_to_u16(i_data.at(2), i_data.at(1)):0),
-	transaction_number(frm_ctrl.IsManufacturerCodePresent()?i_data.at(3):i_data.at(1)),
-	cmd_id(frm_ctrl.IsManufacturerCodePresent()?i_data.at(4):i_data.at(2)) {
+CZCLHeader::CZCLHeader(NSSPI::ByteView i_data, uint8_t& o_idx) :
+	frm_ctrl(i_data.empty()?0:i_data[0]),
+	manufacturer_code(0),
+	transaction_number(0),
+	cmd_id(0) {
+	NSSPI::ByteReader reader(i_data);
+	reader.skip(1);	/* frm_ctrl, already decoded above */
 	if( frm_ctrl.IsManufacturerCodePresent() ) {
-		o_idx=5;	/* When manufacturer code is present, the header is 5-bytes long */
-	}
-	else {
-		o_idx=3;	/* otherwise, it is 3-bytes long */
+		manufacturer_code = reader.readU16le();
 	}
+	transaction_number = reader.readU8();
+	cmd_id = reader.readU8();
+	o_idx = static_cast<uint8_t>(reader.position());	/* 5 bytes when manufacturer code is present, 3 otherwise */
 }
 
 /**
@@ -10,6 +10,7 @@
 
 #include "zclframecontrol.h"
 #include "spi/ByteBuffer.h"
+#include "spi/ByteView.h"
 
 // manufacturer code
 constexpr uint16_t PUBLIC_CODE = 0xFFFF;
@@ -41,7 +42,7 @@ public:
 	 * @param[in] i_data The buffer to parse in order to construct this instance
 	 * @param[out] o_idx The number of bytes used (in buffer i_data) to construct the ZCL header
 	 */
-	CZCLHeader(const NSSPI::ByteBuffer& i_data, uint8_t& o_idx);
+	CZCLHeader(NSSPI::ByteView i_data, uint8_t& o_idx);
 
 	// high level
 
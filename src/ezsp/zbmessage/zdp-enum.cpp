@@ -8,7 +8,7 @@
 using NSEZSP::CZdpEnum;
 
 std::string CZdpEnum::ToString( EZdpLowByte in ) {
-	const std::map<EZdpLowByte,std::string> MyEnumStrings {
+	static const std::map<EZdpLowByte,std::string> MyEnumStrings {
 		{ ZDP_MGMT_BIND, "ZDP_MGMT_BIND" },
 		{ ZDP_MGMT_RTG, "ZDP_MGMT_RTG" },
 		{ ZDP_MGMT_LQI, "ZDP_MGMT_LQI" },
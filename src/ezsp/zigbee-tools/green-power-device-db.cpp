@@ -5,48 +5,450 @@
  */
 
 #include <iomanip>
+#include <algorithm>	// For std::fill(), std::max(), std::sort(), std::unique()
 
 #include "spi/ILogger.h"
+#include "spi/AesBuilder.h"
 #include "green-power-device-db.h"
 
 using NSEZSP::CGPDeviceDb;
+using NSEZSP::CGPDeviceStore;
 
-CGPDeviceDb::CGPDeviceDb() :
-	gp_dev_list() {
+constexpr uint32_t CGPDeviceDb::EMPTY_SLOT;
+constexpr std::size_t CGPDeviceDb::FRAME_COUNTER_FLUSH_BATCH;
+constexpr std::chrono::seconds CGPDeviceDb::FRAME_COUNTER_FLUSH_INTERVAL;
+
+namespace {
+constexpr std::size_t MIN_SLOTS = 16;	/* Initial number of slots when a dynamically sized table gets its first device */
+constexpr std::size_t MIN_LOG_RECORDS_BEFORE_COMPACTION = 1024;	/* The delta log is compacted when it gets longer than this and than the number of devices */
+constexpr uint32_t EXHAUSTED_FRAME_COUNTER = 0xffffffffU;	/* Next frame counter of a device that has used its last frame counter: nothing is accepted anymore */
+}
+
+CGPDeviceDb::CGPDeviceDb(std::size_t maxDevices) :
+	maxDevices(maxDevices),
+	nbDevices(0),
+	nbSlots(0),
+	sourceIds(nullptr),
+	keys(nullptr),
+	frameCounters(nullptr),
+	expandedKeys(nullptr),
+	ownedSourceIds(),
+	ownedKeys(),
+	ownedFrameCounters(),
+	ownedExpandedKeys(),
+	store(),
+	dirtyFrameCounters(),
+	flushedFrameCounters(),
+	lastFrameCounterFlush(std::chrono::steady_clock::now()),
+	filter(),
+	nbFilterStaleSourceIds(0) {
+	if (maxDevices > 0) {
+		this->rehash(CGPDeviceDb::slotsForDevices(maxDevices));
+	}
+}
+
+CGPDeviceDb::~CGPDeviceDb() {
+	this->flushFrameCounters(true);
+}
+
+std::size_t CGPDeviceDb::slotsForDevices(std::size_t nbDevices) {
+	return nbDevices + nbDevices / 4 + 1;	/* Maximum load factor of 80%, linear probing sequences remain short */
+}
+
+std::size_t CGPDeviceDb::homeSlot(uint32_t i_source_id) const {
+	/* Fibonacci hashing to spread sequential source IDs, then map the 32-bit hash on the number of slots (no modulo, no power of 2 constraint) */
+	uint32_t hash = i_source_id * 0x9e3779b1U;
+	return static_cast<std::size_t>((static_cast<uint64_t>(hash) * this->nbSlots) >> 32);
+}
+
+std::size_t CGPDeviceDb::findSlot(uint32_t i_source_id) const {
+	std::size_t slot = this->homeSlot(i_source_id);
+	while (this->sourceIds[slot] != i_source_id && this->sourceIds[slot] != EMPTY_SLOT) {
+		if (++slot == this->nbSlots) {
+			slot = 0;
+		}
+	}
+	return slot;
+}
+
+void CGPDeviceDb::storeAt(std::size_t slot, uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key) {
+	this->sourceIds[slot] = i_source_id;
+	this->keys[slot] = i_key;
+	this->frameCounters[slot] = 0;
+	NSSPI::AesBuilder::shared().expand_key(i_key, this->expandedKeys[slot]);
+	this->filter.insert(i_source_id);
+}
+
+void CGPDeviceDb::moveSlot(std::size_t from, std::size_t to) {
+	this->sourceIds[to] = this->sourceIds[from];
+	this->keys[to] = this->keys[from];
+	this->frameCounters[to] = this->frameCounters[from];
+	this->expandedKeys[to] = this->expandedKeys[from];
+	this->sourceIds[from] = EMPTY_SLOT;
+}
+
+void CGPDeviceDb::useOwnedTable() {
+	this->nbSlots = this->ownedSourceIds.size();
+	this->sourceIds = this->ownedSourceIds.data();
+	this->keys = this->ownedKeys.data();
+	this->frameCounters = this->ownedFrameCounters.data();
+	this->expandedKeys = this->ownedExpandedKeys.data();
+}
+
+CGPDeviceStore::Table CGPDeviceDb::currentTable() const {
+	CGPDeviceStore::Table table;
+	table.nbSlots = this->nbSlots;
+	table.nbDevices = this->nbDevices;
+	table.sourceIds = this->sourceIds;
+	table.keys = this->keys;
+	table.frameCounters = this->frameCounters;
+	return table;
+}
+
+void CGPDeviceDb::rehash(std::size_t nbSlots) {
+	std::vector<uint32_t> oldSourceIds(nbSlots, EMPTY_SLOT);
+	std::vector<NSEZSP::EmberKeyData> oldKeys(nbSlots);
+	std::vector<uint32_t> oldFrameCounters(nbSlots, 0);
+	std::vector<NSSPI::IAes::ExpandedKey> oldExpandedKeys(nbSlots);
+	/* Switch to the new (empty) arrays, then re-insert everything from the old ones */
+	oldSourceIds.swap(this->ownedSourceIds);
+	oldKeys.swap(this->ownedKeys);
+	oldFrameCounters.swap(this->ownedFrameCounters);
+	oldExpandedKeys.swap(this->ownedExpandedKeys);
+	this->useOwnedTable();
+	for (std::size_t oldSlot = 0; oldSlot < oldSourceIds.size(); oldSlot++) {
+		if (oldSourceIds[oldSlot] == EMPTY_SLOT) {
+			continue;
+		}
+		std::size_t slot = this->findSlot(oldSourceIds[oldSlot]);
+		this->sourceIds[slot] = oldSourceIds[oldSlot];
+		this->keys[slot] = oldKeys[oldSlot];
+		this->frameCounters[slot] = oldFrameCounters[oldSlot];
+		this->expandedKeys[slot] = oldExpandedKeys[oldSlot];	/* Key schedules are moved, not recomputed */
+	}
+	this->rebuildFilter();	/* Capacity may have changed */
+}
+
+bool CGPDeviceDb::reserveOneMore() {
+#ifdef USE_STATIC_ALLOCATION
+	return (this->nbDevices < this->maxDevices);	/* The table has been sized for maxDevices at construction */
+#else
+	if (CGPDeviceDb::slotsForDevices(this->nbDevices + 1) > this->nbSlots) {
+		this->rehash(std::max(MIN_SLOTS, 2 * this->nbSlots));
+	}
+	return true;
+#endif
+}
+
+void CGPDeviceDb::resetTable() {
+	std::fill(this->sourceIds, this->sourceIds + this->nbSlots, EMPTY_SLOT);	/* Keeps the reserved storage */
+	this->nbDevices = 0;
+	this->rebuildFilter();
+}
+
+void CGPDeviceDb::loadDevice(uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key, uint32_t i_frame_counter) {
+	if (i_source_id == EMPTY_SLOT || !this->reserveOneMore()) {
+		return;	/* Cannot happen with a valid snapshot, whose device count has been checked against our capacity */
+	}
+	std::size_t slot = this->findSlot(i_source_id);
+	if (this->sourceIds[slot] == EMPTY_SLOT) {
+		this->nbDevices++;
+	}
+	this->storeAt(slot, i_source_id, i_key);	/* Re-computes the key schedule */
+	this->frameCounters[slot] = i_frame_counter;
+}
+
+void CGPDeviceDb::rebuildFilter() {
+	this->filter.reset(std::max(this->capacity(), this->nbDevices));
+	for (std::size_t slot = 0; slot < this->nbSlots; slot++) {
+		if (this->sourceIds[slot] != EMPTY_SLOT) {
+			this->filter.insert(this->sourceIds[slot]);
+		}
+	}
+	this->nbFilterStaleSourceIds = 0;
+}
+
+bool CGPDeviceDb::openStore(const std::string& i_path) {
+	this->closeStore();
+	std::size_t l_nb_devices = 0;
+	if (!this->store.open(i_path, l_nb_devices)) {
+		return false;
+	}
+	this->dirtyFrameCounters.reserve(FRAME_COUNTER_FLUSH_BATCH);	/* Allocated once, as frame counters are updated on the RX path */
+	this->flushedFrameCounters.reserve(FRAME_COUNTER_FLUSH_BATCH);
+#ifdef USE_STATIC_ALLOCATION
+	if (l_nb_devices > this->maxDevices) {
+		clogE << "GP device store " << i_path << " contains " << std::dec << l_nb_devices << " devices, more than the capacity ("
+		      << this->maxDevices << " devices)\n";
+		this->store.close();
+		return false;
+	}
+#endif
+	this->resetTable();
+#ifndef USE_STATIC_ALLOCATION
+	if (CGPDeviceDb::slotsForDevices(l_nb_devices) > this->nbSlots) {
+		this->rehash(CGPDeviceDb::slotsForDevices(l_nb_devices));	/* Bulk load: size the table once */
+	}
+#endif
+	bool loaded = this->store.load([this](uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key, uint32_t i_frame_counter) {
+		this->loadDevice(i_source_id, i_key, i_frame_counter);
+	});
+	bool replayed = loaded && this->store.replayLog([this](CGPDeviceStore::Operation i_operation, uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key, uint32_t i_frame_counter) {
+		switch (i_operation) {
+		case CGPDeviceStore::Operation::ADD:
+			this->insertDevice(i_source_id, i_key);
+			break;
+		case CGPDeviceStore::Operation::REMOVE:
+			this->removeDevice(i_source_id);
+			break;
+		case CGPDeviceStore::Operation::FRAME_COUNTER:
+			if (this->nbSlots > 0) {
+				std::size_t slot = this->findSlot(i_source_id);
+				if (this->sourceIds[slot] == i_source_id) {
+					this->frameCounters[slot] = i_frame_counter;
+				}
+			}
+			break;
+		}
+	});
+	if (!replayed) {
+		this->closeStore();	/* What could be loaded is kept in memory */
+		return false;
+	}
+	clogI << "GP device store " << i_path << " opened with " << std::dec << this->nbDevices << " devices\n";
+	if (l_nb_devices == 0) {
+		this->saveStore();	/* Create the snapshot of a new store */
+	}
+	else {
+		this->compactStoreIfNeeded();
+	}
+	return true;
+}
+
+bool CGPDeviceDb::saveStore() {
+	if (!this->store.isOpen()) {
+		return false;
+	}
+	if (!this->store.save(this->currentTable())) {
+		return false;
+	}
+	this->dirtyFrameCounters.clear();	/* Frame counters are in the snapshot */
+	this->lastFrameCounterFlush = std::chrono::steady_clock::now();
+	return true;
+}
+
+void CGPDeviceDb::closeStore() {
+	this->flushFrameCounters(true);
+	this->store.close();
+}
+
+void CGPDeviceDb::compactStoreIfNeeded() {
+	if (this->store.logRecords() > std::max(MIN_LOG_RECORDS_BEFORE_COMPACTION, this->nbDevices)) {
+		this->saveStore();
+	}
 }
 
 void CGPDeviceDb::clear() {
-	this->gp_dev_list.clear();
+	this->resetTable();
+	this->saveStore();	/* Does nothing if the database is not persistent */
 }
 
-void CGPDeviceDb::insertDevice(uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key) {
+bool CGPDeviceDb::insertDevice(uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key) {
 	clogD << "Inserting source ID 0x" << std::hex << std::setw(4) << std::setfill('0') << i_source_id << "\n";
-	if ( !(this->gp_dev_list.insert(std::make_pair(i_source_id, i_key)).second) ) {
-		clogW << "Overwriting source ID 0x" << std::hex << std::setw(4) << std::setfill('0') << i_source_id << "\n";
+	if (i_source_id == EMPTY_SLOT) {
+		clogW << "Source ID 0x00000000 is not a valid GPD ID, ignoring it\n";
+		return false;
+	}
+	if (this->nbSlots > 0) {
+		std::size_t slot = this->findSlot(i_source_id);
+		if (this->sourceIds[slot] == i_source_id) {
+			clogW << "Overwriting source ID 0x" << std::hex << std::setw(4) << std::setfill('0') << i_source_id << "\n";
+			this->storeAt(slot, i_source_id, i_key);
+			this->store.append(CGPDeviceStore::Operation::ADD, i_source_id, i_key);
+			this->compactStoreIfNeeded();
+			return true;
+		}
+	}
+	if (!this->reserveOneMore()) {
+		clogE << "GP device database is full (" << std::dec << this->maxDevices << " devices), cannot add source ID 0x"
+		      << std::hex << std::setw(8) << std::setfill('0') << i_source_id << "\n";
+		return false;
 	}
+	this->storeAt(this->findSlot(i_source_id), i_source_id, i_key);
+	this->nbDevices++;
+	this->store.append(CGPDeviceStore::Operation::ADD, i_source_id, i_key);
+	this->compactStoreIfNeeded();
+	return true;
 }
 
-void CGPDeviceDb::insertDevice(const NSEZSP::CGpDevice& i_gp_device) {
-	this->insertDevice(i_gp_device.getSourceId(), i_gp_device.getKey());
+bool CGPDeviceDb::insertDevice(const NSEZSP::CGpDevice& i_gp_device) {
+	return this->insertDevice(i_gp_device.getSourceId(), i_gp_device.getKey());
 }
 
 bool CGPDeviceDb::removeDevice(const uint32_t i_source_id) {
 	clogD << "Removing source ID 0x" << std::hex << std::setw(4) << std::setfill('0') << i_source_id << "\n";
-	return (this->gp_dev_list.erase(i_source_id) > 0);
+	if (i_source_id == EMPTY_SLOT || this->nbSlots == 0) {
+		return false;
+	}
+	std::size_t hole = this->findSlot(i_source_id);
+	if (this->sourceIds[hole] != i_source_id) {
+		return false;
+	}
+	this->sourceIds[hole] = EMPTY_SLOT;
+	this->nbDevices--;
+	/* Backward shift deletion: move back the following entries of the probe sequence that would not be reachable anymore because of the hole */
+	std::size_t slot = hole;
+	while (true) {
+		if (++slot == this->nbSlots) {
+			slot = 0;
+		}
+		if (this->sourceIds[slot] == EMPTY_SLOT) {
+			break;
+		}
+		std::size_t home = this->homeSlot(this->sourceIds[slot]);
+		/* The entry at slot can fill the hole if its home slot is not (cyclically) within ]hole, slot] */
+		bool homeAfterHole = (hole <= slot) ? (home > hole && home <= slot) : (home > hole || home <= slot);
+		if (!homeAfterHole) {
+			this->moveSlot(slot, hole);
+			hole = slot;
+		}
+	}
+	/* The filter cannot forget a source ID: it is only rebuilt once enough of them are stale, as stale source IDs only cost a useless lookup */
+	if (++this->nbFilterStaleSourceIds > this->nbDevices / 4) {
+		this->rebuildFilter();
+	}
+	this->store.append(CGPDeviceStore::Operation::REMOVE, i_source_id, NSEZSP::EmberKeyData());
+	this->compactStoreIfNeeded();
+	return true;
 }
 
 void CGPDeviceDb::setDb(const std::vector<NSEZSP::CGpDevice>& i_gp_devices_list) {
-	this->gp_dev_list.clear();
-	for(auto it = i_gp_devices_list.begin(); it != i_gp_devices_list.end(); ++it) {
-		this->insertDevice(*it);
+	this->resetTable();
+	std::size_t nbDevices = i_gp_devices_list.size();
+#ifdef USE_STATIC_ALLOCATION
+	if (nbDevices > this->maxDevices) {
+		clogE << "GP device database is full, dropping the last " << std::dec << (nbDevices - this->maxDevices)
+		      << " devices out of " << nbDevices << "\n";
+		nbDevices = this->maxDevices;
+	}
+#else
+	if (CGPDeviceDb::slotsForDevices(nbDevices) > this->nbSlots) {
+		this->rehash(CGPDeviceDb::slotsForDevices(nbDevices));	/* Bulk load: size the table once */
 	}
+#endif
+	for (std::size_t index = 0; index < nbDevices; index++) {
+		uint32_t sourceId = i_gp_devices_list[index].getSourceId();
+		if (sourceId == EMPTY_SLOT) {
+			clogW << "Source ID 0x00000000 is not a valid GPD ID, ignoring it\n";
+			continue;
+		}
+		std::size_t slot = this->findSlot(sourceId);
+		if (this->sourceIds[slot] == EMPTY_SLOT) {
+			this->nbDevices++;
+		}
+		this->storeAt(slot, sourceId, i_gp_devices_list[index].getKey());	/* If the same source ID appears more than once, the last occurrence wins */
+	}
+	clogD << "GP device database now contains " << std::dec << this->nbDevices << " devices\n";
+	this->saveStore();	/* Does nothing if the database is not persistent */
+}
+
+CGPDeviceDb::Lookup CGPDeviceDb::lookup(uint32_t i_source_id) const {
+	Lookup result;
+	if (i_source_id == EMPTY_SLOT || this->nbSlots == 0) {
+		return result;
+	}
+	std::size_t slot = this->findSlot(i_source_id);
+	if (this->sourceIds[slot] == i_source_id) {
+		result.key = &this->keys[slot];
+		result.expandedKey = &this->expandedKeys[slot];
+		result.nextFrameCounter = this->frameCounters[slot];
+	}
+	return result;
+}
+
+bool CGPDeviceDb::setFrameCounter(uint32_t i_source_id, uint32_t i_frame_counter) {
+	if (i_source_id == EMPTY_SLOT || this->nbSlots == 0) {
+		return false;
+	}
+	std::size_t slot = this->findSlot(i_source_id);
+	if (this->sourceIds[slot] != i_source_id) {
+		return false;
+	}
+	this->recordFrameCounter(slot, i_frame_counter);
+	return true;
+}
+
+void CGPDeviceDb::recordFrameCounter(std::size_t slot, uint32_t i_frame_counter) {
+	if (this->store.isOpen()) {
+		if (this->dirtyFrameCounters.size() >= FRAME_COUNTER_FLUSH_BATCH) {
+			this->flushFrameCounters(true);	/* Keeps the table layout, slot remains valid */
+		}
+		this->dirtyFrameCounters.push_back(this->sourceIds[slot]);
+	}
+	this->frameCounters[slot] = (i_frame_counter == EXHAUSTED_FRAME_COUNTER) ? EXHAUSTED_FRAME_COUNTER : i_frame_counter + 1;
+}
+
+CGPDeviceDb::FrameCounterCheck CGPDeviceDb::checkFrameCounter(uint32_t i_next_frame_counter, uint32_t i_frame_counter) {
+	if (i_next_frame_counter == EXHAUSTED_FRAME_COUNTER) {
+		return FrameCounterCheck::REPLAY;
+	}
+	if (i_frame_counter >= i_next_frame_counter) {
+		return FrameCounterCheck::FRESH;
+	}
+	return (i_frame_counter + 1 == i_next_frame_counter) ? FrameCounterCheck::DUPLICATE : FrameCounterCheck::REPLAY;
+}
+
+CGPDeviceDb::FrameCounterCheck CGPDeviceDb::acceptFrameCounter(uint32_t i_source_id, uint32_t i_frame_counter) {
+	if (i_source_id == EMPTY_SLOT || this->nbSlots == 0) {
+		return FrameCounterCheck::UNKNOWN_DEVICE;
+	}
+	std::size_t slot = this->findSlot(i_source_id);
+	if (this->sourceIds[slot] != i_source_id) {
+		return FrameCounterCheck::UNKNOWN_DEVICE;
+	}
+	FrameCounterCheck check = CGPDeviceDb::checkFrameCounter(this->frameCounters[slot], i_frame_counter);
+	if (check == FrameCounterCheck::FRESH) {
+		this->recordFrameCounter(slot, i_frame_counter);
+	}
+	return check;
+}
+
+bool CGPDeviceDb::flushFrameCounters(bool i_force) {
+	if (this->dirtyFrameCounters.empty() || !this->store.isOpen()) {
+		return true;
+	}
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (!i_force && now - this->lastFrameCounterFlush < FRAME_COUNTER_FLUSH_INTERVAL) {
+		return false;
+	}
+	/* A device may have received several frames since the last flush, only write its latest frame counter once */
+	std::sort(this->dirtyFrameCounters.begin(), this->dirtyFrameCounters.end());
+	this->dirtyFrameCounters.erase(std::unique(this->dirtyFrameCounters.begin(), this->dirtyFrameCounters.end()), this->dirtyFrameCounters.end());
+	this->flushedFrameCounters.clear();
+	std::size_t nbDevices = 0;
+	for (uint32_t sourceId : this->dirtyFrameCounters) {
+		Lookup device = this->lookup(sourceId);
+		if (device.found()) {	/* The device may have been removed since */
+			this->dirtyFrameCounters[nbDevices++] = sourceId;
+			this->flushedFrameCounters.push_back(device.nextFrameCounter);
+		}
+	}
+	this->dirtyFrameCounters.resize(nbDevices);
+	if (!this->store.appendFrameCounters(this->dirtyFrameCounters.data(), this->flushedFrameCounters.data(), nbDevices)) {
+		return false;	/* Will be retried at next flush (the list has been deduplicated, so it cannot overflow) */
+	}
+	clogD << "Persisted frame counters of " << std::dec << nbDevices << " GP devices\n";
+	this->dirtyFrameCounters.clear();
+	this->lastFrameCounterFlush = now;
+	this->compactStoreIfNeeded();
+	return true;
 }
 
 bool CGPDeviceDb::getKeyForSourceId(uint32_t i_source_id, NSEZSP::EmberKeyData& o_key) const {
 	clogD << "Searching source ID 0x" << std::hex << std::setw(4) << std::setfill('0') << i_source_id << "\n";
-	auto search = this->gp_dev_list.find(i_source_id);
-	if (search != this->gp_dev_list.end()) {
-		o_key = search->second;
+	Lookup device = this->lookup(i_source_id);
+	if (device.found()) {
+		o_key = *device.key;
 		clogD << "... found\n";
 		return true;
 	}
@@ -56,6 +458,42 @@ bool CGPDeviceDb::getKeyForSourceId(uint32_t i_source_id, NSEZSP::EmberKeyData&
 	}
 }
 
+const NSSPI::IAes::ExpandedKey* CGPDeviceDb::getExpandedKeyForSourceId(uint32_t i_source_id) const {
+	return this->lookup(i_source_id).expandedKey;
+}
+
 bool CGPDeviceDb::isSourceIdInDb(uint32_t i_source_id) const {
-	return (this->gp_dev_list.find(i_source_id) != this->gp_dev_list.end());
-}
\ No newline at end of file
+	return this->lookup(i_source_id).found();
+}
+
+bool CGPDeviceDb::mayContain(uint32_t i_source_id) const {
+	return this->filter.mayContain(i_source_id);
+}
+
+void CGPDeviceDb::getSourceIds(std::vector<uint32_t>& o_source_ids) const {
+	for (std::size_t slot = 0; slot < this->nbSlots; slot++) {
+		if (this->sourceIds[slot] != EMPTY_SLOT) {
+			o_source_ids.push_back(this->sourceIds[slot]);
+		}
+	}
+}
+
+std::size_t CGPDeviceDb::size() const {
+	return this->nbDevices;
+}
+
+std::size_t CGPDeviceDb::capacity() const {
+#ifdef USE_STATIC_ALLOCATION
+	return this->maxDevices;
+#else
+	return (this->nbSlots == 0) ? 0 : (this->nbSlots - 1) * 4 / 5;	/* Devices that fit without growing the table (see slotsForDevices()) */
+#endif
+}
+
+std::size_t CGPDeviceDb::memoryFootprint() const {
+	return this->ownedSourceIds.capacity() * sizeof(uint32_t)
+	       + this->ownedKeys.capacity() * sizeof(NSEZSP::EmberKeyData)
+	       + this->ownedFrameCounters.capacity() * sizeof(uint32_t)
+	       + this->ownedExpandedKeys.capacity() * sizeof(NSSPI::IAes::ExpandedKey)
+	       + this->filter.memoryFootprint();
+}
@@ -6,15 +6,117 @@
 
 #pragma once
 
-#include <map>
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <chrono>
 
 #include "ezsp/zbmessage/green-power-device.h"
+#include "spi/IAes.h"
+#include "green-power-device-store.h"
+#include "green-power-source-id-filter.h"
 
 namespace NSEZSP {
 
+/**
+ * @brief Green Power device keys, stored in a flat open-addressing hash table keyed by source ID
+ *
+ * The table uses linear probing over a structure-of-arrays layout: probing only reads the (compact) source ID array, the key,
+ * frame counter and key schedule of a device being stored at the same slot index in their own arrays.
+ * The AES key schedule of each key is computed once when the device is added, so that validating the MIC of incoming frames
+ * does not need to re-run the key expansion (see lookup()).
+ * Source ID 0x00000000 (unspecified GPD ID) marks empty slots, it cannot be stored in the database.
+ * In static allocation builds (USE_STATIC_ALLOCATION), the capacity given at construction is a hard limit and the database never allocates afterwards.
+ * Otherwise, the table grows when it gets full.
+ *
+ * The database can be made persistent using openStore(): the keys are then loaded from a snapshot file (key schedules are re-computed
+ * while loading, they are not stored), and each subsequent modification is logged to disk (see CGPDeviceStore).
+ *
+ * The database also tracks the security frame counter of each device, so that duplicate and replayed frames can be rejected (see acceptFrameCounter()).
+ * Frame counters change with every received frame, so they are persisted in batches (write-behind, see flushFrameCounters()) rather than one by one.
+ */
 class CGPDeviceDb {
 public:
-	CGPDeviceDb();
+	/**
+	 * @brief Everything known about one device, as returned by lookup()
+	 *
+	 * @warning Pointers are invalidated by any subsequent modification of the database
+	 */
+	struct Lookup {
+		Lookup() : key(nullptr), expandedKey(nullptr), nextFrameCounter(0) { }
+
+		/**
+		 * @brief Was the source ID found in the database?
+		 *
+		 * @return true if the source ID is in the database (and thus if the other fields are set)
+		 */
+		bool found() const {
+			return key != nullptr;
+		}
+
+		const NSEZSP::EmberKeyData* key;	/*!< The key of the device, nullptr if the source ID is not in the database */
+		const NSSPI::IAes::ExpandedKey* expandedKey;	/*!< The pre-computed AES key schedule of key */
+		uint32_t nextFrameCounter;	/*!< The lowest security frame counter that will be accepted from this device (see acceptFrameCounter()) */
+	};
+
+	/**
+	 * @brief Freshness of a security frame counter received from a device
+	 */
+	enum class FrameCounterCheck {
+		FRESH,	/*!< The frame counter is higher than any frame counter accepted before for this device */
+		DUPLICATE,	/*!< The frame counter is the last one accepted for this device (a retransmission of the same frame) */
+		REPLAY,	/*!< The frame counter is lower than the last one accepted for this device */
+		UNKNOWN_DEVICE,	/*!< The source ID is not in the database */
+	};
+
+	static constexpr std::size_t FRAME_COUNTER_FLUSH_BATCH = 256;	/*!< Number of devices whose frame counter changed that triggers an immediate flushFrameCounters() */
+	static constexpr std::chrono::seconds FRAME_COUNTER_FLUSH_INTERVAL{5};	/*!< Maximum time during which frame counter changes remain in memory only */
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param maxDevices The number of devices to reserve storage for (in static allocation builds, the maximum number of devices)
+	 */
+	explicit CGPDeviceDb(std::size_t maxDevices = 0);
+
+	/**
+	 * @brief Destructor, persisting frame counters not yet flushed to the store
+	 */
+	~CGPDeviceDb();
+
+	CGPDeviceDb(const CGPDeviceDb&) = delete;	/* No copy (owns the files of its store) */
+	CGPDeviceDb& operator=(const CGPDeviceDb&) = delete;
+
+	/**
+	 * @brief Make the database persistent, loading its content from a store
+	 *
+	 * The devices of the snapshot of the store are loaded (computing their key schedules), then modifications logged since that snapshot are
+	 * replayed. From then on, every modification of the database is written to the store before the modifying method returns.
+	 * If the store does not exist yet, it is created with the current content of the database.
+	 *
+	 * @note Any previous content of the database is replaced by the content of the store
+	 * @note In static allocation builds, a store containing more devices than the capacity given at construction is refused
+	 *
+	 * @param[in] i_path The path of the snapshot file of the store (the delta log is written next to it, with a ".log" suffix)
+	 *
+	 * @return true if the store is now open, false if it is invalid or could not be accessed (the database is then left unchanged and not persistent),
+	 *         or if the library has been built without USE_GP_DEVICE_STORE
+	 */
+	bool openStore(const std::string& i_path);
+
+	/**
+	 * @brief Write a new snapshot of the whole database to the store, and reset its delta log
+	 *
+	 * This is done automatically by openStore(), setDb(), clear() and when the delta log gets long, there is no need to invoke it otherwise.
+	 *
+	 * @return true on success, false if the store is not open or the snapshot could not be written (modifications remain in the delta log)
+	 */
+	bool saveStore();
+
+	/**
+	 * @brief Stop persisting the database (its current content is kept in memory)
+	 */
+	void closeStore();
 
 	/**
 	 * @brief Clear all entries in the database
@@ -28,8 +130,10 @@ public:
 	 *
 	 * @param[in] i_source_id The source ID of the new device to add
 	 * @param[in] i_key The key of the new device to add
+	 *
+	 * @return true if the device is now in the database, false if it could not be added because the database is full (or @p i_source_id is 0)
 	 */
-	void insertDevice(uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key);
+	bool insertDevice(uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key);
 
 	/**
 	 * @brief Add/overwrite a device entry in the database
@@ -37,8 +141,10 @@ public:
 	 * @note If an element with the same source ID already exist, it will be overwritten
 	 *
 	 * @param[in] i_gp_device A CGpDevice object containing the source ID and the key of the new device to add
+	 *
+	 * @return true if the device is now in the database, false if it could not be added because the database is full
 	 */
-	void insertDevice(const NSEZSP::CGpDevice& i_gp_device);
+	bool insertDevice(const NSEZSP::CGpDevice& i_gp_device);
 
 	/**
 	 * @brief Remove a device entry in the database
@@ -53,6 +159,8 @@ public:
 	 * @brief Set the database with the exact content provided as specific device list
 	 *
 	 * @note The database will contain exactly this device list, any previous content will be destroyed
+	 * @note If the same source ID appears more than once in @p i_gp_devices_list, the last occurrence is kept
+	 * @note In static allocation builds, devices in excess of the capacity are dropped (an error is logged)
 	 *
 	 * @param[in] i_gp_devices_list A vector of CGpDevice objects containing the source ID and the key of all devices to store in the database
 	 */
@@ -68,6 +176,74 @@ public:
 	 */
 	bool getKeyForSourceId(uint32_t i_source_id, NSEZSP::EmberKeyData& o_key) const;
 
+	/**
+	 * @brief Retrieve all data about a specific source ID, in one probe of the table
+	 *
+	 * @param[in] i_source_id The source ID we are searching
+	 *
+	 * @return The device data (see Lookup::found() to check whether the source ID was found)
+	 */
+	Lookup lookup(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Record the last security frame counter of a device (eg: the one sent in its commissioning frame)
+	 *
+	 * @param[in] i_source_id The source ID of the device
+	 * @param[in] i_frame_counter The frame counter to record, only higher frame counters will be accepted from now on
+	 *
+	 * @return true if the source ID is in the database (and the frame counter has been recorded)
+	 */
+	bool setFrameCounter(uint32_t i_source_id, uint32_t i_frame_counter);
+
+	/**
+	 * @brief Check the freshness of a frame counter against the value returned by lookup(), without modifying the database
+	 *
+	 * @param i_next_frame_counter The Lookup::nextFrameCounter field of the device
+	 * @param i_frame_counter The security frame counter of the received frame
+	 *
+	 * @return FRESH, DUPLICATE or REPLAY
+	 */
+	static FrameCounterCheck checkFrameCounter(uint32_t i_next_frame_counter, uint32_t i_frame_counter);
+
+	/**
+	 * @brief Accept a frame counter received from a device if it is fresh, recording it as the last one accepted
+	 *
+	 * This must only be invoked once the frame has been authenticated, so that forged frames cannot move the frame counter forward.
+	 * Accepted frame counters are persisted later on (see flushFrameCounters()).
+	 *
+	 * @note A device that reaches frame counter 0xffffffff will not have any further frame accepted (it must be re-commissioned with a new key)
+	 *
+	 * @param i_source_id The source ID of the device
+	 * @param i_frame_counter The security frame counter of the received frame
+	 *
+	 * @return FRESH if the frame counter has been accepted, the reason why it was not otherwise
+	 */
+	FrameCounterCheck acceptFrameCounter(uint32_t i_source_id, uint32_t i_frame_counter);
+
+	/**
+	 * @brief Persist frame counters accepted since the last flush to the store, in one synced write
+	 *
+	 * Without @p i_force, this only happens if FRAME_COUNTER_FLUSH_INTERVAL has elapsed since the last flush, so this method can be invoked
+	 * often (eg: after each burst of received frames). If the process stops abruptly, frame counters accepted during the last
+	 * FRAME_COUNTER_FLUSH_INTERVAL are lost: frames sent during this interval would then be accepted again if they were replayed.
+	 *
+	 * @param i_force Flush even if FRAME_COUNTER_FLUSH_INTERVAL has not elapsed
+	 *
+	 * @return true if there is nothing left to flush (or if the database is not persistent)
+	 */
+	bool flushFrameCounters(bool i_force = false);
+
+	/**
+	 * @brief Retrieve the pre-computed AES key schedule of the key for a specific source ID
+	 *
+	 * @param[in] i_source_id The source ID we are searching
+	 *
+	 * @return A pointer to the key schedule, or nullptr if the source ID could not be found in the database
+	 *
+	 * @warning The returned pointer is invalidated by any subsequent modification of the database
+	 */
+	const NSSPI::IAes::ExpandedKey* getExpandedKeyForSourceId(uint32_t i_source_id) const;
+
 	/**
 	 * @brief Check if the provided source ID is in the database
 	 *
@@ -77,8 +253,165 @@ public:
 	 */
 	bool isSourceIdInDb(uint32_t i_source_id) const;
 
+	/**
+	 * @brief Quickly check whether a source ID may be in the database, without probing the table
+	 *
+	 * This only reads one half cache line of a Bloom filter of the source IDs in the database (see CGpSourceIdFilter), and is meant to
+	 * discard frames from foreign devices before doing anything else with them.
+	 *
+	 * @param i_source_id The source ID we are searching
+	 *
+	 * @return false if the source ID is definitely not in the database, true if it probably is (use lookup() to be sure)
+	 */
+	bool mayContain(uint32_t i_source_id) const;
+
+	/**
+	 * @brief List the source IDs of all devices in the database
+	 *
+	 * @param[out] o_source_ids The source IDs are appended to this vector (in no particular order)
+	 */
+	void getSourceIds(std::vector<uint32_t>& o_source_ids) const;
+
+	/**
+	 * @brief Get the number of devices in the database
+	 *
+	 * @return The number of devices
+	 */
+	std::size_t size() const;
+
+	/**
+	 * @brief Get the maximum number of devices that can be stored without allocating
+	 *
+	 * @return The capacity
+	 */
+	std::size_t capacity() const;
+
+	/**
+	 * @brief Get the memory used by the table storage
+	 *
+	 * @return The number of bytes allocated on the heap for all slots (used or not) and for the source ID filter
+	 */
+	std::size_t memoryFootprint() const;
+
 private:
-	std::map<uint32_t, NSEZSP::EmberKeyData> gp_dev_list;   /*!< The green power device list stored in this class */
+	static constexpr uint32_t EMPTY_SLOT = 0;	/*!< Source ID marking an unused slot */
+
+	/**
+	 * @brief Compute the number of slots needed to store a number of devices without exceeding the maximum load factor
+	 *
+	 * @param nbDevices The number of devices
+	 *
+	 * @return The number of slots
+	 */
+	static std::size_t slotsForDevices(std::size_t nbDevices);
+
+	/**
+	 * @brief Get the first slot to probe for a source ID
+	 *
+	 * @param i_source_id The source ID
+	 *
+	 * @return The index of the home slot of @p i_source_id
+	 */
+	std::size_t homeSlot(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Find the slot of a source ID
+	 *
+	 * @param i_source_id The source ID we are searching
+	 *
+	 * @return The index of the slot holding @p i_source_id if it exists, or of the empty slot where it should be inserted otherwise
+	 *
+	 * @note The table must contain at least one slot
+	 */
+	std::size_t findSlot(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Store a device in a slot, computing its key schedule
+	 */
+	void storeAt(std::size_t slot, uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key);
+
+	/**
+	 * @brief Move a used slot to another (empty) slot
+	 */
+	void moveSlot(std::size_t from, std::size_t to);
+
+	/**
+	 * @brief Resize the table, re-inserting all devices
+	 *
+	 * @param nbSlots The new number of slots
+	 */
+	void rehash(std::size_t nbSlots);
+
+	/**
+	 * @brief Record the last frame counter accepted for the device stored in a slot, and remember to persist it
+	 *
+	 * @param slot The slot of the device
+	 * @param i_frame_counter The frame counter
+	 */
+	void recordFrameCounter(std::size_t slot, uint32_t i_frame_counter);
+
+	/**
+	 * @brief Point the table to the owned* vectors
+	 */
+	void useOwnedTable();
+
+	/**
+	 * @brief Get the current table, as saved by the store
+	 *
+	 * @return The slot arrays currently in use
+	 */
+	CGPDeviceStore::Table currentTable() const;
+
+	/**
+	 * @brief Empty the table (keeping its storage)
+	 */
+	void resetTable();
+
+	/**
+	 * @brief Store a device read from the snapshot of the store
+	 *
+	 * @param i_source_id The source ID of the device
+	 * @param i_key The key of the device
+	 * @param i_frame_counter The lowest frame counter still acceptable from the device
+	 */
+	void loadDevice(uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key, uint32_t i_frame_counter);
+
+	/**
+	 * @brief Write a snapshot to the store if the delta log has become long compared to the size of the database
+	 */
+	void compactStoreIfNeeded();
+
+	/**
+	 * @brief Make sure one more device can be stored
+	 *
+	 * @return false if the table is full and cannot grow (static allocation builds)
+	 */
+	bool reserveOneMore();
+
+	/**
+	 * @brief Re-create the source ID filter from the content of the table
+	 *
+	 * The filter is sized for the capacity of the table, so in static allocation builds, this never allocates.
+	 */
+	void rebuildFilter();
+
+	std::size_t maxDevices;	/*!< The capacity reserved at construction */
+	std::size_t nbDevices;	/*!< The number of used slots */
+	std::size_t nbSlots;	/*!< The number of slots in the table */
+	uint32_t* sourceIds;	/*!< The source ID stored in each slot (EMPTY_SLOT if unused) */
+	NSEZSP::EmberKeyData* keys;	/*!< The key of the device stored in each slot */
+	uint32_t* frameCounters;	/*!< The last frame counter recorded for the device stored in each slot */
+	NSSPI::IAes::ExpandedKey* expandedKeys;	/*!< The key schedule of the key stored in each slot */
+	std::vector<uint32_t> ownedSourceIds;	/*!< Heap storage for sourceIds */
+	std::vector<NSEZSP::EmberKeyData> ownedKeys;	/*!< Heap storage for keys */
+	std::vector<uint32_t> ownedFrameCounters;	/*!< Heap storage for frameCounters */
+	std::vector<NSSPI::IAes::ExpandedKey> ownedExpandedKeys;	/*!< Heap storage for expandedKeys */
+	CGPDeviceStore store;	/*!< The files persisting the database, if openStore() has been invoked */
+	std::vector<uint32_t> dirtyFrameCounters;	/*!< Source IDs whose frame counter changed since the last flushFrameCounters() (capacity FRAME_COUNTER_FLUSH_BATCH, reserved by openStore()) */
+	std::vector<uint32_t> flushedFrameCounters;	/*!< Storage for the frame counters written by flushFrameCounters() (same capacity) */
+	std::chrono::steady_clock::time_point lastFrameCounterFlush;	/*!< When flushFrameCounters() last wrote to the store */
+	CGpSourceIdFilter filter;	/*!< Bloom filter of all source IDs in the table (see mayContain()) */
+	std::size_t nbFilterStaleSourceIds;	/*!< Number of source IDs removed from the table since the filter was last rebuilt, that the filter still contains */
 };
 
 } // namespace NSEZSP
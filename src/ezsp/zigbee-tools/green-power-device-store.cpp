@@ -0,0 +1,657 @@
+/**
+ * @file green-power-device-store.cpp
+ *
+ * @brief Persistent storage of the green power device database (snapshot + append-only delta log)
+ */
+
+#include <algorithm>	// For std::min()
+
+#include "spi/ILogger.h"
+#include "green-power-device-store.h"
+
+using NSEZSP::CGPDeviceStore;
+
+namespace {
+
+/**
+ * @brief Incremental Fletcher-64 over 32-bit words
+ */
+class Fletcher64 {
+public:
+	Fletcher64() : sum1(0), sum2(0), pending(0) { }
+
+	void update(const void* data, std::size_t size) {
+		const uint32_t* words = static_cast<const uint32_t*>(data);
+		std::size_t nbWords = size / sizeof(uint32_t);
+		while (nbWords > 0) {
+			/* Both sums fit in 64 bits for up to BLOCK_WORDS words, the modulo is only needed once per block */
+			std::size_t blockWords = std::min(nbWords, BLOCK_WORDS - this->pending);
+			for (std::size_t i = 0; i < blockWords; i++) {
+				this->sum1 += words[i];
+				this->sum2 += this->sum1;
+			}
+			words += blockWords;
+			nbWords -= blockWords;
+			this->pending += blockWords;
+			if (this->pending == BLOCK_WORDS) {
+				this->reduce();
+			}
+		}
+	}
+
+	uint64_t value() {
+		this->reduce();
+		return (this->sum2 << 32) | this->sum1;
+	}
+
+private:
+	static constexpr std::size_t BLOCK_WORDS = 65536;
+	static constexpr uint64_t MODULUS = 0xffffffffU;
+
+	void reduce() {
+		this->sum1 %= MODULUS;
+		this->sum2 %= MODULUS;
+		this->pending = 0;
+	}
+
+	uint64_t sum1;
+	uint64_t sum2;
+	std::size_t pending;
+};
+
+} // namespace
+
+uint64_t CGPDeviceStore::checksum(const void* data, std::size_t size) {
+	Fletcher64 sum;
+	sum.update(data, size);
+	return sum.value();
+}
+
+#ifdef USE_GP_DEVICE_STORE
+#include <cstring>
+#include <cstddef>	// For offsetof()
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+namespace {
+
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;	/* Reads differently on a host with another endianness */
+constexpr uint32_t SNAPSHOT_VERSION = 2;	/* Must be increased on any change of the layout below (version 1 also stored the hash table layout and key schedules) */
+constexpr uint32_t LOG_VERSION = 1;
+constexpr char SNAPSHOT_MAGIC[8] = { 'E', 'Z', 'S', 'P', 'G', 'P', 'D', 'B' };
+constexpr char LOG_MAGIC[8] = { 'E', 'Z', 'S', 'P', 'G', 'P', 'D', 'L' };
+
+/**
+ * @brief Header of a snapshot file, followed by one SnapshotRecord per device
+ */
+struct SnapshotHeader {
+	char magic[8];
+	uint32_t byteOrder;
+	uint32_t version;
+	uint32_t generation;
+	uint32_t reserved0;
+	uint64_t reserved1;
+	uint64_t nbDevices;
+	uint64_t payloadChecksum;	/* Checksum of all records following the header */
+	uint32_t reserved2[3];
+	uint32_t headerChecksum;	/* Checksum of all previous fields */
+};
+static_assert(sizeof(SnapshotHeader) == 64, "Snapshot header must be 64 bytes");
+
+/**
+ * @brief A device stored in a snapshot
+ */
+struct SnapshotRecord {
+	uint32_t sourceId;
+	uint32_t frameCounter;
+	uint8_t key[NSEZSP::EMBER_KEY_DATA_BYTE_SIZE];
+};
+static_assert(sizeof(SnapshotRecord) == 24, "Snapshot records must be 24 bytes");
+
+/**
+ * @brief Header of a delta log file, followed by LogRecords
+ */
+struct LogHeader {
+	char magic[8];
+	uint32_t byteOrder;
+	uint32_t version;
+	uint32_t generation;	/* The generation of the snapshot this log applies to */
+	uint32_t reserved[2];
+	uint32_t headerChecksum;
+};
+static_assert(sizeof(LogHeader) == 32, "Log header must be 32 bytes");
+
+/**
+ * @brief A modification recorded in the delta log
+ */
+struct LogRecord {
+	uint32_t operation;
+	uint32_t sourceId;
+	uint8_t key[NSEZSP::EMBER_KEY_DATA_BYTE_SIZE];	/* Only for Operation::ADD */
+	uint32_t frameCounter;	/* Only for Operation::FRAME_COUNTER */
+	uint32_t recordChecksum;
+};
+static_assert(sizeof(LogRecord) == 32, "Log records must be 32 bytes");
+
+constexpr std::size_t SNAPSHOT_BUFFER_RECORDS = 256;	/* Number of snapshot records read or written at once */
+constexpr std::size_t REPLAY_BUFFER_RECORDS = 256;	/* Number of log records read at once during replay */
+constexpr std::size_t APPEND_BUFFER_RECORDS = 64;	/* Number of log records written at once by appendFrameCounters() */
+
+uint32_t foldedChecksum(const void* data, std::size_t size) {
+	uint64_t sum = CGPDeviceStore::checksum(data, size);
+	return static_cast<uint32_t>(sum ^ (sum >> 32));
+}
+
+bool isValidRecord(const LogRecord& record) {
+	return record.recordChecksum == foldedChecksum(&record, offsetof(LogRecord, recordChecksum))
+	       && (record.operation == static_cast<uint32_t>(CGPDeviceStore::Operation::ADD)
+	           || record.operation == static_cast<uint32_t>(CGPDeviceStore::Operation::REMOVE)
+	           || record.operation == static_cast<uint32_t>(CGPDeviceStore::Operation::FRAME_COUNTER));
+}
+
+/**
+ * @brief Write a whole buffer to a file descriptor, retrying on partial writes and interrupted calls
+ */
+bool writeAll(int fd, const void* data, std::size_t size) {
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	while (size > 0) {
+		ssize_t written = ::write(fd, bytes, size);
+		if (written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return false;
+		}
+		bytes += written;
+		size -= static_cast<std::size_t>(written);
+	}
+	return true;
+}
+
+/**
+ * @brief Read up to size bytes (less only at end of file), retrying on partial reads and interrupted calls
+ *
+ * @return The number of bytes read, or -1 on error
+ */
+ssize_t readAll(int fd, void* data, std::size_t size) {
+	uint8_t* bytes = static_cast<uint8_t*>(data);
+	std::size_t total = 0;
+	while (total < size) {
+		ssize_t nbRead = ::read(fd, bytes + total, size - total);
+		if (nbRead < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -1;
+		}
+		if (nbRead == 0) {
+			break;
+		}
+		total += static_cast<std::size_t>(nbRead);
+	}
+	return static_cast<ssize_t>(total);
+}
+
+/**
+ * @brief Sync the directory containing a file, so that a rename() of that file is durable
+ */
+bool syncParentDirectory(const std::string& path) {
+	std::string::size_type separator = path.rfind('/');
+	std::string directory = (separator == std::string::npos) ? "." : ((separator == 0) ? "/" : path.substr(0, separator));
+	int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+	if (fd < 0) {
+		return false;
+	}
+	bool success = (::fsync(fd) == 0);
+	::close(fd);
+	return success;
+}
+
+/**
+ * @brief Write a file through a temporary file, then atomically rename it over path
+ *
+ * @param path The final path of the file
+ * @param writer A callback writing the content of the file to the file descriptor it receives
+ */
+bool writeFileAtomically(const std::string& path, const std::function<bool (int fd)>& writer) {
+	std::string tmpPath = path + ".tmp";
+	int fd = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+	if (fd < 0) {
+		clogE << "Cannot create " << tmpPath << ": " << std::strerror(errno) << "\n";
+		return false;
+	}
+	bool success = writer(fd) && (::fsync(fd) == 0);
+	if (::close(fd) != 0) {
+		success = false;
+	}
+	if (!success) {
+		clogE << "Cannot write " << tmpPath << ": " << std::strerror(errno) << "\n";
+		::unlink(tmpPath.c_str());
+		return false;
+	}
+	if (::rename(tmpPath.c_str(), path.c_str()) != 0) {
+		clogE << "Cannot rename " << tmpPath << " to " << path << ": " << std::strerror(errno) << "\n";
+		::unlink(tmpPath.c_str());
+		return false;
+	}
+	if (!syncParentDirectory(path)) {
+		clogW << "Cannot sync the directory of " << path << ": " << std::strerror(errno) << "\n";
+	}
+	return true;
+}
+
+} // namespace
+
+CGPDeviceStore::CGPDeviceStore() :
+	path(),
+	generation(0),
+	snapshotFd(-1),
+	nbSnapshotDevices(0),
+	logFd(-1),
+	nbLogRecords(0),
+	replaying(false) {
+}
+
+CGPDeviceStore::~CGPDeviceStore() {
+	this->close();
+}
+
+bool CGPDeviceStore::openSnapshot() {
+	this->generation = 0;
+	this->nbSnapshotDevices = 0;
+	int fd = ::open(this->path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (fd < 0) {
+		if (errno == ENOENT) {
+			return true;	/* New store */
+		}
+		clogE << "Cannot open GP device store " << this->path << ": " << std::strerror(errno) << "\n";
+		return false;
+	}
+	struct stat fileStat;
+	SnapshotHeader header;
+	if (::fstat(fd, &fileStat) != 0 || readAll(fd, &header, sizeof(header)) != static_cast<ssize_t>(sizeof(header))) {
+		clogE << "GP device store " << this->path << " is truncated\n";
+		::close(fd);
+		return false;
+	}
+	std::size_t fileSize = static_cast<std::size_t>(fileStat.st_size);
+	const char* error = nullptr;
+	if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0) {
+		error = "is not a GP device store";
+	}
+	else if (header.byteOrder != BYTE_ORDER_MARK) {
+		error = "has been written by a host with a different byte order";
+	}
+	else if (header.version != SNAPSHOT_VERSION) {
+		error = "has an unsupported version";
+	}
+	else if (header.headerChecksum != foldedChecksum(&header, offsetof(SnapshotHeader, headerChecksum))) {
+		error = "has a corrupted header";
+	}
+	else if (header.nbDevices > (fileSize - sizeof(SnapshotHeader)) / sizeof(SnapshotRecord)
+	         || fileSize != sizeof(SnapshotHeader) + header.nbDevices * sizeof(SnapshotRecord)) {
+		error = "is truncated";
+	}
+	else {
+		/* Check the whole file before anything is loaded, so that the database is left unchanged if the snapshot is corrupted */
+		Fletcher64 payloadChecksum;
+		SnapshotRecord records[SNAPSHOT_BUFFER_RECORDS];
+		std::size_t remaining = static_cast<std::size_t>(header.nbDevices);
+		while (remaining > 0 && error == nullptr) {
+			std::size_t nbRecords = std::min(remaining, SNAPSHOT_BUFFER_RECORDS);
+			if (readAll(fd, records, nbRecords * sizeof(SnapshotRecord)) != static_cast<ssize_t>(nbRecords * sizeof(SnapshotRecord))) {
+				error = "cannot be read";
+			}
+			payloadChecksum.update(records, nbRecords * sizeof(SnapshotRecord));
+			remaining -= nbRecords;
+		}
+		if (error == nullptr && header.payloadChecksum != payloadChecksum.value()) {
+			error = "is corrupted";
+		}
+	}
+	if (error != nullptr) {
+		clogE << "GP device store " << this->path << " " << error << "\n";
+		::close(fd);
+		return false;
+	}
+	this->snapshotFd = fd;	/* Kept open for load(): the snapshot can only be replaced by a rename, that does not affect this file descriptor */
+	this->generation = header.generation;
+	this->nbSnapshotDevices = static_cast<std::size_t>(header.nbDevices);
+	return true;
+}
+
+bool CGPDeviceStore::open(const std::string& i_path, std::size_t& o_nb_devices) {
+	this->close();
+	this->path = i_path;
+	if (!this->openSnapshot()) {
+		this->path.clear();
+		return false;
+	}
+	o_nb_devices = this->nbSnapshotDevices;
+	clogD << "GP device store " << this->path << " generation " << std::dec << this->generation << " opened with "
+	      << o_nb_devices << " devices\n";
+	return true;
+}
+
+bool CGPDeviceStore::load(FLoadCallback i_load) {
+	if (this->snapshotFd < 0) {
+		return this->isOpen();	/* New store, nothing to load */
+	}
+	bool success = (::lseek(this->snapshotFd, static_cast<off_t>(sizeof(SnapshotHeader)), SEEK_SET) >= 0);
+	SnapshotRecord records[SNAPSHOT_BUFFER_RECORDS];
+	std::size_t remaining = this->nbSnapshotDevices;
+	while (success && remaining > 0) {
+		std::size_t nbRecords = std::min(remaining, SNAPSHOT_BUFFER_RECORDS);
+		if (readAll(this->snapshotFd, records, nbRecords * sizeof(SnapshotRecord)) != static_cast<ssize_t>(nbRecords * sizeof(SnapshotRecord))) {
+			success = false;
+			break;
+		}
+		for (std::size_t i = 0; i < nbRecords; i++) {
+			NSEZSP::EmberKeyData key;
+			std::copy(records[i].key, records[i].key + sizeof(records[i].key), key.begin());
+			i_load(records[i].sourceId, key, records[i].frameCounter);
+		}
+		remaining -= nbRecords;
+	}
+	if (!success) {
+		clogE << "Cannot read GP device store " << this->path << ": " << std::strerror(errno) << "\n";
+	}
+	::close(this->snapshotFd);
+	this->snapshotFd = -1;
+	return success;
+}
+
+bool CGPDeviceStore::resetLog() {
+	if (this->logFd >= 0) {
+		::close(this->logFd);
+		this->logFd = -1;
+	}
+	this->nbLogRecords = 0;
+	std::string logPath = this->path + ".log";
+	LogHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.version = LOG_VERSION;
+	header.generation = this->generation;
+	header.headerChecksum = foldedChecksum(&header, offsetof(LogHeader, headerChecksum));
+	bool written = writeFileAtomically(logPath, [&header](int fd) {
+		return writeAll(fd, &header, sizeof(header));
+	});
+	if (!written) {
+		return false;
+	}
+	this->logFd = ::open(logPath.c_str(), O_RDWR | O_APPEND | O_CLOEXEC);
+	return (this->logFd >= 0);
+}
+
+bool CGPDeviceStore::replayLog(FReplayCallback i_replay) {
+	if (!this->isOpen()) {
+		return false;
+	}
+	std::string logPath = this->path + ".log";
+	int fd = ::open(logPath.c_str(), O_RDWR | O_APPEND | O_CLOEXEC);
+	if (fd < 0) {
+		return this->resetLog();	/* No log yet */
+	}
+	LogHeader header;
+	if (readAll(fd, &header, sizeof(header)) != static_cast<ssize_t>(sizeof(header))
+	        || std::memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0
+	        || header.byteOrder != BYTE_ORDER_MARK
+	        || header.version != LOG_VERSION
+	        || header.headerChecksum != foldedChecksum(&header, offsetof(LogHeader, headerChecksum))) {
+		clogW << "Discarding invalid GP device store log " << logPath << "\n";
+		::close(fd);
+		return this->resetLog();
+	}
+	if (header.generation != this->generation) {
+		/* Left over from the previous snapshot, which was replaced before the log could be reset: all its records are in the snapshot */
+		clogD << "Discarding GP device store log of generation " << std::dec << header.generation << "\n";
+		::close(fd);
+		return this->resetLog();
+	}
+	this->replaying = true;
+	this->nbLogRecords = 0;
+	bool truncated = false;
+	LogRecord records[REPLAY_BUFFER_RECORDS];
+	while (!truncated) {
+		ssize_t nbRead = readAll(fd, records, sizeof(records));
+		if (nbRead < 0) {
+			clogE << "Cannot read GP device store log " << logPath << ": " << std::strerror(errno) << "\n";
+			break;
+		}
+		std::size_t nbRecords = static_cast<std::size_t>(nbRead) / sizeof(LogRecord);
+		truncated = (static_cast<std::size_t>(nbRead) % sizeof(LogRecord) != 0);	/* Incomplete last record */
+		for (std::size_t i = 0; i < nbRecords; i++) {
+			if (!isValidRecord(records[i])) {
+				truncated = true;
+				break;
+			}
+			NSEZSP::EmberKeyData key;
+			std::copy(records[i].key, records[i].key + sizeof(records[i].key), key.begin());
+			i_replay(static_cast<Operation>(records[i].operation), records[i].sourceId, key, records[i].frameCounter);
+			this->nbLogRecords++;
+		}
+		if (static_cast<std::size_t>(nbRead) < sizeof(records)) {
+			break;	/* End of file */
+		}
+	}
+	this->replaying = false;
+	off_t validSize = static_cast<off_t>(sizeof(LogHeader) + this->nbLogRecords * sizeof(LogRecord));
+	if (truncated) {
+		/* Power loss while appending: drop the damaged tail, so that new records are appended right after the last valid one */
+		clogW << "GP device store log " << logPath << " has a damaged tail, keeping its first " << std::dec << this->nbLogRecords << " records\n";
+		if (::ftruncate(fd, validSize) != 0 || ::fdatasync(fd) != 0) {
+			clogE << "Cannot truncate GP device store log " << logPath << ": " << std::strerror(errno) << "\n";
+			::close(fd);
+			return false;
+		}
+	}
+	this->logFd = fd;
+	clogD << "Replayed " << std::dec << this->nbLogRecords << " records from GP device store log " << logPath << "\n";
+	return true;
+}
+
+void CGPDeviceStore::close() {
+	if (this->snapshotFd >= 0) {
+		::close(this->snapshotFd);
+		this->snapshotFd = -1;
+	}
+	if (this->logFd >= 0) {
+		::close(this->logFd);
+		this->logFd = -1;
+	}
+	this->path.clear();
+	this->generation = 0;
+	this->nbSnapshotDevices = 0;
+	this->nbLogRecords = 0;
+	this->replaying = false;
+}
+
+bool CGPDeviceStore::isOpen() const {
+	return !this->path.empty();
+}
+
+bool CGPDeviceStore::save(const Table& i_table) {
+	if (!this->isOpen() || this->replaying || this->snapshotFd >= 0) {
+		return false;	/* The log cannot be reset while it is being read, nor the snapshot replaced before it has been loaded */
+	}
+	SnapshotHeader header;
+	std::memset(&header, 0, sizeof(header));
+	std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	header.byteOrder = BYTE_ORDER_MARK;
+	header.version = SNAPSHOT_VERSION;
+	header.generation = this->generation + 1;
+	header.nbDevices = i_table.nbDevices;
+	bool written = writeFileAtomically(this->path, [&header, &i_table](int fd) {
+		/* Records are streamed after a placeholder header, the final header (with the payload checksum) is written last */
+		if (!writeAll(fd, &header, sizeof(header))) {
+			return false;
+		}
+		Fletcher64 payloadChecksum;
+		SnapshotRecord records[SNAPSHOT_BUFFER_RECORDS];
+		std::size_t nbPending = 0;
+		std::size_t nbWritten = 0;
+		for (std::size_t slot = 0; slot < i_table.nbSlots; slot++) {
+			if (i_table.sourceIds[slot] != 0) {
+				SnapshotRecord& record = records[nbPending++];
+				record.sourceId = i_table.sourceIds[slot];
+				record.frameCounter = i_table.frameCounters[slot];
+				std::copy(i_table.keys[slot].begin(), i_table.keys[slot].end(), record.key);
+			}
+			if (nbPending == SNAPSHOT_BUFFER_RECORDS || (slot + 1 == i_table.nbSlots && nbPending > 0)) {
+				payloadChecksum.update(records, nbPending * sizeof(SnapshotRecord));
+				if (!writeAll(fd, records, nbPending * sizeof(SnapshotRecord))) {
+					return false;
+				}
+				nbWritten += nbPending;
+				nbPending = 0;
+			}
+		}
+		if (nbWritten != header.nbDevices) {
+			clogE << "GP device table holds " << std::dec << nbWritten << " devices, expected " << header.nbDevices << "\n";
+			return false;
+		}
+		header.payloadChecksum = payloadChecksum.value();
+		header.headerChecksum = foldedChecksum(&header, offsetof(SnapshotHeader, headerChecksum));
+		return ::pwrite(fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+	});
+	if (!written) {
+		return false;
+	}
+	this->generation = header.generation;
+	/* The log of the previous generation is now obsolete (it would be discarded at next open even if this fails) */
+	if (!this->resetLog()) {
+		clogE << "Cannot reset GP device store log for " << this->path << "\n";
+	}
+	clogD << "GP device store " << this->path << " saved with " << std::dec << i_table.nbDevices << " devices, generation " << this->generation << "\n";
+	return true;
+}
+
+bool CGPDeviceStore::appendRecords(const void* i_records, std::size_t i_count, bool i_sync) {
+	if (this->logFd < 0) {
+		return false;
+	}
+	if (!writeAll(this->logFd, i_records, i_count * sizeof(LogRecord)) || (i_sync && ::fdatasync(this->logFd) != 0)) {
+		clogE << "Cannot append to GP device store log for " << this->path << ": " << std::strerror(errno) << "\n";
+		/* Do not leave a partial record, that would hide all records appended after it at next replay */
+		if (::ftruncate(this->logFd, static_cast<off_t>(sizeof(LogHeader) + this->nbLogRecords * sizeof(LogRecord))) != 0) {
+			clogE << "Cannot truncate GP device store log for " << this->path << "\n";
+		}
+		return false;
+	}
+	this->nbLogRecords += i_count;
+	return true;
+}
+
+bool CGPDeviceStore::append(Operation i_operation, uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key) {
+	if (!this->isOpen() || this->replaying) {
+		return true;
+	}
+	LogRecord record;
+	std::memset(&record, 0, sizeof(record));
+	record.operation = static_cast<uint32_t>(i_operation);
+	record.sourceId = i_source_id;
+	if (i_operation == Operation::ADD) {
+		std::copy(i_key.begin(), i_key.end(), record.key);
+	}
+	record.recordChecksum = foldedChecksum(&record, offsetof(LogRecord, recordChecksum));
+	return this->appendRecords(&record, 1, true);
+}
+
+bool CGPDeviceStore::appendFrameCounters(const uint32_t i_source_ids[], const uint32_t i_frame_counters[], std::size_t i_count) {
+	if (!this->isOpen() || this->replaying || i_count == 0) {
+		return true;
+	}
+	LogRecord records[APPEND_BUFFER_RECORDS];
+	std::size_t nbPending = 0;
+	for (std::size_t index = 0; index < i_count; index++) {
+		LogRecord& record = records[nbPending++];
+		std::memset(&record, 0, sizeof(record));
+		record.operation = static_cast<uint32_t>(Operation::FRAME_COUNTER);
+		record.sourceId = i_source_ids[index];
+		record.frameCounter = i_frame_counters[index];
+		record.recordChecksum = foldedChecksum(&record, offsetof(LogRecord, recordChecksum));
+		bool last = (index + 1 == i_count);
+		if ((nbPending == APPEND_BUFFER_RECORDS || last) && !this->appendRecords(records, nbPending, last)) {	/* Only sync once, after the last chunk */
+			return false;
+		}
+		if (nbPending == APPEND_BUFFER_RECORDS) {
+			nbPending = 0;
+		}
+	}
+	return true;
+}
+
+std::size_t CGPDeviceStore::logRecords() const {
+	return this->nbLogRecords;
+}
+
+#else	// USE_GP_DEVICE_STORE
+
+/* Built without file access (non-POSIX platform, or USE_GP_DEVICE_STORE disabled): the store can never be opened, so the database
+ * simply remains in memory */
+
+CGPDeviceStore::CGPDeviceStore() :
+	path(),
+	generation(0),
+	snapshotFd(-1),
+	nbSnapshotDevices(0),
+	logFd(-1),
+	nbLogRecords(0),
+	replaying(false) {
+}
+
+CGPDeviceStore::~CGPDeviceStore() {
+}
+
+bool CGPDeviceStore::open(const std::string& i_path, std::size_t& o_nb_devices) {
+	clogE << "Cannot open GP device store " << i_path << ": persistent storage is not supported by this build (see USE_GP_DEVICE_STORE)\n";
+	o_nb_devices = 0;
+	return false;
+}
+
+bool CGPDeviceStore::load(FLoadCallback i_load) {
+	(void)i_load;
+	return false;
+}
+
+bool CGPDeviceStore::replayLog(FReplayCallback i_replay) {
+	(void)i_replay;
+	return false;
+}
+
+void CGPDeviceStore::close() {
+}
+
+bool CGPDeviceStore::isOpen() const {
+	return false;
+}
+
+bool CGPDeviceStore::save(const Table& i_table) {
+	(void)i_table;
+	return false;
+}
+
+bool CGPDeviceStore::append(Operation i_operation, uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key) {
+	(void)i_operation;
+	(void)i_source_id;
+	(void)i_key;
+	return true;	/* Same as a closed store */
+}
+
+bool CGPDeviceStore::appendFrameCounters(const uint32_t i_source_ids[], const uint32_t i_frame_counters[], std::size_t i_count) {
+	(void)i_source_ids;
+	(void)i_frame_counters;
+	(void)i_count;
+	return true;	/* Same as a closed store */
+}
+
+std::size_t CGPDeviceStore::logRecords() const {
+	return 0;
+}
+
+#endif	// USE_GP_DEVICE_STORE
@@ -0,0 +1,208 @@
+/**
+ * @file green-power-device-store.h
+ *
+ * @brief Persistent storage of the green power device database (snapshot + append-only delta log)
+ */
+
+#pragma once
+
+#include <string>
+#include <cstddef>
+#include <functional>
+
+#include <ezsp/export.h>
+#include "ezsp/ezsp-protocol/ezsp-enum.h"
+
+namespace NSEZSP {
+
+/**
+ * @brief Files backing a CGPDeviceDb across restarts
+ *
+ * The store is made of two files:
+ * - A snapshot (at the path given to open()): a 64-byte header followed by one record (source ID, frame counter and key) per device.
+ *   Key schedules are not stored (they would take 11 times the size of the keys, and their layout depends on the AES backend): the database
+ *   re-computes them while loading the snapshot (see load()). The layout of the database hash table is not stored either.
+ * - A delta log (same path, suffixed with ".log"), to which each device addition and removal is appended (and synced) after the snapshot
+ *   has been written, as well as batches of frame counter updates. The log is replayed over the snapshot by replayLog().
+ *
+ * Crash safety relies on the following:
+ * - A new snapshot is fully written and synced to a temporary file, then atomically renamed over the previous one (see save()).
+ * - The snapshot header carries a checksum of the whole table, the header of the log and each log record carry their own checksum.
+ * - Both files carry a generation number: a log left over from a previous snapshot (power loss between the two renames) is discarded.
+ * - Replaying the log stops at the first incomplete or corrupted record (power loss during an append), the log is truncated there.
+ *
+ * @note All integers are stored in host byte order, files are thus not portable between hosts with different endianness (this is detected by open()).
+ * @note Files are accessed using the POSIX file API. It is only available if the library has been built with USE_GP_DEVICE_STORE (the default
+ *       on POSIX systems), open() always fails otherwise.
+ */
+class CGPDeviceStore {
+public:
+	/**
+	 * @brief Location and size of the table arrays to save (see save())
+	 */
+	struct Table {
+		Table() : nbSlots(0), nbDevices(0), sourceIds(nullptr), frameCounters(nullptr), keys(nullptr) { }
+
+		std::size_t nbSlots;	/*!< The number of slots (0 if there is no table) */
+		std::size_t nbDevices;	/*!< The number of used slots */
+		const uint32_t* sourceIds;	/*!< The source ID stored in each slot (0 for unused slots) */
+		const uint32_t* frameCounters;	/*!< The lowest frame counter still acceptable from the device stored in each slot */
+		const NSEZSP::EmberKeyData* keys;	/*!< The key of the device stored in each slot */
+	};
+
+	/**
+	 * @brief Modifications recorded in the delta log
+	 */
+	enum class Operation : uint32_t {
+		ADD = 1,	/*!< A device has been added (or its key has been overwritten) */
+		REMOVE = 2,	/*!< A device has been removed */
+		FRAME_COUNTER = 3,	/*!< The frame counter of a device has changed */
+	};
+
+	/**
+	 * @brief Callback invoked for each record replayed from the delta log
+	 */
+	typedef std::function<void (Operation i_operation, uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key, uint32_t i_frame_counter)> FReplayCallback;
+
+	/**
+	 * @brief Callback invoked for each device read from the snapshot
+	 */
+	typedef std::function<void (uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key, uint32_t i_frame_counter)> FLoadCallback;
+
+	CGPDeviceStore();
+
+	~CGPDeviceStore();
+
+	CGPDeviceStore(const CGPDeviceStore&) = delete;	/* No copy (owns file descriptors) */
+	CGPDeviceStore& operator=(const CGPDeviceStore&) = delete;
+
+	/**
+	 * @brief Open the store and validate its snapshot
+	 *
+	 * @param[in] i_path The path of the snapshot file (the log is stored next to it)
+	 * @param[out] o_nb_devices The number of devices in the snapshot (0 if there is no snapshot yet, for a new store)
+	 *
+	 * @return false if the snapshot exists but is invalid (wrong format, version, byte order or checksum) or could not be read,
+	 *         in which case the store remains closed
+	 *
+	 * @note load() then replayLog() must then be invoked
+	 */
+	bool open(const std::string& i_path, std::size_t& o_nb_devices);
+
+	/**
+	 * @brief Read the devices of the snapshot validated by open()
+	 *
+	 * @param[in] i_load A callback storing each device
+	 *
+	 * @return false if the snapshot could not be read anymore (some devices may then have been passed to @p i_load)
+	 */
+	bool load(FLoadCallback i_load);
+
+	/**
+	 * @brief Replay the delta log of an open store, then get ready to append to it
+	 *
+	 * A log that does not match the snapshot (different generation, invalid header) is replaced by an empty one.
+	 * A log ending with an incomplete or corrupted record is truncated after the last valid record.
+	 *
+	 * @param[in] i_replay A callback applying each logged modification. Modifications done by this callback are not appended again to the log.
+	 *
+	 * @return false if the log could not be opened nor created
+	 */
+	bool replayLog(FReplayCallback i_replay);
+
+	/**
+	 * @brief Close the store
+	 */
+	void close();
+
+	/**
+	 * @brief Is the store open?
+	 *
+	 * @return true if open() succeeded and close() has not been called since
+	 */
+	bool isOpen() const;
+
+	/**
+	 * @brief Write a new snapshot of a table and reset the delta log
+	 *
+	 * @param[in] i_table The table to save
+	 *
+	 * @return true on success, false if the new snapshot could not be written (the previous snapshot and log are then still valid)
+	 */
+	bool save(const Table& i_table);
+
+	/**
+	 * @brief Append a modification to the delta log, and sync it to disk
+	 *
+	 * @param i_operation The modification
+	 * @param i_source_id The source ID of the device
+	 * @param i_key The key of the device (ignored for Operation::REMOVE)
+	 *
+	 * @return true if the modification is now on disk (or if the store is closed, or replaying its log)
+	 */
+	bool append(Operation i_operation, uint32_t i_source_id, const NSEZSP::EmberKeyData& i_key);
+
+	/**
+	 * @brief Append frame counter updates of several devices to the delta log, with a single sync to disk
+	 *
+	 * @param i_source_ids The source IDs of the devices
+	 * @param i_frame_counters The new frame counter of each device
+	 * @param i_count The number of devices
+	 *
+	 * @return true if the updates are now on disk (or if the store is closed, or replaying its log)
+	 */
+	bool appendFrameCounters(const uint32_t i_source_ids[], const uint32_t i_frame_counters[], std::size_t i_count);
+
+	/**
+	 * @brief Get the number of modifications in the delta log
+	 *
+	 * @return The number of log records since the last snapshot
+	 */
+	std::size_t logRecords() const;
+
+	/**
+	 * @brief Compute the checksum used by snapshots and logs
+	 *
+	 * Fletcher-64 over 32-bit words, processed in blocks so that the modulo is only computed once per block.
+	 *
+	 * @param data The data to checksum (must be 32-bit aligned)
+	 * @param size The size of @p data in bytes (must be a multiple of 4)
+	 *
+	 * @return The checksum
+	 */
+	static uint64_t checksum(const void* data, std::size_t size);
+
+private:
+	/**
+	 * @brief Open and validate the snapshot file
+	 *
+	 * @return false if the file is invalid or could not be read
+	 */
+	bool openSnapshot();
+
+	/**
+	 * @brief Write records at the end of the delta log, removing any partially written record on failure
+	 *
+	 * @param i_records The records
+	 * @param i_count The number of records
+	 * @param i_sync Also sync the log to disk
+	 *
+	 * @return true if the records have been written
+	 */
+	bool appendRecords(const void* i_records, std::size_t i_count, bool i_sync);
+
+	/**
+	 * @brief Atomically replace the delta log with an empty one for the current generation
+	 */
+	bool resetLog();
+
+	std::string path;	/*!< The path of the snapshot file, empty when closed */
+	uint32_t generation;	/*!< The generation of the current snapshot (0 if there is no snapshot yet) */
+	int snapshotFd;	/*!< The file descriptor of the snapshot between open() and load(), -1 otherwise */
+	std::size_t nbSnapshotDevices;	/*!< The number of devices in the snapshot opened by open() */
+	int logFd;	/*!< The file descriptor of the delta log, -1 when closed */
+	std::size_t nbLogRecords;	/*!< The number of records in the delta log */
+	bool replaying;	/*!< Are we replaying the log (modifications must not be appended) */
+};
+
+} // namespace NSEZSP
@@ -0,0 +1,195 @@
+/**
+ * @file green-power-downlink-queue.cpp
+ *
+ * @brief Host-side queues of GPDFs waiting for the reception window of rx-after-tx GP devices
+ */
+
+#include <algorithm>
+
+#include "green-power-downlink-queue.h"
+
+using NSEZSP::CGpDownlinkQueue;
+
+constexpr std::chrono::milliseconds CGpDownlinkQueue::UNKNOWN_PERIOD_LIFETIME;
+constexpr std::chrono::milliseconds CGpDownlinkQueue::MIN_UPLINK_INTERVAL;
+constexpr std::chrono::milliseconds CGpDownlinkQueue::MIN_WAKE_GUARD;
+
+namespace {
+constexpr std::chrono::milliseconds MAX_LIFETIME = std::chrono::milliseconds(0xFFFF);	/* The adapter's GPDF lifetime is a 16-bit number of milliseconds */
+}
+
+CGpDownlinkQueue::CGpDownlinkQueue() :
+	queues(),
+	timings(),
+	nbQueued(0) {
+}
+
+void CGpDownlinkQueue::enqueue(uint32_t i_source_id, uint8_t i_command_id, const NSSPI::ByteBuffer& i_payload, unsigned int i_max_attempts,
+                               std::chrono::steady_clock::duration i_time_to_live, std::chrono::steady_clock::time_point i_now, FDownlinkCallback i_callback,
+                               std::vector<Push>& o_pushes) {
+	DeviceQueue& queue = this->queues[i_source_id];
+	queue.downlinks.push_back({ i_command_id, i_payload, std::max(i_max_attempts, 1U), 0, i_now, i_now + i_time_to_live, std::move(i_callback) });
+	this->nbQueued++;
+	if (queue.downlinks.size() == 1) {
+		queue.inFlight = false;
+		this->schedule(i_source_id, queue, i_now, false);
+		if (queue.scheduled && queue.pushAt <= i_now) {
+			this->push(i_source_id, queue, queue.windowEnd - i_now, o_pushes);
+		}
+	}
+}
+
+void CGpDownlinkQueue::uplink(uint32_t i_source_id, std::chrono::steady_clock::time_point i_now, std::vector<Push>& o_pushes) {
+	auto timing = this->timings.find(i_source_id);
+	if (timing == this->timings.end()) {
+		this->timings.emplace(i_source_id, Timing({ i_now, std::chrono::steady_clock::duration::zero() }));
+	}
+	else {
+		std::chrono::steady_clock::duration interval = i_now - timing->second.lastUplink;
+		if (interval < MIN_UPLINK_INTERVAL) {
+			return;	/* Repetition of the uplink that was just processed */
+		}
+		std::chrono::steady_clock::duration& period = timing->second.period;
+		if (period == std::chrono::steady_clock::duration::zero()) {
+			period = interval;
+		}
+		else {
+			/* Uplinks may have been missed, the interval then spans several periods */
+			std::chrono::steady_clock::duration::rep nbPeriods = std::max<std::chrono::steady_clock::duration::rep>((interval + period / 2) / period, 1);
+			period = (3 * period + interval / nbPeriods) / 4;
+		}
+		timing->second.lastUplink = i_now;
+	}
+
+	auto queue = this->queues.find(i_source_id);
+	if (queue == this->queues.end() || queue->second.inFlight) {
+		return;
+	}
+	if (this->schedule(i_source_id, queue->second, i_now, true)) {
+		this->push(i_source_id, queue->second, UNKNOWN_PERIOD_LIFETIME, o_pushes);
+	}
+	else if (queue->second.scheduled && queue->second.pushAt <= i_now) {
+		this->push(i_source_id, queue->second, queue->second.windowEnd - i_now, o_pushes);
+	}
+}
+
+void CGpDownlinkQueue::sent(uint32_t i_source_id, bool i_delivered, std::chrono::steady_clock::time_point i_now, std::vector<Finished>& o_finished) {
+	auto queue = this->queues.find(i_source_id);
+	if (queue == this->queues.end() || !queue->second.inFlight) {
+		return;
+	}
+	queue->second.inFlight = false;
+	Downlink& head = queue->second.downlinks.front();
+	if (i_delivered || head.attemptsLeft == 0 || head.expiry <= i_now) {
+		o_finished.push_back({ { i_source_id, head.commandId, i_delivered, head.nbAttempts, std::chrono::duration_cast<std::chrono::microseconds>(i_now - head.queued) },
+		                       std::move(head.callback) });
+		queue->second.downlinks.pop_front();
+		this->nbQueued--;
+	}
+	this->expire(i_source_id, queue->second, i_now, o_finished);
+	if (queue->second.downlinks.empty()) {
+		this->queues.erase(queue);
+	}
+	else {
+		this->schedule(i_source_id, queue->second, i_now, false);	/* Pushed by poll() if due, or after the next uplink */
+	}
+}
+
+void CGpDownlinkQueue::poll(std::chrono::steady_clock::time_point i_now, std::vector<Push>& o_pushes, std::vector<Finished>& o_finished) {
+	for (auto queue = this->queues.begin(); queue != this->queues.end(); ) {
+		this->expire(queue->first, queue->second, i_now, o_finished);
+		if (queue->second.downlinks.empty()) {
+			queue = this->queues.erase(queue);
+			continue;
+		}
+		if (!queue->second.inFlight) {
+			if (!queue->second.scheduled) {
+				this->schedule(queue->first, queue->second, i_now, false);	/* The period may have been learned in the meantime */
+			}
+			if (queue->second.scheduled && queue->second.pushAt <= i_now) {
+				this->push(queue->first, queue->second, queue->second.windowEnd - i_now, o_pushes);
+			}
+		}
+		++queue;
+	}
+}
+
+bool CGpDownlinkQueue::getNextEvent(std::chrono::steady_clock::time_point& o_when) const {
+	bool found = false;
+	auto consider = [&found, &o_when](std::chrono::steady_clock::time_point i_when) {
+		if (!found || i_when < o_when) {
+			o_when = i_when;
+			found = true;
+		}
+	};
+	for (const auto& queue : this->queues) {
+		if (!queue.second.inFlight && queue.second.scheduled) {
+			consider(queue.second.pushAt);
+		}
+		for (std::size_t index = (queue.second.inFlight ? 1 : 0); index < queue.second.downlinks.size(); index++) {
+			consider(queue.second.downlinks[index].expiry);
+		}
+	}
+	return found;
+}
+
+std::chrono::milliseconds CGpDownlinkQueue::getPeriod(uint32_t i_source_id) const {
+	auto timing = this->timings.find(i_source_id);
+	if (timing == this->timings.end()) {
+		return std::chrono::milliseconds::zero();
+	}
+	return std::chrono::duration_cast<std::chrono::milliseconds>(timing->second.period);
+}
+
+std::chrono::steady_clock::duration CGpDownlinkQueue::getWakeGuard(std::chrono::steady_clock::duration i_period) {
+	return std::max<std::chrono::steady_clock::duration>(i_period / 8, MIN_WAKE_GUARD);
+}
+
+std::size_t CGpDownlinkQueue::getNbQueued() const {
+	return this->nbQueued;
+}
+
+bool CGpDownlinkQueue::schedule(uint32_t i_source_id, DeviceQueue& io_queue, std::chrono::steady_clock::time_point i_now, bool i_after_uplink) {
+	io_queue.scheduled = false;
+	if (io_queue.inFlight || io_queue.downlinks.empty()) {
+		return false;
+	}
+	auto timing = this->timings.find(i_source_id);
+	if (timing == this->timings.end() || timing->second.period == std::chrono::steady_clock::duration::zero()) {
+		return i_after_uplink;	/* Period unknown, the device is only known to listen right after its uplinks */
+	}
+	std::chrono::steady_clock::duration period = timing->second.period;
+	std::chrono::steady_clock::duration guard = getWakeGuard(period);
+	std::chrono::steady_clock::time_point predicted = timing->second.lastUplink + period;
+	if (predicted + guard <= i_now) {	/* Predicted uplinks were missed, aim at the next one */
+		predicted += period * ((i_now - predicted - guard) / period + 1);
+	}
+	io_queue.scheduled = true;
+	io_queue.pushAt = predicted - guard;
+	io_queue.windowEnd = predicted + guard;
+	return false;
+}
+
+void CGpDownlinkQueue::push(uint32_t i_source_id, DeviceQueue& io_queue, std::chrono::steady_clock::duration i_life_time, std::vector<Push>& o_pushes) {
+	Downlink& head = io_queue.downlinks.front();
+	std::chrono::milliseconds lifeTime = std::min(std::max(std::chrono::duration_cast<std::chrono::milliseconds>(i_life_time), std::chrono::milliseconds(1)), MAX_LIFETIME);
+	head.attemptsLeft--;
+	head.nbAttempts++;
+	io_queue.inFlight = true;
+	io_queue.scheduled = false;
+	o_pushes.push_back({ i_source_id, head.commandId, head.payload, static_cast<uint16_t>(lifeTime.count()) });
+}
+
+void CGpDownlinkQueue::expire(uint32_t i_source_id, DeviceQueue& io_queue, std::chrono::steady_clock::time_point i_now, std::vector<Finished>& o_finished) {
+	auto first = io_queue.downlinks.begin() + (io_queue.inFlight ? 1 : 0);
+	for (auto downlink = first; downlink != io_queue.downlinks.end(); ) {
+		if (downlink->expiry > i_now) {
+			++downlink;
+			continue;
+		}
+		o_finished.push_back({ { i_source_id, downlink->commandId, false, downlink->nbAttempts, std::chrono::duration_cast<std::chrono::microseconds>(i_now - downlink->queued) },
+		                       std::move(downlink->callback) });
+		downlink = io_queue.downlinks.erase(downlink);
+		this->nbQueued--;
+	}
+}
@@ -0,0 +1,206 @@
+/**
+ * @file green-power-downlink-queue.h
+ *
+ * @brief Host-side queues of GPDFs waiting for the reception window of rx-after-tx GP devices
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <chrono>
+#include <functional>
+
+#include "spi/ByteBuffer.h"
+
+namespace NSEZSP {
+
+/**
+ * @brief Outcome of a GPDF queued for an rx-after-tx GP device
+ */
+struct CGpDownlinkReport {
+	uint32_t sourceId;	/*!< The source ID of the destination GPD */
+	uint8_t commandId;	/*!< The GPD command ID */
+	bool delivered;	/*!< true if the adapter confirmed the transmission, false if all attempts failed or if the GPDF expired */
+	unsigned int nbAttempts;	/*!< The number of times the GPDF was queued in the adapter */
+	std::chrono::microseconds queueDelay;	/*!< The time from queueing to the outcome */
+};
+
+/**
+ * @brief Per GP device queues of GPDFs, that are only handed over to the adapter's GP TX queue when the device is about to listen
+ *
+ * An rx-after-tx GP device only listens during a short window after each of its own transmissions. Rather than occupying one of the few
+ * entries of the adapter's GP TX queue until the device wakes up, GPDFs wait on the host, one queue per source ID, and the head of a
+ * queue is pushed to the adapter (one GPDF per device at a time):
+ * - right after an uplink from the device, with a lifetime of UNKNOWN_PERIOD_LIFETIME, as long as its reporting period is unknown
+ * - or shortly before its next uplink, predicted from its reporting period learned from previous uplinks. The GPDF then only stays
+ *   in the adapter's queue for a window of twice getWakeGuard() around the predicted uplink.
+ *
+ * Each push is one attempt. A GPDF is given up after its last attempt fails, or once its time to live is over.
+ *
+ * The current time is given to each method, no timer is used here. This class is not thread-safe, the sink protects it with its own mutex.
+ */
+class CGpDownlinkQueue {
+public:
+	typedef std::function<void (const CGpDownlinkReport& i_report)> FDownlinkCallback;	/*!< Callback invoked with the outcome of a queued GPDF */
+
+	static constexpr std::chrono::milliseconds UNKNOWN_PERIOD_LIFETIME = std::chrono::milliseconds(10000);	/*!< Lifetime of a GPDF pushed after an uplink from a device whose period is unknown */
+	static constexpr std::chrono::milliseconds MIN_UPLINK_INTERVAL = std::chrono::milliseconds(100);	/*!< Uplinks closer than this are repetitions of the same GPD transmission */
+	static constexpr std::chrono::milliseconds MIN_WAKE_GUARD = std::chrono::milliseconds(250);	/*!< Minimum margin around a predicted uplink */
+
+	/**
+	 * @brief A GPDF to hand over to the adapter now
+	 */
+	struct Push {
+		uint32_t sourceId;	/*!< The source ID of the destination GPD */
+		uint8_t commandId;	/*!< The GPD command ID */
+		NSSPI::ByteBuffer payload;	/*!< The GPD command payload */
+		uint16_t lifeTimeMs;	/*!< How long the adapter should keep it in its GP TX queue */
+	};
+
+	/**
+	 * @brief A GPDF whose outcome is known
+	 */
+	struct Finished {
+		CGpDownlinkReport report;	/*!< The outcome */
+		FDownlinkCallback callback;	/*!< The callback to invoke with the outcome (may be empty) */
+	};
+
+	CGpDownlinkQueue();
+
+	/**
+	 * @brief Queue a GPDF for a device
+	 *
+	 * @param i_source_id The source ID of the destination GPD
+	 * @param i_command_id The GPD command ID
+	 * @param[in] i_payload The GPD command payload
+	 * @param i_max_attempts The maximum number of times the GPDF is pushed to the adapter (at least 1)
+	 * @param i_time_to_live How long to keep the GPDF on the host before giving up
+	 * @param i_now The current time
+	 * @param i_callback The callback to invoke with the outcome
+	 * @param[out] o_pushes The GPDF is appended here if it can be pushed right away
+	 */
+	void enqueue(uint32_t i_source_id, uint8_t i_command_id, const NSSPI::ByteBuffer& i_payload, unsigned int i_max_attempts,
+	             std::chrono::steady_clock::duration i_time_to_live, std::chrono::steady_clock::time_point i_now, FDownlinkCallback i_callback,
+	             std::vector<Push>& o_pushes);
+
+	/**
+	 * @brief Record an uplink from an rx-after-tx device, learning its reporting period
+	 *
+	 * @param i_source_id The source ID of the device
+	 * @param i_now The current time
+	 * @param[out] o_pushes The head of the device's queue is appended here if it must be pushed right away
+	 */
+	void uplink(uint32_t i_source_id, std::chrono::steady_clock::time_point i_now, std::vector<Push>& o_pushes);
+
+	/**
+	 * @brief Record the outcome of the last push for a device
+	 *
+	 * @param i_source_id The source ID of the device
+	 * @param i_delivered true if the adapter confirmed the transmission
+	 * @param i_now The current time
+	 * @param[out] o_finished The GPDF is appended here if it was delivered, or if it is given up
+	 */
+	void sent(uint32_t i_source_id, bool i_delivered, std::chrono::steady_clock::time_point i_now, std::vector<Finished>& o_finished);
+
+	/**
+	 * @brief Push the GPDFs whose predicted uplink is near, and give up those whose time to live is over
+	 *
+	 * @param i_now The current time
+	 * @param[out] o_pushes The GPDFs to push now are appended here
+	 * @param[out] o_finished The GPDFs given up are appended here
+	 */
+	void poll(std::chrono::steady_clock::time_point i_now, std::vector<Push>& o_pushes, std::vector<Finished>& o_finished);
+
+	/**
+	 * @brief Get the time at which poll() has something to do
+	 *
+	 * @param[out] o_when The time of the next scheduled push or expiry
+	 *
+	 * @return false if nothing is scheduled
+	 */
+	bool getNextEvent(std::chrono::steady_clock::time_point& o_when) const;
+
+	/**
+	 * @brief Get the reporting period learned for a device
+	 *
+	 * @param i_source_id The source ID of the device
+	 *
+	 * @return The period, or 0 if it is not known yet
+	 */
+	std::chrono::milliseconds getPeriod(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Get the margin around the predicted uplinks of a device with a learned period
+	 *
+	 * @param i_period The learned period of the device
+	 *
+	 * @return One eighth of the period, at least MIN_WAKE_GUARD
+	 */
+	static std::chrono::steady_clock::duration getWakeGuard(std::chrono::steady_clock::duration i_period);
+
+	/**
+	 * @brief Get the number of GPDFs waiting on the host or in the adapter
+	 */
+	std::size_t getNbQueued() const;
+
+private:
+	/**
+	 * @brief A queued GPDF
+	 */
+	struct Downlink {
+		uint8_t commandId;	/*!< The GPD command ID */
+		NSSPI::ByteBuffer payload;	/*!< The GPD command payload */
+		unsigned int attemptsLeft;	/*!< How many more times it may be pushed */
+		unsigned int nbAttempts;	/*!< How many times it was pushed */
+		std::chrono::steady_clock::time_point queued;	/*!< When it was queued */
+		std::chrono::steady_clock::time_point expiry;	/*!< When to give up */
+		FDownlinkCallback callback;	/*!< The callback to invoke with the outcome */
+	};
+
+	/**
+	 * @brief The GPDFs queued for one device
+	 */
+	struct DeviceQueue {
+		std::deque<Downlink> downlinks;	/*!< Queued GPDFs, the head is the next one to push */
+		bool inFlight;	/*!< Is the head in the adapter's GP TX queue? */
+		bool scheduled;	/*!< Is a push of the head scheduled at pushAt? */
+		std::chrono::steady_clock::time_point pushAt;	/*!< When to push the head, shortly before a predicted uplink */
+		std::chrono::steady_clock::time_point windowEnd;	/*!< The end of the listening window expected around that predicted uplink */
+	};
+
+	/**
+	 * @brief Uplink timing of a device
+	 */
+	struct Timing {
+		std::chrono::steady_clock::time_point lastUplink;	/*!< When the last uplink was received */
+		std::chrono::steady_clock::duration period;	/*!< The learned reporting period (0 if unknown) */
+	};
+
+	/**
+	 * @brief Decide when to push the head of a queue that is not in flight
+	 *
+	 * @return true if it must be pushed right away for UNKNOWN_PERIOD_LIFETIME (after an uplink of a device whose period is unknown).
+	 *         Otherwise, a push may be scheduled at pushAt
+	 */
+	bool schedule(uint32_t i_source_id, DeviceQueue& io_queue, std::chrono::steady_clock::time_point i_now, bool i_after_uplink);
+
+	/**
+	 * @brief Hand over the head of a queue to the adapter
+	 */
+	void push(uint32_t i_source_id, DeviceQueue& io_queue, std::chrono::steady_clock::duration i_life_time, std::vector<Push>& o_pushes);
+
+	/**
+	 * @brief Remove the GPDFs of a queue whose time to live is over, except the head while it is in flight
+	 */
+	void expire(uint32_t i_source_id, DeviceQueue& io_queue, std::chrono::steady_clock::time_point i_now, std::vector<Finished>& o_finished);
+
+	std::unordered_map<uint32_t, DeviceQueue> queues;	/*!< Queues of the devices that have GPDFs waiting, by source ID */
+	std::unordered_map<uint32_t, Timing> timings;	/*!< Uplink timing of the rx-after-tx devices heard so far, by source ID */
+	std::size_t nbQueued;	/*!< Total number of queued GPDFs */
+};
+
+} // namespace NSEZSP
@@ -0,0 +1,67 @@
+/**
+ * @file green-power-duplicate-filter.cpp
+ *
+ * @brief Per source ID memory of the last green power frame accepted, used to drop retransmissions of this frame
+ */
+
+#include "green-power-duplicate-filter.h"
+
+using NSEZSP::CGpDuplicateFilter;
+
+constexpr std::chrono::milliseconds CGpDuplicateFilter::DUPLICATE_TIMEOUT;
+constexpr std::size_t CGpDuplicateFilter::MIN_SLOTS;
+
+CGpDuplicateFilter::CGpDuplicateFilter(std::size_t i_capacity) :
+	slots(),
+	slotShift(32) {
+	std::size_t nbSlots = 1;
+	while (nbSlots < i_capacity || nbSlots < MIN_SLOTS) {
+		nbSlots <<= 1;
+		this->slotShift--;
+	}
+	this->slots.resize(nbSlots);
+	this->clear();
+}
+
+CGpDuplicateFilter::Slot& CGpDuplicateFilter::slotOf(uint32_t i_source_id) {
+	/* Fibonacci hashing: source IDs are often allocated sequentially, the high bits of the product spread them over all slots */
+	return this->slots[static_cast<uint32_t>(i_source_id * 0x9e3779b1U) >> this->slotShift];
+}
+
+bool CGpDuplicateFilter::isDuplicateFrameCounter(uint32_t i_source_id, uint32_t i_frame_counter) {
+	Slot& slot = this->slotOf(i_source_id);
+	if (slot.kind == SlotKind::FRAME_COUNTER && slot.sourceId == i_source_id && slot.value == i_frame_counter) {
+		return true;
+	}
+	slot.sourceId = i_source_id;
+	slot.value = i_frame_counter;
+	slot.kind = SlotKind::FRAME_COUNTER;
+	return false;
+}
+
+bool CGpDuplicateFilter::isDuplicateSequenceNumber(uint32_t i_source_id, uint8_t i_sequence_number, std::chrono::steady_clock::time_point i_now) {
+	uint32_t nowMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(i_now.time_since_epoch()).count());
+	Slot& slot = this->slotOf(i_source_id);
+	if (slot.kind == SlotKind::SEQUENCE_NUMBER && slot.sourceId == i_source_id && slot.value == i_sequence_number
+	        && nowMs - slot.receivedMs < static_cast<uint32_t>(DUPLICATE_TIMEOUT.count())) {	/* Unsigned difference: correct across the wrap around */
+		return true;	/* The original frame's reception time is kept, so that a device repeating the same sequence number is heard again after the timeout */
+	}
+	slot.sourceId = i_source_id;
+	slot.value = i_sequence_number;
+	slot.receivedMs = nowMs;
+	slot.kind = SlotKind::SEQUENCE_NUMBER;
+	return false;
+}
+
+void CGpDuplicateFilter::clear() {
+	for (Slot& slot : this->slots) {
+		slot.sourceId = 0;
+		slot.value = 0;
+		slot.receivedMs = 0;
+		slot.kind = SlotKind::EMPTY;
+	}
+}
+
+std::size_t CGpDuplicateFilter::memoryFootprint() const {
+	return this->slots.capacity() * sizeof(Slot);
+}
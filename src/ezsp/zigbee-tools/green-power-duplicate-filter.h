@@ -0,0 +1,110 @@
+/**
+ * @file green-power-duplicate-filter.h
+ *
+ * @brief Per source ID memory of the last green power frame accepted, used to drop retransmissions of this frame
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <chrono>
+
+namespace NSEZSP {
+
+/**
+ * @brief Direct-mapped cache of the last frame accepted from each source ID
+ *
+ * GPDs repeat each frame on several channels, and several proxies may forward the same frame: the sink gets several copies of it.
+ * A copy is recognized by its security frame counter (for security levels 2 and 3), or by its MAC sequence number, which wraps
+ * around after 256 frames (for security levels 0 and 1). Copies recognized by their sequence number must follow the original
+ * frame within DUPLICATE_TIMEOUT.
+ *
+ * Only the last frame of each source ID is remembered, in a slot selected by hashing the source ID. Two source IDs sharing a slot
+ * evict each other: a copy may then go through, but a new frame is never reported as a duplicate.
+ *
+ * @note Frames with an older frame counter are not reported: replay protection belongs to whoever authenticates frames
+ *       (the adapter's sink table, or CGPDeviceDb when MICs are processed on the host)
+ */
+class CGpDuplicateFilter {
+public:
+	static constexpr std::chrono::milliseconds DUPLICATE_TIMEOUT = std::chrono::milliseconds(2000);	/*!< How long a sequence number identifies a frame (gpDuplicateTimeout in the Green Power specification) */
+	static constexpr std::size_t MIN_SLOTS = 256;	/*!< Minimum number of slots */
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param i_capacity The number of source IDs expected (the number of slots is the next power of 2, at least MIN_SLOTS)
+	 *
+	 * @note All storage is allocated here
+	 */
+	explicit CGpDuplicateFilter(std::size_t i_capacity);
+
+	/**
+	 * @brief Check whether a frame identified by its security frame counter is a copy of the last frame accepted from its source ID, and accept it otherwise
+	 *
+	 * @param i_source_id The source ID of the frame
+	 * @param i_frame_counter The security frame counter of the frame
+	 *
+	 * @return true if the frame is a duplicate, and should be dropped
+	 */
+	bool isDuplicateFrameCounter(uint32_t i_source_id, uint32_t i_frame_counter);
+
+	/**
+	 * @brief Check whether a frame identified by its MAC sequence number is a copy of the last frame accepted from its source ID, and accept it otherwise
+	 *
+	 * @param i_source_id The source ID of the frame
+	 * @param i_sequence_number The MAC sequence number of the frame
+	 * @param i_now The reception time of the frame
+	 *
+	 * @return true if the frame is a duplicate, and should be dropped
+	 */
+	bool isDuplicateSequenceNumber(uint32_t i_source_id, uint8_t i_sequence_number, std::chrono::steady_clock::time_point i_now);
+
+	/**
+	 * @brief Forget all frames accepted so far
+	 */
+	void clear();
+
+	/**
+	 * @brief Get the memory used by the filter
+	 *
+	 * @return The number of bytes allocated on the heap
+	 */
+	std::size_t memoryFootprint() const;
+
+private:
+	/**
+	 * @brief What identifies the frame remembered in a slot
+	 */
+	enum class SlotKind : uint8_t {
+		EMPTY,	/*!< No frame */
+		FRAME_COUNTER,	/*!< The security frame counter */
+		SEQUENCE_NUMBER,	/*!< The MAC sequence number, together with the reception time */
+	};
+
+	/**
+	 * @brief The last frame accepted from a source ID
+	 */
+	struct Slot {
+		uint32_t sourceId;	/*!< The source ID */
+		uint32_t value;	/*!< The frame counter or the sequence number of the frame */
+		uint32_t receivedMs;	/*!< The reception time of the frame in ms (steady clock, wrapping around), for SlotKind::SEQUENCE_NUMBER */
+		SlotKind kind;	/*!< What value holds */
+	};
+
+	/**
+	 * @brief Get the slot of a source ID
+	 *
+	 * @param i_source_id The source ID
+	 *
+	 * @return The slot in which the last frame from @p i_source_id is (or would be) remembered
+	 */
+	Slot& slotOf(uint32_t i_source_id);
+
+	std::vector<Slot> slots;	/*!< The slots (a power of 2 of them) */
+	unsigned int slotShift;	/*!< Right shift of a 32-bit hash giving a slot index */
+};
+
+} // namespace NSEZSP
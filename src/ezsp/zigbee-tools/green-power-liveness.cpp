@@ -0,0 +1,331 @@
+/**
+ * @file green-power-liveness.cpp
+ *
+ * @brief Detection of GP devices that stop reporting, using a hierarchical timing wheel of per-device deadlines
+ */
+
+#include <algorithm>
+
+#include "green-power-liveness.h"
+
+using NSEZSP::CGpLivenessTracker;
+using NSEZSP::CGpLivenessReport;
+
+constexpr unsigned int CGpLivenessTracker::SLOT_BITS;
+constexpr std::size_t CGpLivenessTracker::NB_SLOTS;
+constexpr std::size_t CGpLivenessTracker::NB_LEVELS;
+constexpr unsigned int CGpLivenessTracker::DEFAULT_NB_MISSED_REPORTS;
+constexpr std::chrono::milliseconds CGpLivenessTracker::DEFAULT_MIN_TIMEOUT;
+constexpr std::chrono::milliseconds CGpLivenessTracker::DEFAULT_INITIAL_TIMEOUT;
+constexpr std::chrono::milliseconds CGpLivenessTracker::DEFAULT_TICK;
+constexpr uint32_t CGpLivenessTracker::NO_ENTRY;
+constexpr unsigned int CGpLivenessTracker::PERIOD_FRACTION_BITS;
+
+namespace {
+/* Deadlines are compared by their difference with the current tick, which must stay below 2^31 */
+constexpr uint32_t MAX_TIMEOUT_TICKS = 1U << 30;
+
+/**
+ * @brief Convert a timeout to a number of ticks, rounded up
+ */
+uint32_t toTicks(std::chrono::milliseconds i_timeout, std::chrono::milliseconds i_tick) {
+	uint64_t l_ticks = static_cast<uint64_t>((i_timeout.count() + i_tick.count() - 1) / i_tick.count());
+	return static_cast<uint32_t>(std::min<uint64_t>(std::max<uint64_t>(l_ticks, 1), MAX_TIMEOUT_TICKS));
+}
+}
+
+CGpLivenessTracker::CGpLivenessTracker(std::size_t i_capacity, std::chrono::steady_clock::time_point i_now) :
+	capacity(std::min<std::size_t>(i_capacity, NO_ENTRY - NB_LEVELS * NB_SLOTS)),
+	entries(NB_LEVELS * NB_SLOTS + this->capacity),
+	index(),
+	indexMask(0),
+	freeEntries(NO_ENTRY),
+	nbTracked(0),
+	nbOffline(0),
+	nbArmed(0),
+	nbUntracked(0),
+	nbMissedReports(DEFAULT_NB_MISSED_REPORTS),
+	minTimeoutTicks(0),
+	initialTimeoutTicks(0),
+	tick(DEFAULT_TICK),
+	origin(i_now),
+	currentTick(0) {
+	std::size_t l_index_size = 2;
+	while (l_index_size < 2 * this->capacity) {
+		l_index_size <<= 1;
+	}
+	this->index.resize(l_index_size);
+	this->indexMask = l_index_size - 1;
+	this->configure(DEFAULT_NB_MISSED_REPORTS, DEFAULT_MIN_TIMEOUT, DEFAULT_INITIAL_TIMEOUT, DEFAULT_TICK, i_now);
+}
+
+void CGpLivenessTracker::configure(unsigned int i_nb_missed_reports, std::chrono::milliseconds i_min_timeout, std::chrono::milliseconds i_initial_timeout,
+                                   std::chrono::milliseconds i_tick, std::chrono::steady_clock::time_point i_now) {
+	this->tick = std::max(i_tick, std::chrono::milliseconds(1));
+	this->nbMissedReports = std::max(i_nb_missed_reports, 1U);
+	this->minTimeoutTicks = toTicks(i_min_timeout, this->tick);
+	this->initialTimeoutTicks = toTicks(i_initial_timeout, this->tick);
+	this->origin = i_now;
+	this->currentTick = 0;
+	this->forgetAll();
+}
+
+uint32_t CGpLivenessTracker::toTick(std::chrono::steady_clock::time_point i_time) const {
+	if (i_time <= this->origin) {
+		return 0;
+	}
+	return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(i_time - this->origin) / this->tick);
+}
+
+std::chrono::milliseconds CGpLivenessTracker::toDuration(uint64_t i_sixteenths) const {
+	return std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>((i_sixteenths * static_cast<uint64_t>(this->tick.count())) >> PERIOD_FRACTION_BITS));
+}
+
+std::size_t CGpLivenessTracker::hash(uint32_t i_source_id) const {
+	return static_cast<std::size_t>((static_cast<uint64_t>(i_source_id) * 0x9E3779B97F4A7C15ULL) >> 32) & this->indexMask;
+}
+
+std::size_t CGpLivenessTracker::findPosition(uint32_t i_source_id) const {
+	std::size_t l_position = this->hash(i_source_id);
+	while (this->index[l_position] != NO_ENTRY && this->entries[this->index[l_position]].sourceId != i_source_id) {
+		l_position = (l_position + 1) & this->indexMask;	/* The index is never full, as it is at least twice the capacity */
+	}
+	return l_position;
+}
+
+uint32_t CGpLivenessTracker::find(uint32_t i_source_id) const {
+	return this->index[this->findPosition(i_source_id)];
+}
+
+void CGpLivenessTracker::link(uint32_t i_entry) {
+	Entry& l_entry = this->entries[i_entry];
+	std::size_t l_head;
+	if (static_cast<int32_t>(l_entry.deadline - this->currentTick) <= 0) {
+		l_head = this->currentTick & (NB_SLOTS - 1);	/* Due now (while cascading), the current slot of level 0 is processed next */
+	}
+	else {
+		/* The level is given by the highest bit differing between the deadline and the current tick, the last level also holds further deadlines */
+		uint32_t l_differing = l_entry.deadline ^ this->currentTick;
+		std::size_t l_level = 0;
+		while (l_level < NB_LEVELS - 1 && (l_differing >> (SLOT_BITS * (l_level + 1))) != 0) {
+			l_level++;
+		}
+		l_head = l_level * NB_SLOTS + ((l_entry.deadline >> (SLOT_BITS * l_level)) & (NB_SLOTS - 1));
+	}
+	Entry& l_head_entry = this->entries[l_head];
+	l_entry.next = static_cast<uint32_t>(l_head);
+	l_entry.prev = l_head_entry.prev;
+	this->entries[l_head_entry.prev].next = i_entry;
+	l_head_entry.prev = i_entry;
+}
+
+void CGpLivenessTracker::unlink(uint32_t i_entry) {
+	Entry& l_entry = this->entries[i_entry];
+	this->entries[l_entry.prev].next = l_entry.next;
+	this->entries[l_entry.next].prev = l_entry.prev;
+	l_entry.next = i_entry;
+	l_entry.prev = i_entry;
+}
+
+void CGpLivenessTracker::cascade(std::size_t i_level, std::size_t i_slot) {
+	uint32_t l_head = static_cast<uint32_t>(i_level * NB_SLOTS + i_slot);
+	uint32_t l_entry = this->entries[l_head].next;
+	/* Detach the whole list first: far deadlines of the last level may be linked back into this same slot */
+	this->entries[l_head].next = l_head;
+	this->entries[l_head].prev = l_head;
+	while (l_entry != l_head) {
+		uint32_t l_next = this->entries[l_entry].next;
+		this->link(l_entry);
+		l_entry = l_next;
+	}
+}
+
+void CGpLivenessTracker::arm(uint32_t i_entry, uint32_t i_now_tick) {
+	Entry& l_entry = this->entries[i_entry];
+	uint32_t l_timeout = this->initialTimeoutTicks;
+	if (l_entry.period != 0) {
+		uint64_t l_missed = (static_cast<uint64_t>(l_entry.period) * this->nbMissedReports + (1U << PERIOD_FRACTION_BITS) - 1) >> PERIOD_FRACTION_BITS;
+		l_timeout = static_cast<uint32_t>(std::min<uint64_t>(std::max<uint64_t>(l_missed, this->minTimeoutTicks), MAX_TIMEOUT_TICKS));
+	}
+	l_entry.deadline = i_now_tick + l_timeout;
+	if (static_cast<int32_t>(l_entry.deadline - this->currentTick) <= 0) {
+		l_entry.deadline = this->currentTick + 1;	/* The wheel is behind the reception time, ticks already processed cannot expire */
+	}
+	if (l_entry.next == i_entry) {
+		this->nbArmed++;
+	}
+	else {
+		this->unlink(i_entry);
+	}
+	this->link(i_entry);
+}
+
+CGpLivenessReport CGpLivenessTracker::makeReport(const Entry& i_entry, bool i_offline, uint32_t i_silence) const {
+	return { i_entry.sourceId, i_offline, this->toDuration(i_entry.period), this->toDuration(static_cast<uint64_t>(i_silence) << PERIOD_FRACTION_BITS) };
+}
+
+bool CGpLivenessTracker::heard(uint32_t i_source_id, std::chrono::steady_clock::time_point i_now, CGpLivenessReport& o_report) {
+	uint32_t l_now_tick = this->toTick(i_now);
+	std::size_t l_position = this->findPosition(i_source_id);
+	uint32_t l_index = this->index[l_position];
+	if (l_index == NO_ENTRY) {
+		if (this->freeEntries == NO_ENTRY) {
+			this->nbUntracked++;
+			return false;
+		}
+		l_index = this->freeEntries;
+		Entry& l_entry = this->entries[l_index];
+		this->freeEntries = l_entry.next;
+		l_entry = { i_source_id, l_index, l_index, 0, l_now_tick, 0, false };
+		this->index[l_position] = l_index;
+		this->nbTracked++;
+		this->arm(l_index, l_now_tick);
+		return false;
+	}
+
+	Entry& l_entry = this->entries[l_index];
+	uint32_t l_interval = l_now_tick - l_entry.lastHeard;
+	if (l_interval == 0 && !l_entry.offline) {
+		return false;	/* Already heard during this tick, the deadline would not change */
+	}
+	if (l_interval != 0) {
+		uint64_t l_sample = static_cast<uint64_t>(l_interval) << PERIOD_FRACTION_BITS;
+		if (l_entry.period == 0) {
+			l_entry.period = static_cast<uint32_t>(std::min<uint64_t>(l_sample, NO_ENTRY));
+		}
+		else {
+			/* Reports may have been missed, the interval then spans several periods (same estimator as CGpDownlinkQueue) */
+			uint64_t l_nb_periods = std::max<uint64_t>((l_sample + l_entry.period / 2) / l_entry.period, 1);
+			l_entry.period = static_cast<uint32_t>((3 * static_cast<uint64_t>(l_entry.period) + l_sample / l_nb_periods) / 4);
+		}
+	}
+	bool l_recovered = l_entry.offline;
+	if (l_recovered) {
+		l_entry.offline = false;
+		this->nbOffline--;
+		o_report = this->makeReport(l_entry, false, l_interval);
+	}
+	l_entry.lastHeard = l_now_tick;
+	this->arm(l_index, l_now_tick);
+	return l_recovered;
+}
+
+void CGpLivenessTracker::expire(std::chrono::steady_clock::time_point i_now, std::vector<CGpLivenessReport>& o_reports) {
+	uint32_t l_target = this->toTick(i_now);
+	if (this->nbArmed == 0) {
+		this->currentTick = l_target;	/* Nothing to expire, no need to walk the ticks */
+		return;
+	}
+	while (static_cast<int32_t>(l_target - this->currentTick) > 0) {
+		this->currentTick++;
+		std::size_t l_slot = this->currentTick & (NB_SLOTS - 1);
+		if (l_slot == 0) {
+			/* Level 0 wrapped around, bring down the deadlines of the next slot of level 1, and so on while the upper levels wrap */
+			for (std::size_t l_level = 1; l_level < NB_LEVELS; l_level++) {
+				std::size_t l_upper_slot = (this->currentTick >> (SLOT_BITS * l_level)) & (NB_SLOTS - 1);
+				this->cascade(l_level, l_upper_slot);
+				if (l_upper_slot != 0) {
+					break;
+				}
+			}
+		}
+		while (this->entries[l_slot].next != l_slot) {
+			uint32_t l_index = this->entries[l_slot].next;
+			Entry& l_entry = this->entries[l_index];
+			this->unlink(l_index);
+			this->nbArmed--;
+			l_entry.offline = true;
+			this->nbOffline++;
+			o_reports.push_back(this->makeReport(l_entry, true, this->currentTick - l_entry.lastHeard));
+		}
+	}
+}
+
+bool CGpLivenessTracker::forget(uint32_t i_source_id) {
+	std::size_t l_position = this->findPosition(i_source_id);
+	uint32_t l_index = this->index[l_position];
+	if (l_index == NO_ENTRY) {
+		return false;
+	}
+	Entry& l_entry = this->entries[l_index];
+	if (l_entry.next != l_index) {
+		this->unlink(l_index);
+		this->nbArmed--;
+	}
+	if (l_entry.offline) {
+		this->nbOffline--;
+	}
+	l_entry.next = this->freeEntries;
+	this->freeEntries = l_index;
+	this->nbTracked--;
+
+	/* Backward shift deletion: move up the following entries that would not be found anymore behind the hole */
+	std::size_t l_hole = l_position;
+	std::size_t l_next = l_position;
+	while (true) {
+		l_next = (l_next + 1) & this->indexMask;
+		uint32_t l_moved = this->index[l_next];
+		if (l_moved == NO_ENTRY) {
+			break;
+		}
+		std::size_t l_home = this->hash(this->entries[l_moved].sourceId);
+		if (((l_next - l_home) & this->indexMask) >= ((l_next - l_hole) & this->indexMask)) {
+			this->index[l_hole] = l_moved;
+			l_hole = l_next;
+		}
+	}
+	this->index[l_hole] = NO_ENTRY;
+	return true;
+}
+
+void CGpLivenessTracker::forgetAll() {
+	for (uint32_t i = 0; i < NB_LEVELS * NB_SLOTS; i++) {
+		this->entries[i] = { 0, i, i, 0, 0, 0, false };
+	}
+	this->freeEntries = NO_ENTRY;
+	for (std::size_t i = this->entries.size(); i > NB_LEVELS * NB_SLOTS; i--) {
+		this->entries[i - 1] = { 0, this->freeEntries, static_cast<uint32_t>(i - 1), 0, 0, 0, false };
+		this->freeEntries = static_cast<uint32_t>(i - 1);
+	}
+	std::fill(this->index.begin(), this->index.end(), NO_ENTRY);
+	this->nbTracked = 0;
+	this->nbOffline = 0;
+	this->nbArmed = 0;
+}
+
+bool CGpLivenessTracker::isOnline(uint32_t i_source_id) const {
+	uint32_t l_index = this->find(i_source_id);
+	return (l_index != NO_ENTRY && !this->entries[l_index].offline);
+}
+
+std::chrono::milliseconds CGpLivenessTracker::getPeriod(uint32_t i_source_id) const {
+	uint32_t l_index = this->find(i_source_id);
+	if (l_index == NO_ENTRY) {
+		return std::chrono::milliseconds(0);
+	}
+	return this->toDuration(this->entries[l_index].period);
+}
+
+bool CGpLivenessTracker::hasDeadlines() const {
+	return (this->nbArmed != 0);
+}
+
+std::chrono::milliseconds CGpLivenessTracker::getTick() const {
+	return this->tick;
+}
+
+std::size_t CGpLivenessTracker::getNbTracked() const {
+	return this->nbTracked;
+}
+
+std::size_t CGpLivenessTracker::getNbOffline() const {
+	return this->nbOffline;
+}
+
+std::size_t CGpLivenessTracker::getNbUntracked() const {
+	return this->nbUntracked;
+}
+
+std::size_t CGpLivenessTracker::getBytesPerDevice() {
+	return sizeof(Entry) + 2 * sizeof(uint32_t);	/* The entry, and the index (twice the capacity) */
+}
@@ -0,0 +1,228 @@
+/**
+ * @file green-power-liveness.h
+ *
+ * @brief Detection of GP devices that stop reporting, using a hierarchical timing wheel of per-device deadlines
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <chrono>
+
+#include <ezsp/gpd.h>
+
+namespace NSEZSP {
+
+/**
+ * @brief Tracks when each GP device is expected to be heard again, and reports the devices that miss their deadline
+ *
+ * Each frame from a device re-arms its deadline to a few times its reporting period, learned from the intervals between its frames.
+ * Deadlines are kept in a hierarchical timing wheel of NB_LEVELS levels of NB_SLOTS slots, indexed by tick: re-arming a deadline and
+ * expiring it are O(1), and each deadline is moved to a lower level at most NB_LEVELS - 1 times before it expires. No periodic scan of
+ * the devices is ever needed.
+ *
+ * Devices are stored in a preallocated array, slots are intrusive doubly linked lists of indexes into this array, and source IDs are
+ * found with an open addressing index. A device costs getBytesPerDevice() bytes, whatever the number of devices.
+ *
+ * This class is not thread-safe, the sink protects it with its own mutex.
+ */
+class CGpLivenessTracker {
+public:
+	static constexpr unsigned int SLOT_BITS = 6;	/*!< log2 of the number of slots per level */
+	static constexpr std::size_t NB_SLOTS = 1U << SLOT_BITS;	/*!< Number of slots per level of the timing wheel */
+	static constexpr std::size_t NB_LEVELS = 4;	/*!< Number of levels of the timing wheel (deadlines further than NB_SLOTS^NB_LEVELS ticks wrap around the last level) */
+	static constexpr unsigned int DEFAULT_NB_MISSED_REPORTS = 3;	/*!< Default number of reporting periods without any frame before a device is considered offline */
+	static constexpr std::chrono::milliseconds DEFAULT_MIN_TIMEOUT = std::chrono::milliseconds(60000);	/*!< Default shortest silence before a device is considered offline */
+	static constexpr std::chrono::milliseconds DEFAULT_INITIAL_TIMEOUT = std::chrono::milliseconds(3600000);	/*!< Default silence before a device heard only once is considered offline */
+	static constexpr std::chrono::milliseconds DEFAULT_TICK = std::chrono::milliseconds(1000);	/*!< Default resolution of the deadlines */
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param i_capacity The maximum number of devices tracked (all storage is reserved here)
+	 * @param i_now The current time, origin of the ticks
+	 */
+	CGpLivenessTracker(std::size_t i_capacity, std::chrono::steady_clock::time_point i_now);
+
+	/**
+	 * @brief Change the liveness parameters, forgetting all devices
+	 *
+	 * @param i_nb_missed_reports The number of reporting periods without any frame before a device is considered offline
+	 * @param i_min_timeout The shortest silence before a device is considered offline, whatever its period
+	 * @param i_initial_timeout The silence before a device is considered offline, as long as it was only heard once (its period is unknown)
+	 * @param i_tick The resolution of the deadlines, expire() should be invoked at this interval
+	 * @param i_now The current time, origin of the ticks
+	 */
+	void configure(unsigned int i_nb_missed_reports, std::chrono::milliseconds i_min_timeout, std::chrono::milliseconds i_initial_timeout,
+	               std::chrono::milliseconds i_tick, std::chrono::steady_clock::time_point i_now);
+
+	/**
+	 * @brief Record a valid frame from a device, learning its period and re-arming its deadline
+	 *
+	 * @param i_source_id The source ID of the device
+	 * @param i_now The reception time of the frame
+	 * @param[out] o_report The recovery of the device, if it was offline
+	 *
+	 * @return true if the device was offline, and @p o_report has been filled
+	 */
+	bool heard(uint32_t i_source_id, std::chrono::steady_clock::time_point i_now, CGpLivenessReport& o_report);
+
+	/**
+	 * @brief Advance the timing wheel, reporting the devices whose deadline has passed
+	 *
+	 * Devices reported offline are not tracked until heard() is invoked for them again.
+	 *
+	 * @param i_now The current time
+	 * @param[out] o_reports The devices that went offline are appended here
+	 */
+	void expire(std::chrono::steady_clock::time_point i_now, std::vector<CGpLivenessReport>& o_reports);
+
+	/**
+	 * @brief Stop tracking a device
+	 *
+	 * @param i_source_id The source ID of the device
+	 *
+	 * @return false if the device was not tracked
+	 */
+	bool forget(uint32_t i_source_id);
+
+	/**
+	 * @brief Stop tracking all devices
+	 */
+	void forgetAll();
+
+	/**
+	 * @brief Check whether a device is tracked and not offline
+	 *
+	 * @param i_source_id The source ID of the device
+	 */
+	bool isOnline(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Get the reporting period learned for a device
+	 *
+	 * @param i_source_id The source ID of the device
+	 *
+	 * @return The period, or 0 if the device is not tracked or was heard only once
+	 */
+	std::chrono::milliseconds getPeriod(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Check whether some deadlines are armed, that is whether expire() needs to be invoked
+	 */
+	bool hasDeadlines() const;
+
+	/**
+	 * @brief Get the resolution of the deadlines
+	 */
+	std::chrono::milliseconds getTick() const;
+
+	/**
+	 * @brief Get the number of tracked devices (online or offline)
+	 */
+	std::size_t getNbTracked() const;
+
+	/**
+	 * @brief Get the number of tracked devices that are offline
+	 */
+	std::size_t getNbOffline() const;
+
+	/**
+	 * @brief Get the number of frames from devices that could not be tracked, because the capacity was reached
+	 */
+	std::size_t getNbUntracked() const;
+
+	/**
+	 * @brief Get the memory used per device of capacity
+	 */
+	static std::size_t getBytesPerDevice();
+
+private:
+	static constexpr uint32_t NO_ENTRY = 0xFFFFFFFFU;	/*!< Index meaning "no entry" */
+	static constexpr unsigned int PERIOD_FRACTION_BITS = 4;	/*!< Periods are stored in 1/16 of tick */
+
+	/**
+	 * @brief A device, or the list head of a slot of the timing wheel
+	 */
+	struct Entry {
+		uint32_t sourceId;	/*!< The source ID of the device */
+		uint32_t next;	/*!< Next entry in the slot list (or next free entry), this entry's own index if it is not in any slot */
+		uint32_t prev;	/*!< Previous entry in the slot list, this entry's own index if it is not in any slot */
+		uint32_t deadline;	/*!< The tick at which the device is considered offline */
+		uint32_t lastHeard;	/*!< The tick at which the device was last heard */
+		uint32_t period;	/*!< The learned reporting period, in 1/16 of tick (0 if unknown) */
+		bool offline;	/*!< Has the device missed its deadline? */
+	};
+
+	/**
+	 * @brief Convert a time to a tick number (ticks wrap around, they are compared by their difference)
+	 */
+	uint32_t toTick(std::chrono::steady_clock::time_point i_time) const;
+
+	/**
+	 * @brief Convert a number of 1/16 of tick to a duration
+	 */
+	std::chrono::milliseconds toDuration(uint64_t i_sixteenths) const;
+
+	/**
+	 * @brief Get the home position of a source ID in the index
+	 */
+	std::size_t hash(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Get the position of a source ID in the index, or the free position where it would be stored
+	 */
+	std::size_t findPosition(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Get the entry of a source ID
+	 *
+	 * @return The index of the entry, or NO_ENTRY if the device is not tracked
+	 */
+	uint32_t find(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Set the deadline of an entry and add it into the slot of the timing wheel matching its deadline
+	 */
+	void arm(uint32_t i_entry, uint32_t i_now_tick);
+
+	/**
+	 * @brief Add an entry into the slot of the timing wheel matching its deadline, relatively to the current tick
+	 */
+	void link(uint32_t i_entry);
+
+	/**
+	 * @brief Remove an entry from its slot of the timing wheel
+	 */
+	void unlink(uint32_t i_entry);
+
+	/**
+	 * @brief Move the entries of a slot to the slots matching their deadline, relatively to the current tick (in lower levels)
+	 */
+	void cascade(std::size_t i_level, std::size_t i_slot);
+
+	/**
+	 * @brief Build the report of an entry
+	 */
+	CGpLivenessReport makeReport(const Entry& i_entry, bool i_offline, uint32_t i_silence) const;
+
+	std::size_t capacity;	/*!< The maximum number of tracked devices */
+	std::vector<Entry> entries;	/*!< The NB_LEVELS * NB_SLOTS slot list heads, followed by the devices */
+	std::vector<uint32_t> index;	/*!< Open addressing index of the devices by source ID (linear probing, at least twice the capacity) */
+	std::size_t indexMask;	/*!< Size of the index (a power of two) minus 1 */
+	uint32_t freeEntries;	/*!< First entry of the list of unused device entries */
+	std::size_t nbTracked;	/*!< Number of tracked devices */
+	std::size_t nbOffline;	/*!< Number of tracked devices that are offline */
+	std::size_t nbArmed;	/*!< Number of devices in the timing wheel */
+	std::size_t nbUntracked;	/*!< Number of frames from devices that could not be tracked */
+	unsigned int nbMissedReports;	/*!< Number of periods without any frame before a device is offline */
+	uint32_t minTimeoutTicks;	/*!< Shortest silence before a device is offline */
+	uint32_t initialTimeoutTicks;	/*!< Silence before a device heard once is offline */
+	std::chrono::milliseconds tick;	/*!< Duration of a tick */
+	std::chrono::steady_clock::time_point origin;	/*!< Time of tick 0 */
+	uint32_t currentTick;	/*!< The last tick processed by expire() */
+};
+
+} // namespace NSEZSP
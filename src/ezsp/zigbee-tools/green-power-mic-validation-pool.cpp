@@ -0,0 +1,135 @@
+/**
+ * @file green-power-mic-validation-pool.cpp
+ *
+ * @brief Worker threads validating green power MICs on behalf of all sinks of the process
+ */
+
+#include "green-power-mic-validation-pool.h"
+
+#ifdef USE_CPPTHREADS
+#include <algorithm>	// For std::min()
+
+using NSEZSP::CGpMicValidationPool;
+
+constexpr std::size_t CGpMicValidationPool::MAX_QUEUED_TASKS;
+
+namespace {
+std::mutex sharedPoolMutex;	/* Protects sharedPool */
+std::shared_ptr<CGpMicValidationPool> sharedPool;
+}
+
+CGpMicValidationPool::CGpMicValidationPool(unsigned int i_nb_workers) :
+	mutex(),
+	taskAvailable(),
+	tasks(MAX_QUEUED_TASKS),
+	firstTask(0),
+	nbTasks(0),
+	stopping(false),
+	workers() {
+	this->workers.reserve(i_nb_workers);
+	for (unsigned int i = 0; i < i_nb_workers; i++) {
+		this->workers.emplace_back(&CGpMicValidationPool::workerLoop, this);
+	}
+}
+
+CGpMicValidationPool::~CGpMicValidationPool() {
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->stopping = true;
+	}
+	this->taskAvailable.notify_all();
+	for (std::thread& worker : this->workers) {
+		worker.join();
+	}
+}
+
+unsigned int CGpMicValidationPool::getNbWorkers() const {
+	return static_cast<unsigned int>(this->workers.size());
+}
+
+void CGpMicValidationPool::runTask(std::unique_lock<std::mutex>& lock) {
+	Task task = this->tasks[this->firstTask];
+	this->firstTask = (this->firstTask + 1) % MAX_QUEUED_TASKS;
+	this->nbTasks--;
+	lock.unlock();
+	CGpFrame::validateMICBatch(task.frames, task.keys, task.count, task.results);
+	lock.lock();
+	if (--task.completion->nbPending == 0) {
+		task.completion->done.notify_all();	/* Under the lock: the caller cannot destroy the completion before we are done with it */
+	}
+}
+
+void CGpMicValidationPool::workerLoop() {
+	std::unique_lock<std::mutex> lock(this->mutex);
+	while (true) {
+		this->taskAvailable.wait(lock, [this]() {
+			return (this->stopping || this->nbTasks > 0);
+		});
+		if (this->nbTasks == 0) {
+			return;	/* Stopping, and all tasks have been run */
+		}
+		this->runTask(lock);
+	}
+}
+
+void CGpMicValidationPool::validateMICs(const CGpFrame* const frames[], const NSSPI::IAes::ExpandedKey* const keys[], std::size_t count, bool o_results[]) {
+	const std::size_t chunkSize = CGpFrame::MIC_BATCH_LANES;
+	if (count <= chunkSize || this->workers.empty()) {
+		CGpFrame::validateMICBatch(frames, keys, count, o_results);	/* Nothing to share */
+		return;
+	}
+	Completion completion;
+	completion.nbPending = 0;
+	std::size_t next = chunkSize;	/* The caller validates the first chunk itself */
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		for (; next < count && this->nbTasks < MAX_QUEUED_TASKS; next += chunkSize) {
+			Task& task = this->tasks[(this->firstTask + this->nbTasks) % MAX_QUEUED_TASKS];
+			task.frames = frames + next;
+			task.keys = keys + next;
+			task.count = std::min(chunkSize, count - next);
+			task.results = o_results + next;
+			task.completion = &completion;
+			this->nbTasks++;
+			completion.nbPending++;
+		}
+	}
+	if (completion.nbPending > 1) {
+		this->taskAvailable.notify_all();
+	}
+	else if (completion.nbPending == 1) {
+		this->taskAvailable.notify_one();
+	}
+	CGpFrame::validateMICBatch(frames, keys, chunkSize, o_results);
+	if (next < count) {
+		CGpFrame::validateMICBatch(frames + next, keys + next, count - next, o_results + next);	/* The ring is full, validate the remaining chunks too */
+	}
+
+	std::unique_lock<std::mutex> lock(this->mutex);
+	while (completion.nbPending > 0) {
+		if (this->nbTasks > 0) {
+			this->runTask(lock);	/* Help rather than sleep (the task may belong to another caller) */
+		}
+		else {
+			completion.done.wait(lock);
+		}
+	}
+}
+
+void CGpMicValidationPool::setShared(unsigned int i_nb_workers) {
+	std::shared_ptr<CGpMicValidationPool> pool;
+	if (i_nb_workers > 0) {
+		pool = std::make_shared<CGpMicValidationPool>(i_nb_workers);
+	}
+	{
+		std::lock_guard<std::mutex> lock(sharedPoolMutex);
+		sharedPool.swap(pool);
+	}
+	/* The previous pool (if any) is destroyed here, or by the last sink still using it */
+}
+
+std::shared_ptr<CGpMicValidationPool> CGpMicValidationPool::getShared() {
+	std::lock_guard<std::mutex> lock(sharedPoolMutex);
+	return sharedPool;
+}
+#endif	// USE_CPPTHREADS
@@ -0,0 +1,134 @@
+/**
+ * @file green-power-mic-validation-pool.h
+ *
+ * @brief Worker threads validating green power MICs on behalf of all sinks of the process
+ */
+
+#pragma once
+
+#include <ezsp/export.h>
+
+#ifdef USE_CPPTHREADS
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+#include "ezsp/zbmessage/green-power-frame.h"
+#include "spi/IAes.h"
+
+namespace NSEZSP {
+
+/**
+ * @brief Pool of threads validating the MICs of green power frames
+ *
+ * When several adapters are driven from the same process, each sink validates the MICs of its incoming frames on its own RX thread.
+ * A burst of frames on one adapter can then only use one core. Sinks may instead hand their frames over to a pool shared by the
+ * whole process (see getShared()): validateMICs() splits the frames into chunks of CGpFrame::MIC_BATCH_LANES frames, that are
+ * validated by the workers in parallel, and by the calling thread itself while it waits.
+ *
+ * validateMICs() only returns once all results are available, in the order of the frames that were submitted. The caller thus
+ * processes frames in their reception order, and frames from a given source ID are never reordered, whatever the number of workers.
+ *
+ * Tasks are queued in a ring allocated once, at construction: submitting frames does not allocate. If the ring is full, the
+ * remaining chunks are validated by the calling thread.
+ */
+class CGpMicValidationPool {
+public:
+	static constexpr std::size_t MAX_QUEUED_TASKS = 256;	/*!< Capacity of the task ring, shared by all callers */
+
+	/**
+	 * @brief Start the worker threads
+	 *
+	 * @param i_nb_workers The number of worker threads
+	 */
+	explicit CGpMicValidationPool(unsigned int i_nb_workers);
+
+	/**
+	 * @brief Stop and join the worker threads
+	 */
+	~CGpMicValidationPool();
+
+	CGpMicValidationPool(const CGpMicValidationPool& other) = delete;
+	CGpMicValidationPool& operator=(const CGpMicValidationPool& other) = delete;
+
+	/**
+	 * @brief Get the number of worker threads
+	 *
+	 * @return The number of worker threads
+	 */
+	unsigned int getNbWorkers() const;
+
+	/**
+	 * @brief Validate the MIC of several frames, each one against its own key schedule, using the worker threads
+	 *
+	 * Results are identical to CGpFrame::validateMICBatch(). This method can be invoked concurrently from several threads.
+	 *
+	 * @param[in] frames The frames to validate (they must not be modified until this method returns)
+	 * @param[in] keys The key schedules to use, one per frame (a nullptr key leads to a failed validation for the corresponding frame)
+	 * @param[in] count The number of frames (and keys)
+	 * @param[out] o_results The validation results, one per frame
+	 */
+	void validateMICs(const CGpFrame* const frames[], const NSSPI::IAes::ExpandedKey* const keys[], std::size_t count, bool o_results[]);
+
+	/**
+	 * @brief Replace the pool shared by all sinks of the process
+	 *
+	 * Sinks that are currently validating frames with the previous pool keep using it until they are done.
+	 *
+	 * @param i_nb_workers The number of worker threads of the new pool, 0 to stop using a shared pool
+	 */
+	static void setShared(unsigned int i_nb_workers);
+
+	/**
+	 * @brief Get the pool shared by all sinks of the process
+	 *
+	 * @return The pool, or nullptr if MICs should be validated by the calling thread
+	 */
+	static std::shared_ptr<CGpMicValidationPool> getShared();
+
+private:
+	/**
+	 * @brief Progress of one invocation of validateMICs()
+	 */
+	struct Completion {
+		std::size_t nbPending;	/*!< The number of chunks queued and not yet validated */
+		std::condition_variable done;	/*!< Notified when nbPending drops to 0 */
+	};
+
+	/**
+	 * @brief A chunk of frames to validate
+	 */
+	struct Task {
+		const CGpFrame* const* frames;	/*!< The first frame of the chunk */
+		const NSSPI::IAes::ExpandedKey* const* keys;	/*!< The key schedule of the first frame of the chunk */
+		std::size_t count;	/*!< The number of frames in the chunk */
+		bool* results;	/*!< The result of the first frame of the chunk */
+		Completion* completion;	/*!< The invocation of validateMICs() this chunk belongs to */
+	};
+
+	/**
+	 * @brief Dequeue and run the oldest task
+	 *
+	 * @param lock A lock on mutex, released while the task runs (there must be at least one queued task)
+	 */
+	void runTask(std::unique_lock<std::mutex>& lock);
+
+	/**
+	 * @brief Main loop of the worker threads
+	 */
+	void workerLoop();
+
+	std::mutex mutex;	/*!< Protects all members below, and the Completion objects of the pending invocations */
+	std::condition_variable taskAvailable;	/*!< Notified when tasks are queued, or when the pool stops */
+	std::vector<Task> tasks;	/*!< The task ring */
+	std::size_t firstTask;	/*!< The index of the oldest task in the ring */
+	std::size_t nbTasks;	/*!< The number of tasks in the ring */
+	bool stopping;	/*!< Worker threads should exit */
+	std::vector<std::thread> workers;	/*!< The worker threads */
+};
+
+} // namespace NSEZSP
+#endif	// USE_CPPTHREADS
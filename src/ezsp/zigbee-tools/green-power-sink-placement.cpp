@@ -0,0 +1,282 @@
+/**
+ * @file green-power-sink-placement.cpp
+ *
+ * @brief Selection of the green power devices that are validated by the adapter's sink table rather than by the host
+ */
+
+#include <algorithm>	// For std::partial_sort(), std::min(), std::max()
+
+#include "green-power-sink-placement.h"
+
+using NSEZSP::CGpSinkTablePlacement;
+
+constexpr uint32_t CGpSinkTablePlacement::PROMOTION_MIN_SCORE;
+constexpr unsigned int CGpSinkTablePlacement::HYSTERESIS_PERCENT;
+constexpr std::size_t CGpSinkTablePlacement::MAX_PROMOTIONS_PER_EPOCH;
+
+namespace {
+constexpr std::size_t MIN_SLOTS = 16;
+}
+
+CGpSinkTablePlacement::CGpSinkTablePlacement() :
+	slots(),
+	spareSlots(),
+	candidates(),
+	residents(),
+	nbTracked(0),
+	ncpCapacity(0),
+	nbNcpEntries(0),
+	epoch(0) {
+}
+
+void CGpSinkTablePlacement::reset(std::size_t i_max_devices, std::size_t i_ncp_capacity) {
+	this->nbTracked = 0;
+	this->nbNcpEntries = 0;
+	this->ncpCapacity = i_ncp_capacity;
+	if (i_ncp_capacity == 0) {
+		/* Placement is disabled, release the storage */
+		std::vector<Entry>().swap(this->slots);
+		std::vector<Entry>().swap(this->spareSlots);
+		std::vector<Candidate>().swap(this->candidates);
+		std::vector<Candidate>().swap(this->residents);
+		return;
+	}
+	std::size_t nbSlots = MIN_SLOTS;
+	while (nbSlots < 2 * i_max_devices) {	/* Maximum load factor of 50% */
+		nbSlots *= 2;
+	}
+	Entry empty = { EMPTY_SLOT, 0, 0, 0, Residency::HOST };
+	this->slots.assign(nbSlots, empty);
+	this->spareSlots.assign(nbSlots, empty);
+	this->candidates.reserve(nbSlots);
+	this->residents.reserve(nbSlots);
+}
+
+bool CGpSinkTablePlacement::isEnabled() const {
+	return (this->ncpCapacity != 0);
+}
+
+std::size_t CGpSinkTablePlacement::getNcpCapacity() const {
+	return this->ncpCapacity;
+}
+
+std::size_t CGpSinkTablePlacement::findSlot(uint32_t i_source_id) const {
+	/* Fibonacci hashing to spread sequential source IDs, the top bits select the home slot (the number of slots is a power of 2) */
+	std::size_t mask = this->slots.size() - 1;
+	std::size_t slot = static_cast<std::size_t>((static_cast<uint64_t>(i_source_id * 0x9e3779b1U) * this->slots.size()) >> 32);
+	while (this->slots[slot].sourceId != i_source_id && this->slots[slot].sourceId != EMPTY_SLOT) {
+		slot = (slot + 1) & mask;
+	}
+	return slot;
+}
+
+void CGpSinkTablePlacement::recordFrame(uint32_t i_source_id) {
+	if (this->slots.empty() || i_source_id == EMPTY_SLOT) {
+		return;
+	}
+	std::size_t slot = this->findSlot(i_source_id);
+	if (this->slots[slot].sourceId == EMPTY_SLOT) {
+		if (2 * (this->nbTracked + 1) > this->slots.size()) {
+#ifdef USE_STATIC_ALLOCATION
+			return;	/* Table full, this device will only be tracked once idle devices have been forgotten */
+#else
+			this->rehash(2 * this->slots.size());
+			slot = this->findSlot(i_source_id);
+#endif
+		}
+		this->slots[slot] = { i_source_id, 0, 0, this->epoch, Residency::HOST };
+		this->nbTracked++;
+	}
+	Entry& entry = this->slots[slot];
+	if (entry.hits != UINT32_MAX) {
+		entry.hits++;
+	}
+	entry.lastSeenEpoch = this->epoch;
+}
+
+bool CGpSinkTablePlacement::isNcpResident(uint32_t i_source_id) const {
+	return (this->getResidency(i_source_id) == Residency::NCP);
+}
+
+CGpSinkTablePlacement::Residency CGpSinkTablePlacement::getResidency(uint32_t i_source_id) const {
+	if (this->nbNcpEntries == 0) {
+		return Residency::HOST;	/* Nothing in the adapter's sink table: no need to probe */
+	}
+	return this->slots[this->findSlot(i_source_id)].residency;	/* Empty slots are Residency::HOST */
+}
+
+uint32_t CGpSinkTablePlacement::getScore(uint32_t i_source_id) const {
+	if (this->slots.empty()) {
+		return 0;
+	}
+	return this->slots[this->findSlot(i_source_id)].score;
+}
+
+std::size_t CGpSinkTablePlacement::getNbNcpEntries() const {
+	return this->nbNcpEntries;
+}
+
+void CGpSinkTablePlacement::setResidency(Entry& entry, Residency residency) {
+	bool wasInNcp = (entry.residency != Residency::HOST);
+	bool isInNcp = (residency != Residency::HOST);
+	if (wasInNcp && !isInNcp) {
+		this->nbNcpEntries--;
+	}
+	else if (!wasInNcp && isInNcp) {
+		this->nbNcpEntries++;
+	}
+	entry.residency = residency;
+}
+
+void CGpSinkTablePlacement::endEpoch(std::vector<uint32_t>& o_demotions, std::vector<uint32_t>& o_promotions) {
+	if (this->slots.empty()) {
+		return;
+	}
+	this->epoch++;
+	this->candidates.clear();
+	this->residents.clear();
+	for (std::size_t slot = 0; slot < this->slots.size(); slot++) {
+		Entry& entry = this->slots[slot];
+		if (entry.sourceId == EMPTY_SLOT) {
+			continue;
+		}
+		/* Exponential decay: the frames of the epoch that just ended weigh as much as all previous epochs together */
+		uint32_t decayed = entry.score >> 1;
+		entry.score = (entry.hits > UINT32_MAX - decayed) ? UINT32_MAX : decayed + entry.hits;
+		entry.hits = 0;
+		Candidate candidate = { entry.score, static_cast<uint16_t>(this->epoch - entry.lastSeenEpoch), slot };
+		if (entry.residency == Residency::HOST && entry.score >= PROMOTION_MIN_SCORE) {
+			this->candidates.push_back(candidate);
+		}
+		else if (entry.residency == Residency::NCP) {
+			this->residents.push_back(candidate);
+		}
+	}
+
+	/* Only the few most active candidates and least active residents can move during this epoch */
+	std::size_t nbCandidates = std::min(this->candidates.size(), MAX_PROMOTIONS_PER_EPOCH);
+	std::size_t nbVictims = std::min(this->residents.size(), MAX_PROMOTIONS_PER_EPOCH);
+	std::partial_sort(this->candidates.begin(), this->candidates.begin() + nbCandidates, this->candidates.end(),
+	[](const Candidate& a, const Candidate& b) {
+		return (a.score != b.score) ? (a.score > b.score) : (a.age < b.age);
+	});
+	std::partial_sort(this->residents.begin(), this->residents.begin() + nbVictims, this->residents.end(),
+	[](const Candidate& a, const Candidate& b) {
+		return (a.score != b.score) ? (a.score < b.score) : (a.age > b.age);	/* Least recently seen first amongst equally active residents */
+	});
+
+	std::size_t nbFree = (this->ncpCapacity > this->nbNcpEntries) ? this->ncpCapacity - this->nbNcpEntries : 0;
+	std::size_t victim = 0;
+	for (std::size_t index = 0; index < nbCandidates; index++) {
+		const Candidate& candidate = this->candidates[index];
+		if (nbFree > 0) {
+			nbFree--;
+		}
+		else if (victim < nbVictims
+		         && static_cast<uint64_t>(candidate.score) * 100 > static_cast<uint64_t>(this->residents[victim].score) * (100 + HYSTERESIS_PERCENT)) {
+			Entry& evicted = this->slots[this->residents[victim].slot];
+			this->setResidency(evicted, Residency::DEMOTING);
+			o_demotions.push_back(evicted.sourceId);
+			victim++;
+		}
+		else {
+			break;	/* Candidates are sorted by decreasing score and victims by increasing score: no further candidate can win a place */
+		}
+		Entry& promoted = this->slots[candidate.slot];
+		this->setResidency(promoted, Residency::PROMOTING);
+		o_promotions.push_back(promoted.sourceId);
+	}
+
+	this->rehash(this->slots.size());	/* Forget devices that have been idle long enough for their score to drop to 0 */
+}
+
+void CGpSinkTablePlacement::rehash(std::size_t nbSlots) {
+	Entry empty = { EMPTY_SLOT, 0, 0, 0, Residency::HOST };
+	if (this->spareSlots.size() != nbSlots) {
+		this->spareSlots.assign(nbSlots, empty);
+	}
+	else {
+		std::fill(this->spareSlots.begin(), this->spareSlots.end(), empty);
+	}
+	this->slots.swap(this->spareSlots);
+	this->nbTracked = 0;
+	for (const Entry& entry : this->spareSlots) {
+		if (entry.sourceId == EMPTY_SLOT
+		        || (entry.residency == Residency::HOST && entry.score == 0 && entry.hits == 0)) {
+			continue;
+		}
+		this->slots[this->findSlot(entry.sourceId)] = entry;
+		this->nbTracked++;
+	}
+	if (this->candidates.capacity() < nbSlots) {
+		this->candidates.reserve(nbSlots);
+		this->residents.reserve(nbSlots);
+	}
+}
+
+bool CGpSinkTablePlacement::promotionDone(uint32_t i_source_id, bool i_success) {
+	if (this->slots.empty()) {
+		return false;
+	}
+	Entry& entry = this->slots[this->findSlot(i_source_id)];
+	if (entry.sourceId == EMPTY_SLOT || entry.residency != Residency::PROMOTING) {
+		return false;	/* Forgotten in the meantime */
+	}
+	this->setResidency(entry, i_success ? Residency::NCP : Residency::HOST);
+	return true;
+}
+
+void CGpSinkTablePlacement::demotionDone(uint32_t i_source_id) {
+	if (this->slots.empty()) {
+		return;
+	}
+	Entry& entry = this->slots[this->findSlot(i_source_id)];
+	if (entry.sourceId != EMPTY_SLOT && entry.residency == Residency::DEMOTING) {
+		this->setResidency(entry, Residency::HOST);
+	}
+}
+
+void CGpSinkTablePlacement::ncpTableFull() {
+	/* Devices still being promoted do not occupy an entry yet (the adapter may also hold entries that we did not create, eg: commissioned devices) */
+	std::size_t nbOccupied = 0;
+	for (const Entry& entry : this->slots) {
+		if (entry.sourceId != EMPTY_SLOT && (entry.residency == Residency::NCP || entry.residency == Residency::DEMOTING)) {
+			nbOccupied++;
+		}
+	}
+	this->ncpCapacity = std::max(nbOccupied, static_cast<std::size_t>(1));	/* 0 would disable placement */
+}
+
+void CGpSinkTablePlacement::ncpTableCleared() {
+	for (Entry& entry : this->slots) {
+		entry.residency = Residency::HOST;
+	}
+	this->nbNcpEntries = 0;
+}
+
+bool CGpSinkTablePlacement::forget(uint32_t i_source_id) {
+	if (this->slots.empty()) {
+		return false;
+	}
+	Entry& entry = this->slots[this->findSlot(i_source_id)];
+	if (entry.sourceId == EMPTY_SLOT) {
+		return false;
+	}
+	bool inNcp = (entry.residency != Residency::HOST);
+	this->setResidency(entry, Residency::HOST);
+	entry.score = 0;	/* The slot will be released at the end of the epoch */
+	entry.hits = 0;
+	return inNcp;
+}
+
+void CGpSinkTablePlacement::forgetAll(std::vector<uint32_t>& o_ncp_entries) {
+	Entry empty = { EMPTY_SLOT, 0, 0, 0, Residency::HOST };
+	for (Entry& entry : this->slots) {
+		if (entry.sourceId != EMPTY_SLOT && entry.residency != Residency::HOST) {
+			o_ncp_entries.push_back(entry.sourceId);
+		}
+		entry = empty;
+	}
+	this->nbTracked = 0;
+	this->nbNcpEntries = 0;
+}
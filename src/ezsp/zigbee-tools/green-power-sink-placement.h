@@ -0,0 +1,226 @@
+/**
+ * @file green-power-sink-placement.h
+ *
+ * @brief Selection of the green power devices that are validated by the adapter's sink table rather than by the host
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace NSEZSP {
+
+/**
+ * @brief Traffic-driven placement of green power devices between the adapter's sink table and the host
+ *
+ * The adapter's sink table only holds a few dozen devices, but frames from these devices are authenticated by the adapter itself.
+ * This class counts authenticated frames per source ID and, at the end of each epoch (see endEpoch()), selects which devices should
+ * be moved into the adapter's sink table (promotions) and which devices should leave it to make room (demotions).
+ *
+ * The activity score of a device is halved at the end of each epoch before the frames of the epoch are added, so that recent traffic
+ * weighs more than old traffic. When the adapter's sink table is full, the least active resident (the least recently seen one amongst
+ * equally active residents) is replaced by a more active device only if the latter's score exceeds the former's by HYSTERESIS_PERCENT,
+ * so that devices with similar traffic do not keep swapping places. At most MAX_PROMOTIONS_PER_EPOCH devices are promoted per epoch,
+ * as each move costs several EZSP round trips.
+ *
+ * Counters are stored in a flat open-addressing hash table keyed by source ID, sized by reset(). In static allocation builds
+ * (USE_STATIC_ALLOCATION), neither recordFrame() nor endEpoch() allocate: frames from devices that do not fit in the table are not counted.
+ */
+class CGpSinkTablePlacement {
+public:
+	/**
+	 * @brief Where a device is validated
+	 */
+	enum class Residency : uint8_t {
+		HOST,	/*!< The device is validated by the host only */
+		PROMOTING,	/*!< The device is being added to the adapter's sink table (still validated by the host) */
+		NCP,	/*!< The device is in the adapter's sink table, frames authenticated by the adapter can be trusted */
+		DEMOTING,	/*!< The device is being removed from the adapter's sink table (validated by the host again) */
+	};
+
+	static constexpr uint32_t PROMOTION_MIN_SCORE = 4;	/*!< Minimum activity score for a device to be moved into the adapter's sink table */
+	static constexpr unsigned int HYSTERESIS_PERCENT = 50;	/*!< How much more active than a resident a device must be to take its place */
+	static constexpr std::size_t MAX_PROMOTIONS_PER_EPOCH = 4;	/*!< Maximum number of devices moved into the adapter's sink table per epoch */
+
+	CGpSinkTablePlacement();
+
+	/**
+	 * @brief Forget all devices, and size the placement
+	 *
+	 * @param i_max_devices The number of devices whose activity can be tracked without allocating
+	 * @param i_ncp_capacity The number of entries of the adapter's sink table that may be used (0 disables placement)
+	 */
+	void reset(std::size_t i_max_devices, std::size_t i_ncp_capacity);
+
+	/**
+	 * @brief Is placement enabled?
+	 *
+	 * @return true if some devices may be moved into the adapter's sink table
+	 */
+	bool isEnabled() const;
+
+	/**
+	 * @brief Get the number of entries of the adapter's sink table that may be used
+	 *
+	 * @return The capacity given to reset(), or less if the adapter reported that its sink table was full (see ncpTableFull())
+	 */
+	std::size_t getNcpCapacity() const;
+
+	/**
+	 * @brief Count an authenticated frame received from a device
+	 *
+	 * @param i_source_id The source ID of the device
+	 */
+	void recordFrame(uint32_t i_source_id);
+
+	/**
+	 * @brief Check whether frames authenticated by the adapter can be trusted for a device
+	 *
+	 * @param i_source_id The source ID of the device
+	 *
+	 * @return true if the device is in the adapter's sink table (Residency::NCP)
+	 */
+	bool isNcpResident(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Get where a device is validated
+	 *
+	 * @param i_source_id The source ID of the device
+	 *
+	 * @return The residency of the device (Residency::HOST for devices that are not tracked)
+	 */
+	Residency getResidency(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Get the activity score of a device, as computed at the end of the last epoch
+	 *
+	 * @param i_source_id The source ID of the device
+	 *
+	 * @return The score (0 for devices that are not tracked)
+	 */
+	uint32_t getScore(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Get the number of devices in (or being moved into) the adapter's sink table
+	 *
+	 * @return The number of devices in Residency::PROMOTING, Residency::NCP or Residency::DEMOTING
+	 */
+	std::size_t getNbNcpEntries() const;
+
+	/**
+	 * @brief Update activity scores with the frames counted since the last epoch, and select devices to move
+	 *
+	 * Selected devices are switched to Residency::PROMOTING or Residency::DEMOTING, the caller must then report the outcome of each move
+	 * using promotionDone() and demotionDone(). Devices that have been idle for a while are forgotten.
+	 *
+	 * @param[out] o_demotions Source IDs of the devices to remove from the adapter's sink table are appended to this vector
+	 * @param[out] o_promotions Source IDs of the devices to add to the adapter's sink table are appended to this vector
+	 */
+	void endEpoch(std::vector<uint32_t>& o_demotions, std::vector<uint32_t>& o_promotions);
+
+	/**
+	 * @brief Report the outcome of a promotion selected by endEpoch()
+	 *
+	 * @param i_source_id The source ID of the device
+	 * @param i_success Has the device been added to the adapter's sink table?
+	 *
+	 * @return false if the device was forgotten in the meantime (see forget()), it must then be removed from the adapter's sink table
+	 */
+	bool promotionDone(uint32_t i_source_id, bool i_success);
+
+	/**
+	 * @brief Report that a device has been removed from the adapter's sink table
+	 *
+	 * @param i_source_id The source ID of the device
+	 */
+	void demotionDone(uint32_t i_source_id);
+
+	/**
+	 * @brief Report that the adapter refused a promotion because its sink table is full
+	 *
+	 * The capacity is lowered to the number of entries currently used.
+	 */
+	void ncpTableFull();
+
+	/**
+	 * @brief Report that the adapter's sink table has been emptied (all devices are validated by the host again)
+	 */
+	void ncpTableCleared();
+
+	/**
+	 * @brief Stop tracking a device (eg: because it has been removed from the host database)
+	 *
+	 * @param i_source_id The source ID of the device
+	 *
+	 * @return true if the device was in (or being moved into) the adapter's sink table, from which it must then be removed
+	 */
+	bool forget(uint32_t i_source_id);
+
+	/**
+	 * @brief Stop tracking all devices
+	 *
+	 * @param[out] o_ncp_entries Source IDs of the devices that were in (or being moved into) the adapter's sink table, from which they must
+	 *             then be removed, are appended to this vector
+	 */
+	void forgetAll(std::vector<uint32_t>& o_ncp_entries);
+
+private:
+	static constexpr uint32_t EMPTY_SLOT = 0;	/*!< Source ID marking an unused slot (the unspecified GPD ID) */
+
+	/**
+	 * @brief Activity of one device
+	 */
+	struct Entry {
+		uint32_t sourceId;	/*!< The source ID of the device (EMPTY_SLOT if the slot is unused) */
+		uint32_t hits;	/*!< Number of frames counted since the last epoch */
+		uint32_t score;	/*!< Activity score computed at the end of the last epoch */
+		uint16_t lastSeenEpoch;	/*!< The (wrapping) number of the last epoch during which a frame was counted */
+		Residency residency;	/*!< Where the device is validated */
+	};
+
+	/**
+	 * @brief A device competing for an entry of the adapter's sink table during endEpoch()
+	 */
+	struct Candidate {
+		uint32_t score;	/*!< The activity score of the device */
+		uint16_t age;	/*!< Number of epochs since the device was last seen */
+		std::size_t slot;	/*!< The slot of the device */
+	};
+
+	/**
+	 * @brief Find the slot of a source ID
+	 *
+	 * @param i_source_id The source ID
+	 *
+	 * @return The index of the slot holding @p i_source_id if it exists, or of the empty slot where it should be inserted otherwise
+	 */
+	std::size_t findSlot(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Re-insert all tracked devices in a table with a (possibly) different number of slots, dropping idle devices
+	 *
+	 * @param nbSlots The new number of slots
+	 */
+	void rehash(std::size_t nbSlots);
+
+	/**
+	 * @brief Change the residency of a device, maintaining the number of entries used in the adapter's sink table
+	 *
+	 * @param entry The device
+	 * @param residency The new residency
+	 */
+	void setResidency(Entry& entry, Residency residency);
+
+	std::vector<Entry> slots;	/*!< The hash table (the number of slots is a power of 2) */
+	std::vector<Entry> spareSlots;	/*!< Storage for the next rehash() (same size as slots) */
+	std::vector<Candidate> candidates;	/*!< Storage for endEpoch() (one element per slot) */
+	std::vector<Candidate> residents;	/*!< Storage for endEpoch() (one element per slot) */
+	std::size_t nbTracked;	/*!< The number of used slots */
+	std::size_t ncpCapacity;	/*!< The number of entries of the adapter's sink table that may be used */
+	std::size_t nbNcpEntries;	/*!< The number of devices in Residency::PROMOTING, Residency::NCP or Residency::DEMOTING */
+	uint16_t epoch;	/*!< The (wrapping) number of the current epoch */
+};
+
+} // namespace NSEZSP
@@ -7,7 +7,9 @@
 #include <iostream>
 #include <iomanip>
 #include <map>
+#include <unordered_set>
 #include <string>
+#include <algorithm>	// For std::min(), std::max()
 
 #include "ezsp/zigbee-tools/green-power-sink.h"
 #include "ezsp/ezsp-protocol/struct/ember-gp-address-struct.h"
@@ -17,13 +19,26 @@
 
 #include "ezsp/zbmessage/zigbee-message.h"
 #include "ezsp/zbmessage/gpd-commissioning-command-payload.h"
+#include "ezsp/zbmessage/green-power-payload-decoders.h"
 #include "ezsp/ezsp-protocol/get-network-parameters-response.h"
 
 #include "spi/ILogger.h"
+#include "spi/AllocCounter.h"
 
 DEFINE_ENUM(State, SINK_STATE, NSEZSP::CGpSink);
 
 using NSEZSP::CGpSink;
+using NSEZSP::CGpTableMirror;
+using NSEZSP::CGpTxTable;
+using NSEZSP::CGpTxConfirmation;
+using NSEZSP::NSGPF::GPF_COMMISSIONING_CMD;
+using NSEZSP::NSGPF::GPF_CHANNEL_REQUEST_CMD;
+using NSEZSP::NSGPF::GPF_CHANNEL_CONFIGURATION;
+using NSEZSP::NSGPF::GPF_ATTRIBUTE_REPORTING;
+using NSEZSP::NSGPF::GPF_MANUFACTURER_ATTRIBUTE_REPORTING;
+using NSEZSP::NSGPF::GPF_MANUFACTURER_MULTI_CLUSTER_REPORTING;
+
+constexpr std::chrono::milliseconds CGpSink::GPDF_CONFIRMATION_MARGIN;
 
 // some defines to help understanding
 constexpr uint8_t GP_ENDPOINT = 242;
@@ -33,64 +48,106 @@ constexpr uint16_t GP_CLUSTER_ID =  0x0021;
 // receive client command
 constexpr uint8_t GP_PROXY_COMMISIONING_MODE_CLIENT_CMD_ID = 0x02;
 
-// GPF Command
-constexpr uint8_t GPF_SCENE_0_CMD	=	0x10;
-constexpr uint8_t GPF_SCENE_1_CMD	=	0x11;
-constexpr uint8_t GPF_SCENE_2_CMD	=	0x12;
-constexpr uint8_t GPF_SCENE_3_CMD	=	0x13;
-constexpr uint8_t GPF_SCENE_4_CMD	=	0x14;
-constexpr uint8_t GPF_SCENE_5_CMD	=	0x15;
-constexpr uint8_t GPF_SCENE_6_CMD	=	0x16;
-constexpr uint8_t GPF_SCENE_7_CMD	=	0x17;
+// Registration progress is logged each time this number of devices have been processed
+constexpr std::size_t REGISTRATION_PROGRESS_LOG_INTERVAL	=	50;
 
-constexpr uint8_t GPF_STORE_SCENE_0_CMD	=	0x18;
-constexpr uint8_t GPF_STORE_SCENE_1_CMD	=	0x19;
-constexpr uint8_t GPF_STORE_SCENE_2_CMD	=	0x1A;
-constexpr uint8_t GPF_STORE_SCENE_3_CMD	=	0x1B;
-constexpr uint8_t GPF_STORE_SCENE_4_CMD	=	0x1C;
-constexpr uint8_t GPF_STORE_SCENE_5_CMD	=	0x1D;
-constexpr uint8_t GPF_STORE_SCENE_6_CMD	=	0x1E;
-constexpr uint8_t GPF_STORE_SCENE_7_CMD	=	0x1F;
-
-constexpr uint8_t GPF_OFF_CMD		=	0x20;
-constexpr uint8_t GPF_ON_CMD		=	0x21;
-constexpr uint8_t GPF_TOGGLE_CMD	=	0x22;
-
-constexpr uint8_t GPF_UP_W_ON_OFF_CMD	=	0x34;
-constexpr uint8_t GPF_STOP_CMD			=	0x35;
-constexpr uint8_t GPF_DOWN_W_ON_OFF_CMD	=	0x36;
-
-constexpr uint8_t GPF_MANUFACTURER_ATTRIBUTE_REPORTING	= 0xA1;
+namespace {
+/**
+ * @brief Build an active entry of a host-side copy of the adapter's tables
+ */
+CGpTableMirror::Entry mirrorEntry(uint32_t i_source_id, uint32_t i_options = 0, uint8_t i_security_options = 0, const NSEZSP::EmberKeyData& i_key = NSEZSP::EmberKeyData()) {
+	return { CGpTableMirror::EntryStatus::ACTIVE, i_source_id, i_options, i_security_options, i_key };
+}
 
-constexpr uint8_t GPF_COMMISSIONING_CMD		=	0xE0;
-constexpr uint8_t GPF_DECOMMISSIONING_CMD	=	0xE1;
-constexpr uint8_t GPF_CHANNEL_REQUEST_CMD	=	0xE3;
+/**
+ * @brief Records the decoded attribute reports of a frame into an attribute store
+ */
+class CGpAttributeStoreUpdater : public NSEZSP::CGpPayloadVisitor {
+public:
+	explicit CGpAttributeStoreUpdater(NSEZSP::CGpAttributeStore& i_store) : store(i_store), now(std::chrono::steady_clock::now()) { }
 
-// GPDF commands sent to GPD
-constexpr uint8_t GPF_CHANNEL_CONFIGURATION  = 0xF3;
+	void handleAttributeReport(const NSEZSP::CGpFrameView& i_gpf, const NSEZSP::CGpAttributeReport& i_report) override {
+		this->store.update(i_gpf.getSourceId(), i_report, this->now);
+	}
 
-// MSP GPF
-constexpr uint8_t GPF_MSP_CHANNEL_REQUEST_CMD	=	0xB0;
+private:
+	NSEZSP::CGpAttributeStore& store;	/*!< The store to update */
+	std::chrono::steady_clock::time_point now;	/*!< The reception time of the frame */
+};
+}
 
 
 
-CGpSink::CGpSink( CEzspDongle &i_dongle, CZigbeeMessaging &i_zb_messaging ) :
+CGpSink::CGpSink( CEzspDongle &i_dongle, CZigbeeMessaging &i_zb_messaging, const NSSPI::TimerBuilder& i_timer_builder, std::size_t i_max_gp_devices, std::size_t i_max_gp_attributes ) :
 	dongle(i_dongle),
 	zb_messaging(i_zb_messaging),
 	sink_state(SINK_NOT_INIT),
 	obsStateCallback(nullptr),
 	nwk_parameters(),
 	authorizeGpfChannelRqst(false),
-	gpf_comm_frame(),
+	commissioningMutex(),
+	commissioningSessionOpen(false),
+	commissionings(),
+	commissioningQueue(),
+	commissioningWrites(),
+	commissioningAllocating(false),
+	commissioningAllocatingSourceId(0),
 	sink_table_index(0xFF),
 	gpds_to_register(),
+	registrationProgressMutex(),
+	registrationProgress({0, 0, 0, 0.0}),
+	registrationStart(),
+	ncpTablesMutex(),
+	sinkTableMirror(),
+	proxyTableMirror(),
+	pendingNcpTableUpdates(),
+	nbPendingNcpTableResponses(0),
 	sink_table_entry(),
 	proxy_table_index(),
 	gpds_to_remove(),
+	gpds_to_sync(),
+	downlinkMutex(),
+	downlinkQueue(),
+	downlinkTimerDeadline(std::chrono::steady_clock::time_point::max()),
 	gpdSentStateMutex(),
-	gpdSentLastHandlerNb(-1),
-	sentChannelSwitchSourceId(0),
-	observers() {
+	gpdSentPending(),
+	gpdSentTimerArmed(false),
+	gpdSentTimer(i_timer_builder.create()),
+	downlinkTimer(i_timer_builder.create()),
+	observers(),
+	nbDroppedDuplicateRxGpFrames(0),
+	nbDroppedReplayedRxGpFrames(0),
+	rxDuplicateFilter(i_max_gp_devices),
+	unknownSourcePolicy(CGpUnknownSourcePolicy::Process),
+	unknownSourceSampleInterval(100),
+	nbUnknownSourceFrames(0),
+	nbFilteredRxGpFrames(0),
+	nbNcpValidatedRxGpFrames(0),
+	attributeStore(i_max_gp_attributes),
+	livenessMutex(),
+	liveness(i_max_gp_devices, std::chrono::steady_clock::now()),
+	livenessTimerArmed(false),
+	livenessTimer(i_timer_builder.create())
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	, gp_dev_db(i_max_gp_devices),
+	rxGpFrames(),
+	rxGpFramesSpare(),
+	sinkTablePlacement(),
+	sinkTableEpochDuration(std::chrono::seconds(60)),
+	sinkTableEpochStart(),
+	sinkTableDemotions(),
+	sinkTablePromotions(),
+	sinkTableMigrationInFlight(false),
+	sinkTableMigrationAwaitedCmd(EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY),
+	sinkTableMigrationPromoting(false),
+	sinkTableMigrationSourceId(0),
+	sinkTableMigrationIndex(0xFF)
+#endif
+{
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	this->rxGpFrames.reserve(RX_GP_FRAME_QUEUE_SIZE);	/* No allocation on the RX path */
+	this->rxGpFramesSpare.reserve(RX_GP_FRAME_QUEUE_SIZE);
+#endif
 	dongle.registerObserver(this);
 }
 
@@ -102,8 +159,41 @@ void CGpSink::init() {
 	// retieve network information
 	dongle.sendCommand(EZSP_GET_NETWORK_PARAMETERS);
 
-	// set state
-	setSinkState(SINK_READY);
+	/* Read the adapter's tables once, the host-side copies are then updated from the responses to the commands that modify them */
+	{
+		std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+		this->sinkTableMirror.startLoad();
+		this->proxyTableMirror.startLoad();
+		this->pendingNcpTableUpdates.clear();
+		this->nbPendingNcpTableResponses = 0;
+	}
+	setSinkState(SINK_TABLES_LOAD_IN_PROGRESS);
+	this->loadSinkTableEntry(0);	/* SINK_READY will be set once the end of the proxy table is reached */
+}
+
+void CGpSink::loadSinkTableEntry(uint8_t i_index) {
+	if (i_index == CGpTableMirror::NO_ENTRY) {
+		this->loadProxyTableEntry(0);
+		return;
+	}
+	this->sink_table_index = i_index;
+	gpSinkGetEntry(i_index);
+}
+
+void CGpSink::loadProxyTableEntry(uint8_t i_index) {
+	if (i_index == CGpTableMirror::NO_ENTRY) {
+		{
+			std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+			this->sinkTableMirror.endLoad();
+			this->proxyTableMirror.endLoad();
+			clogI << "Adapter's GP tables loaded: " << std::dec << this->sinkTableMirror.getNbUsedEntries() << "/" << this->sinkTableMirror.size()
+			      << " sink table entries and " << this->proxyTableMirror.getNbUsedEntries() << "/" << this->proxyTableMirror.size() << " proxy table entries in use\n";
+		}
+		setSinkState(SINK_READY);
+		return;
+	}
+	this->proxy_table_index = i_index;
+	dongle.sendCommand(EZSP_GP_PROXY_TABLE_GET_ENTRY, { i_index });
 }
 
 bool CGpSink::gpClearAllTables() {
@@ -112,23 +202,189 @@ bool CGpSink::gpClearAllTables() {
 	}
 
 	setSinkState(CGpSink::State::SINK_CLEAR_ALL);
-	dongle.sendCommand(EZSP_GP_SINK_TABLE_CLEAR_ALL);   /* Handle sink table */
-	dongle.sendCommand(EZSP_GP_PROXY_TABLE_GET_ENTRY, {0}); /* Handle proxy table */
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	/* Devices moved into the adapter's sink table are validated by the host again */
+	this->sinkTablePlacement.ncpTableCleared();
+	this->sinkTableDemotions.clear();
+	this->sinkTablePromotions.clear();
+#endif
+	std::vector<uint32_t> l_proxy_source_ids;
+	{
+		std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+		this->proxyTableMirror.getUsedSourceIds(l_proxy_source_ids);	/* Blank entries of the proxy table are not accessed */
+		this->nbPendingNcpTableResponses = 1 + l_proxy_source_ids.size();
+	}
+	this->gpSinkTableClearAll();   /* Handle sink table */
+	for (uint32_t l_source_id : l_proxy_source_ids) {	/* Handle proxy table */
+		CProcessGpPairingParam l_param(l_source_id);
+		gpProxyTableProcessGpPairing(l_param);
+	}
 	return true;
 }
 
 void CGpSink::openCommissioningSession() {
-	// set local proxy in commissioning mode
-	sendLocalGPProxyCommissioningMode(0x05);
+	bool l_idle;
+	{
+		std::lock_guard<std::mutex> lock(this->commissioningMutex);
+		l_idle = (this->commissioningQueue.empty() && this->commissioningWrites.empty() && !this->commissioningAllocating);
+		if (l_idle) {
+			this->commissionings.clear();	/* Devices paired during a previous session can be commissioned again */
+		}
+		this->commissioningSessionOpen = true;
+	}
+	// set local proxy in commissioning mode, until it is explicitly closed (several devices can be commissioned)
+	sendLocalGPProxyCommissioningMode(0x09);
 
-	setSinkState(CGpSink::State::SINK_COM_OPEN); // Update state
+	if (l_idle) {
+		setSinkState(CGpSink::State::SINK_COM_OPEN); // Update state
+	}
 }
 
 void CGpSink::closeCommissioningSession() {
+	bool l_idle;
+	{
+		std::lock_guard<std::mutex> lock(this->commissioningMutex);
+		this->commissioningSessionOpen = false;
+		l_idle = (this->commissioningQueue.empty() && this->commissioningWrites.empty() && !this->commissioningAllocating);
+	}
 	// set local proxy in commissioning mode
 	sendLocalGPProxyCommissioningMode(0x00);
 
-	setSinkState(CGpSink::State::SINK_READY); // Update state
+	if (l_idle) {
+		setSinkState(CGpSink::State::SINK_READY); // Update state
+	}
+	/* Otherwise, SINK_READY will be set once the devices already queued have been processed, see finishCommissioning() */
+}
+
+void CGpSink::queueCommissioning(const CGpFrameView& i_gpf) {
+	uint32_t l_source_id = i_gpf.getSourceId();
+	bool l_first;
+	{
+		std::lock_guard<std::mutex> lock(this->commissioningMutex);
+		if (!this->commissioningSessionOpen) {
+			return;
+		}
+		auto l_it = this->commissionings.find(l_source_id);
+		if (l_it != this->commissionings.end() && l_it->second.step != CommissioningStep::FAILED) {
+			l_it->second.nbDuplicates++;	/* GPDs repeat their commissioning frames, and several proxies may forward them */
+			return;
+		}
+		this->commissionings[l_source_id] = { i_gpf.retain(), CommissioningStep::WAITING, 0, std::chrono::steady_clock::now(), std::chrono::steady_clock::time_point() };
+		this->commissioningQueue.push_back(l_source_id);
+		l_first = (this->commissioningQueue.size() == 1 && this->commissioningWrites.empty() && !this->commissioningAllocating);
+	}
+	clogD << "Queued commissioning of source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << l_source_id << "\n";
+	if (l_first) {
+		setSinkState(CGpSink::State::SINK_COM_IN_PROGRESS);
+	}
+	this->commissionNextGpd();
+}
+
+void CGpSink::commissionNextGpd() {
+	uint32_t l_source_id;
+	{
+		std::lock_guard<std::mutex> lock(this->commissioningMutex);
+		if (this->commissioningAllocating || this->commissioningQueue.empty()) {
+			return;
+		}
+		l_source_id = this->commissioningQueue.front();
+		this->commissioningQueue.pop_front();
+		PendingCommissioning& l_pending = this->commissionings[l_source_id];
+		l_pending.step = CommissioningStep::ALLOCATING;
+		l_pending.started = std::chrono::steady_clock::now();
+		this->commissioningAllocating = true;
+		this->commissioningAllocatingSourceId = l_source_id;
+	}
+	gpSinkTableFindOrAllocateEntry(l_source_id);
+}
+
+void CGpSink::writeCommissionedGpdEntry(CEmberGpSinkTableEntryStruct& i_entry) {
+	CGpFrame l_gpf;
+	{
+		std::lock_guard<std::mutex> lock(this->commissioningMutex);
+		if (!this->commissioningAllocating) {
+			clogE << "Internal error: no device is being allocated a sink table entry\n";
+			return;
+		}
+		l_gpf = this->commissionings[this->commissioningAllocatingSourceId].frame;
+	}
+	// decode payload
+	CGpdCommissioningPayload l_payload(l_gpf.getPayloadView(), l_gpf.getSourceId());
+
+	// debug
+	clogD << "GPD Commissioning payload: " << l_payload << "\n";
+
+	// update sink table entry
+	CEmberGpAddressStruct l_gp_addr(l_gpf.getSourceId());
+	CEmberGpSinkTableOption l_options(l_gp_addr.getApplicationId(), l_payload);
+
+	i_entry.setDeviceId(l_payload.getDeviceId());
+	i_entry.setAlias(static_cast<uint16_t>(l_gpf.getSourceId()&0xFFFF));
+	i_entry.setSecurityOption(l_payload.getExtendedOption()&0x1F);
+	i_entry.setFrameCounter(l_payload.getOutFrameCounter());
+	i_entry.setKey(l_payload.getKey());
+	i_entry.setEntryActive(true);
+	i_entry.setOptions(l_options);
+	i_entry.setGpdAddress(l_gp_addr);
+	// debug
+	clogD << "Update table entry : " << i_entry << std::endl;
+
+	gpSinkSetEntry(sink_table_index, i_entry);
+	this->sink_table_entry = i_entry;	/* Used for the proxy pairing, once the entry is written */
+	{
+		std::lock_guard<std::mutex> lock(this->commissioningMutex);
+		this->commissionings[this->commissioningAllocatingSourceId].step = CommissioningStep::WRITING;
+		this->commissioningWrites.push_back(this->commissioningAllocatingSourceId);
+		this->commissioningAllocating = false;
+	}
+
+	/* As for registerGpds(), do not wait for this device to be paired before allocating an entry for the next one: the adapter processes commands in order */
+	this->commissionNextGpd();
+}
+
+bool CGpSink::popCommissioningWrite(uint32_t& o_source_id) {
+	std::lock_guard<std::mutex> lock(this->commissioningMutex);
+	if (this->commissioningWrites.empty()) {
+		clogE << "Internal error: no commissioned device is being written\n";
+		return false;
+	}
+	o_source_id = this->commissioningWrites.front();
+	this->commissioningWrites.pop_front();
+	return true;
+}
+
+void CGpSink::finishCommissioning(uint32_t i_source_id, bool i_paired) {
+	CGpCommissioningReport l_report = { i_source_id, i_paired, 0, std::chrono::microseconds(0), std::chrono::microseconds(0) };
+	bool l_idle;
+	{
+		std::lock_guard<std::mutex> lock(this->commissioningMutex);
+		auto l_it = this->commissionings.find(i_source_id);
+		if (l_it != this->commissionings.end()) {
+			l_it->second.step = (i_paired ? CommissioningStep::PAIRED : CommissioningStep::FAILED);
+			l_report.nbDuplicates = l_it->second.nbDuplicates;
+			l_report.queueDelay = std::chrono::duration_cast<std::chrono::microseconds>(l_it->second.started - l_it->second.received);
+			l_report.latency = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - l_it->second.received);
+		}
+		l_idle = (this->commissioningQueue.empty() && this->commissioningWrites.empty() && !this->commissioningAllocating);
+	}
+	clogI << (i_paired ? "Paired" : "Failed pairing") << " source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << i_source_id
+	      << " in " << std::dec << l_report.latency.count() / 1000 << "ms (" << l_report.queueDelay.count() / 1000 << "ms queued)\n";
+	this->notifyObserversOfGpdCommissioning(l_report);
+	if (l_idle) {
+		setSinkState(CGpSink::State::SINK_COM_OPEN);
+		this->endCommissioningIfClosed();	/* The session may have been closed while devices were still being processed */
+	}
+}
+
+void CGpSink::endCommissioningIfClosed() {
+	bool l_closed;
+	{
+		std::lock_guard<std::mutex> lock(this->commissioningMutex);
+		l_closed = (!this->commissioningSessionOpen && this->commissioningQueue.empty() && this->commissioningWrites.empty() && !this->commissioningAllocating);
+	}
+	if (l_closed) {
+		setSinkState(CGpSink::State::SINK_READY);
+	}
 }
 
 bool CGpSink::registerGpds(std::vector<CGpDevice> gpd) {
@@ -145,25 +401,142 @@ bool CGpSink::registerGpds(std::vector<CGpDevice> gpd) {
 		return false;
 	}
 
+#ifdef USE_BUILTIN_MIC_PROCESSING
 	this->setSinkState(CGpSink::State::SINK_COM_OFFLINE_IN_PROGRESS);
 	swap(this->gpds_to_register, gpd);
-#ifdef USE_BUILTIN_MIC_PROCESSING
-	this->gp_dev_db.setDb(gpd);
+	this->startRegistration(this->gpds_to_register.size());
+	this->gp_dev_db.setDb(this->gpds_to_register);	/* gpd now holds the previously queued list, if any */
+	/* Keys may have changed: devices in the adapter's sink table are moved back to the host, the most active ones will be promoted again */
+	this->sinkTablePlacement.forgetAll(this->sinkTableDemotions);
+	this->sinkTablePromotions.clear();
+	std::size_t nbRegistered = this->gpds_to_register.size();
 	this->gpds_to_register.clear();
-	this->setSinkState(CGpSink::State::SINK_READY);
+	this->countRegistration(nbRegistered, 0);	/* The job is already over, this sets SINK_READY */
+	return true;
 #else
+	this->startNcpRegistration(gpd);
+	return true;
+#endif
+}
+
+void CGpSink::startNcpRegistration(std::vector<CGpDevice>& io_gpds) {
+	this->setSinkState(CGpSink::State::SINK_COM_OFFLINE_IN_PROGRESS);
+	swap(this->gpds_to_register, io_gpds);
+	this->startRegistration(this->gpds_to_register.size());
+
 	/* The list GPs that should be added has been stored inside this->gpds_to_register, for background processing */
 
 	/* Request sink table entry for the first source ID to add, the rest of the source IDs in the list gpds_to_register will be processed asynchronously */
-	/* Note: gpds_to_register vector cannot be empty because of the initial test on gpd argument, that was then swapped */
-	/* It is thus safe to issue back() on that vector */
-	gpSinkTableFindOrAllocateEntry(gpds_to_register.back().getSourceId());
+	/* Note: gpds_to_register vector cannot be empty, callers check it */
+	this->registerNextGpd();
 
 	/* When performing the register action directly inside the dongle:
 	 * The SINK_READY final state will be set when reaching the end of the adapter's table iteration, so we don't set SINK_READY right now (it will be done asynchronously)
 	 */
-	return true;
+}
+
+bool CGpSink::syncGpds(const std::vector<CGpDevice>& i_gpds, CGpSyncSummary& o_summary) {
+	if (CGpSink::State::SINK_READY != sink_state) {
+		return false;
+	}
+
+	o_summary = { 0, 0, 0, 0 };
+	std::unordered_set<uint32_t> l_known_ids;	/* Desired source IDs, then also the source IDs already scheduled for removal */
+	l_known_ids.reserve(i_gpds.size());
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	/* Devices are stored in the host database, only the keys can differ */
+	for (const CGpDevice& l_gpd : i_gpds) {
+		uint32_t l_source_id = l_gpd.getSourceId();
+		if (!l_known_ids.insert(l_source_id).second) {
+			continue;	/* The first occurrence of a source ID is kept */
+		}
+		NSEZSP::EmberKeyData l_key;
+		bool l_known = this->gp_dev_db.getKeyForSourceId(l_source_id, l_key);
+		if (l_known && l_key == l_gpd.getKey()) {
+			o_summary.nbUnchanged++;
+			continue;
+		}
+		if (!this->gp_dev_db.insertDevice(l_gpd)) {
+			clogE << "Could not store source ID " << std::hex << std::setw(8) << std::setfill('0') << l_source_id << " in internal database\n";
+		}
+		if (l_known) {
+			o_summary.nbUpdated++;
+			if (this->sinkTablePlacement.forget(l_source_id)) {
+				this->sinkTableDemotions.push_back(l_source_id);	/* The adapter's sink table holds the previous key */
+			}
+		}
+		else {
+			o_summary.nbAdded++;
+		}
+	}
+	std::vector<uint32_t> l_used_ids;
+	this->gp_dev_db.getSourceIds(l_used_ids);
+	for (uint32_t l_source_id : l_used_ids) {
+		if (l_known_ids.count(l_source_id) == 0) {
+			this->gp_dev_db.removeDevice(l_source_id);
+			if (this->sinkTablePlacement.forget(l_source_id)) {
+				this->sinkTableDemotions.push_back(l_source_id);	/* Also remove it from the adapter's sink table */
+			}
+			o_summary.nbRemoved++;
+		}
+	}
+	clogI << "GP devices synchronized: " << std::dec << o_summary.nbUnchanged << " unchanged, " << o_summary.nbAdded << " added, "
+	      << o_summary.nbUpdated << " updated, " << o_summary.nbRemoved << " removed\n";
+	this->setSinkState(CGpSink::State::SINK_READY);
+#else
+	/* Devices are compared with the host-side copies of the adapter's tables, loaded at init() */
+	std::vector<CGpDevice> l_to_register;
+	std::vector<uint32_t> l_to_remove;
+	{
+		std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+		for (const CGpDevice& l_gpd : i_gpds) {
+			uint32_t l_source_id = l_gpd.getSourceId();
+			if (!l_known_ids.insert(l_source_id).second) {
+				continue;	/* The first occurrence of a source ID is kept */
+			}
+			uint8_t l_sink_index = this->sinkTableMirror.find(l_source_id);
+			if (l_sink_index == CGpTableMirror::NO_ENTRY) {
+				o_summary.nbAdded++;
+				l_to_register.push_back(l_gpd);
+				continue;
+			}
+			const CGpTableMirror::Entry& l_entry = this->sinkTableMirror.getEntry(l_sink_index);
+			if (l_entry.status == CGpTableMirror::EntryStatus::ACTIVE
+			        && l_entry.options == l_gpd.getSinkOption().get()
+			        && l_entry.securityOptions == l_gpd.getSinkSecurityOption()
+			        && l_entry.key == l_gpd.getKey()
+			        && this->proxyTableMirror.find(l_source_id) != CGpTableMirror::NO_ENTRY) {
+				o_summary.nbUnchanged++;
+			}
+			else {
+				o_summary.nbUpdated++;	/* Written again, in the entry it already uses */
+				l_to_register.push_back(l_gpd);
+			}
+		}
+		std::vector<uint32_t> l_used_ids;
+		this->sinkTableMirror.getUsedSourceIds(l_used_ids);
+		this->proxyTableMirror.getUsedSourceIds(l_used_ids);
+		for (uint32_t l_source_id : l_used_ids) {
+			if (l_known_ids.insert(l_source_id).second) {
+				l_to_remove.push_back(l_source_id);
+			}
+		}
+	}
+	o_summary.nbRemoved = l_to_remove.size();
+	clogI << "Synchronizing GP devices: " << std::dec << o_summary.nbUnchanged << " unchanged, " << o_summary.nbAdded << " to add, "
+	      << o_summary.nbUpdated << " to update, " << o_summary.nbRemoved << " to remove\n";
+
+	swap(this->gpds_to_sync, l_to_register);	/* Registered once the removals are over, see ncpTableJobDone() */
+	if (l_to_remove.empty()) {
+		this->ncpTableJobDone();
+	}
+	else {
+		this->setSinkState(CGpSink::State::SINK_REMOVE_IN_PROGRESS);
+		swap(this->gpds_to_remove, l_to_remove);
+		this->startNcpRemoval();
+	}
 #endif
+	return true;
 }
 
 bool CGpSink::clearAllGpds() {
@@ -171,10 +544,16 @@ bool CGpSink::clearAllGpds() {
 		clogE << "Request to clearAllGpds() while not SINK_READY. Current state: " << NSEZSP::CGpSink::getStateAsString(this->sink_state) << "\n";
 		return false;
 	}
+	{
+		std::lock_guard<std::mutex> lock(this->livenessMutex);
+		this->liveness.forgetAll();
+	}
 
 #ifdef USE_BUILTIN_MIC_PROCESSING
 	this->setSinkState(CGpSink::State::SINK_CLEAR_ALL);
 	this->gp_dev_db.clear();
+	this->sinkTablePlacement.forgetAll(this->sinkTableDemotions);
+	this->sinkTablePromotions.clear();
 	this->setSinkState(CGpSink::State::SINK_READY);
 	return true;
 #else
@@ -186,6 +565,16 @@ bool CGpSink::clearAllGpds() {
 #endif
 }
 
+bool CGpSink::openDeviceStore(const std::string& i_path) {
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	return this->gp_dev_db.openStore(i_path);
+#else
+	(void)i_path;
+	clogE << "GP devices are stored in the adapter, a host device store is only used with USE_BUILTIN_MIC_PROCESSING\n";
+	return false;
+#endif
+}
+
 bool CGpSink::removeGpds(std::vector<uint32_t> gpd) {
 	if (CGpSink::State::SINK_READY != sink_state) {
 		return false;
@@ -202,54 +591,93 @@ bool CGpSink::removeGpds(std::vector<uint32_t> gpd) {
 
 	this->setSinkState(CGpSink::State::SINK_REMOVE_IN_PROGRESS);
 	swap(this->gpds_to_remove, gpd);
+	{
+		std::lock_guard<std::mutex> lock(this->livenessMutex);
+		for (uint32_t l_source_id : this->gpds_to_remove) {
+			this->liveness.forget(l_source_id);
+		}
+	}
 #ifdef USE_BUILTIN_MIC_PROCESSING
-	for (auto it = gpd.begin(); it != gpd.end(); ++it) {
+	for (auto it = this->gpds_to_remove.begin(); it != this->gpds_to_remove.end(); ++it) {	/* gpd now holds the previously queued list, if any */
 		if (!this->gp_dev_db.removeDevice(*it)) {
 			clogW << "Source ID " << std::hex << std::setw(8) << std::setfill('0') << *it << " not found in internal database\n";
 		}
+		if (this->sinkTablePlacement.forget(*it)) {
+			this->sinkTableDemotions.push_back(*it);	/* Also remove it from the adapter's sink table */
+		}
 	}
 	this->gpds_to_remove.clear();
 	this->setSinkState(CGpSink::State::SINK_READY);
+	return true;
 #else
-	/* Note: the list GPs that should be deleted has been stored inside this->gpds_to_remove, for background processing */
-
-	/* Request sink table entry for the first source ID to delete, the rest of the source IDs in the list gpds_to_remove will be processed asynchronously */
-	/* Note: gpds_to_remove vector cannot be empty because of the initial test on gpd argument, that was then swapped */
-	/* It is thus safe to issue back() on that vector */
-	gpSinkTableLookup(gpds_to_remove.back());
-
-	/* When performing the remove action directly inside the dongle:
-	 * The SINK_READY final state will be set when reaching the end of the adapter's table iteration, so we don't set SINK_READY right now (it will be done asynchronously)
-	 */
+	this->startNcpRemoval();
 	return true;
 #endif
 }
 
+void CGpSink::startNcpRemoval() {
+	/* Note: the list GPs that should be deleted has been stored inside this->gpds_to_remove */
+
+	/* The entries used by these source IDs are found in the host-side copies of the adapter's tables, only them are accessed */
+	std::vector<uint8_t> l_sink_indexes;
+	std::vector<uint32_t> l_proxy_source_ids;
+	{
+		std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+		for (uint32_t l_source_id : this->gpds_to_remove) {
+			uint8_t l_sink_index = this->sinkTableMirror.find(l_source_id);
+			bool l_in_proxy_table = (this->proxyTableMirror.find(l_source_id) != CGpTableMirror::NO_ENTRY);
+			if (l_sink_index != CGpTableMirror::NO_ENTRY) {
+				l_sink_indexes.push_back(l_sink_index);
+			}
+			if (l_in_proxy_table) {
+				l_proxy_source_ids.push_back(l_source_id);
+			}
+			if (l_sink_index == CGpTableMirror::NO_ENTRY && !l_in_proxy_table) {
+				clogW << "Source ID " << std::hex << std::setw(8) << std::setfill('0') << l_source_id << " not found in the adapter's tables\n";
+			}
+		}
+		this->nbPendingNcpTableResponses = l_sink_indexes.size() + l_proxy_source_ids.size();
+	}
+	this->gpds_to_remove.clear();
+	if (l_sink_indexes.empty() && l_proxy_source_ids.empty()) {
+		this->ncpTableJobDone();
+		return;
+	}
+	for (uint8_t l_sink_index : l_sink_indexes) {
+		gpSinkTableRemoveEntry(l_sink_index);
+	}
+	for (uint32_t l_source_id : l_proxy_source_ids) {
+		CProcessGpPairingParam l_param(l_source_id);
+		gpProxyTableProcessGpPairing(l_param);
+	}
+
+	/* The SINK_READY final state will be set once all responses have been received, so we don't set SINK_READY right now (it will be done asynchronously) */
+}
+
 void CGpSink::handleEzspRxMessage_GET_NETWORK_PARAMETERS(const NSSPI::ByteBuffer& i_msg_receive) {
-	CGetNetworkParametersResponse l_rsp(i_msg_receive);
+	NSSPI::ByteReader l_reader(i_msg_receive);
+	CGetNetworkParametersResponse l_rsp(l_reader);
+	if (l_reader.hasError()) {
+		clogE << "Truncated EZSP_GET_NETWORK_PARAMETERS response: " << i_msg_receive << "\n";
+		return;
+	}
 	if( EEmberStatus::EMBER_SUCCESS == l_rsp.getStatus() ) {
 		this->nwk_parameters = l_rsp.getParameters();
 	}
 }
 
-void CGpSink::handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_NO_SECURITY(const CGpFrame& gpf) {
+void CGpSink::handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_NO_SECURITY(const CGpFrameView& gpf) {
 	// do action only if we are in commissioning mode
 	uint32_t remoteGpdSourceId = gpf.getSourceId();
-	if (CGpSink::State::SINK_COM_OPEN == sink_state) {
+	if (CGpSink::State::SINK_COM_OPEN == sink_state || CGpSink::State::SINK_COM_IN_PROGRESS == sink_state) {
 		if (GPF_COMMISSIONING_CMD == gpf.getCommandId()) {
-			// find entry in sink table
-			gpSinkTableFindOrAllocateEntry(remoteGpdSourceId);
-
-			// save incomming message
-			gpf_comm_frame = gpf;
-
-			// set new state
-			setSinkState(CGpSink::State::SINK_COM_IN_PROGRESS);
+			// pair this device once those that were commissioned before it are done
+			this->queueCommissioning(gpf);
 		}
 	}
 	if (authorizeGpfChannelRqst && (GPF_CHANNEL_REQUEST_CMD == gpf.getCommandId())) {
 		// respond only if next attempt is on same channel as us
-		uint8_t l_next_channel_attempt = static_cast<uint8_t>(gpf.getPayload().at(0)&0x0F);
+		uint8_t l_next_channel_attempt = static_cast<uint8_t>(gpf.getPayloadView().at(0)&0x0F);
 		uint8_t targetDot154Channel = this->nwk_parameters.getRadioChannel();
 		clogI << "Will steer requesting source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << remoteGpdSourceId << " to channel " << std::dec << static_cast<unsigned int>(targetDot154Channel) << "\n";
 		uint8_t channelByte = targetDot154Channel - 11U;
@@ -262,26 +690,34 @@ void CGpSink::handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_NO_SECURITY(const CGp
 	}
 }
 
-void CGpSink::handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_SECURITY(const CGpFrame& gpf) {
-	if( (GPF_MANUFACTURER_ATTRIBUTE_REPORTING == gpf.getCommandId()) && (gpf.getPayload().size() > 6) ) {
+void CGpSink::handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_SECURITY(const CGpFrameView& gpf) {
+	this->handleGpdHeard(gpf.getSourceId());
+	if (gpf.isRxAfterTx()) {
+		this->handleGpdUplink(gpf.getSourceId());	/* The GPD is listening right now, and tells us when it will listen again */
+	}
+
+	if( (GPF_MANUFACTURER_ATTRIBUTE_REPORTING == gpf.getCommandId()) && (gpf.getPayloadView().size() > 6) ) {
 		/* Handle the MSP channel request. This message is a MSP extension of the GP commissioning */
 		/* However, it has the advantage of sending the new channel authenticated for the specific GP device, this type of message cannot be forged by an attacker that would not know the GP OOB encryption key */
 		
 		uint32_t remoteGpdSourceId = gpf.getSourceId();
-		std::lock_guard<std::mutex> gpdSentStateLock(this->gpdSentStateMutex);
-		if (this->sentChannelSwitchSourceId != 0) {	/* There is already a channel switch ongoing... EZSP adapters cannot handle two requests simultaneously */
-			clogE << "Discarding channel switch request from source ID 0x"
+		bool l_already_pending;
+		{
+			std::lock_guard<std::mutex> gpdSentStateLock(this->gpdSentStateMutex);
+			l_already_pending = this->gpdSentPending.isPending(remoteGpdSourceId, GPF_CHANNEL_CONFIGURATION);
+		}
+		if (l_already_pending) {	/* Channel switches of other devices are processed in parallel, each one with its own handle */
+			clogD << "Ignoring repeated channel switch request from source ID 0x"
 			      << std::hex << std::setw(8) << std::setfill('0') << remoteGpdSourceId
-			      << " because another previous channel switch request is being processed for source ID 0x"
-			      << std::hex << std::setw(8) << std::setfill('0') << this->sentChannelSwitchSourceId << "\n";
+			      << ", its channel configuration is still waiting to be sent\n";
 		}
 		else {
 			// Assume manufacturing 0x1021 attribute 0x5000 of cluster 0x0000 is a secure channel request
-			uint16_t l_manufacturer_id = dble_u8_to_u16(gpf.getPayload().at(1), gpf.getPayload().at(0));
-			uint16_t l_cluster_id = dble_u8_to_u16(gpf.getPayload().at(3), gpf.getPayload().at(2));
-			uint16_t l_attribute_id = dble_u8_to_u16(gpf.getPayload().at(5), gpf.getPayload().at(4));
-			uint8_t l_type_id = gpf.getPayload().at(6);
-			//uint8_t l_device_id = gpf.getPayload().at(7);	// Unused for now
+			uint16_t l_manufacturer_id = dble_u8_to_u16(gpf.getPayloadView().at(1), gpf.getPayloadView().at(0));
+			uint16_t l_cluster_id = dble_u8_to_u16(gpf.getPayloadView().at(3), gpf.getPayloadView().at(2));
+			uint16_t l_attribute_id = dble_u8_to_u16(gpf.getPayloadView().at(5), gpf.getPayloadView().at(4));
+			uint8_t l_type_id = gpf.getPayloadView().at(6);
+			//uint8_t l_device_id = gpf.getPayloadView().at(7);	// Unused for now
 			if ((0x1021 == l_manufacturer_id) &&
 			    (0 == l_cluster_id) &&
 			    (0x5000 == l_attribute_id) &&
@@ -292,78 +728,486 @@ void CGpSink::handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_SECURITY(const CGpFra
 				// send channel configuration with timeout of 1000ms
 				uint8_t targetDot154Channel = this->nwk_parameters.getRadioChannel();
 				uint8_t channelByte = targetDot154Channel - 11U;
-				this->gpdSentLastHandlerNb++;	/* This transmission will be done using an incremented handler number */
-				this->sentChannelSwitchSourceId = remoteGpdSourceId;
 
-				clogI << "Will steer source ID 0x"
-				      << std::hex << std::setw(8) << std::setfill('0') << remoteGpdSourceId
-				      << " to channel " << std::dec << static_cast<unsigned int>(targetDot154Channel)
-				      << " using proprietary channel switch command"
-				      << " (using handler #" << static_cast<unsigned int>(this->gpdSentLastHandlerNb) << ")\n";
-				this->gpSend(true, true, CEmberGpAddressStruct(remoteGpdSourceId), GPF_CHANNEL_CONFIGURATION, { static_cast<uint8_t>(0x10U | channelByte) }, 1000, this->gpdSentLastHandlerNb);
-			}
-		}
-	}
+				clogI << "Will steer source ID 0x"
+				      << std::hex << std::setw(8) << std::setfill('0') << remoteGpdSourceId
+				      << " to channel " << std::dec << static_cast<unsigned int>(targetDot154Channel)
+				      << " using proprietary channel switch command\n";
+				this->sendGpdf(remoteGpdSourceId, GPF_CHANNEL_CONFIGURATION, { static_cast<uint8_t>(0x10U | channelByte) }, 1000, [](const CGpTxConfirmation& i_confirmation) {
+					if (i_confirmation.status == EEmberStatus::EMBER_SUCCESS) {
+						clogD << "Channel configuration sent to source ID 0x"
+						      << std::hex << std::setw(8) << std::setfill('0') << i_confirmation.sourceId << "\n";
+					}
+					else {
+						clogW << "Channel configuration could not be sent to source ID 0x"
+						      << std::hex << std::setw(8) << std::setfill('0') << i_confirmation.sourceId
+						      << (i_confirmation.expired ? " (no confirmation from the adapter)" : "") << "\n";
+					}
+				});
+			}
+		}
+	}
+
+	if (gpf.getCommandId() >= GPF_ATTRIBUTE_REPORTING && gpf.getCommandId() <= GPF_MANUFACTURER_MULTI_CLUSTER_REPORTING) {
+		CGpAttributeStoreUpdater l_updater(this->attributeStore);
+		if (!CGpPayloadDecoders::decodeAttributeReporting(gpf, l_updater)) {
+			clogD << "Malformed attribute report from source ID 0x"
+			      << std::hex << std::setw(8) << std::setfill('0') << gpf.getSourceId() << "\n";
+		}
+	}
+
+	// notify
+	notifyObserversOfRxGpFrame( gpf );
+}
+
+void CGpSink::setUnknownSourcePolicy(CGpUnknownSourcePolicy i_policy, unsigned int i_sample_interval) {
+	this->unknownSourceSampleInterval = std::max(i_sample_interval, 1U);
+	this->unknownSourcePolicy = i_policy;
+}
+
+std::size_t CGpSink::getNbFilteredRxGpFrames() const {
+	return this->nbFilteredRxGpFrames;
+}
+
+bool CGpSink::filterRxGpFrame(const NSSPI::ByteBuffer& i_msg_receive) {
+	CGpUnknownSourcePolicy l_policy = this->unknownSourcePolicy;
+	if (l_policy == CGpUnknownSourcePolicy::Process) {
+		return false;
+	}
+	CGpFrame::Header l_header;
+	if (!CGpFrame::peekHeader(i_msg_receive, l_header)) {
+		return false;	/* Let the frame decoder report the error */
+	}
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	bool l_known = this->gp_dev_db.mayContain(l_header.source_id);
+#else
+	bool l_known = (l_header.proxy_table_entry != 0xFF);
+#endif
+	if (l_known) {
+		return false;
+	}
+	if (l_header.security == EGpSecurityLevel::GPD_NO_SECURITY
+	        && (l_header.command_id == GPF_COMMISSIONING_CMD || l_header.command_id == GPF_CHANNEL_REQUEST_CMD)) {
+		return false;	/* Unknown devices are precisely the ones that want to be commissioned */
+	}
+	if (l_policy == CGpUnknownSourcePolicy::Sample && ++this->nbUnknownSourceFrames >= this->unknownSourceSampleInterval) {
+		this->nbUnknownSourceFrames = 0;
+		return false;
+	}
+	this->nbFilteredRxGpFrames++;
+	return true;
+}
+
+void CGpSink::handleEzspRxMessage_INCOMING_MESSAGE_HANDLER(const NSSPI::ByteBuffer& i_msg_receive) {
+	ALLOC_COUNTING_LAYER(GP_SINK);
+	if (this->filterRxGpFrame(i_msg_receive)) {
+		return;	/* Frame from a foreign device, dropped before decoding */
+	}
+	/* Fields are decoded from the ezsp rx message on access, the frame is only copied if it has to outlive this message */
+	CGpFrameView gpf(i_msg_receive);
+	if (!gpf.isValid()) {
+		return;	/* Reason has already been logged by CGpFrameView */
+	}
+
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	/* In hybrid mode, the adapter authenticates frames from the devices we moved into its sink table (it reports other devices' frames with another status) */
+	bool l_ncp_validated = (static_cast<EEmberStatus>(i_msg_receive.at(0)) == EEmberStatus::EMBER_SUCCESS
+	                        && gpf.getSecurity() != EGpSecurityLevel::GPD_NO_SECURITY
+	                        && this->sinkTablePlacement.isNcpResident(gpf.getSourceId()));
+	/* MIC validation is deferred until the end of the current burst of incoming EZSP messages, so that frames received together are validated in one batch */
+	this->rxGpFrames.push_back({gpf.retain(), l_ncp_validated});
+	if (this->rxGpFrames.size() >= RX_GP_FRAME_QUEUE_SIZE) {
+		this->flushRxGpFrames();
+	}
+#else
+	CGpdKeyStatus l_key_status = CGpdKeyStatus::Undefined;
+	EEmberStatus l_status = static_cast<EEmberStatus>(i_msg_receive.at(0));
+	if (l_status == EEmberStatus::EMBER_SUCCESS) {
+		l_key_status = CGpdKeyStatus::Valid;
+	}
+	else if (l_status == EEmberStatus::UNDOCUMENTED_WRONG_MIC_FOR_SOURCE_ID) {
+		l_key_status = CGpdKeyStatus::Invalid;
+	}
+	if (NSSPI::Logger::getInstance()->debugLogger.isOutputting()) {
+		clogD << "handleEzspRxMessage_INCOMING_MESSAGE_HANDLER(): Ember status: " << CEzspEnum::EEmberStatusToString(l_status) << "\n";
+	}
+	if (this->dropDuplicateRxGpFrame(gpf, l_key_status)) {
+		return;
+	}
+	this->handleRxGpFrame(gpf, (gpf.getProxyTableEntry()!=0xFF), l_key_status);
+#endif
+}
+
+#ifdef USE_BUILTIN_MIC_PROCESSING
+void CGpSink::flushRxGpFrames() {
+	if (this->rxGpFrames.empty()) {
+		return;
+	}
+	ALLOC_COUNTING_LAYER(GP_SINK);
+	std::vector<QueuedRxGpFrame> l_frames;
+	l_frames.swap(this->rxGpFrames);	/* Take the queued frames... */
+	this->rxGpFrames.swap(this->rxGpFramesSpare);	/* ...and queue further frames (if we are re-entered from an observer) into the spare storage */
+
+#ifdef USE_CPPTHREADS
+	std::shared_ptr<CGpMicValidationPool> l_pool = CGpMicValidationPool::getShared();	/* Shared by the sinks of all adapters */
+#endif
+	/* The whole queue is validated at once, so that a shared pool can spread it over several cores */
+	for (std::size_t first = 0; first < l_frames.size(); first += RX_GP_FRAME_QUEUE_SIZE) {
+		const CGpFrame* l_batch_frames[RX_GP_FRAME_QUEUE_SIZE];
+		CGPDeviceDb::Lookup l_devices[RX_GP_FRAME_QUEUE_SIZE];
+		const NSSPI::IAes::ExpandedKey* l_batch_keys[RX_GP_FRAME_QUEUE_SIZE];
+		bool l_batch_results[RX_GP_FRAME_QUEUE_SIZE];
+		bool l_dropped[RX_GP_FRAME_QUEUE_SIZE];
+		std::size_t l_copy_of[RX_GP_FRAME_QUEUE_SIZE];	/* Index of an identical frame earlier in the batch (or the frame's own index) */
+		std::size_t l_batch_size = std::min(l_frames.size() - first, static_cast<std::size_t>(RX_GP_FRAME_QUEUE_SIZE));
+		for (std::size_t i = 0; i < l_batch_size; i++) {
+			const CGpFrame& gpf = l_frames[first + i].gpf;
+			l_batch_frames[i] = &gpf;
+			l_devices[i] = this->gp_dev_db.lookup(gpf.getSourceId());	/* Key schedule computed when the device was added to the database */
+			/* Encrypted frames (security level 3) are decrypted in place below rather than only validated in the batch */
+			/* Frames already authenticated (and decrypted) by the adapter are not validated again */
+			bool l_skip_aes = (l_frames[first + i].ncpValidated || gpf.getSecurity() == EGpSecurityLevel::GPD_ENCRYPT_FRM_COUNTER_MIC_SECURITY);
+			l_batch_keys[i] = (l_skip_aes ? nullptr : l_devices[i].expandedKey);
+			l_dropped[i] = false;
+			l_copy_of[i] = i;
+			if (!l_devices[i].found() || !CGpSink::hasFrameCounter(gpf)) {
+				continue;
+			}
+			/* Retransmissions and replays of frames already accepted are dropped before spending any AES computation on them */
+			CGPDeviceDb::FrameCounterCheck l_check = CGPDeviceDb::checkFrameCounter(l_devices[i].nextFrameCounter, gpf.getSecurityFrameCounter());
+			if (l_check != CGPDeviceDb::FrameCounterCheck::FRESH) {
+				this->countDroppedRxGpFrame(gpf, l_check == CGPDeviceDb::FrameCounterCheck::REPLAY);
+				l_dropped[i] = true;
+				l_batch_keys[i] = nullptr;
+				continue;
+			}
+			if (l_frames[first + i].ncpValidated) {
+				continue;
+			}
+			/* Copies of a frame received in the same batch (eg: on several channels) are only authenticated once */
+			for (std::size_t j = 0; j < i; j++) {
+				const CGpFrame& l_other = l_frames[first + j].gpf;
+				if (!l_dropped[j] && l_copy_of[j] == j && l_other.getSourceId() == gpf.getSourceId()
+				        && l_other.getSecurityFrameCounter() == gpf.getSecurityFrameCounter()
+				        && l_other.getMic() == gpf.getMic()) {
+					l_copy_of[i] = j;
+					l_batch_keys[i] = nullptr;
+					break;
+				}
+			}
+		}
+#ifdef USE_CPPTHREADS
+		if (l_pool) {
+			l_pool->validateMICs(l_batch_frames, l_batch_keys, l_batch_size, l_batch_results);	/* Results are consumed below in reception order */
+		}
+		else
+#endif
+		{
+			CGpFrame::validateMICBatch(l_batch_frames, l_batch_keys, l_batch_size, l_batch_results);
+		}
+		for (std::size_t i = 0; i < l_batch_size; i++) {
+			if (l_dropped[i]) {
+				continue;
+			}
+			CGpFrame& gpf = l_frames[first + i].gpf;
+			if (l_devices[i].found() && l_frames[first + i].ncpValidated) {
+				l_batch_results[i] = true;
+			}
+			else if (l_copy_of[i] != i) {
+				l_batch_results[i] = l_batch_results[l_copy_of[i]];	/* Same frame, same MIC, same result (the copy of an encrypted frame is not decrypted) */
+			}
+			else if (l_devices[i].found() && gpf.getSecurity() == EGpSecurityLevel::GPD_ENCRYPT_FRM_COUNTER_MIC_SECURITY) {
+				l_batch_results[i] = gpf.decrypt(*l_devices[i].expandedKey);	/* Handlers below will get the plain text command */
+			}
+			CGpdKeyStatus l_key_status;
+			if (!l_devices[i].found()) {
+				clogD << "No key provisionned for source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << gpf.getSourceId() << "\n";
+				l_key_status = CGpdKeyStatus::Undefined;    /* Unknown source ID... no key */
+			}
+			else if (l_batch_results[i]) {
+				clogD << "MIC is valid for frame from source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << gpf.getSourceId() << "\n";
+				l_key_status = CGpdKeyStatus::Valid;
+				if (CGpSink::hasFrameCounter(gpf)) {
+					/* Only authenticated frames move the frame counter forward, this also drops the copies of a frame accepted earlier in this batch */
+					CGPDeviceDb::FrameCounterCheck l_check = this->gp_dev_db.acceptFrameCounter(gpf.getSourceId(), gpf.getSecurityFrameCounter());
+					if (l_check != CGPDeviceDb::FrameCounterCheck::FRESH) {
+						this->countDroppedRxGpFrame(gpf, l_check == CGPDeviceDb::FrameCounterCheck::REPLAY);
+						continue;
+					}
+				}
+				if (l_frames[first + i].ncpValidated) {
+					this->nbNcpValidatedRxGpFrames++;
+				}
+				this->sinkTablePlacement.recordFrame(gpf.getSourceId());
+			}
+			else {
+				clogD << "MIC is invalid for frame from source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << gpf.getSourceId() << "\n";
+				l_key_status = CGpdKeyStatus::Invalid;
+			}
+			if (this->dropDuplicateRxGpFrame(gpf, l_key_status)) {
+				continue;
+			}
+			this->handleRxGpFrame(gpf, l_devices[i].found(), l_key_status);
+		}
+	}
+	this->gp_dev_db.flushFrameCounters();	/* Write-behind: only writes to disk once in a while */
+	this->updateSinkTablePlacement();
+	l_frames.clear();
+	if (this->rxGpFramesSpare.capacity() < l_frames.capacity()) {
+		this->rxGpFramesSpare.swap(l_frames);	/* Give back the storage for the next flush */
+	}
+}
+
+void CGpSink::updateSinkTablePlacement() {
+	if (this->sinkTablePlacement.isEnabled()) {
+		std::chrono::steady_clock::time_point l_now = std::chrono::steady_clock::now();
+		if (l_now - this->sinkTableEpochStart >= this->sinkTableEpochDuration) {
+			this->sinkTableEpochStart = l_now;
+			this->sinkTablePlacement.endEpoch(this->sinkTableDemotions, this->sinkTablePromotions);
+		}
+	}
+	this->startSinkTableMigration();	/* Also removes devices left in the adapter's sink table once hybrid mode has been disabled */
+}
+
+void CGpSink::startSinkTableMigration() {
+	/* Moves never interleave with the adapter table accesses of other sink operations */
+	/* Demotions first, so that the entries they free are available to the promotions that follow */
+	while (!this->sinkTableMigrationInFlight && this->sink_state == CGpSink::State::SINK_READY && !this->sinkTableDemotions.empty()) {
+		this->sinkTableMigrationPromoting = false;
+		this->sinkTableMigrationSourceId = this->sinkTableDemotions.back();
+		this->sinkTableDemotions.pop_back();
+		clogD << "Moving source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << this->sinkTableMigrationSourceId << " out of the adapter's sink table\n";
+		this->continueSinkTableDemotion();	/* Over at once if the device is not in the adapter's tables */
+	}
+	if (this->sinkTableMigrationInFlight || this->sink_state != CGpSink::State::SINK_READY) {
+		return;
+	}
+	if (!this->sinkTablePromotions.empty()) {
+		this->sinkTableMigrationPromoting = true;
+		this->sinkTableMigrationSourceId = this->sinkTablePromotions.front();
+		this->sinkTablePromotions.erase(this->sinkTablePromotions.begin());
+		this->sinkTableMigrationIndex = 0xFF;
+		clogD << "Moving source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << this->sinkTableMigrationSourceId << " into the adapter's sink table\n";
+		this->awaitSinkTableMigrationResponse(EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY);
+		this->gpSinkTableFindOrAllocateEntry(this->sinkTableMigrationSourceId);
+	}
+}
+
+void CGpSink::continueSinkTableDemotion() {
+	uint32_t l_source_id = this->sinkTableMigrationSourceId;
+	uint8_t l_sink_index;
+	bool l_in_proxy_table;
+	{
+		std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+		l_sink_index = this->sinkTableMirror.find(l_source_id);
+		l_in_proxy_table = (this->proxyTableMirror.find(l_source_id) != CGpTableMirror::NO_ENTRY);
+	}
+	if (l_sink_index != CGpTableMirror::NO_ENTRY) {
+		this->awaitSinkTableMigrationResponse(EZSP_GP_SINK_TABLE_REMOVE_ENTRY);
+		this->gpSinkTableRemoveEntry(l_sink_index);
+	}
+	else if (l_in_proxy_table) {
+		CProcessGpPairingParam l_param(l_source_id);
+		this->awaitSinkTableMigrationResponse(EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING);
+		this->gpProxyTableProcessGpPairing(l_param);
+	}
+	else {
+		this->sinkTablePlacement.demotionDone(l_source_id);
+	}
+}
+
+void CGpSink::awaitSinkTableMigrationResponse(EEzspCmd i_awaited_cmd) {
+	this->sinkTableMigrationAwaitedCmd = i_awaited_cmd;
+	this->sinkTableMigrationInFlight = true;	/* EZSP responses come back in command order: the next response of this type is ours */
+}
+
+void CGpSink::abandonSinkTablePromotion(bool i_allocated) {
+	this->sinkTablePlacement.promotionDone(this->sinkTableMigrationSourceId, false);
+	if (i_allocated) {
+		this->sinkTableDemotions.push_back(this->sinkTableMigrationSourceId);	/* Release the (possibly partially written) entry */
+	}
+}
+
+void CGpSink::handleSinkTableMigrationResponse(EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive) {
+	this->sinkTableMigrationInFlight = false;
+	uint32_t l_source_id = this->sinkTableMigrationSourceId;
+	if (this->sink_state != CGpSink::State::SINK_READY) {
+		/* Another sink operation is now using the adapter's tables: our next command could take one of its responses, give up this move */
+		if (this->sinkTableMigrationPromoting) {
+			this->abandonSinkTablePromotion(i_cmd != EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY || i_msg_receive.at(0) != 0xFF);
+		}
+		else {
+			this->sinkTableDemotions.push_back(l_source_id);	/* Retried once the sink is ready again */
+		}
+		return;
+	}
+	switch (i_cmd) {
+	case EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY: {
+		this->sinkTableMigrationIndex = i_msg_receive.at(0);
+		if (this->sinkTableMigrationIndex == 0xFF) {
+			this->sinkTablePlacement.ncpTableFull();
+			clogW << "Adapter's sink table is full, using " << std::dec << this->sinkTablePlacement.getNcpCapacity() << " entries for hybrid mode\n";
+			this->abandonSinkTablePromotion(false);
+			for (uint32_t l_pending : this->sinkTablePromotions) {
+				this->sinkTablePlacement.promotionDone(l_pending, false);
+			}
+			this->sinkTablePromotions.clear();
+		}
+		else {
+			this->awaitSinkTableMigrationResponse(EZSP_GP_SINK_TABLE_GET_ENTRY);
+			this->gpSinkGetEntry(this->sinkTableMigrationIndex);
+		}
+	}
+	break;
+	case EZSP_GP_SINK_TABLE_GET_ENTRY: {
+		NSSPI::ByteReader l_reader(i_msg_receive);
+		l_reader.readU8();	/* Status, an unused entry is fully overwritten anyway */
+		CEmberGpSinkTableEntryStruct l_entry(l_reader);
+		CGPDeviceDb::Lookup l_device = this->gp_dev_db.lookup(l_source_id);
+		if (l_reader.hasError() || !l_device.found()) {
+			this->abandonSinkTablePromotion(true);
+			break;
+		}
+		/* Same entry as for offline commissioning (see handleEzspRxMessage_SINK_TABLE_GET_ENTRY()), but carrying on from the frame counter accepted by the host */
+		CGpDevice l_gpd(l_source_id, *l_device.key);
+		CEmberGpAddressStruct l_gp_addr(l_source_id);
+		l_entry.setAlias(static_cast<uint16_t>(l_source_id & 0xFFFF));
+		l_entry.setSecurityOption(l_gpd.getSinkSecurityOption());
+		l_entry.setFrameCounter(l_device.nextFrameCounter > 0 ? l_device.nextFrameCounter - 1 : 0);
+		l_entry.setKey(l_gpd.getKey());
+		l_entry.setEntryActive(true);
+		l_entry.setOptions(l_gpd.getSinkOption());
+		l_entry.setGpdAddress(l_gp_addr);
+		this->sink_table_entry = l_entry;
+		this->awaitSinkTableMigrationResponse(EZSP_GP_SINK_TABLE_SET_ENTRY);
+		this->gpSinkSetEntry(this->sinkTableMigrationIndex, l_entry);
+	}
+	break;
+	case EZSP_GP_SINK_TABLE_SET_ENTRY: {
+		if (static_cast<EEmberStatus>(i_msg_receive.at(0)) != EMBER_SUCCESS) {
+			this->abandonSinkTablePromotion(true);
+			break;
+		}
+		CProcessGpPairingParam l_param(this->sink_table_entry, true, false, 0, {0,0,0,0,0,0,0,0});
+		this->awaitSinkTableMigrationResponse(EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING);
+		this->gpProxyTableProcessGpPairing(l_param);
+	}
+	break;
+	case EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING: {
+		if (!this->sinkTableMigrationPromoting) {
+			this->sinkTablePlacement.demotionDone(l_source_id);
+		}
+		else if (!this->sinkTablePlacement.promotionDone(l_source_id, true)) {
+			this->sinkTableDemotions.push_back(l_source_id);	/* Removed from the host database in the meantime */
+		}
+	}
+	break;
+	case EZSP_GP_SINK_TABLE_REMOVE_ENTRY: {
+		this->continueSinkTableDemotion();	/* The proxy table may still have an entry */
+	}
+	break;
+	default:
+		break;
+	}
+	this->startSinkTableMigration();	/* Next move, if the current one is over */
+}
+#endif
+
+bool CGpSink::setNcpSinkTableSize(std::size_t i_nb_entries, std::chrono::milliseconds i_rebalance_interval) {
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	/* Start from scratch: devices currently in the adapter's sink table are moved back to the host */
+	this->sinkTablePlacement.forgetAll(this->sinkTableDemotions);
+	this->sinkTablePromotions.clear();
+	this->sinkTablePlacement.reset(std::max(this->gp_dev_db.capacity(), this->gp_dev_db.size()), i_nb_entries);
+	this->sinkTableDemotions.reserve(this->sinkTableDemotions.size() + 2 * i_nb_entries + NSEZSP::CGpSinkTablePlacement::MAX_PROMOTIONS_PER_EPOCH);
+	this->sinkTablePromotions.reserve(i_nb_entries + NSEZSP::CGpSinkTablePlacement::MAX_PROMOTIONS_PER_EPOCH);
+	this->sinkTableEpochDuration = i_rebalance_interval;
+	this->sinkTableEpochStart = std::chrono::steady_clock::now();
+	this->startSinkTableMigration();
+	return true;
+#else
+	(void)i_nb_entries;
+	(void)i_rebalance_interval;
+	clogE << "Hybrid mode is only available when MICs are processed on the host (USE_BUILTIN_MIC_PROCESSING)\n";
+	return false;
+#endif
+}
+
+std::size_t CGpSink::getNbNcpValidatedRxGpFrames() const {
+	return this->nbNcpValidatedRxGpFrames;
+}
+
+const NSEZSP::CGpAttributeStore& CGpSink::getAttributeStore() const {
+	return this->attributeStore;
+}
 
-	// notify
-	notifyObserversOfRxGpFrame( gpf );
+std::size_t CGpSink::getNbDroppedDuplicateRxGpFrames() const {
+	return this->nbDroppedDuplicateRxGpFrames;
 }
 
-void CGpSink::handleEzspRxMessage_INCOMING_MESSAGE_HANDLER(const NSSPI::ByteBuffer& i_msg_receive) {
-	// build gpf frame from ezsp rx message
-	CGpFrame gpf = CGpFrame(i_msg_receive);
+std::size_t CGpSink::getNbDroppedReplayedRxGpFrames() const {
+	return this->nbDroppedReplayedRxGpFrames;
+}
 
-	CGpdKeyStatus l_key_status = CGpdKeyStatus::Undefined;
-#ifdef USE_BUILTIN_MIC_PROCESSING
-	NSEZSP::EmberKeyData l_gpd_key;    /* Local storage for getKeyForSourceId()'s output key */
-	if (!this->gp_dev_db.getKeyForSourceId(gpf.getSourceId(), l_gpd_key)) {
-		clogD << "No key provisionned for source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << gpf.getSourceId() << "\n";
-		l_key_status = CGpdKeyStatus::Undefined;    /* Unknown source ID... no key */
+bool CGpSink::dropDuplicateRxGpFrame(const CGpFrameView& gpf, CGpdKeyStatus i_key_status) {
+	bool l_duplicate;
+	if (!CGpSink::hasFrameCounter(gpf)) {
+		if (gpf.getCommandId() == GPF_COMMISSIONING_CMD) {
+			return false;	/* GPDs repeat their commissioning frames on purpose, the commissioning counts these repetitions */
+		}
+		l_duplicate = this->rxDuplicateFilter.isDuplicateSequenceNumber(gpf.getSourceId(), gpf.getSequenceNumber(), std::chrono::steady_clock::now());
 	}
+#ifdef USE_BUILTIN_MIC_PROCESSING
 	else {
-		if (gpf.validateMIC(l_gpd_key)) {
-			clogD << "MIC is valid for frame from source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << gpf.getSourceId() << "\n";
-			l_key_status = CGpdKeyStatus::Valid;
-		}
-		else {
-			clogD << "MIC is invalid for frame from source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << gpf.getSourceId() << "\n";
-			l_key_status = CGpdKeyStatus::Invalid;
-		}
+		return false;	/* Already checked against the device database, together with replays (see flushRxGpFrames()) */
 	}
 #else
-	EEmberStatus l_status = static_cast<EEmberStatus>(i_msg_receive.at(0));
-	{
-		l_key_status = CGpdKeyStatus::Undefined;
-		if (l_status == EEmberStatus::EMBER_SUCCESS) {
-			l_key_status = CGpdKeyStatus::Valid;
-		}
-		else if (l_status == EEmberStatus::UNDOCUMENTED_WRONG_MIC_FOR_SOURCE_ID) {
-			l_key_status = CGpdKeyStatus::Invalid;
+	else if (i_key_status == CGpdKeyStatus::Valid) {
+		l_duplicate = this->rxDuplicateFilter.isDuplicateFrameCounter(gpf.getSourceId(), gpf.getSecurityFrameCounter());
+	}
+	else {
+		return false;	/* Only authenticated frame counters are remembered, so that a forged frame cannot mask the genuine one */
+	}
+#endif
+	if (l_duplicate) {
+		this->countDroppedRxGpFrame(gpf, false);
+	}
+	return l_duplicate;
+}
+
+bool CGpSink::hasFrameCounter(const CGpFrameView& i_gpf) {
+	return (i_gpf.getSecurity() == EGpSecurityLevel::GPD_FRM_COUNTER_MIC_SECURITY
+	        || i_gpf.getSecurity() == EGpSecurityLevel::GPD_ENCRYPT_FRM_COUNTER_MIC_SECURITY);
+}
+
+void CGpSink::countDroppedRxGpFrame(const CGpFrameView& i_gpf, bool i_replay) {
+	if (!i_replay) {
+		this->nbDroppedDuplicateRxGpFrames++;
+		if (CGpSink::hasFrameCounter(i_gpf)) {
+			clogD << "Dropping duplicate frame #" << std::dec << i_gpf.getSecurityFrameCounter() << " from source ID 0x"
+			      << std::hex << std::setw(8) << std::setfill('0') << i_gpf.getSourceId() << "\n";
 		}
 		else {
-			l_key_status = CGpdKeyStatus::Undefined;
+			clogD << "Dropping duplicate frame with sequence number " << std::dec << static_cast<unsigned int>(i_gpf.getSequenceNumber())
+			      << " from source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << i_gpf.getSourceId() << "\n";
 		}
 	}
-#endif
-	notifyObserversOfRxGpdId(gpf.getSourceId(), (gpf.getProxyTableEntry()!=0xFF?true:false), l_key_status);
+	else {
+		this->nbDroppedReplayedRxGpFrames++;
+		clogD << "Dropping replayed frame #" << std::dec << i_gpf.getSecurityFrameCounter() << " from source ID 0x"
+		      << std::hex << std::setw(8) << std::setfill('0') << i_gpf.getSourceId() << "\n";
+	}
+}
 
-	clogD << "handleEzspRxMessage_INCOMING_MESSAGE_HANDLER(): "
-#ifndef USE_BUILTIN_MIC_PROCESSING
-	      << "Ember status: " << CEzspEnum::EEmberStatusToString(l_status) << ", "
-#endif
-	      << "key_check: " << static_cast<unsigned int>(l_key_status) << ", "
-	      << gpf << "\n";   /* Dump the whole GP frame */
+void CGpSink::handleRxGpFrame(const CGpFrameView& gpf, bool i_gpd_known, CGpdKeyStatus i_key_status) {
+	if (NSSPI::Logger::getInstance()->debugLogger.isOutputting()) {	/* Only format the whole frame dump when it is actually going to be output */
+		clogD << "handleEzspRxMessage_INCOMING_MESSAGE_HANDLER(): "
+		      << "key_check: " << static_cast<unsigned int>(i_key_status) << ", "
+		      << gpf << "\n";   /* Dump the whole GP frame */
+	}
 
 	/* Notify external observers of the reception of a source ID in any case */
-	{
-		bool gpdKnown;
-#ifdef USE_BUILTIN_MIC_PROCESSING
-		gpdKnown = this->gp_dev_db.isSourceIdInDb(gpf.getSourceId());
-#else
-		gpdKnown = (gpf.getProxyTableEntry()!=0xFF);
-#endif
-		notifyObserversOfRxGpdId(gpf.getSourceId(), gpdKnown, l_key_status);
-	}
+	notifyObserversOfRxGpdId(gpf.getSourceId(), i_gpd_known, i_key_status);
 
 	/**
 	 * GPF frame:
@@ -377,7 +1221,7 @@ void CGpSink::handleEzspRxMessage_INCOMING_MESSAGE_HANDLER(const NSSPI::ByteBuff
 	if (gpf.getSecurity() == EGpSecurityLevel::GPD_NO_SECURITY) {
 		handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_NO_SECURITY(gpf);
 	}
-	else if (l_key_status == CGpdKeyStatus::Valid) {
+	else if (i_key_status == CGpdKeyStatus::Valid) {
 		handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_SECURITY(gpf);
 	}
 	else {
@@ -385,99 +1229,260 @@ void CGpSink::handleEzspRxMessage_INCOMING_MESSAGE_HANDLER(const NSSPI::ByteBuff
 	}
 }
 
-void CGpSink::handleEzspRxMessage_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY(const NSSPI::ByteBuffer& i_msg_receive) {
-	if (CGpSink::State::SINK_COM_IN_PROGRESS == sink_state || SINK_COM_OFFLINE_IN_PROGRESS == sink_state) {
-		sink_table_index = i_msg_receive.at(0); // get allocated index
-		clogD << "EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY response index: 0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(sink_table_index) << "\n";
-		if( 0xFF != sink_table_index ) {
-			gpSinkGetEntry( sink_table_index ); // retrieve the entry at the selected index
-		}
-		else {
-			// no place to record pairing : FAILED
-			clogE << "INVALID SINK TABLE ENTRY, PAIRING FAILED !!" << std::endl;
-			setSinkState(CGpSink::State::SINK_READY);
+void CGpSink::startRegistration(std::size_t i_nb_gpds) {
+	std::lock_guard<std::mutex> lock(this->registrationProgressMutex);
+	this->registrationProgress = { i_nb_gpds, 0, 0, 0.0 };
+	this->registrationStart = std::chrono::steady_clock::now();
+}
+
+void CGpSink::countRegistration(std::size_t i_nb_registered, std::size_t i_nb_failed) {
+	RegistrationProgress l_progress;
+	{
+		std::lock_guard<std::mutex> lock(this->registrationProgressMutex);
+		this->registrationProgress.nbRegistered += i_nb_registered;
+		this->registrationProgress.nbFailed += i_nb_failed;
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - this->registrationStart).count();
+		if (elapsed > 0) {
+			this->registrationProgress.devicesPerSecond = static_cast<double>(this->registrationProgress.nbRegistered) / elapsed;
 		}
+		l_progress = this->registrationProgress;
 	}
-	else {
-		clogD << "EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY: sink_state " << NSEZSP::CGpSink::getStateAsString(this->sink_state) << "\n";
+	std::size_t nbDone = l_progress.nbRegistered + l_progress.nbFailed;
+	if (nbDone == l_progress.nbTotal || nbDone / REGISTRATION_PROGRESS_LOG_INTERVAL != (nbDone - i_nb_registered - i_nb_failed) / REGISTRATION_PROGRESS_LOG_INTERVAL) {
+		clogI << "Registered " << std::dec << l_progress.nbRegistered << "/" << l_progress.nbTotal << " GP devices (" << l_progress.nbFailed << " failed), "
+		      << l_progress.devicesPerSecond << " devices/s\n";
+	}
+	if (nbDone == l_progress.nbTotal) {
+		setSinkState(CGpSink::State::SINK_READY);
 	}
 }
 
-void CGpSink::handleEzspRxMessage_SINK_TABLE_LOOKUP(const NSSPI::ByteBuffer& i_msg_receive) {
-	if (CGpSink::State::SINK_REMOVE_IN_PROGRESS == sink_state) {
-		if( 0xFF != i_msg_receive.at(0) ) {
-			// remove index
-			gpSinkTableRemoveEntry(i_msg_receive.at(0));
-		}
+CGpSink::RegistrationProgress CGpSink::getRegistrationProgress() const {
+	std::lock_guard<std::mutex> lock(this->registrationProgressMutex);
+	return this->registrationProgress;
+}
 
-		// find proxy table entry
-		if (!gpds_to_remove.empty()) {
-			gpProxyTableLookup(gpds_to_remove.back());
-		}
-		else {
-			clogE << "Internal error: trying to use data from empty gpds_to_remove vector\n";
-		}
+void CGpSink::registerNextGpd() {
+	if (!this->gpds_to_register.empty()) {
+		gpSinkTableFindOrAllocateEntry(this->gpds_to_register.back().getSourceId());
 	}
 }
 
-void CGpSink::handleEzspRxMessage_SINK_TABLE_GET_ENTRY(const NSSPI::ByteBuffer& i_msg_receive) {
-	EEmberStatus l_status = static_cast<EEmberStatus>(i_msg_receive.at(0));
-	CEmberGpSinkTableEntryStruct l_entry({i_msg_receive.begin()+1,i_msg_receive.end()});
-	CEmberGpSinkTableOption l_options;
-	CEmberGpAddressStruct l_gp_addr;
+void CGpSink::writeRegisteredGpdEntry(CEmberGpSinkTableEntryStruct& i_entry) {
+	if (this->gpds_to_register.empty()) {
+		clogE << "Internal error: trying to use data from empty gpds_to_register vector\n";
+		return;
+	}
+	const NSEZSP::CGpDevice& new_gpd_to_register = this->gpds_to_register.back();
+	CEmberGpAddressStruct l_gp_addr(new_gpd_to_register.getSourceId());
+
+	i_entry.setAlias(static_cast<uint16_t>(l_gp_addr.getSourceId()&0xFFFF));
+	i_entry.setSecurityOption(new_gpd_to_register.getSinkSecurityOption());
+	i_entry.setFrameCounter(0);
+	i_entry.setKey(new_gpd_to_register.getKey());
+	i_entry.setEntryActive(true);
+	i_entry.setOptions(new_gpd_to_register.getSinkOption());
+	i_entry.setGpdAddress(l_gp_addr);
+	clogD << "Update table entry : " << i_entry << "\n";
+
+	gpSinkSetEntry(this->sink_table_index, i_entry);
+	this->sink_table_entry = i_entry;	/* Used for the proxy pairing, once the entry is written */
+	this->gpds_to_register.pop_back();
+
+	/* Do not wait for this device to be paired before allocating an entry for the next one: the adapter processes commands in order,
+	 * so the entry allocated to the next device cannot be the one we are writing. The command queue thus never runs dry. */
+	this->registerNextGpd();
+}
 
-	// debug
-	clogD << "EZSP_GP_SINK_TABLE_GET_ENTRY Response status: " <<  CEzspEnum::EEmberStatusToString(l_status) << ", table entry: " << l_entry << "\n";
+bool CGpSink::isNcpSinkTableEntryFree(uint8_t i_index) const {
+	std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+	return this->sinkTableMirror.isBlank(i_index);
+}
 
-	if (CGpSink::State::SINK_COM_IN_PROGRESS == sink_state) { /* Create new state to parse each entry sequentially, check l_status, if SUCCESS, we found an entry, otherwise out-of-bounds */
-		/* If valid, notify the caller, if invalid, continue progressing (issue a new gpSinkGetEntry() on the next index until out-of-bounds) */
-		// decode payload
-		CGpdCommissioningPayload l_payload(gpf_comm_frame.getPayload(),gpf_comm_frame.getSourceId());
+CGpTableMirror CGpSink::getSinkTableMirror() const {
+	std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+	return this->sinkTableMirror;
+}
 
-		// debug
-		clogD << "GPD Commissioning payload: " << l_payload << "\n";
+CGpTableMirror CGpSink::getProxyTableMirror() const {
+	std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+	return this->proxyTableMirror;
+}
 
-		// update sink table entry
-		l_gp_addr = CEmberGpAddressStruct(gpf_comm_frame.getSourceId());
-		l_options = CEmberGpSinkTableOption(l_gp_addr.getApplicationId(),l_payload);
+void CGpSink::sendNcpTableCommand(const PendingNcpTableUpdate& i_update, const NSSPI::ByteBuffer& i_payload) {
+	{
+		std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+		this->pendingNcpTableUpdates.push_back(i_update);	/* Queued before sending, so that the response cannot overtake the update */
+	}
+	/* The lock is not held while sending: the serial driver notifies incoming messages (thus invokes applyNcpTableUpdate()) under its own lock
+	 * Commands modifying the tables are sent by one thread at a time anyway, as sink operations only start from SINK_READY */
+	dongle.sendCommand(i_update.cmd, i_payload);
+}
 
-		l_entry.setDeviceId(l_payload.getDeviceId());
-		l_entry.setAlias(static_cast<uint16_t>(gpf_comm_frame.getSourceId()&0xFFFF));
-		l_entry.setSecurityOption(l_payload.getExtendedOption()&0x1F);
-		l_entry.setFrameCounter(l_payload.getOutFrameCounter());
-		l_entry.setKey(l_payload.getKey());
+void CGpSink::applyNcpTableUpdate(EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive) {
+	switch (i_cmd) {
+	case EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY:
+	case EZSP_GP_SINK_TABLE_SET_ENTRY:
+	case EZSP_GP_SINK_TABLE_REMOVE_ENTRY:
+	case EZSP_GP_SINK_TABLE_CLEAR_ALL:
+	case EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING:
+		break;
+	default:
+		return;
 	}
-	else if (CGpSink::State::SINK_COM_OFFLINE_IN_PROGRESS == sink_state) {
-		// update sink table entry
-		if (!gpds_to_register.empty()) {
-			NSEZSP::CGpDevice& new_gpd_to_register = gpds_to_register.back();
-			l_gp_addr = CEmberGpAddressStruct(new_gpd_to_register.getSourceId());
-			l_options = new_gpd_to_register.getSinkOption();
+	std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+	/* EZSP responses come back in command order: the oldest pending update for this command is the one performed */
+	auto it = std::find_if(this->pendingNcpTableUpdates.begin(), this->pendingNcpTableUpdates.end(),
+	[i_cmd](const PendingNcpTableUpdate& i_update) {
+		return i_update.cmd == i_cmd;
+	});
+	if (it == this->pendingNcpTableUpdates.end()) {
+		clogW << "Unexpected response to " << CEzspEnum::EEzspCmdToString(i_cmd) << ", the host-side copies of the adapter's tables may be out of date\n";
+		return;
+	}
+	PendingNcpTableUpdate l_update = *it;
+	this->pendingNcpTableUpdates.erase(it);
+	switch (i_cmd) {
+	case EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY:
+		if (!i_msg_receive.empty()) {
+			this->sinkTableMirror.allocateEntry(i_msg_receive[0], l_update.entry.sourceId);
+		}
+		break;
+	case EZSP_GP_SINK_TABLE_SET_ENTRY:
+		/* Even if the write failed, the entry may not be blank anymore, it is thus considered used */
+		this->sinkTableMirror.setEntry(l_update.index, l_update.entry);
+		break;
+	case EZSP_GP_SINK_TABLE_REMOVE_ENTRY:
+		this->sinkTableMirror.removeEntry(l_update.index);
+		break;
+	case EZSP_GP_SINK_TABLE_CLEAR_ALL:
+		this->sinkTableMirror.clear();
+		break;
+	case EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING:
+		if (!l_update.addSink) {
+			this->proxyTableMirror.removeSourceId(l_update.entry.sourceId);
+		}
+		else if ((!i_msg_receive.empty() && i_msg_receive[0] != 0)
+		         || this->proxyTableMirror.find(l_update.entry.sourceId) != CGpTableMirror::NO_ENTRY) {	/* Pairing added, or existing entry updated */
+			if (this->proxyTableMirror.addEntry(l_update.entry) == CGpTableMirror::NO_ENTRY) {
+				clogW << "Adapter added a GP pairing while its proxy table was believed to be full\n";
+			}
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void CGpSink::countNcpTableResponse() {
+	bool l_done;
+	{
+		std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+		if (this->nbPendingNcpTableResponses > 0) {
+			this->nbPendingNcpTableResponses--;
+		}
+		l_done = (this->nbPendingNcpTableResponses == 0);
+	}
+	if (l_done) {
+		this->ncpTableJobDone();
+	}
+}
+
+void CGpSink::ncpTableJobDone() {
+	if (!this->gpds_to_sync.empty()) {
+		std::vector<CGpDevice> l_gpds;
+		swap(l_gpds, this->gpds_to_sync);
+		this->startNcpRegistration(l_gpds);	/* Second step of syncGpds() */
+		return;
+	}
+	setSinkState(CGpSink::State::SINK_READY);
+}
 
-			l_entry.setAlias(static_cast<uint16_t>(l_gp_addr.getSourceId()&0xFFFF));
-			l_entry.setSecurityOption(new_gpd_to_register.getSinkSecurityOption());
-			l_entry.setFrameCounter(0);
-			l_entry.setKey(new_gpd_to_register.getKey());
+void CGpSink::handleEzspRxMessage_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY(const NSSPI::ByteBuffer& i_msg_receive) {
+	if (CGpSink::State::SINK_COM_IN_PROGRESS == sink_state || SINK_COM_OFFLINE_IN_PROGRESS == sink_state) {
+		sink_table_index = i_msg_receive.at(0); // get allocated index
+		clogD << "EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY response index: 0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(sink_table_index) << "\n";
+		if( 0xFF == sink_table_index ) {
+			// no place to record pairing : FAILED
+			clogE << "INVALID SINK TABLE ENTRY, PAIRING FAILED !!" << std::endl;
+			if (CGpSink::State::SINK_COM_OFFLINE_IN_PROGRESS == sink_state) {
+				/* The table is full, none of the remaining devices can be registered */
+				std::size_t nbFailed = this->gpds_to_register.size();
+				this->gpds_to_register.clear();
+				this->countRegistration(0, nbFailed);
+			}
+			else {
+				bool l_allocating;
+				uint32_t l_source_id;
+				{
+					std::lock_guard<std::mutex> lock(this->commissioningMutex);
+					l_allocating = this->commissioningAllocating;
+					l_source_id = this->commissioningAllocatingSourceId;	/* Overwritten as soon as the next device is allocated an entry */
+					this->commissioningAllocating = false;
+				}
+				if (l_allocating) {
+					this->finishCommissioning(l_source_id, false);
+					this->commissionNextGpd();	/* Entries may be freed in the meantime */
+				}
+			}
+		}
+		else if (this->isNcpSinkTableEntryFree(sink_table_index)) {
+			CEmberGpSinkTableEntryStruct l_entry;	/* No need to read back an entry we know is blank */
+			l_entry.setGroupcastRadius(0xFF);	/* As in a blank entry of the adapter's table */
+			if (CGpSink::State::SINK_COM_OFFLINE_IN_PROGRESS == sink_state) {
+				this->writeRegisteredGpdEntry(l_entry);
+			}
+			else {
+				this->writeCommissionedGpdEntry(l_entry);
+			}
 		}
 		else {
-			clogE << "Internal error: trying to use data from empty gpds_to_register vector\n";
+			gpSinkGetEntry( sink_table_index ); // retrieve the entry at the selected index
 		}
 	}
 	else {
-		clogW << "Ignoring EZSP_GP_SINK_TABLE_GET_ENTRY because we are in sink_state " << NSEZSP::CGpSink::getStateAsString(this->sink_state) << "\n";
+		clogD << "EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY: sink_state " << NSEZSP::CGpSink::getStateAsString(this->sink_state) << "\n";
+	}
+}
+
+void CGpSink::handleEzspRxMessage_SINK_TABLE_GET_ENTRY(const NSSPI::ByteBuffer& i_msg_receive) {
+	NSSPI::ByteReader l_reader(i_msg_receive);
+	EEmberStatus l_status = static_cast<EEmberStatus>(l_reader.readU8());
+	if (CGpSink::State::SINK_TABLES_LOAD_IN_PROGRESS == sink_state && EMBER_SUCCESS != l_status) {
+		/* Assume end of table, continue with the proxy table */
+		this->loadProxyTableEntry(0);
+		return;
+	}
+	CEmberGpSinkTableEntryStruct l_entry(l_reader);
+	if (l_reader.hasError()) {
+		clogE << "Truncated EZSP_GP_SINK_TABLE_GET_ENTRY response: " << i_msg_receive << "\n";
 		return;
 	}
-	l_entry.setEntryActive(true);
-	l_entry.setOptions(l_options);
-	l_entry.setGpdAddress(l_gp_addr);
 	// debug
-	clogD << "Update table entry : " << l_entry << std::endl;
-
-	// call
-	gpSinkSetEntry(sink_table_index,l_entry);
+	clogD << "EZSP_GP_SINK_TABLE_GET_ENTRY Response status: " <<  CEzspEnum::EEmberStatusToString(l_status) << ", table entry: " << l_entry << "\n";
 
-	// save
-	sink_table_entry = l_entry;
+	if (CGpSink::State::SINK_TABLES_LOAD_IN_PROGRESS == sink_state) {
+		{
+			std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+			if (l_entry.isActive()) {
+				this->sinkTableMirror.loadEntry(sink_table_index, mirrorEntry(l_entry.getGpdAddr().getSourceId(), l_entry.getOption().get(), l_entry.getSecurityOption(), l_entry.getGpdKey()));
+			}
+			else {
+				this->sinkTableMirror.loadEntry(sink_table_index, CGpTableMirror::Entry());
+			}
+		}
+		this->loadSinkTableEntry(static_cast<uint8_t>(sink_table_index + 1U));
+		return;
+	}
+	else if (CGpSink::State::SINK_COM_IN_PROGRESS == sink_state) {
+		this->writeCommissionedGpdEntry(l_entry);
+	}
+	else if (CGpSink::State::SINK_COM_OFFLINE_IN_PROGRESS == sink_state) {
+		this->writeRegisteredGpdEntry(l_entry);
+	}
+	else {
+		clogW << "Ignoring EZSP_GP_SINK_TABLE_GET_ENTRY because we are in sink_state " << NSEZSP::CGpSink::getStateAsString(this->sink_state) << "\n";
+	}
 }
 
 void CGpSink::handleEzspRxMessage_SINK_TABLE_SET_ENTRY(const NSSPI::ByteBuffer& i_msg_receive) {
@@ -488,9 +1493,19 @@ void CGpSink::handleEzspRxMessage_SINK_TABLE_SET_ENTRY(const NSSPI::ByteBuffer&
 		clogD << "EZSP_GP_SINK_TABLE_SET_ENTRY Response status :" <<  CEzspEnum::EEmberStatusToString(l_status) << "\n";
 
 		if( EMBER_SUCCESS != l_status ) {
-			// error
-			clogD << "ERROR, Stop commissioning process !!\n";
-			setSinkState(CGpSink::State::SINK_READY);
+			if (CGpSink::State::SINK_COM_OFFLINE_IN_PROGRESS == sink_state) {
+				clogE << "Failed writing sink table entry at index 0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(sink_table_index)
+				      << ", skipping this device\n";
+				this->countRegistration(0, 1);	/* Other devices of the job are not affected */
+			}
+			else {
+				uint32_t l_source_id;
+				if (this->popCommissioningWrite(l_source_id)) {
+					clogE << "Failed writing sink table entry at index 0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(sink_table_index)
+					      << " for commissioned source ID 0x" << std::setw(8) << l_source_id << "\n";
+					this->finishCommissioning(l_source_id, false);
+				}
+			}
 		}
 		else {
 			// do proxy pairing
@@ -502,45 +1517,31 @@ void CGpSink::handleEzspRxMessage_SINK_TABLE_SET_ENTRY(const NSSPI::ByteBuffer&
 	}
 }
 
-void CGpSink::handleEzspRxMessage_PROXY_TABLE_LOOKUP(const NSSPI::ByteBuffer& i_msg_receive) {
-	if (CGpSink::State::SINK_REMOVE_IN_PROGRESS == sink_state) {
-		if( 0xFF != i_msg_receive.at(0) ) {
-			if (!gpds_to_remove.empty()) {
-				// remove index
-				CProcessGpPairingParam l_param(gpds_to_remove.back());
-				gpProxyTableProcessGpPairing(l_param);
-			}
-		}
-
-		// find next sink table entry
-		if (!gpds_to_remove.empty()) {
-			gpds_to_remove.pop_back();
-		}
-		if (gpds_to_remove.empty())	{
-			// No more gpd to remove
-			setSinkState(CGpSink::State::SINK_READY);
-		}
-		else {
-			gpSinkTableLookup(gpds_to_remove.back());
-		}
-	}
-}
-
 void CGpSink::handleEzspRxMessage_PROXY_TABLE_GET_ENTRY(const NSSPI::ByteBuffer& i_msg_receive) {
-	if (CGpSink::State::SINK_CLEAR_ALL == sink_state) {
-		EEmberStatus l_status = static_cast<EEmberStatus>(i_msg_receive.at(0));
+	if (CGpSink::State::SINK_TABLES_LOAD_IN_PROGRESS == sink_state) {
+		NSSPI::ByteReader l_reader(i_msg_receive);
+		EEmberStatus l_status = static_cast<EEmberStatus>(l_reader.readU8());
 		if( EMBER_SUCCESS == l_status ) {
-			// do remove action
-			CEmberGpProxyTableEntryStruct l_entry(NSSPI::ByteBuffer(i_msg_receive.begin()+1,i_msg_receive.end()));
-			CProcessGpPairingParam l_param(l_entry.getGpdAddress().getSourceId());
-			gpProxyTableProcessGpPairing(l_param);
+			CEmberGpProxyTableEntryStruct l_entry(l_reader);
+			if (l_reader.hasError()) {
+				clogE << "Truncated EZSP_GP_PROXY_TABLE_GET_ENTRY response: " << i_msg_receive << "\n";
+				return;
+			}
+			{
+				std::lock_guard<std::mutex> lock(this->ncpTablesMutex);
+				if (l_entry.isActive()) {
+					this->proxyTableMirror.loadEntry(proxy_table_index, mirrorEntry(l_entry.getGpdAddress().getSourceId(), l_entry.getOptions()));
+				}
+				else {
+					this->proxyTableMirror.loadEntry(proxy_table_index, CGpTableMirror::Entry());
+				}
+			}
+			this->loadProxyTableEntry(static_cast<uint8_t>(proxy_table_index + 1U));
 		}
 		else {
 			// assume end of table
-			// set new state
-			setSinkState(CGpSink::State::SINK_READY);
+			this->loadProxyTableEntry(CGpTableMirror::NO_ENTRY);
 		}
-
 	}
 }
 
@@ -548,34 +1549,44 @@ void CGpSink::handleEzspRxMessage_PROXY_TABLE_PROCESS_GP_PAIRING(const NSSPI::By
 	if (CGpSink::State::SINK_COM_IN_PROGRESS == sink_state) {
 		clogD << "CGpSink::ezspHandler EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING gpPairingAdded : " << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(i_msg_receive[0]) << "\n";
 
-		// close commissioning session
-		closeCommissioningSession();
+		uint32_t l_source_id;
+		if (this->popCommissioningWrite(l_source_id)) {
+			this->finishCommissioning(l_source_id, true);
+		}
 	}
 	else if (CGpSink::State::SINK_COM_OFFLINE_IN_PROGRESS == sink_state) {
 		clogD << "CGpSink::ezspHandler EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING gpPairingAdded : " << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(i_msg_receive[0]) << "\n";
 
-		gpds_to_register.pop_back();
-
-		if (!gpds_to_register.empty()) {
-			// request sink table entry
-			gpSinkTableFindOrAllocateEntry(gpds_to_register.back().getSourceId());
-		}
-		else {  /* We reached the end of the vector of gpds to register */
-			// set state
-			setSinkState(CGpSink::State::SINK_READY);
-		}
+		/* The next device has already been sent to the adapter, see writeRegisteredGpdEntry() */
+		this->countRegistration(1, 0);
 	}
-	else if (CGpSink::State::SINK_CLEAR_ALL == sink_state) {
-		// retrieve next entry
-		proxy_table_index++;
-		dongle.sendCommand(EZSP_GP_PROXY_TABLE_GET_ENTRY, { proxy_table_index });
+	else if (CGpSink::State::SINK_CLEAR_ALL == sink_state || CGpSink::State::SINK_REMOVE_IN_PROGRESS == sink_state) {
+		this->countNcpTableResponse();
 	}
 	else {
 		clogW << "Ignoring EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING because we are in sink_state " << NSEZSP::CGpSink::getStateAsString(this->sink_state) << "\n";
 	}
 }
 
-void CGpSink::handleEzspRxMessage(EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_receive) {
+void CGpSink::handleEzspRxBurstEnd() {
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	this->flushRxGpFrames();
+#endif
+}
+
+void CGpSink::handleEzspRxMessage(EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive) {
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	if (i_cmd != EZSP_GPEP_INCOMING_MESSAGE_HANDLER) {
+		this->flushRxGpFrames();	/* Process queued GP frames before any other message, to preserve the reception order */
+	}
+	this->applyNcpTableUpdate(i_cmd, i_msg_receive);	/* Also for the responses to background moves */
+	if (this->sinkTableMigrationInFlight && i_cmd == this->sinkTableMigrationAwaitedCmd) {
+		this->handleSinkTableMigrationResponse(i_cmd, i_msg_receive);	/* Response to a background move, not to a sink operation */
+		return;
+	}
+#else
+	this->applyNcpTableUpdate(i_cmd, i_msg_receive);
+#endif
 	switch( i_cmd ) {
 	case EZSP_GP_PROXY_TABLE_GET_ENTRY: {
 		handleEzspRxMessage_PROXY_TABLE_GET_ENTRY(i_msg_receive);
@@ -599,13 +1610,11 @@ void CGpSink::handleEzspRxMessage(EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_receiv
 	}
 	break;
 
-	case EZSP_GP_SINK_TABLE_LOOKUP: {
-		handleEzspRxMessage_SINK_TABLE_LOOKUP(i_msg_receive);
-	}
-	break;
-
-	case EZSP_GP_PROXY_TABLE_LOOKUP: {
-		handleEzspRxMessage_PROXY_TABLE_LOOKUP(i_msg_receive);
+	case EZSP_GP_SINK_TABLE_REMOVE_ENTRY:
+	case EZSP_GP_SINK_TABLE_CLEAR_ALL: {
+		if (CGpSink::State::SINK_CLEAR_ALL == sink_state || CGpSink::State::SINK_REMOVE_IN_PROGRESS == sink_state) {
+			this->countNcpTableResponse();
+		}
 	}
 	break;
 
@@ -635,24 +1644,26 @@ void CGpSink::handleEzspRxMessage(EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_receiv
 	case EZSP_D_GP_SENT_HANDLER: {
 		EEmberStatus l_status = static_cast<EEmberStatus>(i_msg_receive.at(0));
 		uint8_t gpepHandle = i_msg_receive.at(1); // The handle of the GPDF transmission
+		CGpTxConfirmation l_confirmation;
+		CGpTxTable::FSentCallback l_callback;
+		bool l_known;
 
-		if (EMBER_SUCCESS == l_status) {
+		{
 			std::lock_guard<std::mutex> gpdSentStateLock(this->gpdSentStateMutex);
-			if (gpepHandle != this->gpdSentLastHandlerNb) {
-				clogW << "Got a success for GPDF transmission that we don't know about (handle #" << std::dec << static_cast<unsigned int>(gpepHandle) << "). Discarding\n";
-			}
-			else if (this->sentChannelSwitchSourceId == 0) {
-				clogW << "Got a success for GPDF transmission at handle #"
-				      << std::dec << static_cast<unsigned int>(gpepHandle)
-				      << " but we have not stored its source ID. This is a bug. Discarding\n";
+			l_known = this->gpdSentPending.confirm(gpepHandle, l_status, std::chrono::steady_clock::now(), l_confirmation, l_callback);
+		}
+		if (!l_known) {
+			if (gpepHandle != CGpTxTable::NO_HANDLE) {
+				clogW << "Got a confirmation for GPDF transmission that we don't know about (handle #" << std::dec << static_cast<unsigned int>(gpepHandle) << ", it may have expired). Discarding\n";
 			}
-			else {
-				clogD << "Got a success for GPDF transmission at handle #"
-				      << std::dec << static_cast<unsigned int>(gpepHandle)
-				      << " (pending response to source ID 0x"
-				      << std::hex << std::setw(8) << std::setfill('0') << this->sentChannelSwitchSourceId << ")\n";
-				this->sentChannelSwitchSourceId = 0;	/* Forget about the source ID that we were waiting for */
-				this->gpdSentLastHandlerNb--;
+		}
+		else {
+			clogD << "Got a confirmation for GPDF transmission at handle #"
+			      << std::dec << static_cast<unsigned int>(gpepHandle)
+			      << " (to source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << l_confirmation.sourceId
+			      << ") after " << std::dec << l_confirmation.latency.count() << "us\n";
+			if (l_callback) {
+				l_callback(l_confirmation);
 			}
 		}
 
@@ -687,27 +1698,39 @@ void CGpSink::handleEzspRxMessage(EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_receiv
 }
 
 bool CGpSink::registerObserver(CGpObserver* observer) {
-	return this->observers.emplace(observer).second;
+	return this->observers.add(observer);
 }
 
 bool CGpSink::unregisterObserver(CGpObserver* observer) {
-	return static_cast<bool>(this->observers.erase(observer));
+	return this->observers.remove(observer);
 }
 
 void CGpSink::registerStateCallback(std::function<bool (CGpSink::State& i_state)> newObsStateCallback) {
 	this->obsStateCallback=newObsStateCallback;
 }
 
-void CGpSink::notifyObserversOfRxGpFrame( CGpFrame i_gpf ) {
-	for(auto observer : this->observers) {
+void CGpSink::notifyObserversOfRxGpFrame( const CGpFrameView& i_gpf ) {
+	this->observers.forEach([&i_gpf](CGpObserver* observer) {
 		observer->handleRxGpFrame( i_gpf );
-	}
+	});
 }
 
 void CGpSink::notifyObserversOfRxGpdId( uint32_t i_gpd_id, bool i_gpd_known, CGpdKeyStatus i_gpd_key_status ) {
-	for(auto observer : this->observers) {
+	this->observers.forEach([&i_gpd_id, &i_gpd_known, &i_gpd_key_status](CGpObserver* observer) {
 		observer->handleRxGpdId( i_gpd_id, i_gpd_known, i_gpd_key_status );
-	}
+	});
+}
+
+void CGpSink::notifyObserversOfGpdCommissioning( const CGpCommissioningReport& i_report ) {
+	this->observers.forEach([&i_report](CGpObserver* observer) {
+		observer->handleGpdCommissioning( i_report );
+	});
+}
+
+void CGpSink::notifyObserversOfGpdLiveness( const CGpLivenessReport& i_report ) {
+	this->observers.forEach([&i_report](CGpObserver* observer) {
+		observer->handleGpdLiveness( i_report );
+	});
 }
 
 void CGpSink::sendLocalGPProxyCommissioningMode(uint8_t i_option) {
@@ -719,11 +1742,11 @@ void CGpSink::sendLocalGPProxyCommissioningMode(uint8_t i_option) {
 
 	// options:
 	// bit0 (Action) : 0b1 / request to enter commissioning mode
-	// bit1-3 (exit mode) : 0b010 / On first Pairing success
+	// bit1-3 (exit mode) : 0b100 / On GP Proxy Commissioning Mode (exit) command, several devices can be paired
 	// bit4 (channel present) : 0b0 / shall always be set to 0 according current spec.
 	// bit5 (unicast communication) : 0b0 / send GP Commissioning Notification commands in broadcast
 	// bit6-7 (reserved)
-	l_gp_comm_payload.push_back(i_option); // 0x05 => open
+	l_gp_comm_payload.push_back(i_option); // 0x09 => open
 
 	// comm windows 2 bytes
 	// present only if exit mode flag On commissioning Window expiration (bit0) is set
@@ -880,7 +1903,7 @@ void CGpSink::gpSinkTableFindOrAllocateEntry( uint32_t i_src_id ) {
 	CEmberGpAddressStruct l_gp_address(i_src_id);
 
 	clogD << "EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY on source ID: " << std::hex << std::setfill('0') << std::setw(4) << i_src_id << "\n";
-	dongle.sendCommand(EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY, l_gp_address.getRaw());
+	this->sendNcpTableCommand({ EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY, CGpTableMirror::NO_ENTRY, mirrorEntry(i_src_id), false }, l_gp_address.getRaw());
 }
 
 void CGpSink::gpSinkGetEntry( uint8_t i_index ) {
@@ -900,13 +1923,15 @@ void CGpSink::gpSinkSetEntry( uint8_t i_index, CEmberGpSinkTableEntryStruct& i_e
 	l_payload.insert(l_payload.end(), i_struct.begin(), i_struct.end());
 
 	clogD << "EZSP_GP_SINK_TABLE_SET_ENTRY\n";
-	dongle.sendCommand(EZSP_GP_SINK_TABLE_SET_ENTRY,l_payload);
+	this->sendNcpTableCommand({ EZSP_GP_SINK_TABLE_SET_ENTRY, i_index,
+	                            mirrorEntry(i_entry.getGpdAddr().getSourceId(), i_entry.getOption().get(), i_entry.getSecurityOption(), i_entry.getGpdKey()), false }, l_payload);
 }
 
 
 void CGpSink::gpProxyTableProcessGpPairing( CProcessGpPairingParam& i_param ) {
 	clogD << "EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING\n";
-	dongle.sendCommand(EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING,i_param.get());
+	this->sendNcpTableCommand({ EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING, CGpTableMirror::NO_ENTRY, mirrorEntry(i_param.getGpdSourceId(), i_param.getOptions().get()), i_param.getOptions().isAddSink() },
+	                          i_param.get());
 }
 
 void CGpSink::gpSend(bool i_action, bool i_use_cca, CEmberGpAddressStruct i_gp_addr,
@@ -941,21 +1966,248 @@ void CGpSink::gpSend(bool i_action, bool i_use_cca, CEmberGpAddressStruct i_gp_a
 	dongle.sendCommand(EZSP_D_GP_SEND,l_payload);
 }
 
-void CGpSink::gpSinkTableRemoveEntry( uint8_t i_index ) {
-	clogD << "EZSP_GP_SINK_TABLE_REMOVE_ENTRY\n";
-	dongle.sendCommand(EZSP_GP_SINK_TABLE_REMOVE_ENTRY, { i_index });
+bool CGpSink::sendGpdf(uint32_t i_source_id, uint8_t i_command_id, const NSSPI::ByteBuffer& i_payload, uint16_t i_life_time_ms, CGpTxTable::FSentCallback i_callback) {
+	std::chrono::steady_clock::time_point l_now = std::chrono::steady_clock::now();
+	uint8_t l_handle;
+	bool l_start_timer;
+	uint32_t l_timeout_ms = 0;
+	{
+		std::lock_guard<std::mutex> gpdSentStateLock(this->gpdSentStateMutex);
+		if (!this->gpdSentPending.allocate(i_source_id, i_command_id, l_now, std::chrono::milliseconds(i_life_time_ms) + GPDF_CONFIRMATION_MARGIN, std::move(i_callback), l_handle)) {
+			clogE << "Too many GPDF transmissions pending, cannot send command 0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(i_command_id)
+			      << " to source ID 0x" << std::setw(8) << i_source_id << "\n";
+			return false;
+		}
+		l_start_timer = this->armGpdfExpiryTimer(l_now, l_timeout_ms);
+	}
+	if (l_start_timer) {
+		this->startGpdfExpiryTimer(l_timeout_ms);
+	}
+	clogD << "Sending GPDF command 0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(i_command_id)
+	      << " to source ID 0x" << std::setw(8) << i_source_id << " using handle #" << std::dec << static_cast<unsigned int>(l_handle) << "\n";
+	this->gpSend(true, true, CEmberGpAddressStruct(i_source_id), i_command_id, i_payload, i_life_time_ms, l_handle);
+	return true;
+}
+
+std::size_t CGpSink::getNbPendingGpdfTransmissions() const {
+	std::lock_guard<std::mutex> gpdSentStateLock(this->gpdSentStateMutex);
+	return this->gpdSentPending.getNbPending();
+}
+
+CGpTxTable::LatencyStats CGpSink::getGpdfTxLatencyStats() const {
+	std::lock_guard<std::mutex> gpdSentStateLock(this->gpdSentStateMutex);
+	return this->gpdSentPending.getLatencyStats();
+}
+
+bool CGpSink::armGpdfExpiryTimer(std::chrono::steady_clock::time_point i_now, uint32_t& o_timeout_ms) {
+	std::chrono::steady_clock::time_point l_deadline;
+	if (this->gpdSentTimerArmed || !this->gpdSentPending.getNextDeadline(l_deadline)) {
+		return false;	/* Deadlines of transmissions allocated while the timer is armed are checked when it expires */
+	}
+	this->gpdSentTimerArmed = true;
+	std::chrono::milliseconds l_timeout = std::chrono::duration_cast<std::chrono::milliseconds>(l_deadline - i_now) + std::chrono::milliseconds(1);
+	o_timeout_ms = static_cast<uint32_t>(std::max(l_timeout.count(), static_cast<std::chrono::milliseconds::rep>(1)));
+	return true;
+}
+
+void CGpSink::startGpdfExpiryTimer(uint32_t i_timeout_ms) {
+	/* Never started while holding gpdSentStateMutex, as restarting the timer waits for its previous callback to return */
+	this->gpdSentTimer->start(i_timeout_ms, [this](NSSPI::ITimer* triggeringTimer) {
+		(void)triggeringTimer;
+		this->expireGpdfTransmissions();
+	});
+}
+
+void CGpSink::expireGpdfTransmissions() {
+	std::vector<std::pair<CGpTxConfirmation, CGpTxTable::FSentCallback> > l_expired;
+	bool l_restart_timer;
+	uint32_t l_timeout_ms = 0;
+	{
+		std::lock_guard<std::mutex> gpdSentStateLock(this->gpdSentStateMutex);
+		std::chrono::steady_clock::time_point l_now = std::chrono::steady_clock::now();
+		this->gpdSentPending.expire(l_now, l_expired);
+		this->gpdSentTimerArmed = false;
+		l_restart_timer = this->armGpdfExpiryTimer(l_now, l_timeout_ms);
+	}
+	for (auto& expired : l_expired) {
+		clogW << "No confirmation received for GPDF transmission at handle #" << std::dec << static_cast<unsigned int>(expired.first.handle)
+		      << " (to source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << expired.first.sourceId << "), giving up\n";
+		if (expired.second) {
+			expired.second(expired.first);
+		}
+	}
+	if (l_restart_timer) {
+		this->startGpdfExpiryTimer(l_timeout_ms);
+	}
+}
+
+void CGpSink::queueGpdf(uint32_t i_source_id, uint8_t i_command_id, const NSSPI::ByteBuffer& i_payload, CGpDownlinkQueue::FDownlinkCallback i_callback,
+                        unsigned int i_max_attempts, std::chrono::milliseconds i_time_to_live) {
+	this->updateDownlinks([&](CGpDownlinkQueue& io_queue, std::chrono::steady_clock::time_point i_now, std::vector<CGpDownlinkQueue::Push>& o_pushes, std::vector<CGpDownlinkQueue::Finished>& o_finished) {
+		(void)o_finished;
+		io_queue.enqueue(i_source_id, i_command_id, i_payload, i_max_attempts, i_time_to_live, i_now, std::move(i_callback), o_pushes);
+	});
+}
+
+std::size_t CGpSink::getNbQueuedGpdfs() const {
+	std::lock_guard<std::mutex> lock(this->downlinkMutex);
+	return this->downlinkQueue.getNbQueued();
+}
+
+std::chrono::milliseconds CGpSink::getGpdReportingPeriod(uint32_t i_source_id) const {
+	std::lock_guard<std::mutex> lock(this->downlinkMutex);
+	return this->downlinkQueue.getPeriod(i_source_id);
+}
+
+template <typename Operation>
+void CGpSink::updateDownlinks(Operation i_operation) {
+	std::vector<CGpDownlinkQueue::Push> l_pushes;
+	std::vector<CGpDownlinkQueue::Finished> l_finished;
+	bool l_start_timer = false;
+	uint32_t l_timeout_ms = 0;
+	{
+		std::lock_guard<std::mutex> lock(this->downlinkMutex);
+		std::chrono::steady_clock::time_point l_now = std::chrono::steady_clock::now();
+		if (this->downlinkTimerDeadline <= l_now) {
+			this->downlinkTimerDeadline = std::chrono::steady_clock::time_point::max();	/* The timer has expired, or will be restarted below */
+		}
+		i_operation(this->downlinkQueue, l_now, l_pushes, l_finished);
+		std::chrono::steady_clock::time_point l_next_event;
+		if (this->downlinkQueue.getNextEvent(l_next_event) && l_next_event < this->downlinkTimerDeadline) {
+			/* Restart the timer for an earlier event. If another thread restarts it concurrently for a later one, the earlier event is only processed late */
+			this->downlinkTimerDeadline = l_next_event;
+			std::chrono::milliseconds l_timeout = std::chrono::duration_cast<std::chrono::milliseconds>(l_next_event - l_now) + std::chrono::milliseconds(1);
+			l_timeout_ms = static_cast<uint32_t>(std::max(l_timeout.count(), static_cast<std::chrono::milliseconds::rep>(1)));
+			l_start_timer = true;
+		}
+	}
+	this->deliverDownlinks(l_pushes, l_finished, l_start_timer, l_timeout_ms);
+}
+
+void CGpSink::handleGpdUplink(uint32_t i_source_id) {
+	this->updateDownlinks([i_source_id](CGpDownlinkQueue& io_queue, std::chrono::steady_clock::time_point i_now, std::vector<CGpDownlinkQueue::Push>& o_pushes, std::vector<CGpDownlinkQueue::Finished>& o_finished) {
+		(void)o_finished;
+		io_queue.uplink(i_source_id, i_now, o_pushes);
+	});
+}
+
+void CGpSink::setLivenessParameters(unsigned int i_nb_missed_reports, std::chrono::milliseconds i_min_timeout, std::chrono::milliseconds i_initial_timeout, std::chrono::milliseconds i_tick) {
+	std::lock_guard<std::mutex> lock(this->livenessMutex);
+	this->liveness.configure(i_nb_missed_reports, i_min_timeout, i_initial_timeout, i_tick, std::chrono::steady_clock::now());
+}
+
+bool CGpSink::isGpdOnline(uint32_t i_source_id) const {
+	std::lock_guard<std::mutex> lock(this->livenessMutex);
+	return this->liveness.isOnline(i_source_id);
+}
+
+std::size_t CGpSink::getNbOfflineGpds() const {
+	std::lock_guard<std::mutex> lock(this->livenessMutex);
+	return this->liveness.getNbOffline();
+}
+
+void CGpSink::handleGpdHeard(uint32_t i_source_id) {
+	CGpLivenessReport l_report;
+	bool l_recovered;
+	bool l_start_timer = false;
+	{
+		std::lock_guard<std::mutex> lock(this->livenessMutex);
+		l_recovered = this->liveness.heard(i_source_id, std::chrono::steady_clock::now(), l_report);
+		if (!this->livenessTimerArmed && this->liveness.hasDeadlines()) {
+			this->livenessTimerArmed = true;
+			l_start_timer = true;
+		}
+	}
+	if (l_recovered) {
+		clogI << "Source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << l_report.sourceId
+		      << " is heard again after " << std::dec << l_report.silence.count() << "ms of silence\n";
+		this->notifyObserversOfGpdLiveness(l_report);
+	}
+	if (l_start_timer) {
+		this->startLivenessTimer();
+	}
+}
+
+void CGpSink::startLivenessTimer() {
+	uint32_t l_timeout_ms;
+	{
+		std::lock_guard<std::mutex> lock(this->livenessMutex);
+		l_timeout_ms = static_cast<uint32_t>(this->liveness.getTick().count());
+	}
+	/* Never started while holding livenessMutex, as restarting the timer waits for its previous callback to return */
+	this->livenessTimer->start(l_timeout_ms, [this](NSSPI::ITimer* triggeringTimer) {
+		(void)triggeringTimer;
+		this->expireGpdLiveness();
+	});
+}
+
+void CGpSink::expireGpdLiveness() {
+	std::vector<CGpLivenessReport> l_reports;
+	bool l_restart_timer;
+	{
+		std::lock_guard<std::mutex> lock(this->livenessMutex);
+		this->liveness.expire(std::chrono::steady_clock::now(), l_reports);
+		l_restart_timer = this->liveness.hasDeadlines();
+		this->livenessTimerArmed = l_restart_timer;
+	}
+	for (const CGpLivenessReport& report : l_reports) {
+		clogI << "Source ID 0x" << std::hex << std::setw(8) << std::setfill('0') << report.sourceId
+		      << " is offline, not heard for " << std::dec << report.silence.count() << "ms (expected period " << report.expectedPeriod.count() << "ms)\n";
+		this->notifyObserversOfGpdLiveness(report);
+	}
+	if (l_restart_timer) {
+		this->startLivenessTimer();
+	}
+}
+
+void CGpSink::downlinkSent(uint32_t i_source_id, bool i_delivered) {
+	this->updateDownlinks([i_source_id, i_delivered](CGpDownlinkQueue& io_queue, std::chrono::steady_clock::time_point i_now, std::vector<CGpDownlinkQueue::Push>& o_pushes, std::vector<CGpDownlinkQueue::Finished>& o_finished) {
+		(void)o_pushes;
+		io_queue.sent(i_source_id, i_delivered, i_now, o_finished);
+	});
+}
+
+void CGpSink::pollDownlinks() {
+	this->updateDownlinks([](CGpDownlinkQueue& io_queue, std::chrono::steady_clock::time_point i_now, std::vector<CGpDownlinkQueue::Push>& o_pushes, std::vector<CGpDownlinkQueue::Finished>& o_finished) {
+		io_queue.poll(i_now, o_pushes, o_finished);
+	});
+}
+
+void CGpSink::deliverDownlinks(std::vector<CGpDownlinkQueue::Push>& i_pushes, std::vector<CGpDownlinkQueue::Finished>& i_finished, bool i_start_timer, uint32_t i_timeout_ms) {
+	for (CGpDownlinkQueue::Push& push : i_pushes) {
+		bool l_sent = this->sendGpdf(push.sourceId, push.commandId, push.payload, push.lifeTimeMs, [this](const CGpTxConfirmation& i_confirmation) {
+			this->downlinkSent(i_confirmation.sourceId, i_confirmation.status == EEmberStatus::EMBER_SUCCESS);
+		});
+		if (!l_sent) {
+			this->downlinkSent(push.sourceId, false);	/* Counts as a failed attempt */
+		}
+	}
+	for (CGpDownlinkQueue::Finished& finished : i_finished) {
+		if (!finished.report.delivered) {
+			clogW << "Giving up queued GPDF command 0x" << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned int>(finished.report.commandId)
+			      << " to source ID 0x" << std::setw(8) << finished.report.sourceId << " after " << std::dec << finished.report.nbAttempts << " attempt(s)\n";
+		}
+		if (finished.callback) {
+			finished.callback(finished.report);
+		}
+	}
+	if (i_start_timer) {
+		/* Never started while holding downlinkMutex, as restarting the timer waits for its previous callback to return */
+		this->downlinkTimer->start(i_timeout_ms, [this](NSSPI::ITimer* triggeringTimer) {
+			(void)triggeringTimer;
+			this->pollDownlinks();
+		});
+	}
 }
 
-void CGpSink::gpProxyTableLookup(uint32_t i_src_id) {
-	CEmberGpAddressStruct i_addr(i_src_id);
-	clogD << "EZSP_GP_PROXY_TABLE_LOOKUP\n";
-	dongle.sendCommand(EZSP_GP_PROXY_TABLE_LOOKUP, i_addr.getRaw());
+void CGpSink::gpSinkTableRemoveEntry( uint8_t i_index ) {
+	clogD << "EZSP_GP_SINK_TABLE_REMOVE_ENTRY\n";
+	this->sendNcpTableCommand({ EZSP_GP_SINK_TABLE_REMOVE_ENTRY, i_index, mirrorEntry(0), false }, { i_index });
 }
 
-void CGpSink::gpSinkTableLookup(uint32_t i_src_id) {
-	CEmberGpAddressStruct i_addr(i_src_id);
-	clogD << "EZSP_GP_SINK_TABLE_LOOKUP\n";
-	dongle.sendCommand(EZSP_GP_SINK_TABLE_LOOKUP, i_addr.getRaw());
+void CGpSink::gpSinkTableClearAll() {
+	clogD << "EZSP_GP_SINK_TABLE_CLEAR_ALL\n";
+	this->sendNcpTableCommand({ EZSP_GP_SINK_TABLE_CLEAR_ALL, CGpTableMirror::NO_ENTRY, mirrorEntry(0), false }, {});
 }
 
 void CGpSink::setSinkState(CGpSink::State i_state) {
@@ -7,20 +7,36 @@
 #pragma once
 
 #include <map>
+#include <deque>
 #include <vector>
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <memory>
 
 #include "ezsp/zbmessage/green-power-frame.h"
 #include "ezsp/zbmessage/green-power-device.h"
 #include "ezsp/green-power-observer.h"
+#include "ezsp/green-power-attribute-store.h"
 #include "ezsp/ezsp-dongle.h"
 #include "ezsp/zigbee-tools/zigbee-messaging.h"
+#include "ezsp/zigbee-tools/green-power-table-mirror.h"
+#include "ezsp/zigbee-tools/green-power-tx-table.h"
+#include "ezsp/zigbee-tools/green-power-downlink-queue.h"
+#include "ezsp/zigbee-tools/green-power-liveness.h"
+#include "ezsp/zigbee-tools/green-power-duplicate-filter.h"
 #ifdef USE_BUILTIN_MIC_PROCESSING
 #include "ezsp/zigbee-tools/green-power-device-db.h"
+#include "ezsp/zigbee-tools/green-power-sink-placement.h"
+#include "ezsp/zigbee-tools/green-power-mic-validation-pool.h"
 #endif
 #include "ezsp/ezsp-protocol/struct/ember-gp-sink-table-entry-struct.h"
 #include "ezsp/ezsp-protocol/struct/ember-process-gp-pairing-parameter.h"
 #include "ezsp/ezsp-protocol/struct/ember-network-parameters.h"
 #include "spi/ByteBuffer.h"
+#include "spi/ObserverList.h"
+#include "spi/TimerBuilder.h"
 #include "ezsp/enum-generator.h"
 
 namespace NSEZSP {
@@ -35,9 +51,12 @@ namespace NSEZSP {
 	XX(SINK_AUTHORIZE_ANSWER_CH_RQST,)   /*<! Allowing answer to channel request maintenance green power frame */ \
 	XX(SINK_CLEAR_ALL,)                  /*<! Currently clearing all tables (sink/proxy) */ \
 	XX(SINK_REMOVE_IN_PROGRESS,)         /*<! Currently removing, from the sink and proxy tables, data matching with a specific list of GPDS (stored in gpds_to_remove) */ \
+	XX(SINK_TABLES_LOAD_IN_PROGRESS,)    /*<! Currently reading the adapter's sink and proxy tables into their host-side copies */ \
 
 class CGpSink : public CEzspDongleObserver {
 public:
+	static constexpr std::chrono::milliseconds GPDF_CONFIRMATION_MARGIN = std::chrono::milliseconds(500);	/*!< How long to wait for the confirmation of a GPDF transmission after the end of its lifetime in the adapter's TX queue */
+
 	/**
 	 * @brief Current state for the GP sink
 	 *
@@ -48,7 +67,17 @@ public:
 	 */
 	DECLARE_ENUM(State, SINK_STATE);
 
-	CGpSink( CEzspDongle &i_dongle, CZigbeeMessaging &i_zb_messaging );
+	/**
+	 * @brief Constructor
+	 *
+	 * @param i_dongle The EZSP adapter used to send/receive EZSP messages
+	 * @param i_zb_messaging The Zigbee messaging object used to send Zigbee messages
+	 * @param i_timer_builder Timer builder object used to generate the timer that expires unconfirmed GPDF transmissions
+	 * @param i_max_gp_devices The number of Green Power devices to reserve storage for in the host key database (in static allocation builds, the maximum number of devices),
+	 *                         and the maximum number of devices whose liveness is tracked
+	 * @param i_max_gp_attributes The maximum number of attributes whose last reported value is kept (see getAttributeStore())
+	 */
+	CGpSink( CEzspDongle &i_dongle, CZigbeeMessaging &i_zb_messaging, const NSSPI::TimerBuilder& i_timer_builder, std::size_t i_max_gp_devices = 0, std::size_t i_max_gp_attributes = CGpAttributeStore::DEFAULT_CAPACITY );
 
 	CGpSink() = delete; /* Construction without arguments is not allowed */
 	CGpSink(const CGpSink&) = delete; /* No copy construction allowed */
@@ -57,23 +86,36 @@ public:
 
 	/**
 	 * @brief Initialize sink, shall be done after a network init.
+	 *
+	 * The adapter's sink and proxy tables are then read once into host-side copies (see getSinkTableMirror() and getProxyTableMirror()),
+	 * which are kept up to date from the responses to the commands that modify these tables. The sink switches to SINK_READY once both
+	 * tables have been read.
 	 */
 	void init();
 
 	/**
 	 * @brief Clear all GP tables
 	 *
+	 * Only the entries of the proxy table that are in use (according to its host-side copy) are removed.
+	 *
 	 * @return true if action can be done
 	 */
 	bool gpClearAllTables();
 
 	/**
-	 * @brief Open a commissioning session for limited time, close as soon as a binding is done.
+	 * @brief Open a commissioning session, that stays open until closeCommissioningSession() is invoked
+	 *
+	 * Any number of devices can be commissioned during the session. Devices that send commissioning frames are queued by source ID
+	 * (repeated commissioning frames from a device already queued, being paired or paired during this session are ignored), and
+	 * paired in turn, the steps of consecutive pairings being interleaved like for registerGpds(). Observers are notified of the
+	 * outcome and latency of each pairing (see CGpObserver::handleGpdCommissioning()).
 	 */
 	void openCommissioningSession();
 
 	/**
-	 * @brief Force to close commissioning session
+	 * @brief Close the commissioning session
+	 *
+	 * Devices already queued are still paired, the sink goes back to SINK_READY once they all have been processed.
 	 */
 	void closeCommissioningSession();
 
@@ -87,21 +129,251 @@ public:
 	/**
 	 * @brief Add a green power device to this sink
 	 *
+	 * When MICs are checked by the adapter, devices are written into its sink and proxy tables by a background job. The steps of
+	 * consecutive devices are interleaved so that the EZSP command queue never runs dry, and the sink table entry is not read back
+	 * first when it is known to be free (after gpClearAllTables() or clearAllGpds()). See getRegistrationProgress().
+	 *
 	 * @param gpd list of gpds to add
 	 *
 	 * @return true if action can be done
 	 */
 	bool registerGpds(std::vector<CGpDevice> gpd);
 
+	/**
+	 * @brief Progress of the last registration job started by registerGpds()
+	 */
+	struct RegistrationProgress {
+		std::size_t nbTotal;	/*!< The number of devices to register */
+		std::size_t nbRegistered;	/*!< The number of devices written into the adapter's sink and proxy tables */
+		std::size_t nbFailed;	/*!< The number of devices that could not be registered */
+		double devicesPerSecond;	/*!< The registration throughput so far */
+	};
+
+	/**
+	 * @brief Get the progress of the last registration job started by registerGpds()
+	 *
+	 * @return The progress, the job is over when nbRegistered+nbFailed reaches nbTotal
+	 */
+	RegistrationProgress getRegistrationProgress() const;
+
 	/**
 	 * @brief remove a green power device to this sink
 	 *
+	 * When MICs are checked by the adapter, the entries to remove are found in the host-side copies of the adapter's tables,
+	 * so that only the entries actually used by these devices are accessed.
+	 *
 	 * @param gpd list of gpds sourceId to remove
 	 *
 	 * @return true if action can be done
 	 */
 	bool removeGpds(std::vector<uint32_t> gpd);
 
+	/**
+	 * @brief Make the registered green power devices match a desired list, applying only the differences
+	 *
+	 * Devices are compared by source ID, key and options with the host-side copies of the adapter's tables loaded at init()
+	 * (or with the host GP device database when MICs are processed on the host), so the adapter's tables are not read again.
+	 * Registered devices missing from @p i_gpds are removed first, then new or modified devices are registered (see registerGpds()).
+	 * Other entries are left untouched. If a source ID appears several times in @p i_gpds, its first occurrence is used.
+	 *
+	 * @param i_gpds The desired list of devices
+	 * @param[out] o_summary The number of devices left unchanged, added, updated and removed
+	 *
+	 * @return true if action can be done (the sink goes back to SINK_READY once all changes have been applied)
+	 */
+	bool syncGpds(const std::vector<CGpDevice>& i_gpds, CGpSyncSummary& o_summary);
+
+	/**
+	 * @brief Load the host GP device database from a persistent store, and persist all its subsequent modifications there
+	 *
+	 * @param i_path The path of the store snapshot file (see CGPDeviceDb::openStore())
+	 *
+	 * @return true if the store is open, false if it is invalid, or if MICs are not processed on the host (see USE_BUILTIN_MIC_PROCESSING), or if the library has been built without USE_GP_DEVICE_STORE
+	 */
+	bool openDeviceStore(const std::string& i_path);
+
+	/**
+	 * @brief Get the number of incoming GP frames dropped because they were retransmissions of a frame already accepted
+	 *
+	 * Copies of a frame are recognized by their frame counter (security levels 2 and 3), or by their sequence number if they follow the
+	 * original frame within CGpDuplicateFilter::DUPLICATE_TIMEOUT (security levels 0 and 1), whether MICs are processed on the host or not.
+	 *
+	 * @return The number of duplicate frames dropped since construction
+	 */
+	std::size_t getNbDroppedDuplicateRxGpFrames() const;
+
+	/**
+	 * @brief Get the number of incoming GP frames dropped because their frame counter was older than the last frame accepted from their source
+	 *
+	 * @note Frame counters are only checked against replays on the host when it processes MICs (see USE_BUILTIN_MIC_PROCESSING), otherwise this is done by the adapter
+	 *
+	 * @return The number of replayed frames dropped since construction
+	 */
+	std::size_t getNbDroppedReplayedRxGpFrames() const;
+
+	/**
+	 * @brief Select what to do with incoming GP frames from unknown source IDs
+	 *
+	 * Source IDs are peeked from the raw EZSP message before decoding the frame. A source ID is known if it is in the host device
+	 * database (checked using a Bloom filter, see CGPDeviceDb::mayContain()) when MICs are processed on the host, or if the adapter found it
+	 * in its proxy table otherwise. Unsecured commissioning and channel request frames are never dropped.
+	 *
+	 * @param i_policy The policy (CGpUnknownSourcePolicy::Process by default)
+	 * @param i_sample_interval With CGpUnknownSourcePolicy::Sample, one out of this number of frames from unknown source IDs is processed
+	 */
+	void setUnknownSourcePolicy(CGpUnknownSourcePolicy i_policy, unsigned int i_sample_interval = 100);
+
+	/**
+	 * @brief Get the number of incoming GP frames dropped because they came from unknown source IDs (see setUnknownSourcePolicy())
+	 *
+	 * @return The number of frames dropped since construction
+	 */
+	std::size_t getNbFilteredRxGpFrames() const;
+
+	/**
+	 * @brief Let the adapter's sink table validate the most active GP devices, while the host validates all others (hybrid mode)
+	 *
+	 * When MICs are checked on the host, the adapter's sink table is not used by default. In hybrid mode, frames from the host device
+	 * database are counted per source ID, and the most active devices are moved into the adapter's sink table in the background
+	 * (see CGpSinkTablePlacement for the selection and its hysteresis). Frames from these devices are authenticated by the adapter, so the
+	 * host only checks their frame counter, without any AES computation.
+	 * Moves only happen while the sink is ready, one device at a time, without changing the sink state.
+	 *
+	 * @param i_nb_entries The number of entries of the adapter's sink table to use (0 to disable hybrid mode, moving all devices back to the host)
+	 *        If the adapter reports that its sink table is full before that, its actual size is used instead
+	 * @param i_rebalance_interval The duration of the epochs over which traffic is counted before devices are moved
+	 *
+	 * @return false if MICs are not processed on the host (see USE_BUILTIN_MIC_PROCESSING), all devices are then in the adapter's sink table anyway
+	 */
+	bool setNcpSinkTableSize(std::size_t i_nb_entries, std::chrono::milliseconds i_rebalance_interval = std::chrono::seconds(60));
+
+	/**
+	 * @brief Get the number of incoming GP frames that were authenticated by the adapter rather than by the host (see setNcpSinkTableSize())
+	 *
+	 * @return The number of frames since construction
+	 */
+	std::size_t getNbNcpValidatedRxGpFrames() const;
+
+	/**
+	 * @brief Get the last value reported by GP devices for each of their attributes
+	 *
+	 * The store is updated from the attribute reporting commands (0xA0 to 0xA3) of authenticated frames, before observers are notified
+	 *
+	 * @return The attribute store, that can be read from any thread
+	 */
+	const CGpAttributeStore& getAttributeStore() const;
+
+	/**
+	 * @brief Get a copy of the host-side mirror of the adapter's sink table
+	 *
+	 * @return The mirror, loaded by init()
+	 */
+	CGpTableMirror getSinkTableMirror() const;
+
+	/**
+	 * @brief Get a copy of the host-side mirror of the adapter's proxy table
+	 *
+	 * @return The mirror, loaded by init()
+	 */
+	CGpTableMirror getProxyTableMirror() const;
+
+	/**
+	 * @brief Queue a GPDF in the adapter, to be sent to a GPD when it next polls with rx-after-tx
+	 *
+	 * Transmissions are tracked by the handle given to the adapter (see CGpTxTable), so that any number of them can be pending at the
+	 * same time. @p i_callback is invoked with the outcome once the adapter confirms the transmission (EZSP_D_GP_SENT_HANDLER), or
+	 * once GPDF_CONFIRMATION_MARGIN has elapsed after the end of the GPDF lifetime without any confirmation.
+	 * It runs on the EZSP RX thread or on the expiry timer thread, and may send GPDFs itself.
+	 *
+	 * @param i_source_id The source ID of the destination GPD
+	 * @param i_command_id The GPD command ID to send
+	 * @param[in] i_payload The GPD command payload
+	 * @param i_life_time_ms How long the adapter keeps the GPDF in its TX queue
+	 * @param i_callback The callback to invoke with the outcome (optional)
+	 *
+	 * @return false if CGpTxTable::MAX_PENDING transmissions are already pending
+	 */
+	bool sendGpdf(uint32_t i_source_id, uint8_t i_command_id, const NSSPI::ByteBuffer& i_payload, uint16_t i_life_time_ms, CGpTxTable::FSentCallback i_callback = nullptr);
+
+	/**
+	 * @brief Get the number of GPDF transmissions sent by sendGpdf() and waiting for their confirmation
+	 *
+	 * @return The number of pending transmissions
+	 */
+	std::size_t getNbPendingGpdfTransmissions() const;
+
+	/**
+	 * @brief Get the TX confirmation latency statistics of the GPDFs sent by sendGpdf()
+	 *
+	 * @return The statistics since construction
+	 */
+	CGpTxTable::LatencyStats getGpdfTxLatencyStats() const;
+
+	/**
+	 * @brief Queue a GPDF for an rx-after-tx GPD, to be handed over to the adapter only when the GPD is about to listen
+	 *
+	 * Unlike sendGpdf(), the GPDF waits on the host until an authenticated uplink with the rx-after-tx flag is received from the GPD,
+	 * or until its next uplink is predicted from its learned reporting period (see CGpDownlinkQueue). GPDFs for a GPD are sent in
+	 * order, one at a time, so that sleeping GPDs do not hold entries of the adapter's GP TX queue.
+	 * @p i_callback runs on the EZSP RX thread or on a timer thread.
+	 *
+	 * @param i_source_id The source ID of the destination GPD
+	 * @param i_command_id The GPD command ID to send
+	 * @param[in] i_payload The GPD command payload
+	 * @param i_callback The callback to invoke with the outcome (optional)
+	 * @param i_max_attempts How many times the GPDF may be handed over to the adapter before giving up
+	 * @param i_time_to_live How long to keep the GPDF before giving up
+	 */
+	void queueGpdf(uint32_t i_source_id, uint8_t i_command_id, const NSSPI::ByteBuffer& i_payload, CGpDownlinkQueue::FDownlinkCallback i_callback = nullptr,
+	               unsigned int i_max_attempts = 3, std::chrono::milliseconds i_time_to_live = std::chrono::minutes(10));
+
+	/**
+	 * @brief Get the number of GPDFs queued by queueGpdf() and not delivered or given up yet
+	 *
+	 * @return The number of GPDFs waiting on the host or in the adapter
+	 */
+	std::size_t getNbQueuedGpdfs() const;
+
+	/**
+	 * @brief Get the reporting period learned from the uplinks of an rx-after-tx GPD
+	 *
+	 * @param i_source_id The source ID of the GPD
+	 *
+	 * @return The period, or 0 if it is not known yet
+	 */
+	std::chrono::milliseconds getGpdReportingPeriod(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Configure the detection of GPDs that stop reporting, forgetting the devices tracked so far
+	 *
+	 * Each authenticated frame from a GPD re-arms its deadline to @p i_nb_missed_reports times its reporting period, learned from the
+	 * intervals between its frames. Observers are notified with CGpObserver::handleGpdLiveness() when a GPD misses its deadline, and again
+	 * when it is heard after that.
+	 *
+	 * @param i_nb_missed_reports The number of reporting periods without any frame before a GPD is considered offline
+	 * @param i_min_timeout The shortest silence before a GPD is considered offline, whatever its period
+	 * @param i_initial_timeout The silence before a GPD heard only once (whose period is unknown) is considered offline
+	 * @param i_tick The resolution of the deadlines
+	 */
+	void setLivenessParameters(unsigned int i_nb_missed_reports = CGpLivenessTracker::DEFAULT_NB_MISSED_REPORTS,
+	                           std::chrono::milliseconds i_min_timeout = CGpLivenessTracker::DEFAULT_MIN_TIMEOUT,
+	                           std::chrono::milliseconds i_initial_timeout = CGpLivenessTracker::DEFAULT_INITIAL_TIMEOUT,
+	                           std::chrono::milliseconds i_tick = CGpLivenessTracker::DEFAULT_TICK);
+
+	/**
+	 * @brief Check whether a GPD is heard within its expected reporting period
+	 *
+	 * @param i_source_id The source ID of the GPD
+	 *
+	 * @return false if the GPD has missed its deadline, or was never heard
+	 */
+	bool isGpdOnline(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Get the number of GPDs that have missed their deadline and were not heard since
+	 */
+	std::size_t getNbOfflineGpds() const;
+
 	/**
 	 * @brief authorize answer to channel request
 	 *
@@ -117,7 +389,14 @@ public:
 	 * @param i_cmd The EZSP command
 	 * @param i_msg_receive The payload of the message
 	 */
-	void handleEzspRxMessage( EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_receive );
+	void handleEzspRxMessage( EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive );
+
+	/**
+	 * @brief Method that will be invoked once all EZSP messages decoded from one serial read have been passed to handleEzspRxMessage()
+	 *
+	 * When MICs are checked on the host, incoming GP frames are queued until then, so that their MICs are validated in one batch
+	 */
+	void handleEzspRxBurstEnd();
 
 	/**
 	 * @brief Register one observer to the sink events
@@ -131,6 +410,10 @@ public:
 	/**
 	 * @brief Un-register one observer to the sink events
 	 *
+	 * Waits until notifications in progress on other threads are over: once this returns, @p observer will not be invoked anymore and can
+	 * be destroyed. When invoked from a notification of this sink, notifications in progress on other threads are not waited for.
+	 * Do not invoke it while holding a lock that @p observer takes in its handlers.
+	 *
 	 * @param[in] observer The observer to un-register
 	 *
 	 * @return true if The observer could successfully be un-registered
@@ -148,7 +431,7 @@ private:
 	 *
 	 * @param i_gpf The received GP frame
 	 */
-	void notifyObserversOfRxGpFrame( CGpFrame i_gpf );
+	void notifyObserversOfRxGpFrame( const CGpFrameView& i_gpf );
 
 	/**
 	 * @brief Notify observers of this class
@@ -157,6 +440,20 @@ private:
 	 */
 	void notifyObserversOfRxGpdId( uint32_t i_gpd_id, bool i_gpd_known, CGpdKeyStatus i_gpd_key_status );
 
+	/**
+	 * @brief Notify observers of this class
+	 *
+	 * @param i_report The outcome of the pairing of a device that sent commissioning frames
+	 */
+	void notifyObserversOfGpdCommissioning( const CGpCommissioningReport& i_report );
+
+	/**
+	 * @brief Notify observers of this class
+	 *
+	 * @param i_report A GPD going offline or being heard again
+	 */
+	void notifyObserversOfGpdLiveness( const CGpLivenessReport& i_report );
+
 	/**
 	 * @brief Private utility function to manage error state
 	 */
@@ -213,6 +510,87 @@ private:
 	void gpSend(bool i_action, bool i_use_cca, CEmberGpAddressStruct i_gp_addr,
 	            uint8_t i_gpd_command_id, const NSSPI::ByteBuffer& i_gpd_command_payload, uint16_t i_life_time_ms, uint8_t i_handle=0 );
 
+	/**
+	 * @brief Arm gpdSentTimer for the earliest deadline of the pending GPDF transmissions, if it is not already armed
+	 *
+	 * @note gpdSentStateMutex must be held by the caller, and the timer must then be started without holding it (see startGpdfExpiryTimer())
+	 *
+	 * @param i_now The current time
+	 * @param[out] o_timeout_ms The timeout to start the timer with
+	 *
+	 * @return true if the timer must be started
+	 */
+	bool armGpdfExpiryTimer(std::chrono::steady_clock::time_point i_now, uint32_t& o_timeout_ms);
+
+	/**
+	 * @brief Start gpdSentTimer, once armGpdfExpiryTimer() returned true
+	 *
+	 * @param i_timeout_ms The timeout returned by armGpdfExpiryTimer()
+	 */
+	void startGpdfExpiryTimer(uint32_t i_timeout_ms);
+
+	/**
+	 * @brief Expire the GPDF transmissions whose deadline is over, invoked by gpdSentTimer
+	 */
+	void expireGpdfTransmissions();
+
+	/**
+	 * @brief Apply an operation to downlinkQueue, then hand over the GPDFs to push to the adapter and invoke the callbacks of finished ones
+	 *
+	 * @param i_operation The operation, invoked with downlinkQueue, the current time, the GPDFs to push and the finished GPDFs, while holding downlinkMutex
+	 */
+	template <typename Operation>
+	void updateDownlinks(Operation i_operation);
+
+	/**
+	 * @brief Handle an authenticated uplink from a GPD with the rx-after-tx flag set
+	 *
+	 * @param i_source_id The source ID of the GPD
+	 */
+	void handleGpdUplink(uint32_t i_source_id);
+
+	/**
+	 * @brief Re-arm the liveness deadline of a GPD an authenticated frame was received from
+	 *
+	 * @param i_source_id The source ID of the GPD
+	 */
+	void handleGpdHeard(uint32_t i_source_id);
+
+	/**
+	 * @brief Start livenessTimer for one tick of the liveness tracker
+	 *
+	 * @note Never invoked while holding livenessMutex
+	 */
+	void startLivenessTimer();
+
+	/**
+	 * @brief Report the GPDs whose liveness deadline has passed, invoked by livenessTimer
+	 */
+	void expireGpdLiveness();
+
+	/**
+	 * @brief Record the outcome of a GPDF pushed from downlinkQueue
+	 *
+	 * @param i_source_id The source ID of the destination GPD
+	 * @param i_delivered true if the adapter confirmed the transmission
+	 */
+	void downlinkSent(uint32_t i_source_id, bool i_delivered);
+
+	/**
+	 * @brief Push the GPDFs of downlinkQueue that are due, and expire old ones, invoked by downlinkTimer
+	 */
+	void pollDownlinks();
+
+	/**
+	 * @brief Hand over GPDFs to the adapter, invoke the callbacks of finished ones, and start downlinkTimer (without holding downlinkMutex)
+	 *
+	 * @param[in] i_pushes The GPDFs to push
+	 * @param[in] i_finished The finished GPDFs
+	 * @param i_start_timer Should downlinkTimer be started?
+	 * @param i_timeout_ms The timeout to start downlinkTimer with
+	 */
+	void deliverDownlinks(std::vector<CGpDownlinkQueue::Push>& i_pushes, std::vector<CGpDownlinkQueue::Finished>& i_finished, bool i_start_timer, uint32_t i_timeout_ms);
+
 	/**
 	 * @brief Remove an entry in sink table
 	 * @param i_index The index of the entry to remove
@@ -220,16 +598,71 @@ private:
 	void gpSinkTableRemoveEntry( uint8_t i_index );
 
 	/**
-	 * @brief Search an entry in the proxy table for a GPD, using a source ID as key
-	 * @param i_src_id Source id of GPD to search
+	 * @brief Remove all entries in sink table
+	 */
+	void gpSinkTableClearAll();
+
+	/**
+	 * @brief An update of the host-side copies of the adapter's tables, applied once the adapter has processed the command that performs it
 	 */
-	void gpProxyTableLookup(uint32_t i_src_id);
+	struct PendingNcpTableUpdate {
+		EEzspCmd cmd;	/*!< The EZSP command performing the update */
+		uint8_t index;	/*!< The index of the sink table entry (for EZSP_GP_SINK_TABLE_SET_ENTRY and EZSP_GP_SINK_TABLE_REMOVE_ENTRY) */
+		CGpTableMirror::Entry entry;	/*!< The device, with the options of the sink table entry, or of the GP pairing */
+		bool addSink;	/*!< Does the GP pairing add (rather than remove) a device? */
+	};
 
 	/**
-	 * @brief Search an entry in the sink table for a GPD, using a source ID as key
-	 * @param i_src_id Source id of GPD to search
+	 * @brief Send an EZSP command modifying the adapter's sink or proxy table, recording the update to apply to their host-side copies
+	 *
+	 * @param i_update The update, applied by applyNcpTableUpdate() when the response is received
+	 * @param i_payload The payload of the command
 	 */
-	void gpSinkTableLookup(uint32_t i_src_id);
+	void sendNcpTableCommand(const PendingNcpTableUpdate& i_update, const NSSPI::ByteBuffer& i_payload);
+
+	/**
+	 * @brief Apply to the host-side copies of the adapter's tables the update performed by a command, once its response is received
+	 *
+	 * @param i_cmd The EZSP command
+	 * @param i_msg_receive The payload of the response
+	 */
+	void applyNcpTableUpdate(EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive);
+
+	/**
+	 * @brief Account for the response to one of the commands sent for a clear or remove operation, and go back to SINK_READY once all have been received
+	 */
+	void countNcpTableResponse();
+
+	/**
+	 * @brief A clear or remove operation is over, go back to SINK_READY, or register the devices left by syncGpds() in gpds_to_sync
+	 */
+	void ncpTableJobDone();
+
+	/**
+	 * @brief Start removing the devices stored in gpds_to_remove from the adapter's sink and proxy tables
+	 */
+	void startNcpRemoval();
+
+	/**
+	 * @brief Start registering devices into the adapter's sink and proxy tables
+	 *
+	 * @param io_gpds The devices to register, must not be empty (swapped with the previous content of gpds_to_register)
+	 */
+	void startNcpRegistration(std::vector<CGpDevice>& io_gpds);
+
+	/**
+	 * @brief Read the next entry of the adapter's sink table into its host-side copy, or switch to the proxy table at the end of the sink table
+	 *
+	 * @param i_index The index of the next sink table entry
+	 */
+	void loadSinkTableEntry(uint8_t i_index);
+
+	/**
+	 * @brief Read the next entry of the adapter's proxy table into its host-side copy, or switch to SINK_READY at the end of the proxy table
+	 *
+	 * @param i_index The index of the next proxy table entry
+	 */
+	void loadProxyTableEntry(uint8_t i_index);
 
 	/**
 	 * @brief Handle an incoming GET_NETWORK_PARAMETERS EZSP message
@@ -241,13 +674,13 @@ private:
 	 * @brief Handle an incoming EZSP message related to the Green Power endpoint with no GPD security
 	 * @param[in] gpf The Green Power frame
 	 */
-	void handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_NO_SECURITY(const CGpFrame& gpf);
+	void handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_NO_SECURITY(const CGpFrameView& gpf);
 
 	/**
 	 * @brief Handle an incoming EZSP message related to the Green Power endpoint with GPD security
 	 * @param[in] gpf The Green Power frame
 	 */
-	void handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_SECURITY(const CGpFrame& gpf);
+	void handleEzspRxMessage_INCOMING_MESSAGE_HANDLER_SECURITY(const CGpFrameView& gpf);
 
 	/**
 	 * @brief Handle an incoming EZSP message related to the Green Power endpoint
@@ -258,16 +691,178 @@ private:
 	void handleEzspRxMessage_INCOMING_MESSAGE_HANDLER(const NSSPI::ByteBuffer& i_msg_receive);
 
 	/**
-	 * @brief Handle an incoming SINK_TABLE_FIND_OR_ALLOCATE_ENTRY EZSP message
-	 * @param[in] i_msg_receive The incoming EZSP message
+	 * @brief Check whether an incoming GP frame should be dropped because of its source ID, according to the unknown source policy
+	 *
+	 * @param i_msg_receive The incoming EZSP message carrying the GP frame (not decoded yet)
+	 *
+	 * @return true if the frame must be dropped
 	 */
-	void handleEzspRxMessage_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY(const NSSPI::ByteBuffer& i_msg_receive);
+	bool filterRxGpFrame(const NSSPI::ByteBuffer& i_msg_receive);
+
+	/**
+	 * @brief Process an incoming GP frame once the validity of its MIC is known
+	 * @param[in] gpf The Green Power frame
+	 * @param[in] i_gpd_known Is the source ID of this frame known (in our device database, or in the adapter's proxy table)?
+	 * @param[in] i_key_status The result of the MIC check for this frame
+	 */
+	void handleRxGpFrame(const CGpFrameView& gpf, bool i_gpd_known, CGpdKeyStatus i_key_status);
+
+	/**
+	 * @brief Check whether an incoming GP frame is a copy of the last frame accepted from its source ID, and count it if it is
+	 *
+	 * Frames with a frame counter are checked against the host device database instead when MICs are processed on the host
+	 * (see flushRxGpFrames()). Commissioning frames are never dropped, their repetitions are counted by the commissioning itself.
+	 *
+	 * @param[in] gpf The Green Power frame
+	 * @param[in] i_key_status The result of the MIC check for this frame (only authenticated frame counters are remembered)
+	 *
+	 * @return true if the frame must be dropped
+	 */
+	bool dropDuplicateRxGpFrame(const CGpFrameView& gpf, CGpdKeyStatus i_key_status);
+
+	/**
+	 * @brief Does an incoming GP frame carry a frame counter authenticated by its MIC?
+	 *
+	 * @param[in] i_gpf The Green Power frame
+	 *
+	 * @return true for security levels 2 and 3
+	 */
+	static bool hasFrameCounter(const CGpFrameView& i_gpf);
+
+	/**
+	 * @brief Count (and log) an incoming GP frame dropped as a retransmission or as a replay
+	 *
+	 * @param[in] i_gpf The dropped Green Power frame
+	 * @param[in] i_replay Was the frame dropped because its frame counter was older than the last one accepted (rather than equal to it)?
+	 */
+	void countDroppedRxGpFrame(const CGpFrameView& i_gpf, bool i_replay);
+
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	/**
+	 * @brief Validate the MICs of all queued incoming GP frames (in batches) and process these frames, in reception order
+	 */
+	void flushRxGpFrames();
+
+	/**
+	 * @brief End the current placement epoch if it has lasted long enough, and start moving the selected devices (hybrid mode)
+	 */
+	void updateSinkTablePlacement();
+
+	/**
+	 * @brief Start moving the next selected device into or out of the adapter's sink table, if the sink is ready and no move is in progress
+	 */
+	void startSinkTableMigration();
+
+	/**
+	 * @brief Remove the next entry used by the device being demoted, or end its demotion if it is not in the adapter's tables anymore
+	 */
+	void continueSinkTableDemotion();
+
+	/**
+	 * @brief Send the next EZSP command of the move in progress
+	 *
+	 * @param i_awaited_cmd The EZSP command whose response will continue the move
+	 */
+	void awaitSinkTableMigrationResponse(EEzspCmd i_awaited_cmd);
+
+	/**
+	 * @brief Handle the response to the EZSP command sent for the move in progress
+	 *
+	 * @param i_cmd The EZSP command
+	 * @param i_msg_receive The payload of the response
+	 */
+	void handleSinkTableMigrationResponse(EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive);
+
+	/**
+	 * @brief Give up the promotion in progress
+	 *
+	 * @param i_allocated Has an entry already been allocated in the adapter's sink table (it is then removed in the background)?
+	 */
+	void abandonSinkTablePromotion(bool i_allocated);
+#endif
+
+	/**
+	 * @brief Start a registration job, resetting its progress
+	 *
+	 * @param i_nb_gpds The number of devices to register
+	 */
+	void startRegistration(std::size_t i_nb_gpds);
+
+	/**
+	 * @brief Account for devices whose registration is over, and go back to SINK_READY once the whole job is done
+	 *
+	 * @param i_nb_registered The number of devices successfully registered
+	 * @param i_nb_failed The number of devices that could not be registered
+	 */
+	void countRegistration(std::size_t i_nb_registered, std::size_t i_nb_failed);
+
+	/**
+	 * @brief Request a sink table entry for the next device of the registration job (the last one in gpds_to_register), if any
+	 */
+	void registerNextGpd();
+
+	/**
+	 * @brief Write the sink table entry of the device being registered (the last one in gpds_to_register), then start with the next device
+	 *
+	 * @param i_entry The current content of the entry at index sink_table_index
+	 */
+	void writeRegisteredGpdEntry(CEmberGpSinkTableEntryStruct& i_entry);
+
+	/**
+	 * @brief Is an entry of the adapter's sink table known to be free?
+	 *
+	 * @param i_index The index of the entry
+	 *
+	 * @return true if the host-side copy of the sink table is loaded, and the entry does not hold a device
+	 */
+	bool isNcpSinkTableEntryFree(uint8_t i_index) const;
 
 	/**
-	 * @brief Handle an incoming SINK_TABLE_LOOKUP EZSP message
+	 * @brief Queue a device that sent a commissioning frame during the commissioning session, unless it is already known to this session
+	 *
+	 * @param i_gpf The commissioning frame
+	 */
+	void queueCommissioning(const CGpFrameView& i_gpf);
+
+	/**
+	 * @brief Request a sink table entry for the next device waiting in commissioningQueue, unless another device is already being allocated an entry
+	 */
+	void commissionNextGpd();
+
+	/**
+	 * @brief Write the sink table entry of the device being allocated an entry, from its commissioning frame, then start with the next device
+	 *
+	 * @param i_entry The current content of the entry at index sink_table_index
+	 */
+	void writeCommissionedGpdEntry(CEmberGpSinkTableEntryStruct& i_entry);
+
+	/**
+	 * @brief Take the device whose entry was written or paired first, as responses come in sending order
+	 *
+	 * @param[out] o_source_id The source ID of the device
+	 *
+	 * @return false if no commissioned device was being written (this is unexpected)
+	 */
+	bool popCommissioningWrite(uint32_t& o_source_id);
+
+	/**
+	 * @brief The pairing of a device that sent commissioning frames is over, report it, and leave SINK_COM_IN_PROGRESS if no other device is being processed
+	 *
+	 * @param i_source_id The source ID of the device
+	 * @param i_paired Has the device been written into the adapter's sink and proxy tables?
+	 */
+	void finishCommissioning(uint32_t i_source_id, bool i_paired);
+
+	/**
+	 * @brief Go back to SINK_READY if the commissioning session has been closed, and no device is being processed anymore
+	 */
+	void endCommissioningIfClosed();
+
+	/**
+	 * @brief Handle an incoming SINK_TABLE_FIND_OR_ALLOCATE_ENTRY EZSP message
 	 * @param[in] i_msg_receive The incoming EZSP message
 	 */
-	void handleEzspRxMessage_SINK_TABLE_LOOKUP(const NSSPI::ByteBuffer& i_msg_receive);
+	void handleEzspRxMessage_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY(const NSSPI::ByteBuffer& i_msg_receive);
 
 	/**
 	 * @brief Handle an incoming SINK_TABLE_GET_ENTRY EZSP message
@@ -281,12 +876,6 @@ private:
 	 */
 	void handleEzspRxMessage_SINK_TABLE_SET_ENTRY(const NSSPI::ByteBuffer& i_msg_receive);
 
-	/**
-	 * @brief Handle an incoming PROXY_TABLE_LOOKUP EZSP message
-	 * @param[in] i_msg_receive The incoming EZSP message
-	 */
-	void handleEzspRxMessage_PROXY_TABLE_LOOKUP(const NSSPI::ByteBuffer& i_msg_receive);
-
 	/**
 	 * @brief Handle an incoming PROXY_TABLE_GET_ENTRY EZSP message
 	 * @param[in] i_msg_receive The incoming EZSP message
@@ -306,19 +895,95 @@ private:
 	std::function<bool (CGpSink::State& i_state)> obsStateCallback;	/*!< Optional user callback invoked by us each time library state change */
 	CEmberNetworkParameters nwk_parameters;
 	bool authorizeGpfChannelRqst;
+	/**
+	 * @brief Progress of the pairing of a device that sent commissioning frames
+	 */
+	enum class CommissioningStep {
+		WAITING,	/*!< Queued in commissioningQueue */
+		ALLOCATING,	/*!< Being allocated a sink table entry */
+		WRITING,	/*!< Its sink table entry is being written, or it is being paired in the proxy table */
+		PAIRED,	/*!< Written into the adapter's sink and proxy tables */
+		FAILED	/*!< Could not be paired (it can be commissioned again) */
+	};
+
+	/**
+	 * @brief A device that sent commissioning frames during the commissioning session
+	 */
+	struct PendingCommissioning {
+		CGpFrame frame;	/*!< The first commissioning frame received from the device */
+		CommissioningStep step;	/*!< Progress of its pairing */
+		unsigned int nbDuplicates;	/*!< Commissioning frames received again from the device */
+		std::chrono::steady_clock::time_point received;	/*!< When the first commissioning frame was received */
+		std::chrono::steady_clock::time_point started;	/*!< When its pairing started */
+	};
+
 	// parameters to save for pairing/clearing
-	CGpFrame gpf_comm_frame;
+	std::mutex commissioningMutex;	/*!< Mutex protecting the commissioning* attributes below, as the session is opened and closed from another thread */
+	bool commissioningSessionOpen;	/*!< Is the commissioning session open? */
+	std::map<uint32_t, PendingCommissioning> commissionings;	/*!< Devices that sent commissioning frames during the current session, by source ID */
+	std::deque<uint32_t> commissioningQueue;	/*!< Source IDs of the devices waiting to be paired, in reception order */
+	std::deque<uint32_t> commissioningWrites;	/*!< Source IDs of the devices whose entry is being written or paired, in sending order */
+	bool commissioningAllocating;	/*!< Is a device being allocated a sink table entry (only one at a time, as responses do not carry the source ID)? */
+	uint32_t commissioningAllocatingSourceId;	/*!< The source ID of the device being allocated a sink table entry */
 	uint8_t sink_table_index;
 	std::vector<CGpDevice> gpds_to_register;    /*!< A list of GP source IDs and keys to register to the adapter's GP sink */
+	mutable std::mutex registrationProgressMutex;	/*!< Mutex protecting registrationProgress and registrationStart */
+	RegistrationProgress registrationProgress;	/*!< Progress of the last registration job (see getRegistrationProgress()) */
+	std::chrono::steady_clock::time_point registrationStart;	/*!< When the last registration job started */
+	mutable std::mutex ncpTablesMutex;	/*!< Mutex protecting sinkTableMirror, proxyTableMirror, pendingNcpTableUpdates and nbPendingNcpTableResponses */
+	CGpTableMirror sinkTableMirror;	/*!< Host-side copy of the adapter's sink table */
+	CGpTableMirror proxyTableMirror;	/*!< Host-side copy of the adapter's proxy table (options of entries added by GP pairings are the pairing options) */
+	std::deque<PendingNcpTableUpdate> pendingNcpTableUpdates;	/*!< Updates of the mirrors waiting for the response to their command, in sending order */
+	std::size_t nbPendingNcpTableResponses;	/*!< Number of responses still expected before a clear or remove operation is over */
 	CEmberGpSinkTableEntryStruct sink_table_entry;
 	uint8_t proxy_table_index;
 	std::vector<uint32_t> gpds_to_remove;    /*!< A list of GP source IDs to remove from the adapter's GP sink */
-	std::mutex gpdSentStateMutex;	/*!< Mutex allowing exclusive accesses to gpdSentPendingAckList and gpdSentLastHandlerNb */
-	uint8_t gpdSentLastHandlerNb;	/*!< The value of the last handler number used when invoking to dGpSend(), this will be returned by the adapter when the frame is acknowledged as sent */
-	uint32_t sentChannelSwitchSourceId;	/*!< If non-0, this attribute contains the source ID of an MSP channel switch request already sent but not yet successfully acknowledged by the adapter */
-	std::set<CGpObserver*> observers;   /*!< List of observers of this class */
+	std::vector<CGpDevice> gpds_to_sync;    /*!< Devices left to register by syncGpds(), once its removals are over */
+	mutable std::mutex downlinkMutex;	/*!< Mutex protecting downlinkQueue and downlinkTimerDeadline */
+	CGpDownlinkQueue downlinkQueue;	/*!< GPDFs queued by queueGpdf(), waiting for their GPD to listen */
+	std::chrono::steady_clock::time_point downlinkTimerDeadline;	/*!< When downlinkTimer expires (time_point::max() if it is not running) */
+	mutable std::mutex gpdSentStateMutex;	/*!< Mutex allowing exclusive accesses to gpdSentPending and gpdSentTimerArmed */
+	CGpTxTable gpdSentPending;	/*!< GPDF transmissions sent by sendGpdf() and not yet confirmed by the adapter, by handle */
+	bool gpdSentTimerArmed;	/*!< Is gpdSentTimer running to expire pending transmissions? */
+	std::unique_ptr<NSSPI::ITimer> gpdSentTimer;	/*!< Timer expiring the transmissions never confirmed by the adapter (declared after the state it accesses, so it is stopped first) */
+	std::unique_ptr<NSSPI::ITimer> downlinkTimer;	/*!< Timer pushing queued GPDFs before predicted uplinks, and expiring them */
+	NSSPI::ObserverList<CGpObserver> observers;   /*!< List of observers of this class (copy-on-write, can be notified while being modified from another thread) */
+	std::atomic<std::size_t> nbDroppedDuplicateRxGpFrames;	/*!< Number of incoming GP frames dropped as retransmissions (see getNbDroppedDuplicateRxGpFrames()) */
+	std::atomic<std::size_t> nbDroppedReplayedRxGpFrames;	/*!< Number of incoming GP frames dropped as replays (see getNbDroppedReplayedRxGpFrames()) */
+	CGpDuplicateFilter rxDuplicateFilter;	/*!< Last frame accepted from each source ID, to drop its copies (only accessed from the EZSP RX thread) */
+	std::atomic<CGpUnknownSourcePolicy> unknownSourcePolicy;	/*!< What to do with frames from unknown source IDs (see setUnknownSourcePolicy()) */
+	std::atomic<unsigned int> unknownSourceSampleInterval;	/*!< One out of this number of frames from unknown source IDs is processed with CGpUnknownSourcePolicy::Sample */
+	unsigned int nbUnknownSourceFrames;	/*!< Number of frames from unknown source IDs received, used for sampling (only accessed from the EZSP RX thread) */
+	std::atomic<std::size_t> nbFilteredRxGpFrames;	/*!< Number of incoming GP frames dropped by the unknown source policy (see getNbFilteredRxGpFrames()) */
+	std::atomic<std::size_t> nbNcpValidatedRxGpFrames;	/*!< Number of incoming GP frames authenticated by the adapter (see getNbNcpValidatedRxGpFrames()) */
+	CGpAttributeStore attributeStore;	/*!< Last reported attribute values (see getAttributeStore()) */
+	mutable std::mutex livenessMutex;	/*!< Mutex protecting liveness and livenessTimerArmed */
+	CGpLivenessTracker liveness;	/*!< Deadlines of the GPDs, to detect the ones that stop reporting (see setLivenessParameters()) */
+	bool livenessTimerArmed;	/*!< Is livenessTimer running to advance liveness? */
+	std::unique_ptr<NSSPI::ITimer> livenessTimer;	/*!< Timer advancing liveness by one tick (declared after the state it accesses, so it is stopped first) */
 #ifdef USE_BUILTIN_MIC_PROCESSING
+	/**
+	 * @brief An incoming GP frame waiting for its MIC to be validated
+	 */
+	struct QueuedRxGpFrame {
+		CGpFrame gpf;	/*!< The frame */
+		bool ncpValidated;	/*!< Has the adapter authenticated this frame, for a device that we moved into its sink table? */
+	};
+
 	NSEZSP::CGPDeviceDb gp_dev_db;    /*!< A database of known Green Power devices */
+	static constexpr std::size_t RX_GP_FRAME_QUEUE_SIZE = 32;	/*!< Maximum number of incoming GP frames queued before their MICs are validated */
+	std::vector<QueuedRxGpFrame> rxGpFrames;	/*!< Incoming GP frames waiting for their MIC to be validated (capacity reserved at construction) */
+	std::vector<QueuedRxGpFrame> rxGpFramesSpare;	/*!< Spare storage swapped with rxGpFrames while its frames are processed */
+	NSEZSP::CGpSinkTablePlacement sinkTablePlacement;	/*!< Selection of the devices validated by the adapter's sink table in hybrid mode (see setNcpSinkTableSize()) */
+	std::chrono::steady_clock::duration sinkTableEpochDuration;	/*!< The duration of placement epochs */
+	std::chrono::steady_clock::time_point sinkTableEpochStart;	/*!< When the current placement epoch started */
+	std::vector<uint32_t> sinkTableDemotions;	/*!< Source IDs waiting to be removed from the adapter's sink table */
+	std::vector<uint32_t> sinkTablePromotions;	/*!< Source IDs waiting to be added to the adapter's sink table, most active first */
+	bool sinkTableMigrationInFlight;	/*!< Is a command of a move into or out of the adapter's sink table waiting for its response? */
+	EEzspCmd sinkTableMigrationAwaitedCmd;	/*!< The EZSP command whose response is awaited for the move in progress */
+	bool sinkTableMigrationPromoting;	/*!< Is the move in progress a promotion (rather than a demotion)? */
+	uint32_t sinkTableMigrationSourceId;	/*!< The source ID of the device being moved */
+	uint8_t sinkTableMigrationIndex;	/*!< The index allocated in the adapter's sink table for the device being promoted */
 #endif
 };
 
@@ -0,0 +1,77 @@
+/**
+ * @file green-power-source-id-filter.cpp
+ *
+ * @brief Probabilistic set of green power source IDs, used to discard frames from unknown devices cheaply
+ */
+
+#include "green-power-source-id-filter.h"
+
+using NSEZSP::CGpSourceIdFilter;
+
+constexpr std::size_t CGpSourceIdFilter::BITS_PER_SOURCE_ID;
+constexpr std::size_t CGpSourceIdFilter::WORDS_PER_BLOCK;
+
+namespace {
+/* Odd multipliers, one per word of a block, spreading the low half of the hash into 8 independent 5-bit bit positions */
+const uint32_t BIT_SALTS[8] = { 0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U };
+}
+
+CGpSourceIdFilter::CGpSourceIdFilter() :
+	words(),
+	nbBlocks(0) {
+}
+
+void CGpSourceIdFilter::reset(std::size_t i_capacity) {
+	std::size_t bitsPerBlock = WORDS_PER_BLOCK * 32;
+	this->nbBlocks = (i_capacity * BITS_PER_SOURCE_ID + bitsPerBlock - 1) / bitsPerBlock;
+	if (this->nbBlocks == 0) {
+		this->nbBlocks = 1;	/* Source IDs may still be inserted beyond the capacity */
+	}
+	this->words.assign(this->nbBlocks * WORDS_PER_BLOCK, 0);	/* Does not re-allocate if the size is unchanged */
+}
+
+uint64_t CGpSourceIdFilter::hash(uint32_t i_source_id) {
+	/* 64-bit finalizer of MurmurHash3: source IDs are often allocated sequentially, all their bits must influence both halves of the hash */
+	uint64_t h = i_source_id;
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+	h *= 0xc4ceb9fe1a85ec53ULL;
+	h ^= h >> 33;
+	return h;
+}
+
+std::size_t CGpSourceIdFilter::blockOffset(uint64_t i_hash) const {
+	/* Map the high half of the hash on the number of blocks without a modulo */
+	return static_cast<std::size_t>(((i_hash >> 32) * this->nbBlocks) >> 32) * WORDS_PER_BLOCK;
+}
+
+void CGpSourceIdFilter::insert(uint32_t i_source_id) {
+	if (this->nbBlocks == 0) {
+		return;
+	}
+	uint64_t h = CGpSourceIdFilter::hash(i_source_id);
+	uint32_t* block = &this->words[this->blockOffset(h)];
+	uint32_t key = static_cast<uint32_t>(h);
+	for (std::size_t word = 0; word < WORDS_PER_BLOCK; word++) {
+		block[word] |= 1U << ((key * BIT_SALTS[word]) >> 27);
+	}
+}
+
+bool CGpSourceIdFilter::mayContain(uint32_t i_source_id) const {
+	if (this->nbBlocks == 0) {
+		return false;
+	}
+	uint64_t h = CGpSourceIdFilter::hash(i_source_id);
+	const uint32_t* block = &this->words[this->blockOffset(h)];
+	uint32_t key = static_cast<uint32_t>(h);
+	uint32_t missing = 0;
+	for (std::size_t word = 0; word < WORDS_PER_BLOCK; word++) {
+		missing |= ~block[word] & (1U << ((key * BIT_SALTS[word]) >> 27));	/* No early exit: the loop is unrolled and vectorized */
+	}
+	return (missing == 0);
+}
+
+std::size_t CGpSourceIdFilter::memoryFootprint() const {
+	return this->words.capacity() * sizeof(uint32_t);
+}
@@ -0,0 +1,91 @@
+/**
+ * @file green-power-source-id-filter.h
+ *
+ * @brief Probabilistic set of green power source IDs, used to discard frames from unknown devices cheaply
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace NSEZSP {
+
+/**
+ * @brief Split block Bloom filter of source IDs
+ *
+ * Each source ID is mapped to one 32-byte block (half a cache line), in which it sets one bit in each of the 8 32-bit words.
+ * A membership test thus reads a single block, whatever the number of source IDs, and needs no division nor branch per bit.
+ *
+ * With 16 bits per source ID (see BITS_PER_SOURCE_ID), less than 0.5% of the source IDs that have not been inserted are reported as
+ * possibly present. Source IDs that have been inserted are always reported as possibly present.
+ *
+ * @note Source IDs cannot be removed from a Bloom filter: the owner of the filter rebuilds it from scratch instead (see reset())
+ */
+class CGpSourceIdFilter {
+public:
+	static constexpr std::size_t BITS_PER_SOURCE_ID = 16;	/*!< Size of the filter for each source ID it is designed to hold */
+
+	CGpSourceIdFilter();
+
+	/**
+	 * @brief Empty the filter, and size it for a number of source IDs
+	 *
+	 * @param i_capacity The number of source IDs that will be inserted (more can be inserted, at the price of a higher false positive rate)
+	 *
+	 * @note Storage is only re-allocated if the size of the filter changes
+	 */
+	void reset(std::size_t i_capacity);
+
+	/**
+	 * @brief Add a source ID to the filter
+	 *
+	 * @param i_source_id The source ID
+	 *
+	 * @note The filter must have been sized with reset() beforehand
+	 */
+	void insert(uint32_t i_source_id);
+
+	/**
+	 * @brief Check whether a source ID may have been inserted in the filter
+	 *
+	 * @param i_source_id The source ID
+	 *
+	 * @return false if @p i_source_id has definitely not been inserted since the last reset(), true if it probably has
+	 */
+	bool mayContain(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Get the memory used by the filter
+	 *
+	 * @return The number of bytes allocated on the heap
+	 */
+	std::size_t memoryFootprint() const;
+
+private:
+	static constexpr std::size_t WORDS_PER_BLOCK = 8;	/*!< Number of 32-bit words per block (one bit is set in each of them per source ID) */
+
+	/**
+	 * @brief Hash a source ID
+	 *
+	 * @param i_source_id The source ID
+	 *
+	 * @return A 64-bit hash, the high half selects the block and the low half selects the bits within the block
+	 */
+	static uint64_t hash(uint32_t i_source_id);
+
+	/**
+	 * @brief Get the first word of the block of a source ID
+	 *
+	 * @param i_hash The hash of the source ID
+	 *
+	 * @return The index of the first word of the block in words
+	 */
+	std::size_t blockOffset(uint64_t i_hash) const;
+
+	std::vector<uint32_t> words;	/*!< The bits of all blocks */
+	std::size_t nbBlocks;	/*!< The number of blocks (0 if the filter has not been sized yet: it then contains nothing) */
+};
+
+} // namespace NSEZSP
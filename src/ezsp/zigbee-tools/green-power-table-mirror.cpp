@@ -0,0 +1,241 @@
+/**
+ * @file green-power-table-mirror.cpp
+ *
+ * @brief Host-side copy of the adapter's green power sink or proxy table
+ */
+
+#include "green-power-table-mirror.h"
+
+using NSEZSP::CGpTableMirror;
+
+constexpr uint8_t CGpTableMirror::NO_ENTRY;
+constexpr std::size_t CGpTableMirror::MAX_ENTRIES;
+
+namespace {
+constexpr std::size_t NB_SLOTS = 2 * CGpTableMirror::MAX_ENTRIES + 1;	/* Maximum load factor of 50% */
+const CGpTableMirror::Entry BLANK_ENTRY = { CGpTableMirror::EntryStatus::FREE, 0, 0, 0, NSEZSP::EmberKeyData() };
+}
+
+CGpTableMirror::CGpTableMirror() :
+	entries(),
+	slots(NB_SLOTS, NO_ENTRY),
+	nbUsedEntries(0),
+	nbDuplicateEntries(0),
+	loaded(false) {
+	this->entries.reserve(MAX_ENTRIES);
+}
+
+void CGpTableMirror::startLoad() {
+	this->entries.clear();
+	this->slots.assign(NB_SLOTS, NO_ENTRY);
+	this->nbUsedEntries = 0;
+	this->nbDuplicateEntries = 0;
+	this->loaded = false;
+}
+
+void CGpTableMirror::loadEntry(uint8_t i_index, const Entry& i_entry) {
+	if (i_index == NO_ENTRY) {
+		return;
+	}
+	this->grow(i_index);
+	this->removeEntry(i_index);
+	this->entries[i_index] = i_entry;
+	if (i_entry.status != EntryStatus::FREE) {
+		this->link(i_index);
+	}
+}
+
+void CGpTableMirror::endLoad() {
+	this->loaded = true;
+}
+
+bool CGpTableMirror::isLoaded() const {
+	return this->loaded;
+}
+
+std::size_t CGpTableMirror::size() const {
+	return this->entries.size();
+}
+
+std::size_t CGpTableMirror::getNbUsedEntries() const {
+	return this->nbUsedEntries;
+}
+
+const CGpTableMirror::Entry& CGpTableMirror::getEntry(uint8_t i_index) const {
+	if (i_index >= this->entries.size()) {
+		return BLANK_ENTRY;
+	}
+	return this->entries[i_index];
+}
+
+std::size_t CGpTableMirror::homeSlot(uint32_t i_source_id) const {
+	/* Fibonacci hashing to spread sequential source IDs, then map the 32-bit hash on the number of slots */
+	uint32_t hash = i_source_id * 0x9e3779b1U;
+	return static_cast<std::size_t>((static_cast<uint64_t>(hash) * NB_SLOTS) >> 32);
+}
+
+std::size_t CGpTableMirror::findSlot(uint32_t i_source_id) const {
+	std::size_t slot = this->homeSlot(i_source_id);
+	while (this->slots[slot] != NO_ENTRY && this->entries[this->slots[slot]].sourceId != i_source_id) {
+		if (++slot == NB_SLOTS) {
+			slot = 0;
+		}
+	}
+	return slot;
+}
+
+uint8_t CGpTableMirror::find(uint32_t i_source_id) const {
+	return this->slots[this->findSlot(i_source_id)];
+}
+
+bool CGpTableMirror::isBlank(uint8_t i_index) const {
+	return this->loaded && this->getEntry(i_index).status != EntryStatus::ACTIVE;
+}
+
+void CGpTableMirror::grow(uint8_t i_index) {
+	if (i_index >= this->entries.size()) {
+		this->entries.resize(static_cast<std::size_t>(i_index) + 1, BLANK_ENTRY);
+	}
+}
+
+void CGpTableMirror::link(uint8_t i_index) {
+	std::size_t slot = this->findSlot(this->entries[i_index].sourceId);
+	if (this->slots[slot] == NO_ENTRY) {
+		this->slots[slot] = i_index;
+	}
+	else {
+		this->nbDuplicateEntries++;	/* The source ID is already used by another entry, the latter stays the one that is found */
+	}
+	this->nbUsedEntries++;
+}
+
+void CGpTableMirror::unlink(uint8_t i_index) {
+	uint32_t sourceId = this->entries[i_index].sourceId;
+	this->nbUsedEntries--;
+	std::size_t hole = this->findSlot(sourceId);
+	if (this->slots[hole] != i_index) {
+		this->nbDuplicateEntries--;	/* Another entry is used by the same source ID, and that one is reachable */
+		return;
+	}
+	this->slots[hole] = NO_ENTRY;
+	/* Backward shift deletion: move back the following slots of the probe sequence that would not be reachable anymore because of the hole */
+	std::size_t slot = hole;
+	while (true) {
+		if (++slot == NB_SLOTS) {
+			slot = 0;
+		}
+		if (this->slots[slot] == NO_ENTRY) {
+			break;
+		}
+		std::size_t home = this->homeSlot(this->entries[this->slots[slot]].sourceId);
+		/* The slot can fill the hole if its home slot is not (cyclically) within ]hole, slot] */
+		bool homeAfterHole = (hole <= slot) ? (home > hole && home <= slot) : (home > hole || home <= slot);
+		if (!homeAfterHole) {
+			this->slots[hole] = this->slots[slot];
+			this->slots[slot] = NO_ENTRY;
+			hole = slot;
+		}
+	}
+	if (this->nbDuplicateEntries == 0) {
+		return;
+	}
+	/* Duplicate source IDs are unusual, only then does the whole table need to be scanned for an entry that should now be found instead */
+	for (std::size_t index = 0; index < this->entries.size(); index++) {
+		if (index != i_index && this->entries[index].status != EntryStatus::FREE && this->entries[index].sourceId == sourceId) {
+			this->slots[this->findSlot(sourceId)] = static_cast<uint8_t>(index);
+			this->nbDuplicateEntries--;
+			break;
+		}
+	}
+}
+
+void CGpTableMirror::allocateEntry(uint8_t i_index, uint32_t i_source_id) {
+	if (i_index == NO_ENTRY) {
+		return;
+	}
+	this->grow(i_index);
+	Entry& entry = this->entries[i_index];
+	if (entry.status != EntryStatus::FREE) {
+		return;
+	}
+	entry = BLANK_ENTRY;
+	entry.status = EntryStatus::ALLOCATED;
+	entry.sourceId = i_source_id;
+	this->link(i_index);
+}
+
+void CGpTableMirror::setEntry(uint8_t i_index, const Entry& i_entry) {
+	if (i_index == NO_ENTRY) {
+		return;
+	}
+	this->grow(i_index);
+	Entry& entry = this->entries[i_index];
+	bool relink = (entry.status == EntryStatus::FREE || entry.sourceId != i_entry.sourceId);
+	if (relink && entry.status != EntryStatus::FREE) {
+		this->unlink(i_index);
+	}
+	entry = i_entry;
+	entry.status = EntryStatus::ACTIVE;
+	if (relink) {
+		this->link(i_index);
+	}
+}
+
+uint8_t CGpTableMirror::addEntry(const Entry& i_entry) {
+	uint8_t index = this->find(i_entry.sourceId);
+	if (index == NO_ENTRY) {
+		for (std::size_t candidate = 0; candidate < this->entries.size(); candidate++) {
+			if (this->entries[candidate].status == EntryStatus::FREE) {
+				index = static_cast<uint8_t>(candidate);
+				break;
+			}
+		}
+	}
+	if (index == NO_ENTRY) {
+		if (this->loaded || this->entries.size() >= MAX_ENTRIES) {
+			return NO_ENTRY;	/* All entries of the adapter's table are used */
+		}
+		index = static_cast<uint8_t>(this->entries.size());
+	}
+	this->setEntry(index, i_entry);
+	return index;
+}
+
+void CGpTableMirror::removeEntry(uint8_t i_index) {
+	if (i_index >= this->entries.size()) {
+		return;
+	}
+	Entry& entry = this->entries[i_index];
+	if (entry.status == EntryStatus::FREE) {
+		return;
+	}
+	this->unlink(i_index);
+	entry = BLANK_ENTRY;
+}
+
+std::size_t CGpTableMirror::removeSourceId(uint32_t i_source_id) {
+	std::size_t nbRemoved = 0;
+	uint8_t index;
+	while ((index = this->find(i_source_id)) != NO_ENTRY) {
+		this->removeEntry(index);
+		nbRemoved++;
+	}
+	return nbRemoved;
+}
+
+void CGpTableMirror::clear() {
+	for (Entry& entry : this->entries) {
+		entry = BLANK_ENTRY;
+	}
+	this->slots.assign(NB_SLOTS, NO_ENTRY);
+	this->nbUsedEntries = 0;
+	this->nbDuplicateEntries = 0;
+}
+
+void CGpTableMirror::getUsedSourceIds(std::vector<uint32_t>& o_source_ids) const {
+	for (uint8_t index : this->slots) {
+		if (index != NO_ENTRY) {
+			o_source_ids.push_back(this->entries[index].sourceId);
+		}
+	}
+}
@@ -0,0 +1,230 @@
+/**
+ * @file green-power-table-mirror.h
+ *
+ * @brief Host-side copy of the adapter's green power sink or proxy table
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+#include "ezsp/ezsp-protocol/ezsp-enum.h"
+
+namespace NSEZSP {
+
+/**
+ * @brief Host-side copy of one of the adapter's green power tables (sink table or proxy table)
+ *
+ * The copy is loaded once by reading every entry of the adapter's table (see startLoad() and endLoad()), and is then kept up to date
+ * by the sink from the responses to the commands that modify the table, so that looking up a source ID, checking whether an entry is
+ * blank, or listing the entries to remove does not cost any EZSP round trip.
+ *
+ * Entries are stored by index, and indexes of used entries are also stored in a flat open-addressing hash table keyed by source ID,
+ * so that find() runs in constant time. All storage is reserved at construction, no method allocates afterwards.
+ */
+class CGpTableMirror {
+public:
+	static constexpr uint8_t NO_ENTRY = 0xFF;	/*!< Index returned when no entry matches (the adapter also uses 0xFF as an invalid index) */
+	static constexpr std::size_t MAX_ENTRIES = NO_ENTRY;	/*!< Maximum number of entries of a table */
+
+	/**
+	 * @brief Status of an entry
+	 */
+	enum class EntryStatus : uint8_t {
+		FREE,	/*!< The entry is blank */
+		ALLOCATED,	/*!< The adapter returned this index for a source ID (GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY), but the entry has not been written yet */
+		ACTIVE,	/*!< The entry holds a device */
+	};
+
+	/**
+	 * @brief An entry of the table
+	 */
+	struct Entry {
+		EntryStatus status;	/*!< Status of the entry */
+		uint32_t sourceId;	/*!< Source ID of the device (meaningless if status is EntryStatus::FREE) */
+		uint32_t options;	/*!< Options of the entry, as stored by the adapter */
+		uint8_t securityOptions;	/*!< Security options of the entry (security level and key type) */
+		EmberKeyData key;	/*!< Key of the device */
+	};
+
+	CGpTableMirror();
+
+	/**
+	 * @brief Forget all entries, before reading the adapter's table again
+	 *
+	 * isLoaded() returns false until endLoad() is invoked.
+	 */
+	void startLoad();
+
+	/**
+	 * @brief Record an entry read from the adapter's table
+	 *
+	 * @param i_index The index of the entry
+	 * @param i_entry The entry (with EntryStatus::FREE for a blank entry)
+	 */
+	void loadEntry(uint8_t i_index, const Entry& i_entry);
+
+	/**
+	 * @brief Mark the copy as complete, all entries of the adapter's table have been read
+	 */
+	void endLoad();
+
+	/**
+	 * @brief Check whether the copy is complete
+	 *
+	 * @return true if endLoad() has been invoked since the last startLoad()
+	 */
+	bool isLoaded() const;
+
+	/**
+	 * @brief Get the number of entries of the table
+	 *
+	 * @return The number of entries read from the adapter (or the highest index written since, plus one)
+	 */
+	std::size_t size() const;
+
+	/**
+	 * @brief Get the number of entries that are not blank
+	 *
+	 * @return The number of entries in EntryStatus::ALLOCATED or EntryStatus::ACTIVE
+	 */
+	std::size_t getNbUsedEntries() const;
+
+	/**
+	 * @brief Get an entry
+	 *
+	 * @param i_index The index of the entry
+	 *
+	 * @return The entry (a blank entry if i_index is not lower than size())
+	 */
+	const Entry& getEntry(uint8_t i_index) const;
+
+	/**
+	 * @brief Find the entry used by a source ID
+	 *
+	 * @param i_source_id The source ID to look for
+	 *
+	 * @return The index of the entry, or NO_ENTRY if no entry is used by this source ID
+	 */
+	uint8_t find(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Check whether an entry is known to be blank in the adapter
+	 *
+	 * @param i_index The index of the entry
+	 *
+	 * @return true if the copy is loaded and the entry does not hold a device, false if the entry must be read from the adapter
+	 */
+	bool isBlank(uint8_t i_index) const;
+
+	/**
+	 * @brief Record that the adapter has reserved an entry for a source ID
+	 *
+	 * Entries that are already used are left unchanged.
+	 *
+	 * @param i_index The index returned by the adapter
+	 * @param i_source_id The source ID of the device
+	 */
+	void allocateEntry(uint8_t i_index, uint32_t i_source_id);
+
+	/**
+	 * @brief Record that an entry has been written
+	 *
+	 * @param i_index The index of the entry
+	 * @param i_entry The content written (its status is ignored, the entry becomes EntryStatus::ACTIVE)
+	 */
+	void setEntry(uint8_t i_index, const Entry& i_entry);
+
+	/**
+	 * @brief Record that the adapter has stored a device in the first entry it could use
+	 *
+	 * This is used for the proxy table, the adapter does not tell which entry has been used when processing a pairing.
+	 *
+	 * @param i_entry The content written (its status is ignored, the entry becomes EntryStatus::ACTIVE)
+	 *
+	 * @return The index of the entry already used by the source ID, or of the first blank entry, or NO_ENTRY if the table is full
+	 */
+	uint8_t addEntry(const Entry& i_entry);
+
+	/**
+	 * @brief Record that an entry has been removed
+	 *
+	 * @param i_index The index of the entry
+	 */
+	void removeEntry(uint8_t i_index);
+
+	/**
+	 * @brief Record that all entries used by a source ID have been removed
+	 *
+	 * @param i_source_id The source ID of the device
+	 *
+	 * @return The number of entries removed
+	 */
+	std::size_t removeSourceId(uint32_t i_source_id);
+
+	/**
+	 * @brief Record that all entries have been removed
+	 *
+	 * The copy stays loaded.
+	 */
+	void clear();
+
+	/**
+	 * @brief List the source IDs of the used entries
+	 *
+	 * @param[out] o_source_ids The source ID of each used entry is appended to this vector (once per source ID)
+	 */
+	void getUsedSourceIds(std::vector<uint32_t>& o_source_ids) const;
+
+private:
+	/**
+	 * @brief Get the slot where the lookup for a source ID starts
+	 *
+	 * @param i_source_id The source ID
+	 *
+	 * @return The slot index
+	 */
+	std::size_t homeSlot(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Get the slot holding a source ID, or the empty slot that ends its probe sequence
+	 *
+	 * @param i_source_id The source ID
+	 *
+	 * @return The slot index
+	 */
+	std::size_t findSlot(uint32_t i_source_id) const;
+
+	/**
+	 * @brief Make an entry that has just been used reachable by its source ID
+	 *
+	 * @param i_index The index of the entry
+	 */
+	void link(uint8_t i_index);
+
+	/**
+	 * @brief Make an entry that is about to become blank unreachable by its source ID
+	 *
+	 * If another entry is used by the same source ID, that entry becomes reachable instead.
+	 *
+	 * @param i_index The index of the entry
+	 */
+	void unlink(uint8_t i_index);
+
+	/**
+	 * @brief Grow the table so that an index is valid
+	 *
+	 * @param i_index The index
+	 */
+	void grow(uint8_t i_index);
+
+	std::vector<Entry> entries;	/*!< Entries, by index */
+	std::vector<uint8_t> slots;	/*!< Open-addressing hash table keyed by source ID, holding the index of used entries (NO_ENTRY in empty slots) */
+	std::size_t nbUsedEntries;	/*!< Number of entries in EntryStatus::ALLOCATED or EntryStatus::ACTIVE */
+	std::size_t nbDuplicateEntries;	/*!< Number of used entries not reachable from slots, because their source ID is used by another entry */
+	bool loaded;	/*!< Has the adapter's table been read entirely? */
+};
+
+} // namespace NSEZSP
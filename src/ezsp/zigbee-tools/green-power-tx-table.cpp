@@ -0,0 +1,129 @@
+/**
+ * @file green-power-tx-table.cpp
+ *
+ * @brief Table of the GPDF transmissions queued in the adapter and not yet confirmed, by handle
+ */
+
+#include <algorithm>
+
+#include "green-power-tx-table.h"
+
+using NSEZSP::CGpTxTable;
+using NSEZSP::CGpTxConfirmation;
+
+constexpr uint8_t CGpTxTable::NO_HANDLE;
+constexpr std::size_t CGpTxTable::MAX_PENDING;
+
+CGpTxTable::CGpTxTable(std::size_t i_max_pending) :
+	transmissions(std::min<std::size_t>(i_max_pending, 255) + 1),
+	freeHandles(),
+	nbPending(0),
+	stats(),
+	latencySum(0) {
+	for (std::size_t handle = NO_HANDLE + 1; handle < this->transmissions.size(); handle++) {
+		this->freeHandles.push_back(static_cast<uint8_t>(handle));
+	}
+}
+
+bool CGpTxTable::allocate(uint32_t i_source_id, uint8_t i_command_id, std::chrono::steady_clock::time_point i_now,
+                          std::chrono::steady_clock::duration i_timeout, FSentCallback i_callback, uint8_t& o_handle) {
+	if (this->freeHandles.empty()) {
+		return false;
+	}
+	o_handle = this->freeHandles.front();
+	this->freeHandles.pop_front();
+	Transmission& transmission = this->transmissions[o_handle];
+	transmission.pending = true;
+	transmission.sourceId = i_source_id;
+	transmission.commandId = i_command_id;
+	transmission.sent = i_now;
+	transmission.deadline = i_now + i_timeout;
+	transmission.callback = std::move(i_callback);
+	this->nbPending++;
+	return true;
+}
+
+bool CGpTxTable::confirm(uint8_t i_handle, EEmberStatus i_status, std::chrono::steady_clock::time_point i_now,
+                         CGpTxConfirmation& o_confirmation, FSentCallback& o_callback) {
+	if (i_handle >= this->transmissions.size() || !this->transmissions[i_handle].pending) {
+		return false;
+	}
+	Transmission& transmission = this->transmissions[i_handle];
+	std::chrono::microseconds latency = std::chrono::duration_cast<std::chrono::microseconds>(i_now - transmission.sent);
+	o_confirmation = { transmission.sourceId, transmission.commandId, i_handle, false, i_status, latency };
+	o_callback = std::move(transmission.callback);
+
+	if (i_status == EEmberStatus::EMBER_SUCCESS) {
+		this->stats.nbConfirmed++;
+	}
+	else {
+		this->stats.nbFailed++;
+	}
+	std::size_t nbMeasured = this->stats.nbConfirmed + this->stats.nbFailed;
+	if (nbMeasured == 1 || latency < this->stats.minLatency) {
+		this->stats.minLatency = latency;
+	}
+	if (latency > this->stats.maxLatency) {
+		this->stats.maxLatency = latency;
+	}
+	this->latencySum += latency;
+	this->stats.averageLatency = this->latencySum / static_cast<std::chrono::microseconds::rep>(nbMeasured);
+
+	this->release(i_handle);
+	return true;
+}
+
+void CGpTxTable::cancel(uint8_t i_handle) {
+	if (i_handle < this->transmissions.size() && this->transmissions[i_handle].pending) {
+		this->release(i_handle);
+	}
+}
+
+void CGpTxTable::expire(std::chrono::steady_clock::time_point i_now, std::vector<std::pair<CGpTxConfirmation, FSentCallback> >& o_expired) {
+	for (std::size_t handle = NO_HANDLE + 1; handle < this->transmissions.size() && this->nbPending > 0; handle++) {
+		Transmission& transmission = this->transmissions[handle];
+		if (!transmission.pending || transmission.deadline > i_now) {
+			continue;
+		}
+		CGpTxConfirmation confirmation = { transmission.sourceId, transmission.commandId, static_cast<uint8_t>(handle), true,
+		                                   EEmberStatus::EMBER_DELIVERY_FAILED,
+		                                   std::chrono::duration_cast<std::chrono::microseconds>(i_now - transmission.sent) };
+		o_expired.emplace_back(confirmation, std::move(transmission.callback));
+		this->stats.nbExpired++;
+		this->release(static_cast<uint8_t>(handle));
+	}
+}
+
+bool CGpTxTable::getNextDeadline(std::chrono::steady_clock::time_point& o_deadline) const {
+	bool found = false;
+	for (std::size_t handle = NO_HANDLE + 1; handle < this->transmissions.size(); handle++) {
+		const Transmission& transmission = this->transmissions[handle];
+		if (transmission.pending && (!found || transmission.deadline < o_deadline)) {
+			o_deadline = transmission.deadline;
+			found = true;
+		}
+	}
+	return found;
+}
+
+bool CGpTxTable::isPending(uint32_t i_source_id, uint8_t i_command_id) const {
+	return std::any_of(this->transmissions.begin(), this->transmissions.end(), [i_source_id, i_command_id](const Transmission& transmission) {
+		return transmission.pending && transmission.sourceId == i_source_id && transmission.commandId == i_command_id;
+	});
+}
+
+std::size_t CGpTxTable::getNbPending() const {
+	return this->nbPending;
+}
+
+CGpTxTable::LatencyStats CGpTxTable::getLatencyStats() const {
+	return this->stats;
+}
+
+void CGpTxTable::release(uint8_t i_handle) {
+	Transmission& transmission = this->transmissions[i_handle];
+	transmission.pending = false;
+	transmission.callback = nullptr;
+	this->freeHandles.push_back(i_handle);
+	this->nbPending--;
+}
@@ -0,0 +1,165 @@
+/**
+ * @file green-power-tx-table.h
+ *
+ * @brief Table of the GPDF transmissions queued in the adapter and not yet confirmed, by handle
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <chrono>
+#include <functional>
+
+#include "ezsp/ezsp-protocol/ezsp-enum.h"
+
+namespace NSEZSP {
+
+/**
+ * @brief Outcome of a GPDF transmission
+ */
+struct CGpTxConfirmation {
+	uint32_t sourceId;	/*!< The source ID of the destination GPD */
+	uint8_t commandId;	/*!< The GPD command ID that was sent */
+	uint8_t handle;	/*!< The handle that was used for the transmission */
+	bool expired;	/*!< true if the adapter never confirmed the transmission before its deadline */
+	EEmberStatus status;	/*!< The status reported by the adapter (EMBER_DELIVERY_FAILED if expired) */
+	std::chrono::microseconds latency;	/*!< The time from the transmission request to its confirmation (or expiration) */
+};
+
+/**
+ * @brief GPDF transmissions waiting for their EZSP_D_GP_SENT_HANDLER confirmation, indexed by the handle given to the adapter
+ *
+ * Handles are taken from a free list. Released handles are appended at the end of the list, so that a handle is reused as late as
+ * possible, and a late confirmation for an expired transmission is not mistaken for a newer one.
+ * Handle NO_HANDLE (0) is never allocated, it is left for transmissions that are not tracked.
+ *
+ * All storage is reserved at construction. This class is not thread-safe, the sink protects it with its own mutex.
+ */
+class CGpTxTable {
+public:
+	typedef std::function<void (const CGpTxConfirmation& i_confirmation)> FSentCallback;	/*!< Callback invoked when a transmission is confirmed or expires */
+
+	static constexpr uint8_t NO_HANDLE = 0;	/*!< The handle used for transmissions that are not tracked */
+	static constexpr std::size_t MAX_PENDING = 64;	/*!< Default maximum number of transmissions pending at the same time */
+
+	/**
+	 * @brief A transmission waiting for its confirmation
+	 */
+	struct Transmission {
+		bool pending;	/*!< Is this handle in use? */
+		uint32_t sourceId;	/*!< The source ID of the destination GPD */
+		uint8_t commandId;	/*!< The GPD command ID that was sent */
+		std::chrono::steady_clock::time_point sent;	/*!< When the transmission was requested */
+		std::chrono::steady_clock::time_point deadline;	/*!< When to give up waiting for the confirmation */
+		FSentCallback callback;	/*!< The callback to invoke with the outcome (may be empty) */
+	};
+
+	/**
+	 * @brief Confirmation latency statistics
+	 */
+	struct LatencyStats {
+		std::size_t nbConfirmed;	/*!< Transmissions confirmed by the adapter with EMBER_SUCCESS */
+		std::size_t nbFailed;	/*!< Transmissions confirmed by the adapter with another status */
+		std::size_t nbExpired;	/*!< Transmissions never confirmed before their deadline */
+		std::chrono::microseconds minLatency;	/*!< Lowest confirmation latency (confirmed and failed transmissions) */
+		std::chrono::microseconds maxLatency;	/*!< Highest confirmation latency */
+		std::chrono::microseconds averageLatency;	/*!< Average confirmation latency */
+	};
+
+	/**
+	 * @brief Constructor
+	 *
+	 * @param i_max_pending The maximum number of transmissions pending at the same time (at most 255)
+	 */
+	explicit CGpTxTable(std::size_t i_max_pending = MAX_PENDING);
+
+	/**
+	 * @brief Allocate a handle for a new transmission
+	 *
+	 * @param i_source_id The source ID of the destination GPD
+	 * @param i_command_id The GPD command ID to send
+	 * @param i_now The current time
+	 * @param i_timeout How long to wait for the confirmation
+	 * @param i_callback The callback to invoke with the outcome
+	 * @param[out] o_handle The allocated handle
+	 *
+	 * @return false if all handles are in use
+	 */
+	bool allocate(uint32_t i_source_id, uint8_t i_command_id, std::chrono::steady_clock::time_point i_now,
+	              std::chrono::steady_clock::duration i_timeout, FSentCallback i_callback, uint8_t& o_handle);
+
+	/**
+	 * @brief Release the handle of a transmission confirmed by the adapter
+	 *
+	 * @param i_handle The handle carried by EZSP_D_GP_SENT_HANDLER
+	 * @param i_status The status carried by EZSP_D_GP_SENT_HANDLER
+	 * @param i_now The current time
+	 * @param[out] o_confirmation The outcome of the transmission
+	 * @param[out] o_callback The callback of the transmission, to invoke with @p o_confirmation
+	 *
+	 * @return false if no transmission is pending for this handle
+	 */
+	bool confirm(uint8_t i_handle, EEmberStatus i_status, std::chrono::steady_clock::time_point i_now,
+	             CGpTxConfirmation& o_confirmation, FSentCallback& o_callback);
+
+	/**
+	 * @brief Release the handle of a transmission that was not accepted by the adapter, without counting it in statistics
+	 *
+	 * @param i_handle The handle allocated for the transmission
+	 */
+	void cancel(uint8_t i_handle);
+
+	/**
+	 * @brief Release the handles of all transmissions whose deadline is over
+	 *
+	 * @param i_now The current time
+	 * @param[out] o_expired The outcomes and callbacks of the expired transmissions are appended here
+	 */
+	void expire(std::chrono::steady_clock::time_point i_now, std::vector<std::pair<CGpTxConfirmation, FSentCallback> >& o_expired);
+
+	/**
+	 * @brief Get the earliest deadline of the pending transmissions
+	 *
+	 * @param[out] o_deadline The earliest deadline
+	 *
+	 * @return false if no transmission is pending
+	 */
+	bool getNextDeadline(std::chrono::steady_clock::time_point& o_deadline) const;
+
+	/**
+	 * @brief Check whether a transmission of a command to a GPD is pending
+	 *
+	 * @param i_source_id The source ID of the destination GPD
+	 * @param i_command_id The GPD command ID
+	 *
+	 * @return true if such a transmission is waiting for its confirmation
+	 */
+	bool isPending(uint32_t i_source_id, uint8_t i_command_id) const;
+
+	/**
+	 * @brief Get the number of pending transmissions
+	 */
+	std::size_t getNbPending() const;
+
+	/**
+	 * @brief Get the confirmation latency statistics since construction
+	 */
+	LatencyStats getLatencyStats() const;
+
+private:
+	/**
+	 * @brief Release a handle, appending it to the free list
+	 */
+	void release(uint8_t i_handle);
+
+	std::vector<Transmission> transmissions;	/*!< Transmissions, indexed by handle */
+	std::deque<uint8_t> freeHandles;	/*!< Handles not in use, least recently released first */
+	std::size_t nbPending;	/*!< Number of handles in use */
+	LatencyStats stats;	/*!< Latency statistics (averageLatency is computed from latencySum) */
+	std::chrono::microseconds latencySum;	/*!< Sum of the latencies of confirmed and failed transmissions */
+};
+
+} // namespace NSEZSP
@@ -16,7 +16,7 @@ CZigbeeMessaging::CZigbeeMessaging(CEzspDongle& i_dongle, const NSSPI::TimerBuil
 	dongle.registerObserver(this);
 }
 
-void CZigbeeMessaging::handleEzspRxMessage( EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_receive ) {
+void CZigbeeMessaging::handleEzspRxMessage( EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive ) {
 	switch( i_cmd ) {
 	case EZSP_MESSAGE_SENT_HANDLER: {
 		clogD << "EZSP_MESSAGE_SENT_HANDLER return status : " << CEzspEnum::EEmberStatusToString(static_cast<EEmberStatus>(i_msg_receive.at(16))) << std::endl;
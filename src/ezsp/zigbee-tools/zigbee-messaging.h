@@ -37,7 +37,7 @@ public:
 	/**
 	 * Observer
 	 */
-	void handleEzspRxMessage( EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_receive );
+	void handleEzspRxMessage( EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive );
 
 private:
 	CEzspDongle &dongle;
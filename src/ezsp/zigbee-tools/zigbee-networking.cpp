@@ -28,7 +28,7 @@ CZigbeeNetworking::CZigbeeNetworking( CEzspDongle &i_dongle, CZigbeeMessaging &i
 	dongle.registerObserver(this);
 }
 
-void CZigbeeNetworking::handleEzspRxMessage(EEzspCmd i_cmd, NSSPI::ByteBuffer i_msg_receive) {
+void CZigbeeNetworking::handleEzspRxMessage(EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive) {
 	// clogD << "CZigbeeNetworking::handleEzspRxMessage : " << CEzspEnum::EEzspCmdToString(i_cmd) << std::endl;
 
 	switch( i_cmd ) {
@@ -44,8 +44,13 @@ void CZigbeeNetworking::handleEzspRxMessage(EEzspCmd i_cmd, NSSPI::ByteBuffer i_
 	case EZSP_GET_CHILD_DATA: {
 		clogD << "EZSP_GET_CHILD_DATA return  at index : " << unsigned(child_idx) << ", status : " << CEzspEnum::EEmberStatusToString(static_cast<EEmberStatus>(i_msg_receive.at(0))) << std::endl;
 		if( EMBER_SUCCESS == i_msg_receive.at(0) ) {
-			i_msg_receive.erase(i_msg_receive.begin());
-			CEmberChildDataStruct l_rsp(i_msg_receive);
+			NSSPI::ByteReader l_reader(i_msg_receive);
+			l_reader.skip(1);	/* Status byte, already checked above */
+			CEmberChildDataStruct l_rsp(l_reader);
+			if (l_reader.hasError()) {
+				clogE << "Truncated EZSP_GET_CHILD_DATA response: " << i_msg_receive << "\n";
+				break;
+			}
 			clogD << l_rsp.String() << std::endl;
 
 			// appeler la fonction de nouveau produit
@@ -1,22 +1,106 @@
 #include "spi/AesBuilder.h"
 
-#undef __AES_SPI_FOUND__ //NOSONAR
-#define __AES_SPI_FOUND__
 #ifdef USE_AESCUSTOM
 #include "spi/custom-aes/custom-aes.h"
-typedef NSSPI::CustomAes Aes;
 #endif
-#ifndef __AES_SPI_FOUND__
-# error At least one AES SPI should be selected
+#ifdef USE_AESTTABLE
+#include "spi/ttable-aes/ttable-aes.h"
+#endif
+#ifdef USE_AESNI
+#include "spi/aesni-aes/aesni-aes.h"
+#endif
+#if !defined(USE_AESCUSTOM) && !defined(USE_AESTTABLE)
+# error At least one portable AES SPI (USE_AESCUSTOM or USE_AESTTABLE) should be selected
 #endif
-#undef __AES_SPI_FOUND__ //NOSONAR
 
 using NSSPI::AesBuilder;
 using NSSPI::IAes;
 
+namespace {
+/**
+ * @brief The AES implementations AesBuilder can select from
+ */
+enum class AesBackend {
+	AESNI,	/*!< AES-NI instructions (only if supported by the CPU) */
+	TTABLE,	/*!< Portable 32-bit T-table implementation */
+	CUSTOM,	/*!< Portable byte-oriented implementation */
+};
+
+/**
+ * @brief Select the fastest AES implementation available, once for the whole process
+ *
+ * @return The selected implementation
+ */
+AesBackend getBackend() {
+	static const AesBackend backend = []() {
+#if defined(USE_AESNI) && defined(AESNI_AES_AVAILABLE)
+		if (NSSPI::AesNiAes::isSupported()) {
+			return AesBackend::AESNI;
+		}
+#endif
+#ifdef USE_AESTTABLE
+		return AesBackend::TTABLE;
+#else
+		return AesBackend::CUSTOM;
+#endif
+	}();
+	return backend;
+}
+}
+
 std::unique_ptr<IAes> AesBuilder::create() {
-	/* TODO: When using a C++14 compliant compiler, the line below should be replaced with:
-	 * return std::make_unique<IAes>();
-	 */
-	return std::unique_ptr<IAes>(new Aes());
+	/* TODO: When using a C++14 compliant compiler, the lines below should be replaced with std::make_unique<>() */
+	switch (getBackend()) {
+#if defined(USE_AESNI) && defined(AESNI_AES_AVAILABLE)
+	case AesBackend::AESNI:
+		return std::unique_ptr<IAes>(new AesNiAes());
+#endif
+#ifdef USE_AESTTABLE
+	case AesBackend::TTABLE:
+		return std::unique_ptr<IAes>(new TTableAes());
+#endif
+	default:
+#ifdef USE_AESCUSTOM
+		return std::unique_ptr<IAes>(new CustomAes());
+#else
+		return std::unique_ptr<IAes>(new TTableAes());
+#endif
+	}
+}
+
+const IAes& AesBuilder::shared() {
+	/* Function-local statics are constructed on first use only (so there is no instance of unused backends), and their initialization is thread-safe since C++11 */
+	switch (getBackend()) {
+#if defined(USE_AESNI) && defined(AESNI_AES_AVAILABLE)
+	case AesBackend::AESNI: {
+		static const AesNiAes instance;
+		return instance;
+	}
+#endif
+#ifdef USE_AESTTABLE
+	case AesBackend::TTABLE: {
+		static const TTableAes instance;
+		return instance;
+	}
+#endif
+	default: {
+#ifdef USE_AESCUSTOM
+		static const CustomAes instance;
+#else
+		static const TTableAes instance;
+#endif
+		return instance;
+	}
+	}
+}
+
+const char* AesBuilder::getBackendName() {
+	switch (getBackend()) {
+	case AesBackend::AESNI:
+		return "AES-NI";
+	case AesBackend::TTABLE:
+		return "T-table";
+	default:
+		return "custom";
+	}
 }
@@ -0,0 +1,165 @@
+/**
+ * @file AllocCounter.cpp
+ *
+ * @brief Replacement of the global operator new/delete counting allocations per thread and per layer
+ *
+ * This file is only compiled when the USE_ALLOC_COUNTING build option is set.
+ * Because the operators below are exported by the ezspspi shared library, they replace the default ones for the whole
+ * process (including allocations performed by the C++ standard library).
+ */
+
+#include <cstdlib>	// For malloc()/free()
+#include <cstdio>	// For fprintf()
+#include <new>
+#include <atomic>
+
+#include <spi/AllocCounter.h>
+
+using NSSPI::AllocCounter;
+
+namespace {
+/* Only trivially constructible thread_local variables here, as they are accessed from within operator new */
+thread_local AllocCounter::Stats tlsStats[static_cast<unsigned int>(AllocCounter::Layer::NB_LAYERS)];
+thread_local AllocCounter::Stats tlsViolations[static_cast<unsigned int>(AllocCounter::Layer::NB_LAYERS)];
+thread_local AllocCounter::Layer tlsCurrentLayer = AllocCounter::Layer::NONE;
+thread_local bool tlsPoisoned = false;
+std::atomic<unsigned int> processPoisonDepth(0);	/* Number of live ProcessPoison objects */
+std::atomic<uint64_t> processViolationAllocs[static_cast<unsigned int>(AllocCounter::Layer::NB_LAYERS)];
+std::atomic<uint64_t> processViolationBytes[static_cast<unsigned int>(AllocCounter::Layer::NB_LAYERS)];
+}
+
+AllocCounter::Scope::Scope(Layer layer) :
+	previous(tlsCurrentLayer) {
+	tlsCurrentLayer = layer;
+}
+
+AllocCounter::Scope::~Scope() {
+	tlsCurrentLayer = this->previous;
+}
+
+AllocCounter::Poison::Poison() :
+	previous(tlsPoisoned) {
+	tlsPoisoned = true;
+}
+
+AllocCounter::Poison::~Poison() {
+	tlsPoisoned = this->previous;
+}
+
+AllocCounter::ProcessPoison::ProcessPoison() {
+	processPoisonDepth++;
+}
+
+AllocCounter::ProcessPoison::~ProcessPoison() {
+	processPoisonDepth--;
+}
+
+AllocCounter::Stats AllocCounter::get(Layer layer) {
+	return tlsStats[static_cast<unsigned int>(layer)];
+}
+
+AllocCounter::Stats AllocCounter::getViolations(Layer layer) {
+	return tlsViolations[static_cast<unsigned int>(layer)];
+}
+
+AllocCounter::Stats AllocCounter::getProcessViolations(Layer layer) {
+	AllocCounter::Stats violations;
+	violations.allocs = processViolationAllocs[static_cast<unsigned int>(layer)];
+	violations.bytes = processViolationBytes[static_cast<unsigned int>(layer)];
+	return violations;
+}
+
+void AllocCounter::reset() {
+	for (unsigned int layer = 0; layer < static_cast<unsigned int>(Layer::NB_LAYERS); layer++) {
+		processViolationAllocs[layer] = 0;
+		processViolationBytes[layer] = 0;
+		tlsStats[layer].allocs = 0;
+		tlsStats[layer].bytes = 0;
+		tlsViolations[layer].allocs = 0;
+		tlsViolations[layer].bytes = 0;
+	}
+}
+
+const char* AllocCounter::layerToString(Layer layer) {
+	switch (layer) {
+	case Layer::NONE:
+		return "none";
+	case Layer::ASH:
+		return "ASH";
+	case Layer::DONGLE:
+		return "dongle";
+	case Layer::GP_SINK:
+		return "GP sink";
+	case Layer::USER_CALLBACK:
+		return "user callback";
+	default:
+		return "unknown";
+	}
+}
+
+void AllocCounter::onAlloc(std::size_t size) {
+	AllocCounter::Stats& stats = tlsStats[static_cast<unsigned int>(tlsCurrentLayer)];
+	stats.allocs++;
+	stats.bytes += size;
+	if ((tlsPoisoned || processPoisonDepth.load(std::memory_order_relaxed) != 0) && tlsCurrentLayer != Layer::NONE) {
+		AllocCounter::Stats& violations = tlsViolations[static_cast<unsigned int>(tlsCurrentLayer)];
+		violations.allocs++;
+		violations.bytes += size;
+		processViolationAllocs[static_cast<unsigned int>(tlsCurrentLayer)]++;
+		processViolationBytes[static_cast<unsigned int>(tlsCurrentLayer)] += size;
+		std::fprintf(stderr, "Poisoned allocator: %zu bytes requested by layer %s\n", size, AllocCounter::layerToString(tlsCurrentLayer));	/* Does not allocate */
+	}
+}
+
+namespace {
+void* countedAlloc(std::size_t size) {
+	AllocCounter::onAlloc(size);
+	void* p = std::malloc(size ? size : 1);
+	if (!p) {
+		throw std::bad_alloc();
+	}
+	return p;
+}
+}
+
+LIBEXPORT void* operator new(std::size_t size) {
+	return countedAlloc(size);
+}
+
+LIBEXPORT void* operator new[](std::size_t size) {
+	return countedAlloc(size);
+}
+
+LIBEXPORT void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+	AllocCounter::onAlloc(size);
+	return std::malloc(size ? size : 1);
+}
+
+LIBEXPORT void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+	AllocCounter::onAlloc(size);
+	return std::malloc(size ? size : 1);
+}
+
+LIBEXPORT void operator delete(void* p) noexcept {
+	std::free(p);
+}
+
+LIBEXPORT void operator delete[](void* p) noexcept {
+	std::free(p);
+}
+
+LIBEXPORT void operator delete(void* p, const std::nothrow_t&) noexcept {
+	std::free(p);
+}
+
+LIBEXPORT void operator delete[](void* p, const std::nothrow_t&) noexcept {
+	std::free(p);
+}
+
+LIBEXPORT void operator delete(void* p, std::size_t) noexcept {
+	std::free(p);
+}
+
+LIBEXPORT void operator delete[](void* p, std::size_t) noexcept {
+	std::free(p);
+}
@@ -7,15 +7,21 @@ GenericAsyncDataInputObservable::GenericAsyncDataInputObservable() : observers()
 }
 
 bool GenericAsyncDataInputObservable::registerObserver(IAsyncDataInputObserver* observer) {
-	return this->observers.emplace(observer).second;
+	return this->observers.add(observer);
 }
 
 bool GenericAsyncDataInputObservable::unregisterObserver(IAsyncDataInputObserver* observer) {
-	return static_cast<bool>(this->observers.erase(observer));
+	return this->observers.remove(observer);
 }
 
 void GenericAsyncDataInputObservable::notifyObservers(const unsigned char* inputData, const size_t inputDataLen) {
-	for(auto observer : this->observers) {
+	this->observers.forEach([&inputData, &inputDataLen](IAsyncDataInputObserver* observer) {
 		observer->handleInputData(inputData, inputDataLen);
-	}
+	});
+}
+
+void GenericAsyncDataInputObservable::notifyObserversOfInputBurstEnd() {
+	this->observers.forEach([](IAsyncDataInputObserver* observer) {
+		observer->handleInputBurstEnd();
+	});
 }
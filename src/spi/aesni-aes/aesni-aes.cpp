@@ -0,0 +1,156 @@
+/**
+ * @file aesni-aes.cpp
+ *
+ * @brief AES-128 encryption using the x86 AES-NI instructions
+ *
+ * Only the functions using intrinsics are compiled for the AES-NI target (using the target function attribute), so that
+ * this file can be built without any specific compiler flag, and the rest of the library does not require AES-NI.
+ */
+
+#include "aesni-aes.h"
+
+#ifdef AESNI_AES_AVAILABLE
+
+#include <cstring>
+#include <stdexcept>
+
+#include <cpuid.h>
+#include <wmmintrin.h>	// AES-NI intrinsics
+#include <emmintrin.h>	// SSE2 intrinsics
+
+#define AESNI_TARGET __attribute__((target("aes,sse2")))
+
+using NSSPI::AesNiAes;
+using NSSPI::IAes;
+
+namespace {
+/**
+ * @brief Compute the next round key from the previous one and the output of AESKEYGENASSIST on it
+ */
+AESNI_TARGET inline __m128i next_round_key(__m128i key, __m128i keygened) {
+	keygened = _mm_shuffle_epi32(keygened, _MM_SHUFFLE(3, 3, 3, 3));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	key = _mm_xor_si128(key, _mm_slli_si128(key, 4));
+	return _mm_xor_si128(key, keygened);
+}
+
+AESNI_TARGET inline void store_round_key(IAes::ExpandedKey& o_expanded, unsigned int round, __m128i roundKey) {
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(o_expanded.round_keys + round * IAes::AES_BLOCK_SIZE), roundKey);
+}
+}
+
+/* AESKEYGENASSIST requires the round constant as an immediate, thus this macro rather than a loop */
+#define AESNI_EXPAND_ROUND(round, rcon) \
+	do { \
+		roundKey = next_round_key(roundKey, _mm_aeskeygenassist_si128(roundKey, rcon)); \
+		store_round_key(o_expanded, round, roundKey); \
+	} while (0) //NOSONAR
+
+AesNiAes::AesNiAes() :
+	context(),
+	keySet(false) {
+}
+
+bool AesNiAes::isSupported() {
+	unsigned int eax, ebx, ecx, edx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		return false;
+	}
+	return (ecx & bit_AES) != 0 && (edx & bit_SSE2) != 0;
+}
+
+AESNI_TARGET void AesNiAes::expand( const uint8_t key[IAes::AES_KEY_SIZE], IAes::ExpandedKey& o_expanded ) {
+	__m128i roundKey = _mm_loadu_si128(reinterpret_cast<const __m128i*>(key));
+	store_round_key(o_expanded, 0, roundKey);
+	AESNI_EXPAND_ROUND(1, 0x01);
+	AESNI_EXPAND_ROUND(2, 0x02);
+	AESNI_EXPAND_ROUND(3, 0x04);
+	AESNI_EXPAND_ROUND(4, 0x08);
+	AESNI_EXPAND_ROUND(5, 0x10);
+	AESNI_EXPAND_ROUND(6, 0x20);
+	AESNI_EXPAND_ROUND(7, 0x40);
+	AESNI_EXPAND_ROUND(8, 0x80);
+	AESNI_EXPAND_ROUND(9, 0x1b);
+	AESNI_EXPAND_ROUND(10, 0x36);
+}
+
+void AesNiAes::set_key( const uint8_t key[IAes::AES_KEY_SIZE] ) {
+	expand(key, this->context);
+	this->keySet = true;
+}
+
+void AesNiAes::set_key( const NSEZSP::EmberKeyData& key ) {
+	this->expand_key(key, this->context);
+	this->keySet = true;
+}
+
+void AesNiAes::expand_key( const NSEZSP::EmberKeyData& key, IAes::ExpandedKey& o_expanded ) const {
+	if (IAes::AES_KEY_SIZE != key.size()) {
+		throw std::out_of_range("Wrong AES key size");
+	}
+	expand(key.data(), o_expanded);
+}
+
+AESNI_TARGET void AesNiAes::encrypt( const IAes::ExpandedKey& key, const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) const {
+	const __m128i* rk = reinterpret_cast<const __m128i*>(key.round_keys);
+	__m128i state = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), _mm_loadu_si128(rk));
+	for (unsigned int round = 1; round < IAes::AES128_ROUNDS; round++) {
+		state = _mm_aesenc_si128(state, _mm_loadu_si128(rk + round));
+	}
+	state = _mm_aesenclast_si128(state, _mm_loadu_si128(rk + IAes::AES128_ROUNDS));
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(out), state);
+}
+
+AESNI_TARGET void AesNiAes::encrypt_interleaved( const IAes::ExpandedKey* const keys[], const unsigned char in[][IAes::AES_BLOCK_SIZE], unsigned char out[][IAes::AES_BLOCK_SIZE], unsigned int count ) {
+	__m128i state[MAX_INTERLEAVED_BLOCKS];
+	const __m128i* rk[MAX_INTERLEAVED_BLOCKS];
+	for (unsigned int lane = 0; lane < count; lane++) {
+		rk[lane] = reinterpret_cast<const __m128i*>(keys[lane]->round_keys);
+		state[lane] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in[lane])), _mm_loadu_si128(rk[lane]));
+	}
+	/* Round-major loops: the AESENC of the different lanes are independent, so they fill the AES unit pipeline */
+	for (unsigned int round = 1; round < IAes::AES128_ROUNDS; round++) {
+		for (unsigned int lane = 0; lane < count; lane++) {
+			state[lane] = _mm_aesenc_si128(state[lane], _mm_loadu_si128(rk[lane] + round));
+		}
+	}
+	for (unsigned int lane = 0; lane < count; lane++) {
+		state[lane] = _mm_aesenclast_si128(state[lane], _mm_loadu_si128(rk[lane] + IAes::AES128_ROUNDS));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out[lane]), state[lane]);
+	}
+}
+
+void AesNiAes::encrypt_blocks( const IAes::ExpandedKey* const keys[], const unsigned char in[][IAes::AES_BLOCK_SIZE], unsigned char out[][IAes::AES_BLOCK_SIZE], std::size_t count ) const {
+	for (std::size_t first = 0; first < count; first += MAX_INTERLEAVED_BLOCKS) {
+		std::size_t remaining = count - first;
+		encrypt_interleaved(keys + first, in + first, out + first, static_cast<unsigned int>(remaining < MAX_INTERLEAVED_BLOCKS ? remaining : MAX_INTERLEAVED_BLOCKS));
+	}
+}
+
+bool AesNiAes::encrypt( const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) {
+	if (!this->keySet) {
+		return false;
+	}
+	this->encrypt(this->context, in, out);
+	return true;
+}
+
+bool AesNiAes::cbc_encrypt(const unsigned char *in, unsigned char *out, unsigned long size, unsigned char iv[IAes::AES_BLOCK_SIZE]) {
+	if (size % IAes::AES_BLOCK_SIZE != 0 || !this->keySet) {
+		return false;
+	}
+
+	for (unsigned long n_block = size / IAes::AES_BLOCK_SIZE; n_block > 0; n_block--) {
+		for (unsigned int i = 0; i < IAes::AES_BLOCK_SIZE; i++) {
+			iv[i] ^= in[i];
+		}
+		this->encrypt(this->context, iv, iv);
+		memcpy(out, iv, IAes::AES_BLOCK_SIZE);
+		in += IAes::AES_BLOCK_SIZE;
+		out += IAes::AES_BLOCK_SIZE;
+	}
+	return true;
+}
+
+#endif	// AESNI_AES_AVAILABLE
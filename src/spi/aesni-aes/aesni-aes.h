@@ -0,0 +1,58 @@
+/**
+ * @file aesni-aes.h
+ *
+ * @brief AES-128 encryption using the x86 AES-NI instructions
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "spi/IAes.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+# define AESNI_AES_AVAILABLE	/* The compiler can generate AES-NI code for this target */
+#endif
+
+#ifdef AESNI_AES_AVAILABLE
+namespace NSSPI {
+
+/**
+ * @brief AES-128 implementation using the AESENC/AESENCLAST/AESKEYGENASSIST instructions
+ *
+ * @warning Instances must only be used on CPUs supporting AES-NI, see isSupported() (AesBuilder takes care of that)
+ */
+class AesNiAes : public IAes {
+public:
+	AesNiAes();
+
+	/**
+	 * @brief Does the CPU we are running on support the AES-NI instructions?
+	 *
+	 * @return true if AES-NI is supported (as reported by CPUID)
+	 */
+	static bool isSupported();
+
+	void set_key( const uint8_t key[IAes::AES_KEY_SIZE] );
+	void set_key( const NSEZSP::EmberKeyData& key );
+
+	bool encrypt( const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] );
+
+	bool cbc_encrypt(const unsigned char *in, unsigned char *out, unsigned long size, unsigned char iv[IAes::AES_BLOCK_SIZE]);
+
+	void expand_key( const NSEZSP::EmberKeyData& key, IAes::ExpandedKey& o_expanded ) const;
+	void encrypt( const IAes::ExpandedKey& key, const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) const;
+	void encrypt_blocks( const IAes::ExpandedKey* const keys[], const unsigned char in[][IAes::AES_BLOCK_SIZE], unsigned char out[][IAes::AES_BLOCK_SIZE], std::size_t count ) const;
+
+	static constexpr unsigned int MAX_INTERLEAVED_BLOCKS = 8;	/*!< Number of blocks encrypted in parallel by encrypt_blocks(), AESENC has a latency of ~4 cycles and a throughput of 1 or 2 per cycle */
+
+private:
+	static void encrypt_interleaved( const IAes::ExpandedKey* const keys[], const unsigned char in[][IAes::AES_BLOCK_SIZE], unsigned char out[][IAes::AES_BLOCK_SIZE], unsigned int count );
+	static void expand( const uint8_t key[IAes::AES_KEY_SIZE], IAes::ExpandedKey& o_expanded );
+
+	IAes::ExpandedKey context;	/*!< Key schedule of the key set using set_key() */
+	bool keySet;	/*!< Has set_key() been invoked? */
+};
+
+} // namespace NSSPI
+#endif	// AESNI_AES_AVAILABLE
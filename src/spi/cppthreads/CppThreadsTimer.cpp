@@ -13,65 +13,120 @@ using NSSPI::ITimer;
 
 CppThreadsTimer::CppThreadsTimer() :
 	started(false),
-	waitingThread(),
+	armed(false),
+	runningCallback(false),
+	quitting(false),
+	destroyedInCallback(nullptr),
+	generation(0),
+	deadline(),
 	cv(),
 	cv_m(),
-	callback(nullptr) {
+	callback(nullptr),
+	waitingThread(&CppThreadsTimer::routine, this) {
 }
 
 CppThreadsTimer::~CppThreadsTimer() {
-	this->stop();
+	{
+		std::lock_guard<std::mutex> lock(this->cv_m);
+		this->started = false;
+		this->armed = false;
+		this->quitting = true;
+	}
+	this->cv.notify_all();
+	if (this->waitingThread.get_id() == std::this_thread::get_id()) {
+		*this->destroyedInCallback = true;	/* Destroyed from our own callback, the secondary thread exits as soon as the callback returns, without touching this object anymore */
+		this->waitingThread.detach();
+	}
+	else {
+		this->waitingThread.join();
+	}
 }
 
 bool CppThreadsTimer::start(uint32_t timeout, NSSPI::TimerCallback callBackFunction) {
 	//clogD << "Starting timer " << static_cast<void *>(this) << " for " << std::dec << static_cast<unsigned int>(timeout) << "ms\n";
 
-	if (this->started) {
-		clogD << "First stopping the already existing timer " << static_cast<void *>(this) << " before starting again\n";
-		this->stop();
-	}
-
 	if (!callBackFunction) {
 		clogW << "No callback function provided\n";
 		return false;
 	}
 
-	this->duration = timeout;
-	if (this->duration == 0) {
+	if (timeout == 0) {
+		this->stop();
 		clogD << "Timeout set to 0, directly running callback function\n";
 		callBackFunction(this);
+		return true;
 	}
-	else {
+
+	{
+		/* start() and stop() may be invoked concurrently (e.g. ASH ACK timer restarted by the host while the serial reader thread cancels it) */
+		std::unique_lock<std::mutex> lock(this->cv_m);
+		if (this->started) {
+			clogD << "First stopping the already existing timer " << static_cast<void *>(this) << " before starting again\n";
+		}
+		this->waitCallbackEnd(lock);	/* As when stopping, a callback of the previous run is not running anymore when we return */
+		this->generation++;
 		this->started = true;
-		this->callback = callBackFunction;
-		this->waitingThread = std::thread(&CppThreadsTimer::routine, this);
+		this->armed = true;
+		this->duration = timeout;
+		this->deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+		this->callback = std::move(callBackFunction);
 	}
+	this->cv.notify_all();
 
 	return true;
 }
 
 bool CppThreadsTimer::stop() {
-
-	if (! this->started) {
-		return false;
-	}
-	this->started = false;
-	this->cv.notify_one();
-	if (this->waitingThread.joinable()) {
-		this->waitingThread.join();
+	bool wasStarted;
+	{
+		std::unique_lock<std::mutex> lock(this->cv_m);
+		wasStarted = this->started;
+		this->started = false;
+		this->armed = false;
+		this->generation++;
+		this->duration = 0;
+		this->waitCallbackEnd(lock);
 	}
-	this->duration = 0;
-	return true;
+	this->cv.notify_all();
+	return wasStarted;
 }
 
 bool CppThreadsTimer::isRunning() {
+	std::lock_guard<std::mutex> lock(this->cv_m);
 	return this->started;
 }
 
+void CppThreadsTimer::waitCallbackEnd(std::unique_lock<std::mutex>& lock) {
+	if (this->waitingThread.get_id() == std::this_thread::get_id()) {
+		return;	/* Invoked from our own callback */
+	}
+	this->cv.wait(lock, [this] {return !this->runningCallback;});
+}
+
 void CppThreadsTimer::routine() {
 	std::unique_lock<std::mutex> lock(this->cv_m);
-	this->cv.wait_for(lock, std::chrono::milliseconds(this->duration), [this] {return !this->started;});
-	if (this->started) {
-		this->callback(this);
+	while (!this->quitting) {
+		if (!this->armed) {
+			this->cv.wait(lock);
+			continue;
+		}
+		unsigned int runGeneration = this->generation;
+		if (this->cv.wait_until(lock, this->deadline, [this, runGeneration] {return this->quitting || this->generation != runGeneration;})) {
+			continue;	/* Stopped, restarted or destroyed in the meantime */
+		}
+		this->armed = false;
+		this->runningCallback = true;
+		TimerCallback expiredCallback(std::move(this->callback));	/* Moved, not copied: no allocation, and start() may set a new callback from within this one */
+		bool destroyed = false;
+		this->destroyedInCallback = &destroyed;
+		lock.unlock();	/* The callback may start or stop this timer again */
+		expiredCallback(this);
+		if (destroyed) {
+			return;
+		}
+		lock.lock();
+		this->destroyedInCallback = nullptr;
+		this->runningCallback = false;
+		this->cv.notify_all();	/* Wake up start() or stop() waiting for the end of the callback */
 	}
 }
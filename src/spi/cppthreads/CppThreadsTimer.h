@@ -10,11 +10,17 @@
 
 #include <thread>
 #include <condition_variable>
+#include <mutex>
+#include <chrono>
 
 namespace NSSPI {
 
 /**
  * @brief Concrete implementation of ITimer using C++11 threads
+ *
+ * Each timer owns one secondary thread, created with the timer and kept until it is destroyed, that waits for the deadline and runs the
+ * callback. Starting or stopping a timer thus never creates a thread nor allocates memory (as long as the callback fits in the
+ * small-object storage of std::function).
  */
 class CppThreadsTimer : public ITimer {
 public:
@@ -57,16 +63,29 @@ public:
 
 protected:
 	/**
-	 * @brief The routine that will run in a secondary thread
+	 * @brief The routine that runs in the secondary thread, for the whole life of the timer
 	 */
 	void routine();
 
 private:
+	/**
+	 * @brief Wait until the callback is not running anymore, unless we are invoked from that callback
+	 *
+	 * @param lock A lock held on cv_m
+	 */
+	void waitCallbackEnd(std::unique_lock<std::mutex>& lock);
+
 	bool started;	/*!< Is the timer currently running */
-	std::thread waitingThread;	/*!< The thread that will wait for the specified timeout and will then run the callback */
-	std::condition_variable cv;	/*!< A condition variable that allows to unlock the wait performed by waitingThread (this allows stopping that secondary thread) */
-	std::mutex cv_m;	/*!< A mutex to handle access to variable cv */
+	bool armed;	/*!< Should the callback be run at deadline? (cleared once it has been run) */
+	bool runningCallback;	/*!< Is the callback currently being run by the secondary thread? */
+	bool quitting;	/*!< Should the secondary thread exit? */
+	bool* destroyedInCallback;	/*!< Set by the secondary thread while running the callback, to a flag the destructor raises if invoked from that callback */
+	unsigned int generation;	/*!< Incremented at each start() or stop(), so that the secondary thread restarts its wait */
+	std::chrono::steady_clock::time_point deadline;	/*!< When the callback should be run */
+	std::condition_variable cv;	/*!< A condition variable that allows to unlock the wait performed by waitingThread (this allows stopping or restarting the timer) */
+	std::mutex cv_m;	/*!< A mutex to handle access to variable cv, and to all attributes above, so that start() and stop() can be invoked from any thread */
 	TimerCallback callback;	/*!< The callback to invoke when the timer elapses */
+	std::thread waitingThread;	/*!< The thread that waits for the deadline and then runs the callback (declared last, it uses all attributes above) */
 };
 
 } // namespace NSSPI
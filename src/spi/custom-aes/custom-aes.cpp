@@ -50,6 +50,7 @@
 #include "custom-aes.h"
 
 #include <cstring>
+#include <stdexcept>
 
 #define WPOLY   0x011b //NOSONAR
 #define BPOLY     0x1b //NOSONAR
@@ -328,23 +329,21 @@ void CustomAes::inv_mix_sub_columns( uint8_t dt[IAes::AES_BLOCK_SIZE] ) {
 	dt[11] = is_box(gfm_b(st[12]) ^ gfm_d(st[13]) ^ gfm_9(st[14]) ^ gfm_e(st[15]));
 }
 
-// Set the cipher key for the pre-keyed version
-void CustomAes::set_key( const uint8_t key[AES_KEY_SIZE] ) {
+// Compute the key schedule for a 128-bit key into ksch, and return the number of rounds
+uint8_t CustomAes::expand( const uint8_t key[AES_KEY_SIZE], uint8_t ksch[] ) {
 	uint8_t cc, rc, hi;
-	aes_context *ctx = &context;
 	// 128 only
 	uint8_t keylen = AES_KEY_SIZE;
 
-	block_copy_nn(ctx->ksch, key, keylen);
+	block_copy_nn(ksch, key, keylen);
 	hi = static_cast<uint8_t>(static_cast<uint8_t>(keylen + 28) << 2);
-	ctx->rnd = static_cast<uint8_t>((hi >> 4) - 1);
 	for( cc = keylen, rc = 1; cc < hi; cc = static_cast<uint8_t>(cc + 4) ) {
 		uint8_t tt, t0, t1, t2, t3;
 
-		t0 = ctx->ksch[cc - 4];
-		t1 = ctx->ksch[cc - 3];
-		t2 = ctx->ksch[cc - 2];
-		t3 = ctx->ksch[cc - 1];
+		t0 = ksch[cc - 4];
+		t1 = ksch[cc - 3];
+		t2 = ksch[cc - 2];
+		t3 = ksch[cc - 1];
 		if( cc % keylen == 0 ) {
 			tt = t0;
 			t0 = s_box(t1) ^ rc;
@@ -360,11 +359,17 @@ void CustomAes::set_key( const uint8_t key[AES_KEY_SIZE] ) {
 			t3 = s_box(t3);
 		}
 		tt = static_cast<uint8_t>(cc - keylen);
-		ctx->ksch[cc + 0] = ctx->ksch[tt + 0] ^ t0;
-		ctx->ksch[cc + 1] = ctx->ksch[tt + 1] ^ t1;
-		ctx->ksch[cc + 2] = ctx->ksch[tt + 2] ^ t2;
-		ctx->ksch[cc + 3] = ctx->ksch[tt + 3] ^ t3;
+		ksch[cc + 0] = ksch[tt + 0] ^ t0;
+		ksch[cc + 1] = ksch[tt + 1] ^ t1;
+		ksch[cc + 2] = ksch[tt + 2] ^ t2;
+		ksch[cc + 3] = ksch[tt + 3] ^ t3;
 	}
+	return static_cast<uint8_t>((hi >> 4) - 1);
+}
+
+// Set the cipher key for the pre-keyed version
+void CustomAes::set_key( const uint8_t key[AES_KEY_SIZE] ) {
+	context.rnd = expand(key, context.ksch);
 }
 
 void CustomAes::set_key( const NSEZSP::EmberKeyData& key ) {
@@ -380,19 +385,36 @@ void CustomAes::set_key( const NSEZSP::EmberKeyData& key ) {
 	this->set_key(key_buf);
 }
 
+void CustomAes::expand_key( const NSEZSP::EmberKeyData& key, IAes::ExpandedKey& o_expanded ) const {
+	uint8_t key_buf[AES_KEY_SIZE];
+
+	if (AES_KEY_SIZE != key.size()) {
+		throw std::out_of_range("Wrong AES key size");
+	}
+
+	for (unsigned int i = 0; i<AES_KEY_SIZE; i++) {
+		key_buf[i] = key[i];
+	}
+	expand(key_buf, o_expanded.round_keys);
+}
+
+// Run all rounds of the cipher on a single block of 16 bytes
+void CustomAes::encrypt_rounds( const uint8_t ksch[], uint8_t rnd, const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) {
+	uint8_t s1[IAes::AES_BLOCK_SIZE], r;
+	copy_and_key( s1, in, ksch );
+
+	for( r = 1 ; r < rnd ; ++r ) {
+		mix_sub_columns( s1 );
+		add_round_key( s1, ksch + r * IAes::AES_BLOCK_SIZE);
+	}
+	shift_sub_rows( s1 );
+	copy_and_key( out, s1, ksch + r * IAes::AES_BLOCK_SIZE );
+}
 
 // Encrypt a single block of 16 bytes
 bool CustomAes::encrypt( const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) {
 	if( context.rnd ) {
-		uint8_t s1[IAes::AES_BLOCK_SIZE], r;
-		copy_and_key( s1, in, context.ksch );
-
-		for( r = 1 ; r < context.rnd ; ++r ) {
-			mix_sub_columns( s1 );
-			add_round_key( s1, context.ksch + r * IAes::AES_BLOCK_SIZE);
-		}
-		shift_sub_rows( s1 );
-		copy_and_key( out, s1, context.ksch + r * IAes::AES_BLOCK_SIZE );
+		encrypt_rounds(context.ksch, context.rnd, in, out);
 	}
 	else {
 		return false;
@@ -400,6 +422,11 @@ bool CustomAes::encrypt( const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned
 	return true;
 }
 
+// Encrypt a single block of 16 bytes with a pre-computed key schedule
+void CustomAes::encrypt( const IAes::ExpandedKey& key, const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) const {
+	encrypt_rounds(key.round_keys, IAes::AES128_ROUNDS, in, out);
+}
+
 // CBC encrypt a number of blocks (input and return an IV)
 bool CustomAes::cbc_encrypt(const unsigned char *in, unsigned char *out, unsigned long size, unsigned char iv[IAes::AES_BLOCK_SIZE]) {
 	if (size % 16 != 0) {
@@ -76,13 +76,16 @@ public:
 
 	bool encrypt( const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] );
 
+	void expand_key( const NSEZSP::EmberKeyData& key, IAes::ExpandedKey& o_expanded ) const;
+	void encrypt( const IAes::ExpandedKey& key, const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) const;
+
 	//bool decrypt( const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE], const aes_context ctx[1] ); // \TODO rewrite with class context
 	bool cbc_encrypt(const unsigned char *in, unsigned char *out, unsigned long size, unsigned char iv[IAes::AES_BLOCK_SIZE]);
 	//bool cbc_decrypt(const unsigned char *in, unsigned char *out, unsigned long size, unsigned char iv[IAes::AES_BLOCK_SIZE], const aes_context ctx[1] ); // \TODO rewrite with class context
 
 	// helper functions
 private:
-	void xor_block( void *d, const void *s );
+	static void xor_block( void *d, const void *s );
 
 
 private:
@@ -90,12 +93,14 @@ private:
 	aes_context context;
 
 	// helper functions
-	void copy_and_key( void *d, const void *s, const void *k );
-	void add_round_key( uint8_t d[IAes::AES_BLOCK_SIZE], const uint8_t k[IAes::AES_BLOCK_SIZE] );
-	void shift_sub_rows( uint8_t st[IAes::AES_BLOCK_SIZE] );
-	void inv_shift_sub_rows( uint8_t st[IAes::AES_BLOCK_SIZE] );
-	void mix_sub_columns( uint8_t dt[IAes::AES_BLOCK_SIZE] );
-	void inv_mix_sub_columns( uint8_t dt[IAes::AES_BLOCK_SIZE] );
+	static uint8_t expand( const uint8_t key[IAes::AES_KEY_SIZE], uint8_t ksch[] );
+	static void encrypt_rounds( const uint8_t ksch[], uint8_t rnd, const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] );
+	static void copy_and_key( void *d, const void *s, const void *k );
+	static void add_round_key( uint8_t d[IAes::AES_BLOCK_SIZE], const uint8_t k[IAes::AES_BLOCK_SIZE] );
+	static void shift_sub_rows( uint8_t st[IAes::AES_BLOCK_SIZE] );
+	static void inv_shift_sub_rows( uint8_t st[IAes::AES_BLOCK_SIZE] );
+	static void mix_sub_columns( uint8_t dt[IAes::AES_BLOCK_SIZE] );
+	static void inv_mix_sub_columns( uint8_t dt[IAes::AES_BLOCK_SIZE] );
 };
 
 } // namespace NSSPI
@@ -115,6 +115,16 @@ void MockUartDriver::scheduleIncomingChunk(const MockUartScheduledByteDelivery&
 	}
 }
 
+void MockUartDriver::deliverIncomingChunk(const uint8_t* buf, size_t cnt) {
+	{
+		std::lock_guard<std::mutex> lock(this->scheduledReadQueueMutex);
+		this->deliveredReadBytesCount += cnt;
+	} /* scheduledReadQueueMutex released here */
+	if (dataInputObservable != nullptr) {
+		this->dataInputObservable->notifyObservers(buf, cnt);	/* Notify observers */
+	}
+}
+
 std::string MockUartDriver::scheduledIncomingChunksToString() {
 	std::stringstream result;
 	std::queue<struct MockUartScheduledByteDelivery> scheduledReadQueueCopy;
@@ -119,6 +119,17 @@ public:
 	 */
 	void scheduleIncomingChunk(const MockUartScheduledByteDelivery& scheduledBytes);
 
+	/**
+	 * @brief Immediately deliver a byte sequence on the emulated serial port, from the caller's thread
+	 *
+	 * Contrary to scheduleIncomingChunk(), no secondary thread is involved: observers are notified synchronously, before this method returns.
+	 * This allows the caller to measure (time, allocations...) the whole processing of incoming bytes on its own thread.
+	 *
+	 * @param[in] buf The bytes to deliver
+	 * @param cnt The number of bytes in @p buf
+	 */
+	void deliverIncomingChunk(const uint8_t* buf, size_t cnt);
+
 	/**
 	 * @brief Get a string representation of the scheduled incoming chunks (for debug)
 	 *
@@ -0,0 +1,185 @@
+/**
+ * @file ttable-aes.cpp
+ *
+ * @brief AES-128 encryption using 32-bit lookup tables (T-tables)
+ */
+
+#include <cstring>
+#include <stdexcept>
+
+#include "ttable-aes.h"
+
+using NSSPI::TTableAes;
+using NSSPI::IAes;
+
+namespace {
+/* AES S-box (see FIPS-197, figure 7) */
+const uint8_t sbox[256] = {
+	0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
+	0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
+	0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
+	0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
+	0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
+	0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
+	0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
+	0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
+	0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
+	0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
+	0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
+	0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
+	0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
+	0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
+	0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
+	0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16,
+};
+
+uint8_t xtime(uint8_t x) {
+	return static_cast<uint8_t>((x << 1) ^ ((x & 0x80U) ? 0x1bU : 0x00U));
+}
+
+uint32_t rotr(uint32_t x, unsigned int n) {
+	return (x >> n) | (x << (32 - n));
+}
+
+uint32_t load_be32(const uint8_t* p) {
+	return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 8) | static_cast<uint32_t>(p[3]);
+}
+
+void store_be32(uint8_t* p, uint32_t v) {
+	p[0] = static_cast<uint8_t>(v >> 24);
+	p[1] = static_cast<uint8_t>(v >> 16);
+	p[2] = static_cast<uint8_t>(v >> 8);
+	p[3] = static_cast<uint8_t>(v);
+}
+
+/**
+ * @brief The four T-tables, te[n][x] being the MixColumns output column for S-box(x) as input byte n, computed from the S-box
+ */
+struct TTables {
+	TTables() : te() {
+		for (unsigned int i = 0; i < 256; i++) {
+			uint8_t s = sbox[i];
+			uint8_t s2 = xtime(s);
+			uint8_t s3 = static_cast<uint8_t>(s2 ^ s);
+			uint32_t w = (static_cast<uint32_t>(s2) << 24) | (static_cast<uint32_t>(s) << 16) | (static_cast<uint32_t>(s) << 8) | static_cast<uint32_t>(s3);
+			te[0][i] = w;
+			te[1][i] = rotr(w, 8);
+			te[2][i] = rotr(w, 16);
+			te[3][i] = rotr(w, 24);
+		}
+	}
+
+	uint32_t te[4][256];
+};
+
+const TTables& tables() {
+	static const TTables instance;	/* Initialization is thread-safe since C++11 */
+	return instance;
+}
+
+uint32_t sub_word(uint32_t w) {
+	return (static_cast<uint32_t>(sbox[(w >> 24) & 0xffU]) << 24) | (static_cast<uint32_t>(sbox[(w >> 16) & 0xffU]) << 16)
+	       | (static_cast<uint32_t>(sbox[(w >> 8) & 0xffU]) << 8) | static_cast<uint32_t>(sbox[w & 0xffU]);
+}
+}
+
+TTableAes::TTableAes() :
+	context(),
+	keySet(false) {
+}
+
+void TTableAes::expand( const uint8_t key[IAes::AES_KEY_SIZE], IAes::ExpandedKey& o_expanded ) {
+	/* Key expansion as in FIPS-197, section 5.2, for Nk=4 */
+	static constexpr unsigned int NB_WORDS = (IAes::AES128_ROUNDS + 1) * 4;
+	uint32_t w[NB_WORDS];
+	for (unsigned int i = 0; i < 4; i++) {
+		w[i] = load_be32(key + 4 * i);
+	}
+	uint8_t rcon = 0x01U;
+	for (unsigned int i = 4; i < NB_WORDS; i++) {
+		uint32_t temp = w[i - 1];
+		if (i % 4 == 0) {
+			temp = sub_word(rotr(temp, 24)) ^ (static_cast<uint32_t>(rcon) << 24);
+			rcon = xtime(rcon);
+		}
+		w[i] = w[i - 4] ^ temp;
+	}
+	for (unsigned int i = 0; i < NB_WORDS; i++) {
+		store_be32(o_expanded.round_keys + 4 * i, w[i]);
+	}
+}
+
+void TTableAes::set_key( const uint8_t key[IAes::AES_KEY_SIZE] ) {
+	expand(key, this->context);
+	this->keySet = true;
+}
+
+void TTableAes::set_key( const NSEZSP::EmberKeyData& key ) {
+	this->expand_key(key, this->context);
+	this->keySet = true;
+}
+
+void TTableAes::expand_key( const NSEZSP::EmberKeyData& key, IAes::ExpandedKey& o_expanded ) const {
+	if (IAes::AES_KEY_SIZE != key.size()) {
+		throw std::out_of_range("Wrong AES key size");
+	}
+	expand(key.data(), o_expanded);
+}
+
+void TTableAes::encrypt( const IAes::ExpandedKey& key, const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) const {
+	const uint32_t (&te)[4][256] = tables().te;
+	const uint8_t* rk = key.round_keys;
+
+	uint32_t s0 = load_be32(in) ^ load_be32(rk);
+	uint32_t s1 = load_be32(in + 4) ^ load_be32(rk + 4);
+	uint32_t s2 = load_be32(in + 8) ^ load_be32(rk + 8);
+	uint32_t s3 = load_be32(in + 12) ^ load_be32(rk + 12);
+
+	for (unsigned int round = 1; round < IAes::AES128_ROUNDS; round++) {
+		rk += IAes::AES_BLOCK_SIZE;
+		uint32_t t0 = te[0][s0 >> 24] ^ te[1][(s1 >> 16) & 0xffU] ^ te[2][(s2 >> 8) & 0xffU] ^ te[3][s3 & 0xffU] ^ load_be32(rk);
+		uint32_t t1 = te[0][s1 >> 24] ^ te[1][(s2 >> 16) & 0xffU] ^ te[2][(s3 >> 8) & 0xffU] ^ te[3][s0 & 0xffU] ^ load_be32(rk + 4);
+		uint32_t t2 = te[0][s2 >> 24] ^ te[1][(s3 >> 16) & 0xffU] ^ te[2][(s0 >> 8) & 0xffU] ^ te[3][s1 & 0xffU] ^ load_be32(rk + 8);
+		uint32_t t3 = te[0][s3 >> 24] ^ te[1][(s0 >> 16) & 0xffU] ^ te[2][(s1 >> 8) & 0xffU] ^ te[3][s2 & 0xffU] ^ load_be32(rk + 12);
+		s0 = t0;
+		s1 = t1;
+		s2 = t2;
+		s3 = t3;
+	}
+
+	/* Last round has no MixColumns */
+	rk += IAes::AES_BLOCK_SIZE;
+	store_be32(out, (static_cast<uint32_t>(sbox[s0 >> 24]) << 24) ^ (static_cast<uint32_t>(sbox[(s1 >> 16) & 0xffU]) << 16)
+	           ^ (static_cast<uint32_t>(sbox[(s2 >> 8) & 0xffU]) << 8) ^ static_cast<uint32_t>(sbox[s3 & 0xffU]) ^ load_be32(rk));
+	store_be32(out + 4, (static_cast<uint32_t>(sbox[s1 >> 24]) << 24) ^ (static_cast<uint32_t>(sbox[(s2 >> 16) & 0xffU]) << 16)
+	           ^ (static_cast<uint32_t>(sbox[(s3 >> 8) & 0xffU]) << 8) ^ static_cast<uint32_t>(sbox[s0 & 0xffU]) ^ load_be32(rk + 4));
+	store_be32(out + 8, (static_cast<uint32_t>(sbox[s2 >> 24]) << 24) ^ (static_cast<uint32_t>(sbox[(s3 >> 16) & 0xffU]) << 16)
+	           ^ (static_cast<uint32_t>(sbox[(s0 >> 8) & 0xffU]) << 8) ^ static_cast<uint32_t>(sbox[s1 & 0xffU]) ^ load_be32(rk + 8));
+	store_be32(out + 12, (static_cast<uint32_t>(sbox[s3 >> 24]) << 24) ^ (static_cast<uint32_t>(sbox[(s0 >> 16) & 0xffU]) << 16)
+	           ^ (static_cast<uint32_t>(sbox[(s1 >> 8) & 0xffU]) << 8) ^ static_cast<uint32_t>(sbox[s2 & 0xffU]) ^ load_be32(rk + 12));
+}
+
+bool TTableAes::encrypt( const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) {
+	if (!this->keySet) {
+		return false;
+	}
+	this->encrypt(this->context, in, out);
+	return true;
+}
+
+bool TTableAes::cbc_encrypt(const unsigned char *in, unsigned char *out, unsigned long size, unsigned char iv[IAes::AES_BLOCK_SIZE]) {
+	if (size % IAes::AES_BLOCK_SIZE != 0 || !this->keySet) {
+		return false;
+	}
+
+	for (unsigned long n_block = size / IAes::AES_BLOCK_SIZE; n_block > 0; n_block--) {
+		for (unsigned int i = 0; i < IAes::AES_BLOCK_SIZE; i++) {
+			iv[i] ^= in[i];
+		}
+		this->encrypt(this->context, iv, iv);
+		memcpy(out, iv, IAes::AES_BLOCK_SIZE);
+		in += IAes::AES_BLOCK_SIZE;
+		out += IAes::AES_BLOCK_SIZE;
+	}
+	return true;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file ttable-aes.h
+ *
+ * @brief AES-128 encryption using 32-bit lookup tables (T-tables) combining SubBytes, ShiftRows and MixColumns
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include "spi/IAes.h"
+
+namespace NSSPI {
+
+/**
+ * @brief Portable AES-128 implementation, processing the state as four 32-bit columns
+ *
+ * Each of the first 9 rounds costs 16 table lookups and 16 XORs, instead of the byte-by-byte S-box substitutions and GF(2^8)
+ * multiplications of CustomAes.
+ * Key schedules (see IAes::ExpandedKey) use the FIPS-197 byte layout, so they are interchangeable with the other backends.
+ */
+class TTableAes : public IAes {
+public:
+	TTableAes();
+
+	void set_key( const uint8_t key[IAes::AES_KEY_SIZE] );
+	void set_key( const NSEZSP::EmberKeyData& key );
+
+	bool encrypt( const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] );
+
+	bool cbc_encrypt(const unsigned char *in, unsigned char *out, unsigned long size, unsigned char iv[IAes::AES_BLOCK_SIZE]);
+
+	void expand_key( const NSEZSP::EmberKeyData& key, IAes::ExpandedKey& o_expanded ) const;
+	void encrypt( const IAes::ExpandedKey& key, const unsigned char in[IAes::AES_BLOCK_SIZE], unsigned char out[IAes::AES_BLOCK_SIZE] ) const;
+
+private:
+	static void expand( const uint8_t key[IAes::AES_KEY_SIZE], IAes::ExpandedKey& o_expanded );
+
+	IAes::ExpandedKey context;	/*!< Key schedule of the key set using set_key() */
+	bool keySet;	/*!< Has set_key() been invoked? */
+};
+
+} // namespace NSSPI
@@ -0,0 +1,419 @@
+/**
+ * @file SimulatedNcp.h
+ *
+ * @brief A minimal EZSP adapter emulated behind a mock UART, answering green power table commands
+ */
+
+#ifndef __SIMULATEDNCP_H__
+#define __SIMULATEDNCP_H__
+
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <map>
+#include <set>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+
+#include "spi/mock-uart/MockUartDriver.h"
+#include "spi/ByteBuffer.h"
+#include "spi/FrameBuffer.h"
+#include "spi/ByteReader.h"
+#include "spi/AllocCounter.h"
+#include "ezsp/ashv2-codec.h"
+#include "ezsp/ezsp-protocol/ezsp-enum.h"
+#include "ezsp/ezsp-protocol/struct/ember-gp-address-struct.h"
+
+/**
+ * @brief An EZSP adapter emulated behind a mock UART
+ *
+ * ASH frames written by the host are decoded on a dedicated thread, that answers each EZSP command after a configurable latency
+ * (modelling the UART and the adapter's processing time), one command at a time, like a real adapter.
+ * The adapter's GP sink and proxy tables are emulated, so that GP devices can be registered, looked up and removed.
+ * GPDFs queued with EZSP_D_GP_SEND are confirmed right away with an EZSP_D_GP_SENT_HANDLER callback, unless dropGpdfConfirmations() was invoked.
+ * Other EZSP commands get a response without parameters. Callbacks (e.g. incoming GP frames) can be sent to the host with sendCallback().
+ *
+ * Use getUart() as the UART of a CEzspDongle, and invoke stop() before destroying that dongle.
+ */
+class SimulatedNcp {
+public:
+	/**
+	 * @brief Start the emulated adapter
+	 *
+	 * @param i_table_size The number of entries of the sink table (and of the proxy table)
+	 * @param i_latency The delay between receiving a command and sending its response
+	 */
+	SimulatedNcp(std::size_t i_table_size, std::chrono::microseconds i_latency) :
+		uart(new NSSPI::MockUartDriver([this](size_t& writtenCnt, const void* buf, size_t cnt, std::chrono::duration<double, std::milli> delta) -> int {
+			(void)delta;
+			return this->onWrite(writtenCnt, buf, cnt);
+		})),	//NOSONAR
+		codec(nullptr),
+		latency(i_latency),
+		mutex(),
+		written(),
+		inbox(),
+		callbacks(),
+		commands(),
+		callbackSequence(0),
+		stopping(false),
+		sinkTable(i_table_size, 0),
+		proxyTable(i_table_size, 0),
+		failingAllocations(),
+		failingSetEntries(),
+		unconfirmedGpdfs(),
+		nbCommands(),
+		worker() {
+		this->worker = std::thread(&SimulatedNcp::run, this);
+	}
+
+	~SimulatedNcp() {
+		this->stop();
+	}
+
+	SimulatedNcp(const SimulatedNcp& other) = delete;
+	SimulatedNcp& operator=(const SimulatedNcp& other) = delete;
+
+	/**
+	 * @brief Get the UART the host should use to talk to this adapter
+	 */
+	NSSPI::IUartDriverHandle getUart() {
+		return this->uart;
+	}
+
+	/**
+	 * @brief Stop answering commands (pending commands are dropped)
+	 */
+	void stop() {
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->stopping = true;
+		}
+		this->written.notify_all();
+		if (this->worker.joinable()) {
+			this->worker.join();
+		}
+	}
+
+	/**
+	 * @brief Send an EZSP callback to the host, in between the responses to its commands
+	 *
+	 * @param i_cmd The frame ID of the callback
+	 * @param i_params The parameters of the callback
+	 */
+	void sendCallback(NSEZSP::EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_params) {
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			NSSPI::ByteBuffer callback({ this->callbackSequence++, 0x90, 0xff, 0x00, static_cast<uint8_t>(i_cmd) });	/* Frame control for an asynchronous callback, extended header */
+			callback.insert(callback.end(), i_params.begin(), i_params.end());
+			this->callbacks.push_back(callback);
+		}
+		this->written.notify_one();
+	}
+
+	/**
+	 * @brief Make EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY fail for a source ID, as if the sink table was full
+	 */
+	void failAllocation(uint32_t i_source_id) {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->failingAllocations.insert(i_source_id);
+	}
+
+	/**
+	 * @brief Make EZSP_GP_SINK_TABLE_SET_ENTRY fail for a source ID
+	 */
+	void failSetEntry(uint32_t i_source_id) {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->failingSetEntries.insert(i_source_id);
+	}
+
+	/**
+	 * @brief Never send EZSP_D_GP_SENT_HANDLER for the GPDFs sent to a source ID
+	 */
+	void dropGpdfConfirmations(uint32_t i_source_id) {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->unconfirmedGpdfs.insert(i_source_id);
+	}
+
+	/**
+	 * @brief Store a device in the first free entry of the sink table and of the proxy table, as if it had been registered earlier
+	 */
+	void addDevice(uint32_t i_source_id) {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		uint8_t index = findEntry(this->sinkTable, 0);
+		if (index != 0xff) {
+			this->sinkTable[index] = i_source_id;
+		}
+		index = findEntry(this->proxyTable, 0);
+		if (index != 0xff) {
+			this->proxyTable[index] = i_source_id;
+		}
+	}
+
+	/**
+	 * @brief Get the number of commands of a given type received so far
+	 */
+	std::size_t getNbCommands(NSEZSP::EEzspCmd i_cmd) {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->nbCommands[static_cast<uint8_t>(i_cmd)];
+	}
+
+	/**
+	 * @brief Get the source IDs currently in the sink table (0 for free entries), by index
+	 */
+	std::vector<uint32_t> getSinkTable() {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->sinkTable;
+	}
+
+	/**
+	 * @brief Get the source IDs currently in the proxy table (0 for free entries), by index
+	 */
+	std::vector<uint32_t> getProxyTable() {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		return this->proxyTable;
+	}
+
+private:
+	int onWrite(size_t& writtenCnt, const void* buf, size_t cnt) {
+		ALLOC_COUNTING_LAYER(NONE);	/* We are emulating the adapter here, do not attribute our own allocations to the library layer that is writing */
+		const uint8_t* bytes = static_cast<const uint8_t*>(buf);
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->inbox.emplace_back(bytes, bytes + cnt);
+		}
+		this->written.notify_one();
+		writtenCnt = cnt;
+		return 0;
+	}
+
+	void run() {
+		std::unique_lock<std::mutex> lock(this->mutex);
+		while (true) {
+			this->written.wait(lock, [this]() {
+				return (this->stopping || !this->inbox.empty() || !this->callbacks.empty() || !this->commands.empty());
+			});
+			if (this->stopping) {
+				return;
+			}
+			/* Bytes written by the host are decoded first, so that the frames we send acknowledge all frames the host has sent */
+			if (!this->inbox.empty()) {
+				std::vector<uint8_t> chunk;
+				chunk.swap(this->inbox.front());
+				this->inbox.pop_front();
+				lock.unlock();	/* Frames are delivered without the lock, the host may write again while handling them */
+				this->decodeChunk(chunk);
+				lock.lock();
+				continue;
+			}
+			NSSPI::ByteBuffer frame;
+			if (!this->callbacks.empty()) {
+				frame.swap(this->callbacks.front());
+				this->callbacks.pop_front();
+				lock.unlock();
+			}
+			else {
+				NSSPI::FrameBuffer command(this->commands.front());
+				this->commands.pop_front();
+				lock.unlock();
+				frame = this->answer(command);
+				if (this->latency.count() > 0) {
+					std::this_thread::sleep_for(this->latency);
+				}
+			}
+			NSSPI::FrameBuffer ashFrame = this->codec.forgeDataFrame(frame);
+			this->uart->deliverIncomingChunk(ashFrame.data(), ashFrame.size());
+			lock.lock();
+		}
+	}
+
+	/**
+	 * @brief Decode bytes written by the host, queueing the EZSP commands they contain into commands
+	 */
+	void decodeChunk(const std::vector<uint8_t>& i_chunk) {
+		if (!i_chunk.empty() && i_chunk[0] == 0x1a) {	/* Cancel byte: this is an ASH RST */
+			this->codec.forgeResetNCPFrame();	/* Restart frame numbering */
+			const uint8_t rstAck[] = { 0x1a, 0xc1, 0x02, 0x0b, 0x0a, 0x52, 0x7e };	/* RSTACK, software reset */
+			this->uart->deliverIncomingChunk(rstAck, sizeof(rstAck));
+			return;
+		}
+		std::vector<NSSPI::FrameBuffer> frames;
+		this->codec.appendIncoming(i_chunk.data(), i_chunk.size(), frames);
+		std::lock_guard<std::mutex> lock(this->mutex);
+		for (const NSSPI::FrameBuffer& frame : frames) {
+			if (frame.size() >= 3) {	/* Not an ASH ACK or NAK */
+				this->commands.push_back(frame);
+			}
+		}
+	}
+
+	/**
+	 * @brief Build the EZSP response to an EZSP command frame
+	 */
+	NSSPI::ByteBuffer answer(const NSSPI::FrameBuffer& i_frame) {
+		std::size_t headerLen = (i_frame[2] == 0xff ? 5 : 3);	/* Extended or legacy header */
+		uint8_t cmd = i_frame[headerLen - 1];
+		NSSPI::ByteBuffer params(i_frame.data() + headerLen, i_frame.data() + i_frame.size());
+		NSSPI::ByteBuffer response({ i_frame[0], 0x80, 0xff, 0x00, cmd });	/* Same sequence number, frame control for a response, extended header */
+
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->nbCommands[cmd]++;
+		switch (static_cast<NSEZSP::EEzspCmd>(cmd)) {
+		case NSEZSP::EZSP_GET_NETWORK_PARAMETERS:
+			response.push_back(0x00);	/* EMBER_SUCCESS */
+			response.push_back(0x00);	/* EMBER_UNKNOWN_DEVICE node type */
+			response.insert(response.end(), 20, 0x00);	/* Blank EmberNetworkParameters */
+			break;
+		case NSEZSP::EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY:
+		case NSEZSP::EZSP_GP_SINK_TABLE_LOOKUP: {
+			uint32_t sourceId = readSourceId(params, 0);
+			uint8_t index = findEntry(this->sinkTable, sourceId);
+			if (index == 0xff && cmd == NSEZSP::EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY && this->failingAllocations.count(sourceId) == 0) {
+				index = findEntry(this->sinkTable, 0);
+				if (index != 0xff) {
+					this->sinkTable[index] = sourceId;	/* The entry is allocated right away */
+				}
+			}
+			response.push_back(index);
+		}
+		break;
+		case NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY: {
+			uint8_t index = params.at(0);
+			uint32_t sourceId = (index < this->sinkTable.size() ? this->sinkTable[index] : 0);
+			response.push_back(index < this->sinkTable.size() ? 0x00 : 0xb1);	/* EMBER_SUCCESS or EMBER_INDEX_OUT_OF_RANGE */
+			response.push_back(sourceId != 0 ? 0x01 : 0xff);	/* Entry status */
+			response.insert(response.end(), 2, 0x00);	/* Options */
+			NSSPI::ByteBuffer address = NSEZSP::CEmberGpAddressStruct(sourceId).getRaw();
+			response.insert(response.end(), address.begin(), address.end());
+			response.push_back(0x00);	/* Device ID */
+			response.insert(response.end(), NSEZSP::GP_SINK_LIST_ENTRIES * NSEZSP::EMBER_GP_SINK_LIST_ENTRY_SIZE, 0xff);	/* Unused sink list */
+			response.insert(response.end(), 2 + 1 + 1 + 4 + 16, 0x00);	/* Alias, radius, security options, frame counter, key */
+		}
+		break;
+		case NSEZSP::EZSP_GP_SINK_TABLE_SET_ENTRY: {
+			uint8_t index = params.at(0);
+			uint32_t sourceId = readSourceId(params, 1 + 1 + 2);	/* Index, entry status, options */
+			if (index >= this->sinkTable.size() || this->failingSetEntries.count(sourceId) != 0) {
+				response.push_back(0x01);	/* EMBER_ERR_FATAL */
+			}
+			else {
+				this->sinkTable[index] = sourceId;
+				response.push_back(0x00);
+			}
+		}
+		break;
+		case NSEZSP::EZSP_GP_SINK_TABLE_REMOVE_ENTRY: {
+			uint8_t index = params.at(0);
+			if (index < this->sinkTable.size()) {
+				this->sinkTable[index] = 0;
+			}
+		}
+		break;
+		case NSEZSP::EZSP_GP_SINK_TABLE_CLEAR_ALL:
+			std::fill(this->sinkTable.begin(), this->sinkTable.end(), 0);
+			break;
+		case NSEZSP::EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING: {
+			bool removeGpd = ((params.at(0) & 0x10) != 0);	/* Bit 4 of the pairing options */
+			uint32_t sourceId = readSourceId(params, 4);
+			uint8_t index = findEntry(this->proxyTable, sourceId);
+			if (removeGpd) {
+				if (index != 0xff) {
+					this->proxyTable[index] = 0;
+				}
+				response.push_back(0x00);
+			}
+			else {
+				if (index == 0xff) {
+					index = findEntry(this->proxyTable, 0);
+				}
+				if (index != 0xff) {
+					this->proxyTable[index] = sourceId;
+				}
+				response.push_back(index != 0xff ? 0x01 : 0x00);	/* gpPairingAdded */
+			}
+		}
+		break;
+		case NSEZSP::EZSP_GP_PROXY_TABLE_LOOKUP:
+			response.push_back(findEntry(this->proxyTable, readSourceId(params, 0)));
+			break;
+		case NSEZSP::EZSP_GP_PROXY_TABLE_GET_ENTRY: {
+			uint8_t index = params.at(0);
+			if (index >= this->proxyTable.size()) {
+				response.push_back(0xb1);	/* EMBER_INDEX_OUT_OF_RANGE, this ends table iterations */
+				break;
+			}
+			response.push_back(0x00);
+			response.push_back(this->proxyTable[index] != 0 ? 0x01 : 0xff);	/* Entry status */
+			response.insert(response.end(), 4, 0x00);	/* Options */
+			NSSPI::ByteBuffer address = NSEZSP::CEmberGpAddressStruct(this->proxyTable[index]).getRaw();
+			response.insert(response.end(), address.begin(), address.end());
+			response.insert(response.end(), 2 + 1 + 4 + 16, 0x00);	/* Alias, security options, frame counter, key */
+			response.insert(response.end(), NSEZSP::GP_SINK_LIST_ENTRIES * NSEZSP::EMBER_GP_SINK_LIST_ENTRY_SIZE, 0xff);	/* Unused sink list */
+			response.insert(response.end(), 2, 0x00);	/* Radius, search counter */
+		}
+		break;
+		case NSEZSP::EZSP_D_GP_SEND: {
+			NSSPI::ByteReader reader(params);
+			reader.skip(2);	/* Action, use CCA */
+			NSEZSP::CEmberGpAddressStruct address(reader);
+			reader.skip(1);	/* GPD command ID */
+			reader.skip(reader.readU8());	/* GPD command payload */
+			uint8_t handle = reader.readU8();
+			response.push_back(0x00);	/* EMBER_SUCCESS */
+			if (this->unconfirmedGpdfs.count(address.getSourceId()) == 0) {
+				this->callbacks.push_back({ this->callbackSequence++, 0x90, 0xff, 0x00, static_cast<uint8_t>(NSEZSP::EZSP_D_GP_SENT_HANDLER), 0x00, handle });	/* Sent after this response */
+			}
+		}
+		break;
+		default:
+			break;
+		}
+		return response;
+	}
+
+	/**
+	 * @brief Read the source ID from an EmberGpAddress serialized in EZSP parameters
+	 */
+	static uint32_t readSourceId(const NSSPI::ByteBuffer& i_params, std::size_t i_offset) {
+		NSSPI::ByteReader reader(i_params);
+		reader.skip(i_offset);
+		NSEZSP::CEmberGpAddressStruct address(reader);
+		return address.getSourceId();
+	}
+
+	/**
+	 * @brief Find the index of a source ID in a table (0 finds a free entry)
+	 */
+	static uint8_t findEntry(const std::vector<uint32_t>& i_table, uint32_t i_source_id) {
+		for (std::size_t index = 0; index < i_table.size() && index < 0xff; index++) {
+			if (i_table[index] == i_source_id) {
+				return static_cast<uint8_t>(index);
+			}
+		}
+		return 0xff;
+	}
+
+	std::shared_ptr<NSSPI::MockUartDriver> uart;	/*!< The UART shared with the host */
+	NSEZSP::AshCodec codec;	/*!< The adapter's side of the ASH link (only accessed from the worker thread) */
+	std::chrono::microseconds latency;	/*!< Delay before each response */
+	std::mutex mutex;	/*!< Protects all members below */
+	std::condition_variable written;	/*!< Notified when the host writes bytes, or when stopping */
+	std::deque<std::vector<uint8_t>> inbox;	/*!< Bytes written by the host, not processed yet */
+	std::deque<NSSPI::ByteBuffer> callbacks;	/*!< EZSP callbacks waiting to be sent to the host */
+	std::deque<NSSPI::FrameBuffer> commands;	/*!< EZSP commands decoded, not answered yet */
+	uint8_t callbackSequence;	/*!< Sequence number of the next callback */
+	bool stopping;	/*!< The worker thread should exit */
+	std::vector<uint32_t> sinkTable;	/*!< Source ID of each sink table entry (0 if free) */
+	std::vector<uint32_t> proxyTable;	/*!< Source ID of each proxy table entry (0 if free) */
+	std::set<uint32_t> failingAllocations;	/*!< Source IDs for which EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY finds no free entry */
+	std::set<uint32_t> failingSetEntries;	/*!< Source IDs for which EZSP_GP_SINK_TABLE_SET_ENTRY fails */
+	std::set<uint32_t> unconfirmedGpdfs;	/*!< Source IDs for which GPDF transmissions are never confirmed */
+	std::map<uint8_t, std::size_t> nbCommands;	/*!< Number of commands received, by frame ID */
+	std::thread worker;	/*!< The thread answering commands */
+};
+
+#endif	// __SIMULATEDNCP_H__
@@ -0,0 +1,260 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+
+#include "ezsp/config.h"
+#include "spi/IAes.h"
+#include "spi/AesBuilder.h"
+#ifdef USE_AESCUSTOM
+#include "spi/custom-aes/custom-aes.h"
+#endif
+#ifdef USE_AESTTABLE
+#include "spi/ttable-aes/ttable-aes.h"
+#endif
+#ifdef USE_AESNI
+#include "spi/aesni-aes/aesni-aes.h"
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>	// For __rdtsc()
+#define AES_TESTS_HAVE_RDTSC
+#endif
+
+#include "TestHarness.h"
+
+using NSSPI::IAes;
+
+namespace {
+/**
+ * @brief An AES implementation under test
+ */
+struct AesBackendUnderTest {
+	std::string name;
+	std::unique_ptr<IAes> aes;
+};
+
+/**
+ * @brief Instantiate all AES implementations built in the library (and supported by the CPU, for AES-NI)
+ */
+std::vector<AesBackendUnderTest> getBackends() {
+	std::vector<AesBackendUnderTest> backends;
+#ifdef USE_AESCUSTOM
+	backends.push_back({"custom", std::unique_ptr<IAes>(new NSSPI::CustomAes())});
+#endif
+#ifdef USE_AESTTABLE
+	backends.push_back({"T-table", std::unique_ptr<IAes>(new NSSPI::TTableAes())});
+#endif
+#if defined(USE_AESNI) && defined(AESNI_AES_AVAILABLE)
+	if (NSSPI::AesNiAes::isSupported()) {
+		backends.push_back({"AES-NI", std::unique_ptr<IAes>(new NSSPI::AesNiAes())});
+	}
+	else {
+		std::cout << "AES-NI not supported by this CPU, skipping it\n";
+	}
+#endif
+	return backends;
+}
+
+/* FIPS-197, appendix C.1 (AES-128) */
+const NSEZSP::EmberKeyData fipsKey({0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f});
+const uint8_t fipsPlainText[IAes::AES_BLOCK_SIZE] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff};
+const uint8_t fipsCipherText[IAes::AES_BLOCK_SIZE] = {0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a};
+
+/* AES-CCM* blocks of the secured GP frame checked in green_power_frame_tests.cpp (source ID 0x0054000a, MIC 0x4e2392b5) */
+const NSEZSP::EmberKeyData gpKey({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5F});
+const uint8_t gpB[3 * IAes::AES_BLOCK_SIZE] = {
+	0x49, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xad, 0x10, 0x00, 0x00, 0x05, 0x00, 0x00,	/* B0 */
+	0x00, 0x1c, 0x8c, 0x70, 0x0a, 0x00, 0x54, 0x00, 0xad, 0x10, 0x00, 0x00, 0xa2, 0x01, 0x00, 0x20,	/* B1 */
+	0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30, 0x00, 0x00,	/* B2 */
+};
+const uint8_t gpX3[IAes::AES_BLOCK_SIZE] = {0x36, 0x3a, 0x17, 0xf0, 0x05, 0x0d, 0x1d, 0x61, 0xdb, 0xd0, 0x4d, 0x50, 0x79, 0xfc, 0x21, 0x9a};
+const uint8_t gpA0[IAes::AES_BLOCK_SIZE] = {0x01, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xad, 0x10, 0x00, 0x00, 0x05, 0x00, 0x00};
+const uint8_t gpEA0[IAes::AES_BLOCK_SIZE] = {0x83, 0xa8, 0x34, 0xbe, 0xa8, 0x0a, 0x06, 0xaa, 0x2f, 0xd5, 0x82, 0xdf, 0x4f, 0x71, 0x9a, 0x70};
+const uint32_t gpMic = 0x4e2392b5;
+}
+
+TEST_GROUP(aes_tests) {
+};
+
+TEST(aes_tests, fips197_known_answer) {
+	for (AesBackendUnderTest& backend : getBackends()) {
+		uint8_t out[IAes::AES_BLOCK_SIZE];
+		backend.aes->set_key(fipsKey);
+		if (!backend.aes->encrypt(fipsPlainText, out) || memcmp(out, fipsCipherText, sizeof(out)) != 0) {
+			FAILF("FIPS-197 known answer test failed for the %s AES implementation", backend.name.c_str());
+		}
+		IAes::ExpandedKey expandedKey;
+		backend.aes->expand_key(fipsKey, expandedKey);
+		memset(out, 0, sizeof(out));
+		backend.aes->encrypt(expandedKey, fipsPlainText, out);
+		if (memcmp(out, fipsCipherText, sizeof(out)) != 0) {
+			FAILF("FIPS-197 known answer test using an expanded key failed for the %s AES implementation", backend.name.c_str());
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(aes_tests, gp_frame_known_answer) {
+	for (AesBackendUnderTest& backend : getBackends()) {
+		/* AES-CBC part of AES-CCM*: X3 is the CBC-MAC of B0..B2 with a null IV */
+		uint8_t iv[IAes::AES_BLOCK_SIZE] = { 0 };
+		uint8_t X[sizeof(gpB)];
+		backend.aes->set_key(gpKey);
+		if (!backend.aes->cbc_encrypt(gpB, X, sizeof(gpB), iv) || memcmp(X + 2 * IAes::AES_BLOCK_SIZE, gpX3, sizeof(gpX3)) != 0) {
+			FAILF("GP frame AES-CBC known answer test failed for the %s AES implementation", backend.name.c_str());
+		}
+		/* AES-CTR part of AES-CCM*, using an expanded key */
+		uint8_t EA0[IAes::AES_BLOCK_SIZE];
+		IAes::ExpandedKey expandedKey;
+		backend.aes->expand_key(gpKey, expandedKey);
+		backend.aes->encrypt(expandedKey, gpA0, EA0);
+		if (memcmp(EA0, gpEA0, sizeof(EA0)) != 0) {
+			FAILF("GP frame AES-CTR known answer test failed for the %s AES implementation", backend.name.c_str());
+		}
+		uint32_t mic = 0;
+		for (unsigned int i = 0; i < 4; i++) {
+			mic |= static_cast<uint32_t>(gpX3[i] ^ EA0[i]) << (8 * i);
+		}
+		if (mic != gpMic) {
+			FAILF("GP frame MIC mismatch for the %s AES implementation", backend.name.c_str());
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(aes_tests, interchangeable_key_schedules) {
+	std::vector<AesBackendUnderTest> backends = getBackends();
+	for (unsigned int keyIndex = 0; keyIndex < 64; keyIndex++) {
+		NSEZSP::EmberKeyData key;
+		for (unsigned int i = 0; i < key.size(); i++) {
+			key[i] = static_cast<uint8_t>(keyIndex * 37 + i * 11);
+		}
+		IAes::ExpandedKey reference;
+		backends.front().aes->expand_key(key, reference);
+		for (AesBackendUnderTest& backend : backends) {
+			IAes::ExpandedKey expandedKey;
+			backend.aes->expand_key(key, expandedKey);
+			if (memcmp(expandedKey.round_keys, reference.round_keys, sizeof(reference.round_keys)) != 0) {
+				FAILF("Key schedule computed by the %s AES implementation differs from the one computed by the %s implementation",
+				      backend.name.c_str(), backends.front().name.c_str());
+			}
+			uint8_t in[IAes::AES_BLOCK_SIZE];
+			uint8_t outReference[IAes::AES_BLOCK_SIZE];
+			uint8_t out[IAes::AES_BLOCK_SIZE];
+			memcpy(in, key.data(), sizeof(in));
+			backends.front().aes->encrypt(reference, in, outReference);
+			backend.aes->encrypt(expandedKey, in, out);
+			if (memcmp(out, outReference, sizeof(out)) != 0) {
+				FAILF("Cipher text from the %s AES implementation differs from the one computed by the %s implementation",
+				      backend.name.c_str(), backends.front().name.c_str());
+			}
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(aes_tests, encrypt_blocks_matches_encrypt) {
+	static constexpr unsigned int MAX_BLOCKS = 19;	/* More than two groups of interleaved blocks, and not a multiple of any group size */
+	IAes::ExpandedKey expandedKeys[MAX_BLOCKS];
+	const IAes::ExpandedKey* keys[MAX_BLOCKS];
+	uint8_t in[MAX_BLOCKS][IAes::AES_BLOCK_SIZE];
+	for (unsigned int block = 0; block < MAX_BLOCKS; block++) {
+		NSEZSP::EmberKeyData key(gpKey);
+		key[0] = static_cast<uint8_t>(block);
+		getBackends().front().aes->expand_key(key, expandedKeys[block]);
+		keys[block] = &expandedKeys[block];
+		for (unsigned int i = 0; i < IAes::AES_BLOCK_SIZE; i++) {
+			in[block][i] = static_cast<uint8_t>(block * 16 + i);
+		}
+	}
+	for (AesBackendUnderTest& backend : getBackends()) {
+		for (unsigned int count = 0; count <= MAX_BLOCKS; count++) {
+			uint8_t out[MAX_BLOCKS][IAes::AES_BLOCK_SIZE] = {{ 0 }};
+			backend.aes->encrypt_blocks(keys, in, out, count);
+			for (unsigned int block = 0; block < MAX_BLOCKS; block++) {
+				uint8_t expected[IAes::AES_BLOCK_SIZE] = { 0 };
+				if (block < count) {
+					backend.aes->encrypt(*keys[block], in[block], expected);
+				}
+				if (memcmp(out[block], expected, sizeof(expected)) != 0) {
+					FAILF("Block %u out of %u encrypted by encrypt_blocks() differs from encrypt() for the %s AES implementation", block, count, backend.name.c_str());
+				}
+			}
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(aes_tests, cycles_per_block) {
+	static constexpr unsigned int NB_BLOCKS = 200000;
+	std::cout << "AES implementation selected by AesBuilder: " << NSSPI::AesBuilder::getBackendName() << "\n";
+	for (AesBackendUnderTest& backend : getBackends()) {
+		IAes::ExpandedKey expandedKey;
+		backend.aes->expand_key(gpKey, expandedKey);
+		uint8_t block[IAes::AES_BLOCK_SIZE] = { 0 };
+		/* Each block is encrypted from the previous cipher text, as in the AES-CBC part of MIC calculation */
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+#ifdef AES_TESTS_HAVE_RDTSC
+		unsigned long long startTsc = __rdtsc();
+#endif
+		for (unsigned int n = 0; n < NB_BLOCKS; n++) {
+			backend.aes->encrypt(expandedKey, block, block);
+		}
+#ifdef AES_TESTS_HAVE_RDTSC
+		unsigned long long cycles = __rdtsc() - startTsc;
+#endif
+		double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "AES-128 " << std::setfill(' ') << std::setw(7) << backend.name << ": " << std::fixed << std::setprecision(1)
+		          << (ns / NB_BLOCKS) << " ns/block";
+#ifdef AES_TESTS_HAVE_RDTSC
+		std::cout << ", " << (static_cast<double>(cycles) / NB_BLOCKS) << " TSC cycles/block";
+#endif
+		std::cout << " (last block " << std::hex << std::setfill('0') << std::setw(2) << +block[0] << "...)\n";
+		std::cout.unsetf(std::ios_base::floatfield);
+		std::cout << std::dec;
+
+		/* Same measurement with 8 independent chains encrypted at once, as when validating the MICs of several frames in one batch */
+		static constexpr unsigned int NB_CHAINS = 8;
+		const IAes::ExpandedKey* keys[NB_CHAINS];
+		uint8_t blocks[NB_CHAINS][IAes::AES_BLOCK_SIZE] = {{ 0 }};
+		for (unsigned int chain = 0; chain < NB_CHAINS; chain++) {
+			keys[chain] = &expandedKey;
+			blocks[chain][0] = static_cast<uint8_t>(chain);
+		}
+		start = std::chrono::steady_clock::now();
+#ifdef AES_TESTS_HAVE_RDTSC
+		startTsc = __rdtsc();
+#endif
+		for (unsigned int n = 0; n < NB_BLOCKS / NB_CHAINS; n++) {
+			backend.aes->encrypt_blocks(keys, blocks, blocks, NB_CHAINS);
+		}
+#ifdef AES_TESTS_HAVE_RDTSC
+		cycles = __rdtsc() - startTsc;
+#endif
+		ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "AES-128 " << std::setfill(' ') << std::setw(7) << backend.name << ", " << NB_CHAINS << " interleaved chains: " << std::fixed << std::setprecision(1)
+		          << (ns / NB_BLOCKS) << " ns/block";
+#ifdef AES_TESTS_HAVE_RDTSC
+		std::cout << ", " << (static_cast<double>(cycles) / NB_BLOCKS) << " TSC cycles/block";
+#endif
+		std::cout << " (last block " << std::hex << std::setfill('0') << std::setw(2) << +blocks[0][0] << "...)\n";
+		std::cout.unsetf(std::ios_base::floatfield);
+		std::cout << std::dec;
+	}
+	NOTIFYPASS();
+}
+
+
+#ifndef USE_CPPUTEST
+void unit_tests_aes() {
+	fips197_known_answer();
+	gp_frame_known_answer();
+	interchangeable_key_schedules();
+	encrypt_blocks_matches_encrypt();
+	cycles_per_block();
+}
+#endif	// USE_CPPUTEST
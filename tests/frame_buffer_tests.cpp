@@ -0,0 +1,129 @@
+#include <iostream>
+#include <vector>
+
+#include "spi/FrameBuffer.h"
+#include "spi/ByteReader.h"
+#include "ezsp/ashv2-codec.h"
+#include "spi/ILogger.h"
+#include "TestHarness.h"
+
+TEST_GROUP(frame_buffer_tests) {
+};
+
+TEST(frame_buffer_tests, frame_buffer_inline_storage) {
+	NSSPI::FrameBuffer buf;
+
+	for (unsigned int i=0; i<NSSPI::FrameBuffer::INLINE_CAPACITY; i++) {
+		buf.push_back(static_cast<uint8_t>(i));
+	}
+	if (!buf.isInline()) {
+		FAILF("Buffer spilled to the heap before reaching its inline capacity");
+	}
+	if (buf.size() != NSSPI::FrameBuffer::INLINE_CAPACITY || buf.at(10) != 10 || buf.back() != static_cast<uint8_t>(NSSPI::FrameBuffer::INLINE_CAPACITY-1)) {
+		FAILF("Wrong content in inline buffer");
+	}
+	buf.push_back(0xAA);
+	if (buf.isInline()) {
+		FAILF("Buffer should have spilled to the heap");
+	}
+	if (buf.size() != NSSPI::FrameBuffer::INLINE_CAPACITY+1 || buf.at(10) != 10 || buf.back() != 0xAA) {
+		FAILF("Wrong content after spilling to the heap");
+	}
+	NSSPI::FrameBuffer moved(std::move(buf));
+	if (moved.size() != NSSPI::FrameBuffer::INLINE_CAPACITY+1 || moved.at(10) != 10 || !buf.empty()) {
+		FAILF("Wrong content after move");
+	}
+	NOTIFYPASS();
+}
+
+TEST(frame_buffer_tests, frame_buffer_bulk_operations) {
+	const uint8_t raw[] = { 0x01, 0x02, 0x03, 0x04, 0x05 };
+	NSSPI::FrameBuffer buf(raw, sizeof(raw));
+
+	buf.append(NSSPI::ByteBuffer({ 0x06, 0x07 }));
+	buf.eraseFront(2);
+	NSSPI::ByteBuffer result = buf.toByteBuffer();
+	if (result != NSSPI::ByteBuffer({ 0x03, 0x04, 0x05, 0x06, 0x07 })) {
+		FAILF("Unexpected content after bulk operations: %s", NSSPI::Logger::byteSequenceToString(result).c_str());
+	}
+	uint8_t mem[5];
+	buf.toMemory(mem);
+	if (mem[0] != 0x03 || mem[4] != 0x07) {
+		FAILF("Wrong content copied to memory");
+	}
+	NOTIFYPASS();
+}
+
+TEST(frame_buffer_tests, frame_buffer_self_append) {
+	NSSPI::FrameBuffer buf;
+	for (unsigned int i=0; i<100; i++) {
+		buf.push_back(static_cast<uint8_t>(i));
+	}
+	buf.append(buf);	/* Spills from the inline storage to the heap */
+	buf.append(buf);	/* Reallocates the heap storage */
+	if (buf.isInline() || buf.size() != 400) {
+		FAILF("Wrong size %zu after appending the buffer to itself", buf.size());
+	}
+	for (unsigned int i=0; i<buf.size(); i++) {
+		if (buf[i] != static_cast<uint8_t>(i % 100)) {
+			FAILF("Wrong byte at %u after appending the buffer to itself", i);
+		}
+	}
+	NSSPI::FrameBuffer empty;
+	empty.pop_back();
+	if (!empty.empty()) {
+		FAILF("pop_back() on an empty buffer should leave it empty");
+	}
+	NOTIFYPASS();
+}
+
+TEST(frame_buffer_tests, ash_data_frame_round_trip) {
+	NSEZSP::AshCodec encoder(nullptr);
+	NSEZSP::AshCodec decoder(nullptr);
+	/* This payload contains bytes that require ASH byte stuffing */
+	NSSPI::ByteBuffer ezspPayload({ 0x01, 0x80, 0x7E, 0x7D, 0x11, 0x13, 0x18, 0x1A, 0x00, 0xff });
+
+	NSSPI::FrameBuffer ashFrame = encoder.forgeDataFrame(ezspPayload);
+	std::vector<NSSPI::FrameBuffer> payloads;
+	decoder.appendIncoming(ashFrame.data(), ashFrame.size(), payloads);
+	if (payloads.size() != 1) {
+		FAILF("Expected exactly one decoded payload, got %zu", payloads.size());
+	}
+	if (payloads[0].toByteBuffer() != ezspPayload) {
+		FAILF("Decoded payload does not match: %s", NSSPI::Logger::byteSequenceToString(payloads[0].toByteBuffer()).c_str());
+	}
+	NOTIFYPASS();
+}
+
+TEST(frame_buffer_tests, byte_reader_cursor) {
+	NSSPI::FrameBuffer buf({ 0x01, 0x34, 0x12, 0x78, 0x56, 0x34, 0x12, 0xAA, 0xBB, 0xCC });
+	NSSPI::ByteReader reader(buf);
+
+	if (reader.readU8() != 0x01 || reader.readU16le() != 0x1234 || reader.readU32le() != 0x12345678) {
+		FAILF("Wrong little endian decoding");
+	}
+	NSSPI::ByteView tail = reader.readBytes(2);
+	if (tail.size() != 2 || tail[0] != 0xAA || tail[1] != 0xBB || tail.data() != buf.data()+7) {
+		FAILF("readBytes() should return a view inside the original buffer");
+	}
+	if (reader.hasError() || reader.remaining() != 1) {
+		FAILF("Unexpected reader state after in-bounds reads");
+	}
+	if (reader.readU16le() != 0 || !reader.hasError()) {
+		FAILF("Reading past the end should return 0 and raise the error flag");
+	}
+	if (reader.readU8() != 0 || !reader.hasError()) {
+		FAILF("Error flag should be sticky");
+	}
+	NOTIFYPASS();
+}
+
+#ifndef USE_CPPUTEST
+void unit_tests_frame_buffer() {
+	frame_buffer_inline_storage();
+	frame_buffer_bulk_operations();
+	frame_buffer_self_append();
+	ash_data_frame_round_trip();
+	byte_reader_cursor();
+}
+#endif	// USE_CPPUTEST
@@ -0,0 +1,173 @@
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+
+#include "ezsp/green-power-attribute-store.h"
+#include "ezsp/zbmessage/zcl.h"
+
+#include "TestHarness.h"
+
+using NSEZSP::CGpAttributeStore;
+using NSEZSP::CGpAttributeValue;
+
+namespace {
+/**
+ * @brief Build a standard attribute report with a 16-bit value
+ */
+NSEZSP::CGpAttributeReport makeReport(uint16_t i_cluster_id, uint16_t i_attribute_id, uint64_t i_raw_value, uint8_t i_type = NSEZSP::ZCL_INT16S_ATTRIBUTE_TYPE) {
+	return { false, 0, i_cluster_id, i_attribute_id, i_type, i_raw_value, NSSPI::ByteView() };
+}
+}
+
+TEST_GROUP(gp_attribute_store_tests) {
+};
+
+TEST(gp_attribute_store_tests, attribute_store_updates) {
+	CGpAttributeStore store(4);
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	CGpAttributeValue value;
+	if (store.get(0x01000001, 0x0402, 0x0000, value) || store.getVersion() != 0) {
+		FAILF("A new store should be empty");
+	}
+	if (!store.update(0x01000001, makeReport(0x0402, 0x0000, 2150), t0) || !store.update(0x01000001, makeReport(0x0405, 0x0000, 5000), t0)) {
+		FAILF("New attributes should be reported as changed");
+	}
+	if (!store.get(0x01000001, 0x0402, 0x0000, value) || value.sourceId != 0x01000001 || value.clusterId != 0x0402 || value.attributeId != 0x0000
+	    || value.type != NSEZSP::ZCL_INT16S_ATTRIBUTE_TYPE || value.rawValue != 2150 || value.version != 1 || value.lastReport != t0) {
+		FAILF("Wrong stored temperature");
+	}
+	std::chrono::steady_clock::time_point t1 = t0 + std::chrono::seconds(30);
+	if (store.update(0x01000001, makeReport(0x0402, 0x0000, 2150), t1) || store.getVersion() != 2) {
+		FAILF("An unchanged value should not change the version");
+	}
+	if (!store.get(0x01000001, 0x0402, 0x0000, value) || value.version != 1 || value.lastReport != t1) {
+		FAILF("An unchanged value should still update the report time");
+	}
+	if (!store.update(0x01000001, makeReport(0x0402, 0x0000, 2160), t1) || store.getVersion() != 3
+	    || !store.get(0x01000001, 0x0402, 0x0000, value) || value.rawValue != 2160 || value.version != 3) {
+		FAILF("A changed value should get a new version");
+	}
+
+	/* Values that are not kept */
+	NSEZSP::CGpAttributeReport manufacturer = makeReport(0x0000, 0x5000, 0x07);
+	manufacturer.manufacturerSpecific = true;
+	const uint8_t version[] = { '1', '.', '0' };
+	NSEZSP::CGpAttributeReport string = makeReport(0x0000, 0x4000, 0, NSEZSP::ZCL_CHAR_STRING_ATTRIBUTE_TYPE);
+	string.value = NSSPI::ByteView(version, sizeof(version));
+	if (store.update(0x01000001, manufacturer, t1) || store.update(0x01000001, string, t1) || store.update(0, makeReport(0x0402, 0x0000, 0), t1)
+	    || store.getNbEntries() != 2 || store.getNbDropped() != 0) {
+		FAILF("Manufacturer-specific attributes, strings and invalid source IDs should be ignored");
+	}
+
+	/* Full store */
+	store.update(0x01000002, makeReport(0x0402, 0x0000, 1), t1);
+	store.update(0x01000003, makeReport(0x0402, 0x0000, 1), t1);
+	if (store.update(0x01000004, makeReport(0x0402, 0x0000, 1), t1) || store.getNbEntries() != 4 || store.getNbDropped() != 1
+	    || store.get(0x01000004, 0x0402, 0x0000, value)) {
+		FAILF("New attributes should be dropped once the store is full");
+	}
+	if (!store.update(0x01000003, makeReport(0x0402, 0x0000, 2), t1)) {
+		FAILF("Attributes already in a full store should still be updated");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_attribute_store_tests, attribute_store_changed_since) {
+	CGpAttributeStore store(1000);
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	for (uint32_t sourceId = 1; sourceId <= 500; sourceId++) {
+		store.update(sourceId, makeReport(0x0402, 0x0000, sourceId), now);
+		store.update(sourceId, makeReport(0x0405, 0x0000, sourceId), now);
+	}
+	std::size_t count = 0;
+	uint64_t version = store.forEachChangedSince(0, [&count](const CGpAttributeValue&) {
+		count++;
+	});
+	if (version != 1000 || count != 1000) {
+		FAILF("All values should be given on the first poll, got %zu", count);
+	}
+	count = 0;
+	auto counter = [&count](const CGpAttributeValue&) {
+		count++;
+	};
+	if (store.forEachChangedSince(version, counter) != version || count != 0) {
+		FAILF("Nothing should be given when nothing changed");
+	}
+
+	store.update(42, makeReport(0x0405, 0x0000, 4242), now);
+	store.update(43, makeReport(0x0402, 0x0000, 43), now);	/* Unchanged */
+	store.update(44, makeReport(0x0402, 0x0000, 4444), now);
+	std::vector<CGpAttributeValue> changed;
+	version = store.forEachChangedSince(version, [&changed](const CGpAttributeValue& i_value) {
+		changed.push_back(i_value);
+	});
+	if (version != 1002 || changed.size() != 2) {
+		FAILF("Only the changed values should be given, got %zu", changed.size());
+	}
+	for (const CGpAttributeValue& value : changed) {
+		if (!(value.sourceId == 42 && value.clusterId == 0x0405 && value.rawValue == 4242) && !(value.sourceId == 44 && value.clusterId == 0x0402 && value.rawValue == 4444)) {
+			FAILF("Unexpected changed value for source ID %u", value.sourceId);
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_attribute_store_tests, attribute_store_concurrent_readers) {
+	const uint32_t NB_SOURCES = 64;
+	const unsigned int NB_READERS = 4;
+	CGpAttributeStore store(NB_SOURCES);
+	/* The writer always stores the same number in the value and in the report time, so that a reader sees a torn read if they differ */
+	for (uint32_t sourceId = 1; sourceId <= NB_SOURCES; sourceId++) {
+		store.update(sourceId, makeReport(0x0402, 0x0000, 0), std::chrono::steady_clock::time_point());
+	}
+	std::atomic<bool> stop(false);
+	std::atomic<unsigned int> nbTorn(0);
+	std::atomic<unsigned int> nbReads(0);
+	std::vector<std::thread> readers;
+	for (unsigned int i = 0; i < NB_READERS; i++) {
+		readers.emplace_back([&store, &stop, &nbTorn, &nbReads, i]() {
+			uint64_t version = 0;
+			uint32_t sourceId = 1 + i;
+			while (!stop) {
+				CGpAttributeValue value;
+				if (!store.get(sourceId, 0x0402, 0x0000, value) || static_cast<int64_t>(value.rawValue) != value.lastReport.time_since_epoch().count()) {
+					nbTorn++;
+				}
+				version = store.forEachChangedSince(version, [&nbTorn](const CGpAttributeValue& i_value) {
+					if (static_cast<int64_t>(i_value.rawValue) != i_value.lastReport.time_since_epoch().count()) {
+						nbTorn++;
+					}
+				});
+				sourceId = 1 + (sourceId % NB_SOURCES);
+				nbReads++;
+			}
+		});
+	}
+	for (uint64_t n = 1; n <= 200000; n++) {
+		std::chrono::steady_clock::time_point t{std::chrono::steady_clock::duration(static_cast<std::chrono::steady_clock::rep>(n))};
+		store.update(1 + static_cast<uint32_t>(n % NB_SOURCES), makeReport(0x0402, 0x0000, n), t);
+	}
+	stop = true;
+	for (std::thread& reader : readers) {
+		reader.join();
+	}
+	if (nbTorn != 0) {
+		FAILF("Readers saw %u inconsistent values", nbTorn.load());
+	}
+	if (store.getVersion() != 200000 + NB_SOURCES) {
+		FAILF("Wrong final version %llu", static_cast<unsigned long long>(store.getVersion()));
+	}
+	std::cout << "Attribute store: 200000 updates while " << NB_READERS << " threads performed " << nbReads.load() << " polls\n";
+	NOTIFYPASS();
+}
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_attribute_store() {
+	attribute_store_updates();
+	attribute_store_changed_since();
+	attribute_store_concurrent_readers();
+}
+#endif	// USE_CPPUTEST
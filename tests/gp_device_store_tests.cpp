@@ -0,0 +1,395 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <map>
+#include <random>
+#include <chrono>
+#include <fstream>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include "spi/Logger.h"
+#include "spi/ILogger.h"
+#include "ezsp/zigbee-tools/green-power-device-db.h"
+#include "spi/AesBuilder.h"
+
+#include "TestHarness.h"
+
+#ifdef USE_GP_DEVICE_STORE
+#include <unistd.h>
+#endif
+
+using NSSPI::Logger;
+using NSSPI::LOG_LEVEL;
+
+TEST_GROUP(gp_device_store_tests) {
+};
+
+#ifdef USE_GP_DEVICE_STORE
+namespace {
+const NSEZSP::EmberKeyData baseKey({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5F});
+
+/**
+ * @brief A temporary directory holding a store, removed with its content on destruction
+ */
+class TemporaryStore {
+public:
+	TemporaryStore() : directory() {
+		char path[] = "/tmp/gp-device-store-XXXXXX";
+		if (::mkdtemp(path) == nullptr) {
+			FAILF("Cannot create a temporary directory");
+		}
+		this->directory = path;
+	}
+
+	~TemporaryStore() {
+		::unlink(this->path().c_str());
+		::unlink(this->logPath().c_str());
+		::unlink((this->path() + ".tmp").c_str());
+		::unlink((this->logPath() + ".tmp").c_str());
+		::rmdir(this->directory.c_str());
+	}
+
+	std::string path() const {
+		return this->directory + "/gpdevices.db";
+	}
+
+	std::string logPath() const {
+		return this->path() + ".log";
+	}
+
+private:
+	std::string directory;
+};
+
+NSEZSP::EmberKeyData keyForIndex(unsigned int index) {
+	NSEZSP::EmberKeyData key(baseKey);
+	key[0] = static_cast<uint8_t>(index & 0xffU);
+	key[1] = static_cast<uint8_t>((index >> 8) & 0xffU);
+	key[2] = static_cast<uint8_t>((index >> 16) & 0xffU);
+	return key;
+}
+
+/**
+ * @brief Check that a database has exactly the expected content, with valid key schedules
+ */
+void checkDbContent(const NSEZSP::CGPDeviceDb& db, const std::map<uint32_t, NSEZSP::EmberKeyData>& reference, uint32_t maxSourceId) {
+	if (db.size() != reference.size()) {
+		FAILF("Database contains %zu devices, expected %zu", db.size(), reference.size());
+	}
+	for (uint32_t sourceId = 1; sourceId <= maxSourceId; sourceId++) {
+		NSEZSP::CGPDeviceDb::Lookup device = db.lookup(sourceId);
+		auto expected = reference.find(sourceId);
+		if (device.found() != (expected != reference.end())) {
+			FAILF("Source ID 0x%08x should %sbe in the database", sourceId, (expected != reference.end()) ? "" : "not ");
+		}
+		if (!device.found()) {
+			continue;
+		}
+		NSSPI::IAes::ExpandedKey expandedKey;
+		NSSPI::AesBuilder::shared().expand_key(expected->second, expandedKey);
+		if (*device.key != expected->second || memcmp(device.expandedKey->round_keys, expandedKey.round_keys, sizeof(expandedKey.round_keys)) != 0) {
+			FAILF("Wrong key or key schedule for source ID 0x%08x", sourceId);
+		}
+	}
+}
+
+void appendBytes(const std::string& path, const std::vector<char>& bytes) {
+	std::ofstream file(path, std::ios::binary | std::ios::app);
+	file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+std::vector<char> readFile(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	return std::vector<char>((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+void writeFile(const std::string& path, const std::vector<char>& bytes) {
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+}
+
+TEST(gp_device_store_tests, store_round_trip) {
+	static constexpr unsigned int NB_SOURCE_IDS = 500;
+	static constexpr unsigned int NB_OPERATIONS = 1500;	/* More than the compaction threshold, so that the log is compacted on the way */
+	TemporaryStore store;
+	std::map<uint32_t, NSEZSP::EmberKeyData> reference;
+	std::mt19937 rng(0x57);
+	{
+		NSEZSP::CGPDeviceDb db(NB_SOURCE_IDS);
+		if (!db.openStore(store.path())) {
+			FAILF("Could not create a new store");
+		}
+		std::vector<NSEZSP::CGpDevice> devices;
+		for (uint32_t sourceId = 1; sourceId <= NB_SOURCE_IDS; sourceId += 3) {
+			devices.push_back(NSEZSP::CGpDevice(sourceId, keyForIndex(sourceId)));
+			reference[sourceId] = keyForIndex(sourceId);
+		}
+		db.setDb(devices);	/* Written as a snapshot */
+		for (unsigned int operation = 0; operation < NB_OPERATIONS; operation++) {	/* Written to the log */
+			uint32_t sourceId = 1 + static_cast<uint32_t>(rng() % NB_SOURCE_IDS);
+			if (rng() % 3 == 0) {
+				db.removeDevice(sourceId);
+				reference.erase(sourceId);
+			}
+			else {
+				db.insertDevice(sourceId, keyForIndex(operation));
+				reference[sourceId] = keyForIndex(operation);
+			}
+		}
+		checkDbContent(db, reference, NB_SOURCE_IDS);
+	}
+	/* Snapshot + log replay */
+	NSEZSP::CGPDeviceDb reloaded(NB_SOURCE_IDS);
+	if (!reloaded.openStore(store.path())) {
+		FAILF("Could not reopen the store");
+	}
+	checkDbContent(reloaded, reference, NB_SOURCE_IDS);
+	/* Modifications of a loaded table, then a snapshot of it */
+	reloaded.insertDevice(NB_SOURCE_IDS + 1, keyForIndex(1));
+	reference[NB_SOURCE_IDS + 1] = keyForIndex(1);
+	reloaded.removeDevice(reference.begin()->first);
+	reference.erase(reference.begin());
+	if (!reloaded.saveStore()) {
+		FAILF("Could not save the store");
+	}
+	checkDbContent(reloaded, reference, NB_SOURCE_IDS + 1);
+	/* Only keys are persisted (64-byte header, then 24 bytes per device), key schedules are re-computed when loading */
+	if (readFile(store.path()).size() != 64 + 24 * reference.size()) {
+		FAILF("Snapshot of %zu devices takes %zu bytes, expected %zu", reference.size(), readFile(store.path()).size(), 64 + 24 * reference.size());
+	}
+	reloaded.closeStore();
+	checkDbContent(reloaded, reference, NB_SOURCE_IDS + 1);	/* Content is kept in memory */
+
+	NSEZSP::CGPDeviceDb again(NB_SOURCE_IDS + 1);
+	if (!again.openStore(store.path())) {
+		FAILF("Could not reopen the store after saving");
+	}
+	checkDbContent(again, reference, NB_SOURCE_IDS + 1);
+	again.clear();
+	NSEZSP::CGPDeviceDb cleared(NB_SOURCE_IDS);
+	if (!cleared.openStore(store.path()) || cleared.size() != 0) {
+		FAILF("Store should be empty after clear()");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_device_store_tests, store_survives_torn_log_append) {
+	TemporaryStore store;
+	std::map<uint32_t, NSEZSP::EmberKeyData> reference;
+	{
+		NSEZSP::CGPDeviceDb db(16);
+		if (!db.openStore(store.path())) {
+			FAILF("Could not create a new store");
+		}
+		for (uint32_t sourceId = 1; sourceId <= 10; sourceId++) {
+			db.insertDevice(sourceId, keyForIndex(sourceId));
+			reference[sourceId] = keyForIndex(sourceId);
+		}
+		db.removeDevice(4);
+		reference.erase(4);
+	}
+	/* Power loss in the middle of an append: half a record at the end of the log */
+	std::vector<char> log = readFile(store.logPath());
+	appendBytes(store.logPath(), std::vector<char>(log.end() - 32, log.end() - 16));
+	{
+		NSEZSP::CGPDeviceDb db(16);
+		if (!db.openStore(store.path())) {
+			FAILF("Could not reopen a store with a torn log");
+		}
+		checkDbContent(db, reference, 16);
+		/* Records appended after recovery must be replayed too */
+		db.insertDevice(11, keyForIndex(11));
+		reference[11] = keyForIndex(11);
+	}
+	/* Corrupted last record */
+	log = readFile(store.logPath());
+	log[log.size() - 20] ^= 0x01;
+	writeFile(store.logPath(), log);
+	reference.erase(11);
+	NSEZSP::CGPDeviceDb db(16);
+	if (!db.openStore(store.path())) {
+		FAILF("Could not reopen a store with a corrupted log");
+	}
+	checkDbContent(db, reference, 16);
+	NOTIFYPASS();
+}
+
+TEST(gp_device_store_tests, store_rejects_corruption) {
+	TemporaryStore store;
+	std::map<uint32_t, NSEZSP::EmberKeyData> reference;
+	std::vector<NSEZSP::CGpDevice> devices;
+	for (uint32_t sourceId = 1; sourceId <= 20; sourceId++) {
+		devices.push_back(NSEZSP::CGpDevice(sourceId, keyForIndex(sourceId)));
+		reference[sourceId] = keyForIndex(sourceId);
+	}
+	{
+		NSEZSP::CGPDeviceDb db(32);
+		db.openStore(store.path());
+		db.setDb(devices);
+	}
+	std::vector<char> snapshot = readFile(store.path());
+	std::vector<char> log = readFile(store.logPath());
+
+	/* A log left over from the previous snapshot (power loss before the log could be reset) must be ignored */
+	{
+		NSEZSP::CGPDeviceDb db(32);
+		db.openStore(store.path());
+		db.removeDevice(5);
+		std::vector<char> staleLog = readFile(store.logPath());
+		db.insertDevice(5, keyForIndex(5));
+		db.saveStore();
+		writeFile(store.logPath(), staleLog);	/* Generation of the previous snapshot, replaying it would remove source ID 5 */
+	}
+	{
+		NSEZSP::CGPDeviceDb db(32);
+		if (!db.openStore(store.path())) {
+			FAILF("Could not reopen a store with a stale log");
+		}
+		checkDbContent(db, reference, 32);
+	}
+	writeFile(store.logPath(), log);
+
+	/* Flipped bit in the keys, in the frame counters and in the header */
+	const std::size_t offsets[] = { snapshot.size() - 1, 64 + 4, 16 };
+	for (std::size_t offset : offsets) {
+		std::vector<char> corrupted(snapshot);
+		corrupted[offset] ^= 0x10;
+		writeFile(store.path(), corrupted);
+		NSEZSP::CGPDeviceDb db(32);
+		db.insertDevice(1000, baseKey);
+		if (db.openStore(store.path())) {
+			FAILF("A snapshot corrupted at offset %zu should be refused", offset);
+		}
+		if (db.size() != 1 || !db.isSourceIdInDb(1000)) {
+			FAILF("Database should be left unchanged when the store is refused");
+		}
+	}
+	writeFile(store.path(), std::vector<char>(snapshot.begin(), snapshot.end() - 1));
+	NSEZSP::CGPDeviceDb db(32);
+	if (db.openStore(store.path())) {
+		FAILF("A truncated snapshot should be refused");
+	}
+	writeFile(store.path(), snapshot);
+	if (!db.openStore(store.path())) {
+		FAILF("Could not reopen the restored snapshot");
+	}
+	checkDbContent(db, reference, 32);
+	NOTIFYPASS();
+}
+
+TEST(gp_device_store_tests, store_persists_frame_counters) {
+	TemporaryStore store;
+	{
+		NSEZSP::CGPDeviceDb db(8);
+		if (!db.openStore(store.path())) {
+			FAILF("Could not create a new store");
+		}
+		db.setDb({ NSEZSP::CGpDevice(1, keyForIndex(1)), NSEZSP::CGpDevice(2, keyForIndex(2)), NSEZSP::CGpDevice(3, keyForIndex(3)) });
+		for (uint32_t frameCounter = 0; frameCounter < 100; frameCounter++) {
+			db.acceptFrameCounter(1, frameCounter);
+		}
+		db.acceptFrameCounter(2, 50);
+		if (!db.flushFrameCounters(true)) {
+			FAILF("Could not flush frame counters");
+		}
+		db.acceptFrameCounter(3, 7);	/* Only persisted by the destructor */
+	}
+	NSEZSP::CGPDeviceDb reloaded(8);
+	if (!reloaded.openStore(store.path())) {
+		FAILF("Could not reopen the store");
+	}
+	if (reloaded.lookup(1).nextFrameCounter != 100 || reloaded.lookup(2).nextFrameCounter != 51 || reloaded.lookup(3).nextFrameCounter != 8) {
+		FAILF("Frame counters were not persisted (got %u, %u, %u)",
+		      reloaded.lookup(1).nextFrameCounter, reloaded.lookup(2).nextFrameCounter, reloaded.lookup(3).nextFrameCounter);
+	}
+	if (reloaded.acceptFrameCounter(1, 99) != NSEZSP::CGPDeviceDb::FrameCounterCheck::DUPLICATE
+	        || reloaded.acceptFrameCounter(2, 10) != NSEZSP::CGPDeviceDb::FrameCounterCheck::REPLAY) {
+		FAILF("Frames accepted before a restart should be rejected after it");
+	}
+	reloaded.acceptFrameCounter(1, 200);	/* Not flushed yet (write-behind) */
+	if (!reloaded.flushFrameCounters() && reloaded.saveStore()) {	/* The snapshot also carries frame counters */
+		reloaded.closeStore();
+		NSEZSP::CGPDeviceDb saved(8);
+		if (!saved.openStore(store.path()) || saved.lookup(1).nextFrameCounter != 201) {
+			FAILF("Frame counters should be part of the snapshot");
+		}
+	}
+	else {
+		FAILF("Frame counters should not be flushed before %lld s", static_cast<long long>(NSEZSP::CGPDeviceDb::FRAME_COUNTER_FLUSH_INTERVAL.count()));
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_device_store_tests, store_startup_time) {
+	static constexpr unsigned int NB_DEVICES = 100000;
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	TemporaryStore store;
+	std::mt19937 rng(0x100000);
+	std::vector<NSEZSP::CGpDevice> devices;
+	devices.reserve(NB_DEVICES);
+	for (unsigned int index = 0; index < NB_DEVICES; index++) {
+		devices.push_back(NSEZSP::CGpDevice(1 + static_cast<uint32_t>(rng() % 0xfffffffeU), keyForIndex(index)));
+	}
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	{
+		NSEZSP::CGPDeviceDb db(NB_DEVICES);
+		db.setDb(devices);
+	}
+	double setDbSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	{
+		NSEZSP::CGPDeviceDb db(NB_DEVICES);
+		db.openStore(store.path());
+		db.setDb(devices);
+		for (unsigned int index = 0; index < 100; index++) {	/* Some modifications in the log */
+			db.removeDevice(devices[index].getSourceId());
+		}
+	}
+	NSEZSP::CGPDeviceDb db(NB_DEVICES);
+	start = std::chrono::steady_clock::now();
+	bool opened = db.openStore(store.path());
+	double openSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	if (!opened) {
+		FAILF("Could not open the store");
+	}
+	for (unsigned int index = 0; index < NB_DEVICES; index += 97) {
+		NSEZSP::CGPDeviceDb::Lookup device = db.lookup(devices[index].getSourceId());
+		if (device.found() != (index >= 100)) {
+			FAILF("Wrong lookup result for device %u", index);
+		}
+	}
+	std::cout << "GP device database with " << std::dec << db.size() << " devices: setDb() in " << std::fixed << std::setprecision(1)
+	          << (setDbSeconds * 1000) << "ms, openStore() in " << (openSeconds * 1000) << "ms\n";
+	std::cout.unsetf(std::ios_base::floatfield);
+	NOTIFYPASS();
+}
+#else	// USE_GP_DEVICE_STORE
+TEST(gp_device_store_tests, store_unsupported) {
+	NSEZSP::CGPDeviceDb db(4);
+	db.insertDevice(1, NSEZSP::EmberKeyData({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5F}));
+	if (db.openStore("/tmp/gpdevices.db") || db.saveStore()) {
+		FAILF("The store cannot be opened without USE_GP_DEVICE_STORE");
+	}
+	if (db.size() != 1 || !db.isSourceIdInDb(1)) {
+		FAILF("Database should be left unchanged when the store is refused");
+	}
+	NOTIFYPASS();
+}
+#endif	// USE_GP_DEVICE_STORE
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_device_store() {
+#ifdef USE_GP_DEVICE_STORE
+	store_round_trip();
+	store_survives_torn_log_append();
+	store_rejects_corruption();
+	store_persists_frame_counters();
+	store_startup_time();
+#else
+	store_unsupported();
+#endif
+}
+#endif	// USE_CPPUTEST
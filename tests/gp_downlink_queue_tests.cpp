@@ -0,0 +1,156 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+#include "ezsp/zigbee-tools/green-power-downlink-queue.h"
+
+#include "TestHarness.h"
+
+using NSEZSP::CGpDownlinkQueue;
+using NSEZSP::CGpDownlinkReport;
+
+namespace {
+const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::time_point() + std::chrono::hours(1);
+
+std::chrono::steady_clock::time_point at(unsigned int i_ms) {
+	return t0 + std::chrono::milliseconds(i_ms);
+}
+}
+
+TEST_GROUP(gp_downlink_queue_tests) {
+};
+
+TEST(gp_downlink_queue_tests, downlink_waits_for_uplink) {
+	CGpDownlinkQueue queue;
+	std::vector<CGpDownlinkQueue::Push> pushes;
+	std::vector<CGpDownlinkQueue::Finished> finished;
+	std::vector<CGpDownlinkReport> reports;
+	auto record = [&reports](const CGpDownlinkReport& i_report) {
+		reports.push_back(i_report);
+	};
+
+	queue.enqueue(0x01000001, 0xF3, { 0x1f }, 3, std::chrono::seconds(60), at(0), record, pushes);
+	queue.enqueue(0x01000001, 0xF4, { }, 3, std::chrono::seconds(60), at(0), record, pushes);
+	std::chrono::steady_clock::time_point when;
+	queue.poll(at(5000), pushes, finished);
+	if (!pushes.empty() || queue.getNbQueued() != 2) {
+		FAILF("Nothing should be pushed before the device is heard");
+	}
+	if (!queue.getNextEvent(when) || when != at(60000)) {
+		FAILF("Only the expiry should be scheduled");
+	}
+
+	/* Uplinks from other devices, or a device whose period is unknown, push the head right away */
+	queue.uplink(0x01000002, at(6000), pushes);
+	queue.uplink(0x01000001, at(6000), pushes);
+	if (pushes.size() != 1 || pushes[0].sourceId != 0x01000001 || pushes[0].commandId != 0xF3 || pushes[0].payload != NSSPI::ByteBuffer({ 0x1f })
+	    || pushes[0].lifeTimeMs != CGpDownlinkQueue::UNKNOWN_PERIOD_LIFETIME.count()) {
+		FAILF("The head should be pushed after the uplink");
+	}
+	pushes.clear();
+	queue.uplink(0x01000001, at(6050), pushes);
+	if (!pushes.empty()) {
+		FAILF("Only one GPDF per device should be in the adapter");
+	}
+	queue.sent(0x01000001, true, at(7000), finished);
+	if (finished.size() != 1 || !finished[0].report.delivered || finished[0].report.nbAttempts != 1 || finished[0].report.queueDelay != std::chrono::seconds(7)) {
+		FAILF("Wrong outcome for the delivered GPDF");
+	}
+	finished[0].callback(finished[0].report);
+	finished.clear();
+	queue.poll(at(8000), pushes, finished);
+	if (!pushes.empty()) {
+		FAILF("The next GPDF should wait for the next uplink");
+	}
+	/* The second uplink gives the period, the next GPDF is pushed before the following predicted uplink */
+	queue.uplink(0x01000001, at(9000), pushes);
+	if (!pushes.empty() || queue.getPeriod(0x01000001) != std::chrono::seconds(3) || !queue.getNextEvent(when) || when != at(11625)) {
+		FAILF("The next GPDF should be scheduled before the predicted uplink");
+	}
+	queue.poll(at(11700), pushes, finished);
+	if (pushes.size() != 1 || pushes[0].commandId != 0xF4 || pushes[0].lifeTimeMs != 675) {
+		FAILF("The next GPDF should be pushed before the predicted uplink");
+	}
+	queue.sent(0x01000001, true, at(12010), finished);
+	if (queue.getNbQueued() != 0 || queue.getNextEvent(when) || reports.size() != 1) {
+		FAILF("All GPDFs should be delivered");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_downlink_queue_tests, downlink_period_prediction) {
+	CGpDownlinkQueue queue;
+	std::vector<CGpDownlinkQueue::Push> pushes;
+	std::vector<CGpDownlinkQueue::Finished> finished;
+
+	/* Uplinks every 10s, with repetitions of each transmission and a missed uplink */
+	for (unsigned int ms : { 0, 20, 10000, 10040, 20000, 40000, 50000 }) {
+		queue.uplink(0x01000001, at(ms), pushes);
+	}
+	if (queue.getPeriod(0x01000001) != std::chrono::seconds(10) || queue.getPeriod(0x01000002) != std::chrono::milliseconds(0)) {
+		FAILF("Wrong learned period: %lldms", static_cast<long long>(queue.getPeriod(0x01000001).count()));
+	}
+	std::chrono::steady_clock::duration guard = CGpDownlinkQueue::getWakeGuard(std::chrono::seconds(10));
+	if (guard != std::chrono::milliseconds(1250) || CGpDownlinkQueue::getWakeGuard(std::chrono::seconds(1)) != CGpDownlinkQueue::MIN_WAKE_GUARD) {
+		FAILF("Wrong wake guard");
+	}
+
+	/* Pushed shortly before the predicted uplink, for the duration of the window around it */
+	queue.enqueue(0x01000001, 0xF3, { }, 2, std::chrono::seconds(60), at(52000), nullptr, pushes);
+	std::chrono::steady_clock::time_point when;
+	if (!pushes.empty() || !queue.getNextEvent(when) || when != at(60000) - guard) {
+		FAILF("The push should be scheduled before the predicted uplink");
+	}
+	queue.poll(at(58800), pushes, finished);
+	if (pushes.size() != 1 || pushes[0].lifeTimeMs != 1200 + 1250) {
+		FAILF("The GPDF should be pushed for the rest of the window");
+	}
+	pushes.clear();
+
+	/* The device stays asleep: the second attempt aims at the following predicted uplink, then the GPDF is given up */
+	queue.sent(0x01000001, false, at(61300), finished);
+	if (!finished.empty() || !queue.getNextEvent(when) || when != at(70000) - guard) {
+		FAILF("A second attempt should be scheduled");
+	}
+	queue.poll(at(68750), pushes, finished);
+	queue.sent(0x01000001, false, at(71300), finished);
+	if (pushes.size() != 1 || finished.size() != 1 || finished[0].report.delivered || finished[0].report.nbAttempts != 2 || queue.getNbQueued() != 0) {
+		FAILF("The GPDF should be given up after its last attempt");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_downlink_queue_tests, downlink_expiry) {
+	CGpDownlinkQueue queue;
+	std::vector<CGpDownlinkQueue::Push> pushes;
+	std::vector<CGpDownlinkQueue::Finished> finished;
+
+	queue.enqueue(0x01000001, 0xF3, { }, 3, std::chrono::seconds(1), at(0), nullptr, pushes);
+	queue.enqueue(0x01000001, 0xF4, { }, 3, std::chrono::seconds(2), at(0), nullptr, pushes);
+	queue.enqueue(0x01000002, 0xF3, { }, 3, std::chrono::seconds(5), at(0), nullptr, pushes);
+	queue.uplink(0x01000001, at(500), pushes);
+	queue.poll(at(2500), pushes, finished);
+	if (pushes.size() != 1 || finished.size() != 1 || finished[0].report.commandId != 0xF4 || finished[0].report.nbAttempts != 0) {
+		FAILF("Only GPDFs that are not in the adapter should expire");
+	}
+	finished.clear();
+	queue.sent(0x01000001, false, at(3000), finished);
+	if (finished.size() != 1 || finished[0].report.commandId != 0xF3 || finished[0].report.delivered) {
+		FAILF("An expired GPDF should be given up after its attempt fails");
+	}
+	finished.clear();
+	queue.poll(at(5000), pushes, finished);
+	if (finished.size() != 1 || finished[0].report.sourceId != 0x01000002 || queue.getNbQueued() != 0) {
+		FAILF("GPDFs for devices never heard should expire");
+	}
+	NOTIFYPASS();
+}
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_downlink_queue() {
+	downlink_waits_for_uplink();
+	downlink_period_prediction();
+	downlink_expiry();
+}
+#endif	// USE_CPPUTEST
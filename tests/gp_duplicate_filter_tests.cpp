@@ -0,0 +1,192 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+#include "spi/TimerBuilder.h"
+#include "spi/ByteBuffer.h"
+#include "spi/Logger.h"
+#include "spi/ILogger.h"
+#include "ezsp/ezsp-dongle.h"
+#include "ezsp/zigbee-tools/zigbee-messaging.h"
+#include "ezsp/zigbee-tools/green-power-sink.h"
+#include "ezsp/zigbee-tools/green-power-duplicate-filter.h"
+
+#include "TestHarness.h"
+
+using NSSPI::Logger;
+using NSSPI::LOG_LEVEL;
+
+namespace {
+/* The secured GP frame also used in green_power_frame_tests.cpp (source ID 0x0054000a), as reported by the adapter with EMBER_SUCCESS */
+const NSSPI::ByteBuffer knownEzspMsg({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x02, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0xa2, 0xb5, 0x92, 0x23, 0x4e, 0x00, 0x11, 0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30});
+const uint32_t knownSourceId = 0x0054000a;
+const unsigned int STATUS_OFFSET = 0;	/* Offset of the EZSP status in knownEzspMsg */
+const unsigned int SEQUENCE_NUMBER_OFFSET = 2;	/* Offset of the MAC sequence number in knownEzspMsg */
+const unsigned int SECURITY_LEVEL_OFFSET = 13;	/* Offset of the security level in knownEzspMsg */
+const unsigned int FRAME_COUNTER_OFFSET = 17;	/* Offset of the little endian security frame counter in knownEzspMsg */
+const unsigned int COMMAND_ID_OFFSET = 21;	/* Offset of the command ID in knownEzspMsg */
+
+/**
+ * @brief Forge an unsecured copy of knownEzspMsg
+ *
+ * @param sequenceNumber The MAC sequence number
+ * @param commandId The GPD command ID
+ */
+NSSPI::ByteBuffer forgeUnsecuredEzspMsg(uint8_t sequenceNumber, uint8_t commandId) {
+	NSSPI::ByteBuffer ezspMsg(knownEzspMsg);
+	ezspMsg[SEQUENCE_NUMBER_OFFSET] = sequenceNumber;
+	ezspMsg[SECURITY_LEVEL_OFFSET] = 0x00;
+	ezspMsg[COMMAND_ID_OFFSET] = commandId;
+	return ezspMsg;
+}
+
+/**
+ * @brief Observer counting the source IDs notified by the sink
+ */
+class SourceIdCountingObserver : public NSEZSP::CGpObserver {
+public:
+	SourceIdCountingObserver() : nbRxGpdIds(0) { }
+
+	void handleRxGpFrame(const NSEZSP::CGpFrameView& i_gpf) override {
+	}
+
+	void handleRxGpdId(uint32_t& i_gpd_id, bool i_gpd_known, NSEZSP::CGpdKeyStatus i_gpd_key_status) override {
+		if (i_gpd_id == knownSourceId) {
+			this->nbRxGpdIds++;
+		}
+	}
+
+	unsigned int nbRxGpdIds;
+};
+}
+
+TEST_GROUP(gp_duplicate_filter_tests) {
+};
+
+TEST(gp_duplicate_filter_tests, filter_frame_counters) {
+	static constexpr uint32_t NB_SOURCE_IDS = 100000;
+	NSEZSP::CGpDuplicateFilter filter(1024);
+
+	if (filter.isDuplicateFrameCounter(knownSourceId, 10) || !filter.isDuplicateFrameCounter(knownSourceId, 10)) {
+		FAILF("The second copy of a frame should be reported as a duplicate");
+	}
+	if (filter.isDuplicateFrameCounter(knownSourceId + 1, 10)) {
+		FAILF("Frames from another source ID should not be reported as duplicates");
+	}
+	if (filter.isDuplicateFrameCounter(knownSourceId, 11) || filter.isDuplicateFrameCounter(knownSourceId, 0)) {
+		FAILF("Frames with another frame counter should not be reported as duplicates (older ones included)");
+	}
+	if (filter.isDuplicateSequenceNumber(knownSourceId, 0, std::chrono::steady_clock::now())) {
+		FAILF("A sequence number should not be compared with a frame counter");
+	}
+
+	/* Many more source IDs than slots: copies may go through, new frames must never be dropped */
+	unsigned int nbDetected = 0;
+	for (uint32_t index = 0; index < NB_SOURCE_IDS; index++) {
+		if (filter.isDuplicateFrameCounter(0x01000000 + index, 1)) {
+			FAILF("The first frame from source ID 0x%08x should not be reported as a duplicate", 0x01000000 + index);
+		}
+		if (filter.isDuplicateFrameCounter(0x01000000 + index, 1)) {
+			nbDetected++;
+		}
+	}
+	if (nbDetected != NB_SOURCE_IDS) {
+		FAILF("A copy immediately following its original should always be detected, got %u out of %u", nbDetected, NB_SOURCE_IDS);
+	}
+	filter.clear();
+	if (filter.isDuplicateFrameCounter(0x01000000, 1)) {
+		FAILF("Frames accepted before clear() should be forgotten");
+	}
+	std::cout << "Duplicate filter for 1024 source IDs uses " << std::dec << filter.memoryFootprint() << " bytes\n";
+	NOTIFYPASS();
+}
+
+TEST(gp_duplicate_filter_tests, filter_sequence_numbers) {
+	NSEZSP::CGpDuplicateFilter filter(0);
+	std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	const std::chrono::steady_clock::duration timeout = NSEZSP::CGpDuplicateFilter::DUPLICATE_TIMEOUT;
+
+	if (filter.isDuplicateSequenceNumber(knownSourceId, 0x42, t0) || !filter.isDuplicateSequenceNumber(knownSourceId, 0x42, t0 + timeout / 2)) {
+		FAILF("A copy received within the timeout should be reported as a duplicate");
+	}
+	if (filter.isDuplicateSequenceNumber(knownSourceId, 0x42, t0 + timeout + std::chrono::milliseconds(1))) {
+		FAILF("The timeout should run from the reception of the original frame, not of its copies");
+	}
+	if (filter.isDuplicateSequenceNumber(knownSourceId, 0x43, t0 + timeout * 2) || filter.isDuplicateSequenceNumber(knownSourceId, 0x42, t0 + timeout * 2)) {
+		FAILF("A frame with another sequence number should not be reported as a duplicate, nor should the frame following it");
+	}
+	if (filter.isDuplicateFrameCounter(knownSourceId, 0x42)) {
+		FAILF("A frame counter should not be compared with a sequence number");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_duplicate_filter_tests, sink_drops_duplicates) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	NSSPI::TimerBuilder timerBuilder;
+	NSEZSP::CEzspDongle dongle(timerBuilder);	/* Never opened: frames are directly injected into the sink */
+	NSEZSP::CZigbeeMessaging zbMessaging(dongle, timerBuilder);
+	NSEZSP::CGpSink sink(dongle, zbMessaging, timerBuilder, 16);
+	SourceIdCountingObserver observer;
+	sink.registerObserver(&observer);
+	auto receive = [&sink](const NSSPI::ByteBuffer& ezspMsg) {
+		sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, ezspMsg);
+		sink.handleEzspRxBurstEnd();
+	};
+
+	/* Unsecured frames are recognized by their sequence number, whether MICs are processed on the host or not */
+	receive(forgeUnsecuredEzspMsg(0x10, 0xA2));
+	receive(forgeUnsecuredEzspMsg(0x10, 0xA2));
+	receive(forgeUnsecuredEzspMsg(0x11, 0xA2));
+	if (observer.nbRxGpdIds != 2 || sink.getNbDroppedDuplicateRxGpFrames() != 1) {
+		FAILF("The copy of an unsecured frame should be dropped, got %u frames", observer.nbRxGpdIds);
+	}
+
+	/* Repetitions of commissioning frames are expected by the commissioning */
+	observer.nbRxGpdIds = 0;
+	receive(forgeUnsecuredEzspMsg(0x20, 0xE0));
+	receive(forgeUnsecuredEzspMsg(0x20, 0xE0));
+	if (observer.nbRxGpdIds != 2 || sink.getNbDroppedDuplicateRxGpFrames() != 1) {
+		FAILF("Copies of commissioning frames should not be dropped, got %u frames", observer.nbRxGpdIds);
+	}
+
+#ifndef USE_BUILTIN_MIC_PROCESSING
+	/* Secured frames authenticated by the adapter are recognized by their frame counter */
+	observer.nbRxGpdIds = 0;
+	receive(knownEzspMsg);
+	receive(knownEzspMsg);
+	NSSPI::ByteBuffer nextEzspMsg(knownEzspMsg);
+	nextEzspMsg[FRAME_COUNTER_OFFSET]++;
+	receive(nextEzspMsg);
+	if (observer.nbRxGpdIds != 2 || sink.getNbDroppedDuplicateRxGpFrames() != 2) {
+		FAILF("The copy of a secured frame should be dropped, got %u frames", observer.nbRxGpdIds);
+	}
+
+	/* Frames the adapter could not authenticate must not mask the genuine frame carrying the same frame counter */
+	observer.nbRxGpdIds = 0;
+	NSSPI::ByteBuffer forgedEzspMsg(knownEzspMsg);
+	forgedEzspMsg[STATUS_OFFSET] = static_cast<uint8_t>(NSEZSP::EEmberStatus::UNDOCUMENTED_WRONG_MIC_FOR_SOURCE_ID);
+	forgedEzspMsg[FRAME_COUNTER_OFFSET] += 2;
+	receive(forgedEzspMsg);
+	receive(forgedEzspMsg);
+	nextEzspMsg[FRAME_COUNTER_OFFSET]++;
+	receive(nextEzspMsg);
+	if (observer.nbRxGpdIds != 3 || sink.getNbDroppedDuplicateRxGpFrames() != 2) {
+		FAILF("Frames that could not be authenticated should not be checked for duplicates, got %u frames", observer.nbRxGpdIds);
+	}
+	if (sink.getNbDroppedReplayedRxGpFrames() != 0) {
+		FAILF("Replays are checked by the adapter when MICs are not processed on the host");
+	}
+#endif
+	sink.unregisterObserver(&observer);
+	NOTIFYPASS();
+}
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_duplicate_filter() {
+	filter_frame_counters();
+	filter_sequence_numbers();
+	sink_drops_duplicates();
+}
+#endif	// USE_CPPUTEST
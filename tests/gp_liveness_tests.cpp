@@ -0,0 +1,201 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <random>
+#include <algorithm>
+
+#include "ezsp/zigbee-tools/green-power-liveness.h"
+
+#include "TestHarness.h"
+
+using NSEZSP::CGpLivenessTracker;
+using NSEZSP::CGpLivenessReport;
+
+namespace {
+const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::time_point() + std::chrono::hours(1);
+
+/**
+ * @brief Get the time of a tick of 1ms after t0
+ */
+std::chrono::steady_clock::time_point at(uint64_t i_ms) {
+	return t0 + std::chrono::milliseconds(i_ms);
+}
+}
+
+TEST_GROUP(gp_liveness_tests) {
+};
+
+TEST(gp_liveness_tests, liveness_offline_and_recovery) {
+	CGpLivenessTracker tracker(16, t0);
+	tracker.configure(3, std::chrono::milliseconds(1), std::chrono::milliseconds(1000), std::chrono::milliseconds(1), t0);
+	CGpLivenessReport report;
+	std::vector<CGpLivenessReport> reports;
+
+	/* Heard every 100ms, then silent */
+	for (uint64_t t = 0; t <= 500; t += 100) {
+		if (tracker.heard(0x01000001, at(t), report)) {
+			FAILF("An online device should not be reported as recovered");
+		}
+		tracker.expire(at(t), reports);
+	}
+	if (tracker.getPeriod(0x01000001) != std::chrono::milliseconds(100) || !tracker.isOnline(0x01000001) || !reports.empty()) {
+		FAILF("The period should be learned, got %lldms", static_cast<long long>(tracker.getPeriod(0x01000001).count()));
+	}
+	tracker.expire(at(799), reports);
+	if (!reports.empty()) {
+		FAILF("The device should not be offline before missing 3 reports");
+	}
+	tracker.expire(at(800), reports);
+	if (reports.size() != 1 || reports[0].sourceId != 0x01000001 || !reports[0].offline || reports[0].expectedPeriod != std::chrono::milliseconds(100)
+	    || reports[0].silence != std::chrono::milliseconds(300) || tracker.isOnline(0x01000001) || tracker.getNbOffline() != 1) {
+		FAILF("The device should be offline after missing 3 reports");
+	}
+	reports.clear();
+	tracker.expire(at(5000), reports);
+	if (!reports.empty() || tracker.hasDeadlines()) {
+		FAILF("An offline device should only be reported once");
+	}
+
+	/* Heard again */
+	if (!tracker.heard(0x01000001, at(5000), report) || report.offline || report.sourceId != 0x01000001 || report.silence != std::chrono::milliseconds(4500)
+	    || !tracker.isOnline(0x01000001) || tracker.getNbOffline() != 0) {
+		FAILF("The device should be reported as recovered");
+	}
+	/* The outage spanned 45 periods, the learned period is kept */
+	if (tracker.getPeriod(0x01000001) != std::chrono::milliseconds(100)) {
+		FAILF("The period should not be disturbed by the outage, got %lldms", static_cast<long long>(tracker.getPeriod(0x01000001).count()));
+	}
+
+	/* A device heard only once uses the initial timeout */
+	tracker.heard(0x01000002, at(5000), report);
+	tracker.expire(at(5999), reports);
+	if (reports.size() != 1 || reports[0].sourceId != 0x01000001) {
+		FAILF("Only the periodic device should be offline before the initial timeout");
+	}
+	tracker.expire(at(6000), reports);
+	if (reports.size() != 2 || reports[1].sourceId != 0x01000002 || reports[1].expectedPeriod != std::chrono::milliseconds(0)) {
+		FAILF("A device heard once should be offline after the initial timeout");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_liveness_tests, liveness_wheel_levels) {
+	/* Deadlines spread over all levels of the wheel (up to 4 * 100000 ticks), checked against the expected expiry tick of each device */
+	const std::size_t NB_DEVICES = 5000;
+	CGpLivenessTracker tracker(NB_DEVICES, t0);
+	tracker.configure(3, std::chrono::milliseconds(1), std::chrono::milliseconds(1), std::chrono::milliseconds(1), t0);
+	std::mt19937 rng(42);
+	std::uniform_int_distribution<uint32_t> periods(1, 100000);
+	std::vector<uint64_t> deadlines(NB_DEVICES + 1);
+	CGpLivenessReport report;
+	for (uint32_t sourceId = 1; sourceId <= NB_DEVICES; sourceId++) {
+		uint32_t period = periods(rng);
+		tracker.heard(sourceId, at(0), report);
+		tracker.heard(sourceId, at(period), report);
+		deadlines[sourceId] = 4 * static_cast<uint64_t>(period);	/* Heard at period, offline after 3 periods */
+	}
+	std::vector<CGpLivenessReport> reports;
+	std::vector<bool> expired(NB_DEVICES + 1, false);
+	std::size_t nbExpired = 0;
+	for (uint64_t t = 0; t < 400000 + 997; t += 997) {
+		reports.clear();
+		tracker.expire(at(t), reports);
+		for (const CGpLivenessReport& expiredReport : reports) {
+			uint32_t sourceId = expiredReport.sourceId;
+			if (expired[sourceId] || deadlines[sourceId] > t || expiredReport.silence != std::chrono::milliseconds(deadlines[sourceId] - deadlines[sourceId] / 4)) {
+				FAILF("Source ID %u expired at the wrong time (deadline %llu, now %llu)", sourceId, static_cast<unsigned long long>(deadlines[sourceId]), static_cast<unsigned long long>(t));
+			}
+			expired[sourceId] = true;
+			nbExpired++;
+		}
+		std::size_t nbDue = static_cast<std::size_t>(std::count_if(deadlines.begin() + 1, deadlines.end(), [t](uint64_t deadline) {
+			return deadline <= t;
+		}));
+		if (nbExpired != nbDue) {
+			FAILF("%zu devices expired at %llu, %zu expected", nbExpired, static_cast<unsigned long long>(t), nbDue);
+		}
+	}
+	if (nbExpired != NB_DEVICES || tracker.hasDeadlines()) {
+		FAILF("All devices should have expired");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_liveness_tests, liveness_forget_and_capacity) {
+	const uint32_t NB_DEVICES = 1000;
+	CGpLivenessTracker tracker(NB_DEVICES, t0);
+	CGpLivenessReport report;
+	for (uint32_t sourceId = 1; sourceId <= NB_DEVICES + 1; sourceId++) {
+		tracker.heard(sourceId, at(0), report);
+	}
+	if (tracker.getNbTracked() != NB_DEVICES || tracker.getNbUntracked() != 1 || tracker.isOnline(NB_DEVICES + 1)) {
+		FAILF("Devices above the capacity should not be tracked");
+	}
+	/* Forgetting every other device must keep all others reachable in the index */
+	for (uint32_t sourceId = 1; sourceId <= NB_DEVICES; sourceId += 2) {
+		if (!tracker.forget(sourceId)) {
+			FAILF("Source ID %u should have been forgotten", sourceId);
+		}
+	}
+	for (uint32_t sourceId = 1; sourceId <= NB_DEVICES; sourceId++) {
+		if (tracker.isOnline(sourceId) != (sourceId % 2 == 0)) {
+			FAILF("Wrong tracking of source ID %u after removals", sourceId);
+		}
+	}
+	if (tracker.forget(1) || tracker.getNbTracked() != NB_DEVICES / 2) {
+		FAILF("A forgotten device should not be tracked anymore");
+	}
+	/* Freed entries are reused, and forgotten devices never expire */
+	tracker.heard(NB_DEVICES + 1, at(0), report);
+	if (!tracker.isOnline(NB_DEVICES + 1)) {
+		FAILF("Entries of forgotten devices should be reused");
+	}
+	std::vector<CGpLivenessReport> reports;
+	tracker.expire(at(2 * 3600 * 1000), reports);
+	if (reports.size() != NB_DEVICES / 2 + 1 || tracker.getNbOffline() != NB_DEVICES / 2 + 1) {
+		FAILF("Only tracked devices should expire, got %zu", reports.size());
+	}
+	tracker.forgetAll();
+	if (tracker.getNbTracked() != 0 || tracker.getNbOffline() != 0 || tracker.hasDeadlines() || tracker.isOnline(2)) {
+		FAILF("No device should be tracked anymore");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_liveness_tests, liveness_benchmark) {
+	const uint32_t NB_DEVICES = 100000;
+	const unsigned int NB_ROUNDS = 10;
+	CGpLivenessTracker tracker(NB_DEVICES, t0);
+	CGpLivenessReport report;
+	std::vector<CGpLivenessReport> reports;
+	/* Each device reports every 60s, at its own phase. One tick is 1s */
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	for (unsigned int round = 0; round < NB_ROUNDS; round++) {
+		for (uint32_t sourceId = 1; sourceId <= NB_DEVICES; sourceId++) {
+			uint64_t now = (round * 60 + sourceId % 60) * 1000;
+			tracker.heard(sourceId, at(now), report);
+		}
+		tracker.expire(at((round * 60 + 59) * 1000), reports);
+	}
+	std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+	if (!reports.empty() || tracker.getNbTracked() != NB_DEVICES || tracker.getPeriod(NB_DEVICES) != std::chrono::seconds(60)) {
+		FAILF("No device should be offline while reporting");
+	}
+	tracker.expire(at((NB_ROUNDS * 60 + 180) * 1000), reports);
+	if (reports.size() != NB_DEVICES) {
+		FAILF("All devices should be offline after missing 3 reports, got %zu", reports.size());
+	}
+	std::cout << "Liveness of " << NB_DEVICES << " GP devices: " << elapsed.count() / (NB_DEVICES * NB_ROUNDS) << "ns per frame, "
+	          << CGpLivenessTracker::getBytesPerDevice() << " bytes per device\n";
+	NOTIFYPASS();
+}
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_liveness() {
+	liveness_offline_and_recovery();
+	liveness_wheel_levels();
+	liveness_forget_and_capacity();
+	liveness_benchmark();
+}
+#endif	// USE_CPPUTEST
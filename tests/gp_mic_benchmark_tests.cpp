@@ -0,0 +1,397 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <chrono>
+#include <memory>
+#include <map>
+#include <cstdint>
+#include <cstring>
+
+#include "spi/ByteBuffer.h"
+#include "spi/Logger.h"
+#include "spi/ILogger.h"
+#include "ezsp/zbmessage/green-power-frame.h"
+#include "ezsp/zigbee-tools/green-power-device-db.h"
+#include "spi/AesBuilder.h"
+
+#include "TestHarness.h"
+
+using NSSPI::Logger;
+using NSSPI::LOG_LEVEL;
+
+namespace {
+/* The secured GP frame and key also used in green_power_frame_tests.cpp (source ID 0x0054000a) */
+const NSSPI::ByteBuffer knownEzspMsg({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x02, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0xa2, 0xb5, 0x92, 0x23, 0x4e, 0x00, 0x11, 0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30});
+const uint32_t knownSourceId = 0x0054000a;
+const NSEZSP::EmberKeyData knownKey({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5F});
+const unsigned int SOURCE_ID_OFFSET = 4;	/* Offset of the little endian source ID in knownEzspMsg */
+const unsigned int SECURITY_LEVEL_OFFSET = 13;	/* Offset of the security level in knownEzspMsg */
+const unsigned int PAYLOAD_LENGTH_OFFSET = 27;	/* Offset of the payload length in knownEzspMsg (the payload follows) */
+
+/**
+ * @brief Forge the EZSP incoming GP frame message for another source ID, based on knownEzspMsg
+ *
+ * @note The MIC enclosed in the resulting frame is only valid for knownSourceId and knownKey
+ */
+NSSPI::ByteBuffer forgeEzspMsg(uint32_t sourceId) {
+	NSSPI::ByteBuffer ezspMsg(knownEzspMsg);
+	ezspMsg[SOURCE_ID_OFFSET] = static_cast<uint8_t>(sourceId & 0xffU);
+	ezspMsg[SOURCE_ID_OFFSET + 1] = static_cast<uint8_t>((sourceId >> 8) & 0xffU);
+	ezspMsg[SOURCE_ID_OFFSET + 2] = static_cast<uint8_t>((sourceId >> 16) & 0xffU);
+	ezspMsg[SOURCE_ID_OFFSET + 3] = static_cast<uint8_t>((sourceId >> 24) & 0xffU);
+	return ezspMsg;
+}
+
+/**
+ * @brief Evict the CPU data caches by writing then reading a buffer larger than the last level cache
+ */
+void evictCaches() {
+	static std::vector<uint8_t> evictionBuffer(64 * 1024 * 1024);
+	static volatile uint8_t sink = 0;
+	uint8_t sum = 0;
+	for (std::size_t i = 0; i < evictionBuffer.size(); i += 64) {
+		evictionBuffer[i] = static_cast<uint8_t>(i);
+	}
+	for (std::size_t i = 0; i < evictionBuffer.size(); i += 64) {
+		sum = static_cast<uint8_t>(sum + evictionBuffer[i]);
+	}
+	sink = sum;
+}
+}
+
+TEST_GROUP(gp_mic_benchmark_tests) {
+};
+
+TEST(gp_mic_benchmark_tests, device_db_expanded_key_cache) {
+	const NSEZSP::EmberKeyData wrongKey({0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf});
+	NSEZSP::CGpFrame gpf(knownEzspMsg);
+	NSEZSP::CGPDeviceDb db(2);
+
+	if (db.getExpandedKeyForSourceId(knownSourceId) != nullptr) {
+		FAILF("No key schedule should be found in an empty database");
+	}
+	db.insertDevice(knownSourceId, wrongKey);
+	const NSSPI::IAes::ExpandedKey* expandedKey = db.getExpandedKeyForSourceId(knownSourceId);
+	if (expandedKey == nullptr || gpf.validateMIC(*expandedKey)) {
+		FAILF("Key schedule of a wrong key should be found in the database but should not validate the frame");
+	}
+	db.insertDevice(knownSourceId, knownKey);	/* Overwriting the key should also replace its key schedule */
+	expandedKey = db.getExpandedKeyForSourceId(knownSourceId);
+	if (expandedKey == nullptr || !gpf.validateMIC(*expandedKey)) {
+		FAILF("Key schedule should have been recomputed when overwriting the key");
+	}
+	db.setDb({ NSEZSP::CGpDevice(0x01000000, wrongKey), NSEZSP::CGpDevice(knownSourceId, knownKey) });
+	expandedKey = db.getExpandedKeyForSourceId(knownSourceId);
+	if (expandedKey == nullptr || !gpf.validateMIC(*expandedKey)) {
+		FAILF("Key schedule should have been computed by setDb()");
+	}
+	db.removeDevice(knownSourceId);
+	if (db.getExpandedKeyForSourceId(knownSourceId) != nullptr) {
+		FAILF("Key schedule should not be found anymore after removing the device");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_mic_benchmark_tests, device_db_matches_reference) {
+	/* Random inserts, overwrites and removals in a narrow source ID range (lots of collisions and probe sequence wrap-arounds), checked against a std::map */
+	static constexpr unsigned int NB_OPERATIONS = 20000;
+	static constexpr unsigned int NB_SOURCE_IDS = 300;
+	std::mt19937 rng(0xdb);
+	std::map<uint32_t, NSEZSP::EmberKeyData> reference;
+	NSEZSP::CGPDeviceDb db(NB_SOURCE_IDS);
+
+	for (unsigned int operation = 0; operation < NB_OPERATIONS; operation++) {
+		uint32_t sourceId = 1 + static_cast<uint32_t>(rng() % NB_SOURCE_IDS);
+		if (rng() % 3 == 0) {
+			bool removed = db.removeDevice(sourceId);
+			if (removed != (reference.erase(sourceId) != 0)) {
+				FAILF("Unexpected result when removing source ID 0x%08x", sourceId);
+			}
+		}
+		else {
+			NSEZSP::EmberKeyData key(knownKey);
+			key[0] = static_cast<uint8_t>(operation & 0xffU);
+			key[1] = static_cast<uint8_t>((operation >> 8) & 0xffU);
+			if (!db.insertDevice(sourceId, key)) {
+				FAILF("Could not insert source ID 0x%08x", sourceId);
+			}
+			reference[sourceId] = key;
+			if (operation % 7 == 0) {
+				db.setFrameCounter(sourceId, operation);
+			}
+		}
+		if (db.size() != reference.size()) {
+			FAILF("Database contains %zu devices, expected %zu", db.size(), reference.size());
+		}
+	}
+	for (uint32_t sourceId = 0; sourceId <= NB_SOURCE_IDS + 1; sourceId++) {
+		NSEZSP::CGPDeviceDb::Lookup device = db.lookup(sourceId);
+		auto expected = reference.find(sourceId);
+		if (device.found() != (expected != reference.end())) {
+			FAILF("Source ID 0x%08x should %sbe in the database", sourceId, (expected != reference.end()) ? "" : "not ");
+		}
+		if (!device.found()) {
+			continue;
+		}
+		NSSPI::IAes::ExpandedKey expandedKey;
+		NSSPI::AesBuilder::shared().expand_key(expected->second, expandedKey);
+		if (*device.key != expected->second || memcmp(device.expandedKey->round_keys, expandedKey.round_keys, sizeof(expandedKey.round_keys)) != 0) {
+			FAILF("Wrong key or key schedule for source ID 0x%08x", sourceId);
+		}
+	}
+	if (db.insertDevice(0x00000000, knownKey) || db.lookup(0x00000000).found()) {
+		FAILF("Source ID 0x00000000 should not be accepted");
+	}
+	db.clear();
+	if (db.size() != 0 || db.lookup(1).found()) {
+		FAILF("Database should be empty after clear()");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_mic_benchmark_tests, device_db_frame_counters) {
+	typedef NSEZSP::CGPDeviceDb::FrameCounterCheck Check;
+	NSEZSP::CGPDeviceDb db(2);
+
+	if (db.acceptFrameCounter(knownSourceId, 1) != Check::UNKNOWN_DEVICE) {
+		FAILF("Frame counter of an unknown device should not be accepted");
+	}
+	db.insertDevice(knownSourceId, knownKey);
+	if (db.acceptFrameCounter(knownSourceId, 0) != Check::FRESH || db.lookup(knownSourceId).nextFrameCounter != 1) {
+		FAILF("First frame counter of a new device should be accepted");
+	}
+	if (db.acceptFrameCounter(knownSourceId, 10) != Check::FRESH) {
+		FAILF("Frame counters may skip values (frames lost)");
+	}
+	if (db.acceptFrameCounter(knownSourceId, 10) != Check::DUPLICATE) {
+		FAILF("Same frame counter should be reported as a duplicate");
+	}
+	if (db.acceptFrameCounter(knownSourceId, 9) != Check::REPLAY || db.acceptFrameCounter(knownSourceId, 0) != Check::REPLAY) {
+		FAILF("Older frame counters should be reported as replays");
+	}
+	if (db.lookup(knownSourceId).nextFrameCounter != 11 || NSEZSP::CGPDeviceDb::checkFrameCounter(11, 11) != Check::FRESH) {
+		FAILF("Rejected frame counters should not modify the database");
+	}
+	db.setFrameCounter(knownSourceId, 0xffffffff);
+	if (db.acceptFrameCounter(knownSourceId, 0xffffffff) != Check::REPLAY || db.acceptFrameCounter(knownSourceId, 0) != Check::REPLAY) {
+		FAILF("No frame should be accepted once the frame counter is exhausted");
+	}
+	db.insertDevice(knownSourceId, knownKey);	/* Re-commissioning a device (new key) restarts its frame counter */
+	if (db.acceptFrameCounter(knownSourceId, 0) != Check::FRESH) {
+		FAILF("A re-commissioned device should start again from frame counter 0");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_mic_benchmark_tests, device_db_lookups_per_second) {
+	static const unsigned int nbDevicesList[] = { 1000, 100000, 1000000 };
+	static constexpr unsigned int NB_LOOKUPS = 1000000;
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+
+	for (unsigned int nbDevices : nbDevicesList) {
+		std::mt19937 rng(nbDevices);
+		std::vector<NSEZSP::CGpDevice> devices;
+		devices.reserve(nbDevices);
+		for (unsigned int index = 0; index < nbDevices; index++) {
+			devices.push_back(NSEZSP::CGpDevice(1 + static_cast<uint32_t>(rng() % 0xfffffffeU), knownKey));	/* Random source IDs, as in a real deployment */
+		}
+		NSEZSP::CGPDeviceDb db(nbDevices);
+		db.setDb(devices);
+
+		/* Look up known source IDs in random order (as frames are received), half of the frames coming from unknown devices */
+		std::vector<uint32_t> sourceIds;
+		sourceIds.reserve(NB_LOOKUPS);
+		for (unsigned int lookup = 0; lookup < NB_LOOKUPS; lookup++) {
+			sourceIds.push_back((lookup % 2) ? devices[rng() % nbDevices].getSourceId() : (1 + static_cast<uint32_t>(rng() % 0xfffffffeU)));
+		}
+		unsigned int nbFound = 0;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (uint32_t sourceId : sourceIds) {
+			NSEZSP::CGPDeviceDb::Lookup device = db.lookup(sourceId);
+			if (device.found()) {
+				nbFound++;
+			}
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (nbFound < NB_LOOKUPS / 2) {
+			FAILF("Expected at least %u source IDs to be found, got %u", NB_LOOKUPS / 2, nbFound);
+		}
+		std::cout << "GP device database with " << std::setfill(' ') << std::setw(7) << std::dec << db.size() << " devices: "
+		          << std::fixed << std::setprecision(0) << (NB_LOOKUPS / seconds) << " lookups/s, "
+		          << std::setprecision(1) << (static_cast<double>(db.memoryFootprint()) / db.size()) << " bytes/device\n";
+		std::cout.unsetf(std::ios_base::floatfield);
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_mic_benchmark_tests, batch_validation_matches_single) {
+	const NSEZSP::EmberKeyData wrongKey({0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf});
+	NSSPI::IAes::ExpandedKey knownExpandedKey;
+	NSSPI::IAes::ExpandedKey wrongExpandedKey;
+	NSSPI::AesBuilder::shared().expand_key(knownKey, knownExpandedKey);
+	NSSPI::AesBuilder::shared().expand_key(wrongKey, wrongExpandedKey);
+
+	/* Mix valid frames, frames with a wrong key, no key, an unsupported security level, and payloads of various lengths (thus a various number of AES-CBC blocks) */
+	std::vector<NSEZSP::CGpFrame> frames;
+	std::vector<const NSSPI::IAes::ExpandedKey*> keys;
+	for (unsigned int index = 0; index < 37; index++) {	/* Not a multiple of CGpFrame::MIC_BATCH_LANES */
+		NSSPI::ByteBuffer ezspMsg(knownEzspMsg);
+		const NSSPI::IAes::ExpandedKey* key = &knownExpandedKey;
+		switch (index % 5) {
+		case 1:
+			key = &wrongExpandedKey;
+			break;
+		case 2:
+			key = nullptr;
+			break;
+		case 3:
+			ezspMsg[SECURITY_LEVEL_OFFSET] = 0x00;	/* No security */
+			break;
+		case 4: {
+			uint8_t payloadLength = static_cast<uint8_t>(index % (knownEzspMsg[PAYLOAD_LENGTH_OFFSET] + 1));
+			ezspMsg.resize(PAYLOAD_LENGTH_OFFSET + 1 + payloadLength);
+			ezspMsg[PAYLOAD_LENGTH_OFFSET] = payloadLength;
+		}
+		break;
+		default:
+			break;
+		}
+		frames.push_back(NSEZSP::CGpFrame(ezspMsg));
+		keys.push_back(key);
+	}
+
+	for (std::size_t count = 0; count <= frames.size(); count++) {
+		std::vector<const NSEZSP::CGpFrame*> framePtrs;
+		for (std::size_t i = 0; i < count; i++) {
+			framePtrs.push_back(&frames[i]);
+		}
+		std::unique_ptr<bool[]> results(new bool[count + 1]);
+		NSEZSP::CGpFrame::validateMICBatch(framePtrs.data(), keys.data(), count, results.get());
+		unsigned int nbValid = 0;
+		for (std::size_t i = 0; i < count; i++) {
+			bool expected = (keys[i] != nullptr && frames[i].validateMIC(*keys[i]));
+			if (results[i] != expected) {
+				FAILF("Batch MIC validation of frame %zu out of %zu differs from single frame validation", i, count);
+			}
+			if (results[i]) {
+				nbValid++;
+			}
+		}
+		if (count == frames.size() && nbValid != 8) {	/* Indexes 0, 5, 10... 35 */
+			FAILF("Expected 8 frames with a valid MIC, got %u", nbValid);
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_mic_benchmark_tests, mic_validations_per_second) {
+	static constexpr unsigned int NB_DEVICES = 10000;
+	static constexpr unsigned int NB_PASSES = 5;
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);	/* Same log level as a production gateway */
+
+	/* 10k devices with distinct source IDs and keys, one of them being the device that sent knownEzspMsg (so its MIC validates) */
+	std::vector<NSEZSP::CGpDevice> devices;
+	std::vector<NSEZSP::CGpFrame> frames;
+	devices.reserve(NB_DEVICES);
+	frames.reserve(NB_DEVICES);
+	for (unsigned int index = 0; index < NB_DEVICES - 1; index++) {
+		uint32_t sourceId = 0x01000000 + index;
+		NSEZSP::EmberKeyData key(knownKey);
+		key[0] = static_cast<uint8_t>(index & 0xffU);
+		key[1] = static_cast<uint8_t>((index >> 8) & 0xffU);
+		devices.push_back(NSEZSP::CGpDevice(sourceId, key));
+		frames.push_back(NSEZSP::CGpFrame(forgeEzspMsg(sourceId)));
+	}
+	devices.push_back(NSEZSP::CGpDevice(knownSourceId, knownKey));
+	frames.push_back(NSEZSP::CGpFrame(knownEzspMsg));
+	/* Frames are received in random order, so that consecutive lookups do not hit neighbouring database entries */
+	std::shuffle(frames.begin(), frames.end(), std::mt19937(0x5eed));
+
+	NSEZSP::CGPDeviceDb db(NB_DEVICES);
+	db.setDb(devices);
+
+	enum class Mode { KEY_EXPANSION_PER_FRAME, CACHED_KEY_SCHEDULE_COLD, CACHED_KEY_SCHEDULE_WARM, BATCHED_COLD, BATCHED_WARM };
+	auto runPass = [&frames, &db](Mode mode) -> unsigned int {
+		unsigned int nbValid = 0;
+		if (mode == Mode::BATCHED_COLD || mode == Mode::BATCHED_WARM) {
+			/* Frames are validated by groups of MIC_BATCH_LANES, as CGpSink does for frames received in one serial read */
+			for (std::size_t first = 0; first < frames.size(); first += NSEZSP::CGpFrame::MIC_BATCH_LANES) {
+				const NSEZSP::CGpFrame* batchFrames[NSEZSP::CGpFrame::MIC_BATCH_LANES];
+				const NSSPI::IAes::ExpandedKey* batchKeys[NSEZSP::CGpFrame::MIC_BATCH_LANES];
+				bool batchResults[NSEZSP::CGpFrame::MIC_BATCH_LANES];
+				std::size_t batchSize = std::min(frames.size() - first, static_cast<std::size_t>(NSEZSP::CGpFrame::MIC_BATCH_LANES));
+				for (std::size_t i = 0; i < batchSize; i++) {
+					batchFrames[i] = &frames[first + i];
+					batchKeys[i] = db.getExpandedKeyForSourceId(frames[first + i].getSourceId());
+				}
+				NSEZSP::CGpFrame::validateMICBatch(batchFrames, batchKeys, batchSize, batchResults);
+				for (std::size_t i = 0; i < batchSize; i++) {
+					if (batchResults[i]) {
+						nbValid++;
+					}
+				}
+			}
+			return nbValid;
+		}
+		for (const NSEZSP::CGpFrame& gpf : frames) {
+			if (mode == Mode::KEY_EXPANSION_PER_FRAME) {
+				NSEZSP::EmberKeyData key;
+				if (db.getKeyForSourceId(gpf.getSourceId(), key) && gpf.validateMIC(key)) {
+					nbValid++;
+				}
+			}
+			else {
+				const NSSPI::IAes::ExpandedKey* expandedKey = db.getExpandedKeyForSourceId(gpf.getSourceId());
+				if (expandedKey != nullptr && gpf.validateMIC(*expandedKey)) {
+					nbValid++;
+				}
+			}
+		}
+		return nbValid;
+	};
+
+	const struct {
+		Mode mode;
+		const char* label;
+	} cases[] = {
+		{ Mode::KEY_EXPANSION_PER_FRAME, "key expansion per frame, cold cache" },
+		{ Mode::CACHED_KEY_SCHEDULE_COLD, "cached key schedules, cold cache" },
+		{ Mode::CACHED_KEY_SCHEDULE_WARM, "cached key schedules, warm cache" },
+		{ Mode::BATCHED_COLD, "cached key schedules, batched, cold cache" },
+		{ Mode::BATCHED_WARM, "cached key schedules, batched, warm cache" },
+	};
+	for (const auto& c : cases) {
+		runPass(c.mode);	/* Warm up the code path (and, in warm cache mode, the data) */
+		std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::duration::zero();
+		for (unsigned int pass = 0; pass < NB_PASSES; pass++) {
+			if (c.mode != Mode::CACHED_KEY_SCHEDULE_WARM && c.mode != Mode::BATCHED_WARM) {
+				evictCaches();
+			}
+			std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+			unsigned int nbValid = runPass(c.mode);
+			elapsed += std::chrono::steady_clock::now() - start;
+			if (nbValid != 1) {
+				FAILF("Expected exactly one frame with a valid MIC (%s), got %u", c.label, nbValid);
+			}
+		}
+		double seconds = std::chrono::duration<double>(elapsed).count();
+		std::cout << "MIC validations for " << std::dec << NB_DEVICES << " source IDs (" << c.label << "): "
+		          << std::fixed << std::setprecision(0) << (NB_PASSES * NB_DEVICES / seconds) << " frames/s\n";
+		std::cout.unsetf(std::ios_base::floatfield);
+	}
+	NOTIFYPASS();
+}
+
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_mic_benchmark() {
+	device_db_expanded_key_cache();
+	device_db_matches_reference();
+	device_db_frame_counters();
+	device_db_lookups_per_second();
+	batch_validation_matches_single();
+	mic_validations_per_second();
+}
+#endif	// USE_CPPUTEST
@@ -0,0 +1,345 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <cstdint>
+
+#include "spi/TimerBuilder.h"
+#include "spi/ByteBuffer.h"
+#include "spi/Logger.h"
+#include "spi/ILogger.h"
+#include "spi/AesBuilder.h"
+#include "ezsp/zbmessage/green-power-frame.h"
+#include "ezsp/zigbee-tools/green-power-mic-validation-pool.h"
+#ifdef USE_BUILTIN_MIC_PROCESSING
+#include "ezsp/ezsp-dongle.h"
+#include "ezsp/zigbee-tools/zigbee-messaging.h"
+#include "ezsp/zigbee-tools/green-power-sink.h"
+#include "ezsp/ezsp.h"
+#endif
+
+#include "TestHarness.h"
+
+using NSSPI::Logger;
+using NSSPI::LOG_LEVEL;
+
+#ifdef USE_CPPTHREADS
+using NSEZSP::CGpMicValidationPool;
+
+namespace {
+/* The secured GP frame also used in green_power_frame_tests.cpp (source ID 0x0054000a, security level 2) */
+const NSSPI::ByteBuffer knownEzspMsg({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x02, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0xa2, 0xb5, 0x92, 0x23, 0x4e, 0x00, 0x11, 0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30});
+const NSEZSP::EmberKeyData knownKey({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5F});
+const unsigned int SOURCE_ID_OFFSET = 4;	/* Offset of the little endian source ID in knownEzspMsg */
+const unsigned int FRAME_COUNTER_OFFSET = 17;	/* Offset of the little endian security frame counter in knownEzspMsg */
+const unsigned int MIC_OFFSET = 22;	/* Offset of the little endian MIC in knownEzspMsg */
+
+void putU32le(NSSPI::ByteBuffer& buffer, unsigned int offset, uint32_t value) {
+	for (unsigned int i = 0; i < 4; i++) {
+		buffer[offset + i] = static_cast<uint8_t>((value >> (8 * i)) & 0xffU);
+	}
+}
+
+/**
+ * @brief Compute the MIC of a security level 2 frame (AES-CCM* with a 4-byte MIC, see 09-5499-25, section A 1.5.4)
+ */
+uint32_t computeMic(const NSEZSP::CGpFrame& gpf, const NSEZSP::EmberKeyData& key) {
+	const NSSPI::IAes& aes = NSSPI::AesBuilder::shared();
+	NSSPI::IAes::ExpandedKey expandedKey;
+	aes.expand_key(key, expandedKey);
+
+	uint8_t nonce[13];
+	for (unsigned int i = 0; i < 4; i++) {
+		nonce[i] = nonce[4 + i] = static_cast<uint8_t>(gpf.getSourceId() >> (8 * i));
+		nonce[8 + i] = static_cast<uint8_t>(gpf.getSecurityFrameCounter() >> (8 * i));
+	}
+	nonce[12] = 0x05;
+
+	std::vector<uint8_t> a;
+	a.push_back(static_cast<uint8_t>(0x8c | (gpf.isAutoCommissioning() ? 0x40 : 0x00)));
+	a.push_back(static_cast<uint8_t>((gpf.getApplicationId() & 0x07) | ((static_cast<uint8_t>(gpf.getSecurity()) & 0x03) << 3)
+	                                 | (gpf.getKeyType() != NSEZSP::EGpSecurityKeyType::GPD_KEY_TYPE_NO_KEY ? 0x20 : 0x00)
+	                                 | (gpf.isRxAfterTx() ? 0x40 : 0x00)));
+	for (unsigned int i = 0; i < 4; i++) {
+		a.push_back(static_cast<uint8_t>(gpf.getSourceId() >> (8 * i)));
+	}
+	for (unsigned int i = 0; i < 4; i++) {
+		a.push_back(static_cast<uint8_t>(gpf.getSecurityFrameCounter() >> (8 * i)));
+	}
+	a.push_back(gpf.getCommandId());
+	NSSPI::ByteView payload = gpf.getPayloadView();
+	a.insert(a.end(), payload.begin(), payload.end());
+
+	std::vector<uint8_t> blocks;
+	blocks.push_back(static_cast<uint8_t>(a.size() >> 8));
+	blocks.push_back(static_cast<uint8_t>(a.size() & 0xff));
+	blocks.insert(blocks.end(), a.begin(), a.end());
+	blocks.resize((blocks.size() + 15) / 16 * 16, 0x00);
+
+	uint8_t x[16] = { 0x49 };	/* B0: flags, nonce, empty plain text */
+	std::copy(nonce, nonce + 13, x + 1);
+	aes.encrypt(expandedKey, x, x);
+	for (std::size_t block = 0; block < blocks.size(); block += 16) {
+		for (unsigned int i = 0; i < 16; i++) {
+			x[i] ^= blocks[block + i];
+		}
+		aes.encrypt(expandedKey, x, x);
+	}
+	uint8_t a0[16] = { 0x01 };
+	std::copy(nonce, nonce + 13, a0 + 1);
+	aes.encrypt(expandedKey, a0, a0);
+	uint32_t mic = 0;
+	for (unsigned int i = 0; i < 4; i++) {
+		mic |= static_cast<uint32_t>(x[i] ^ a0[i]) << (8 * i);
+	}
+	return mic;
+}
+
+/**
+ * @brief Forge an EZSP incoming GP frame message from another source ID and frame counter, based on knownEzspMsg
+ *
+ * @param sourceId The source ID
+ * @param frameCounter The security frame counter
+ * @param validMic Sign the frame with knownKey (otherwise the MIC is wrong)
+ */
+NSSPI::ByteBuffer forgeEzspMsg(uint32_t sourceId, uint32_t frameCounter, bool validMic) {
+	NSSPI::ByteBuffer ezspMsg(knownEzspMsg);
+	ezspMsg[0] = 0xAD;	/* Not authenticated by the adapter */
+	putU32le(ezspMsg, SOURCE_ID_OFFSET, sourceId);
+	putU32le(ezspMsg, FRAME_COUNTER_OFFSET, frameCounter);
+	uint32_t mic = computeMic(NSEZSP::CGpFrame(ezspMsg), knownKey);
+	putU32le(ezspMsg, MIC_OFFSET, validMic ? mic : ~mic);
+	return ezspMsg;
+}
+
+/**
+ * @brief Synthetic traffic: frames from several source IDs, with valid and invalid MICs
+ */
+struct SyntheticTraffic {
+	explicit SyntheticTraffic(std::size_t nbFrames) :
+		frames(),
+		expected(),
+		expandedKey() {
+		NSSPI::AesBuilder::shared().expand_key(knownKey, this->expandedKey);
+		NSSPI::ByteBuffer valid(forgeEzspMsg(0x0200000a, 1, true));
+		NSSPI::ByteBuffer invalid(forgeEzspMsg(0x0200000a, 1, false));
+		this->frames.reserve(nbFrames);
+		for (std::size_t i = 0; i < nbFrames; i++) {
+			/* Frames are not re-signed for each source ID: this is about MIC validation cost and result placement, not about authenticity */
+			this->expected.push_back(i % 3 != 0);
+			this->frames.push_back(NSEZSP::CGpFrame(this->expected.back() ? valid : invalid));
+		}
+	}
+
+	std::vector<NSEZSP::CGpFrame> frames;
+	std::vector<bool> expected;
+	NSSPI::IAes::ExpandedKey expandedKey;
+};
+}
+
+TEST_GROUP(gp_mic_pool_tests) {
+};
+
+TEST(gp_mic_pool_tests, pool_results_match_serial_validation) {
+	SyntheticTraffic traffic(203);	/* Not a multiple of the chunk size */
+	std::vector<const NSEZSP::CGpFrame*> frames;
+	std::vector<const NSSPI::IAes::ExpandedKey*> keys;
+	for (std::size_t i = 0; i < traffic.frames.size(); i++) {
+		frames.push_back(&traffic.frames[i]);
+		keys.push_back((i % 17 == 5) ? nullptr : &traffic.expandedKey);	/* Unknown devices */
+	}
+
+	CGpMicValidationPool pool(3);
+	if (pool.getNbWorkers() != 3) {
+		FAILF("Unexpected number of workers: %u", pool.getNbWorkers());
+	}
+	for (std::size_t count : { static_cast<std::size_t>(0), static_cast<std::size_t>(1), static_cast<std::size_t>(NSEZSP::CGpFrame::MIC_BATCH_LANES + 1), frames.size() }) {
+		bool poolResults[203];
+		bool serialResults[203];
+		pool.validateMICs(frames.data(), keys.data(), count, poolResults);
+		NSEZSP::CGpFrame::validateMICBatch(frames.data(), keys.data(), count, serialResults);
+		for (std::size_t i = 0; i < count; i++) {
+			if (poolResults[i] != serialResults[i] || poolResults[i] != (traffic.expected[i] && keys[i] != nullptr)) {
+				FAILF("Wrong result for frame %zu out of %zu", i, count);
+			}
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_mic_pool_tests, pool_concurrent_callers) {
+	constexpr unsigned int NB_CALLERS = 4;
+	constexpr std::size_t BURST = 32;
+	SyntheticTraffic traffic(NB_CALLERS * 40 * BURST);
+	CGpMicValidationPool pool(2);
+	std::vector<unsigned int> nbErrors(NB_CALLERS, 0);
+	std::vector<std::thread> callers;
+	for (unsigned int caller = 0; caller < NB_CALLERS; caller++) {
+		callers.emplace_back([&traffic, &pool, &nbErrors, caller]() {
+			for (std::size_t first = caller * BURST; first < traffic.frames.size(); first += NB_CALLERS * BURST) {
+				const NSEZSP::CGpFrame* frames[BURST];
+				const NSSPI::IAes::ExpandedKey* keys[BURST];
+				bool results[BURST];
+				for (std::size_t i = 0; i < BURST; i++) {
+					frames[i] = &traffic.frames[first + i];
+					keys[i] = &traffic.expandedKey;
+				}
+				pool.validateMICs(frames, keys, BURST, results);
+				for (std::size_t i = 0; i < BURST; i++) {
+					if (results[i] != traffic.expected[first + i]) {
+						nbErrors[caller]++;
+					}
+				}
+			}
+		});
+	}
+	for (std::thread& caller : callers) {
+		caller.join();
+	}
+	for (unsigned int caller = 0; caller < NB_CALLERS; caller++) {
+		if (nbErrors[caller] != 0) {
+			FAILF("Caller %u got %u wrong results", caller, nbErrors[caller]);
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_mic_pool_tests, pool_scaling_benchmark) {
+	const unsigned int NB_ADAPTERS = 4;	/* Threads submitting bursts of frames, as the RX threads of 4 adapters would */
+	constexpr std::size_t BURST = 32;
+	constexpr std::size_t NB_BURSTS = 200;
+	SyntheticTraffic traffic(BURST);
+	for (unsigned int nbWorkers : { 0U, 1U, 2U, 4U, 8U }) {
+		CGpMicValidationPool pool(nbWorkers);
+		std::vector<std::thread> adapters;
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned int adapter = 0; adapter < NB_ADAPTERS; adapter++) {
+			adapters.emplace_back([&traffic, &pool]() {
+				const NSEZSP::CGpFrame* frames[BURST];
+				const NSSPI::IAes::ExpandedKey* keys[BURST];
+				bool results[BURST];
+				for (std::size_t i = 0; i < BURST; i++) {
+					frames[i] = &traffic.frames[i];
+					keys[i] = &traffic.expandedKey;
+				}
+				for (std::size_t burst = 0; burst < NB_BURSTS; burst++) {
+					pool.validateMICs(frames, keys, BURST, results);
+				}
+			});
+		}
+		for (std::thread& adapter : adapters) {
+			adapter.join();
+		}
+		double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		std::cout << "MIC validations from " << std::dec << NB_ADAPTERS << " adapters with " << nbWorkers << " shared workers ("
+		          << std::thread::hardware_concurrency() << " cores): " << std::fixed << std::setprecision(0)
+		          << (NB_ADAPTERS * NB_BURSTS * BURST / seconds) << " frames/s\n";
+		std::cout.unsetf(std::ios_base::floatfield);
+	}
+	NOTIFYPASS();
+}
+
+#ifdef USE_BUILTIN_MIC_PROCESSING
+namespace {
+/**
+ * @brief Observer recording authenticated frames
+ */
+class FrameOrderObserver : public NSEZSP::CGpObserver {
+public:
+	void handleRxGpFrame(const NSEZSP::CGpFrameView& i_gpf) override {
+		this->frames.push_back(std::make_pair(i_gpf.getSourceId(), i_gpf.getSecurityFrameCounter()));
+	}
+
+	void handleRxGpdId(uint32_t& i_gpd_id, bool i_gpd_known, NSEZSP::CGpdKeyStatus i_gpd_key_status) override {
+	}
+
+	std::vector<std::pair<uint32_t, uint32_t>> frames;
+};
+}
+
+TEST(gp_mic_pool_tests, shared_pool_keeps_source_order) {
+	const unsigned int NB_ADAPTERS = 2;
+	const unsigned int NB_SOURCES = 8;
+	const unsigned int NB_FRAMES_PER_SOURCE = 50;
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+
+	NSEZSP::CGpFrame reference(knownEzspMsg);
+	if (computeMic(reference, knownKey) != reference.getMic()) {
+		FAILF("MIC computation of the test does not match the reference frame");
+	}
+
+	/* Traffic of each adapter, sources interleaved, frame counters increasing for each source */
+	std::vector<std::vector<NSSPI::ByteBuffer>> traffic(NB_ADAPTERS);
+	std::vector<std::vector<NSEZSP::CGpDevice>> devices(NB_ADAPTERS);
+	for (unsigned int adapter = 0; adapter < NB_ADAPTERS; adapter++) {
+		for (unsigned int source = 0; source < NB_SOURCES; source++) {
+			devices[adapter].push_back(NSEZSP::CGpDevice(0x03000000U + adapter * 0x100U + source, knownKey));
+		}
+		for (unsigned int counter = 1; counter <= NB_FRAMES_PER_SOURCE; counter++) {
+			for (unsigned int source = 0; source < NB_SOURCES; source++) {
+				traffic[adapter].push_back(forgeEzspMsg(devices[adapter][source].getSourceId(), counter, true));
+			}
+		}
+	}
+
+	if (!NSEZSP::CEzsp::setGPMicValidationWorkers(3)) {
+		FAILF("A shared pool should be available when MICs are processed on the host");
+	}
+	NSSPI::TimerBuilder timerBuilder;
+	std::vector<FrameOrderObserver> observers(NB_ADAPTERS);
+	std::vector<std::thread> rxThreads;
+	std::vector<std::size_t> nbDropped(NB_ADAPTERS, 0);
+	for (unsigned int adapter = 0; adapter < NB_ADAPTERS; adapter++) {
+		rxThreads.emplace_back([&timerBuilder, &traffic, &devices, &observers, &nbDropped, adapter]() {
+			NSEZSP::CEzspDongle dongle(timerBuilder);	/* Never opened: frames are directly injected into the sink */
+			NSEZSP::CZigbeeMessaging zbMessaging(dongle, timerBuilder);
+			NSEZSP::CGpSink sink(dongle, zbMessaging, timerBuilder, 16);
+			sink.registerObserver(&observers[adapter]);
+			sink.init();
+			/* Empty adapter tables: EMBER_INDEX_OUT_OF_RANGE at the first index of both tables ends their loading */
+			sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GP_SINK_TABLE_GET_ENTRY, { 0xB1 });
+			sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GP_PROXY_TABLE_GET_ENTRY, { 0xB1 });
+			sink.registerGpds(devices[adapter]);
+			for (const NSSPI::ByteBuffer& ezspMsg : traffic[adapter]) {
+				sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, ezspMsg);
+			}
+			sink.handleEzspRxBurstEnd();
+			nbDropped[adapter] = sink.getNbDroppedDuplicateRxGpFrames() + sink.getNbDroppedReplayedRxGpFrames();
+			sink.unregisterObserver(&observers[adapter]);
+		});
+	}
+	for (std::thread& rxThread : rxThreads) {
+		rxThread.join();
+	}
+	NSEZSP::CEzsp::setGPMicValidationWorkers(0);
+
+	for (unsigned int adapter = 0; adapter < NB_ADAPTERS; adapter++) {
+		const std::vector<std::pair<uint32_t, uint32_t>>& frames = observers[adapter].frames;
+		if (frames.size() != traffic[adapter].size() || nbDropped[adapter] != 0) {
+			FAILF("Adapter %u: %zu frames accepted out of %zu, %zu dropped", adapter, frames.size(), traffic[adapter].size(), nbDropped[adapter]);
+		}
+		for (std::size_t i = 0; i < frames.size(); i++) {
+			if (frames[i].first != devices[adapter][i % NB_SOURCES].getSourceId() || frames[i].second != i / NB_SOURCES + 1) {
+				FAILF("Adapter %u: frame %zu was not delivered in reception order", adapter, i);
+			}
+		}
+	}
+	NOTIFYPASS();
+}
+#endif	// USE_BUILTIN_MIC_PROCESSING
+#endif	// USE_CPPTHREADS
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_mic_pool() {
+#ifdef USE_CPPTHREADS
+	pool_results_match_serial_validation();
+	pool_concurrent_callers();
+	pool_scaling_benchmark();
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	shared_pool_keeps_source_order();
+#endif
+#endif
+}
+#endif	// USE_CPPUTEST
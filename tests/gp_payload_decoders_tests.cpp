@@ -0,0 +1,177 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "ezsp/zbmessage/green-power-payload-decoders.h"
+#include "ezsp/zbmessage/zcl.h"
+
+#include "TestHarness.h"
+
+using NSEZSP::CGpFrameView;
+using NSEZSP::CGpPayloadDecoders;
+
+namespace {
+/**
+ * @brief Forge an incoming ezsp raw message carrying a GPD command from source ID 0x01000001
+ */
+NSSPI::ByteBuffer forgeEzspMsg(uint8_t i_command_id, const NSSPI::ByteBuffer& i_payload) {
+	NSSPI::ByteBuffer msg({0x00, 0xde, 0x01, 0x00, 0x01, 0x00, 0x00, 0x01, 0x01, 0x00, 0x00, 0x01, 0x00, 0x02, 0x04, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00});
+	msg.push_back(i_command_id);
+	msg.append(NSSPI::ByteBuffer({0x00, 0x00, 0x00, 0x00, 0xff}));	/* MIC and proxy table entry */
+	msg.push_back(static_cast<uint8_t>(i_payload.size()));
+	msg.append(i_payload);
+	return msg;
+}
+
+/**
+ * @brief Records the decoded events
+ */
+class RecordingVisitor : public NSEZSP::CGpPayloadVisitor {
+public:
+	void handleOnOff(const CGpFrameView& i_gpf, NSEZSP::CGpOnOffAction i_action) override {
+		this->onOff.push_back(i_action);
+	}
+
+	void handleScene(const CGpFrameView& i_gpf, const NSEZSP::CGpSceneEvent& i_event) override {
+		this->scenes.push_back(i_event);
+	}
+
+	void handleAttributeReport(const CGpFrameView& i_gpf, const NSEZSP::CGpAttributeReport& i_report) override {
+		if (i_gpf.getSourceId() != 0x01000001 || i_report.value.data() < i_gpf.getPayloadView().begin() || i_report.value.end() > i_gpf.getPayloadView().end()) {
+			FAILF("Attribute values should point into the payload of the decoded frame");
+		}
+		this->reports.push_back(i_report);
+	}
+
+	void handleCustomEvent(const CGpFrameView& i_gpf, const NSEZSP::CGpCustomEvent& i_event) override {
+		this->customEvents.push_back(i_event);
+	}
+
+	std::vector<NSEZSP::CGpOnOffAction> onOff;
+	std::vector<NSEZSP::CGpSceneEvent> scenes;
+	std::vector<NSEZSP::CGpAttributeReport> reports;
+	std::vector<NSEZSP::CGpCustomEvent> customEvents;
+};
+
+/**
+ * @brief Decode a forged frame
+ */
+bool decode(const CGpPayloadDecoders& i_decoders, uint8_t i_command_id, const NSSPI::ByteBuffer& i_payload, RecordingVisitor& io_visitor) {
+	NSSPI::ByteBuffer msg = forgeEzspMsg(i_command_id, i_payload);
+	return i_decoders.decode(CGpFrameView(msg), io_visitor);
+}
+
+/**
+ * @brief A manufacturer-specific decoder: one custom event per payload byte, the event value is the byte
+ */
+bool decodeButtons(const CGpFrameView& i_gpf, NSEZSP::CGpPayloadVisitor& io_visitor) {
+	NSSPI::ByteView payload = i_gpf.getPayloadView();
+	if (payload.empty()) {
+		return false;
+	}
+	for (std::size_t i = 0; i < payload.size(); i++) {
+		io_visitor.handleCustomEvent(i_gpf, { 0x0001, payload[i], payload.subView(i, 1) });
+	}
+	return true;
+}
+}
+
+TEST_GROUP(gp_payload_decoders_tests) {
+};
+
+TEST(gp_payload_decoders_tests, payload_decoders_commands) {
+	CGpPayloadDecoders decoders;
+	RecordingVisitor visitor;
+	if (!decode(decoders, NSEZSP::NSGPF::GPF_OFF_CMD, { }, visitor) || !decode(decoders, NSEZSP::NSGPF::GPF_ON_CMD, { }, visitor) || !decode(decoders, NSEZSP::NSGPF::GPF_TOGGLE_CMD, { }, visitor)) {
+		FAILF("On/off commands should be decoded");
+	}
+	if (visitor.onOff != std::vector<NSEZSP::CGpOnOffAction>({ NSEZSP::CGpOnOffAction::Off, NSEZSP::CGpOnOffAction::On, NSEZSP::CGpOnOffAction::Toggle })) {
+		FAILF("Wrong on/off actions");
+	}
+	if (!decode(decoders, NSEZSP::NSGPF::GPF_SCENE_3_CMD, { }, visitor) || !decode(decoders, NSEZSP::NSGPF::GPF_STORE_SCENE_5_CMD, { }, visitor)) {
+		FAILF("Scene commands should be decoded");
+	}
+	if (visitor.scenes.size() != 2 || visitor.scenes[0].store || visitor.scenes[0].scene != 3 || !visitor.scenes[1].store || visitor.scenes[1].scene != 5) {
+		FAILF("Wrong scene events");
+	}
+	if (decode(decoders, NSEZSP::NSGPF::GPF_COMMISSIONING_CMD, { 0x02, 0x81 }, visitor) || decoders.hasDecoder(NSEZSP::NSGPF::GPF_COMMISSIONING_CMD) || !decoders.hasDecoder(NSEZSP::NSGPF::GPF_ON_CMD)) {
+		FAILF("Commands without a decoder should not be decoded");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_payload_decoders_tests, payload_decoders_attribute_reports) {
+	CGpPayloadDecoders decoders;
+	RecordingVisitor visitor;
+	/* Temperature 21.50°C and tolerance, in one report of cluster 0x0402 */
+	if (!decode(decoders, NSEZSP::NSGPF::GPF_ATTRIBUTE_REPORTING, { 0x02, 0x04, 0x00, 0x00, 0x29, 0x66, 0x08, 0x03, 0x00, 0x21, 0x0a, 0x00 }, visitor)) {
+		FAILF("Attribute reporting should be decoded");
+	}
+	if (visitor.reports.size() != 2 || visitor.reports[0].clusterId != 0x0402 || visitor.reports[0].attributeId != 0x0000
+	        || visitor.reports[0].type != NSEZSP::ZCL_INT16S_ATTRIBUTE_TYPE || static_cast<int16_t>(visitor.reports[0].rawValue) != 2150
+	        || visitor.reports[1].clusterId != 0x0402 || visitor.reports[1].attributeId != 0x0003 || visitor.reports[1].rawValue != 10
+	        || visitor.reports[0].manufacturerSpecific) {
+		FAILF("Wrong attribute reports");
+	}
+	visitor.reports.clear();
+	/* Negative temperature, humidity and firmware version string from several clusters */
+	if (!decode(decoders, NSEZSP::NSGPF::GPF_MULTI_CLUSTER_REPORTING, { 0x02, 0x04, 0x00, 0x00, 0x29, 0x06, 0xff, 0x05, 0x04, 0x00, 0x00, 0x21, 0x88, 0x13,
+	            0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30 }, visitor)) {
+		FAILF("Multi-cluster reporting should be decoded");
+	}
+	if (visitor.reports.size() != 3 || static_cast<int16_t>(visitor.reports[0].rawValue) != -250 || visitor.reports[1].clusterId != 0x0405
+	        || visitor.reports[1].rawValue != 5000 || visitor.reports[2].clusterId != 0x0000 || visitor.reports[2].attributeId != 0x4000
+	        || std::string(visitor.reports[2].value.begin(), visitor.reports[2].value.end()) != "1.0.0") {
+		FAILF("Wrong multi-cluster reports");
+	}
+	visitor.reports.clear();
+	/* The MSP secure channel request is a manufacturer-specific attribute report */
+	if (!decode(decoders, NSEZSP::NSGPF::GPF_MANUFACTURER_ATTRIBUTE_REPORTING, { 0x21, 0x10, 0x00, 0x00, 0x00, 0x50, 0x20, 0x07 }, visitor)
+	        || visitor.reports.size() != 1 || !visitor.reports[0].manufacturerSpecific || visitor.reports[0].manufacturerId != 0x1021
+	        || visitor.reports[0].clusterId != 0x0000 || visitor.reports[0].attributeId != 0x5000 || visitor.reports[0].rawValue != 0x07) {
+		FAILF("Wrong manufacturer-specific report");
+	}
+	visitor.reports.clear();
+
+	/* Malformed payloads */
+	if (decode(decoders, NSEZSP::NSGPF::GPF_ATTRIBUTE_REPORTING, { 0x02 }, visitor)
+	        || decode(decoders, NSEZSP::NSGPF::GPF_ATTRIBUTE_REPORTING, { 0x02, 0x04, 0x00, 0x00, 0x29, 0x66 }, visitor)
+	        || decode(decoders, NSEZSP::NSGPF::GPF_ATTRIBUTE_REPORTING, { 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31 }, visitor)
+	        || decode(decoders, NSEZSP::NSGPF::GPF_ATTRIBUTE_REPORTING, { 0x00, 0x00, 0x00, 0x00, 0x48, 0x20, 0x01, 0x00, 0x01 }, visitor)) {
+		FAILF("Truncated records and unsupported types should not be decoded");
+	}
+	if (!visitor.reports.empty()) {
+		FAILF("No event should come out of a malformed record");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_payload_decoders_tests, payload_decoders_custom) {
+	CGpPayloadDecoders decoders;
+	RecordingVisitor visitor;
+	decoders.registerDecoder(0xB5, &decodeButtons);
+	if (!decoders.hasDecoder(0xB5) || !decode(decoders, 0xB5, { 0x03, 0x81 }, visitor) || decode(decoders, 0xB5, { }, visitor)) {
+		FAILF("Registered decoders should be used");
+	}
+	if (visitor.customEvents.size() != 2 || visitor.customEvents[0].value != 0x03 || visitor.customEvents[1].value != 0x81
+	        || visitor.customEvents[1].data.size() != 1 || visitor.customEvents[1].data[0] != 0x81) {
+		FAILF("Wrong custom events");
+	}
+	/* Built-in decoders can be replaced or removed */
+	decoders.registerDecoder(NSEZSP::NSGPF::GPF_ON_CMD, nullptr);
+	decoders.registerDecoder(NSEZSP::NSGPF::GPF_OFF_CMD, &decodeButtons);
+	if (decode(decoders, NSEZSP::NSGPF::GPF_ON_CMD, { }, visitor) || !decode(decoders, NSEZSP::NSGPF::GPF_OFF_CMD, { 0x01 }, visitor)
+	        || !visitor.onOff.empty() || visitor.customEvents.size() != 3) {
+		FAILF("Built-in decoders should be replaceable");
+	}
+	NOTIFYPASS();
+}
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_payload_decoders() {
+	payload_decoders_commands();
+	payload_decoders_attribute_reports();
+	payload_decoders_custom();
+}
+#endif	// USE_CPPUTEST
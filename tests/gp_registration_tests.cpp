@@ -0,0 +1,842 @@
+#include <iostream>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <mutex>
+
+#include "spi/TimerBuilder.h"
+#include "spi/Logger.h"
+#include "spi/ILogger.h"
+#include "ezsp/ezsp-dongle.h"
+#include "ezsp/zigbee-tools/zigbee-messaging.h"
+#include "ezsp/zigbee-tools/green-power-sink.h"
+#include "ezsp/ezsp-protocol/ezsp-enum.h"
+
+#include "TestHarness.h"
+#include "SimulatedNcp.h"
+
+using NSSPI::Logger;
+using NSSPI::LOG_LEVEL;
+using NSEZSP::CGpSink;
+
+#ifndef USE_BUILTIN_MIC_PROCESSING
+namespace {
+const NSEZSP::EmberKeyData registrationKey({ 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff });
+
+/**
+ * @brief Build a list of devices with consecutive source IDs
+ */
+std::vector<NSEZSP::CGpDevice> makeDevices(std::size_t i_count, uint32_t i_first_source_id = 0x01500000) {
+	std::vector<NSEZSP::CGpDevice> devices;
+	for (std::size_t i = 0; i < i_count; i++) {
+		devices.push_back(NSEZSP::CGpDevice(i_first_source_id + static_cast<uint32_t>(i), registrationKey));
+	}
+	return devices;
+}
+
+/**
+ * @brief Count the entries of a simulated adapter table that are in use
+ */
+std::size_t countEntries(const std::vector<uint32_t>& i_table) {
+	std::size_t count = 0;
+	for (uint32_t sourceId : i_table) {
+		if (sourceId != 0) {
+			count++;
+		}
+	}
+	return count;
+}
+
+/**
+ * @brief A sink driving a simulated adapter through an EZSP dongle
+ */
+struct SimulatedSink {
+	/**
+	 * @param i_table_size The number of entries of the adapter's tables
+	 * @param i_latency The latency of the simulated adapter
+	 * @param i_preloaded Devices already in the adapter's tables when the sink starts
+	 */
+	SimulatedSink(std::size_t i_table_size, std::chrono::microseconds i_latency, const std::vector<NSEZSP::CGpDevice>& i_preloaded = {}) :
+		ncp(i_table_size, i_latency),
+		timerBuilder(),
+		dongle(timerBuilder),
+		zbMessaging(dongle, timerBuilder),
+		sink(dongle, zbMessaging, timerBuilder, 64),
+		state(CGpSink::State::SINK_NOT_INIT) {
+		for (const NSEZSP::CGpDevice& device : i_preloaded) {
+			this->ncp.addDevice(device.getSourceId());
+		}
+		this->dongle.setUart(this->ncp.getUart());
+		if (!this->dongle.reset()) {
+			FAILF("Failed resetting the simulated adapter");
+		}
+		this->sink.registerStateCallback([this](CGpSink::State& i_state) {
+			this->state = i_state;
+			return true;
+		});
+		this->sink.init();
+		this->waitReady();	/* The adapter's tables are loaded */
+	}
+
+	~SimulatedSink() {
+		this->ncp.stop();	/* No response can be delivered to the dongle while it is destroyed */
+	}
+
+	/**
+	 * @brief Wait until the sink is back to SINK_READY, and until all registered devices have been processed
+	 */
+	void waitReady() {
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+		while (this->state != CGpSink::State::SINK_READY || this->sink.getRegistrationProgress().nbTotal != this->sink.getRegistrationProgress().nbRegistered + this->sink.getRegistrationProgress().nbFailed) {
+			if (std::chrono::steady_clock::now() > deadline) {
+				FAILF("Timeout waiting for the sink to be ready");
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+	SimulatedNcp ncp;
+	NSSPI::TimerBuilder timerBuilder;
+	NSEZSP::CEzspDongle dongle;
+	NSEZSP::CZigbeeMessaging zbMessaging;
+	CGpSink sink;
+	std::atomic<CGpSink::State> state;
+};
+
+/**
+ * @brief Forge the EZSP incoming GP frame message of an unsecured commissioning frame (on/off switch, no extended options)
+ */
+NSSPI::ByteBuffer forgeCommissioningMsg(uint32_t i_source_id) {
+	NSSPI::ByteBuffer msg({ 0x00, 0xde, 0x01, 0x00 });	/* EZSP status, link value, sequence number, application ID */
+	for (unsigned int i = 0; i < 8; i++) {
+		msg.push_back(static_cast<uint8_t>((i_source_id >> (8 * (i % 4))) & 0xffU));	/* GPD IEEE address, whose both halves are the source ID */
+	}
+	msg.insert(msg.end(), { 0x00, 0x00, 0x00, 0x00, 0x00 });	/* Endpoint, security level, key type, auto-commissioning, rx after tx */
+	msg.insert(msg.end(), 4, 0x00);	/* Frame counter */
+	msg.push_back(0xe0);	/* GPF_COMMISSIONING_CMD */
+	msg.insert(msg.end(), 4, 0x00);	/* MIC */
+	msg.insert(msg.end(), { 0xff, 0x02, 0x02, 0x00 });	/* Proxy table entry, payload length, device ID, options */
+	return msg;
+}
+
+/**
+ * @brief Forge the EZSP incoming GP frame message of an authenticated "off" command from an rx-after-tx device
+ */
+NSSPI::ByteBuffer forgeRxAfterTxMsg(uint32_t i_source_id, uint8_t i_sequence_number) {
+	NSSPI::ByteBuffer msg({ 0x00, 0xde, i_sequence_number, 0x00 });	/* EZSP status (MIC checked by the adapter), link value, sequence number, application ID */
+	for (unsigned int i = 0; i < 8; i++) {
+		msg.push_back(static_cast<uint8_t>((i_source_id >> (8 * (i % 4))) & 0xffU));
+	}
+	msg.insert(msg.end(), { 0x00, 0x02, 0x04, 0x00, 0x01 });	/* Endpoint, security level, key type, auto-commissioning, rx after tx */
+	msg.insert(msg.end(), { i_sequence_number, 0x00, 0x00, 0x00 });	/* Frame counter */
+	msg.push_back(0x20);	/* GPF_OFF_CMD */
+	msg.insert(msg.end(), 4, 0x00);	/* MIC */
+	msg.insert(msg.end(), { 0xff, 0x00 });	/* Proxy table entry, payload length */
+	return msg;
+}
+
+/**
+ * @brief Forge the EZSP incoming GP frame message of an authenticated attribute reporting command
+ */
+NSSPI::ByteBuffer forgeAttributeReportMsg(uint32_t i_source_id, uint8_t i_sequence_number, const NSSPI::ByteBuffer& i_payload) {
+	NSSPI::ByteBuffer msg({ 0x00, 0xde, i_sequence_number, 0x00 });	/* EZSP status (MIC checked by the adapter), link value, sequence number, application ID */
+	for (unsigned int i = 0; i < 8; i++) {
+		msg.push_back(static_cast<uint8_t>((i_source_id >> (8 * (i % 4))) & 0xffU));
+	}
+	msg.insert(msg.end(), { 0x00, 0x02, 0x04, 0x00, 0x00 });	/* Endpoint, security level, key type, auto-commissioning, rx after tx */
+	msg.insert(msg.end(), { i_sequence_number, 0x00, 0x00, 0x00 });	/* Frame counter */
+	msg.push_back(0xa0);	/* GPF_ATTRIBUTE_REPORTING */
+	msg.insert(msg.end(), 4, 0x00);	/* MIC */
+	msg.insert(msg.end(), { 0xff, static_cast<uint8_t>(i_payload.size()) });	/* Proxy table entry, payload length */
+	msg.append(i_payload);
+	return msg;
+}
+
+/**
+ * @brief Observer collecting the outcome of commissionings
+ */
+class CommissioningObserver : public NSEZSP::CGpObserver {
+public:
+	CommissioningObserver() : mutex(), reports() { }
+
+	void handleGpdCommissioning(const NSEZSP::CGpCommissioningReport& i_report) override {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->reports.push_back(i_report);
+	}
+
+	/**
+	 * @brief Wait until a number of commissionings are over, and get their reports
+	 */
+	std::vector<NSEZSP::CGpCommissioningReport> waitReports(std::size_t i_count) {
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+		while (true) {
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				if (this->reports.size() >= i_count) {
+					return this->reports;
+				}
+			}
+			if (std::chrono::steady_clock::now() > deadline) {
+				FAILF("Timeout waiting for %zu commissionings", i_count);
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+private:
+	std::mutex mutex;
+	std::vector<NSEZSP::CGpCommissioningReport> reports;
+};
+
+/**
+ * @brief Register devices into a simulated adapter, and return the measured throughput
+ *
+ * @param i_count The number of devices
+ * @param i_already_registered The devices are already in the adapter's tables, their entries are updated
+ * @param i_latency The latency of the simulated adapter
+ * @param[out] o_nb_commands The number of EZSP commands per device
+ */
+double measureRegistration(std::size_t i_count, bool i_already_registered, std::chrono::microseconds i_latency, double& o_nb_commands) {
+	SimulatedSink simulated(i_count, i_latency, i_already_registered ? makeDevices(i_count) : std::vector<NSEZSP::CGpDevice>());
+	std::size_t nbCommands = 0;
+	for (NSEZSP::EEzspCmd cmd : { NSEZSP::EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY, NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY, NSEZSP::EZSP_GP_SINK_TABLE_SET_ENTRY, NSEZSP::EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING }) {
+		nbCommands -= simulated.ncp.getNbCommands(cmd);
+	}
+	if (!simulated.sink.registerGpds(makeDevices(i_count))) {
+		FAILF("Registration should be possible on a ready sink");
+	}
+	simulated.waitReady();
+	for (NSEZSP::EEzspCmd cmd : { NSEZSP::EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY, NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY, NSEZSP::EZSP_GP_SINK_TABLE_SET_ENTRY, NSEZSP::EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING }) {
+		nbCommands += simulated.ncp.getNbCommands(cmd);
+	}
+	CGpSink::RegistrationProgress progress = simulated.sink.getRegistrationProgress();
+	if (progress.nbRegistered != i_count || countEntries(simulated.ncp.getSinkTable()) != i_count) {
+		FAILF("%zu devices out of %zu registered", progress.nbRegistered, i_count);
+	}
+	o_nb_commands = static_cast<double>(nbCommands) / static_cast<double>(i_count);
+	return progress.devicesPerSecond;
+}
+}
+
+TEST_GROUP(gp_registration_tests) {
+};
+
+TEST(gp_registration_tests, tables_loaded_at_init) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	const std::size_t tableSize = 16;
+	std::vector<NSEZSP::CGpDevice> devices = makeDevices(5);
+	SimulatedSink simulated(tableSize, std::chrono::microseconds(0), devices);
+
+	/* Each entry of both tables is read once, up to the first index out of range */
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY) != tableSize + 1
+	        || simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_PROXY_TABLE_GET_ENTRY) != tableSize + 1) {
+		FAILF("Both tables should be read entirely at init");
+	}
+	NSEZSP::CGpTableMirror sinkTable = simulated.sink.getSinkTableMirror();
+	NSEZSP::CGpTableMirror proxyTable = simulated.sink.getProxyTableMirror();
+	if (!sinkTable.isLoaded() || sinkTable.size() != tableSize || sinkTable.getNbUsedEntries() != devices.size()
+	        || !proxyTable.isLoaded() || proxyTable.size() != tableSize || proxyTable.getNbUsedEntries() != devices.size()) {
+		FAILF("Unexpected mirrors: %zu/%zu sink entries, %zu/%zu proxy entries", sinkTable.getNbUsedEntries(), sinkTable.size(), proxyTable.getNbUsedEntries(), proxyTable.size());
+	}
+	for (std::size_t index = 0; index < devices.size(); index++) {
+		if (sinkTable.find(devices[index].getSourceId()) != index || proxyTable.find(devices[index].getSourceId()) != index) {
+			FAILF("Device %08x should be found at index %zu", devices[index].getSourceId(), index);
+		}
+	}
+	if (sinkTable.isBlank(0) || !sinkTable.isBlank(static_cast<uint8_t>(devices.size()))) {
+		FAILF("Entries used by devices should not be blank");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, registration_skips_known_free_entries) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	const std::size_t nbDevices = 40;
+	SimulatedSink simulated(64, std::chrono::microseconds(0));
+	std::size_t nbLoadReads = simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY);
+
+	if (!simulated.sink.registerGpds(makeDevices(nbDevices))) {
+		FAILF("Registration should be possible on a ready sink");
+	}
+	if (simulated.sink.registerGpds(makeDevices(1, 0x01600000))) {
+		FAILF("A second registration should be refused while the first one is in progress");
+	}
+	simulated.waitReady();
+
+	CGpSink::RegistrationProgress progress = simulated.sink.getRegistrationProgress();
+	if (progress.nbTotal != nbDevices || progress.nbRegistered != nbDevices || progress.nbFailed != 0) {
+		FAILF("Unexpected progress: %zu/%zu registered, %zu failed", progress.nbRegistered, progress.nbTotal, progress.nbFailed);
+	}
+	std::vector<uint32_t> sinkTable = simulated.ncp.getSinkTable();
+	std::vector<uint32_t> proxyTable = simulated.ncp.getProxyTable();
+	for (const NSEZSP::CGpDevice& device : makeDevices(nbDevices)) {
+		if (std::find(sinkTable.begin(), sinkTable.end(), device.getSourceId()) == sinkTable.end()
+		        || std::find(proxyTable.begin(), proxyTable.end(), device.getSourceId()) == proxyTable.end()) {
+			FAILF("Device %08x is missing from the adapter's tables", device.getSourceId());
+		}
+	}
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY) != nbLoadReads) {
+		FAILF("Blank entries of the sink table should not be read back");
+	}
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY) != nbDevices
+	        || simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_SET_ENTRY) != nbDevices
+	        || simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING) != nbDevices) {
+		FAILF("Each device should be allocated, written and paired once");
+	}
+
+	/* Registering the same devices again updates their entries, which are not free anymore: they are read first */
+	simulated.sink.registerGpds(makeDevices(nbDevices));
+	simulated.waitReady();
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY) != nbLoadReads + nbDevices || countEntries(simulated.ncp.getSinkTable()) != nbDevices) {
+		FAILF("Existing entries should be read and updated in place");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, registration_reads_back_used_entries) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	const std::size_t nbDevices = 10;
+	SimulatedSink simulated(32, std::chrono::microseconds(0), makeDevices(nbDevices));
+	std::size_t nbLoadReads = simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY);
+
+	/* Half of the devices were already in the adapter's tables before the sink started */
+	std::vector<NSEZSP::CGpDevice> devices = makeDevices(2 * nbDevices);
+	simulated.sink.registerGpds(devices);
+	simulated.waitReady();
+	if (simulated.sink.getRegistrationProgress().nbRegistered != devices.size() || countEntries(simulated.ncp.getProxyTable()) != devices.size()) {
+		FAILF("All devices should be registered");
+	}
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY) != nbLoadReads + nbDevices) {
+		FAILF("Only the entries used before the registration should be read back");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, removal_only_touches_used_entries) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	std::vector<NSEZSP::CGpDevice> devices = makeDevices(8);
+	SimulatedSink simulated(32, std::chrono::microseconds(0), devices);
+
+	/* Remove 3 devices, and one that is unknown to the adapter */
+	if (!simulated.sink.removeGpds({ devices[1].getSourceId(), devices[4].getSourceId(), devices[6].getSourceId(), 0x01600000 })) {
+		FAILF("Removal should be possible on a ready sink");
+	}
+	simulated.waitReady();
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_REMOVE_ENTRY) != 3
+	        || simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING) != 3
+	        || simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_LOOKUP) != 0
+	        || simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_PROXY_TABLE_LOOKUP) != 0) {
+		FAILF("Each removed device should cost one sink and one proxy table command, without any lookup");
+	}
+	std::vector<uint32_t> sinkTable = simulated.ncp.getSinkTable();
+	NSEZSP::CGpTableMirror sinkMirror = simulated.sink.getSinkTableMirror();
+	NSEZSP::CGpTableMirror proxyMirror = simulated.sink.getProxyTableMirror();
+	for (std::size_t index = 0; index < devices.size(); index++) {
+		bool removed = (index == 1 || index == 4 || index == 6);
+		bool inAdapter = (std::find(sinkTable.begin(), sinkTable.end(), devices[index].getSourceId()) != sinkTable.end());
+		bool inMirror = (sinkMirror.find(devices[index].getSourceId()) != NSEZSP::CGpTableMirror::NO_ENTRY
+		                 && proxyMirror.find(devices[index].getSourceId()) != NSEZSP::CGpTableMirror::NO_ENTRY);
+		if (inAdapter == removed || inMirror == removed) {
+			FAILF("Device %08x should %s", devices[index].getSourceId(), removed ? "have been removed" : "still be registered");
+		}
+	}
+
+	/* Nothing to remove: no command at all */
+	if (!simulated.sink.removeGpds({ devices[1].getSourceId() })) {
+		FAILF("Removal should be possible on a ready sink");
+	}
+	simulated.waitReady();
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_REMOVE_ENTRY) != 3) {
+		FAILF("A device that is not in the adapter's tables should not cost any command");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, clear_only_touches_used_entries) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	const std::size_t nbDevices = 5;
+	SimulatedSink simulated(64, std::chrono::microseconds(0), makeDevices(nbDevices));
+	std::size_t nbLoadReads = simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_PROXY_TABLE_GET_ENTRY);
+
+	if (!simulated.sink.clearAllGpds()) {
+		FAILF("Clearing tables should be possible on a ready sink");
+	}
+	simulated.waitReady();
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_CLEAR_ALL) != 1
+	        || simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING) != nbDevices
+	        || simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_PROXY_TABLE_GET_ENTRY) != nbLoadReads) {
+		FAILF("Clearing should only remove the used entries of the proxy table, without reading it again");
+	}
+	if (countEntries(simulated.ncp.getSinkTable()) != 0 || countEntries(simulated.ncp.getProxyTable()) != 0) {
+		FAILF("Adapter's tables should be empty");
+	}
+	if (simulated.sink.getSinkTableMirror().getNbUsedEntries() != 0 || simulated.sink.getProxyTableMirror().getNbUsedEntries() != 0) {
+		FAILF("Mirrors should be empty");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, registration_failures) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	SimulatedSink simulated(8, std::chrono::microseconds(0));
+	std::vector<NSEZSP::CGpDevice> devices = makeDevices(12);
+
+	simulated.ncp.failSetEntry(devices[10].getSourceId());	/* Devices are registered from the end of the list */
+	simulated.sink.clearAllGpds();
+	simulated.waitReady();
+	simulated.sink.registerGpds(devices);
+	simulated.waitReady();
+
+	/* One write fails (its entry remains allocated), then 7 devices fill the table, the 4 remaining ones cannot be allocated an entry */
+	CGpSink::RegistrationProgress progress = simulated.sink.getRegistrationProgress();
+	if (progress.nbRegistered != 7 || progress.nbFailed != 5) {
+		FAILF("Unexpected progress: %zu/%zu registered, %zu failed", progress.nbRegistered, progress.nbTotal, progress.nbFailed);
+	}
+	if (countEntries(simulated.ncp.getProxyTable()) != 7) {
+		FAILF("Devices that failed should not be paired");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, sync_only_applies_differences) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	const NSEZSP::EmberKeyData otherKey({ 0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88, 0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00 });
+	SimulatedSink simulated(32, std::chrono::microseconds(0));
+	std::vector<NSEZSP::CGpDevice> devices = makeDevices(10);
+	simulated.sink.registerGpds(devices);
+	simulated.waitReady();
+
+	/* Drop the last 2 devices, change the key of another one, add 3 new devices, and list one device twice */
+	std::vector<NSEZSP::CGpDevice> desired(devices.begin(), devices.begin() + 8);
+	desired[2] = NSEZSP::CGpDevice(devices[2].getSourceId(), otherKey);
+	std::vector<NSEZSP::CGpDevice> newDevices = makeDevices(3, 0x01600000);
+	desired.insert(desired.end(), newDevices.begin(), newDevices.end());
+	desired.push_back(devices[0]);
+
+	const std::vector<NSEZSP::EEzspCmd> tableCommands = { NSEZSP::EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY, NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY,
+	                                                      NSEZSP::EZSP_GP_SINK_TABLE_SET_ENTRY, NSEZSP::EZSP_GP_SINK_TABLE_REMOVE_ENTRY,
+	                                                      NSEZSP::EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING, NSEZSP::EZSP_GP_PROXY_TABLE_GET_ENTRY
+	                                                    };
+	std::vector<std::size_t> before;
+	for (NSEZSP::EEzspCmd cmd : tableCommands) {
+		before.push_back(simulated.ncp.getNbCommands(cmd));
+	}
+	NSEZSP::CGpSyncSummary summary;
+	if (!simulated.sink.syncGpds(desired, summary)) {
+		FAILF("Synchronization should be possible on a ready sink");
+	}
+	if (summary.nbUnchanged != 7 || summary.nbUpdated != 1 || summary.nbAdded != 3 || summary.nbRemoved != 2) {
+		FAILF("Unexpected summary: %zu unchanged, %zu updated, %zu added, %zu removed", summary.nbUnchanged, summary.nbUpdated, summary.nbAdded, summary.nbRemoved);
+	}
+	simulated.waitReady();
+
+	/* 2 removals (one sink and one proxy command each), 4 registrations (allocate, write and pair), only the updated entry is read back */
+	const std::vector<std::size_t> expected = { 4, 1, 4, 2, 2 + 4, 0 };
+	for (std::size_t i = 0; i < tableCommands.size(); i++) {
+		if (simulated.ncp.getNbCommands(tableCommands[i]) - before[i] != expected[i]) {
+			FAILF("Sent %zu commands 0x%02x, expected %zu", simulated.ncp.getNbCommands(tableCommands[i]) - before[i], static_cast<unsigned int>(tableCommands[i]), expected[i]);
+		}
+	}
+	std::vector<uint32_t> sinkTable = simulated.ncp.getSinkTable();
+	std::vector<uint32_t> proxyTable = simulated.ncp.getProxyTable();
+	if (countEntries(sinkTable) != 11 || countEntries(proxyTable) != 11) {
+		FAILF("Adapter's tables should hold exactly the desired devices");
+	}
+	for (const NSEZSP::CGpDevice& device : desired) {
+		if (std::find(sinkTable.begin(), sinkTable.end(), device.getSourceId()) == sinkTable.end()
+		        || std::find(proxyTable.begin(), proxyTable.end(), device.getSourceId()) == proxyTable.end()) {
+			FAILF("Device %08x is missing from the adapter's tables", device.getSourceId());
+		}
+	}
+	NSEZSP::CGpTableMirror sinkMirror = simulated.sink.getSinkTableMirror();
+	if (!(sinkMirror.getEntry(sinkMirror.find(devices[2].getSourceId())).key == otherKey)) {
+		FAILF("The updated key should be mirrored");
+	}
+
+	/* Synchronizing again with the same list: nothing to do, no command at all */
+	for (std::size_t i = 0; i < tableCommands.size(); i++) {
+		before[i] = simulated.ncp.getNbCommands(tableCommands[i]);
+	}
+	if (!simulated.sink.syncGpds(desired, summary)) {
+		FAILF("Synchronization should be possible on a ready sink");
+	}
+	simulated.waitReady();
+	if (summary.nbUnchanged != 11 || summary.nbUpdated != 0 || summary.nbAdded != 0 || summary.nbRemoved != 0) {
+		FAILF("Unexpected summary: %zu unchanged, %zu updated, %zu added, %zu removed", summary.nbUnchanged, summary.nbUpdated, summary.nbAdded, summary.nbRemoved);
+	}
+	for (std::size_t i = 0; i < tableCommands.size(); i++) {
+		if (simulated.ncp.getNbCommands(tableCommands[i]) != before[i]) {
+			FAILF("A synchronization without any difference should not send command 0x%02x", static_cast<unsigned int>(tableCommands[i]));
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, sync_rewrites_unknown_entries) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	std::vector<NSEZSP::CGpDevice> devices = makeDevices(6);
+	SimulatedSink simulated(16, std::chrono::microseconds(0), devices);
+
+	/* Entries found in the adapter at startup do not hold the expected key and options: they are written again */
+	NSEZSP::CGpSyncSummary summary;
+	if (!simulated.sink.syncGpds(std::vector<NSEZSP::CGpDevice>(devices.begin(), devices.begin() + 4), summary)) {
+		FAILF("Synchronization should be possible on a ready sink");
+	}
+	simulated.waitReady();
+	if (summary.nbUnchanged != 0 || summary.nbUpdated != 4 || summary.nbAdded != 0 || summary.nbRemoved != 2) {
+		FAILF("Unexpected summary: %zu unchanged, %zu updated, %zu added, %zu removed", summary.nbUnchanged, summary.nbUpdated, summary.nbAdded, summary.nbRemoved);
+	}
+	if (countEntries(simulated.ncp.getSinkTable()) != 4 || countEntries(simulated.ncp.getProxyTable()) != 4
+	        || simulated.sink.getRegistrationProgress().nbRegistered != 4) {
+		FAILF("Adapter's tables should hold exactly the desired devices");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, commissioning_of_concurrent_devices) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	const std::size_t nbDevices = 20;
+	CommissioningObserver observer;
+	SimulatedSink simulated(32, std::chrono::microseconds(1000));
+	simulated.sink.registerObserver(&observer);
+	std::size_t nbLoadReads = simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY);
+
+	/* All devices press their button together, each one repeating its commissioning frame 3 times */
+	simulated.sink.openCommissioningSession();
+	for (unsigned int repeat = 0; repeat < 3; repeat++) {
+		for (uint32_t i = 0; i < nbDevices; i++) {
+			simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeCommissioningMsg(0x01700000 + i));
+		}
+	}
+	std::vector<NSEZSP::CGpCommissioningReport> reports = observer.waitReports(nbDevices);
+	for (std::size_t i = 0; i < reports.size(); i++) {
+		if (!reports[i].paired || reports[i].sourceId != 0x01700000 + i) {
+			FAILF("Devices should be paired in the order of their first commissioning frame");
+		}
+		if (reports[i].latency < reports[i].queueDelay) {
+			FAILF("Pairing latency should include the time spent waiting for other devices");
+		}
+	}
+	if (reports.back().queueDelay <= reports.front().queueDelay) {
+		FAILF("Last device should have waited longer than the first one");
+	}
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY) != nbDevices
+	        || simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_SET_ENTRY) != nbDevices
+	        || simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING) != nbDevices
+	        || simulated.ncp.getNbCommands(NSEZSP::EZSP_GP_SINK_TABLE_GET_ENTRY) != nbLoadReads) {
+		FAILF("Each device should be paired once, repeated commissioning frames being ignored, and blank entries not read back");
+	}
+	if (countEntries(simulated.ncp.getSinkTable()) != nbDevices || countEntries(simulated.ncp.getProxyTable()) != nbDevices) {
+		FAILF("All devices should be in the adapter's tables");
+	}
+
+	/* Closing the session while devices are being paired: they are still paired, then the sink is ready */
+	for (uint32_t i = 0; i < 5; i++) {
+		simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeCommissioningMsg(0x01800000 + i));
+	}
+	observer.waitReports(nbDevices + 1);
+	simulated.sink.closeCommissioningSession();
+	simulated.waitReady();
+	reports = observer.waitReports(nbDevices + 5);
+	if (reports.size() != nbDevices + 5 || countEntries(simulated.ncp.getSinkTable()) != nbDevices + 5) {
+		FAILF("Devices queued before the session was closed should be paired");
+	}
+	simulated.sink.unregisterObserver(&observer);
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, commissioning_table_full) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	CommissioningObserver observer;
+	SimulatedSink simulated(4, std::chrono::microseconds(0));
+	simulated.sink.registerObserver(&observer);
+
+	simulated.sink.openCommissioningSession();
+	for (uint32_t i = 0; i < 6; i++) {
+		simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeCommissioningMsg(0x01700000 + i));
+	}
+	std::vector<NSEZSP::CGpCommissioningReport> reports = observer.waitReports(6);
+	std::size_t nbPaired = 0;
+	for (const NSEZSP::CGpCommissioningReport& report : reports) {
+		nbPaired += (report.paired ? 1 : 0);
+	}
+	if (nbPaired != 4 || simulated.state != CGpSink::State::SINK_COM_OPEN) {
+		FAILF("%zu devices paired out of 6 in a table of 4 entries, the session should stay open", nbPaired);
+	}
+	simulated.sink.closeCommissioningSession();
+	simulated.waitReady();
+	simulated.sink.unregisterObserver(&observer);
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, commissioning_allocation_failure_with_queue) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	CommissioningObserver observer;
+	SimulatedSink simulated(4, std::chrono::microseconds(500));
+	const uint32_t failingSourceId = 0x01750000;
+	const uint32_t nextSourceId = 0x01750001;
+	simulated.ncp.failAllocation(failingSourceId);
+	simulated.sink.registerObserver(&observer);
+
+	/* The second device is queued while the first one is waiting for its sink table entry */
+	simulated.sink.openCommissioningSession();
+	simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeCommissioningMsg(failingSourceId));
+	simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeCommissioningMsg(nextSourceId));
+	std::vector<NSEZSP::CGpCommissioningReport> reports = observer.waitReports(2);
+	if (reports[0].sourceId != failingSourceId || reports[0].paired) {
+		FAILF("The allocation failure should be reported for source ID 0x%08x, got 0x%08x", failingSourceId, reports[0].sourceId);
+	}
+	std::vector<uint32_t> sinkTable = simulated.ncp.getSinkTable();
+	if (reports[1].sourceId != nextSourceId || !reports[1].paired || std::count(sinkTable.begin(), sinkTable.end(), nextSourceId) != 1
+	    || std::count(sinkTable.begin(), sinkTable.end(), failingSourceId) != 0) {
+		FAILF("The pairing of the queued source ID 0x%08x should go on", nextSourceId);
+	}
+	simulated.sink.closeCommissioningSession();
+	simulated.waitReady();
+	simulated.sink.unregisterObserver(&observer);
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, gpdf_transmissions_in_parallel) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	static constexpr uint32_t NB_GPDS = 20;
+	const uint32_t silentSourceId = 0x01800000 + NB_GPDS - 1;
+	SimulatedSink simulated(4, std::chrono::microseconds(200));
+	simulated.ncp.dropGpdfConfirmations(silentSourceId);
+
+	std::mutex mutex;
+	std::vector<NSEZSP::CGpTxConfirmation> confirmations;
+	for (uint32_t i = 0; i < NB_GPDS; i++) {
+		/* Like a bulk channel migration: channel configurations for many GPDs are queued without waiting for previous confirmations */
+		bool sent = simulated.sink.sendGpdf(0x01800000 + i, 0xF3, { 0x1f }, 100, [&mutex, &confirmations](const NSEZSP::CGpTxConfirmation& i_confirmation) {
+			std::lock_guard<std::mutex> lock(mutex);
+			confirmations.push_back(i_confirmation);
+		});
+		if (!sent) {
+			FAILF("GPDF transmission %u should be accepted", i);
+		}
+	}
+	auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (simulated.sink.getNbPendingGpdfTransmissions() != 0) {
+		if (std::chrono::steady_clock::now() > deadline) {
+			FAILF("Timeout waiting for GPDF transmissions to be confirmed or to expire");
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_D_GP_SEND) != NB_GPDS) {
+		FAILF("Each GPDF should be queued in the adapter once");
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	if (confirmations.size() != NB_GPDS) {
+		FAILF("Got %zu outcomes for %u GPDF transmissions", confirmations.size(), NB_GPDS);
+	}
+	for (const NSEZSP::CGpTxConfirmation& confirmation : confirmations) {
+		bool silent = (confirmation.sourceId == silentSourceId);
+		if (confirmation.expired != silent || (confirmation.status == NSEZSP::EEmberStatus::EMBER_SUCCESS) == silent || confirmation.commandId != 0xF3) {
+			FAILF("Wrong outcome for the GPDF transmission to source ID 0x%08x", confirmation.sourceId);
+		}
+		if (silent && confirmation.latency < std::chrono::milliseconds(100) + CGpSink::GPDF_CONFIRMATION_MARGIN) {
+			FAILF("GPDF transmission expired too early");
+		}
+	}
+	NSEZSP::CGpTxTable::LatencyStats stats = simulated.sink.getGpdfTxLatencyStats();
+	if (stats.nbConfirmed != NB_GPDS - 1 || stats.nbFailed != 0 || stats.nbExpired != 1 ||
+	    stats.minLatency.count() <= 0 || stats.minLatency > stats.averageLatency || stats.averageLatency > stats.maxLatency) {
+		FAILF("Wrong TX confirmation statistics");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, downlinks_wait_for_uplinks) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	SimulatedSink simulated(4, std::chrono::microseconds(200));
+	std::mutex mutex;
+	std::vector<NSEZSP::CGpDownlinkReport> reports;
+	auto record = [&mutex, &reports](const NSEZSP::CGpDownlinkReport& i_report) {
+		std::lock_guard<std::mutex> lock(mutex);
+		reports.push_back(i_report);
+	};
+	auto waitReports = [&mutex, &reports](std::size_t i_count) {
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (true) {
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				if (reports.size() >= i_count) {
+					return;
+				}
+			}
+			if (std::chrono::steady_clock::now() > deadline) {
+				FAILF("Timeout waiting for %zu downlink outcomes", i_count);
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	};
+
+	simulated.sink.queueGpdf(0x01900001, 0xF3, { 0x1f }, record);
+	simulated.sink.queueGpdf(0x01900002, 0xF3, { 0x1f }, record, 3, std::chrono::milliseconds(50));
+	std::this_thread::sleep_for(std::chrono::milliseconds(100));
+	waitReports(1);	/* The GPDF for a device that is never heard expires */
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_D_GP_SEND) != 0 || simulated.sink.getNbQueuedGpdfs() != 1) {
+		FAILF("GPDFs should not be handed over to the adapter before their device is heard");
+	}
+	simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeRxAfterTxMsg(0x01900001, 1));
+	waitReports(2);
+	std::lock_guard<std::mutex> lock(mutex);
+	if (reports[0].sourceId != 0x01900002 || reports[0].delivered || reports[0].nbAttempts != 0) {
+		FAILF("Wrong outcome for the expired GPDF");
+	}
+	if (reports[1].sourceId != 0x01900001 || !reports[1].delivered || reports[1].nbAttempts != 1) {
+		FAILF("Wrong outcome for the delivered GPDF");
+	}
+	if (simulated.ncp.getNbCommands(NSEZSP::EZSP_D_GP_SEND) != 1 || simulated.sink.getNbQueuedGpdfs() != 0) {
+		FAILF("The GPDF should be handed over to the adapter once, after the uplink");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, attribute_reports_update_store) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	SimulatedSink simulated(4, std::chrono::microseconds(200));
+	const NSEZSP::CGpAttributeStore& store = simulated.sink.getAttributeStore();
+	auto waitVersion = [&store](uint64_t i_version) {
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (store.getVersion() < i_version) {
+			if (std::chrono::steady_clock::now() > deadline) {
+				FAILF("Timeout waiting for attribute store version %llu", static_cast<unsigned long long>(i_version));
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	};
+
+	/* Temperature 21.50°C and humidity 50.00% from the same device */
+	simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeAttributeReportMsg(0x01a00001, 1, { 0x02, 0x04, 0x00, 0x00, 0x29, 0x66, 0x08 }));
+	simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeAttributeReportMsg(0x01a00001, 2, { 0x05, 0x04, 0x00, 0x00, 0x21, 0x88, 0x13 }));
+	waitVersion(2);
+	NSEZSP::CGpAttributeValue value;
+	if (!store.get(0x01a00001, 0x0402, 0x0000, value) || static_cast<int16_t>(value.rawValue) != 2150 || value.version != 1
+	    || !store.get(0x01a00001, 0x0405, 0x0000, value) || value.rawValue != 5000 || value.version != 2) {
+		FAILF("Reported attributes should be in the store");
+	}
+	/* Unchanged temperature, then a new one */
+	simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeAttributeReportMsg(0x01a00001, 3, { 0x02, 0x04, 0x00, 0x00, 0x29, 0x66, 0x08 }));
+	simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeAttributeReportMsg(0x01a00001, 4, { 0x02, 0x04, 0x00, 0x00, 0x29, 0x70, 0x08 }));
+	waitVersion(3);
+	std::vector<NSEZSP::CGpAttributeValue> changed;
+	if (store.forEachChangedSince(2, [&changed](const NSEZSP::CGpAttributeValue& i_value) { changed.push_back(i_value); }) != 3
+	    || changed.size() != 1 || changed[0].clusterId != 0x0402 || static_cast<int16_t>(changed[0].rawValue) != 2160) {
+		FAILF("Only the changed temperature should be reported");
+	}
+	NOTIFYPASS();
+}
+
+/**
+ * @brief Observer collecting the liveness changes of GPDs
+ */
+class LivenessObserver : public NSEZSP::CGpObserver {
+public:
+	LivenessObserver() : mutex(), reports() { }
+
+	void handleGpdLiveness(const NSEZSP::CGpLivenessReport& i_report) override {
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->reports.push_back(i_report);
+	}
+
+	/**
+	 * @brief Wait until a number of liveness changes were notified, and get their reports
+	 */
+	std::vector<NSEZSP::CGpLivenessReport> waitReports(std::size_t i_count) {
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (true) {
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				if (this->reports.size() >= i_count) {
+					return this->reports;
+				}
+			}
+			if (std::chrono::steady_clock::now() > deadline) {
+				FAILF("Timeout waiting for %zu liveness reports", i_count);
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	}
+
+private:
+	std::mutex mutex;
+	std::vector<NSEZSP::CGpLivenessReport> reports;
+};
+
+TEST(gp_registration_tests, gpd_liveness_offline_and_recovery) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	SimulatedSink simulated(4, std::chrono::microseconds(200));
+	LivenessObserver observer;
+	simulated.sink.registerObserver(&observer);
+	simulated.sink.setLivenessParameters(2, std::chrono::milliseconds(150), std::chrono::milliseconds(1000), std::chrono::milliseconds(10));
+	const NSSPI::ByteBuffer temperature({ 0x02, 0x04, 0x00, 0x00, 0x29, 0x66, 0x08 });
+
+	/* A report every 50ms, then silence: offline after 150ms, the timeout of 2 missed reports being shorter */
+	uint8_t sequence = 1;
+	for (unsigned int i = 0; i < 5; i++) {
+		simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeAttributeReportMsg(0x01b00001, sequence++, temperature));
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	}
+	std::vector<NSEZSP::CGpLivenessReport> reports = observer.waitReports(1);
+	if (reports[0].sourceId != 0x01b00001 || !reports[0].offline || reports[0].expectedPeriod < std::chrono::milliseconds(30)
+	    || reports[0].expectedPeriod > std::chrono::milliseconds(200) || simulated.sink.isGpdOnline(0x01b00001) || simulated.sink.getNbOfflineGpds() != 1) {
+		FAILF("The GPD should be reported offline");
+	}
+
+	/* Heard again */
+	simulated.ncp.sendCallback(NSEZSP::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeAttributeReportMsg(0x01b00001, sequence++, temperature));
+	reports = observer.waitReports(2);
+	if (reports[1].sourceId != 0x01b00001 || reports[1].offline || !simulated.sink.isGpdOnline(0x01b00001) || simulated.sink.getNbOfflineGpds() != 0) {
+		FAILF("The GPD should be reported back online");
+	}
+	simulated.sink.unregisterObserver(&observer);
+	NOTIFYPASS();
+}
+
+TEST(gp_registration_tests, registration_benchmark) {
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	const std::size_t nbDevices = 100;
+	const std::chrono::microseconds latency(500);
+	double commandsPerDeviceNew = 0;
+	double commandsPerDeviceUpdated = 0;
+
+	double newRate = measureRegistration(nbDevices, false, latency, commandsPerDeviceNew);
+	double updatedRate = measureRegistration(nbDevices, true, latency, commandsPerDeviceUpdated);
+	std::cout << "Registration of " << nbDevices << " GP devices, " << latency.count() << "us adapter latency:\n";
+	std::cout << "  new devices:     " << static_cast<unsigned int>(newRate) << " devices/s (" << commandsPerDeviceNew << " EZSP commands per device)\n";
+	std::cout << "  updated devices: " << static_cast<unsigned int>(updatedRate) << " devices/s (" << commandsPerDeviceUpdated << " EZSP commands per device)\n";
+	if (commandsPerDeviceNew != 3 || commandsPerDeviceUpdated != 4) {
+		FAILF("Unexpected number of EZSP commands per device");
+	}
+	NOTIFYPASS();
+}
+#endif	// USE_BUILTIN_MIC_PROCESSING
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_registration() {
+#ifndef USE_BUILTIN_MIC_PROCESSING
+	tables_loaded_at_init();
+	registration_skips_known_free_entries();
+	registration_reads_back_used_entries();
+	removal_only_touches_used_entries();
+	clear_only_touches_used_entries();
+	registration_failures();
+	sync_only_applies_differences();
+	sync_rewrites_unknown_entries();
+	commissioning_of_concurrent_devices();
+	commissioning_table_full();
+	commissioning_allocation_failure_with_queue();
+	gpdf_transmissions_in_parallel();
+	downlinks_wait_for_uplinks();
+	attribute_reports_update_store();
+	gpd_liveness_offline_and_recovery();
+	registration_benchmark();
+#endif
+}
+#endif	// USE_CPPUTEST
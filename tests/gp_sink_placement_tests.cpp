@@ -0,0 +1,453 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+#include "spi/TimerBuilder.h"
+#include "spi/ByteBuffer.h"
+#include "spi/Logger.h"
+#include "spi/ILogger.h"
+#include "spi/AesBuilder.h"
+#include "ezsp/ezsp-dongle.h"
+#include "ezsp/zigbee-tools/zigbee-messaging.h"
+#include "ezsp/zigbee-tools/green-power-sink.h"
+#include "ezsp/zigbee-tools/green-power-sink-placement.h"
+#include "ezsp/ezsp-protocol/ezsp-enum.h"
+
+#include "TestHarness.h"
+
+using NSSPI::Logger;
+using NSSPI::LOG_LEVEL;
+using NSEZSP::CGpSinkTablePlacement;
+
+namespace {
+/**
+ * @brief Count frames for several devices, then end the epoch
+ *
+ * @param placement The placement
+ * @param hits The number of frames of each device (device n has source ID n + 1)
+ * @param[out] demotions The devices selected for demotion
+ * @param[out] promotions The devices selected for promotion
+ */
+void runEpoch(CGpSinkTablePlacement& placement, const std::vector<unsigned int>& hits, std::vector<uint32_t>& demotions, std::vector<uint32_t>& promotions) {
+	demotions.clear();
+	promotions.clear();
+	for (std::size_t device = 0; device < hits.size(); device++) {
+		for (unsigned int frame = 0; frame < hits[device]; frame++) {
+			placement.recordFrame(static_cast<uint32_t>(device + 1));
+		}
+	}
+	placement.endEpoch(demotions, promotions);
+}
+
+/**
+ * @brief Report all moves selected by an epoch as successful
+ */
+void completeMoves(CGpSinkTablePlacement& placement, const std::vector<uint32_t>& demotions, const std::vector<uint32_t>& promotions) {
+	for (uint32_t sourceId : demotions) {
+		placement.demotionDone(sourceId);
+	}
+	for (uint32_t sourceId : promotions) {
+		placement.promotionDone(sourceId, true);
+	}
+}
+}
+
+TEST_GROUP(gp_sink_placement_tests) {
+};
+
+TEST(gp_sink_placement_tests, promotes_most_active) {
+	CGpSinkTablePlacement placement;
+	std::vector<uint32_t> demotions;
+	std::vector<uint32_t> promotions;
+
+	runEpoch(placement, { 10, 8 }, demotions, promotions);
+	if (placement.isEnabled() || !promotions.empty() || placement.getScore(1) != 0) {
+		FAILF("A placement that has not been sized should not track anything");
+	}
+
+	placement.reset(16, 2);
+	runEpoch(placement, { 6, 1, 10, 8, CGpSinkTablePlacement::PROMOTION_MIN_SCORE - 1 }, demotions, promotions);
+	if (promotions != std::vector<uint32_t>({ 3, 4 }) || !demotions.empty()) {
+		FAILF("The two most active devices should be promoted, most active first");
+	}
+	if (placement.getResidency(3) != CGpSinkTablePlacement::Residency::PROMOTING || placement.isNcpResident(3)) {
+		FAILF("Frames of a device being promoted should still be validated by the host");
+	}
+	completeMoves(placement, demotions, promotions);
+	if (!placement.isNcpResident(3) || !placement.isNcpResident(4) || placement.isNcpResident(1) || placement.getNbNcpEntries() != 2) {
+		FAILF("Devices should be resident once their promotion is done");
+	}
+
+	/* The table is full, and no device is much more active than the residents */
+	runEpoch(placement, { 6, 1, 10, 8, 3 }, demotions, promotions);
+	if (!promotions.empty() || !demotions.empty()) {
+		FAILF("No device should move while traffic is stable");
+	}
+
+	/* Device 1 becomes by far the most active, device 4 stops sending */
+	runEpoch(placement, { 40, 1, 10, 0, 3 }, demotions, promotions);
+	if (promotions != std::vector<uint32_t>({ 1 }) || demotions != std::vector<uint32_t>({ 4 })) {
+		FAILF("The most active device should replace the least active resident");
+	}
+	if (placement.isNcpResident(4) || placement.getNbNcpEntries() != 3) {
+		FAILF("A device being demoted should be validated by the host, but still occupy its entry");
+	}
+	completeMoves(placement, demotions, promotions);
+	if (!placement.isNcpResident(1) || !placement.isNcpResident(3) || placement.getNbNcpEntries() != 2) {
+		FAILF("Unexpected residents after a swap");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_sink_placement_tests, hysteresis_prevents_flapping) {
+	CGpSinkTablePlacement placement;
+	std::vector<uint32_t> demotions;
+	std::vector<uint32_t> promotions;
+	placement.reset(16, 1);
+
+	/* Two devices with the same traffic compete for a single entry */
+	runEpoch(placement, { 10, 10 }, demotions, promotions);
+	if (promotions.size() != 1 || !demotions.empty()) {
+		FAILF("One device should be promoted");
+	}
+	uint32_t resident = promotions.front();
+	completeMoves(placement, demotions, promotions);
+	unsigned int nbMoves = 0;
+	for (unsigned int epoch = 0; epoch < 50; epoch++) {
+		/* Bursts alternate between both devices, the average traffic is the same */
+		runEpoch(placement, (epoch % 2 == 0) ? std::vector<unsigned int>({ 12, 8 }) : std::vector<unsigned int>({ 8, 12 }), demotions, promotions);
+		nbMoves += static_cast<unsigned int>(demotions.size() + promotions.size());
+		completeMoves(placement, demotions, promotions);
+	}
+	if (nbMoves != 0 || !placement.isNcpResident(resident)) {
+		FAILF("Devices with similar traffic should not swap places, got %u moves", nbMoves);
+	}
+
+	/* A slightly more active device does not take the place either */
+	uint32_t other = (resident == 1) ? 2 : 1;
+	std::vector<unsigned int> hits(2);
+	hits[resident - 1] = 10;
+	hits[other - 1] = 13;
+	for (unsigned int epoch = 0; epoch < 20; epoch++) {
+		runEpoch(placement, hits, demotions, promotions);
+		nbMoves += static_cast<unsigned int>(demotions.size() + promotions.size());
+		completeMoves(placement, demotions, promotions);
+	}
+	if (nbMoves != 0) {
+		FAILF("A device less than %u%% more active than the resident should not replace it", CGpSinkTablePlacement::HYSTERESIS_PERCENT);
+	}
+
+	hits[other - 1] = 20;
+	runEpoch(placement, hits, demotions, promotions);
+	if (promotions != std::vector<uint32_t>({ other }) || demotions != std::vector<uint32_t>({ resident })) {
+		FAILF("A device twice as active as the resident should replace it");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_sink_placement_tests, limits_and_forgetting) {
+	CGpSinkTablePlacement placement;
+	std::vector<uint32_t> demotions;
+	std::vector<uint32_t> promotions;
+	placement.reset(64, 32);
+
+	/* Moves are spread over several epochs */
+	std::vector<unsigned int> hits(20, 10);
+	runEpoch(placement, hits, demotions, promotions);
+	if (promotions.size() != CGpSinkTablePlacement::MAX_PROMOTIONS_PER_EPOCH) {
+		FAILF("At most %zu devices should be promoted per epoch, got %zu", CGpSinkTablePlacement::MAX_PROMOTIONS_PER_EPOCH, promotions.size());
+	}
+	/* The adapter's table turns out to be smaller than configured: it is full after the first two promotions */
+	placement.promotionDone(promotions[0], true);
+	placement.promotionDone(promotions[1], true);
+	placement.ncpTableFull();
+	placement.promotionDone(promotions[2], false);
+	placement.promotionDone(promotions[3], false);
+	if (placement.getNcpCapacity() != 2 || placement.getNbNcpEntries() != 2) {
+		FAILF("The capacity should be lowered to the number of entries in use, got %zu", placement.getNcpCapacity());
+	}
+	uint32_t resident = promotions[0];
+	runEpoch(placement, hits, demotions, promotions);
+	if (!promotions.empty()) {
+		FAILF("No device should be promoted once the adapter's table is full");
+	}
+
+	/* Removed devices must leave the adapter's table */
+	if (!placement.forget(resident) || placement.isNcpResident(resident) || placement.getNbNcpEntries() != 1) {
+		FAILF("Forgetting a resident should free its entry");
+	}
+	if (placement.forget(0x12345678)) {
+		FAILF("Forgetting an unknown device should not require any move");
+	}
+	/* A device forgotten while being promoted is reported as such */
+	hits[resident - 1] = 0;
+	for (unsigned int epoch = 0; epoch < 2 && promotions.empty(); epoch++) {
+		runEpoch(placement, hits, demotions, promotions);
+	}
+	if (promotions.size() != 1) {
+		FAILF("The freed entry should be used by another device");
+	}
+	placement.forget(promotions.front());
+	if (placement.promotionDone(promotions.front(), true)) {
+		FAILF("The promotion of a forgotten device should be reported");
+	}
+
+	/* Idle devices are eventually forgotten */
+	std::vector<uint32_t> ncpEntries;
+	placement.forgetAll(ncpEntries);
+	if (ncpEntries.size() != 1 || placement.getNbNcpEntries() != 0) {
+		FAILF("All remaining residents should be reported by forgetAll()");
+	}
+	runEpoch(placement, { 16 }, demotions, promotions);
+	for (unsigned int epoch = 0; epoch < 8; epoch++) {
+		runEpoch(placement, { 0 }, demotions, promotions);
+	}
+	if (placement.getScore(1) != 0) {
+		FAILF("The score of an idle device should decay to 0");
+	}
+	NOTIFYPASS();
+}
+
+#ifdef USE_BUILTIN_MIC_PROCESSING
+namespace {
+/* The secured GP frame also used in green_power_frame_tests.cpp (source ID 0x0054000a, security level 2) */
+const NSSPI::ByteBuffer knownEzspMsg({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x02, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0xa2, 0xb5, 0x92, 0x23, 0x4e, 0x00, 0x11, 0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30});
+const NSEZSP::EmberKeyData knownKey({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5F});
+const unsigned int SOURCE_ID_OFFSET = 4;	/* Offset of the little endian source ID in knownEzspMsg */
+const unsigned int FRAME_COUNTER_OFFSET = 17;	/* Offset of the little endian security frame counter in knownEzspMsg */
+const unsigned int MIC_OFFSET = 22;	/* Offset of the little endian MIC in knownEzspMsg */
+const uint8_t WRONG_MIC_STATUS = 0xAD;	/* Any status but EMBER_SUCCESS: the adapter could not authenticate the frame */
+
+void putU32le(NSSPI::ByteBuffer& buffer, unsigned int offset, uint32_t value) {
+	for (unsigned int i = 0; i < 4; i++) {
+		buffer[offset + i] = static_cast<uint8_t>((value >> (8 * i)) & 0xffU);
+	}
+}
+
+/**
+ * @brief Compute the MIC of a security level 2 frame (AES-CCM* with a 4-byte MIC, see 09-5499-25, section A 1.5.4)
+ */
+uint32_t computeMic(const NSEZSP::CGpFrame& gpf, const NSEZSP::EmberKeyData& key) {
+	const NSSPI::IAes& aes = NSSPI::AesBuilder::shared();
+	NSSPI::IAes::ExpandedKey expandedKey;
+	aes.expand_key(key, expandedKey);
+
+	uint8_t nonce[13];
+	for (unsigned int i = 0; i < 4; i++) {
+		nonce[i] = nonce[4 + i] = static_cast<uint8_t>(gpf.getSourceId() >> (8 * i));
+		nonce[8 + i] = static_cast<uint8_t>(gpf.getSecurityFrameCounter() >> (8 * i));
+	}
+	nonce[12] = 0x05;
+
+	std::vector<uint8_t> a;
+	a.push_back(static_cast<uint8_t>(0x8c | (gpf.isAutoCommissioning() ? 0x40 : 0x00)));
+	a.push_back(static_cast<uint8_t>((gpf.getApplicationId() & 0x07) | ((static_cast<uint8_t>(gpf.getSecurity()) & 0x03) << 3)
+	                                 | (gpf.getKeyType() != NSEZSP::EGpSecurityKeyType::GPD_KEY_TYPE_NO_KEY ? 0x20 : 0x00)
+	                                 | (gpf.isRxAfterTx() ? 0x40 : 0x00)));
+	for (unsigned int i = 0; i < 4; i++) {
+		a.push_back(static_cast<uint8_t>(gpf.getSourceId() >> (8 * i)));
+	}
+	for (unsigned int i = 0; i < 4; i++) {
+		a.push_back(static_cast<uint8_t>(gpf.getSecurityFrameCounter() >> (8 * i)));
+	}
+	a.push_back(gpf.getCommandId());
+	NSSPI::ByteView payload = gpf.getPayloadView();
+	a.insert(a.end(), payload.begin(), payload.end());
+
+	std::vector<uint8_t> blocks;
+	blocks.push_back(static_cast<uint8_t>(a.size() >> 8));
+	blocks.push_back(static_cast<uint8_t>(a.size() & 0xff));
+	blocks.insert(blocks.end(), a.begin(), a.end());
+	blocks.resize((blocks.size() + 15) / 16 * 16, 0x00);
+
+	uint8_t x[16] = { 0x49 };	/* B0: flags, nonce, empty plain text */
+	std::copy(nonce, nonce + 13, x + 1);
+	aes.encrypt(expandedKey, x, x);
+	for (std::size_t block = 0; block < blocks.size(); block += 16) {
+		for (unsigned int i = 0; i < 16; i++) {
+			x[i] ^= blocks[block + i];
+		}
+		aes.encrypt(expandedKey, x, x);
+	}
+	uint8_t a0[16] = { 0x01 };
+	std::copy(nonce, nonce + 13, a0 + 1);
+	aes.encrypt(expandedKey, a0, a0);
+	uint32_t mic = 0;
+	for (unsigned int i = 0; i < 4; i++) {
+		mic |= static_cast<uint32_t>(x[i] ^ a0[i]) << (8 * i);
+	}
+	return mic;
+}
+
+/**
+ * @brief Forge an EZSP incoming GP frame message from another source ID and frame counter, based on knownEzspMsg
+ *
+ * @param sourceId The source ID
+ * @param frameCounter The security frame counter
+ * @param status The EZSP status byte (EMBER_SUCCESS if the adapter authenticated the frame)
+ * @param validMic Sign the frame with knownKey (otherwise the MIC is wrong)
+ */
+NSSPI::ByteBuffer forgeEzspMsg(uint32_t sourceId, uint32_t frameCounter, uint8_t status, bool validMic) {
+	NSSPI::ByteBuffer ezspMsg(knownEzspMsg);
+	ezspMsg[0] = status;
+	putU32le(ezspMsg, SOURCE_ID_OFFSET, sourceId);
+	putU32le(ezspMsg, FRAME_COUNTER_OFFSET, frameCounter);
+	uint32_t mic = computeMic(NSEZSP::CGpFrame(ezspMsg), knownKey);
+	putU32le(ezspMsg, MIC_OFFSET, validMic ? mic : ~mic);
+	return ezspMsg;
+}
+
+/**
+ * @brief Observer counting authenticated frames per source ID
+ */
+class AuthenticatedFrameObserver : public NSEZSP::CGpObserver {
+public:
+	void handleRxGpFrame(const NSEZSP::CGpFrameView& i_gpf) override {
+		this->sourceIds.push_back(i_gpf.getSourceId());
+	}
+
+	void handleRxGpdId(uint32_t& i_gpd_id, bool i_gpd_known, NSEZSP::CGpdKeyStatus i_gpd_key_status) override {
+	}
+
+	unsigned int count(uint32_t sourceId) const {
+		return static_cast<unsigned int>(std::count(this->sourceIds.begin(), this->sourceIds.end(), sourceId));
+	}
+
+	std::vector<uint32_t> sourceIds;
+};
+
+/**
+ * @brief Respond, as an adapter with empty GP tables would, to the EZSP commands that read these tables
+ */
+void acknowledgeTablesLoad(NSEZSP::CGpSink& sink) {
+	/* EMBER_INDEX_OUT_OF_RANGE at the first index of both tables ends their loading */
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GP_SINK_TABLE_GET_ENTRY, { 0xB1 });
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GP_PROXY_TABLE_GET_ENTRY, { 0xB1 });
+}
+
+/**
+ * @brief Respond, as the adapter would, to the EZSP commands that add a device to the sink table
+ */
+void acknowledgePromotion(NSEZSP::CGpSink& sink, uint8_t index) {
+	NSSPI::ByteBuffer entry({ 0x00, 0xFF });	/* EMBER_SUCCESS, unused entry */
+	/* Options, GPD address, device ID, sink list, alias, groupcast radius, security options, frame counter and key, all blank */
+	entry.resize(entry.size() + 2 + 10 + 1 + NSEZSP::GP_SINK_LIST_ENTRIES * NSEZSP::EMBER_GP_SINK_LIST_ENTRY_SIZE + 2 + 1 + 1 + 4 + 16, 0x00);
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY, { index });
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GP_SINK_TABLE_GET_ENTRY, entry);
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GP_SINK_TABLE_SET_ENTRY, { 0x00 });
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING, { 0x01 });
+}
+
+/**
+ * @brief Respond, as the adapter would, to the EZSP commands that remove a device from the sink and proxy tables
+ */
+void acknowledgeDemotion(NSEZSP::CGpSink& sink) {
+	/* The entries to remove are found in the host-side copies of the adapter's tables */
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GP_SINK_TABLE_REMOVE_ENTRY, {});
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GP_PROXY_TABLE_PROCESS_GP_PAIRING, { 0x00 });
+}
+}
+
+TEST(gp_sink_placement_tests, sink_hybrid_mode) {
+	const uint32_t deviceA = 0x0100000a;
+	const uint32_t deviceB = 0x0100000b;
+	const uint32_t deviceC = 0x0100000c;
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+
+	NSSPI::ByteBuffer reference(knownEzspMsg);
+	if (computeMic(NSEZSP::CGpFrame(reference), knownKey) != NSEZSP::CGpFrame(reference).getMic()) {
+		FAILF("MIC computation of the test does not match the reference frame");
+	}
+
+	NSSPI::TimerBuilder timerBuilder;
+	NSEZSP::CEzspDongle dongle(timerBuilder);	/* Never opened: frames and adapter responses are directly injected into the sink */
+	NSEZSP::CZigbeeMessaging zbMessaging(dongle, timerBuilder);
+	NSEZSP::CGpSink sink(dongle, zbMessaging, timerBuilder, 16);
+	AuthenticatedFrameObserver observer;
+	sink.registerObserver(&observer);
+	sink.init();
+	acknowledgeTablesLoad(sink);
+	sink.registerGpds({ NSEZSP::CGpDevice(deviceA, knownKey), NSEZSP::CGpDevice(deviceB, knownKey), NSEZSP::CGpDevice(deviceC, knownKey) });
+	if (!sink.setNcpSinkTableSize(2, std::chrono::milliseconds(0))) {	/* Each burst of frames is an epoch */
+		FAILF("Hybrid mode should be available when MICs are processed on the host");
+	}
+
+	uint32_t frameCounter = 1;
+	auto sendBurst = [&sink, &frameCounter](const std::vector<std::pair<uint32_t, unsigned int>>& traffic) {
+		for (const auto& device : traffic) {
+			for (unsigned int frame = 0; frame < device.second; frame++) {
+				/* The adapter does not know these devices yet: it reports other statuses than EMBER_SUCCESS */
+				sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeEzspMsg(device.first, frameCounter++, WRONG_MIC_STATUS, true));
+			}
+		}
+		sink.handleEzspRxBurstEnd();
+	};
+
+	/* A and B are the most active devices, they are moved to the adapter (A first) */
+	sendBurst({ { deviceA, 8 }, { deviceB, 6 }, { deviceC, 1 } });
+	if (observer.count(deviceA) != 8 || observer.count(deviceB) != 6 || observer.count(deviceC) != 1) {
+		FAILF("All frames should be authenticated by the host");
+	}
+	acknowledgePromotion(sink, 0);
+	acknowledgePromotion(sink, 1);
+
+	/* Frames from A are now authenticated by the adapter: the host does not check their MIC anymore, only their frame counter */
+	observer.sourceIds.clear();
+	uint32_t aCounter = frameCounter++;
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeEzspMsg(deviceA, aCounter, 0x00, false));
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeEzspMsg(deviceA, aCounter, 0x00, false));	/* Duplicate */
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeEzspMsg(deviceA, frameCounter++, WRONG_MIC_STATUS, false));
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeEzspMsg(deviceC, frameCounter++, 0x00, false));
+	sink.handleEzspRxBurstEnd();
+	if (observer.count(deviceA) != 1 || sink.getNbNcpValidatedRxGpFrames() != 1 || sink.getNbDroppedDuplicateRxGpFrames() != 1) {
+		FAILF("Frames authenticated by the adapter should be accepted once, got %u frames", observer.count(deviceA));
+	}
+	if (observer.count(deviceC) != 0) {
+		FAILF("Frames from a device that is not in the adapter's sink table should be authenticated by the host");
+	}
+
+	/* C becomes by far the most active device while B stops sending: C takes B's place */
+	for (unsigned int epoch = 0; epoch < 4; epoch++) {
+		sendBurst({ { deviceA, 8 }, { deviceC, 30 } });
+		if (epoch == 0) {
+			acknowledgeDemotion(sink);
+			acknowledgePromotion(sink, 1);
+		}
+	}
+	observer.sourceIds.clear();
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeEzspMsg(deviceB, frameCounter++, 0x00, false));
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeEzspMsg(deviceC, frameCounter++, 0x00, false));
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeEzspMsg(deviceA, frameCounter++, 0x00, false));
+	sink.handleEzspRxBurstEnd();
+	if (observer.count(deviceB) != 0 || observer.count(deviceC) != 1 || observer.count(deviceA) != 1) {
+		FAILF("B should have been moved back to the host, and C into the adapter's sink table");
+	}
+
+	/* Removing a device from the sink moves it out of the adapter's sink table */
+	sink.removeGpds({ deviceC });
+	sink.handleEzspRxBurstEnd();	/* Nothing queued: moves start on the next burst of frames */
+	sendBurst({ { deviceA, 1 } });
+	acknowledgeDemotion(sink);
+	observer.sourceIds.clear();
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, forgeEzspMsg(deviceC, frameCounter++, 0x00, false));
+	sink.handleEzspRxBurstEnd();
+	if (observer.count(deviceC) != 0) {
+		FAILF("Frames from a removed device should not be accepted");
+	}
+	sink.unregisterObserver(&observer);
+	NOTIFYPASS();
+}
+#endif
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_sink_placement() {
+	promotes_most_active();
+	hysteresis_prevents_flapping();
+	limits_and_forgetting();
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	sink_hybrid_mode();
+#endif
+}
+#endif	// USE_CPPUTEST
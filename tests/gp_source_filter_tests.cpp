@@ -0,0 +1,332 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <set>
+#include <random>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+
+#include <unistd.h>
+
+#include "spi/TimerBuilder.h"
+#include "spi/ByteBuffer.h"
+#include "spi/Logger.h"
+#include "spi/ILogger.h"
+#include "ezsp/ezsp-dongle.h"
+#include "ezsp/zigbee-tools/zigbee-messaging.h"
+#include "ezsp/zigbee-tools/green-power-sink.h"
+#include "ezsp/zigbee-tools/green-power-device-db.h"
+#include "ezsp/zigbee-tools/green-power-source-id-filter.h"
+
+#include "TestHarness.h"
+
+using NSSPI::Logger;
+using NSSPI::LOG_LEVEL;
+
+namespace {
+/* The secured GP frame also used in green_power_frame_tests.cpp (source ID 0x0054000a) */
+const NSSPI::ByteBuffer knownEzspMsg({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x02, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0xa2, 0xb5, 0x92, 0x23, 0x4e, 0x00, 0x11, 0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30});
+const NSEZSP::EmberKeyData knownKey({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5F});
+const unsigned int SOURCE_ID_OFFSET = 4;	/* Offset of the little endian source ID in knownEzspMsg */
+const unsigned int SECURITY_LEVEL_OFFSET = 13;	/* Offset of the security level in knownEzspMsg */
+const unsigned int FRAME_COUNTER_OFFSET = 17;	/* Offset of the little endian security frame counter in knownEzspMsg */
+const unsigned int COMMAND_ID_OFFSET = 21;	/* Offset of the command ID in knownEzspMsg */
+const unsigned int PROXY_TABLE_ENTRY_OFFSET = 26;	/* Offset of the adapter's proxy table index in knownEzspMsg */
+const uint32_t FIRST_KNOWN_SOURCE_ID = 0x01000000;
+
+/**
+ * @brief Forge the EZSP incoming GP frame message for another source ID, based on knownEzspMsg
+ *
+ * @param sourceId The source ID
+ * @param proxyTableEntry The index in the adapter's proxy table (0xFF if the adapter does not know the device)
+ * @param frameCounter The security frame counter
+ */
+NSSPI::ByteBuffer forgeEzspMsg(uint32_t sourceId, uint8_t proxyTableEntry, uint32_t frameCounter) {
+	NSSPI::ByteBuffer ezspMsg(knownEzspMsg);
+	ezspMsg[SOURCE_ID_OFFSET] = static_cast<uint8_t>(sourceId & 0xffU);
+	ezspMsg[SOURCE_ID_OFFSET + 1] = static_cast<uint8_t>((sourceId >> 8) & 0xffU);
+	ezspMsg[SOURCE_ID_OFFSET + 2] = static_cast<uint8_t>((sourceId >> 16) & 0xffU);
+	ezspMsg[SOURCE_ID_OFFSET + 3] = static_cast<uint8_t>((sourceId >> 24) & 0xffU);
+	ezspMsg[PROXY_TABLE_ENTRY_OFFSET] = proxyTableEntry;
+	ezspMsg[FRAME_COUNTER_OFFSET] = static_cast<uint8_t>(frameCounter & 0xffU);
+	ezspMsg[FRAME_COUNTER_OFFSET + 1] = static_cast<uint8_t>((frameCounter >> 8) & 0xffU);
+	ezspMsg[FRAME_COUNTER_OFFSET + 2] = static_cast<uint8_t>((frameCounter >> 16) & 0xffU);
+	ezspMsg[FRAME_COUNTER_OFFSET + 3] = static_cast<uint8_t>((frameCounter >> 24) & 0xffU);
+	return ezspMsg;
+}
+
+/**
+ * @brief Draw random source IDs outside of the range of known source IDs
+ */
+std::vector<uint32_t> foreignSourceIds(std::size_t count, uint32_t nbKnown, std::mt19937& rng) {
+	std::vector<uint32_t> result;
+	result.reserve(count);
+	while (result.size() < count) {
+		uint32_t sourceId = static_cast<uint32_t>(rng());
+		if (sourceId != 0 && (sourceId < FIRST_KNOWN_SOURCE_ID || sourceId >= FIRST_KNOWN_SOURCE_ID + nbKnown)) {
+			result.push_back(sourceId);
+		}
+	}
+	return result;
+}
+
+/**
+ * @brief Observer counting notifications from the sink
+ */
+class CountingObserver : public NSEZSP::CGpObserver {
+public:
+	CountingObserver() : nbRxGpFrames(0), nbKnownRxGpdIds(0), nbForeignRxGpdIds(0), nbKnown(0) { }
+
+	void handleRxGpFrame(const NSEZSP::CGpFrameView& i_gpf) override {
+		this->nbRxGpFrames++;
+	}
+
+	void handleRxGpdId(uint32_t& i_gpd_id, bool i_gpd_known, NSEZSP::CGpdKeyStatus i_gpd_key_status) override {
+		if (i_gpd_id >= FIRST_KNOWN_SOURCE_ID && i_gpd_id < FIRST_KNOWN_SOURCE_ID + this->nbKnown) {
+			this->nbKnownRxGpdIds++;
+		}
+		else {
+			this->nbForeignRxGpdIds++;
+		}
+	}
+
+	void reset(uint32_t nbKnown) {
+		this->nbRxGpFrames = 0;
+		this->nbKnownRxGpdIds = 0;
+		this->nbForeignRxGpdIds = 0;
+		this->nbKnown = nbKnown;
+	}
+
+	unsigned int nbRxGpFrames;
+	unsigned int nbKnownRxGpdIds;
+	unsigned int nbForeignRxGpdIds;
+
+private:
+	uint32_t nbKnown;
+};
+}
+
+TEST_GROUP(gp_source_filter_tests) {
+};
+
+TEST(gp_source_filter_tests, filter_false_positive_rate) {
+	static constexpr unsigned int NB_INSERTED = 10000;
+	static constexpr unsigned int NB_PROBES = 200000;
+	std::mt19937 rng(0xb100);
+	std::set<uint32_t> inserted;
+	NSEZSP::CGpSourceIdFilter filter;
+
+	if (filter.mayContain(FIRST_KNOWN_SOURCE_ID)) {
+		FAILF("A filter that has not been sized should not contain anything");
+	}
+	filter.reset(NB_INSERTED);
+	for (uint32_t index = 0; index < NB_INSERTED; index++) {	/* Half sequential (typical of a production batch of devices), half random */
+		uint32_t sourceId = (index % 2 == 0) ? FIRST_KNOWN_SOURCE_ID + index : static_cast<uint32_t>(rng());
+		filter.insert(sourceId);
+		inserted.insert(sourceId);
+	}
+	for (uint32_t sourceId : inserted) {
+		if (!filter.mayContain(sourceId)) {
+			FAILF("Source ID 0x%08x has been inserted but is not in the filter", sourceId);
+		}
+	}
+	unsigned int nbFalsePositives = 0;
+	unsigned int nbProbes = 0;
+	while (nbProbes < NB_PROBES) {
+		uint32_t sourceId = (nbProbes % 2 == 0) ? FIRST_KNOWN_SOURCE_ID + NB_INSERTED + nbProbes : static_cast<uint32_t>(rng());
+		if (inserted.count(sourceId) != 0) {
+			continue;
+		}
+		nbProbes++;
+		if (filter.mayContain(sourceId)) {
+			nbFalsePositives++;
+		}
+	}
+	double rate = static_cast<double>(nbFalsePositives) / NB_PROBES;
+	std::cout << "Source ID filter false positive rate with " << std::dec << NB_INSERTED << " source IDs: " << std::fixed << std::setprecision(3)
+	          << (rate * 100) << "% (" << filter.memoryFootprint() << " bytes)\n";
+	std::cout.unsetf(std::ios_base::floatfield);
+	if (rate > 0.005) {
+		FAILF("False positive rate is too high: %u out of %u", nbFalsePositives, NB_PROBES);
+	}
+	filter.reset(NB_INSERTED);
+	for (uint32_t sourceId : inserted) {
+		if (filter.mayContain(sourceId)) {
+			FAILF("Source ID 0x%08x should not be in the filter anymore after reset()", sourceId);
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_source_filter_tests, device_db_filter_tracks_content) {
+	static constexpr unsigned int NB_SOURCE_IDS = 2000;
+	std::mt19937 rng(0xb101);
+	std::set<uint32_t> reference;
+#ifdef USE_STATIC_ALLOCATION
+	NSEZSP::CGPDeviceDb db(NB_SOURCE_IDS);
+#else
+	NSEZSP::CGPDeviceDb db(0);	/* Grows, so the filter is rebuilt on the way */
+#endif
+
+	for (unsigned int operation = 0; operation < 4 * NB_SOURCE_IDS; operation++) {
+		uint32_t sourceId = FIRST_KNOWN_SOURCE_ID + static_cast<uint32_t>(rng() % NB_SOURCE_IDS);
+		if (operation >= NB_SOURCE_IDS && rng() % 2 == 0) {
+			db.removeDevice(sourceId);
+			reference.erase(sourceId);
+		}
+		else {
+			db.insertDevice(sourceId, knownKey);
+			reference.insert(sourceId);
+		}
+	}
+	for (uint32_t sourceId : reference) {
+		if (!db.mayContain(sourceId)) {
+			FAILF("Source ID 0x%08x is in the database but not in its filter", sourceId);
+		}
+	}
+	db.clear();
+	for (uint32_t sourceId : reference) {
+		if (db.mayContain(sourceId)) {
+			FAILF("Source ID 0x%08x should not be in the filter of an empty database", sourceId);
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_source_filter_tests, sink_drops_foreign_traffic) {
+	static constexpr unsigned int NB_KNOWN = 1000;
+	static constexpr unsigned int NB_FRAMES = 100000;
+	static constexpr unsigned int FOREIGN_PERCENT = 90;
+	static constexpr unsigned int FRAMES_PER_BURST = 8;	/* Frames decoded from one serial read */
+	static constexpr unsigned int SAMPLE_INTERVAL = 10;
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);	/* Same log level as a production gateway */
+	std::mt19937 rng(0xf0e1);
+
+	/* 10% of the traffic comes from our devices, 90% from neighbours' devices, in random order */
+	std::vector<NSSPI::ByteBuffer> frames;
+	frames.reserve(NB_FRAMES);
+	std::vector<uint32_t> foreign = foreignSourceIds(NB_FRAMES * FOREIGN_PERCENT / 100, NB_KNOWN, rng);
+	for (uint32_t sourceId : foreign) {
+		frames.push_back(forgeEzspMsg(sourceId, 0xFF, static_cast<uint32_t>(frames.size())));
+	}
+	while (frames.size() < NB_FRAMES) {
+		uint32_t index = static_cast<uint32_t>(frames.size() % NB_KNOWN);
+		frames.push_back(forgeEzspMsg(FIRST_KNOWN_SOURCE_ID + index, static_cast<uint8_t>(index % 0xFE), static_cast<uint32_t>(frames.size())));	/* Distinct frame counters: not copies of each other */
+	}
+	std::shuffle(frames.begin(), frames.end(), rng);
+	const unsigned int nbForeign = static_cast<unsigned int>(foreign.size());
+	const unsigned int nbKnownFrames = NB_FRAMES - nbForeign;
+
+	NSSPI::TimerBuilder timerBuilder;
+	NSEZSP::CEzspDongle dongle(timerBuilder);	/* Never opened: frames are directly injected into the sink */
+	NSEZSP::CZigbeeMessaging zbMessaging(dongle, timerBuilder);
+	NSEZSP::CGpSink sink(dongle, zbMessaging, timerBuilder, NB_KNOWN);
+	CountingObserver observer;
+	sink.registerObserver(&observer);
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	/* The host database must know our devices (the adapter's proxy table index carried by frames is not used) */
+	char directory[] = "/tmp/gp-source-filter-XXXXXX";
+	if (::mkdtemp(directory) == nullptr) {
+		FAILF("Cannot create a temporary directory");
+	}
+	std::string storePath = std::string(directory) + "/gpdevices.db";
+	{
+		NSEZSP::CGPDeviceDb db(NB_KNOWN);
+		std::vector<NSEZSP::CGpDevice> devices;
+		for (uint32_t index = 0; index < NB_KNOWN; index++) {
+			devices.push_back(NSEZSP::CGpDevice(FIRST_KNOWN_SOURCE_ID + index, knownKey));
+		}
+		if (!db.openStore(storePath)) {
+			FAILF("Could not create a store");
+		}
+		db.setDb(devices);
+	}
+	if (!sink.openDeviceStore(storePath)) {
+		FAILF("Could not load the device store into the sink");
+	}
+#endif
+
+	auto runPass = [&frames, &sink, &observer](NSEZSP::CGpUnknownSourcePolicy policy) -> double {
+		sink.setUnknownSourcePolicy(policy, SAMPLE_INTERVAL);
+		observer.reset(NB_KNOWN);
+		for (NSSPI::ByteBuffer& frame : frames) {
+			frame[FRAME_COUNTER_OFFSET + 3]++;	/* Each pass sends new frames, rather than copies of the frames of the previous pass */
+		}
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		for (std::size_t index = 0; index < frames.size(); index++) {
+			sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, frames[index]);
+			if (index % FRAMES_PER_BURST == FRAMES_PER_BURST - 1) {
+				sink.handleEzspRxBurstEnd();
+			}
+		}
+		sink.handleEzspRxBurstEnd();
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	};
+
+	double processSeconds = runPass(NSEZSP::CGpUnknownSourcePolicy::Process);
+	if (observer.nbKnownRxGpdIds + observer.nbForeignRxGpdIds != NB_FRAMES || sink.getNbFilteredRxGpFrames() != 0) {
+		FAILF("Observers should be notified exactly once of the source ID of each frame, got %u notifications for %u frames",
+		      observer.nbKnownRxGpdIds + observer.nbForeignRxGpdIds, NB_FRAMES);
+	}
+
+	double dropSeconds = runPass(NSEZSP::CGpUnknownSourcePolicy::Drop);
+	unsigned int nbFalsePositives = observer.nbForeignRxGpdIds;	/* Foreign source IDs that the Bloom filter could not rule out */
+	if (observer.nbKnownRxGpdIds != nbKnownFrames) {
+		FAILF("Frames from known devices should never be dropped, got %u out of %u", observer.nbKnownRxGpdIds, nbKnownFrames);
+	}
+	if (nbFalsePositives > nbForeign / 200 || sink.getNbFilteredRxGpFrames() != nbForeign - nbFalsePositives) {
+		FAILF("Frames from foreign devices should be dropped, got %u out of %u", nbForeign - nbFalsePositives, nbForeign);
+	}
+#ifndef USE_BUILTIN_MIC_PROCESSING
+	if (nbFalsePositives != 0) {
+		FAILF("Source IDs are checked using the adapter's proxy table, there should not be any false positive");
+	}
+#endif
+
+	std::size_t nbFilteredBefore = sink.getNbFilteredRxGpFrames();
+	runPass(NSEZSP::CGpUnknownSourcePolicy::Sample);
+	unsigned int nbSampled = observer.nbForeignRxGpdIds - nbFalsePositives;
+	unsigned int nbUnknown = nbForeign - nbFalsePositives;	/* Frames subject to sampling */
+	if (nbSampled < nbUnknown / SAMPLE_INTERVAL - 1 || nbSampled > nbUnknown / SAMPLE_INTERVAL + 1
+	        || sink.getNbFilteredRxGpFrames() - nbFilteredBefore != nbForeign - observer.nbForeignRxGpdIds) {
+		FAILF("One out of %u frames from foreign devices should be processed, got %u out of %u", SAMPLE_INTERVAL, nbSampled, nbUnknown);
+	}
+
+	/* Unknown devices asking to be commissioned are not dropped */
+	NSSPI::ByteBuffer commissioning(forgeEzspMsg(foreign.front(), 0xFF, 0));
+	commissioning[SECURITY_LEVEL_OFFSET] = 0x00;
+	commissioning[COMMAND_ID_OFFSET] = 0xE0;
+	sink.setUnknownSourcePolicy(NSEZSP::CGpUnknownSourcePolicy::Drop);
+	observer.reset(NB_KNOWN);
+	sink.handleEzspRxMessage(NSEZSP::EEzspCmd::EZSP_GPEP_INCOMING_MESSAGE_HANDLER, commissioning);
+	sink.handleEzspRxBurstEnd();
+	if (observer.nbForeignRxGpdIds != 1) {
+		FAILF("Commissioning frames from unknown devices should not be dropped");
+	}
+
+	std::cout << "GP frames with " << std::dec << FOREIGN_PERCENT << "% foreign traffic: " << std::fixed << std::setprecision(0)
+	          << (NB_FRAMES / processSeconds) << " frames/s when processing all frames, "
+	          << (NB_FRAMES / dropSeconds) << " frames/s when dropping unknown source IDs ("
+	          << std::setprecision(1) << (processSeconds / dropSeconds) << "x)\n";
+	std::cout.unsetf(std::ios_base::floatfield);
+	if (dropSeconds > processSeconds) {
+		FAILF("Dropping frames from unknown source IDs should be faster than processing them");
+	}
+	sink.unregisterObserver(&observer);
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	::unlink(storePath.c_str());
+	::unlink((storePath + ".log").c_str());
+	::rmdir(directory);
+#endif
+	NOTIFYPASS();
+}
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_source_filter() {
+	filter_false_positive_rate();
+	device_db_filter_tracks_content();
+	sink_drops_foreign_traffic();
+}
+#endif	// USE_CPPUTEST
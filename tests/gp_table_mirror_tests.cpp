@@ -0,0 +1,231 @@
+#include <iostream>
+#include <vector>
+#include <map>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+
+#include "ezsp/zigbee-tools/green-power-table-mirror.h"
+
+#include "TestHarness.h"
+
+using NSEZSP::CGpTableMirror;
+
+namespace {
+/**
+ * @brief Build an active entry for a device
+ */
+CGpTableMirror::Entry activeEntry(uint32_t i_source_id, uint32_t i_options) {
+	CGpTableMirror::Entry entry = CGpTableMirror::Entry();
+	entry.status = CGpTableMirror::EntryStatus::ACTIVE;
+	entry.sourceId = i_source_id;
+	entry.options = i_options;
+	return entry;
+}
+
+/**
+ * @brief Load a mirror with a table of i_size entries, the first ones being used by i_source_ids
+ */
+void loadMirror(CGpTableMirror& mirror, std::size_t i_size, const std::vector<uint32_t>& i_source_ids) {
+	mirror.startLoad();
+	for (std::size_t index = 0; index < i_size; index++) {
+		CGpTableMirror::Entry entry = CGpTableMirror::Entry();
+		if (index < i_source_ids.size()) {
+			entry = activeEntry(i_source_ids[index], 0x0000e548);
+		}
+		mirror.loadEntry(static_cast<uint8_t>(index), entry);
+	}
+	mirror.endLoad();
+}
+
+/**
+ * @brief Check that a mirror holds exactly the entries of a reference table (index -> source ID)
+ */
+void checkMirror(const CGpTableMirror& mirror, const std::map<uint8_t, uint32_t>& reference) {
+	if (mirror.getNbUsedEntries() != reference.size()) {
+		FAILF("Mirror has %zu used entries, expected %zu", mirror.getNbUsedEntries(), reference.size());
+	}
+	for (const auto& entry : reference) {
+		if (mirror.find(entry.second) != entry.first) {
+			FAILF("Source ID 0x%08x should be found at index %u", entry.second, entry.first);
+		}
+		if (mirror.isBlank(entry.first)) {
+			FAILF("Entry %u should not be blank", entry.first);
+		}
+	}
+	std::vector<uint32_t> usedSourceIds;
+	mirror.getUsedSourceIds(usedSourceIds);
+	if (usedSourceIds.size() != reference.size()) {
+		FAILF("Listed %zu used source IDs, expected %zu", usedSourceIds.size(), reference.size());
+	}
+}
+}
+
+TEST_GROUP(gp_table_mirror_tests) {
+};
+
+TEST(gp_table_mirror_tests, mirror_load_and_find) {
+	CGpTableMirror mirror;
+
+	if (mirror.isLoaded() || mirror.isBlank(0) || mirror.find(0x0050abcd) != CGpTableMirror::NO_ENTRY) {
+		FAILF("A mirror that has not been loaded should not know anything");
+	}
+	loadMirror(mirror, 32, { 0x0050abcd, 0x01000001, 0x01000002 });
+	if (!mirror.isLoaded() || mirror.size() != 32) {
+		FAILF("Mirror should be loaded with 32 entries");
+	}
+	checkMirror(mirror, { { 0, 0x0050abcd }, { 1, 0x01000001 }, { 2, 0x01000002 } });
+	if (!mirror.isBlank(3) || !mirror.isBlank(31) || mirror.find(0x01000003) != CGpTableMirror::NO_ENTRY) {
+		FAILF("Unused entries should be blank");
+	}
+	if (mirror.getEntry(1).options != 0x0000e548 || mirror.getEntry(200).status != CGpTableMirror::EntryStatus::FREE) {
+		FAILF("Wrong entry content");
+	}
+
+	/* Loading again forgets the previous content */
+	mirror.startLoad();
+	if (mirror.isLoaded() || mirror.getNbUsedEntries() != 0 || mirror.find(0x0050abcd) != CGpTableMirror::NO_ENTRY) {
+		FAILF("Mirror should be empty after startLoad()");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_table_mirror_tests, mirror_sink_table_updates) {
+	CGpTableMirror mirror;
+	loadMirror(mirror, 8, { 0x01000001 });
+
+	/* GP_SINK_TABLE_FIND_OR_ALLOCATE_ENTRY then GP_SINK_TABLE_SET_ENTRY */
+	mirror.allocateEntry(1, 0x01000002);
+	if (mirror.find(0x01000002) != 1 || mirror.getEntry(1).status != CGpTableMirror::EntryStatus::ALLOCATED) {
+		FAILF("Allocated entry should be reserved");
+	}
+	if (!mirror.isBlank(1)) {
+		FAILF("Allocated entry has not been written yet, its content is still blank");
+	}
+	mirror.allocateEntry(0, 0x01000003);
+	if (mirror.find(0x01000003) != CGpTableMirror::NO_ENTRY || mirror.find(0x01000001) != 0) {
+		FAILF("Allocating a used entry should not change it");
+	}
+	mirror.setEntry(1, activeEntry(0x01000002, 0x0000a548));
+	if (mirror.getEntry(1).status != CGpTableMirror::EntryStatus::ACTIVE || mirror.getEntry(1).options != 0x0000a548) {
+		FAILF("Entry should be active after being set");
+	}
+	/* Overwriting an entry with another device */
+	mirror.setEntry(0, activeEntry(0x01000004, 0));
+	checkMirror(mirror, { { 0, 0x01000004 }, { 1, 0x01000002 } });
+	if (mirror.find(0x01000001) != CGpTableMirror::NO_ENTRY) {
+		FAILF("Overwritten device should not be found anymore");
+	}
+	/* Writing beyond the loaded size grows the table */
+	mirror.setEntry(10, activeEntry(0x01000005, 0));
+	if (mirror.size() != 11 || mirror.find(0x01000005) != 10) {
+		FAILF("Table should grow when an entry is written beyond its size");
+	}
+
+	mirror.removeEntry(1);
+	mirror.removeEntry(1);
+	mirror.removeEntry(100);
+	checkMirror(mirror, { { 0, 0x01000004 }, { 10, 0x01000005 } });
+	if (!mirror.isBlank(1)) {
+		FAILF("Removed entry should be blank");
+	}
+
+	mirror.clear();
+	if (!mirror.isLoaded() || mirror.getNbUsedEntries() != 0 || !mirror.isBlank(0) || mirror.find(0x01000004) != CGpTableMirror::NO_ENTRY) {
+		FAILF("Cleared mirror should stay loaded, with all entries blank");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_table_mirror_tests, mirror_proxy_table_updates) {
+	CGpTableMirror mirror;
+	loadMirror(mirror, 4, { 0x01000001, 0x01000002 });
+
+	/* GP_PROXY_TABLE_PROCESS_GP_PAIRING does not tell which entry is used, the adapter takes the first free one */
+	if (mirror.addEntry(activeEntry(0x01000003, 0x1)) != 2 || mirror.addEntry(activeEntry(0x01000001, 0x2)) != 0) {
+		FAILF("New devices should take the first free entry, known devices keep their entry");
+	}
+	if (mirror.getEntry(0).options != 0x2) {
+		FAILF("Options of a known device should be updated");
+	}
+	mirror.removeEntry(1);
+	if (mirror.addEntry(activeEntry(0x01000004, 0)) != 1 || mirror.addEntry(activeEntry(0x01000005, 0)) != 3) {
+		FAILF("Freed entries should be reused first");
+	}
+	if (mirror.addEntry(activeEntry(0x01000006, 0)) != CGpTableMirror::NO_ENTRY) {
+		FAILF("A loaded table that is full cannot take more devices");
+	}
+	if (mirror.removeSourceId(0x01000003) != 1 || mirror.removeSourceId(0x01000003) != 0) {
+		FAILF("Removing a device should remove exactly its entry");
+	}
+	checkMirror(mirror, { { 0, 0x01000001 }, { 1, 0x01000004 }, { 3, 0x01000005 } });
+
+	/* Before the load completes, the table size is unknown and the mirror grows */
+	CGpTableMirror partial;
+	if (partial.addEntry(activeEntry(0x01000001, 0)) != 0 || partial.addEntry(activeEntry(0x01000002, 0)) != 1 || partial.size() != 2) {
+		FAILF("A mirror that is not loaded should grow");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_table_mirror_tests, mirror_duplicate_source_ids) {
+	CGpTableMirror mirror;
+	loadMirror(mirror, 8, { 0x01000001, 0x01000002, 0x01000001 });
+
+	/* Two entries for the same device (e.g. after an adapter firmware bug), the first one is found */
+	if (mirror.find(0x01000001) != 0 || mirror.getNbUsedEntries() != 3) {
+		FAILF("The first of the duplicate entries should be found");
+	}
+	mirror.removeEntry(0);
+	if (mirror.find(0x01000001) != 2) {
+		FAILF("The remaining duplicate entry should be found after the first one is removed");
+	}
+	mirror.setEntry(5, activeEntry(0x01000001, 0));
+	if (mirror.removeSourceId(0x01000001) != 2 || mirror.getNbUsedEntries() != 1) {
+		FAILF("All entries of a device should be removed");
+	}
+	checkMirror(mirror, { { 1, 0x01000002 } });
+	NOTIFYPASS();
+}
+
+TEST(gp_table_mirror_tests, mirror_random_operations) {
+	static constexpr unsigned int NB_OPERATIONS = 20000;
+	std::mt19937 random(42);
+	CGpTableMirror mirror;
+	std::map<uint8_t, uint32_t> reference;
+	loadMirror(mirror, CGpTableMirror::MAX_ENTRIES, {});
+
+	/* Source IDs are drawn from a small range with a common stride, so that probe sequences collide */
+	for (unsigned int operation = 0; operation < NB_OPERATIONS; operation++) {
+		uint8_t index = static_cast<uint8_t>(random() % CGpTableMirror::MAX_ENTRIES);
+		uint32_t sourceId = 0x01000000 + static_cast<uint32_t>(random() % 400) * 0x100;
+		if (random() % 3 == 0) {
+			mirror.removeEntry(index);
+			reference.erase(index);
+		}
+		else if (mirror.find(sourceId) == CGpTableMirror::NO_ENTRY) {
+			mirror.setEntry(index, activeEntry(sourceId, 0));
+			reference[index] = sourceId;
+		}
+	}
+	checkMirror(mirror, reference);
+	for (uint32_t sourceId = 0x01000000; sourceId < 0x01000000 + 400 * 0x100; sourceId += 0x100) {
+		bool used = std::any_of(reference.begin(), reference.end(), [sourceId](const std::pair<const uint8_t, uint32_t>& entry) {
+			return entry.second == sourceId;
+		});
+		if (used != (mirror.find(sourceId) != CGpTableMirror::NO_ENTRY)) {
+			FAILF("Source ID 0x%08x should %sbe found", sourceId, used ? "" : "not ");
+		}
+	}
+	NOTIFYPASS();
+}
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_table_mirror() {
+	mirror_load_and_find();
+	mirror_sink_table_updates();
+	mirror_proxy_table_updates();
+	mirror_duplicate_source_ids();
+	mirror_random_operations();
+}
+#endif	// USE_CPPUTEST
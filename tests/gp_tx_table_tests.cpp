@@ -0,0 +1,149 @@
+#include <iostream>
+#include <vector>
+#include <set>
+#include <chrono>
+#include <cstdint>
+
+#include "ezsp/zigbee-tools/green-power-tx-table.h"
+
+#include "TestHarness.h"
+
+using NSEZSP::CGpTxTable;
+using NSEZSP::CGpTxConfirmation;
+
+namespace {
+const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::time_point() + std::chrono::hours(1);
+
+/**
+ * @brief Allocate a handle, failing the test if none is available
+ */
+uint8_t allocateOrFail(CGpTxTable& table, uint32_t i_source_id, std::chrono::steady_clock::time_point i_now, std::chrono::milliseconds i_timeout, CGpTxTable::FSentCallback i_callback = nullptr) {
+	uint8_t handle = CGpTxTable::NO_HANDLE;
+	if (!table.allocate(i_source_id, 0xF3, i_now, i_timeout, i_callback, handle)) {
+		FAILF("No handle available for source ID 0x%08x", i_source_id);
+	}
+	return handle;
+}
+}
+
+TEST_GROUP(gp_tx_table_tests) {
+};
+
+TEST(gp_tx_table_tests, tx_table_handles) {
+	CGpTxTable table(4);
+	std::set<uint8_t> handles;
+	for (uint32_t i = 0; i < 4; i++) {
+		handles.insert(allocateOrFail(table, 0x01000000 + i, t0, std::chrono::milliseconds(1000)));
+	}
+	if (handles.size() != 4 || handles.count(CGpTxTable::NO_HANDLE) != 0 || table.getNbPending() != 4) {
+		FAILF("Each pending transmission should get its own handle, never NO_HANDLE");
+	}
+	uint8_t handle;
+	if (table.allocate(0x01000004, 0xF3, t0, std::chrono::milliseconds(1000), nullptr, handle)) {
+		FAILF("No handle should be available once all of them are in use");
+	}
+	if (!table.isPending(0x01000002, 0xF3) || table.isPending(0x01000002, 0xF2) || table.isPending(0x01000004, 0xF3)) {
+		FAILF("Wrong pending transmissions");
+	}
+
+	/* A released handle is only reused once all other free handles have been used */
+	CGpTxConfirmation confirmation;
+	CGpTxTable::FSentCallback callback;
+	uint8_t released = *handles.begin();
+	if (!table.confirm(released, NSEZSP::EEmberStatus::EMBER_SUCCESS, t0, confirmation, callback) || confirmation.sourceId != 0x01000000) {
+		FAILF("Confirming a pending handle should return its transmission");
+	}
+	if (table.confirm(released, NSEZSP::EEmberStatus::EMBER_SUCCESS, t0, confirmation, callback) || table.confirm(CGpTxTable::NO_HANDLE, NSEZSP::EEmberStatus::EMBER_SUCCESS, t0, confirmation, callback)) {
+		FAILF("Unknown handles should not be confirmed");
+	}
+	CGpTxTable large(8);
+	uint8_t first = allocateOrFail(large, 0x01000000, t0, std::chrono::milliseconds(1000));
+	large.cancel(first);
+	for (uint32_t i = 1; i < 8; i++) {
+		if (allocateOrFail(large, 0x01000000 + i, t0, std::chrono::milliseconds(1000)) == first) {
+			FAILF("Handle %u was reused too early", first);
+		}
+	}
+	if (allocateOrFail(large, 0x01000008, t0, std::chrono::milliseconds(1000)) != first) {
+		FAILF("The released handle should be reused last");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_tx_table_tests, tx_table_expiry) {
+	CGpTxTable table;
+	std::vector<uint32_t> outcomes;
+	auto record = [&outcomes](const CGpTxConfirmation& i_confirmation) {
+		outcomes.push_back(i_confirmation.sourceId);
+	};
+	allocateOrFail(table, 0x01000001, t0, std::chrono::milliseconds(1500), record);
+	uint8_t confirmed = allocateOrFail(table, 0x01000002, t0, std::chrono::milliseconds(500), record);
+	allocateOrFail(table, 0x01000003, t0 + std::chrono::milliseconds(100), std::chrono::milliseconds(1000), record);
+
+	std::chrono::steady_clock::time_point deadline;
+	if (!table.getNextDeadline(deadline) || deadline != t0 + std::chrono::milliseconds(500)) {
+		FAILF("Wrong next deadline");
+	}
+	CGpTxConfirmation confirmation;
+	CGpTxTable::FSentCallback callback;
+	if (!table.confirm(confirmed, NSEZSP::EEmberStatus::EMBER_SUCCESS, t0 + std::chrono::milliseconds(20), confirmation, callback) || !callback) {
+		FAILF("The callback of a confirmed transmission should be returned");
+	}
+	if (!table.getNextDeadline(deadline) || deadline != t0 + std::chrono::milliseconds(1100)) {
+		FAILF("Confirmed transmissions should not have a deadline anymore");
+	}
+
+	std::vector<std::pair<CGpTxConfirmation, CGpTxTable::FSentCallback> > expired;
+	table.expire(t0 + std::chrono::milliseconds(1200), expired);
+	if (expired.size() != 1 || expired[0].first.sourceId != 0x01000003 || !expired[0].first.expired ||
+	    expired[0].first.status != NSEZSP::EEmberStatus::EMBER_DELIVERY_FAILED || expired[0].first.latency != std::chrono::milliseconds(1100)) {
+		FAILF("Only the transmission whose deadline is over should expire");
+	}
+	expired[0].second(expired[0].first);
+	expired.clear();
+	table.expire(t0 + std::chrono::milliseconds(1500), expired);
+	if (expired.size() != 1 || table.getNbPending() != 0 || table.getNextDeadline(deadline)) {
+		FAILF("All transmissions should be over");
+	}
+	expired[0].second(expired[0].first);
+	if (outcomes != std::vector<uint32_t>({ 0x01000003, 0x01000001 })) {
+		FAILF("Wrong callbacks");
+	}
+	NOTIFYPASS();
+}
+
+TEST(gp_tx_table_tests, tx_table_latency_stats) {
+	CGpTxTable table;
+	CGpTxConfirmation confirmation;
+	CGpTxTable::FSentCallback callback;
+	const std::chrono::milliseconds latencies[] = { std::chrono::milliseconds(30), std::chrono::milliseconds(10), std::chrono::milliseconds(20) };
+	for (unsigned int i = 0; i < 3; i++) {
+		uint8_t handle = allocateOrFail(table, 0x01000000 + i, t0, std::chrono::milliseconds(1000));
+		NSEZSP::EEmberStatus status = (i == 2 ? NSEZSP::EEmberStatus::EMBER_DELIVERY_FAILED : NSEZSP::EEmberStatus::EMBER_SUCCESS);
+		if (!table.confirm(handle, status, t0 + latencies[i], confirmation, callback) || confirmation.latency != latencies[i] || confirmation.expired) {
+			FAILF("Wrong confirmation latency");
+		}
+	}
+	uint8_t handle = allocateOrFail(table, 0x01000003, t0, std::chrono::milliseconds(1000));
+	table.cancel(handle);
+	std::vector<std::pair<CGpTxConfirmation, CGpTxTable::FSentCallback> > expired;
+	allocateOrFail(table, 0x01000004, t0, std::chrono::milliseconds(10));
+	table.expire(t0 + std::chrono::seconds(2), expired);
+
+	CGpTxTable::LatencyStats stats = table.getLatencyStats();
+	if (stats.nbConfirmed != 2 || stats.nbFailed != 1 || stats.nbExpired != 1) {
+		FAILF("Wrong outcome counts: %zu confirmed, %zu failed, %zu expired", stats.nbConfirmed, stats.nbFailed, stats.nbExpired);
+	}
+	if (stats.minLatency != std::chrono::milliseconds(10) || stats.maxLatency != std::chrono::milliseconds(30) || stats.averageLatency != std::chrono::milliseconds(20)) {
+		FAILF("Wrong latency statistics");
+	}
+	NOTIFYPASS();
+}
+
+#ifndef USE_CPPUTEST
+void unit_tests_gp_tx_table() {
+	tx_table_handles();
+	tx_table_expiry();
+	tx_table_latency_stats();
+}
+#endif	// USE_CPPUTEST
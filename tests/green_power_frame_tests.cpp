@@ -5,6 +5,7 @@
 
 #include "spi/ByteBuffer.h"
 #include "ezsp/zbmessage/green-power-frame.h"
+#include "spi/AesBuilder.h"
 #include "TestHarness.h"
 
 TEST_GROUP(green_power_frame_tests) {
@@ -18,10 +19,150 @@ TEST(green_power_frame_tests, mic_calculation) {
 	}
 	NOTIFYPASS();
 }
+TEST(green_power_frame_tests, mic_calculation_expanded_key) {
+	NSSPI::ByteBuffer ezspMsg({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x02, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0xa2, 0xb5, 0x92, 0x23, 0x4e, 0x00, 0x11, 0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30});
+	NSEZSP::CGpFrame gpf(ezspMsg);
+	NSSPI::IAes::ExpandedKey expandedKey;
+	NSSPI::AesBuilder::shared().expand_key({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5F}, expandedKey);
+	if (!gpf.validateMIC(expandedKey)) {
+		FAILF("Re-caclulated MIC using a pre-computed key schedule does not match the one enclosed in the GP frame");
+	}
+	NSSPI::AesBuilder::shared().expand_key({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5E}, expandedKey);
+	if (gpf.validateMIC(expandedKey)) {
+		FAILF("MIC should not validate using the key schedule of a wrong key");
+	}
+	NOTIFYPASS();
+}
+TEST(green_power_frame_tests, decrypt_security_level_3) {
+	/* Same GPD, key, frame counter and command as in mic_calculation, but sent with security level 3 (encrypted command, AES-CCM* with L=2, M=4) */
+	NSSPI::ByteBuffer ezspMsg({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x03, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0x97, 0xe2, 0x0b, 0xae, 0x49, 0x00, 0x11, 0xb8, 0xa0, 0x55, 0xee, 0x86, 0xeb, 0x88, 0x2b, 0xfc, 0x4b, 0xb6, 0x62, 0x39, 0xd8, 0xe0, 0x10, 0x94});
+	const NSSPI::ByteBuffer plainPayload({0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30});
+	const NSEZSP::EmberKeyData key({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5F});
+	const NSEZSP::EmberKeyData wrongKey({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5E});
+	NSEZSP::CGpFrame gpf(ezspMsg);
+	if (!gpf.isValid() || gpf.getSecurity() != NSEZSP::EGpSecurityLevel::GPD_ENCRYPT_FRM_COUNTER_MIC_SECURITY) {
+		FAILF("Failed decoding an encrypted GP frame");
+	}
+	if (!gpf.validateMIC(key) || gpf.isDecrypted() || gpf.getCommandId() != 0x97) {
+		FAILF("MIC of an encrypted frame should validate without modifying the frame");
+	}
+	if (gpf.decrypt(wrongKey) || gpf.isDecrypted() || gpf.getCommandId() != 0x97) {
+		FAILF("Decryption using a wrong key should fail and leave the frame untouched");
+	}
+	if (!gpf.decrypt(key) || !gpf.isDecrypted()) {
+		FAILF("Decryption failed");
+	}
+	if (gpf.getCommandId() != 0xa2 || gpf.getPayload() != plainPayload) {
+		FAILF("Decrypted command does not match the plain text command");
+	}
+	if (!gpf.validateMIC(key) || gpf.validateMIC(wrongKey)) {
+		FAILF("MIC validation of a decrypted frame should use its plain text command");
+	}
 
+	NSEZSP::CGpFrame encrypted(ezspMsg);
+	NSEZSP::CGpFrame clear(NSSPI::ByteBuffer({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x02, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0xa2, 0xb5, 0x92, 0x23, 0x4e, 0x00, 0x11, 0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30}));
+	if (clear.decrypt(key)) {
+		FAILF("Only security level 3 frames can be decrypted");
+	}
+	NSSPI::IAes::ExpandedKey expandedKey;
+	NSSPI::AesBuilder::shared().expand_key(key, expandedKey);
+	const NSEZSP::CGpFrame* frames[] = { &encrypted, &clear, &gpf };
+	const NSSPI::IAes::ExpandedKey* keys[] = { &expandedKey, &expandedKey, &expandedKey };
+	bool results[] = { false, false, false };
+	NSEZSP::CGpFrame::validateMICBatch(frames, keys, 3, results);
+	if (!results[0] || !results[1] || !results[2]) {
+		FAILF("Batch MIC validation should support encrypted frames");
+	}
+	NOTIFYPASS();
+}
+TEST(green_power_frame_tests, truncated_frame) {
+	NSSPI::ByteBuffer ezspMsg({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x02, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0xa2, 0xb5, 0x92, 0x23, 0x4e, 0x00, 0x11, 0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30});
+	NSEZSP::CGpFrame complete(ezspMsg);
+	if (!complete.isValid() || complete.getSourceId() != 0x0054000a || complete.getPayloadView().size() != 0x11) {
+		FAILF("Failed decoding a complete GP frame");
+	}
+	ezspMsg.pop_back();	/* Remove the last payload byte */
+	NSEZSP::CGpFrame truncated(ezspMsg);
+	if (truncated.isValid()) {
+		FAILF("A truncated GP frame should not be valid");
+	}
+	NOTIFYPASS();
+}
+TEST(green_power_frame_tests, peek_header) {
+	NSSPI::ByteBuffer ezspMsg({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x02, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0xa2, 0xb5, 0x92, 0x23, 0x4e, 0x07, 0x11, 0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30});
+	NSEZSP::CGpFrame gpf(ezspMsg);
+	NSEZSP::CGpFrame::Header header;
+	if (!NSEZSP::CGpFrame::peekHeader(ezspMsg, header)) {
+		FAILF("Failed peeking the header of a complete GP frame");
+	}
+	if (header.source_id != gpf.getSourceId() || header.security != gpf.getSecurity() || header.command_id != gpf.getCommandId()
+	        || header.proxy_table_entry != gpf.getProxyTableEntry() || header.proxy_table_entry != 0x07) {
+		FAILF("Peeked header does not match the decoded GP frame");
+	}
+	ezspMsg.resize(27);	/* Cut just before the payload length */
+	if (!NSEZSP::CGpFrame::peekHeader(ezspMsg, header)) {
+		FAILF("Peeking the header should not need the payload");
+	}
+	ezspMsg.pop_back();	/* Remove the proxy table entry */
+	if (NSEZSP::CGpFrame::peekHeader(ezspMsg, header)) {
+		FAILF("Peeking the header of a GP frame truncated within the header should fail");
+	}
+	NOTIFYPASS();
+}
+
+TEST(green_power_frame_tests, frame_view) {
+	NSSPI::ByteBuffer ezspMsg({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x02, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0xa2, 0xb5, 0x92, 0x23, 0x4e, 0x07, 0x11, 0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30});
+	NSEZSP::CGpFrame gpf(ezspMsg);
+	NSEZSP::CGpFrameView view(ezspMsg);
+	if (!view.isValid() || view.getLinkValue() != gpf.getLinkValue() || view.getSequenceNumber() != gpf.getSequenceNumber()
+	        || view.getSourceId() != gpf.getSourceId() || view.getSecurity() != gpf.getSecurity() || view.getKeyType() != gpf.getKeyType()
+	        || view.isAutoCommissioning() != gpf.isAutoCommissioning() || view.isRxAfterTx() != gpf.isRxAfterTx()
+	        || view.getSecurityFrameCounter() != gpf.getSecurityFrameCounter() || view.getCommandId() != gpf.getCommandId()
+	        || view.getMic() != gpf.getMic() || view.getProxyTableEntry() != gpf.getProxyTableEntry() || view.isDecrypted()) {
+		FAILF("Fields read by the view do not match the decoded GP frame");
+	}
+	if (view.getPayloadView().data() != ezspMsg.data() + 28 || view.getPayloadView().toByteBuffer() != gpf.getPayloadView().toByteBuffer()) {
+		FAILF("The payload view should point into the ezsp message");
+	}
+	NSEZSP::CGpFrame retained = view.retain();
+	if (!retained.isValid() || retained.String() != gpf.String() || view.String() != gpf.String()) {
+		FAILF("The retained frame should be the decoded GP frame");
+	}
+
+	/* A view on a decrypted frame returns its plain text command */
+	NSSPI::ByteBuffer encryptedMsg({0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x03, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0x97, 0xe2, 0x0b, 0xae, 0x49, 0x00, 0x11, 0xb8, 0xa0, 0x55, 0xee, 0x86, 0xeb, 0x88, 0x2b, 0xfc, 0x4b, 0xb6, 0x62, 0x39, 0xd8, 0xe0, 0x10, 0x94});
+	NSEZSP::CGpFrame encrypted(encryptedMsg);
+	if (!encrypted.decrypt(NSEZSP::EmberKeyData({0xAC, 0xF2, 0x03, 0x6F, 0x55, 0x82, 0x72, 0x08, 0x5A, 0x30, 0xB0, 0x6D, 0x60, 0x36, 0x83, 0x5F}))) {
+		FAILF("Decryption failed");
+	}
+	NSEZSP::CGpFrameView decryptedView(encrypted);
+	if (!decryptedView.isDecrypted() || decryptedView.getCommandId() != 0xa2 || decryptedView.getPayloadView().toByteBuffer() != gpf.getPayloadView().toByteBuffer()
+	        || decryptedView.retain().getCommandId() != 0xa2) {
+		FAILF("A view on a decrypted frame should return its plain text command");
+	}
+
+	/* Invalid messages lead to invalid views, whose getters do not read the message */
+	ezspMsg.pop_back();
+	NSEZSP::CGpFrameView truncated(ezspMsg);
+	ezspMsg.resize(20);
+	NSEZSP::CGpFrameView header(ezspMsg);
+	ezspMsg = NSSPI::ByteBuffer({0x00, 0xde, 0xad, 0x02});
+	NSEZSP::CGpFrameView ieee(ezspMsg);
+	for (const NSEZSP::CGpFrameView* invalid : { &truncated, &header, &ieee }) {
+		if (invalid->isValid() || invalid->getSourceId() != 0 || !invalid->getPayloadView().empty() || invalid->retain().isValid()) {
+			FAILF("Views on truncated or non sourceId-addressed messages should not be valid");
+		}
+	}
+	NOTIFYPASS();
+}
 
 #ifndef USE_CPPUTEST
 void unit_tests_green_power_frame() {
 	mic_calculation();
+	mic_calculation_expanded_key();
+	decrypt_security_level_3();
+	truncated_frame();
+	peek_header();
+	frame_view();
 }
 #endif	// USE_CPPUTEST
@@ -0,0 +1,159 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+
+#include "spi/GenericAsyncDataInputObservable.h"
+#include "spi/IAsyncDataInputObserver.h"
+#include "spi/ObserverList.h"
+#include "TestHarness.h"
+
+namespace {
+
+class CountingObserver : public NSSPI::IAsyncDataInputObserver {
+public:
+	CountingObserver() : received(0) { }
+	void handleInputData(const unsigned char* dataIn, const size_t dataLen) {
+		this->received += dataLen;
+	}
+	std::atomic<size_t> received;
+};
+
+/**
+ * @brief Observer whose handler takes some time, recording when it is running
+ */
+class SlowObserver : public NSSPI::IAsyncDataInputObserver {
+public:
+	SlowObserver() : running(false), finished(false) { }
+	void handleInputData(const unsigned char* dataIn, const size_t dataLen) {
+		this->running = true;
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		this->finished = true;
+	}
+	std::atomic<bool> running;
+	std::atomic<bool> finished;
+};
+
+/**
+ * @brief Observer that unregisters itself from its own handler
+ */
+class SelfRemovingObserver : public NSSPI::IAsyncDataInputObserver {
+public:
+	explicit SelfRemovingObserver(NSSPI::GenericAsyncDataInputObservable& i_observable) : observable(i_observable), removed(false) { }
+	void handleInputData(const unsigned char* dataIn, const size_t dataLen) {
+		this->removed = this->observable.unregisterObserver(this);
+	}
+	NSSPI::GenericAsyncDataInputObservable& observable;
+	bool removed;
+};
+
+}
+
+TEST_GROUP(observer_list_tests) {
+};
+
+TEST(observer_list_tests, observer_list_add_remove) {
+	NSSPI::ObserverList<CountingObserver> list;
+	CountingObserver a;
+	CountingObserver b;
+
+	if (!list.add(&a) || !list.add(&b) || list.add(&a)) {
+		FAILF("Unexpected result when adding observers");
+	}
+	std::shared_ptr<const NSSPI::ObserverList<CountingObserver>::Snapshot> before = list.snapshot();
+	if (!list.remove(&a) || list.remove(&a)) {
+		FAILF("Unexpected result when removing observers");
+	}
+	if (before->size() != 2 || list.size() != 1 || (*list.snapshot())[0] != &b) {
+		FAILF("A snapshot should not be modified by later changes to the list");
+	}
+	NOTIFYPASS();
+}
+
+TEST(observer_list_tests, observer_list_register_notify_stress) {
+	static constexpr unsigned int NB_CHURNING_OBSERVERS = 8;
+	static constexpr unsigned int NB_ITERATIONS = 20000;
+	NSSPI::GenericAsyncDataInputObservable observable;
+	CountingObserver permanent;
+	std::vector<CountingObserver> churning(NB_CHURNING_OBSERVERS);
+	std::atomic<bool> stop(false);
+	const unsigned char byte = 0x55;
+
+	observable.registerObserver(&permanent);
+	std::thread notifier([&observable, &stop, &byte]() {
+		while (!stop) {
+			observable.notifyObservers(&byte, 1);
+		}
+	});
+	std::vector<std::thread> registrars;
+	for (unsigned int t=0; t<2; t++) {
+		registrars.emplace_back([&observable, &churning, t]() {
+			for (unsigned int loop=0; loop<NB_ITERATIONS; loop++) {
+				CountingObserver* observer = &churning[(loop*2+t) % NB_CHURNING_OBSERVERS];
+				observable.registerObserver(observer);
+				observable.unregisterObserver(observer);
+			}
+		});
+	}
+	for (auto& registrar : registrars) {
+		registrar.join();
+	}
+	size_t receivedBeforeStop = permanent.received;
+	stop = true;
+	notifier.join();
+
+	if (receivedBeforeStop == 0) {
+		FAILF("Permanent observer was never notified");
+	}
+	size_t receivedNow = permanent.received;
+	observable.notifyObservers(&byte, 1);
+	if (permanent.received != receivedNow + 1) {
+		FAILF("Permanent observer was lost during register/unregister churn");
+	}
+	for (auto& observer : churning) {
+		size_t count = observer.received;
+		observable.notifyObservers(&byte, 1);
+		if (observer.received != count) {
+			FAILF("An unregistered observer is still being notified");
+		}
+	}
+	NOTIFYPASS();
+}
+
+TEST(observer_list_tests, observer_list_unregister_waits_for_notifications) {
+	NSSPI::GenericAsyncDataInputObservable observable;
+	SlowObserver slow;
+	const unsigned char byte = 0x55;
+
+	observable.registerObserver(&slow);
+	std::thread notifier([&observable, &byte]() {
+		observable.notifyObservers(&byte, 1);
+	});
+	while (!slow.running) {
+		std::this_thread::yield();
+	}
+	observable.unregisterObserver(&slow);
+	bool finishedAtReturn = slow.finished;
+	notifier.join();
+	if (!finishedAtReturn) {
+		FAILF("unregisterObserver() returned while the observer was still being notified");
+	}
+
+	/* An observer can unregister itself from its handler without waiting for itself */
+	SelfRemovingObserver selfRemoving(observable);
+	observable.registerObserver(&selfRemoving);
+	observable.notifyObservers(&byte, 1);
+	if (!selfRemoving.removed || observable.unregisterObserver(&selfRemoving)) {
+		FAILF("An observer should be able to unregister itself from its handler");
+	}
+	NOTIFYPASS();
+}
+
+#ifndef USE_CPPUTEST
+void unit_tests_observer_list() {
+	observer_list_add_remove();
+	observer_list_register_notify_stress();
+	observer_list_unregister_waits_for_notifications();
+}
+#endif	// USE_CPPUTEST
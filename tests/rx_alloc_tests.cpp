@@ -0,0 +1,384 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <string>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#ifdef __GLIBC__
+#include <malloc.h>	// For malloc_trim()
+#endif
+
+#include "spi/mock-uart/MockUartDriver.h"
+#include "spi/TimerBuilder.h"
+#include "spi/Logger.h"
+#include "spi/ILogger.h"
+#include "spi/AllocCounter.h"
+#include "ezsp/ezsp.h"
+#include "ezsp/ezsp-dongle.h"
+#include "ezsp/ashv2-codec.h"
+#include "ezsp/zigbee-tools/green-power-device-db.h"
+#include "ezsp/zigbee-tools/green-power-liveness.h"
+
+#include "TestHarness.h"
+#include "SimulatedNcp.h"
+
+using NSSPI::Logger;
+using NSSPI::LOG_LEVEL;
+using NSSPI::TimerBuilder;
+using NSSPI::MockUartDriver;
+
+/**
+ * @brief Minimal emulated NCP: tracks the frames written by the host so that the ASH DATA frames we forge carry the expected ACK number
+ */
+class RxAllocNcpEmulator {
+public:
+	RxAllocNcpEmulator() : codec(nullptr), codecMutex(), hostPayloads() { }
+
+	int onWriteCallback(size_t& writtenCnt, const void* buf, size_t cnt, std::chrono::duration<double, std::milli> delta) {
+		ALLOC_COUNTING_LAYER(NONE);	/* We are emulating the NCP here, do not attribute our own allocations to the library layer that is writing */
+		std::lock_guard<std::mutex> lock(this->codecMutex);
+		this->codec.appendIncoming(static_cast<const uint8_t*>(buf), cnt, this->hostPayloads);	/* Only done to keep track of the host's frame numbers */
+		this->hostPayloads.clear();
+		writtenCnt = cnt;
+		return 0;
+	}
+
+	NSSPI::FrameBuffer forgeDataFrame(const NSSPI::ByteBuffer& ezspMsg) {
+		std::lock_guard<std::mutex> lock(this->codecMutex);
+		return this->codec.forgeDataFrame(ezspMsg);
+	}
+
+private:
+	NSEZSP::AshCodec codec;	/*!< The NCP side of the ASH link */
+	std::mutex codecMutex;	/*!< Host writes may happen from a timer thread */
+	std::vector<NSSPI::FrameBuffer> hostPayloads;	/*!< Reused storage for decoded host frames */
+};
+
+/**
+ * @brief Read a memory counter of the current process
+ *
+ * @param field The name of the field in /proc/self/status (eg: "VmRSS", "VmHWM")
+ *
+ * @return The value of this field in kiB, or 0 if it could not be read
+ */
+static unsigned long readProcStatusKb(const std::string& field) {
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, field.size() + 1, field + ":") == 0) {
+			return std::stoul(line.substr(field.size() + 1));
+		}
+	}
+	return 0;
+}
+
+/**
+ * @brief Reset the peak RSS (VmHWM) of the current process to its current RSS
+ *
+ * @return true if the peak RSS could be reset (Linux 4.0 and later)
+ */
+static bool resetPeakRss() {
+#ifdef __GLIBC__
+	malloc_trim(0);	/* Give the heap freed by previous tests back to the system, or we would measure its reuse instead of new memory */
+#endif
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	clearRefs << "5";
+	clearRefs.flush();
+	return static_cast<bool>(clearRefs);
+}
+
+/**
+ * @brief Dongle observer counting the responses to EZSP_NOP commands, without allocating
+ */
+class NopResponseCounter : public NSEZSP::CEzspDongleObserver {
+public:
+	NopResponseCounter() : ready(false), nbResponses(0) { }
+
+	void handleDongleState(NSEZSP::EDongleState i_state) override {
+		if (i_state == NSEZSP::DONGLE_READY) {
+			this->ready = true;
+		}
+	}
+
+	void handleEzspRxMessage(NSEZSP::EEzspCmd i_cmd, const NSSPI::ByteBuffer& i_msg_receive) override {
+		(void)i_msg_receive;
+		if (i_cmd == NSEZSP::EZSP_NOP) {
+			this->nbResponses++;
+		}
+	}
+
+	/**
+	 * @brief Wait until a number of responses have been received
+	 *
+	 * @return true if they have been received within a few seconds
+	 */
+	bool waitResponses(unsigned int i_count) const {
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (this->nbResponses < i_count) {
+			if (std::chrono::steady_clock::now() > deadline) {
+				return false;
+			}
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+		return true;
+	}
+
+	std::atomic<bool> ready;	/*!< Has the dongle reported DONGLE_READY? */
+	std::atomic<unsigned int> nbResponses;	/*!< Number of EZSP_NOP responses received */
+};
+
+TEST_GROUP(rx_alloc_tests) {
+};
+
+TEST(rx_alloc_tests, rx_gp_incoming_allocations) {
+	static constexpr unsigned int NB_WARMUP_FRAMES = 100;
+	static constexpr unsigned int NB_MEASURED_FRAMES = 5000;
+	static constexpr unsigned int NB_POISONED_FRAMES = 1000;
+	TimerBuilder timerBuilder;
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);	/* Same log level as a production gateway */
+	RxAllocNcpEmulator ncp;
+	auto wcb = [&ncp](size_t& writtenCnt, const void* buf, size_t cnt, std::chrono::duration<double, std::milli> delta) -> int {
+		return ncp.onWriteCallback(writtenCnt, buf, cnt, delta);
+	};
+	std::shared_ptr<MockUartDriver> mockUartDriverHandle(new MockUartDriver(wcb));	//NOSONAR
+	if (mockUartDriverHandle->open("/dev/ttyUSB0", 115200) != 0) {
+		FAILF("Failed opening mock serial port");
+	}
+	unsigned int nbRxGpFrames = 0;
+	{
+		NSEZSP::CEzsp lib_main(static_cast<NSSPI::IUartDriverHandle>(mockUartDriverHandle), timerBuilder);
+		lib_main.registerGPFrameRecvCallback([&nbRxGpFrames](const NSEZSP::CGpFrameView& i_gpf) {
+			if (i_gpf.getSourceId() == 0x0054000a) {
+				nbRxGpFrames++;
+			}
+		});
+		lib_main.start();
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));	/* Let the host send its ASH RST */
+		const uint8_t rstAck[] = { 0x1a, 0xc1, 0x02, 0x0b, 0x0a, 0x52, 0x7e };
+		mockUartDriverHandle->deliverIncomingChunk(rstAck, sizeof(rstAck));
+		std::this_thread::sleep_for(std::chrono::milliseconds(100));	/* Let the host send its first EZSP command, we will never answer it */
+
+		/* Recorded EZSP_GPEP_INCOMING_MESSAGE_HANDLER (legacy EZSP header: sequence, frame control, frame ID), carrying a GP attribute report */
+		NSSPI::ByteBuffer ezspMsg({0x00, 0x90, 0xc5, 0x00, 0xde, 0xad, 0x00, 0x0a, 0x00, 0x54, 0x00, 0x0a, 0x00, 0x54, 0x00, 0xc5, 0x02, 0x04, 0x00, 0x01, 0xad, 0x10, 0x00, 0x00, 0xa2, 0xb5, 0x92, 0x23, 0x4e, 0x00, 0x11, 0x01, 0x00, 0x20, 0x00, 0x20, 0x20, 0x00, 0x00, 0x00, 0x40, 0x42, 0x05, 0x31, 0x2e, 0x30, 0x2e, 0x30});
+		std::vector<NSSPI::FrameBuffer> ashFrames;	/* Forged beforehand, so that the test itself does not allocate while measuring */
+		for (unsigned int loop=0; loop<NB_WARMUP_FRAMES+NB_MEASURED_FRAMES+NB_POISONED_FRAMES; loop++) {
+			ezspMsg[0] = static_cast<uint8_t>(loop);	/* EZSP sequence number */
+			ezspMsg[20] = static_cast<uint8_t>(loop & 0xffU);	/* Security frame counter: each frame is a new one, not a copy to drop */
+			ezspMsg[21] = static_cast<uint8_t>((loop >> 8) & 0xffU);
+			ashFrames.push_back(ncp.forgeDataFrame(ezspMsg));
+		}
+
+		for (unsigned int loop=0; loop<NB_WARMUP_FRAMES; loop++) {
+			mockUartDriverHandle->deliverIncomingChunk(ashFrames[loop].data(), ashFrames[loop].size());
+		}
+#ifdef USE_ALLOC_COUNTING
+		NSSPI::AllocCounter::reset();
+#endif
+		for (unsigned int loop=NB_WARMUP_FRAMES; loop<NB_WARMUP_FRAMES+NB_MEASURED_FRAMES; loop++) {
+			mockUartDriverHandle->deliverIncomingChunk(ashFrames[loop].data(), ashFrames[loop].size());
+		}
+#ifdef USE_ALLOC_COUNTING
+		/* Allocation budget per frame and per layer: lower these values as allocations are removed from the RX path, never raise them */
+		static const struct {
+			NSSPI::AllocCounter::Layer layer;
+			double maxAllocsPerFrame;
+		} budget[] = {
+			{ NSSPI::AllocCounter::Layer::ASH, 0 },
+			{ NSSPI::AllocCounter::Layer::DONGLE, 0 },
+			{ NSSPI::AllocCounter::Layer::GP_SINK, 0 },
+			{ NSSPI::AllocCounter::Layer::USER_CALLBACK, 0 },
+		};
+		bool overBudget = false;
+		for (const auto& entry : budget) {
+			NSSPI::AllocCounter::Stats stats = NSSPI::AllocCounter::get(entry.layer);
+			double allocsPerFrame = static_cast<double>(stats.allocs) / NB_MEASURED_FRAMES;
+			double bytesPerFrame = static_cast<double>(stats.bytes) / NB_MEASURED_FRAMES;
+			std::cout << "RX allocations for layer " << std::setfill(' ') << std::setw(13) << NSSPI::AllocCounter::layerToString(entry.layer)
+			          << ": " << std::fixed << std::setprecision(2) << allocsPerFrame << " allocs/frame, "
+			          << bytesPerFrame << " bytes/frame (budget " << entry.maxAllocsPerFrame << " allocs/frame)\n";
+			if (allocsPerFrame > entry.maxAllocsPerFrame) {
+				overBudget = true;
+			}
+		}
+		if (overBudget) {
+			FAILF("RX path allocation budget exceeded");
+		}
+#else
+		std::cout << "Allocation counting is not enabled in this build (use cmake option USE_ALLOC_COUNTING to get a per-layer report)\n";
+#endif
+
+		{
+#if defined(USE_ALLOC_COUNTING) && defined(USE_STATIC_ALLOCATION)
+			NSSPI::AllocCounter::reset();
+			NSSPI::AllocCounter::Poison poisonedAllocator;	/* The library is started: from now on, the RX path must not allocate at all */
+#endif
+			for (unsigned int loop=NB_WARMUP_FRAMES+NB_MEASURED_FRAMES; loop<NB_WARMUP_FRAMES+NB_MEASURED_FRAMES+NB_POISONED_FRAMES; loop++) {
+				mockUartDriverHandle->deliverIncomingChunk(ashFrames[loop].data(), ashFrames[loop].size());
+			}
+		}
+#if defined(USE_ALLOC_COUNTING) && defined(USE_STATIC_ALLOCATION)
+		for (unsigned int layer = 0; layer < static_cast<unsigned int>(NSSPI::AllocCounter::Layer::NB_LAYERS); layer++) {
+			NSSPI::AllocCounter::Stats violations = NSSPI::AllocCounter::getViolations(static_cast<NSSPI::AllocCounter::Layer>(layer));
+			if (violations.allocs != 0) {
+				FAILF("Layer %s allocated %llu times (%llu bytes) on the RX path after start() in a static allocation build",
+				      NSSPI::AllocCounter::layerToString(static_cast<NSSPI::AllocCounter::Layer>(layer)),
+				      static_cast<unsigned long long>(violations.allocs), static_cast<unsigned long long>(violations.bytes));
+			}
+		}
+#endif
+		mockUartDriverHandle->destroyAllScheduledIncomingChunks();
+	}
+#ifdef USE_BUILTIN_MIC_PROCESSING
+	const unsigned int expectedRxGpFrames = 0;	/* No key is provisioned on the host for this source ID, so frames are dropped before reaching the user callback */
+#else
+	const unsigned int expectedRxGpFrames = NB_WARMUP_FRAMES+NB_MEASURED_FRAMES+NB_POISONED_FRAMES;
+#endif
+	if (nbRxGpFrames != expectedRxGpFrames) {
+		FAILF("Expected %u GP frames to reach the user callback, got %u", expectedRxGpFrames, nbRxGpFrames);
+	}
+	NOTIFYPASS();
+}
+
+TEST(rx_alloc_tests, tx_command_allocations) {
+	static constexpr std::size_t QUEUE_CAPACITY = 16;
+	static constexpr unsigned int NB_WARMUP_COMMANDS = 100;
+	static constexpr unsigned int NB_POISONED_COMMANDS = 1000;
+	Logger::getInstance()->setLogLevel(LOG_LEVEL::ERROR);
+	SimulatedNcp ncp(16, std::chrono::microseconds(0));
+	TimerBuilder timerBuilder;
+	NopResponseCounter counter;
+	{
+		NSEZSP::CEzspDongle dongle(timerBuilder, &counter, QUEUE_CAPACITY);
+		dongle.setUart(ncp.getUart());
+		if (!dongle.reset()) {
+			FAILF("Failed resetting the simulated adapter");
+		}
+		auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (!counter.ready) {
+			if (std::chrono::steady_clock::now() > deadline) {
+				FAILF("Timeout waiting for the dongle to be ready");
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		const NSSPI::ByteBuffer payload;	/* Built beforehand, so that the test itself does not allocate while poisoned */
+		unsigned int nbSent = 0;
+		for (; nbSent < NB_WARMUP_COMMANDS; nbSent++) {
+			if (!dongle.sendCommand(NSEZSP::EZSP_NOP, payload) || !counter.waitResponses(nbSent + 1)) {
+				FAILF("No response to warm-up command #%u", nbSent);
+			}
+		}
+#ifdef USE_ALLOC_COUNTING
+		NSSPI::AllocCounter::reset();
+#endif
+		{
+#if defined(USE_ALLOC_COUNTING) && defined(USE_STATIC_ALLOCATION)
+			NSSPI::AllocCounter::ProcessPoison poisonedAllocator;	/* Covers the adapter responses handled on the serial thread, and the ASH timer thread */
+#endif
+			while (nbSent < NB_WARMUP_COMMANDS + NB_POISONED_COMMANDS) {
+				if (nbSent - counter.nbResponses >= QUEUE_CAPACITY / 2 && !counter.waitResponses(nbSent - QUEUE_CAPACITY / 4)) {
+					FAILF("The adapter stopped answering after %u commands", static_cast<unsigned int>(counter.nbResponses));
+				}
+				if (!dongle.sendCommand(NSEZSP::EZSP_NOP, payload)) {
+					FAILF("Command #%u was dropped although the queue was not full", nbSent);
+				}
+				nbSent++;
+			}
+			if (!counter.waitResponses(nbSent)) {
+				FAILF("Only %u responses out of %u commands", static_cast<unsigned int>(counter.nbResponses), nbSent);
+			}
+		}
+#if defined(USE_ALLOC_COUNTING) && defined(USE_STATIC_ALLOCATION)
+		for (unsigned int layer = 0; layer < static_cast<unsigned int>(NSSPI::AllocCounter::Layer::NB_LAYERS); layer++) {
+			NSSPI::AllocCounter::Stats violations = NSSPI::AllocCounter::getProcessViolations(static_cast<NSSPI::AllocCounter::Layer>(layer));
+			if (violations.allocs != 0) {
+				FAILF("Layer %s allocated %llu times (%llu bytes) on the TX path after start() in a static allocation build",
+				      NSSPI::AllocCounter::layerToString(static_cast<NSSPI::AllocCounter::Layer>(layer)),
+				      static_cast<unsigned long long>(violations.allocs), static_cast<unsigned long long>(violations.bytes));
+			}
+		}
+#endif
+
+		ncp.stop();	/* From now on, the command being sent never gets a response, and the following ones remain queued */
+		unsigned int nbAccepted = 0;
+		for (unsigned int loop = 0; loop < QUEUE_CAPACITY + 1; loop++) {
+			if (dongle.sendCommand(NSEZSP::EZSP_NOP, payload)) {
+				nbAccepted++;
+			}
+		}
+#ifdef USE_STATIC_ALLOCATION
+		if (nbAccepted != QUEUE_CAPACITY || dongle.getDroppedCommandsCount() != 1) {
+			FAILF("Expected the command exceeding the queue capacity to be rejected and counted, %u commands out of %zu were accepted, %u dropped",
+			      nbAccepted, QUEUE_CAPACITY + 1, dongle.getDroppedCommandsCount());
+		}
+#else
+		if (nbAccepted != QUEUE_CAPACITY + 1 || dongle.getDroppedCommandsCount() != 0) {
+			FAILF("The command queue should grow as needed in a dynamic allocation build");
+		}
+#endif
+	}
+	NOTIFYPASS();
+}
+
+TEST(rx_alloc_tests, gp_device_db_footprint) {
+	static const unsigned int nbDevicesList[] = { 1000, 10000, 100000 };
+	const NSEZSP::EmberKeyData key({0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf});
+	TimerBuilder timerBuilder;
+	std::shared_ptr<MockUartDriver> mockUartDriverHandle(new MockUartDriver());	//NOSONAR
+
+	for (unsigned int nbDevices : nbDevicesList) {
+		bool peakReset = resetPeakRss();
+		unsigned long rssBeforeKb = readProcStatusKb("VmRSS");
+		{
+			/* Everything sized by the number of devices: the library (host key database and liveness tracker of the sink), plus a full
+			 * database and a full liveness tracker on the side, as the library's own ones cannot be filled without an adapter */
+			NSEZSP::CEzsp lib_main(static_cast<NSSPI::IUartDriverHandle>(mockUartDriverHandle), timerBuilder, 0, NSEZSP::CEzspCapacities(256, nbDevices));
+			auto now = std::chrono::steady_clock::now();
+			NSEZSP::CGpLivenessTracker liveness(nbDevices, now);
+			NSEZSP::CGPDeviceDb db(nbDevices);
+			for (unsigned int index = 0; index < nbDevices; index++) {
+				if (!db.insertDevice(0x01000000 + index, key)) {
+					FAILF("Could not insert device #%u out of %u", index, nbDevices);
+				}
+			}
+#ifdef USE_STATIC_ALLOCATION
+			if (db.insertDevice(0x00ffffff, key)) {
+				FAILF("Inserting more than %u devices should fail in a static allocation build", nbDevices);
+			}
+#endif
+			if (db.size() != nbDevices || !db.isSourceIdInDb(0x01000000 + nbDevices - 1)) {
+				FAILF("Unexpected database content after inserting %u devices", nbDevices);
+			}
+			for (unsigned int index = 0; index < nbDevices; index++) {
+				NSEZSP::CGpLivenessReport report;
+				liveness.heard(0x01000000 + index, now, report);
+			}
+			if (liveness.getNbTracked() != nbDevices) {
+				FAILF("Expected %u devices in the liveness tracker, got %zu", nbDevices, liveness.getNbTracked());
+			}
+			unsigned long rssAfterKb = readProcStatusKb("VmRSS");
+			unsigned long peakKb = readProcStatusKb("VmHWM");
+			long deltaKb = static_cast<long>(rssAfterKb) - static_cast<long>(rssBeforeKb);
+			std::cout << "Library sized for " << std::setfill(' ') << std::setw(6) << std::dec << nbDevices << " GP devices: RSS "
+			          << rssAfterKb << " kiB (" << std::showpos << deltaKb << std::noshowpos << " kiB), peak RSS " << peakKb << " kiB";
+			if (peakReset) {
+				std::cout << " (" << std::showpos << static_cast<long>(peakKb) - static_cast<long>(rssBeforeKb) << std::noshowpos << " kiB)";
+			}
+			else {
+				std::cout << " (since process start, peak RSS cannot be reset on this system)";
+			}
+			std::cout << "\n";
+		}
+	}
+	NOTIFYPASS();
+}
+
+#ifndef USE_CPPUTEST
+void unit_tests_rx_alloc() {
+	rx_gp_incoming_allocations();
+	tx_command_allocations();
+	gp_device_db_footprint();
+}
+#endif	// USE_CPPUTEST
@@ -12,9 +12,26 @@
 
 #ifndef USE_CPPUTEST
 void unit_tests_gp();	// Declaration of gp unit test procedure (see gp_tests.cpp)
+void unit_tests_rx_alloc();	// Declaration of RX path allocation tests (see rx_alloc_tests.cpp)
 void unit_tests_mock_serial();	// Declaration of mock serial self tests (see mock_serial_self_tests.cpp)
 void unit_tests_logger_bytes_to_string();	// Declaration of logger bytes to string tests (see logger_bytes_to_string_tests.cpp)
+void unit_tests_frame_buffer();	// Declaration of frame buffer tests (see frame_buffer_tests.cpp)
+void unit_tests_observer_list();	// Declaration of observer list tests (see observer_list_tests.cpp)
+void unit_tests_aes();	// Declaration of AES implementations tests (see aes_tests.cpp)
 void unit_tests_green_power_frame();	// Declaration of green power frame decoder tests (see green_power_frame_tests.cpp)
+void unit_tests_gp_payload_decoders();	// Declaration of GPD command payload decoders tests (see gp_payload_decoders_tests.cpp)
+void unit_tests_gp_attribute_store();	// Declaration of GP attribute store tests (see gp_attribute_store_tests.cpp)
+void unit_tests_gp_liveness();	// Declaration of GP liveness tracker tests (see gp_liveness_tests.cpp)
+void unit_tests_gp_mic_benchmark();	// Declaration of GP MIC validation benchmark (see gp_mic_benchmark_tests.cpp)
+void unit_tests_gp_device_store();	// Declaration of GP device store tests (see gp_device_store_tests.cpp)
+void unit_tests_gp_source_filter();	// Declaration of GP source ID filter tests (see gp_source_filter_tests.cpp)
+void unit_tests_gp_duplicate_filter();	// Declaration of GP duplicate frame filter tests (see gp_duplicate_filter_tests.cpp)
+void unit_tests_gp_sink_placement();	// Declaration of GP sink table placement tests (see gp_sink_placement_tests.cpp)
+void unit_tests_gp_mic_pool();	// Declaration of GP MIC validation pool tests (see gp_mic_pool_tests.cpp)
+void unit_tests_gp_table_mirror();	// Declaration of GP table mirror tests (see gp_table_mirror_tests.cpp)
+void unit_tests_gp_tx_table();	// Declaration of GPDF transmissions table tests (see gp_tx_table_tests.cpp)
+void unit_tests_gp_downlink_queue();	// Declaration of GPDF downlink queue tests (see gp_downlink_queue_tests.cpp)
+void unit_tests_gp_registration();	// Declaration of GP device bulk registration tests (see gp_registration_tests.cpp)
 void unit_tests_ezsp_adapter_version();	// Declaration of EZSP adapter tests (see ezsp_adapter_version_tests.cpp)
 #endif
 
@@ -25,10 +42,44 @@ int main(int argc, char* argv[]) {
 	unit_tests_mock_serial();
 	printf("*** Testing bytes container to string converter ***\n");
 	unit_tests_logger_bytes_to_string();
+	printf("*** Testing frame buffer and ASH codec ***\n");
+	unit_tests_frame_buffer();
+	printf("*** Testing copy-on-write observer lists ***\n");
+	unit_tests_observer_list();
+	printf("*** Testing AES implementations ***\n");
+	unit_tests_aes();
 	printf("*** Testing GP frames decoder and MIC check ***\n");
 	unit_tests_green_power_frame();
+	printf("*** Testing GPD command payload decoders ***\n");
+	unit_tests_gp_payload_decoders();
+	printf("*** Testing GP attribute store ***\n");
+	unit_tests_gp_attribute_store();
+	printf("*** Testing GP liveness tracking ***\n");
+	unit_tests_gp_liveness();
+	printf("*** Benchmarking GP MIC validation ***\n");
+	unit_tests_gp_mic_benchmark();
+	printf("*** Testing GP device store ***\n");
+	unit_tests_gp_device_store();
+	printf("*** Testing GP source ID filter ***\n");
+	unit_tests_gp_source_filter();
+	printf("*** Testing GP duplicate frame filter ***\n");
+	unit_tests_gp_duplicate_filter();
+	printf("*** Testing GP sink table placement ***\n");
+	unit_tests_gp_sink_placement();
+	printf("*** Testing GP MIC validation pool ***\n");
+	unit_tests_gp_mic_pool();
+	printf("*** Testing GP table mirror ***\n");
+	unit_tests_gp_table_mirror();
+	printf("*** Testing GPDF transmissions table ***\n");
+	unit_tests_gp_tx_table();
+	printf("*** Testing GPDF downlink queue ***\n");
+	unit_tests_gp_downlink_queue();
+	printf("*** Testing GP device bulk registration ***\n");
+	unit_tests_gp_registration();
 	printf("*** Testing GP frames processing ***\n");
 	unit_tests_gp();
+	printf("*** Testing RX path allocations ***\n");
+	unit_tests_rx_alloc();
 	printf("*** Testing EZSP version processing ***\n");
 	unit_tests_ezsp_adapter_version();
 	printf("\n*** All unit tests passed successfully ***\n");